@@ -200,6 +200,10 @@ void up_initialize(void)
   loop_register();      /* Standard /dev/loop */
 #endif
 
+#if defined(CONFIG_DEV_SHMRING)
+  shmring_register();   /* Non-standard /dev/shmring */
+#endif
+
 #if defined(CONFIG_SCHED_INSTRUMENTATION_BUFFER) && \
     defined(CONFIG_DRIVER_NOTE)
   note_register();      /* Non-standard /dev/note */
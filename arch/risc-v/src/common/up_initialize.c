@@ -144,6 +144,10 @@ void up_initialize(void)
   devzero_register();   /* Standard /dev/zero */
 #endif
 
+#if defined(CONFIG_DEV_SHMRING)
+  shmring_register();   /* Non-standard /dev/shmring */
+#endif
+
   /* Initialize the serial device driver */
 
 #ifdef USE_SERIALDRIVER
@@ -212,6 +212,10 @@ void up_initialize(void)
   loop_register();          /* Standard /dev/loop */
 #endif
 
+#if defined(CONFIG_DEV_SHMRING)
+  shmring_register();       /* Non-standard /dev/shmring */
+#endif
+
 #if defined(CONFIG_SCHED_INSTRUMENTATION_BUFFER) && \
     defined(CONFIG_DRIVER_NOTE)
   note_register();          /* Non-standard /dev/note */
@@ -253,6 +257,10 @@ void up_initialize(void)
   up_registerblockdevice(); /* Our FAT ramdisk at /dev/ram0 */
 #endif
 
+#ifdef CONFIG_SIM_SENSOR
+  sim_sensor_initialize(0); /* Simulated IMU at /dev/sensor/accel0, gyro0 */
+#endif
+
 #ifdef CONFIG_SIM_NETDEV
   netdriver_init();         /* Our "real" network driver */
 #endif
@@ -310,6 +310,12 @@ void up_buttonevent(int x, int y, int buttons);
 int sim_ajoy_initialize(void);
 #endif
 
+/* up_sensor.c **************************************************************/
+
+#ifdef CONFIG_SIM_SENSOR
+int sim_sensor_initialize(int devno);
+#endif
+
 /* up_ioexpander.c **********************************************************/
 
 #ifdef CONFIG_SIM_IOEXPANDER
@@ -0,0 +1,341 @@
+/****************************************************************************
+ * arch/sim/src/sim/up_sensor.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/sensors/sensor.h>
+
+#include "up_internal.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Depth of the simulated hardware FIFO, in samples */
+
+#define SIM_SENSOR_FIFO     32
+
+/* Slowest and fastest supported intervals: 1 Hz to 1 kHz */
+
+#define SIM_INTERVAL_MAX    1000000
+#define SIM_INTERVAL_MIN    1000
+
+/* Period of the triangle wave on the X axis, in samples */
+
+#define SIM_WAVE_PERIOD     64
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A simulated sensor.  Samples are "taken" at the configured interval and
+ * "stored" in a FIFO of SIM_SENSOR_FIFO entries that is drained every
+ * batch latency, like a real chip would do.  When the FIFO overflows,
+ * the oldest samples are lost.
+ */
+
+struct sim_sensor_s
+{
+  struct sensor_lowerhalf_s lower;     /* Must be first */
+  struct work_s work;                  /* Drains the FIFO */
+  bool enabled;
+  unsigned int interval;               /* Sample interval in usec */
+  unsigned int latency;                /* Batch latency in usec */
+  uint64_t next;                       /* Time of the next sample */
+  uint32_t seq;                        /* Sample sequence number */
+  union
+  {
+    struct sensor_event_accel_s accel[SIM_SENSOR_FIFO];
+    struct sensor_event_gyro_s gyro[SIM_SENSOR_FIFO];
+  } fifo;
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int sim_activate(FAR struct sensor_lowerhalf_s *lower, bool enable);
+static int sim_set_interval(FAR struct sensor_lowerhalf_s *lower,
+                            FAR unsigned int *period_us);
+static int sim_batch(FAR struct sensor_lowerhalf_s *lower,
+                     FAR unsigned int *latency_us);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct sensor_ops_s g_sim_sensor_ops =
+{
+  sim_activate,      /* activate */
+  sim_set_interval,  /* set_interval */
+  sim_batch,         /* batch */
+  NULL               /* control */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_wave
+ *
+ * Description:
+ *   A triangle wave between -1 and 1, so that the samples are easy to
+ *   check without libm.
+ *
+ ****************************************************************************/
+
+static float sim_wave(uint32_t seq)
+{
+  uint32_t phase = seq % SIM_WAVE_PERIOD;
+
+  if (phase < SIM_WAVE_PERIOD / 2)
+    {
+      return -1.0f + 4.0f * phase / SIM_WAVE_PERIOD;
+    }
+
+  return 3.0f - 4.0f * phase / SIM_WAVE_PERIOD;
+}
+
+/****************************************************************************
+ * Name: sim_schedule
+ ****************************************************************************/
+
+static void sim_schedule(FAR struct sim_sensor_s *priv, worker_t worker)
+{
+  unsigned int delay;
+
+  delay = priv->latency > priv->interval ? priv->latency : priv->interval;
+  work_queue(LPWORK, &priv->work, worker, priv,
+             USEC2TICK(delay) > 0 ? USEC2TICK(delay) : 1);
+}
+
+/****************************************************************************
+ * Name: sim_worker
+ *
+ * Description:
+ *   Generate the samples taken since the last run and push them to the
+ *   upper half in one burst.
+ *
+ ****************************************************************************/
+
+static void sim_worker(FAR void *arg)
+{
+  FAR struct sim_sensor_s *priv = arg;
+  uint64_t now = sensor_get_timestamp();
+  uint64_t timestamp;
+  unsigned int nsamples;
+  unsigned int i;
+  float wave;
+
+  if (!priv->enabled || now < priv->next)
+    {
+      if (priv->enabled)
+        {
+          sim_schedule(priv, sim_worker);
+        }
+
+      return;
+    }
+
+  /* Skip the samples that the FIFO could not hold */
+
+  nsamples = (now - priv->next) / priv->interval + 1;
+  if (nsamples > SIM_SENSOR_FIFO)
+    {
+      priv->next += (uint64_t)(nsamples - SIM_SENSOR_FIFO) * priv->interval;
+      priv->seq  += nsamples - SIM_SENSOR_FIFO;
+      nsamples    = SIM_SENSOR_FIFO;
+    }
+
+  for (i = 0; i < nsamples; i++)
+    {
+      timestamp   = priv->next;
+      wave        = sim_wave(priv->seq++);
+      priv->next += priv->interval;
+
+      if (priv->lower.type == SENSOR_TYPE_ACCELEROMETER)
+        {
+          /* At rest, with some vibration on X */
+
+          priv->fifo.accel[i].timestamp   = timestamp;
+          priv->fifo.accel[i].x           = 0.5f * wave;
+          priv->fifo.accel[i].y           = 0.0f;
+          priv->fifo.accel[i].z           = SENSOR_GRAVITY;
+          priv->fifo.accel[i].temperature = 25.0f;
+        }
+      else
+        {
+          /* Rocking around X, turning slowly around Z */
+
+          priv->fifo.gyro[i].timestamp   = timestamp;
+          priv->fifo.gyro[i].x           = wave;
+          priv->fifo.gyro[i].y           = 0.0f;
+          priv->fifo.gyro[i].z           = 0.1f;
+          priv->fifo.gyro[i].temperature = 25.0f;
+        }
+    }
+
+  priv->lower.push_event(priv->lower.priv, &priv->fifo,
+                         priv->lower.type == SENSOR_TYPE_ACCELEROMETER ?
+                         nsamples * sizeof(struct sensor_event_accel_s) :
+                         nsamples * sizeof(struct sensor_event_gyro_s));
+
+  sim_schedule(priv, sim_worker);
+}
+
+/****************************************************************************
+ * Name: sim_activate
+ ****************************************************************************/
+
+static int sim_activate(FAR struct sensor_lowerhalf_s *lower, bool enable)
+{
+  FAR struct sim_sensor_s *priv = (FAR struct sim_sensor_s *)lower;
+
+  if (enable && !priv->enabled)
+    {
+      priv->next    = sensor_get_timestamp() + priv->interval;
+      priv->enabled = true;
+      sim_schedule(priv, sim_worker);
+    }
+  else if (!enable && priv->enabled)
+    {
+      priv->enabled = false;
+      work_cancel(LPWORK, &priv->work);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: sim_set_interval
+ ****************************************************************************/
+
+static int sim_set_interval(FAR struct sensor_lowerhalf_s *lower,
+                            FAR unsigned int *period_us)
+{
+  FAR struct sim_sensor_s *priv = (FAR struct sim_sensor_s *)lower;
+
+  if (*period_us < SIM_INTERVAL_MIN)
+    {
+      *period_us = SIM_INTERVAL_MIN;
+    }
+  else if (*period_us > SIM_INTERVAL_MAX)
+    {
+      *period_us = SIM_INTERVAL_MAX;
+    }
+
+  priv->interval = *period_us;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: sim_batch
+ ****************************************************************************/
+
+static int sim_batch(FAR struct sensor_lowerhalf_s *lower,
+                     FAR unsigned int *latency_us)
+{
+  FAR struct sim_sensor_s *priv = (FAR struct sim_sensor_s *)lower;
+  unsigned int max = (SIM_SENSOR_FIFO - 1) * priv->interval;
+
+  if (*latency_us > max)
+    {
+      *latency_us = max;
+    }
+
+  priv->latency = *latency_us;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: sim_sensor_register
+ ****************************************************************************/
+
+static int sim_sensor_register(int type, int devno)
+{
+  FAR struct sim_sensor_s *priv;
+  int ret;
+
+  priv = kmm_zalloc(sizeof(struct sim_sensor_s));
+  if (priv == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  priv->lower.type          = type;
+  priv->lower.buffer_number = SIM_SENSOR_FIFO;
+  priv->lower.batch_number  = SIM_SENSOR_FIFO;
+  priv->lower.ops           = &g_sim_sensor_ops;
+  priv->interval            = 10000;
+
+  ret = sensor_register(&priv->lower, devno);
+  if (ret < 0)
+    {
+      kmm_free(priv);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_sensor_initialize
+ *
+ * Description:
+ *   Register a simulated IMU as /dev/sensor/accel<devno> and
+ *   /dev/sensor/gyro<devno>.
+ *
+ ****************************************************************************/
+
+int sim_sensor_initialize(int devno)
+{
+  int ret;
+
+  ret = sim_sensor_register(SENSOR_TYPE_ACCELEROMETER, devno);
+  if (ret < 0)
+    {
+      snerr("ERROR: Failed to register accel: %d\n", ret);
+      return ret;
+    }
+
+  ret = sim_sensor_register(SENSOR_TYPE_GYROSCOPE, devno);
+  if (ret < 0)
+    {
+      snerr("ERROR: Failed to register gyro: %d\n", ret);
+    }
+
+  return ret;
+}
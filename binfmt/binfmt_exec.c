@@ -46,6 +46,7 @@
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/sched.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/binfmt/binfmt.h>
 
 #include "binfmt.h"
@@ -175,6 +176,16 @@ int exec_spawn(FAR const char *filename, FAR char * const *argv,
     {
       berr("ERROR: Failed to schedule unload '%s': %d\n", filename, ret);
     }
+#ifdef CONFIG_FS_RAMMAP
+  else if (bin->mapped != NULL)
+    {
+      /* The new task unmaps the module when it exits, so make it the
+       * owner of the mapping rather than the caller.
+       */
+
+      rammap_transfer(bin->mapped, pid);
+    }
+#endif
 
 #else
   /* Free the binary_s structure here */
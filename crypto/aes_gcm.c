@@ -0,0 +1,445 @@
+/****************************************************************************
+ * crypto/aes_gcm.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/crypto/aes.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define GETBE64(p) \
+  (((uint64_t)(p)[0] << 56) | ((uint64_t)(p)[1] << 48) | \
+   ((uint64_t)(p)[2] << 40) | ((uint64_t)(p)[3] << 32) | \
+   ((uint64_t)(p)[4] << 24) | ((uint64_t)(p)[5] << 16) | \
+   ((uint64_t)(p)[6] << 8)  | (uint64_t)(p)[7])
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Reduction of the four bits shifted out of the 128-bit product, modulo the
+ * GCM polynomial x^128 + x^7 + x^2 + x + 1 (bit-reflected).
+ */
+
+static const uint16_t g_last4[16] =
+{
+  0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+  0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void putbe64(FAR uint8_t *p, uint64_t v)
+{
+  int i;
+
+  for (i = 7; i >= 0; i--)
+    {
+      p[i] = (uint8_t)v;
+      v >>= 8;
+    }
+}
+
+/****************************************************************************
+ * Name: gcm_gen_table
+ *
+ * Description:
+ *   Precompute the multiples of the hash subkey H = E(K, 0^128) by all
+ *   4-bit values, so that GHASH can process a nibble per table lookup
+ *   (Shoup's method) instead of a bit per iteration.
+ *
+ ****************************************************************************/
+
+static void gcm_gen_table(FAR struct aes_gcm_s *gcm)
+{
+  uint8_t h[AES_BLOCK_SIZE];
+  uint64_t vh;
+  uint64_t vl;
+  uint32_t t;
+  int i;
+  int j;
+
+  memset(h, 0, AES_BLOCK_SIZE);
+  aes_encipher(&gcm->aes, h, 1);
+
+  vh = GETBE64(h);
+  vl = GETBE64(h + 8);
+
+  gcm->hl[8] = vl;
+  gcm->hh[8] = vh;
+  gcm->hl[0] = 0;
+  gcm->hh[0] = 0;
+
+  for (i = 4; i > 0; i >>= 1)
+    {
+      t  = (uint32_t)(vl & 1) * 0xe1000000u;
+      vl = (vh << 63) | (vl >> 1);
+      vh = (vh >> 1) ^ ((uint64_t)t << 32);
+
+      gcm->hl[i] = vl;
+      gcm->hh[i] = vh;
+    }
+
+  for (i = 2; i <= 8; i *= 2)
+    {
+      vh = gcm->hh[i];
+      vl = gcm->hl[i];
+
+      for (j = 1; j < i; j++)
+        {
+          gcm->hh[i + j] = vh ^ gcm->hh[j];
+          gcm->hl[i + j] = vl ^ gcm->hl[j];
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: gcm_mult
+ *
+ * Description:
+ *   Multiply the GHASH accumulator by H in GF(2^128), in place.
+ *
+ ****************************************************************************/
+
+static void gcm_mult(FAR struct aes_gcm_s *gcm, FAR uint8_t *x)
+{
+  uint64_t zh;
+  uint64_t zl;
+  uint8_t rem;
+  uint8_t lo;
+  uint8_t hi;
+  int i;
+
+  lo = x[15] & 0x0f;
+  zh = gcm->hh[lo];
+  zl = gcm->hl[lo];
+
+  for (i = 15; i >= 0; i--)
+    {
+      lo = x[i] & 0x0f;
+      hi = x[i] >> 4;
+
+      if (i != 15)
+        {
+          rem = (uint8_t)zl & 0x0f;
+          zl  = (zh << 60) | (zl >> 4);
+          zh  = (zh >> 4) ^ ((uint64_t)g_last4[rem] << 48);
+          zh ^= gcm->hh[lo];
+          zl ^= gcm->hl[lo];
+        }
+
+      rem = (uint8_t)zl & 0x0f;
+      zl  = (zh << 60) | (zl >> 4);
+      zh  = (zh >> 4) ^ ((uint64_t)g_last4[rem] << 48);
+      zh ^= gcm->hh[hi];
+      zl ^= gcm->hl[hi];
+    }
+
+  putbe64(x, zh);
+  putbe64(x + 8, zl);
+}
+
+/****************************************************************************
+ * Name: gcm_next_stream
+ *
+ * Description:
+ *   Increment the low 32 bits of the counter block and encipher it.
+ *
+ ****************************************************************************/
+
+static void gcm_next_stream(FAR struct aes_gcm_s *gcm)
+{
+  int i;
+
+  for (i = AES_BLOCK_SIZE - 1; i >= AES_BLOCK_SIZE - 4; i--)
+    {
+      if (++gcm->counter[i] != 0)
+        {
+          break;
+        }
+    }
+
+  memcpy(gcm->stream, gcm->counter, AES_BLOCK_SIZE);
+  aes_encipher(&gcm->aes, gcm->stream, 1);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aes_gcm_setupkey
+ *
+ * Description:
+ *   Expand the key and precompute the GHASH table of a GCM context.
+ *
+ ****************************************************************************/
+
+int aes_gcm_setupkey(FAR struct aes_gcm_s *gcm, FAR const uint8_t *key,
+                     int len)
+{
+  int ret;
+
+  ret = aes_setupkey(&gcm->aes, key, len);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  gcm_gen_table(gcm);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: aes_gcm_start
+ *
+ * Description:
+ *   Start a new GCM message with the given IV.
+ *
+ ****************************************************************************/
+
+int aes_gcm_start(FAR struct aes_gcm_s *gcm, FAR const uint8_t *iv,
+                  size_t ivlen, int encrypt)
+{
+  uint64_t ivbits;
+  size_t chunk;
+  size_t i;
+
+  if (ivlen == 0)
+    {
+      return -EINVAL;
+    }
+
+  memset(gcm->ghash, 0, AES_BLOCK_SIZE);
+  memset(gcm->counter, 0, AES_BLOCK_SIZE);
+
+  if (ivlen == 12)
+    {
+      /* J0 = IV || 0^31 || 1 */
+
+      memcpy(gcm->counter, iv, ivlen);
+      gcm->counter[15] = 1;
+    }
+  else
+    {
+      /* J0 = GHASH(IV || 0^s || 0^64 || [len(IV)]64) */
+
+      uint8_t work[AES_BLOCK_SIZE];
+
+      ivbits = (uint64_t)ivlen * 8;
+      for (; ivlen > 0; ivlen -= chunk, iv += chunk)
+        {
+          chunk = ivlen < AES_BLOCK_SIZE ? ivlen : AES_BLOCK_SIZE;
+          for (i = 0; i < chunk; i++)
+            {
+              gcm->counter[i] ^= iv[i];
+            }
+
+          gcm_mult(gcm, gcm->counter);
+        }
+
+      memset(work, 0, AES_BLOCK_SIZE);
+      putbe64(work + 8, ivbits);
+      for (i = 0; i < AES_BLOCK_SIZE; i++)
+        {
+          gcm->counter[i] ^= work[i];
+        }
+
+      gcm_mult(gcm, gcm->counter);
+    }
+
+  memcpy(gcm->ek0, gcm->counter, AES_BLOCK_SIZE);
+  aes_encipher(&gcm->aes, gcm->ek0, 1);
+
+  gcm->aadlen  = 0;
+  gcm->textlen = 0;
+  gcm->encrypt = encrypt != 0;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: aes_gcm_aad
+ *
+ * Description:
+ *   Add additional authenticated data to the current message.
+ *
+ ****************************************************************************/
+
+int aes_gcm_aad(FAR struct aes_gcm_s *gcm, FAR const uint8_t *aad,
+                size_t len)
+{
+  unsigned int offset;
+
+  if (gcm->textlen != 0)
+    {
+      return -EINVAL;
+    }
+
+  while (len > 0)
+    {
+      offset = gcm->aadlen % AES_BLOCK_SIZE;
+      gcm->ghash[offset] ^= *aad++;
+      gcm->aadlen++;
+      len--;
+
+      if (offset == AES_BLOCK_SIZE - 1)
+        {
+          gcm_mult(gcm, gcm->ghash);
+        }
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: aes_gcm_update
+ *
+ * Description:
+ *   Encrypt or decrypt the next len bytes of the message.
+ *
+ ****************************************************************************/
+
+void aes_gcm_update(FAR struct aes_gcm_s *gcm, FAR uint8_t *out,
+                    FAR const uint8_t *in, size_t len)
+{
+  unsigned int offset;
+  uint8_t c;
+  size_t i;
+
+  /* The AAD is zero-padded to a full block before the cipher text */
+
+  if (gcm->textlen == 0 && gcm->aadlen % AES_BLOCK_SIZE != 0 && len > 0)
+    {
+      gcm_mult(gcm, gcm->ghash);
+    }
+
+  /* Finish a partial block left over from the previous call */
+
+  offset = gcm->textlen % AES_BLOCK_SIZE;
+  while (offset != 0 && len > 0)
+    {
+      c = *in++;
+      *out = c ^ gcm->stream[offset];
+      gcm->ghash[offset] ^= gcm->encrypt ? *out : c;
+      out++;
+      len--;
+
+      gcm->textlen++;
+      if (++offset == AES_BLOCK_SIZE)
+        {
+          gcm_mult(gcm, gcm->ghash);
+          offset = 0;
+        }
+    }
+
+  /* Full blocks */
+
+  for (; len >= AES_BLOCK_SIZE; len -= AES_BLOCK_SIZE)
+    {
+      gcm_next_stream(gcm);
+
+      for (i = 0; i < AES_BLOCK_SIZE; i++)
+        {
+          c = in[i];
+          out[i] = c ^ gcm->stream[i];
+          gcm->ghash[i] ^= gcm->encrypt ? out[i] : c;
+        }
+
+      gcm_mult(gcm, gcm->ghash);
+
+      gcm->textlen += AES_BLOCK_SIZE;
+      out          += AES_BLOCK_SIZE;
+      in           += AES_BLOCK_SIZE;
+    }
+
+  /* Start of a trailing partial block */
+
+  if (len > 0)
+    {
+      gcm_next_stream(gcm);
+
+      for (i = 0; i < len; i++)
+        {
+          c = in[i];
+          out[i] = c ^ gcm->stream[i];
+          gcm->ghash[i] ^= gcm->encrypt ? out[i] : c;
+        }
+
+      gcm->textlen += len;
+    }
+}
+
+/****************************************************************************
+ * Name: aes_gcm_finish
+ *
+ * Description:
+ *   Finish the message and return the authentication tag.
+ *
+ ****************************************************************************/
+
+void aes_gcm_finish(FAR struct aes_gcm_s *gcm, FAR uint8_t *tag,
+                    size_t taglen)
+{
+  uint8_t work[AES_BLOCK_SIZE];
+  size_t i;
+
+  /* Flush the partial block of either the AAD (when there was no text) or
+   * of the text.
+   */
+
+  if ((gcm->textlen == 0 && gcm->aadlen % AES_BLOCK_SIZE != 0) ||
+      gcm->textlen % AES_BLOCK_SIZE != 0)
+    {
+      gcm_mult(gcm, gcm->ghash);
+    }
+
+  putbe64(work, gcm->aadlen * 8);
+  putbe64(work + 8, gcm->textlen * 8);
+
+  for (i = 0; i < AES_BLOCK_SIZE; i++)
+    {
+      gcm->ghash[i] ^= work[i];
+    }
+
+  gcm_mult(gcm, gcm->ghash);
+
+  if (taglen > AES_BLOCK_SIZE)
+    {
+      taglen = AES_BLOCK_SIZE;
+    }
+
+  for (i = 0; i < taglen; i++)
+    {
+      tag[i] = gcm->ghash[i] ^ gcm->ek0[i];
+    }
+}
@@ -0,0 +1,235 @@
+/****************************************************************************
+ * crypto/aes_ni.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/crypto/aes.h>
+
+#include "aes_ni.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* CPUID.01H:ECX.AESNI[bit 25] */
+
+#define CPUID_ECX_AESNI  (1 << 25)
+
+/* Number of blocks kept in flight.  AESENC has a latency of several cycles
+ * but a throughput of one per cycle, so independent blocks are interleaved.
+ */
+
+#define AESNI_NINTERLEAVE 4
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+typedef long long aesni_block_t __attribute__((vector_size(16)));
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static int g_aesni_supported = -1;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline aesni_block_t aesni_load(FAR const void *ptr)
+{
+  aesni_block_t block;
+
+  memcpy(&block, ptr, sizeof(block));
+  return block;
+}
+
+static inline void aesni_store(FAR void *ptr, aesni_block_t block)
+{
+  memcpy(ptr, &block, sizeof(block));
+}
+
+static inline void aesni_load_keys(FAR aesni_block_t *keys,
+                                   FAR const uint32_t *rk, int nr)
+{
+  int i;
+
+  for (i = 0; i <= nr; i++)
+    {
+      keys[i] = aesni_load(rk + 4 * i);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aesni_supported
+ ****************************************************************************/
+
+bool aesni_supported(void)
+{
+  uint32_t eax;
+  uint32_t ebx;
+  uint32_t ecx;
+  uint32_t edx;
+
+  if (g_aesni_supported < 0)
+    {
+      eax = 1;
+      ecx = 0;
+      __asm__ __volatile__("cpuid"
+                           : "+a"(eax), "=b"(ebx), "+c"(ecx), "=d"(edx));
+
+      g_aesni_supported = (ecx & CPUID_ECX_AESNI) != 0;
+    }
+
+  return g_aesni_supported != 0;
+}
+
+/****************************************************************************
+ * Name: aesni_encipher
+ ****************************************************************************/
+
+void aesni_encipher(FAR const uint32_t *rk, int nr, FAR uint8_t *blocks,
+                    int nblk)
+{
+  aesni_block_t keys[AES_MAXNR + 1];
+  aesni_block_t b[AESNI_NINTERLEAVE];
+  int round;
+  int i;
+
+  aesni_load_keys(keys, rk, nr);
+
+  for (; nblk >= AESNI_NINTERLEAVE; nblk -= AESNI_NINTERLEAVE)
+    {
+      for (i = 0; i < AESNI_NINTERLEAVE; i++)
+        {
+          b[i] = aesni_load(blocks + i * AES_BLOCK_SIZE) ^ keys[0];
+        }
+
+      for (round = 1; round < nr; round++)
+        {
+          __asm__("aesenc %4, %0\n\t"
+                  "aesenc %4, %1\n\t"
+                  "aesenc %4, %2\n\t"
+                  "aesenc %4, %3"
+                  : "+x"(b[0]), "+x"(b[1]), "+x"(b[2]), "+x"(b[3])
+                  : "x"(keys[round]));
+        }
+
+      __asm__("aesenclast %4, %0\n\t"
+              "aesenclast %4, %1\n\t"
+              "aesenclast %4, %2\n\t"
+              "aesenclast %4, %3"
+              : "+x"(b[0]), "+x"(b[1]), "+x"(b[2]), "+x"(b[3])
+              : "x"(keys[nr]));
+
+      for (i = 0; i < AESNI_NINTERLEAVE; i++)
+        {
+          aesni_store(blocks + i * AES_BLOCK_SIZE, b[i]);
+        }
+
+      blocks += AESNI_NINTERLEAVE * AES_BLOCK_SIZE;
+    }
+
+  for (; nblk > 0; nblk--)
+    {
+      b[0] = aesni_load(blocks) ^ keys[0];
+      for (round = 1; round < nr; round++)
+        {
+          __asm__("aesenc %1, %0" : "+x"(b[0]) : "x"(keys[round]));
+        }
+
+      __asm__("aesenclast %1, %0" : "+x"(b[0]) : "x"(keys[nr]));
+      aesni_store(blocks, b[0]);
+      blocks += AES_BLOCK_SIZE;
+    }
+}
+
+/****************************************************************************
+ * Name: aesni_decipher
+ ****************************************************************************/
+
+void aesni_decipher(FAR const uint32_t *rk, int nr, FAR uint8_t *blocks,
+                    int nblk)
+{
+  aesni_block_t keys[AES_MAXNR + 1];
+  aesni_block_t b[AESNI_NINTERLEAVE];
+  int round;
+  int i;
+
+  aesni_load_keys(keys, rk, nr);
+
+  for (; nblk >= AESNI_NINTERLEAVE; nblk -= AESNI_NINTERLEAVE)
+    {
+      for (i = 0; i < AESNI_NINTERLEAVE; i++)
+        {
+          b[i] = aesni_load(blocks + i * AES_BLOCK_SIZE) ^ keys[0];
+        }
+
+      for (round = 1; round < nr; round++)
+        {
+          __asm__("aesdec %4, %0\n\t"
+                  "aesdec %4, %1\n\t"
+                  "aesdec %4, %2\n\t"
+                  "aesdec %4, %3"
+                  : "+x"(b[0]), "+x"(b[1]), "+x"(b[2]), "+x"(b[3])
+                  : "x"(keys[round]));
+        }
+
+      __asm__("aesdeclast %4, %0\n\t"
+              "aesdeclast %4, %1\n\t"
+              "aesdeclast %4, %2\n\t"
+              "aesdeclast %4, %3"
+              : "+x"(b[0]), "+x"(b[1]), "+x"(b[2]), "+x"(b[3])
+              : "x"(keys[nr]));
+
+      for (i = 0; i < AESNI_NINTERLEAVE; i++)
+        {
+          aesni_store(blocks + i * AES_BLOCK_SIZE, b[i]);
+        }
+
+      blocks += AESNI_NINTERLEAVE * AES_BLOCK_SIZE;
+    }
+
+  for (; nblk > 0; nblk--)
+    {
+      b[0] = aesni_load(blocks) ^ keys[0];
+      for (round = 1; round < nr; round++)
+        {
+          __asm__("aesdec %1, %0" : "+x"(b[0]) : "x"(keys[round]));
+        }
+
+      __asm__("aesdeclast %1, %0" : "+x"(b[0]) : "x"(keys[nr]));
+      aesni_store(blocks, b[0]);
+      blocks += AES_BLOCK_SIZE;
+    }
+}
@@ -0,0 +1,75 @@
+/****************************************************************************
+ * crypto/aes_ni.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __CRYPTO_AES_NI_H
+#define __CRYPTO_AES_NI_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef CONFIG_CRYPTO_AES_NI
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aesni_supported
+ *
+ * Description:
+ *   Return true if the host CPU implements the AES-NI instructions.  The
+ *   CPUID probe is done once and cached.
+ *
+ ****************************************************************************/
+
+bool aesni_supported(void);
+
+/****************************************************************************
+ * Name: aesni_encipher
+ *
+ * Description:
+ *   Encipher nblk 16-byte blocks in place with AESENC/AESENCLAST.  rk holds
+ *   the encryption round keys in FIPS-197 byte order.
+ *
+ ****************************************************************************/
+
+void aesni_encipher(FAR const uint32_t *rk, int nr, FAR uint8_t *blocks,
+                    int nblk);
+
+/****************************************************************************
+ * Name: aesni_decipher
+ *
+ * Description:
+ *   Decipher nblk 16-byte blocks in place with AESDEC/AESDECLAST.  rk holds
+ *   the round keys of the equivalent inverse cipher.
+ *
+ ****************************************************************************/
+
+void aesni_decipher(FAR const uint32_t *rk, int nr, FAR uint8_t *blocks,
+                    int nblk);
+
+#endif /* CONFIG_CRYPTO_AES_NI */
+#endif /* __CRYPTO_AES_NI_H */
@@ -44,13 +44,21 @@
 #include <string.h>
 #include <poll.h>
 #include <errno.h>
+#include <debug.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/drivers/drivers.h>
 
 #include <nuttx/crypto/crypto.h>
 #include <nuttx/crypto/cryptodev.h>
 
+#ifdef CONFIG_CRYPTO_SW_AES
+#  include <nuttx/crypto/aes.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -61,12 +69,104 @@
              mode, encrypt)
 #endif
 
+#define CRYPTODEV_MAX_KEYLEN 32
+
+#ifdef CONFIG_CRYPTO_CRYPTODEV_BATCH
+#  ifdef CONFIG_SCHED_LPWORK
+#    define CRYPTODEV_WORK LPWORK
+#  else
+#    define CRYPTODEV_WORK HPWORK
+#  endif
+
+#  define CRYPTODEV_NJOBS CONFIG_CRYPTO_CRYPTODEV_NJOBS
+#endif
+
+#define CRYPTODEV_BLKSIZE    16     /* AES block, IV and GCM tag size */
+#define CRYPTODEV_GCM_IVLEN  12
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A session created by CIOCGSESSION.  The key is copied, and expanded once
+ * if the software AES library is used, so that individual operations do
+ * not repeat the key setup.
+ */
+
+struct cryptodev_session_s
+{
+  FAR struct cryptodev_session_s *flink;
+  sem_t exclsem;                    /* Serializes operations on the session */
+  uint32_t id;                      /* Session number returned to the user */
+  uint32_t cipher;                  /* CRYPTO_AES_* */
+  uint32_t keylen;                  /* Key length in bytes */
+  uint8_t crefs;                    /* Operations in progress */
+  bool released;                    /* CIOCFSESSION was called */
+  uint8_t key[CRYPTODEV_MAX_KEYLEN];
+#ifdef CONFIG_CRYPTO_SW_AES
+  union
+  {
+    struct aes_state_s aes;         /* Expanded key (ECB, CBC, CTR) */
+#ifdef CONFIG_CRYPTO_SW_AES_GCM
+    struct aes_gcm_s gcm;           /* Expanded key and GHASH table (GCM) */
+#endif
+  } u;
+#endif
+};
+
+#ifdef CONFIG_CRYPTO_CRYPTODEV_BATCH
+/* A queued job.  The worker runs on the kernel work queue, where the
+ * caller's buffers may not be mapped, so it works on kernel copies: the
+ * data in buf, processed in place, and the IV and tag.  The output is
+ * copied to the caller's buffers when the job is reaped.
+ */
+
+struct cryptodev_job_s
+{
+  struct crypt_job job;             /* The job as submitted */
+  struct crypt_op op;               /* The same operation on the copies */
+  FAR uint8_t *buf;                 /* Copy of the data */
+  uint8_t iv[CRYPTODEV_BLKSIZE];    /* Copy of the IV */
+  uint8_t mac[CRYPTODEV_BLKSIZE];   /* Copy of the GCM tag */
+};
+#endif
+
+/* The state of one open of /dev/crypto */
+
+struct cryptodev_file_s
+{
+  sem_t exclsem;                    /* Protects the fields below */
+  FAR struct cryptodev_session_s *sessions;
+  uint32_t nextid;                  /* Next session number */
+
+#ifdef CONFIG_CRYPTO_CRYPTODEV_BATCH
+  /* Job ring.  Jobs in [head, done) are complete but not yet reaped, jobs
+   * in [done, tail) wait for the worker.  The indices run freely and are
+   * reduced modulo CRYPTODEV_NJOBS on access.
+   */
+
+  struct work_s work;               /* Worker on the kernel work queue */
+  sem_t waitsem;                    /* CIOCREAP waits here for completions */
+  sem_t exitsem;                    /* close() waits here for the worker */
+  bool running;                     /* The worker is queued or running */
+  bool closing;                     /* close() is in progress */
+  uint8_t nwaiters;                 /* Number of threads waiting on waitsem */
+  unsigned int head;
+  unsigned int done;
+  unsigned int tail;
+  struct cryptodev_job_s jobs[CRYPTODEV_NJOBS];
+  FAR struct pollfd *fds[CONFIG_CRYPTO_CRYPTODEV_NPOLLWAITERS];
+#endif
+};
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
 
 /* Character driver methods */
 
+static int cryptodev_open(FAR struct file *filep);
+static int cryptodev_close(FAR struct file *filep);
 static ssize_t cryptodev_read(FAR struct file *filep,
                               FAR char *buffer,
                               size_t len);
@@ -76,6 +176,10 @@ static ssize_t cryptodev_write(FAR struct file *filep,
 static int cryptodev_ioctl(FAR struct file *filep,
                            int cmd,
                            unsigned long arg);
+#ifdef CONFIG_CRYPTO_CRYPTODEV_BATCH
+static int cryptodev_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                          bool setup);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -83,13 +187,17 @@ static int cryptodev_ioctl(FAR struct file *filep,
 
 static const struct file_operations g_cryptodevops =
 {
-  NULL,               /* open   */
-  NULL,               /* close  */
+  cryptodev_open,     /* open   */
+  cryptodev_close,    /* close  */
   cryptodev_read,     /* read   */
   cryptodev_write,    /* write  */
   NULL,               /* seek   */
   cryptodev_ioctl,    /* ioctl  */
+#ifdef CONFIG_CRYPTO_CRYPTODEV_BATCH
+  cryptodev_poll      /* poll   */
+#else
   NULL                /* poll   */
+#endif
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   , NULL              /* unlink */
 #endif
@@ -99,6 +207,946 @@ static const struct file_operations g_cryptodevops =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: cryptodev_session_get
+ *
+ * Description:
+ *   Look up a session by number and take a reference to it.  Called with
+ *   the file structure locked.
+ *
+ ****************************************************************************/
+
+static FAR struct cryptodev_session_s *
+cryptodev_session_get(FAR struct cryptodev_file_s *fh, uint32_t id)
+{
+  FAR struct cryptodev_session_s *ses;
+
+  for (ses = fh->sessions; ses != NULL; ses = ses->flink)
+    {
+      if (ses->id == id)
+        {
+          ses->crefs++;
+          return ses;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: cryptodev_session_put
+ *
+ * Description:
+ *   Drop a reference taken by cryptodev_session_get() and free the session
+ *   if it was released in the meantime.  Called with the file structure
+ *   locked.
+ *
+ ****************************************************************************/
+
+static void cryptodev_session_put(FAR struct cryptodev_session_s *ses)
+{
+  DEBUGASSERT(ses->crefs > 0);
+
+  if (--ses->crefs == 0 && ses->released)
+    {
+      nxsem_destroy(&ses->exclsem);
+      kmm_free(ses);
+    }
+}
+
+/****************************************************************************
+ * Name: cryptodev_session_create
+ ****************************************************************************/
+
+static int cryptodev_session_create(FAR struct cryptodev_file_s *fh,
+                                    FAR struct session_op *sop)
+{
+  FAR struct cryptodev_session_s *ses;
+  int ret = OK;
+
+  if (sop->key == NULL || sop->keylen > CRYPTODEV_MAX_KEYLEN)
+    {
+      return -EINVAL;
+    }
+
+  switch (sop->cipher)
+    {
+      case CRYPTO_AES_ECB:
+      case CRYPTO_AES_CBC:
+      case CRYPTO_AES_CTR:
+#ifdef CONFIG_CRYPTO_SW_AES_GCM
+      case CRYPTO_AES_GCM:
+#endif
+        break;
+
+      default:
+        return -EINVAL;
+    }
+
+  ses = kmm_zalloc(sizeof(struct cryptodev_session_s));
+  if (ses == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  nxsem_init(&ses->exclsem, 0, 1);
+  ses->cipher = sop->cipher;
+  ses->keylen = sop->keylen;
+  memcpy(ses->key, sop->key, sop->keylen);
+
+#ifdef CONFIG_CRYPTO_SW_AES
+  /* Expand the key now so that it is not done for every operation */
+
+#ifdef CONFIG_CRYPTO_SW_AES_GCM
+  if (ses->cipher == CRYPTO_AES_GCM)
+    {
+      ret = aes_gcm_setupkey(&ses->u.gcm, ses->key, ses->keylen);
+    }
+  else
+#endif
+    {
+      ret = aes_setupkey(&ses->u.aes, ses->key, ses->keylen);
+    }
+
+  if (ret < 0)
+    {
+      nxsem_destroy(&ses->exclsem);
+      kmm_free(ses);
+      return ret;
+    }
+#endif
+
+  ret = nxsem_wait(&fh->exclsem);
+  if (ret < 0)
+    {
+      nxsem_destroy(&ses->exclsem);
+      kmm_free(ses);
+      return ret;
+    }
+
+  ses->id      = ++fh->nextid;
+  ses->flink   = fh->sessions;
+  fh->sessions = ses;
+  sop->ses     = ses->id;
+
+  nxsem_post(&fh->exclsem);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: cryptodev_session_release
+ ****************************************************************************/
+
+static int cryptodev_session_release(FAR struct cryptodev_file_s *fh,
+                                     uint32_t id)
+{
+  FAR struct cryptodev_session_s *prev = NULL;
+  FAR struct cryptodev_session_s *ses;
+  int ret;
+
+  ret = nxsem_wait(&fh->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (ses = fh->sessions; ses != NULL; prev = ses, ses = ses->flink)
+    {
+      if (ses->id == id)
+        {
+          break;
+        }
+    }
+
+  if (ses == NULL)
+    {
+      nxsem_post(&fh->exclsem);
+      return -EINVAL;
+    }
+
+  if (prev != NULL)
+    {
+      prev->flink = ses->flink;
+    }
+  else
+    {
+      fh->sessions = ses->flink;
+    }
+
+  /* Free it now unless an operation still uses it */
+
+  ses->released = true;
+  ses->crefs++;
+  cryptodev_session_put(ses);
+
+  nxsem_post(&fh->exclsem);
+  return OK;
+}
+
+#ifdef CONFIG_CRYPTO_SW_AES
+/****************************************************************************
+ * Name: cryptodev_sw_aes
+ *
+ * Description:
+ *   ECB, CBC and CTR modes on top of the software AES library, using the
+ *   key schedule cached in the session.
+ *
+ ****************************************************************************/
+
+static int cryptodev_sw_aes(FAR struct crypt_op *op,
+                            FAR struct cryptodev_session_s *ses,
+                            int encrypt)
+{
+  FAR const uint8_t *src = (FAR const uint8_t *)op->src;
+  FAR uint8_t *dst = (FAR uint8_t *)op->dst;
+  uint8_t iv[AES_BLOCK_SIZE];
+  uint8_t blk[AES_BLOCK_SIZE];
+  size_t len = op->len;
+  size_t chunk;
+  int i;
+
+  if (ses->cipher != CRYPTO_AES_CTR && (len % AES_BLOCK_SIZE) != 0)
+    {
+      return -EINVAL;
+    }
+
+  if (ses->cipher != CRYPTO_AES_ECB)
+    {
+      if (op->iv == NULL)
+        {
+          return -EINVAL;
+        }
+
+      memcpy(iv, op->iv, AES_BLOCK_SIZE);
+    }
+
+  switch (ses->cipher)
+    {
+      case CRYPTO_AES_ECB:
+        memmove(dst, src, len);
+        if (encrypt)
+          {
+            aes_encipher(&ses->u.aes, dst, len / AES_BLOCK_SIZE);
+          }
+        else
+          {
+            aes_decipher(&ses->u.aes, dst, len / AES_BLOCK_SIZE);
+          }
+        break;
+
+      case CRYPTO_AES_CBC:
+        for (; len > 0; len -= AES_BLOCK_SIZE)
+          {
+            memcpy(blk, src, AES_BLOCK_SIZE);
+            if (encrypt)
+              {
+                for (i = 0; i < AES_BLOCK_SIZE; i++)
+                  {
+                    dst[i] = blk[i] ^ iv[i];
+                  }
+
+                aes_encipher(&ses->u.aes, dst, 1);
+                memcpy(iv, dst, AES_BLOCK_SIZE);
+              }
+            else
+              {
+                memcpy(dst, blk, AES_BLOCK_SIZE);
+                aes_decipher(&ses->u.aes, dst, 1);
+                for (i = 0; i < AES_BLOCK_SIZE; i++)
+                  {
+                    dst[i] ^= iv[i];
+                  }
+
+                memcpy(iv, blk, AES_BLOCK_SIZE);
+              }
+
+            src += AES_BLOCK_SIZE;
+            dst += AES_BLOCK_SIZE;
+          }
+        break;
+
+      case CRYPTO_AES_CTR:
+        for (; len > 0; len -= chunk)
+          {
+            memcpy(blk, iv, AES_BLOCK_SIZE);
+            aes_encipher(&ses->u.aes, blk, 1);
+
+            chunk = len < AES_BLOCK_SIZE ? len : AES_BLOCK_SIZE;
+            for (i = 0; i < chunk; i++)
+              {
+                dst[i] = src[i] ^ blk[i];
+              }
+
+            for (i = AES_BLOCK_SIZE - 1; i >= 0; i--)
+              {
+                if (++iv[i] != 0)
+                  {
+                    break;
+                  }
+              }
+
+            src += chunk;
+            dst += chunk;
+          }
+        break;
+
+      default:
+        return -EINVAL;
+    }
+
+  return OK;
+}
+#endif
+
+#ifdef CONFIG_CRYPTO_SW_AES_GCM
+/****************************************************************************
+ * Name: cryptodev_gcm
+ *
+ * Description:
+ *   AES-GCM with a 12-byte IV.  The 16-byte tag is returned in (encrypt)
+ *   or checked against (decrypt) op->mac.
+ *
+ ****************************************************************************/
+
+static int cryptodev_gcm(FAR struct crypt_op *op,
+                         FAR struct cryptodev_session_s *ses, int encrypt)
+{
+  FAR struct aes_gcm_s *gcm = &ses->u.gcm;
+  uint8_t tag[AES_BLOCK_SIZE];
+  uint8_t diff;
+  int i;
+
+  if (op->iv == NULL || op->mac == NULL)
+    {
+      return -EINVAL;
+    }
+
+  aes_gcm_start(gcm, (FAR const uint8_t *)op->iv, 12, encrypt);
+  aes_gcm_update(gcm, (FAR uint8_t *)op->dst, (FAR const uint8_t *)op->src,
+                 op->len);
+  aes_gcm_finish(gcm, tag, AES_BLOCK_SIZE);
+
+  if (encrypt)
+    {
+      memcpy(op->mac, tag, AES_BLOCK_SIZE);
+      return OK;
+    }
+
+  /* Compare the whole tag so that the time taken does not depend on the
+   * position of the first mismatch.
+   */
+
+  for (diff = 0, i = 0; i < AES_BLOCK_SIZE; i++)
+    {
+      diff |= tag[i] ^ (uint8_t)op->mac[i];
+    }
+
+  return diff != 0 ? -EBADMSG : OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: cryptodev_process
+ *
+ * Description:
+ *   Perform one operation on a session.  Shared by CIOCCRYPT and the batch
+ *   worker.
+ *
+ ****************************************************************************/
+
+static int cryptodev_process(FAR struct cryptodev_session_s *ses,
+                             FAR struct crypt_op *op)
+{
+  int encrypt;
+  int ret;
+
+  switch (op->op)
+    {
+      case COP_ENCRYPT:
+        encrypt = 1;
+        break;
+
+      case COP_DECRYPT:
+        encrypt = 0;
+        break;
+
+      default:
+        return -EINVAL;
+    }
+
+  ret = nxsem_wait_uninterruptible(&ses->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  switch (ses->cipher)
+    {
+#if defined(CONFIG_CRYPTO_AES)
+      case CRYPTO_AES_ECB:
+        ret = AES_CYPHER(AES_MODE_ECB);
+        break;
+
+      case CRYPTO_AES_CBC:
+        ret = AES_CYPHER(AES_MODE_CBC);
+        break;
+
+      case CRYPTO_AES_CTR:
+        ret = AES_CYPHER(AES_MODE_CTR);
+        break;
+#elif defined(CONFIG_CRYPTO_SW_AES)
+      case CRYPTO_AES_ECB:
+      case CRYPTO_AES_CBC:
+      case CRYPTO_AES_CTR:
+        ret = cryptodev_sw_aes(op, ses, encrypt);
+        break;
+#endif
+
+#ifdef CONFIG_CRYPTO_SW_AES_GCM
+      case CRYPTO_AES_GCM:
+        ret = cryptodev_gcm(op, ses, encrypt);
+        break;
+#endif
+
+      default:
+        ret = -EINVAL;
+        break;
+    }
+
+  nxsem_post(&ses->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: cryptodev_crypt
+ *
+ * Description:
+ *   Handle CIOCCRYPT: one synchronous operation.
+ *
+ ****************************************************************************/
+
+static int cryptodev_crypt(FAR struct cryptodev_file_s *fh,
+                           FAR struct crypt_op *op)
+{
+  FAR struct cryptodev_session_s *ses;
+  int ret;
+
+  ret = nxsem_wait(&fh->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ses = cryptodev_session_get(fh, op->ses);
+  nxsem_post(&fh->exclsem);
+
+  if (ses == NULL)
+    {
+      return -EINVAL;
+    }
+
+  ret = cryptodev_process(ses, op);
+
+  nxsem_wait_uninterruptible(&fh->exclsem);
+  cryptodev_session_put(ses);
+  nxsem_post(&fh->exclsem);
+
+  return ret;
+}
+
+#ifdef CONFIG_CRYPTO_CRYPTODEV_BATCH
+/****************************************************************************
+ * Name: cryptodev_pollnotify
+ *
+ * Description:
+ *   Report POLLIN to the poll waiters.  Called with the file structure
+ *   locked.
+ *
+ ****************************************************************************/
+
+static void cryptodev_pollnotify(FAR struct cryptodev_file_s *fh)
+{
+  FAR struct pollfd *fds;
+  int i;
+
+  for (i = 0; i < CONFIG_CRYPTO_CRYPTODEV_NPOLLWAITERS; i++)
+    {
+      fds = fh->fds[i];
+      if (fds != NULL)
+        {
+          fds->revents |= (fds->events & POLLIN);
+          if (fds->revents != 0)
+            {
+              nxsem_post(fds->sem);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: cryptodev_worker
+ *
+ * Description:
+ *   Process the submitted jobs in order on the kernel work queue.  The
+ *   worker keeps going as long as new jobs arrive, so that a busy ring is
+ *   drained without going back through the work queue.
+ *
+ ****************************************************************************/
+
+static void cryptodev_worker(FAR void *arg)
+{
+  FAR struct cryptodev_file_s *fh = (FAR struct cryptodev_file_s *)arg;
+  FAR struct cryptodev_session_s *ses;
+  FAR struct cryptodev_job_s *job;
+  int ret;
+
+  nxsem_wait_uninterruptible(&fh->exclsem);
+
+  while (fh->done != fh->tail && !fh->closing)
+    {
+      job = &fh->jobs[fh->done % CRYPTODEV_NJOBS];
+      ses = cryptodev_session_get(fh, job->op.ses);
+      nxsem_post(&fh->exclsem);
+
+      if (ses != NULL)
+        {
+          ret = cryptodev_process(ses, &job->op);
+        }
+      else
+        {
+          ret = -EINVAL;
+        }
+
+      nxsem_wait_uninterruptible(&fh->exclsem);
+
+      if (ses != NULL)
+        {
+          cryptodev_session_put(ses);
+        }
+
+      job->job.result = ret;
+      fh->done++;
+
+      /* Wake up the reapers */
+
+      while (fh->nwaiters > 0)
+        {
+          fh->nwaiters--;
+          nxsem_post(&fh->waitsem);
+        }
+
+      cryptodev_pollnotify(fh);
+    }
+
+  fh->running = false;
+  if (fh->closing)
+    {
+      nxsem_post(&fh->exitsem);
+    }
+
+  nxsem_post(&fh->exclsem);
+}
+
+/****************************************************************************
+ * Name: cryptodev_job_copyin
+ *
+ * Description:
+ *   Copy the input of a submitted job into kernel memory.  Called with the
+ *   file structure locked.
+ *
+ ****************************************************************************/
+
+static int cryptodev_job_copyin(FAR struct cryptodev_file_s *fh,
+                                FAR struct cryptodev_job_s *kjob,
+                                FAR const struct crypt_job *job)
+{
+  FAR struct cryptodev_session_s *ses;
+  uint32_t cipher = 0;
+
+  ses = cryptodev_session_get(fh, job->op.ses);
+  if (ses != NULL)
+    {
+      cipher = ses->cipher;
+      cryptodev_session_put(ses);
+    }
+
+  kjob->job = *job;
+  kjob->op  = job->op;
+  kjob->buf = NULL;
+
+  if (job->op.len > 0)
+    {
+      if (job->op.src == NULL || job->op.dst == NULL)
+        {
+          return -EINVAL;
+        }
+
+      kjob->buf = kmm_malloc(job->op.len);
+      if (kjob->buf == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      memcpy(kjob->buf, job->op.src, job->op.len);
+    }
+
+  kjob->op.src = (caddr_t)kjob->buf;
+  kjob->op.dst = (caddr_t)kjob->buf;
+
+  if (job->op.iv != NULL)
+    {
+      memcpy(kjob->iv, job->op.iv, cipher == CRYPTO_AES_GCM ?
+             CRYPTODEV_GCM_IVLEN : CRYPTODEV_BLKSIZE);
+      kjob->op.iv = (caddr_t)kjob->iv;
+    }
+
+  if (job->op.mac != NULL)
+    {
+      if (job->op.op == COP_DECRYPT)
+        {
+          memcpy(kjob->mac, job->op.mac, CRYPTODEV_BLKSIZE);
+        }
+
+      kjob->op.mac = (caddr_t)kjob->mac;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: cryptodev_job_copyout
+ *
+ * Description:
+ *   Copy the output of a completed job to the caller's buffers and free
+ *   the kernel copy.  Called in the context of the caller.
+ *
+ ****************************************************************************/
+
+static void cryptodev_job_copyout(FAR struct cryptodev_job_s *kjob,
+                                  FAR struct crypt_job *job)
+{
+  *job = kjob->job;
+
+  if (job->result == OK)
+    {
+      if (kjob->buf != NULL)
+        {
+          memcpy(job->op.dst, kjob->buf, job->op.len);
+        }
+
+      if (job->op.mac != NULL && job->op.op == COP_ENCRYPT)
+        {
+          memcpy(job->op.mac, kjob->mac, CRYPTODEV_BLKSIZE);
+        }
+    }
+
+  kmm_free(kjob->buf);
+  kjob->buf = NULL;
+}
+
+/****************************************************************************
+ * Name: cryptodev_submit
+ *
+ * Description:
+ *   Handle CIOCSUBMIT: copy as many jobs as fit into the ring, together
+ *   with their data, and kick the worker.  Returns the number of jobs
+ *   accepted.
+ *
+ ****************************************************************************/
+
+static int cryptodev_submit(FAR struct cryptodev_file_s *fh,
+                            FAR struct crypt_batch *batch)
+{
+  unsigned int space;
+  unsigned int n;
+  unsigned int i;
+  int ret;
+
+  if (batch->jobs == NULL && batch->njobs > 0)
+    {
+      return -EINVAL;
+    }
+
+  ret = nxsem_wait(&fh->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  space = CRYPTODEV_NJOBS - (fh->tail - fh->head);
+  n     = batch->njobs < space ? batch->njobs : space;
+
+  if (n == 0 && batch->njobs > 0)
+    {
+      /* The ring is full of unreaped completions or pending jobs */
+
+      nxsem_post(&fh->exclsem);
+      return -EAGAIN;
+    }
+
+  /* Copy the jobs in.  If one cannot be copied, accept those before it
+   * or fail if it is the first.
+   */
+
+  for (i = 0; i < n; i++)
+    {
+      ret = cryptodev_job_copyin(fh,
+                                 &fh->jobs[(fh->tail + i) % CRYPTODEV_NJOBS],
+                                 &batch->jobs[i]);
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  if (i == 0 && n > 0)
+    {
+      nxsem_post(&fh->exclsem);
+      return ret;
+    }
+
+  n         = i;
+  fh->tail += n;
+
+  if (n > 0 && !fh->running)
+    {
+      fh->running = true;
+      ret = work_queue(CRYPTODEV_WORK, &fh->work, cryptodev_worker, fh, 0);
+      if (ret < 0)
+        {
+          fh->running = false;
+          fh->tail   -= n;
+          for (i = 0; i < n; i++)
+            {
+              kmm_free(fh->jobs[(fh->tail + i) % CRYPTODEV_NJOBS].buf);
+            }
+
+          nxsem_post(&fh->exclsem);
+          return ret;
+        }
+    }
+
+  nxsem_post(&fh->exclsem);
+  return (int)n;
+}
+
+/****************************************************************************
+ * Name: cryptodev_reap
+ *
+ * Description:
+ *   Handle CIOCREAP: return completed jobs, with their result field set, in
+ *   submission order, and copy their output to the caller's buffers.  With
+ *   CRYPT_BATCH_WAIT, block until at least one job has completed.  Returns
+ *   the number of jobs returned.
+ *
+ ****************************************************************************/
+
+static int cryptodev_reap(FAR struct cryptodev_file_s *fh,
+                          FAR struct crypt_batch *batch)
+{
+  unsigned int n;
+  unsigned int i;
+  int ret;
+
+  if (batch->jobs == NULL && batch->njobs > 0)
+    {
+      return -EINVAL;
+    }
+
+  ret = nxsem_wait(&fh->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  while (fh->done == fh->head && (batch->flags & CRYPT_BATCH_WAIT) != 0 &&
+         batch->njobs > 0)
+    {
+      if (fh->done == fh->tail)
+        {
+          /* Nothing is pending, so waiting would block forever */
+
+          nxsem_post(&fh->exclsem);
+          return -EAGAIN;
+        }
+
+      fh->nwaiters++;
+      nxsem_post(&fh->exclsem);
+
+      ret = nxsem_wait(&fh->waitsem);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      ret = nxsem_wait(&fh->exclsem);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  n = fh->done - fh->head;
+  if (n > batch->njobs)
+    {
+      n = batch->njobs;
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      cryptodev_job_copyout(&fh->jobs[(fh->head + i) % CRYPTODEV_NJOBS],
+                            &batch->jobs[i]);
+    }
+
+  fh->head += n;
+  nxsem_post(&fh->exclsem);
+  return (int)n;
+}
+
+/****************************************************************************
+ * Name: cryptodev_poll
+ *
+ * Description:
+ *   POLLIN is reported when completed jobs are waiting to be reaped and
+ *   POLLOUT when the ring has room for more jobs.
+ *
+ ****************************************************************************/
+
+static int cryptodev_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                          bool setup)
+{
+  FAR struct cryptodev_file_s *fh = filep->f_priv;
+  FAR struct pollfd **slot;
+  int ret;
+  int i;
+
+  DEBUGASSERT(fh != NULL);
+
+  ret = nxsem_wait(&fh->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (setup)
+    {
+      for (i = 0; i < CONFIG_CRYPTO_CRYPTODEV_NPOLLWAITERS; i++)
+        {
+          if (fh->fds[i] == NULL)
+            {
+              fh->fds[i] = fds;
+              fds->priv  = &fh->fds[i];
+              break;
+            }
+        }
+
+      if (i >= CONFIG_CRYPTO_CRYPTODEV_NPOLLWAITERS)
+        {
+          fds->priv = NULL;
+          ret       = -EBUSY;
+          goto errout;
+        }
+
+      /* Report the events that are already true */
+
+      if (fh->done != fh->head)
+        {
+          fds->revents |= (fds->events & POLLIN);
+        }
+
+      if (fh->tail - fh->head < CRYPTODEV_NJOBS)
+        {
+          fds->revents |= (fds->events & POLLOUT);
+        }
+
+      if (fds->revents != 0)
+        {
+          nxsem_post(fds->sem);
+        }
+    }
+  else if (fds->priv != NULL)
+    {
+      slot      = (FAR struct pollfd **)fds->priv;
+      *slot     = NULL;
+      fds->priv = NULL;
+    }
+
+errout:
+  nxsem_post(&fh->exclsem);
+  return ret;
+}
+#endif /* CONFIG_CRYPTO_CRYPTODEV_BATCH */
+
+static int cryptodev_open(FAR struct file *filep)
+{
+  FAR struct cryptodev_file_s *fh;
+
+  fh = kmm_zalloc(sizeof(struct cryptodev_file_s));
+  if (fh == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  nxsem_init(&fh->exclsem, 0, 1);
+
+#ifdef CONFIG_CRYPTO_CRYPTODEV_BATCH
+  /* These semaphores are used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&fh->waitsem, 0, 0);
+  nxsem_setprotocol(&fh->waitsem, SEM_PRIO_NONE);
+  nxsem_init(&fh->exitsem, 0, 0);
+  nxsem_setprotocol(&fh->exitsem, SEM_PRIO_NONE);
+#endif
+
+  filep->f_priv = fh;
+  return OK;
+}
+
+static int cryptodev_close(FAR struct file *filep)
+{
+  FAR struct cryptodev_file_s *fh = filep->f_priv;
+  FAR struct cryptodev_session_s *ses;
+
+  DEBUGASSERT(fh != NULL);
+
+  nxsem_wait_uninterruptible(&fh->exclsem);
+
+#ifdef CONFIG_CRYPTO_CRYPTODEV_BATCH
+  /* Stop the worker.  Jobs not yet processed are discarded. */
+
+  fh->closing = true;
+  if (fh->running)
+    {
+      nxsem_post(&fh->exclsem);
+      nxsem_wait_uninterruptible(&fh->exitsem);
+      nxsem_wait_uninterruptible(&fh->exclsem);
+    }
+
+  for (; fh->head != fh->tail; fh->head++)
+    {
+      kmm_free(fh->jobs[fh->head % CRYPTODEV_NJOBS].buf);
+    }
+
+  nxsem_destroy(&fh->waitsem);
+  nxsem_destroy(&fh->exitsem);
+#endif
+
+  while ((ses = fh->sessions) != NULL)
+    {
+      fh->sessions = ses->flink;
+      nxsem_destroy(&ses->exclsem);
+      kmm_free(ses);
+    }
+
+  nxsem_post(&fh->exclsem);
+  nxsem_destroy(&fh->exclsem);
+  kmm_free(fh);
+  filep->f_priv = NULL;
+  return OK;
+}
+
 static ssize_t cryptodev_read(FAR struct file *filep,
                               FAR char *buffer,
                               size_t len)
@@ -117,55 +1165,41 @@ static int cryptodev_ioctl(FAR struct file *filep,
                            int cmd,
                            unsigned long arg)
 {
+  FAR struct cryptodev_file_s *fh = filep->f_priv;
+
+  DEBUGASSERT(fh != NULL);
+
   switch (cmd)
   {
   case CIOCGSESSION:
     {
       FAR struct session_op *ses = (FAR struct session_op *)arg;
-      ses->ses = (uint32_t)ses;
-      return OK;
+      return cryptodev_session_create(fh, ses);
     }
 
   case CIOCFSESSION:
     {
-      return OK;
+      FAR uint32_t *ses = (FAR uint32_t *)arg;
+      return cryptodev_session_release(fh, *ses);
     }
 
-#ifdef CONFIG_CRYPTO_AES
   case CIOCCRYPT:
     {
-      FAR struct crypt_op *op    = (FAR struct crypt_op *)arg;
-      FAR struct session_op *ses = (FAR struct session_op *)op->ses;
-      int encrypt;
-
-      switch (op->op)
-        {
-        case COP_ENCRYPT:
-          encrypt = 1;
-          break;
-
-        case COP_DECRYPT:
-          encrypt = 0;
-          break;
-
-        default:
-          return -EINVAL;
-        }
-
-      switch (ses->cipher)
-        {
-        case CRYPTO_AES_ECB:
-          return AES_CYPHER(AES_MODE_ECB);
-
-        case CRYPTO_AES_CBC:
-          return AES_CYPHER(AES_MODE_CBC);
+      FAR struct crypt_op *op = (FAR struct crypt_op *)arg;
+      return cryptodev_crypt(fh, op);
+    }
 
-        case CRYPTO_AES_CTR:
-          return AES_CYPHER(AES_MODE_CTR);
+#ifdef CONFIG_CRYPTO_CRYPTODEV_BATCH
+  case CIOCSUBMIT:
+    {
+      FAR struct crypt_batch *batch = (FAR struct crypt_batch *)arg;
+      return cryptodev_submit(fh, batch);
+    }
 
-        default:
-           return -EINVAL;
-        }
+  case CIOCREAP:
+    {
+      FAR struct crypt_batch *batch = (FAR struct crypt_batch *)arg;
+      return cryptodev_reap(fh, batch);
     }
 #endif
 
@@ -50,6 +50,15 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/crypto/crypto.h>
 
+#ifdef CONFIG_CRYPTO_SW_AES
+#  include <nuttx/crypto/aes.h>
+#endif
+
+#ifdef CONFIG_CRYPTO_ALGTEST_BENCHMARK
+#  include <time.h>
+#  include <syslog.h>
+#endif
+
 #ifdef CONFIG_CRYPTO_ALGTEST
 
 #include "testmngr.h"
@@ -62,12 +71,25 @@
 #  define ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
 #endif
 
-#if defined(CONFIG_CRYPTO_AES)
+/* Size of the buffer and number of passes used by the throughput
+ * benchmark.
+ */
+
+#define BENCH_BUFSIZE   4096
+#define BENCH_NPASSES   256
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+#  define BENCH_CLOCK   CLOCK_MONOTONIC
+#else
+#  define BENCH_CLOCK   CLOCK_REALTIME
+#endif
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#if defined(CONFIG_CRYPTO_AES)
+
 static int do_test_aes(FAR struct cipher_testvec *test,
                        int mode,
                        int encrypt)
@@ -123,6 +145,294 @@ static int test_aes(void)
 }
 #endif
 
+#if defined(CONFIG_CRYPTO_SW_AES)
+static int do_test_sw_aes_ecb(FAR struct cipher_testvec *test, int encrypt)
+{
+  struct aes_state_s state;
+  uint8_t buf[AES_BLOCK_SIZE];
+  int res;
+
+  res = aes_setupkey(&state, (FAR const uint8_t *)test->key, test->klen);
+  if (res < 0)
+    {
+      return res;
+    }
+
+  memcpy(buf, test->input, AES_BLOCK_SIZE);
+  if (encrypt)
+    {
+      aes_encipher(&state, buf, 1);
+    }
+  else
+    {
+      aes_decipher(&state, buf, 1);
+    }
+
+  return memcmp(buf, test->result, AES_BLOCK_SIZE);
+}
+
+/* The CTR test runs the message through the streaming interface twice:
+ * once in a single call and once in odd-sized pieces that straddle the
+ * block and key stream boundaries.
+ */
+
+static int do_test_sw_aes_ctr(FAR struct cipher_testvec *test)
+{
+  FAR struct aes_ctr_s *ctr;
+  FAR uint8_t *out;
+  size_t offset;
+  size_t chunk;
+  int res;
+
+  ctr = kmm_malloc(sizeof(struct aes_ctr_s));
+  out = kmm_malloc(test->rlen);
+  if (ctr == NULL || out == NULL)
+    {
+      res = -ENOMEM;
+      goto errout;
+    }
+
+  res = aes_ctr_setupkey(ctr, (FAR const uint8_t *)test->key, test->klen,
+                         (FAR const uint8_t *)test->iv);
+  if (res < 0)
+    {
+      goto errout;
+    }
+
+  aes_ctr_crypt(ctr, out, (FAR const uint8_t *)test->input, test->ilen);
+  res = memcmp(out, test->result, test->rlen);
+  if (res != 0)
+    {
+      goto errout;
+    }
+
+  aes_ctr_setupkey(ctr, (FAR const uint8_t *)test->key, test->klen,
+                   (FAR const uint8_t *)test->iv);
+
+  for (offset = 0, chunk = 1; offset < test->ilen; offset += chunk)
+    {
+      chunk = chunk + 6 > test->ilen - offset ?
+              test->ilen - offset : chunk + 6;
+      aes_ctr_crypt(ctr, out + offset,
+                    (FAR const uint8_t *)test->input + offset, chunk);
+    }
+
+  res = memcmp(out, test->result, test->rlen);
+
+errout:
+  kmm_free(out);
+  kmm_free(ctr);
+  return res;
+}
+
+#ifdef CONFIG_CRYPTO_SW_AES_GCM
+static int do_test_sw_aes_gcm(FAR struct aead_testvec *test, int encrypt)
+{
+  FAR struct aes_gcm_s *gcm;
+  FAR uint8_t *out = NULL;
+  FAR const char *in;
+  FAR const char *expect;
+  uint8_t tag[AES_BLOCK_SIZE];
+  int res;
+
+  gcm = kmm_malloc(sizeof(struct aes_gcm_s));
+  if (gcm == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  if (test->ilen > 0)
+    {
+      out = kmm_malloc(test->ilen);
+      if (out == NULL)
+        {
+          res = -ENOMEM;
+          goto errout;
+        }
+    }
+
+  in     = encrypt ? test->input : test->result;
+  expect = encrypt ? test->result : test->input;
+
+  res = aes_gcm_setupkey(gcm, (FAR const uint8_t *)test->key, test->klen);
+  if (res < 0)
+    {
+      goto errout;
+    }
+
+  aes_gcm_start(gcm, (FAR const uint8_t *)test->iv, test->ivlen, encrypt);
+  aes_gcm_aad(gcm, (FAR const uint8_t *)test->assoc, test->alen);
+  aes_gcm_update(gcm, out, (FAR const uint8_t *)in, test->ilen);
+  aes_gcm_finish(gcm, tag, AES_BLOCK_SIZE);
+
+  res = memcmp(tag, test->tag, AES_BLOCK_SIZE);
+  if (res == 0 && test->ilen > 0)
+    {
+      res = memcmp(out, expect, test->ilen);
+    }
+
+errout:
+  kmm_free(out);
+  kmm_free(gcm);
+  return res;
+}
+#endif
+
+static int test_sw_aes(void)
+{
+  int i;
+
+  for (i = 0; i < ARRAY_SIZE(aes_enc_tv_template); i++)
+    {
+      if (do_test_sw_aes_ecb(aes_enc_tv_template + i, 1))
+        {
+          crypterr("ERROR: Failed software ECB encrypt test #%i\n", i);
+          return -1;
+        }
+    }
+
+  for (i = 0; i < ARRAY_SIZE(aes_dec_tv_template); i++)
+    {
+      if (do_test_sw_aes_ecb(aes_dec_tv_template + i, 0))
+        {
+          crypterr("ERROR: Failed software ECB decrypt test #%i\n", i);
+          return -1;
+        }
+    }
+
+  for (i = 0; i < ARRAY_SIZE(aes_ctr_enc_tv_template); i++)
+    {
+      if (do_test_sw_aes_ctr(aes_ctr_enc_tv_template + i))
+        {
+          crypterr("ERROR: Failed software CTR encrypt test #%i\n", i);
+          return -1;
+        }
+    }
+
+  for (i = 0; i < ARRAY_SIZE(aes_ctr_dec_tv_template); i++)
+    {
+      if (do_test_sw_aes_ctr(aes_ctr_dec_tv_template + i))
+        {
+          crypterr("ERROR: Failed software CTR decrypt test #%i\n", i);
+          return -1;
+        }
+    }
+
+#ifdef CONFIG_CRYPTO_SW_AES_GCM
+  for (i = 0; i < ARRAY_SIZE(aes_gcm_tv_template); i++)
+    {
+      if (do_test_sw_aes_gcm(aes_gcm_tv_template + i, 1) ||
+          do_test_sw_aes_gcm(aes_gcm_tv_template + i, 0))
+        {
+          crypterr("ERROR: Failed software GCM test #%i\n", i);
+          return -1;
+        }
+    }
+#endif
+
+  return OK;
+}
+#endif
+
+#ifdef CONFIG_CRYPTO_ALGTEST_BENCHMARK
+static void bench_report(FAR const char *name, FAR struct timespec *start)
+{
+  struct timespec end;
+  uint64_t usec;
+
+  clock_gettime(BENCH_CLOCK, &end);
+  usec = (uint64_t)(end.tv_sec - start->tv_sec) * 1000000 +
+         (end.tv_nsec - start->tv_nsec) / 1000;
+  if (usec == 0)
+    {
+      usec = 1;
+    }
+
+  syslog(LOG_INFO, "crypto: %-16s %8lu KiB/s\n", name,
+         (unsigned long)((uint64_t)BENCH_BUFSIZE * BENCH_NPASSES *
+                         1000000 / 1024 / usec));
+}
+
+/* Encrypt a buffer BENCH_NPASSES times with each software mode and report
+ * the throughput.  The key size is that of the first ECB test vector.
+ */
+
+static void bench_sw_aes(void)
+{
+  FAR struct cipher_testvec *test = aes_enc_tv_template;
+  struct timespec start;
+  FAR struct aes_ctr_s *ctr;
+#ifdef CONFIG_CRYPTO_SW_AES_GCM
+  FAR struct aes_gcm_s *gcm;
+  uint8_t tag[AES_BLOCK_SIZE];
+#endif
+  FAR uint8_t *buf;
+  int i;
+
+  buf = kmm_zalloc(BENCH_BUFSIZE);
+  ctr = kmm_malloc(sizeof(struct aes_ctr_s));
+  if (buf == NULL || ctr == NULL)
+    {
+      goto errout;
+    }
+
+  aes_ctr_setupkey(ctr, (FAR const uint8_t *)test->key, test->klen,
+                   (FAR const uint8_t *)test->input);
+
+  clock_gettime(BENCH_CLOCK, &start);
+  for (i = 0; i < BENCH_NPASSES; i++)
+    {
+      aes_encipher(&ctr->aes, buf, BENCH_BUFSIZE / AES_BLOCK_SIZE);
+    }
+
+  bench_report("aes-ecb encrypt", &start);
+
+  clock_gettime(BENCH_CLOCK, &start);
+  for (i = 0; i < BENCH_NPASSES; i++)
+    {
+      aes_decipher(&ctr->aes, buf, BENCH_BUFSIZE / AES_BLOCK_SIZE);
+    }
+
+  bench_report("aes-ecb decrypt", &start);
+
+  clock_gettime(BENCH_CLOCK, &start);
+  for (i = 0; i < BENCH_NPASSES; i++)
+    {
+      aes_ctr_crypt(ctr, buf, buf, BENCH_BUFSIZE);
+    }
+
+  bench_report("aes-ctr", &start);
+
+#ifdef CONFIG_CRYPTO_SW_AES_GCM
+  gcm = kmm_malloc(sizeof(struct aes_gcm_s));
+  if (gcm != NULL)
+    {
+      aes_gcm_setupkey(gcm, (FAR const uint8_t *)test->key, test->klen);
+
+      clock_gettime(BENCH_CLOCK, &start);
+      aes_gcm_start(gcm, (FAR const uint8_t *)test->input, 12,
+                    CYPHER_ENCRYPT);
+      for (i = 0; i < BENCH_NPASSES; i++)
+        {
+          aes_gcm_update(gcm, buf, buf, BENCH_BUFSIZE);
+        }
+
+      aes_gcm_finish(gcm, tag, AES_BLOCK_SIZE);
+      bench_report("aes-gcm", &start);
+      kmm_free(gcm);
+    }
+#endif
+
+errout:
+  kmm_free(ctr);
+  kmm_free(buf);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
 int crypto_test(void)
 {
 #if defined(CONFIG_CRYPTO_AES)
@@ -132,6 +442,17 @@ int crypto_test(void)
     }
 #endif
 
+#if defined(CONFIG_CRYPTO_SW_AES)
+  if (test_sw_aes())
+    {
+      return -1;
+    }
+#endif
+
+#ifdef CONFIG_CRYPTO_ALGTEST_BENCHMARK
+  bench_sw_aes();
+#endif
+
   return OK;
 }
 
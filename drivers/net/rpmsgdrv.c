@@ -145,6 +145,19 @@
 
 #define NET_RPMSG_DRV_WDDELAY      (1*CLK_TCK)
 
+/* Packets larger than one rpmsg buffer are sent as NET_RPMSG_TRANSFER_FRAG
+ * fragments if CONFIG_NET_RPMSG_DRV_PKTSIZE is non-zero.
+ */
+
+#ifndef CONFIG_NET_RPMSG_DRV_PKTSIZE
+#  define CONFIG_NET_RPMSG_DRV_PKTSIZE 0
+#endif
+
+#if CONFIG_NET_RPMSG_DRV_PKTSIZE > 0
+#  define NET_RPMSG_DRV_FRAG
+#  define NET_RPMSG_DRV_BUFSIZE    ((CONFIG_NET_RPMSG_DRV_PKTSIZE + 1) / 2)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -167,6 +180,12 @@ struct net_rpmsg_drv_s
   WDOG_ID               txpoll;   /* TX poll timer */
   struct work_s         pollwork; /* For deferring poll work to the work queue */
 
+#ifdef NET_RPMSG_DRV_FRAG
+  struct rpmsg_reasm_s  reasm;    /* Reassembly of fragmented RX packets */
+  uint16_t              txbuf[NET_RPMSG_DRV_BUFSIZE];
+  uint16_t              rxbuf[NET_RPMSG_DRV_BUFSIZE];
+#endif
+
   /* This holds the information visible to the NuttX network */
 
   struct net_driver_s  dev;      /* Interface understood by the network */
@@ -178,6 +197,7 @@ struct net_rpmsg_drv_s
 
 /* Common TX logic */
 
+static bool net_rpmsg_drv_getbuf(FAR struct net_driver_s *dev);
 static int  net_rpmsg_drv_transmit(FAR struct net_driver_s *dev,
                                    bool nocopy);
 static int  net_rpmsg_drv_txpoll(FAR struct net_driver_s *dev);
@@ -194,6 +214,11 @@ static int net_rpmsg_drv_sockioctl_handler(FAR struct rpmsg_endpoint *ept,
 static int net_rpmsg_drv_transfer_handler(FAR struct rpmsg_endpoint *ept,
                                           FAR void *data, size_t len,
                                           uint32_t src, FAR void *priv);
+#ifdef NET_RPMSG_DRV_FRAG
+static int net_rpmsg_drv_frag_handler(FAR struct rpmsg_endpoint *ept,
+                                      FAR void *data, size_t len,
+                                      uint32_t src, FAR void *priv);
+#endif
 
 static void net_rpmsg_drv_device_created(FAR struct rpmsg_device *rdev,
                                          FAR void *priv_);
@@ -247,6 +272,9 @@ static const rpmsg_ept_cb g_net_rpmsg_drv_handler[] =
   [NET_RPMSG_DEVIOCTL]  = net_rpmsg_drv_default_handler,
   [NET_RPMSG_SOCKIOCTL] = net_rpmsg_drv_sockioctl_handler,
   [NET_RPMSG_TRANSFER]  = net_rpmsg_drv_transfer_handler,
+#ifdef NET_RPMSG_DRV_FRAG
+  [NET_RPMSG_TRANSFER_FRAG] = net_rpmsg_drv_frag_handler,
+#endif
 };
 
 /****************************************************************************
@@ -258,6 +286,56 @@ static void net_rpmsg_drv_wait(FAR sem_t *sem)
   net_lockedwait_uninterruptible(sem);
 }
 
+/****************************************************************************
+ * Name: net_rpmsg_drv_getbuf
+ *
+ * Description:
+ *   Make sure dev->d_buf points to a buffer that the next TX packet can be
+ *   built in: an rpmsg tx buffer by default, or the driver's own buffer if
+ *   large packets are enabled.
+ *
+ * Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *
+ * Returned Value:
+ *   true if a buffer is available
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static bool net_rpmsg_drv_getbuf(FAR struct net_driver_s *dev)
+{
+  FAR struct net_rpmsg_drv_s *priv = dev->d_private;
+#ifdef NET_RPMSG_DRV_FRAG
+
+  if (is_rpmsg_ept_ready(&priv->ept))
+    {
+      dev->d_buf     = (FAR uint8_t *)priv->txbuf;
+      dev->d_pktsize = CONFIG_NET_RPMSG_DRV_PKTSIZE;
+    }
+  else
+    {
+      dev->d_buf     = NULL;
+    }
+#else
+  uint32_t size;
+
+  if (dev->d_buf == NULL)
+    {
+      dev->d_buf = rpmsg_get_tx_payload_buffer(&priv->ept, &size, false);
+      if (dev->d_buf)
+        {
+          dev->d_buf += sizeof(struct net_rpmsg_transfer_s);
+          dev->d_pktsize = size - sizeof(struct net_rpmsg_transfer_s);
+        }
+    }
+#endif
+
+  return dev->d_buf != NULL;
+}
+
 /****************************************************************************
  * Name: net_rpmsg_drv_transmit
  *
@@ -278,7 +356,11 @@ static void net_rpmsg_drv_wait(FAR sem_t *sem)
 static int net_rpmsg_drv_transmit(FAR struct net_driver_s *dev, bool nocopy)
 {
   FAR struct net_rpmsg_drv_s *priv = dev->d_private;
+#ifdef NET_RPMSG_DRV_FRAG
+  struct net_rpmsg_header_s header;
+#else
   FAR struct net_rpmsg_transfer_s *msg;
+#endif
   int ret;
 
   /* Verify that the hardware is ready to send another packet. If we get
@@ -293,6 +375,14 @@ static int net_rpmsg_drv_transmit(FAR struct net_driver_s *dev, bool nocopy)
 
   /* Send the packet: address=dev->d_buf, length=dev->d_len */
 
+#ifdef NET_RPMSG_DRV_FRAG
+  header.command = NET_RPMSG_TRANSFER_FRAG;
+  header.result  = 0;
+  header.cookie  = 0;
+
+  ret = rpmsg_send_frag(&priv->ept, &header, sizeof(header),
+                        dev->d_buf, dev->d_len);
+#else
   msg = (FAR struct net_rpmsg_transfer_s *)dev->d_buf - 1;
 
   msg->header.command = NET_RPMSG_TRANSFER;
@@ -308,6 +398,7 @@ static int net_rpmsg_drv_transmit(FAR struct net_driver_s *dev, bool nocopy)
     {
       ret = rpmsg_send(&priv->ept, msg, sizeof(*msg) + msg->length);
     }
+#endif
 
   if (ret < 0)
     {
@@ -346,9 +437,6 @@ static int net_rpmsg_drv_transmit(FAR struct net_driver_s *dev, bool nocopy)
 
 static int net_rpmsg_drv_txpoll(FAR struct net_driver_s *dev)
 {
-  FAR struct net_rpmsg_drv_s *priv = dev->d_private;
-  uint32_t size;
-
   /* If the polling resulted in data that should be sent out on the network,
    * the field d_len is set to a value > 0.
    */
@@ -383,14 +471,8 @@ static int net_rpmsg_drv_txpoll(FAR struct net_driver_s *dev)
            * return a non-zero value to terminate the poll.
            */
 
-          dev->d_buf = rpmsg_get_tx_payload_buffer(&priv->ept, &size, false);
-          if (dev->d_buf)
-            {
-              dev->d_buf += sizeof(struct net_rpmsg_transfer_s);
-              dev->d_pktsize = size - sizeof(struct net_rpmsg_transfer_s);
-            }
-
-          return dev->d_buf == NULL;
+          dev->d_buf = NULL;
+          return !net_rpmsg_drv_getbuf(dev);
         }
     }
 
@@ -584,29 +666,25 @@ static bool net_rpmsg_drv_is_arp(FAR struct net_driver_s *dev)
 #endif
 
 /****************************************************************************
- * Name: net_rpmsg_drv_transfer_handler
+ * Name: net_rpmsg_drv_input
  *
  * Description:
- *   An message was received indicating the availability of a new RX packet
+ *   Dispatch a received packet to the network
  *
  * Parameters:
- *   ept - Reference to the endpoint which receive the message
+ *   dev - Reference to the NuttX driver state structure
+ *   buf - The received packet
+ *   len - The length of the packet
  *
  * Returned Value:
- *   OK on success
- *
- * Assumptions:
- *   The network is locked.
+ *   None
  *
  ****************************************************************************/
 
-static int net_rpmsg_drv_transfer_handler(FAR struct rpmsg_endpoint *ept,
-                                          FAR void *data, size_t len,
-                                          uint32_t src, FAR void *priv)
+static void net_rpmsg_drv_input(FAR struct net_driver_s *dev,
+                                FAR uint8_t *buf, size_t len)
 {
-  FAR struct net_driver_s *dev = ept->priv;
-  FAR struct net_rpmsg_transfer_s *msg = data;
-  FAR void *oldbuf;
+  FAR uint8_t *oldbuf;
 
   /* Lock the network and serialize driver operations if necessary.
    * NOTE: Serialization is only required in the case where the driver work
@@ -618,7 +696,7 @@ static int net_rpmsg_drv_transfer_handler(FAR struct rpmsg_endpoint *ept,
 
   /* Check for errors and update statistics */
 
-  net_rpmsg_drv_dumppacket("receive", msg->data, msg->length);
+  net_rpmsg_drv_dumppacket("receive", buf, len);
 
   NETDEV_RXPACKETS(dev);
 
@@ -628,8 +706,8 @@ static int net_rpmsg_drv_transfer_handler(FAR struct rpmsg_endpoint *ept,
 
   oldbuf = dev->d_buf;
 
-  dev->d_buf = msg->data;
-  dev->d_len = msg->length;
+  dev->d_buf = buf;
+  dev->d_len = len;
 
 #ifdef CONFIG_NET_PKT
   /* When packet sockets are enabled, feed the frame into the packet tap */
@@ -696,9 +774,87 @@ static int net_rpmsg_drv_transfer_handler(FAR struct rpmsg_endpoint *ept,
 
   dev->d_buf = oldbuf;
   net_unlock();
+}
+
+/****************************************************************************
+ * Name: net_rpmsg_drv_transfer_handler
+ *
+ * Description:
+ *   An message was received indicating the availability of a new RX packet
+ *
+ * Parameters:
+ *   ept - Reference to the endpoint which receive the message
+ *
+ * Returned Value:
+ *   OK on success
+ *
+ ****************************************************************************/
+
+static int net_rpmsg_drv_transfer_handler(FAR struct rpmsg_endpoint *ept,
+                                          FAR void *data, size_t len,
+                                          uint32_t src, FAR void *priv)
+{
+  FAR struct net_driver_s *dev = ept->priv;
+  FAR struct net_rpmsg_transfer_s *msg = data;
+#ifdef NET_RPMSG_DRV_FRAG
+  FAR struct net_rpmsg_drv_s *drv = dev->d_private;
+
+  /* Replies are built in place and may not fit into the rpmsg buffer, so
+   * move the packet to rxbuf first.
+   */
+
+  if (msg->length > CONFIG_NET_RPMSG_DRV_PKTSIZE)
+    {
+      NETDEV_RXDROPPED(dev);
+      return 0;
+    }
+
+  memcpy(drv->rxbuf, msg->data, msg->length);
+  net_rpmsg_drv_input(dev, (FAR uint8_t *)drv->rxbuf, msg->length);
+#else
+  net_rpmsg_drv_input(dev, msg->data, msg->length);
+#endif
+
+  return 0;
+}
+
+#ifdef NET_RPMSG_DRV_FRAG
+/****************************************************************************
+ * Name: net_rpmsg_drv_frag_handler
+ *
+ * Description:
+ *   A fragment of an RX packet larger than one rpmsg buffer was received
+ *
+ * Parameters:
+ *   ept - Reference to the endpoint which receive the message
+ *
+ * Returned Value:
+ *   OK on success
+ *
+ ****************************************************************************/
+
+static int net_rpmsg_drv_frag_handler(FAR struct rpmsg_endpoint *ept,
+                                      FAR void *data, size_t len,
+                                      uint32_t src, FAR void *priv)
+{
+  FAR struct net_driver_s *dev = ept->priv;
+  FAR struct net_rpmsg_drv_s *drv = dev->d_private;
+  ssize_t ret;
+
+  ret = rpmsg_recv_frag(&drv->reasm, data, len,
+                        sizeof(struct net_rpmsg_header_s));
+  if (ret > 0)
+    {
+      net_rpmsg_drv_input(dev, drv->reasm.buf, ret);
+    }
+  else if (ret < 0)
+    {
+      NETDEV_RXERRORS(dev);
+    }
 
   return 0;
 }
+#endif
 
 static void net_rpmsg_drv_device_created(FAR struct rpmsg_device *rdev,
                                          FAR void *priv_)
@@ -797,7 +953,6 @@ static void net_rpmsg_drv_poll_work(FAR void *arg)
 {
   FAR struct net_driver_s *dev = arg;
   FAR struct net_rpmsg_drv_s *priv = dev->d_private;
-  uint32_t size;
 
   /* Lock the network and serialize driver operations if necessary.
    * NOTE: Serialization is only required in the case where the driver work
@@ -813,19 +968,7 @@ static void net_rpmsg_drv_poll_work(FAR void *arg)
    * the TX poll if he are unable to accept another packet for transmission.
    */
 
-  if (dev->d_buf == NULL)
-    {
-      /* Try to get the payload buffer if not yet */
-
-      dev->d_buf = rpmsg_get_tx_payload_buffer(&priv->ept, &size, false);
-      if (dev->d_buf)
-        {
-          dev->d_buf += sizeof(struct net_rpmsg_transfer_s);
-          dev->d_pktsize = size - sizeof(struct net_rpmsg_transfer_s);
-        }
-    }
-
-  if (dev->d_buf)
+  if (net_rpmsg_drv_getbuf(dev))
     {
       /* If so, update TCP timing states and poll the network for new XMIT data.
        * Hmmm.. might be bug here.  Does this mean if there is a transmit in
@@ -1064,8 +1207,6 @@ static int net_rpmsg_drv_ifdown(FAR struct net_driver_s *dev)
 static void net_rpmsg_drv_txavail_work(FAR void *arg)
 {
   FAR struct net_driver_s *dev = arg;
-  FAR struct net_rpmsg_drv_s *priv = dev->d_private;
-  uint32_t size;
 
   /* Lock the network and serialize driver operations if necessary.
    * NOTE: Serialization is only required in the case where the driver work
@@ -1079,21 +1220,11 @@ static void net_rpmsg_drv_txavail_work(FAR void *arg)
 
   if (IFF_IS_UP(dev->d_flags))
     {
-      /* Try to get the payload buffer if not yet */
-
-      if (dev->d_buf == NULL)
-        {
-          dev->d_buf = rpmsg_get_tx_payload_buffer(&priv->ept, &size, false);
-          if (dev->d_buf)
-            {
-              dev->d_buf += sizeof(struct net_rpmsg_transfer_s);
-              dev->d_pktsize = size - sizeof(struct net_rpmsg_transfer_s);
-            }
-        }
-
-      /* Check if there is room in the hardware to hold another outgoing packet. */
+      /* Check if there is room in the hardware to hold another outgoing
+       * packet, trying to get the payload buffer if not yet.
+       */
 
-      if (dev->d_buf)
+      if (net_rpmsg_drv_getbuf(dev))
         {
           /* If so, then poll the network for new XMIT data */
 
@@ -1369,6 +1500,11 @@ int net_rpmsg_drv_init(FAR const char *cpuname,
   priv->cpuname = cpuname;
   priv->devname = devname;
 
+#ifdef NET_RPMSG_DRV_FRAG
+  priv->reasm.buf  = (FAR uint8_t *)priv->rxbuf;
+  priv->reasm.size = CONFIG_NET_RPMSG_DRV_PKTSIZE;
+#endif
+
   /* Initialize the driver structure */
 
   strcpy(dev->d_ifname, devname);
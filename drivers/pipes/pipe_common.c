@@ -27,6 +27,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
@@ -385,22 +386,36 @@ int pipecommon_close(FAR struct file *filep)
 }
 
 /****************************************************************************
- * Name: pipecommon_read
+ * Name: pipecommon_readv
+ *
+ * Description:
+ *   Scatter what is available in the pipe into the caller's segments.  All
+ *   segments are filled under one hold of the device semaphore, so a
+ *   vectored read costs one wakeup of the writers instead of one per
+ *   segment.
+ *
  ****************************************************************************/
 
-ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
+ssize_t pipecommon_readv(FAR struct file *filep, FAR const struct iovec *iov,
+                         int iovcnt)
 {
   FAR struct inode      *inode  = filep->f_inode;
   FAR struct pipe_dev_s *dev    = inode->i_private;
-#ifdef CONFIG_DEV_PIPEDUMP
-  FAR uint8_t           *start  = (FAR uint8_t *)buffer;
-#endif
+  FAR char              *buffer;
   ssize_t                nread  = 0;
+  size_t                 len    = 0;
+  size_t                 seglen;
   int                    sval;
   int                    ret;
+  int                    i;
 
   DEBUGASSERT(dev);
 
+  for (i = 0; i < iovcnt; i++)
+    {
+      len += iov[i].iov_len;
+    }
+
   if (len == 0)
     {
       return 0;
@@ -455,18 +470,28 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
         }
     }
 
-  /* Then return whatever is available in the pipe (which is at least one byte) */
+  /* Then return whatever is available in the pipe (which is at least one
+   * byte), filling each segment in turn.
+   */
 
-  nread = 0;
-  while ((size_t)nread < len && dev->d_wrndx != dev->d_rdndx)
+  for (i = 0; i < iovcnt && dev->d_wrndx != dev->d_rdndx; i++)
     {
-      *buffer++ = dev->d_buffer[dev->d_rdndx];
-      if (++dev->d_rdndx >= dev->d_bufsize)
+      buffer = iov[i].iov_base;
+      seglen = 0;
+
+      while (seglen < iov[i].iov_len && dev->d_wrndx != dev->d_rdndx)
         {
-          dev->d_rdndx = 0;
+          *buffer++ = dev->d_buffer[dev->d_rdndx];
+          if (++dev->d_rdndx >= dev->d_bufsize)
+            {
+              dev->d_rdndx = 0;
+            }
+
+          seglen++;
         }
 
-      nread++;
+      pipe_dumpbuffer("From PIPE:", (FAR uint8_t *)iov[i].iov_base, seglen);
+      nread += seglen;
     }
 
   /* Notify all waiting writers that bytes have been removed from the buffer */
@@ -481,31 +506,58 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
   pipecommon_pollnotify(dev, POLLOUT);
 
   nxsem_post(&dev->d_bfsem);
-  pipe_dumpbuffer("From PIPE:", start, nread);
   return nread;
 }
 
 /****************************************************************************
- * Name: pipecommon_write
+ * Name: pipecommon_read
  ****************************************************************************/
 
-ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
-                         size_t len)
+ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
+{
+  struct iovec iov;
+
+  iov.iov_base = buffer;
+  iov.iov_len  = len;
+  return pipecommon_readv(filep, &iov, 1);
+}
+
+/****************************************************************************
+ * Name: pipecommon_writev
+ *
+ * Description:
+ *   Gather the caller's segments into the pipe.  The segments are copied
+ *   under one hold of the device semaphore and the readers are woken once
+ *   the whole request is in the pipe (or the pipe fills up), not once per
+ *   segment.
+ *
+ ****************************************************************************/
+
+ssize_t pipecommon_writev(FAR struct file *filep,
+                          FAR const struct iovec *iov, int iovcnt)
 {
   FAR struct inode      *inode    = filep->f_inode;
   FAR struct pipe_dev_s *dev      = inode->i_private;
+  FAR const char        *buffer;
   ssize_t                nwritten = 0;
   ssize_t                last;
+  size_t                 seglen;
   int                    nxtwrndx;
   int                    sval;
   int                    ret;
+  int                    i;
 
   DEBUGASSERT(dev);
-  pipe_dumpbuffer("To PIPE:", (FAR uint8_t *)buffer, len);
+
+  /* Skip over any leading zero-length segments */
+
+  for (i = 0; i < iovcnt && iov[i].iov_len == 0; i++)
+    {
+    }
 
   /* Handle zero-length writes */
 
-  if (len == 0)
+  if (i >= iovcnt)
     {
       return 0;
     }
@@ -548,6 +600,10 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
       return ret;
     }
 
+  buffer = iov[i].iov_base;
+  seglen = iov[i].iov_len;
+  pipe_dumpbuffer("To PIPE:", (FAR uint8_t *)buffer, seglen);
+
   /* Loop until all of the bytes have been written */
 
   last = 0;
@@ -569,27 +625,43 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
 
           dev->d_buffer[dev->d_wrndx] = *buffer++;
           dev->d_wrndx = nxtwrndx;
+          nwritten++;
 
-          /* Is the write complete? */
+          /* Move on to the next non-empty segment when this one is done */
 
-          nwritten++;
-          if ((size_t)nwritten >= len)
+          if (--seglen == 0)
             {
-              /* Yes.. Notify all of the waiting readers that more data is available */
+              for (i++; i < iovcnt && iov[i].iov_len == 0; i++)
+                {
+                }
+
+              if (i < iovcnt)
+                {
+                  buffer = iov[i].iov_base;
+                  seglen = iov[i].iov_len;
+                  pipe_dumpbuffer("To PIPE:", (FAR uint8_t *)buffer, seglen);
+                  continue;
+                }
+
+              /* The write is complete.  Notify all of the waiting readers
+               * that more data is available
+               */
 
               while (nxsem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0)
                 {
                   nxsem_post(&dev->d_rdsem);
                 }
 
-              /* Notify all poll/select waiters that they can read from the FIFO */
+              /* Notify all poll/select waiters that they can read from the
+               * FIFO
+               */
 
               pipecommon_pollnotify(dev, POLLIN);
 
               /* Return the number of bytes written */
 
               nxsem_post(&dev->d_bfsem);
-              return len;
+              return nwritten;
             }
         }
       else
@@ -646,6 +718,20 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
     }
 }
 
+/****************************************************************************
+ * Name: pipecommon_write
+ ****************************************************************************/
+
+ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
+                         size_t len)
+{
+  struct iovec iov;
+
+  iov.iov_base = (FAR void *)buffer;
+  iov.iov_len  = len;
+  return pipecommon_writev(filep, &iov, 1);
+}
+
 /****************************************************************************
  * Name: pipecommon_poll
  ****************************************************************************/
@@ -0,0 +1,607 @@
+/****************************************************************************
+ * drivers/pipes/shmring.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/shmring.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/drivers/drivers.h>
+
+#ifdef CONFIG_DEV_SHMRING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_DEV_SHMRING_MAXSIZE
+#  define CONFIG_DEV_SHMRING_MAXSIZE 65536
+#endif
+
+#ifndef CONFIG_DEV_SHMRING_NPOLLWAITERS
+#  define CONFIG_DEV_SHMRING_NPOLLWAITERS 4
+#endif
+
+#define SHMRING_ALIGN(n)  (((n) + 7) & ~7)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Kernel side of one named ring.  The geometry is kept here as well as in
+ * the shared state so that a corrupted copy cannot send the kernel outside
+ * of the ring.
+ */
+
+struct shmring_dev_s
+{
+  FAR struct shmring_dev_s *flink;
+  FAR struct shmring_ctrl_s *ctrl; /* Shared state, from the user heap */
+  FAR uint8_t *slots;              /* Kernel copy of ctrl->slots */
+  uint32_t mask;                   /* Kernel copy of ctrl->mask */
+  uint32_t stride;                 /* Kernel copy of ctrl->stride */
+  int crefs;                       /* Descriptors attached to the ring */
+  sem_t rsem;                      /* Consumers waiting for data */
+  sem_t wsem;                      /* Producers waiting for room */
+  FAR struct pollfd *fds[CONFIG_DEV_SHMRING_NPOLLWAITERS];
+  char name[SHMRING_NAME_MAX + 1];
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     shmring_dev_close(FAR struct file *filep);
+static int     shmring_dev_ioctl(FAR struct file *filep, int cmd,
+                                 unsigned long arg);
+static int     shmring_dev_poll(FAR struct file *filep,
+                                FAR struct pollfd *fds, bool setup);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_shmring_fops =
+{
+  NULL,              /* open */
+  shmring_dev_close, /* close */
+  NULL,              /* read */
+  NULL,              /* write */
+  NULL,              /* seek */
+  shmring_dev_ioctl, /* ioctl */
+  shmring_dev_poll   /* poll */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , NULL             /* unlink */
+#endif
+};
+
+/* All rings that have descriptors attached, and the lock protecting the
+ * list and the reference counts.
+ */
+
+static FAR struct shmring_dev_s *g_shmring_list;
+static sem_t g_shmring_lock = SEM_INITIALIZER(1);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shmring_events
+ *
+ * Description:
+ *   Return POLLIN if the slot at tail is ready to be consumed and POLLOUT
+ *   if the slot at head is free to be produced.
+ *
+ ****************************************************************************/
+
+static pollevent_t shmring_events(FAR struct shmring_dev_s *dev)
+{
+  FAR struct shmring_ctrl_s *ctrl = dev->ctrl;
+  FAR struct shmring_slot_s *slot;
+  pollevent_t eventset = 0;
+  uint32_t pos;
+
+  pos  = ctrl->tail;
+  slot = (FAR struct shmring_slot_s *)
+         (dev->slots + (pos & dev->mask) * dev->stride);
+  if (slot->seq == pos + 1)
+    {
+      eventset |= POLLIN;
+    }
+
+  pos  = ctrl->head;
+  slot = (FAR struct shmring_slot_s *)
+         (dev->slots + (pos & dev->mask) * dev->stride);
+  if (slot->seq == pos)
+    {
+      eventset |= POLLOUT;
+    }
+
+  return eventset;
+}
+
+/****************************************************************************
+ * Name: shmring_waiters
+ *
+ * Description:
+ *   Add delta to the shared count of consumers and/or producers waiting
+ *   for the events.  The count is what tells the other side that it must
+ *   issue SHMRINGIOC_WAKE, so it must be visible before the ring state is
+ *   sampled again.
+ *
+ ****************************************************************************/
+
+static void shmring_waiters(FAR struct shmring_dev_s *dev,
+                            pollevent_t events, int delta)
+{
+  if (events & POLLIN)
+    {
+      __atomic_fetch_add(&dev->ctrl->rwait, delta, __ATOMIC_SEQ_CST);
+    }
+
+  if (events & POLLOUT)
+    {
+      __atomic_fetch_add(&dev->ctrl->wwait, delta, __ATOMIC_SEQ_CST);
+    }
+}
+
+/****************************************************************************
+ * Name: shmring_pollnotify
+ *
+ * Description:
+ *   Report events to the threads polling the ring.  Called from within a
+ *   critical section.
+ *
+ ****************************************************************************/
+
+static void shmring_pollnotify(FAR struct shmring_dev_s *dev,
+                               pollevent_t eventset)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_DEV_SHMRING_NPOLLWAITERS; i++)
+    {
+      FAR struct pollfd *fds = dev->fds[i];
+
+      if (fds)
+        {
+          fds->revents |= (fds->events & eventset);
+          if (fds->revents != 0)
+            {
+              nxsem_post(fds->sem);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: shmring_wakeall
+ *
+ * Description:
+ *   Wake every thread waiting on sem.  Called from within a critical
+ *   section.
+ *
+ ****************************************************************************/
+
+static void shmring_wakeall(FAR sem_t *sem)
+{
+  int semcount;
+
+  while (nxsem_getvalue(sem, &semcount) >= 0 && semcount < 0)
+    {
+      nxsem_post(sem);
+    }
+}
+
+/****************************************************************************
+ * Name: shmring_create
+ *
+ * Description:
+ *   Allocate a new ring.  The shared state comes from the user heap so
+ *   that every task can reach it directly.
+ *
+ ****************************************************************************/
+
+static FAR struct shmring_dev_s *
+shmring_create(FAR const char *name, FAR const struct shmring_attr_s *attr)
+{
+  FAR struct shmring_dev_s *dev;
+  FAR struct shmring_ctrl_s *ctrl;
+  FAR struct shmring_slot_s *slot;
+  uint32_t nslots;
+  uint32_t stride;
+  uint32_t i;
+
+  for (nslots = 1; nslots < attr->nslots; nslots <<= 1)
+    {
+    }
+
+  stride = SHMRING_ALIGN(sizeof(struct shmring_slot_s) + attr->slotsize);
+
+  dev = (FAR struct shmring_dev_s *)kmm_zalloc(sizeof(struct shmring_dev_s));
+  if (dev == NULL)
+    {
+      return NULL;
+    }
+
+  ctrl = (FAR struct shmring_ctrl_s *)
+    kumm_zalloc(SHMRING_ALIGN(sizeof(struct shmring_ctrl_s)) +
+                nslots * stride);
+  if (ctrl == NULL)
+    {
+      kmm_free(dev);
+      return NULL;
+    }
+
+  ctrl->mask     = nslots - 1;
+  ctrl->slotsize = stride - sizeof(struct shmring_slot_s);
+  ctrl->stride   = stride;
+  ctrl->flags    = attr->flags;
+  ctrl->slots    = (FAR uint8_t *)ctrl +
+                   SHMRING_ALIGN(sizeof(struct shmring_ctrl_s));
+
+  for (i = 0; i < nslots; i++)
+    {
+      slot      = (FAR struct shmring_slot_s *)(ctrl->slots + i * stride);
+      slot->seq = i;
+    }
+
+  dev->ctrl   = ctrl;
+  dev->slots  = ctrl->slots;
+  dev->mask   = ctrl->mask;
+  dev->stride = stride;
+  strncpy(dev->name, name, SHMRING_NAME_MAX);
+
+  nxsem_init(&dev->rsem, 0, 0);
+  nxsem_setprotocol(&dev->rsem, SEM_PRIO_NONE);
+  nxsem_init(&dev->wsem, 0, 0);
+  nxsem_setprotocol(&dev->wsem, SEM_PRIO_NONE);
+
+  return dev;
+}
+
+/****************************************************************************
+ * Name: shmring_attach
+ *
+ * Description:
+ *   Attach the descriptor to the ring named in 'attach', creating the ring
+ *   if it does not exist and O_CREAT is given.
+ *
+ ****************************************************************************/
+
+static int shmring_attach(FAR struct file *filep,
+                          FAR struct shmring_attach_s *attach)
+{
+  FAR struct shmring_dev_s *dev;
+  int ret;
+
+  if (attach == NULL || attach->name == NULL ||
+      strlen(attach->name) > SHMRING_NAME_MAX)
+    {
+      return -EINVAL;
+    }
+
+  ret = nxsem_wait(&g_shmring_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (filep->f_priv != NULL)
+    {
+      ret = -EBUSY;
+      goto errout;
+    }
+
+  for (dev = g_shmring_list; dev != NULL; dev = dev->flink)
+    {
+      if (strcmp(dev->name, attach->name) == 0)
+        {
+          break;
+        }
+    }
+
+  if (dev != NULL)
+    {
+      if ((attach->oflag & (O_CREAT | O_EXCL)) == (O_CREAT | O_EXCL))
+        {
+          ret = -EEXIST;
+          goto errout;
+        }
+    }
+  else
+    {
+      if ((attach->oflag & O_CREAT) == 0)
+        {
+          ret = -ENOENT;
+          goto errout;
+        }
+
+      if (attach->attr.nslots == 0 || attach->attr.slotsize == 0 ||
+          attach->attr.nslots > CONFIG_DEV_SHMRING_MAXSIZE ||
+          attach->attr.slotsize > CONFIG_DEV_SHMRING_MAXSIZE)
+        {
+          ret = -EINVAL;
+          goto errout;
+        }
+
+      dev = shmring_create(attach->name, &attach->attr);
+      if (dev == NULL)
+        {
+          ret = -ENOMEM;
+          goto errout;
+        }
+
+      dev->flink     = g_shmring_list;
+      g_shmring_list = dev;
+    }
+
+  dev->crefs++;
+  filep->f_priv = dev;
+  attach->ctrl  = dev->ctrl;
+
+errout:
+  nxsem_post(&g_shmring_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: shmring_wait
+ *
+ * Description:
+ *   Wait until the ring is readable (POLLIN) or writable (POLLOUT).  The
+ *   caller is counted as a waiter before the ring is checked, so a
+ *   producer or consumer that changes the ring afterwards will wake it.
+ *
+ ****************************************************************************/
+
+static int shmring_wait(FAR struct shmring_dev_s *dev, pollevent_t events)
+{
+  FAR sem_t *sem;
+  irqstate_t flags;
+  int ret = OK;
+
+  if (events == POLLIN)
+    {
+      sem = &dev->rsem;
+    }
+  else if (events == POLLOUT)
+    {
+      sem = &dev->wsem;
+    }
+  else
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+  shmring_waiters(dev, events, 1);
+
+  if ((shmring_events(dev) & events) == 0)
+    {
+      ret = nxsem_wait(sem);
+    }
+
+  shmring_waiters(dev, events, -1);
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: shmring_wake
+ ****************************************************************************/
+
+static int shmring_wake(FAR struct shmring_dev_s *dev, pollevent_t events)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  if (events & POLLIN)
+    {
+      shmring_wakeall(&dev->rsem);
+    }
+
+  if (events & POLLOUT)
+    {
+      shmring_wakeall(&dev->wsem);
+    }
+
+  shmring_pollnotify(dev, shmring_events(dev) & events);
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: shmring_dev_close
+ *
+ * Description:
+ *   Detach the descriptor.  The ring is freed with the last descriptor
+ *   attached to it.
+ *
+ ****************************************************************************/
+
+static int shmring_dev_close(FAR struct file *filep)
+{
+  FAR struct shmring_dev_s *dev = (FAR struct shmring_dev_s *)filep->f_priv;
+  FAR struct shmring_dev_s **prev;
+
+  if (dev == NULL)
+    {
+      return OK;
+    }
+
+  nxsem_wait_uninterruptible(&g_shmring_lock);
+
+  filep->f_priv = NULL;
+  if (--dev->crefs <= 0)
+    {
+      for (prev = &g_shmring_list; *prev != dev; prev = &(*prev)->flink)
+        {
+        }
+
+      *prev = dev->flink;
+
+      nxsem_destroy(&dev->rsem);
+      nxsem_destroy(&dev->wsem);
+      kumm_free(dev->ctrl);
+      kmm_free(dev);
+    }
+
+  nxsem_post(&g_shmring_lock);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: shmring_dev_ioctl
+ ****************************************************************************/
+
+static int shmring_dev_ioctl(FAR struct file *filep, int cmd,
+                             unsigned long arg)
+{
+  FAR struct shmring_dev_s *dev = (FAR struct shmring_dev_s *)filep->f_priv;
+
+  if (cmd == SHMRINGIOC_ATTACH)
+    {
+      return shmring_attach(filep,
+                            (FAR struct shmring_attach_s *)((uintptr_t)arg));
+    }
+
+  if (dev == NULL)
+    {
+      return _SHMRINGIOCVALID(cmd) ? -EBADF : -ENOTTY;
+    }
+
+  switch (cmd)
+    {
+      case SHMRINGIOC_WAIT:
+        return shmring_wait(dev, (pollevent_t)arg);
+
+      case SHMRINGIOC_WAKE:
+        return shmring_wake(dev, (pollevent_t)arg);
+
+      default:
+        return -ENOTTY;
+    }
+}
+
+/****************************************************************************
+ * Name: shmring_dev_poll
+ *
+ * Description:
+ *   POLLIN is reported while a slot waits to be consumed and POLLOUT while
+ *   a slot is free.  A poller counts as a waiter of the ring, so producers
+ *   and consumers issue SHMRINGIOC_WAKE for it.
+ *
+ ****************************************************************************/
+
+static int shmring_dev_poll(FAR struct file *filep,
+                            FAR struct pollfd *fds, bool setup)
+{
+  FAR struct shmring_dev_s *dev = (FAR struct shmring_dev_s *)filep->f_priv;
+  pollevent_t eventset;
+  irqstate_t flags;
+  int ret = OK;
+  int i;
+
+  DEBUGASSERT(fds != NULL);
+
+  if (dev == NULL)
+    {
+      return -EBADF;
+    }
+
+  flags = enter_critical_section();
+  if (setup)
+    {
+      for (i = 0; i < CONFIG_DEV_SHMRING_NPOLLWAITERS; i++)
+        {
+          if (dev->fds[i] == NULL)
+            {
+              dev->fds[i] = fds;
+              fds->priv   = &dev->fds[i];
+              break;
+            }
+        }
+
+      if (i >= CONFIG_DEV_SHMRING_NPOLLWAITERS)
+        {
+          fds->priv = NULL;
+          ret       = -EBUSY;
+          goto errout;
+        }
+
+      shmring_waiters(dev, fds->events, 1);
+
+      eventset = shmring_events(dev);
+      if (eventset != 0)
+        {
+          shmring_pollnotify(dev, eventset);
+        }
+    }
+  else if (fds->priv != NULL)
+    {
+      FAR struct pollfd **slot = (FAR struct pollfd **)fds->priv;
+
+      shmring_waiters(dev, fds->events, -1);
+
+      *slot     = NULL;
+      fds->priv = NULL;
+    }
+
+errout:
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shmring_register
+ *
+ * Description:
+ *   Register the shared ring device at SHMRING_DEVPATH.
+ *
+ ****************************************************************************/
+
+void shmring_register(void)
+{
+  register_driver(SHMRING_DEVPATH, &g_shmring_fops, 0666, NULL);
+}
+
+#endif /* CONFIG_DEV_SHMRING */
@@ -39,9 +39,12 @@
 
 #include <nuttx/config.h>
 
+#include <debug.h>
+#include <errno.h>
 #include <inttypes.h>
 #include <stdio.h>
 #include <fcntl.h>
+#include <string.h>
 
 #include <nuttx/arch.h>
 #include <nuttx/kmalloc.h>
@@ -790,6 +793,129 @@ void rpmsg_unregister_callback(FAR void *priv_,
   nxsem_post(&g_rptun_sem);
 }
 
+/****************************************************************************
+ * Name: rpmsg_send_frag
+ *
+ * Description:
+ *   Send a payload that may be larger than one rpmsg buffer.  The payload
+ *   is split over as many tx buffers as needed; each one carries a copy of
+ *   header followed by a struct rpmsg_frag_s and the fragment data, and is
+ *   sent without a further copy.
+ *
+ * Returned Value:
+ *   len on success; a negated errno on failure.
+ *
+ ****************************************************************************/
+
+int rpmsg_send_frag(FAR struct rpmsg_endpoint *ept,
+                    FAR const void *header, size_t hdrlen,
+                    FAR const void *data, size_t len)
+{
+  FAR struct rpmsg_frag_s *frag;
+  FAR uint8_t *msg;
+  uint32_t space;
+  size_t offset = 0;
+  size_t n;
+  int ret;
+
+  do
+    {
+      msg = rpmsg_get_tx_payload_buffer(ept, &space, true);
+      if (msg == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      DEBUGASSERT(space > hdrlen + sizeof(*frag));
+
+      n = space - hdrlen - sizeof(*frag);
+      if (n > len - offset)
+        {
+          n = len - offset;
+        }
+
+      frag = (FAR struct rpmsg_frag_s *)(msg + hdrlen);
+      frag->total  = len;
+      frag->offset = offset;
+
+      memcpy(msg, header, hdrlen);
+      memcpy(frag + 1, (FAR const uint8_t *)data + offset, n);
+
+      ret = rpmsg_send_nocopy(ept, msg, hdrlen + sizeof(*frag) + n);
+      if (ret < 0)
+        {
+          /* The buffer still belongs to us, give it back */
+
+          rpmsg_release_tx_buffer(ept, msg);
+          return ret;
+        }
+
+      offset += n;
+    }
+  while (offset < len);
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: rpmsg_recv_frag
+ *
+ * Description:
+ *   Add one fragment sent by rpmsg_send_frag() to reasm->buf.  Fragments
+ *   of one payload arrive in order on an endpoint; a fragment that does
+ *   not continue the payload in progress starts over.
+ *
+ * Returned Value:
+ *   The payload length once the last fragment has been added, zero if
+ *   more fragments are needed, or a negated errno if the fragment had to
+ *   be dropped.
+ *
+ ****************************************************************************/
+
+ssize_t rpmsg_recv_frag(FAR struct rpmsg_reasm_s *reasm,
+                        FAR const void *msg, size_t len, size_t hdrlen)
+{
+  FAR const struct rpmsg_frag_s *frag;
+  size_t n;
+
+  if (len < hdrlen + sizeof(*frag))
+    {
+      return -EINVAL;
+    }
+
+  frag = (FAR const struct rpmsg_frag_s *)((FAR const uint8_t *)msg +
+                                            hdrlen);
+  n    = len - hdrlen - sizeof(*frag);
+
+  if (frag->offset != reasm->received)
+    {
+      /* A fragment was lost, or a new payload started */
+
+      reasm->received = 0;
+      if (frag->offset != 0)
+        {
+          return -EPROTO;
+        }
+    }
+
+  if (frag->total > reasm->size || frag->offset + n > frag->total)
+    {
+      reasm->received = 0;
+      return -E2BIG;
+    }
+
+  memcpy(reasm->buf + frag->offset, frag + 1, n);
+  reasm->received += n;
+
+  if (reasm->received < frag->total)
+    {
+      return 0;
+    }
+
+  reasm->received = 0;
+  return frag->total;
+}
+
 int rptun_initialize(FAR struct rptun_dev_s *dev)
 {
   struct metal_init_params params = METAL_INIT_DEFAULTS;
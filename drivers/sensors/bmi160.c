@@ -49,6 +49,11 @@
 #include <nuttx/spi/spi.h>
 #include <nuttx/i2c/i2c_master.h>
 #include <nuttx/sensors/bmi160.h>
+#ifdef CONFIG_SENSORS_UPPERHALF
+#  include <nuttx/mutex.h>
+#  include <nuttx/wqueue.h>
+#  include <nuttx/sensors/sensor.h>
+#endif
 
 #if defined(CONFIG_SENSORS_BMI160)
 
@@ -211,8 +216,35 @@
 
 #define STEP_CNT_EN           (1 << 3)
 
+/* Register 0x47 - FIFO_CONFIG_1 */
+
+#define FIFO_GYR_EN           (1 << 7)
+#define FIFO_ACC_EN           (1 << 6)
+
+/* Common sensor upper half support */
+
+#ifdef CONFIG_SENSORS_UPPERHALF
+#  define BMI160_FIFO_SIZE    1024      /* Hardware FIFO size in bytes */
+#  define BMI160_FIFO_CHUNK   16        /* Frames read in one transfer */
+#  define BMI160_ODR_MIN      6         /* 25 Hz, lowest common gyro ODR */
+#  define BMI160_ODR_MAX      12        /* 1600 Hz, highest accel ODR */
+
+/* Output data rate code k is 100 * 2^(k - 8) Hz */
+
+#  define BMI160_ODR2USEC(k)  ((k) >= 8 ? 10000 >> ((k) - 8) : \
+                               10000 << (8 - (k)))
+
+/* Default ranges: accel +/-2g (16384 LSB/g), gyro +/-2000 dps
+ * (16.4 LSB/dps)
+ */
+
+#  define BMI160_ACCEL_SCALE  (SENSOR_GRAVITY / 16384.0f)
+#  define BMI160_GYRO_SCALE   (3.14159265f / 180.0f / 16.4f)
+#endif
+
 /* Register 0x7e - CMD */
 
+#define FIFO_FLUSH            (0xb0)
 #define	ACCEL_PM_SUSPEND      (0X10)
 #define ACCEL_PM_NORMAL       (0x11)
 #define	ACCEL_PM_LOWPOWER     (0X12)
@@ -240,6 +272,36 @@ struct bmi160_dev_s
 #endif
 };
 
+#ifdef CONFIG_SENSORS_UPPERHALF
+/* One of the two sensors of the chip, as seen by the sensor upper half */
+
+struct bmi160_sensor_s
+{
+  struct sensor_lowerhalf_s lower;   /* Must be first */
+  FAR struct bmi160_sensor_dev_s *dev;
+  bool enabled;
+};
+
+/* The chip driven through the sensor upper half.  Both sensors share the
+ * output data rate, which is required for a headerless FIFO.
+ */
+
+struct bmi160_sensor_dev_s
+{
+  struct bmi160_dev_s dev;           /* Bus access, must be first */
+  struct bmi160_sensor_s accel;
+  struct bmi160_sensor_s gyro;
+  mutex_t lock;                      /* Serializes chip access */
+  struct work_s work;                /* Drains the FIFO */
+  unsigned int interval;             /* Sample interval in usec */
+  unsigned int latency;              /* Batch latency in usec */
+  uint8_t odr;                       /* Output data rate code */
+  uint8_t fifo[BMI160_FIFO_CHUNK * 12];
+  struct sensor_event_accel_s aevents[BMI160_FIFO_CHUNK];
+  struct sensor_event_gyro_s gevents[BMI160_FIFO_CHUNK];
+};
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -264,6 +326,20 @@ static int     bmi160_ioctl(FAR struct file *filep, int cmd,
 
 static int bmi160_checkid(FAR struct bmi160_dev_s *priv);
 
+#ifdef CONFIG_SENSORS_UPPERHALF
+/* Sensor upper half methods */
+
+static void bmi160_fifo_worker(FAR void *arg);
+static int bmi160_activate(FAR struct sensor_lowerhalf_s *lower,
+                           bool enable);
+static int bmi160_set_interval(FAR struct sensor_lowerhalf_s *lower,
+                               FAR unsigned int *period_us);
+static int bmi160_batch(FAR struct sensor_lowerhalf_s *lower,
+                        FAR unsigned int *latency_us);
+static int bmi160_control(FAR struct sensor_lowerhalf_s *lower,
+                          int cmd, unsigned long arg);
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -280,6 +356,18 @@ static const struct file_operations g_bmi160fops =
   bmi160_ioctl,    /* ioctl */
 };
 
+#ifdef CONFIG_SENSORS_UPPERHALF
+/* Operations of the accel and gyro sensors for the sensor upper half */
+
+static const struct sensor_ops_s g_bmi160_sensor_ops =
+{
+  bmi160_activate,     /* activate */
+  bmi160_set_interval, /* set_interval */
+  bmi160_batch,        /* batch */
+  bmi160_control       /* control */
+};
+#endif
+
 /****************************************************************************
  * Name: bmi160_configspi
  *
@@ -726,6 +814,286 @@ static int bmi160_checkid(FAR struct bmi160_dev_s *priv)
   return OK;
 }
 
+#ifdef CONFIG_SENSORS_UPPERHALF
+/****************************************************************************
+ * Name: bmi160_fifo_worker
+ *
+ * Description:
+ *   Drain the FIFO in bursts of up to BMI160_FIFO_CHUNK frames and push
+ *   the samples to the upper half.  Runs every batch latency (or every
+ *   sample interval if batching is disabled) while a sensor is enabled.
+ *
+ ****************************************************************************/
+
+static void bmi160_fifo_worker(FAR void *arg)
+{
+  FAR struct bmi160_sensor_dev_s *priv = arg;
+  FAR struct sensor_event_accel_s *ae;
+  FAR struct sensor_event_gyro_s *ge;
+  FAR const int16_t *frame;
+  unsigned int framesize;
+  unsigned int nframes;
+  unsigned int delay;
+  unsigned int n;
+  unsigned int i;
+  uint64_t now;
+  float temp;
+
+  nxmutex_lock(&priv->lock);
+
+  if (!priv->accel.enabled && !priv->gyro.enabled)
+    {
+      nxmutex_unlock(&priv->lock);
+      return;
+    }
+
+  /* Headerless frames hold the enabled sensors: gyro first, then accel */
+
+  framesize = (priv->accel.enabled ? 6 : 0) + (priv->gyro.enabled ? 6 : 0);
+  nframes   = (bmi160_getreg16(&priv->dev, BMI160_FIFO_LENGTH_0) & 0x7ff) /
+              framesize;
+  now       = sensor_get_timestamp();
+
+  /* 0 is 23 degrees, 1/512 degree per LSB */
+
+  temp = 23.0f + (int16_t)bmi160_getreg16(&priv->dev,
+                                                 BMI160_TEMPERATURE_0) /
+         512.0f;
+
+  while (nframes > 0)
+    {
+      n = nframes > BMI160_FIFO_CHUNK ? BMI160_FIFO_CHUNK : nframes;
+      bmi160_getregs(&priv->dev, BMI160_FIFO_DATA, priv->fifo,
+                     n * framesize);
+
+      for (i = 0; i < n; i++)
+        {
+          /* The last frame in the FIFO is the newest */
+
+          frame = (FAR const int16_t *)&priv->fifo[i * framesize];
+          ae    = &priv->aevents[i];
+          ge    = &priv->gevents[i];
+
+          ae->timestamp = now - (uint64_t)(nframes - 1 - i) *
+                          priv->interval;
+          ge->timestamp = ae->timestamp;
+
+          if (priv->gyro.enabled)
+            {
+              ge->x           = frame[0] * BMI160_GYRO_SCALE;
+              ge->y           = frame[1] * BMI160_GYRO_SCALE;
+              ge->z           = frame[2] * BMI160_GYRO_SCALE;
+              ge->temperature = temp;
+              frame          += 3;
+            }
+
+          if (priv->accel.enabled)
+            {
+              ae->x           = frame[0] * BMI160_ACCEL_SCALE;
+              ae->y           = frame[1] * BMI160_ACCEL_SCALE;
+              ae->z           = frame[2] * BMI160_ACCEL_SCALE;
+              ae->temperature = temp;
+            }
+        }
+
+      if (priv->gyro.enabled)
+        {
+          priv->gyro.lower.push_event(priv->gyro.lower.priv, priv->gevents,
+                                      n * sizeof(priv->gevents[0]));
+        }
+
+      if (priv->accel.enabled)
+        {
+          priv->accel.lower.push_event(priv->accel.lower.priv,
+                                       priv->aevents,
+                                       n * sizeof(priv->aevents[0]));
+        }
+
+      nframes -= n;
+    }
+
+  delay = priv->latency > priv->interval ? priv->latency : priv->interval;
+  work_queue(LPWORK, &priv->work, bmi160_fifo_worker, priv,
+             USEC2TICK(delay) > 0 ? USEC2TICK(delay) : 1);
+
+  nxmutex_unlock(&priv->lock);
+}
+
+/****************************************************************************
+ * Name: bmi160_sensor_config
+ *
+ * Description:
+ *   Apply the power mode, the output data rate and the FIFO configuration
+ *   for the enabled sensors.  The FIFO is flushed so that it only holds
+ *   frames of the new layout.  Called with the lock held.
+ *
+ ****************************************************************************/
+
+static void bmi160_sensor_config(FAR struct bmi160_sensor_dev_s *priv)
+{
+  FAR struct bmi160_dev_s *dev = &priv->dev;
+  uint8_t fifocfg = 0;
+
+  bmi160_putreg8(dev, BMI160_CMD,
+                 priv->accel.enabled ? ACCEL_PM_NORMAL : ACCEL_PM_SUSPEND);
+  up_mdelay(30);
+  bmi160_putreg8(dev, BMI160_CMD,
+                 priv->gyro.enabled ? GYRO_PM_NORMAL : GYRO_PM_SUSPEND);
+  up_mdelay(30);
+
+  bmi160_putreg8(dev, BMI160_ACCEL_CONFIG, ACCEL_NORMAL_AVG4 | priv->odr);
+  bmi160_putreg8(dev, BMI160_GYRO_CONFIG, GYRO_NORMAL_MODE | priv->odr);
+
+  if (priv->accel.enabled)
+    {
+      fifocfg |= FIFO_ACC_EN;
+    }
+
+  if (priv->gyro.enabled)
+    {
+      fifocfg |= FIFO_GYR_EN;
+    }
+
+  bmi160_putreg8(dev, BMI160_FIFO_CONFIG_1, fifocfg);
+  bmi160_putreg8(dev, BMI160_CMD, FIFO_FLUSH);
+}
+
+/****************************************************************************
+ * Name: bmi160_activate
+ ****************************************************************************/
+
+static int bmi160_activate(FAR struct sensor_lowerhalf_s *lower,
+                           bool enable)
+{
+  FAR struct bmi160_sensor_s *sensor = (FAR struct bmi160_sensor_s *)lower;
+  FAR struct bmi160_sensor_dev_s *priv = sensor->dev;
+  bool wasidle;
+
+  nxmutex_lock(&priv->lock);
+
+  wasidle         = !priv->accel.enabled && !priv->gyro.enabled;
+  sensor->enabled = enable;
+  bmi160_sensor_config(priv);
+
+  if (wasidle && enable)
+    {
+      work_queue(LPWORK, &priv->work, bmi160_fifo_worker, priv,
+                 USEC2TICK(priv->interval) > 0 ?
+                 USEC2TICK(priv->interval) : 1);
+    }
+  else if (!priv->accel.enabled && !priv->gyro.enabled)
+    {
+      work_cancel(LPWORK, &priv->work);
+    }
+
+  nxmutex_unlock(&priv->lock);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bmi160_set_interval
+ ****************************************************************************/
+
+static int bmi160_set_interval(FAR struct sensor_lowerhalf_s *lower,
+                               FAR unsigned int *period_us)
+{
+  FAR struct bmi160_sensor_s *sensor = (FAR struct bmi160_sensor_s *)lower;
+  FAR struct bmi160_sensor_dev_s *priv = sensor->dev;
+  uint8_t odr;
+
+  /* Pick the slowest rate that is at least as fast as requested */
+
+  for (odr = BMI160_ODR_MIN; odr < BMI160_ODR_MAX; odr++)
+    {
+      if (BMI160_ODR2USEC(odr) <= *period_us)
+        {
+          break;
+        }
+    }
+
+  nxmutex_lock(&priv->lock);
+
+  priv->odr      = odr;
+  priv->interval = BMI160_ODR2USEC(odr);
+  *period_us     = priv->interval;
+
+  if (priv->accel.enabled || priv->gyro.enabled)
+    {
+      bmi160_sensor_config(priv);
+    }
+
+  nxmutex_unlock(&priv->lock);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bmi160_batch
+ ****************************************************************************/
+
+static int bmi160_batch(FAR struct sensor_lowerhalf_s *lower,
+                        FAR unsigned int *latency_us)
+{
+  FAR struct bmi160_sensor_s *sensor = (FAR struct bmi160_sensor_s *)lower;
+  FAR struct bmi160_sensor_dev_s *priv = sensor->dev;
+  unsigned int max;
+
+  nxmutex_lock(&priv->lock);
+
+  /* Leave some headroom so that the FIFO never overflows */
+
+  max = (lower->batch_number * 3 / 4) * priv->interval;
+  if (*latency_us > max)
+    {
+      *latency_us = max;
+    }
+
+  priv->latency = *latency_us;
+  nxmutex_unlock(&priv->lock);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bmi160_control
+ ****************************************************************************/
+
+static int bmi160_control(FAR struct sensor_lowerhalf_s *lower,
+                          int cmd, unsigned long arg)
+{
+  FAR struct bmi160_sensor_s *sensor = (FAR struct bmi160_sensor_s *)lower;
+  FAR struct bmi160_sensor_dev_s *priv = sensor->dev;
+  int ret = OK;
+
+  nxmutex_lock(&priv->lock);
+
+  switch (cmd)
+    {
+      /* Enable bmi160 step counter. Arg: int value */
+
+      case SNIOC_ENABLESC:
+        bmi160_enable_stepcounter(&priv->dev, (int)arg);
+        break;
+
+      /* Read bmi160 step count. Arg:  int16_t* pointer */
+
+      case SNIOC_READSC:
+        {
+          FAR int16_t *ptr = (FAR int16_t *)((uintptr_t)arg);
+
+          DEBUGASSERT(ptr != NULL);
+          *ptr = bmi160_getreg16(&priv->dev, BMI160_STEP_COUNT_0);
+        }
+        break;
+
+      default:
+        ret = -ENOTTY;
+        break;
+    }
+
+  nxmutex_unlock(&priv->lock);
+  return ret;
+}
+#endif /* CONFIG_SENSORS_UPPERHALF */
+
 /****************************************************************************
  * Name: bmi160_register
  *
@@ -797,4 +1165,108 @@ int bmi160_register(FAR const char *devpath, FAR struct spi_dev_s *dev)
   return OK;
 }
 
+#ifdef CONFIG_SENSORS_UPPERHALF
+/****************************************************************************
+ * Name: bmi160_register_sensors
+ *
+ * Description:
+ *   Register the BMI160 accelerometer and gyroscope with the sensor upper
+ *   half as /dev/sensor/accel<devno> and /dev/sensor/gyro<devno>.  The
+ *   samples are collected through the FIFO of the chip.
+ *
+ * Input Parameters:
+ *   devno - The device number
+ *   dev   - An instance of the SPI or I2C interface to use to communicate
+ *           with BMI160
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SENSORS_BMI160_I2C
+int bmi160_register_sensors(int devno, FAR struct i2c_master_s *dev)
+#else /* CONFIG_SENSORS_BMI160_SPI */
+int bmi160_register_sensors(int devno, FAR struct spi_dev_s *dev)
+#endif
+{
+  FAR struct bmi160_sensor_dev_s *priv;
+  int ret;
+
+  priv = kmm_zalloc(sizeof(struct bmi160_sensor_dev_s));
+  if (priv == NULL)
+    {
+      snerr("Failed to allocate instance\n");
+      return -ENOMEM;
+    }
+
+#ifdef CONFIG_SENSORS_BMI160_I2C
+  priv->dev.i2c  = dev;
+  priv->dev.addr = BMI160_I2C_ADDR;
+  priv->dev.freq = BMI160_I2C_FREQ;
+
+#else /* CONFIG_SENSORS_BMI160_SPI */
+  priv->dev.spi = dev;
+
+  /* BMI160 detects communication bus is SPI by rising edge of CS. */
+
+  bmi160_getreg8(&priv->dev, 0x7f);
+  bmi160_getreg8(&priv->dev, 0x7f); /* workaround: fail to switch SPI, run twice */
+  up_udelay(200);
+
+#endif
+
+  ret = bmi160_checkid(&priv->dev);
+  if (ret < 0)
+    {
+      snerr("Wrong Device ID!\n");
+      goto errout_with_priv;
+    }
+
+  /* To avoid gyro wakeup it is required to write 0x00 to 0x6C */
+
+  bmi160_putreg8(&priv->dev, BMI160_PMU_TRIGGER, 0);
+
+  nxmutex_init(&priv->lock);
+  priv->odr      = ACCEL_ODR_100HZ;
+  priv->interval = BMI160_ODR2USEC(ACCEL_ODR_100HZ);
+
+  priv->accel.dev                 = priv;
+  priv->accel.lower.type          = SENSOR_TYPE_ACCELEROMETER;
+  priv->accel.lower.buffer_number = BMI160_FIFO_CHUNK;
+  priv->accel.lower.batch_number  = BMI160_FIFO_SIZE / 12;
+  priv->accel.lower.ops           = &g_bmi160_sensor_ops;
+
+  priv->gyro.dev                  = priv;
+  priv->gyro.lower.type           = SENSOR_TYPE_GYROSCOPE;
+  priv->gyro.lower.buffer_number  = BMI160_FIFO_CHUNK;
+  priv->gyro.lower.batch_number   = BMI160_FIFO_SIZE / 12;
+  priv->gyro.lower.ops            = &g_bmi160_sensor_ops;
+
+  ret = sensor_register(&priv->accel.lower, devno);
+  if (ret < 0)
+    {
+      snerr("Failed to register accel: %d\n", ret);
+      goto errout_with_lock;
+    }
+
+  ret = sensor_register(&priv->gyro.lower, devno);
+  if (ret < 0)
+    {
+      snerr("Failed to register gyro: %d\n", ret);
+      sensor_unregister(&priv->accel.lower, devno);
+      goto errout_with_lock;
+    }
+
+  return OK;
+
+errout_with_lock:
+  nxmutex_destroy(&priv->lock);
+
+errout_with_priv:
+  kmm_free(priv);
+  return ret;
+}
+#endif /* CONFIG_SENSORS_UPPERHALF */
+
 #endif /* CONFIG_SENSORS_BMI160 */
@@ -58,6 +58,11 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/i2c/i2c_master.h>
 #include <nuttx/sensors/lsm6dsl.h>
+#ifdef CONFIG_SENSORS_UPPERHALF
+#  include <nuttx/mutex.h>
+#  include <nuttx/wqueue.h>
+#  include <nuttx/sensors/sensor.h>
+#endif
 
 #if defined(CONFIG_I2C) && defined(CONFIG_SENSORS_LSM6DSL)
 
@@ -69,6 +74,25 @@
 #  define CONFIG_LSM6DSL_I2C_FREQUENCY 400000
 #endif
 
+/* Common sensor upper half support */
+
+#ifdef CONFIG_SENSORS_UPPERHALF
+#  define LSM6DSL_FIFO_WORDS      2048  /* Hardware FIFO size, 16-bit words */
+#  define LSM6DSL_FIFO_CHUNK      16    /* Data sets read in one transfer */
+#  define LSM6DSL_ODR_MAX         8     /* 1.66 kHz */
+
+#  define LSM6DSL_FIFO_NODEC      1     /* FIFO_CTRL3: in FIFO, no decimation */
+#  define LSM6DSL_FIFO_CONT       6     /* FIFO_CTRL5: continuous mode */
+#  define LSM6DSL_FS_XL_16G       0x04  /* CTRL1_XL: +/- 16g */
+#  define LSM6DSL_FS_G_2000DPS    0x0c  /* CTRL2_G: 2000 dps */
+#  define LSM6DSL_DIFF_FIFO_MASK  0x07ff
+#  define LSM6DSL_FIFO_OVERRUN    (1 << 6) /* FIFO_STATUS2 */
+#  define LSM6DSL_PATTERN_MASK    0x03ff
+
+#  define LSM6DSL_ACCEL_SCALE     (0.488e-3f * SENSOR_GRAVITY)
+#  define LSM6DSL_GYRO_SCALE      (70.0e-3f * 3.14159265f / 180.0f)
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -118,6 +142,51 @@ static int lsm6dsl_register(FAR const char *devpath,
                             uint8_t datareg,
                             struct lsm6dsl_sensor_data_s sensor_data);
 
+#ifdef CONFIG_SENSORS_UPPERHALF
+/* Sensor Upper Half Methods */
+
+static int lsm6dsl_activate(FAR struct sensor_lowerhalf_s *lower,
+                            bool enable);
+static int lsm6dsl_set_interval(FAR struct sensor_lowerhalf_s *lower,
+                                FAR unsigned int *period_us);
+static int lsm6dsl_batch(FAR struct sensor_lowerhalf_s *lower,
+                         FAR unsigned int *latency_us);
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef CONFIG_SENSORS_UPPERHALF
+/* One of the two sensors of the chip, as seen by the sensor upper half */
+
+struct lsm6dsl_sensor_s
+{
+  struct sensor_lowerhalf_s lower;        /* Must be first */
+  FAR struct lsm6dsl_sensor_dev_s *dev;
+  bool enabled;
+};
+
+/* The chip driven through the sensor upper half.  Both sensors share the
+ * output data rate so that each FIFO data set holds one sample of each.
+ */
+
+struct lsm6dsl_sensor_dev_s
+{
+  struct lsm6dsl_dev_s dev;               /* Bus access */
+  struct lsm6dsl_sensor_s accel;
+  struct lsm6dsl_sensor_s gyro;
+  mutex_t lock;                           /* Serializes chip access */
+  struct work_s work;                     /* Drains the FIFO */
+  unsigned int interval;                  /* Sample interval in usec */
+  unsigned int latency;                   /* Batch latency in usec */
+  uint8_t odr;                            /* Output data rate code */
+  int16_t fifo[LSM6DSL_FIFO_CHUNK * 6];
+  struct sensor_event_accel_s aevents[LSM6DSL_FIFO_CHUNK];
+  struct sensor_event_gyro_s gevents[LSM6DSL_FIFO_CHUNK];
+};
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -148,6 +217,23 @@ static const struct lsm6dsl_ops_s g_lsm6dsl_sensor_ops =
   lsm6dsl_selftest
 };
 
+#ifdef CONFIG_SENSORS_UPPERHALF
+static const struct sensor_ops_s g_lsm6dsl_upper_ops =
+{
+  lsm6dsl_activate,      /* activate */
+  lsm6dsl_set_interval,  /* set_interval */
+  lsm6dsl_batch,         /* batch */
+  NULL                   /* control */
+};
+
+/* Sample interval in microseconds for each output data rate code */
+
+static const uint32_t g_lsm6dsl_odr_usec[LSM6DSL_ODR_MAX + 1] =
+{
+  0, 80000, 38462, 19231, 9615, 4808, 2404, 1200, 602
+};
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -1036,6 +1122,315 @@ static int lsm6dsl_sensor_read(FAR struct lsm6dsl_dev_s *priv,
   return OK;
 }
 
+#ifdef CONFIG_SENSORS_UPPERHALF
+/****************************************************************************
+ * Name: lsm6dsl_readregs
+ *
+ * Description:
+ *   Read a block of registers in one transfer.  Reading from
+ *   LSM6DSL_FIFO_DATA_OUT_L returns consecutive FIFO words, since the
+ *   address pointer rolls back from FIFO_DATA_OUT_H.
+ *
+ ****************************************************************************/
+
+static int lsm6dsl_readregs(FAR struct lsm6dsl_dev_s *priv,
+                            uint8_t regaddr, FAR uint8_t *regval,
+                            size_t len)
+{
+  struct i2c_config_s config;
+  int ret;
+
+  config.frequency = CONFIG_LSM6DSL_I2C_FREQUENCY;
+  config.address = priv->addr;
+  config.addrlen = 7;
+
+  ret = i2c_write(priv->i2c, &config, &regaddr, sizeof(regaddr));
+  if (ret < 0)
+    {
+      snerr("ERROR: i2c_write failed: %d\n", ret);
+      return ret;
+    }
+
+  ret = i2c_read(priv->i2c, &config, regval, len);
+  if (ret < 0)
+    {
+      snerr("ERROR: i2c_read failed: %d\n", ret);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: lsm6dsl_fifo_config
+ *
+ * Description:
+ *   Apply the output data rate to the enabled sensors, power down the
+ *   others, and restart the FIFO with the matching data set layout.  Called
+ *   with the lock held.
+ *
+ ****************************************************************************/
+
+static void lsm6dsl_fifo_config(FAR struct lsm6dsl_sensor_dev_s *priv)
+{
+  FAR struct lsm6dsl_dev_s *dev = &priv->dev;
+  uint8_t odr = priv->odr << 4;
+  uint8_t regval = 0;
+
+  lsm6dsl_writereg8(dev, LSM6DSL_CTRL1_XL,
+                    priv->accel.enabled ? odr | LSM6DSL_FS_XL_16G : 0);
+  lsm6dsl_writereg8(dev, LSM6DSL_CTRL2_G,
+                    priv->gyro.enabled ? odr | LSM6DSL_FS_G_2000DPS : 0);
+
+  if (priv->accel.enabled)
+    {
+      regval |= LSM6DSL_FIFO_NODEC << LSM6DSL_FIFO_CTRL3_DEC_FIFO_XL_SHIFT;
+    }
+
+  if (priv->gyro.enabled)
+    {
+      regval |= LSM6DSL_FIFO_NODEC << LSM6DSL_FIFO_CTRL3_DEC_FIFO_GYRO_SHIFT;
+    }
+
+  lsm6dsl_writereg8(dev, LSM6DSL_FIFO_CTRL3, regval);
+
+  /* Going through bypass mode empties the FIFO */
+
+  lsm6dsl_writereg8(dev, LSM6DSL_FIFO_CTRL5, 0);
+  if (regval != 0)
+    {
+      lsm6dsl_writereg8(dev, LSM6DSL_FIFO_CTRL5,
+                        (priv->odr << LSM6DSL_FIFO_CTRL5_ODR_FIFO_SHIFT) |
+                        LSM6DSL_FIFO_CONT);
+    }
+}
+
+/****************************************************************************
+ * Name: lsm6dsl_fifo_worker
+ *
+ * Description:
+ *   Drain the FIFO in bursts of up to LSM6DSL_FIFO_CHUNK data sets and
+ *   push the samples to the upper half.  Runs every batch latency (or
+ *   every sample interval if batching is disabled) while a sensor is
+ *   enabled.
+ *
+ ****************************************************************************/
+
+static void lsm6dsl_fifo_worker(FAR void *arg)
+{
+  FAR struct lsm6dsl_sensor_dev_s *priv = arg;
+  FAR struct sensor_event_accel_s *ae;
+  FAR struct sensor_event_gyro_s *ge;
+  FAR const int16_t *set;
+  unsigned int nwords;
+  unsigned int avail;
+  unsigned int nsets;
+  unsigned int delay;
+  unsigned int n;
+  unsigned int i;
+  uint16_t pattern;
+  uint8_t status[4];
+  int16_t temp;
+  uint64_t now;
+  float temperature;
+
+  nxmutex_lock(&priv->lock);
+
+  if (!priv->accel.enabled && !priv->gyro.enabled)
+    {
+      nxmutex_unlock(&priv->lock);
+      return;
+    }
+
+  /* A data set holds the gyro sample first, then the accel sample */
+
+  nwords = (priv->accel.enabled ? 3 : 0) + (priv->gyro.enabled ? 3 : 0);
+  now    = sensor_get_timestamp();
+
+  lsm6dsl_readregs(&priv->dev, LSM6DSL_FIFO_STATUS1, status,
+                   sizeof(status));
+  if ((status[1] & LSM6DSL_FIFO_OVERRUN) != 0)
+    {
+      snwarn("WARNING: FIFO overrun\n");
+      lsm6dsl_fifo_config(priv);
+      goto out;
+    }
+
+  /* The pattern is the index of the next word within a data set.  Drop
+   * the rest of a partial set so that the reads start on a boundary.
+   */
+
+  avail   = ((status[1] << 8) | status[0]) & LSM6DSL_DIFF_FIFO_MASK;
+  pattern = ((status[3] << 8) | status[2]) & LSM6DSL_PATTERN_MASK;
+  if (pattern != 0)
+    {
+      for (i = pattern; i < nwords && avail > 0; i++, avail--)
+        {
+          lsm6dsl_readregs(&priv->dev, LSM6DSL_FIFO_DATA_OUT_L,
+                           (FAR uint8_t *)priv->fifo, 2);
+        }
+    }
+
+  nsets = avail / nwords;
+
+  lsm6dsl_readregs(&priv->dev, LSM6DSL_OUT_TEMP_L, (FAR uint8_t *)&temp,
+                   sizeof(temp));
+  temperature = temp / 256.0f + 25.0f;
+
+  while (nsets > 0)
+    {
+      n = nsets > LSM6DSL_FIFO_CHUNK ? LSM6DSL_FIFO_CHUNK : nsets;
+      lsm6dsl_readregs(&priv->dev, LSM6DSL_FIFO_DATA_OUT_L,
+                       (FAR uint8_t *)priv->fifo,
+                       n * nwords * sizeof(int16_t));
+
+      for (i = 0; i < n; i++)
+        {
+          /* The last data set in the FIFO is the newest */
+
+          set = &priv->fifo[i * nwords];
+          ae  = &priv->aevents[i];
+          ge  = &priv->gevents[i];
+
+          ae->timestamp = now - (uint64_t)(nsets - 1 - i) * priv->interval;
+          ge->timestamp = ae->timestamp;
+
+          if (priv->gyro.enabled)
+            {
+              ge->x           = set[0] * LSM6DSL_GYRO_SCALE;
+              ge->y           = set[1] * LSM6DSL_GYRO_SCALE;
+              ge->z           = set[2] * LSM6DSL_GYRO_SCALE;
+              ge->temperature = temperature;
+              set            += 3;
+            }
+
+          if (priv->accel.enabled)
+            {
+              ae->x           = set[0] * LSM6DSL_ACCEL_SCALE;
+              ae->y           = set[1] * LSM6DSL_ACCEL_SCALE;
+              ae->z           = set[2] * LSM6DSL_ACCEL_SCALE;
+              ae->temperature = temperature;
+            }
+        }
+
+      if (priv->gyro.enabled)
+        {
+          priv->gyro.lower.push_event(priv->gyro.lower.priv, priv->gevents,
+                                      n * sizeof(priv->gevents[0]));
+        }
+
+      if (priv->accel.enabled)
+        {
+          priv->accel.lower.push_event(priv->accel.lower.priv,
+                                       priv->aevents,
+                                       n * sizeof(priv->aevents[0]));
+        }
+
+      nsets -= n;
+    }
+
+out:
+  delay = priv->latency > priv->interval ? priv->latency : priv->interval;
+  work_queue(LPWORK, &priv->work, lsm6dsl_fifo_worker, priv,
+             USEC2TICK(delay) > 0 ? USEC2TICK(delay) : 1);
+
+  nxmutex_unlock(&priv->lock);
+}
+
+/****************************************************************************
+ * Name: lsm6dsl_activate
+ ****************************************************************************/
+
+static int lsm6dsl_activate(FAR struct sensor_lowerhalf_s *lower,
+                            bool enable)
+{
+  FAR struct lsm6dsl_sensor_s *sensor = (FAR struct lsm6dsl_sensor_s *)lower;
+  FAR struct lsm6dsl_sensor_dev_s *priv = sensor->dev;
+  bool wasidle;
+
+  nxmutex_lock(&priv->lock);
+
+  wasidle         = !priv->accel.enabled && !priv->gyro.enabled;
+  sensor->enabled = enable;
+  lsm6dsl_fifo_config(priv);
+
+  if (wasidle && enable)
+    {
+      work_queue(LPWORK, &priv->work, lsm6dsl_fifo_worker, priv,
+                 USEC2TICK(priv->interval) > 0 ?
+                 USEC2TICK(priv->interval) : 1);
+    }
+  else if (!priv->accel.enabled && !priv->gyro.enabled)
+    {
+      work_cancel(LPWORK, &priv->work);
+    }
+
+  nxmutex_unlock(&priv->lock);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lsm6dsl_set_interval
+ ****************************************************************************/
+
+static int lsm6dsl_set_interval(FAR struct sensor_lowerhalf_s *lower,
+                                FAR unsigned int *period_us)
+{
+  FAR struct lsm6dsl_sensor_s *sensor = (FAR struct lsm6dsl_sensor_s *)lower;
+  FAR struct lsm6dsl_sensor_dev_s *priv = sensor->dev;
+  uint8_t odr;
+
+  /* Pick the slowest rate that is at least as fast as requested */
+
+  for (odr = 1; odr < LSM6DSL_ODR_MAX; odr++)
+    {
+      if (g_lsm6dsl_odr_usec[odr] <= *period_us)
+        {
+          break;
+        }
+    }
+
+  nxmutex_lock(&priv->lock);
+
+  priv->odr      = odr;
+  priv->interval = g_lsm6dsl_odr_usec[odr];
+  *period_us     = priv->interval;
+
+  if (priv->accel.enabled || priv->gyro.enabled)
+    {
+      lsm6dsl_fifo_config(priv);
+    }
+
+  nxmutex_unlock(&priv->lock);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lsm6dsl_batch
+ ****************************************************************************/
+
+static int lsm6dsl_batch(FAR struct sensor_lowerhalf_s *lower,
+                         FAR unsigned int *latency_us)
+{
+  FAR struct lsm6dsl_sensor_s *sensor = (FAR struct lsm6dsl_sensor_s *)lower;
+  FAR struct lsm6dsl_sensor_dev_s *priv = sensor->dev;
+  unsigned int max;
+
+  nxmutex_lock(&priv->lock);
+
+  /* Leave some headroom so that the FIFO never overruns */
+
+  max = (lower->batch_number * 3 / 4) * priv->interval;
+  if (*latency_us > max)
+    {
+      *latency_us = max;
+    }
+
+  priv->latency = *latency_us;
+  nxmutex_unlock(&priv->lock);
+  return OK;
+}
+#endif /* CONFIG_SENSORS_UPPERHALF */
+
 /****************************************************************************
  * Name: lsm6dsl_open
  *
@@ -1367,4 +1762,90 @@ int lsm6dsl_sensor_register(FAR const char *devpath,
                           LSM6DSL_OUTX_L_XL_SHIFT, sensor_data);
 }
 
+#ifdef CONFIG_SENSORS_UPPERHALF
+/****************************************************************************
+ * Name: lsm6dsl_register_sensors
+ *
+ * Description:
+ *   Register the LSM6DSL accelerometer and gyroscope with the sensor upper
+ *   half as /dev/sensor/accel<devno> and /dev/sensor/gyro<devno>.
+ *
+ * Input Parameters:
+ *   devno   - The device number.
+ *   i2c     - An I2C driver instance.
+ *   addr    - The I2C address of the LSM6DSL.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int lsm6dsl_register_sensors(int devno, FAR struct i2c_master_s *i2c,
+                             uint8_t addr)
+{
+  FAR struct lsm6dsl_sensor_dev_s *priv;
+  int ret;
+
+  DEBUGASSERT(i2c != NULL);
+  DEBUGASSERT(addr == LSM6DSLACCEL_ADDR0 || addr == LSM6DSLACCEL_ADDR1);
+
+  priv = kmm_zalloc(sizeof(*priv));
+  if (priv == NULL)
+    {
+      snerr("ERROR: Failed to allocate instance\n");
+      return -ENOMEM;
+    }
+
+  priv->dev.i2c  = i2c;
+  priv->dev.addr = addr;
+
+  ret = lsm6dsl_sensor_config(&priv->dev);
+  if (ret < 0)
+    {
+      snerr("ERROR: Failed to configure device: %d\n", ret);
+      goto errout_with_priv;
+    }
+
+  nxmutex_init(&priv->lock);
+  priv->odr      = 4;
+  priv->interval = g_lsm6dsl_odr_usec[4];
+
+  priv->accel.dev                 = priv;
+  priv->accel.lower.type          = SENSOR_TYPE_ACCELEROMETER;
+  priv->accel.lower.buffer_number = LSM6DSL_FIFO_CHUNK;
+  priv->accel.lower.batch_number  = LSM6DSL_FIFO_WORDS / 6;
+  priv->accel.lower.ops           = &g_lsm6dsl_upper_ops;
+
+  priv->gyro.dev                  = priv;
+  priv->gyro.lower.type           = SENSOR_TYPE_GYROSCOPE;
+  priv->gyro.lower.buffer_number  = LSM6DSL_FIFO_CHUNK;
+  priv->gyro.lower.batch_number   = LSM6DSL_FIFO_WORDS / 6;
+  priv->gyro.lower.ops            = &g_lsm6dsl_upper_ops;
+
+  ret = sensor_register(&priv->accel.lower, devno);
+  if (ret < 0)
+    {
+      snerr("ERROR: Failed to register accel: %d\n", ret);
+      goto errout_with_lock;
+    }
+
+  ret = sensor_register(&priv->gyro.lower, devno);
+  if (ret < 0)
+    {
+      snerr("ERROR: Failed to register gyro: %d\n", ret);
+      sensor_unregister(&priv->accel.lower, devno);
+      goto errout_with_lock;
+    }
+
+  return OK;
+
+errout_with_lock:
+  nxmutex_destroy(&priv->lock);
+
+errout_with_priv:
+  kmm_free(priv);
+  return ret;
+}
+#endif /* CONFIG_SENSORS_UPPERHALF */
+
 #endif /* CONFIG_I2C && CONFIG_SENSORS_LSM6DSL */
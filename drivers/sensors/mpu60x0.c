@@ -57,6 +57,10 @@
 #include <nuttx/spi/spi.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/sensors/mpu60x0.h>
+#ifdef CONFIG_SENSORS_UPPERHALF
+#  include <nuttx/wqueue.h>
+#  include <nuttx/sensors/sensor.h>
+#endif
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -83,6 +87,19 @@
 #define MPU_REG_READ 0x80
 #define MPU_REG_WRITE 0
 
+/* Common sensor upper half support */
+
+#ifdef CONFIG_SENSORS_UPPERHALF
+#  define MPU_FIFO_SIZE    1024        /* Hardware FIFO size in bytes */
+#  define MPU_FIFO_CHUNK   16          /* Frames read in one transfer */
+#  define MPU_FRAME_SIZE   14          /* accel, temp and gyro */
+
+/* The ranges set up by mpu_reset(): +/- 8g and +/- 1000 deg/sec */
+
+#  define MPU_ACCEL_SCALE  (SENSOR_GRAVITY / 4096.0f)
+#  define MPU_GYRO_SCALE   (3.14159265f / 180.0f / 32.8f)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -123,6 +140,11 @@ enum mpu_regaddr_e
 
   MOT_THR = 0x1f,
   FIFO_EN = 0x23,
+  FIFO_EN__TEMP_FIFO_EN = BIT(7),
+  FIFO_EN__XG_FIFO_EN = BIT(6),
+  FIFO_EN__YG_FIFO_EN = BIT(5),
+  FIFO_EN__ZG_FIFO_EN = BIT(4),
+  FIFO_EN__ACCEL_FIFO_EN = BIT(3),
   I2C_MST_CTRL = 0x24,
   I2C_SLV0_ADDR = 0x25,
   I2C_SLV0_REG = 0x26,
@@ -154,6 +176,7 @@ enum mpu_regaddr_e
 
   INT_ENABLE = 0x38,
   INT_STATUS = 0x3a,          /* RO */
+  INT_STATUS__FIFO_OFLOW_INT = BIT(4),
 
   ACCEL_XOUT_H = 0x3b,        /* RO */
   ACCEL_XOUT_L = 0x3c,        /* RO */
@@ -247,6 +270,17 @@ begin_packed_struct struct sensor_data_s
   int16_t z_gyro;
 } end_packed_struct;
 
+#ifdef CONFIG_SENSORS_UPPERHALF
+/* One of the two sensors of the chip, as seen by the sensor upper half */
+
+struct mpu_sensor_s
+{
+  struct sensor_lowerhalf_s lower;   /* Must be first */
+  FAR struct mpu_dev_s *dev;
+  bool enabled;
+};
+#endif
+
 /* Used by the driver to manage the device */
 
 struct mpu_dev_s
@@ -256,6 +290,21 @@ struct mpu_dev_s
 
   struct sensor_data_s buf;   /* temporary buffer (for read(), etc.) */
   size_t bufpos;              /* cursor into @buf, in bytes (!) */
+
+#ifdef CONFIG_SENSORS_UPPERHALF
+  /* Used only through the sensor upper half.  Both sensors always go to
+   * the FIFO and share the sample rate.
+   */
+
+  struct mpu_sensor_s accel;
+  struct mpu_sensor_s gyro;
+  struct work_s work;         /* drains the FIFO */
+  unsigned int interval;      /* sample interval, usec */
+  unsigned int latency;       /* batch latency, usec */
+  uint8_t fifo[MPU_FIFO_CHUNK * MPU_FRAME_SIZE];
+  struct sensor_event_accel_s aevents[MPU_FIFO_CHUNK];
+  struct sensor_event_gyro_s gevents[MPU_FIFO_CHUNK];
+#endif
 };
 
 /****************************************************************************
@@ -270,6 +319,14 @@ static ssize_t mpu_write(FAR struct file *filep, FAR const char *buf,
 static off_t mpu_seek(FAR struct file *filep, off_t offset, int whence);
 static int mpu_ioctl(FAR struct file *filep, int cmd, unsigned long arg);
 
+#ifdef CONFIG_SENSORS_UPPERHALF
+static int mpu_activate(FAR struct sensor_lowerhalf_s *lower, bool enable);
+static int mpu_set_interval(FAR struct sensor_lowerhalf_s *lower,
+                            FAR unsigned int *period_us);
+static int mpu_batch(FAR struct sensor_lowerhalf_s *lower,
+                     FAR unsigned int *latency_us);
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -288,6 +345,16 @@ static const struct file_operations g_mpu_fops =
 #endif
 };
 
+#ifdef CONFIG_SENSORS_UPPERHALF
+static const struct sensor_ops_s g_mpu_sensor_ops =
+{
+  mpu_activate,       /* activate */
+  mpu_set_interval,   /* set_interval */
+  mpu_batch,          /* batch */
+  NULL                /* control */
+};
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -719,6 +786,229 @@ static int mpu_reset(FAR struct mpu_dev_s *dev)
   return 0;
 }
 
+#ifdef CONFIG_SENSORS_UPPERHALF
+/* __mpu_fifo_reset()
+ *
+ * Disables, resets and (if @enable) re-enables the FIFO. Since frames
+ * have a fixed size, this is also how we get back in sync after an
+ * overflow.
+ */
+
+static int __mpu_fifo_reset(FAR struct mpu_dev_s *dev, bool enable)
+{
+  uint8_t user_ctrl = dev->config.spi ? USER_CTRL__I2C_IF_DIS : 0;
+  uint8_t fifo_en = FIFO_EN__TEMP_FIFO_EN | FIFO_EN__XG_FIFO_EN |
+                    FIFO_EN__YG_FIFO_EN | FIFO_EN__ZG_FIFO_EN |
+                    FIFO_EN__ACCEL_FIFO_EN;
+  uint8_t zero = 0;
+
+  __mpu_write_reg(dev, FIFO_EN, &zero, sizeof(zero));
+  __mpu_write_user_ctrl(dev, user_ctrl | USER_CTRL__FIFO_RESET);
+
+  if (enable)
+    {
+      __mpu_write_user_ctrl(dev, user_ctrl | USER_CTRL__FIFO_EN);
+      return __mpu_write_reg(dev, FIFO_EN, &fifo_en, sizeof(fifo_en));
+    }
+
+  return __mpu_write_user_ctrl(dev, user_ctrl);
+}
+
+/* Converts a big endian register pair. */
+
+static inline int16_t mpu_be16(FAR const uint8_t *p)
+{
+  return (int16_t)((p[0] << 8) | p[1]);
+}
+
+/* mpu_fifo_worker()
+ *
+ * Drains the FIFO in bursts of up to MPU_FIFO_CHUNK frames and pushes
+ * the samples to the upper half. Runs every batch latency (or every
+ * sample interval if batching is disabled) while a sensor is enabled.
+ */
+
+static void mpu_fifo_worker(FAR void *arg)
+{
+  FAR struct mpu_dev_s *dev = arg;
+  FAR struct sensor_event_accel_s *ae;
+  FAR struct sensor_event_gyro_s *ge;
+  FAR const uint8_t *frame;
+  unsigned int nframes;
+  unsigned int delay;
+  unsigned int n;
+  unsigned int i;
+  uint8_t count[2];
+  uint8_t status;
+  uint64_t now;
+
+  mpu_lock(dev);
+
+  if (!dev->accel.enabled && !dev->gyro.enabled)
+    {
+      mpu_unlock(dev);
+      return;
+    }
+
+  /* After an overflow the frame boundaries are lost: start over. */
+
+  __mpu_read_reg(dev, INT_STATUS, &status, sizeof(status));
+  if (status & INT_STATUS__FIFO_OFLOW_INT)
+    {
+      snwarn("WARNING: FIFO overflow\n");
+      __mpu_fifo_reset(dev, true);
+      nframes = 0;
+    }
+  else
+    {
+      __mpu_read_reg(dev, FIFO_COUNTH, count, sizeof(count));
+      nframes = ((count[0] << 8) | count[1]) / MPU_FRAME_SIZE;
+    }
+
+  now = sensor_get_timestamp();
+
+  while (nframes > 0)
+    {
+      n = nframes > MPU_FIFO_CHUNK ? MPU_FIFO_CHUNK : nframes;
+      __mpu_read_reg(dev, FIFO_R_W, dev->fifo, n * MPU_FRAME_SIZE);
+
+      for (i = 0; i < n; i++)
+        {
+          /* The last frame in the FIFO is the newest */
+
+          frame = &dev->fifo[i * MPU_FRAME_SIZE];
+          ae    = &dev->aevents[i];
+          ge    = &dev->gevents[i];
+
+          ae->timestamp   = now - (uint64_t)(nframes - 1 - i) *
+                            dev->interval;
+          ae->x           = mpu_be16(&frame[0]) * MPU_ACCEL_SCALE;
+          ae->y           = mpu_be16(&frame[2]) * MPU_ACCEL_SCALE;
+          ae->z           = mpu_be16(&frame[4]) * MPU_ACCEL_SCALE;
+          ae->temperature = mpu_be16(&frame[6]) / 340.0f + 36.53f;
+
+          ge->timestamp   = ae->timestamp;
+          ge->x           = mpu_be16(&frame[8]) * MPU_GYRO_SCALE;
+          ge->y           = mpu_be16(&frame[10]) * MPU_GYRO_SCALE;
+          ge->z           = mpu_be16(&frame[12]) * MPU_GYRO_SCALE;
+          ge->temperature = ae->temperature;
+        }
+
+      if (dev->accel.enabled)
+        {
+          dev->accel.lower.push_event(dev->accel.lower.priv, dev->aevents,
+                                      n * sizeof(dev->aevents[0]));
+        }
+
+      if (dev->gyro.enabled)
+        {
+          dev->gyro.lower.push_event(dev->gyro.lower.priv, dev->gevents,
+                                     n * sizeof(dev->gevents[0]));
+        }
+
+      nframes -= n;
+    }
+
+  delay = dev->latency > dev->interval ? dev->latency : dev->interval;
+  work_queue(LPWORK, &dev->work, mpu_fifo_worker, dev,
+             USEC2TICK(delay) > 0 ? USEC2TICK(delay) : 1);
+
+  mpu_unlock(dev);
+}
+
+/* mpu_activate()
+ *
+ * The chip is woken up and the FIFO started with the first enabled
+ * sensor, and put back to sleep when the last one is disabled.
+ */
+
+static int mpu_activate(FAR struct sensor_lowerhalf_s *lower, bool enable)
+{
+  FAR struct mpu_sensor_s *sensor = (FAR struct mpu_sensor_s *)lower;
+  FAR struct mpu_dev_s *dev = sensor->dev;
+  bool wasidle;
+
+  mpu_lock(dev);
+
+  wasidle         = !dev->accel.enabled && !dev->gyro.enabled;
+  sensor->enabled = enable;
+
+  if (wasidle && enable)
+    {
+      /* Disable SLEEP, use PLL with z-axis clock source */
+
+      __mpu_write_pwr_mgmt_1(dev, 3);
+      up_mdelay(2);
+
+      __mpu_fifo_reset(dev, true);
+      work_queue(LPWORK, &dev->work, mpu_fifo_worker, dev,
+                 USEC2TICK(dev->interval) > 0 ?
+                 USEC2TICK(dev->interval) : 1);
+    }
+  else if (!dev->accel.enabled && !dev->gyro.enabled)
+    {
+      work_cancel(LPWORK, &dev->work);
+      __mpu_fifo_reset(dev, false);
+      __mpu_write_pwr_mgmt_1(dev, PWR_MGMT_1__SLEEP | 3);
+    }
+
+  mpu_unlock(dev);
+  return OK;
+}
+
+/* mpu_set_interval()
+ *
+ * With the digital low-pass filter enabled, the sample rate is
+ * 1kHz / (1 + SMPLRT_DIV).
+ */
+
+static int mpu_set_interval(FAR struct sensor_lowerhalf_s *lower,
+                            FAR unsigned int *period_us)
+{
+  FAR struct mpu_sensor_s *sensor = (FAR struct mpu_sensor_s *)lower;
+  FAR struct mpu_dev_s *dev = sensor->dev;
+  unsigned int div = *period_us / 1000;
+  uint8_t val;
+
+  div = div > 256 ? 256 : div < 1 ? 1 : div;
+  val = div - 1;
+
+  mpu_lock(dev);
+  __mpu_write_reg(dev, SMPLRT_DIV, &val, sizeof(val));
+  dev->interval = div * 1000;
+  *period_us    = dev->interval;
+  mpu_unlock(dev);
+
+  return OK;
+}
+
+/* mpu_batch()
+ *
+ * Only sets how often the FIFO is drained, leaving some headroom so that
+ * it never overflows.
+ */
+
+static int mpu_batch(FAR struct sensor_lowerhalf_s *lower,
+                     FAR unsigned int *latency_us)
+{
+  FAR struct mpu_sensor_s *sensor = (FAR struct mpu_sensor_s *)lower;
+  FAR struct mpu_dev_s *dev = sensor->dev;
+  unsigned int max;
+
+  mpu_lock(dev);
+
+  max = (lower->batch_number * 3 / 4) * dev->interval;
+  if (*latency_us > max)
+    {
+      *latency_us = max;
+    }
+
+  dev->latency = *latency_us;
+  mpu_unlock(dev);
+  return OK;
+}
+#endif /* CONFIG_SENSORS_UPPERHALF */
+
 /****************************************************************************
  * Name: mpu_open
  *
@@ -964,3 +1254,93 @@ int mpu60x0_register(FAR const char *path, FAR struct mpu_config_s *config)
 
   return mpu_reset(priv);
 }
+
+#ifdef CONFIG_SENSORS_UPPERHALF
+/****************************************************************************
+ * Name: mpu60x0_register_sensors
+ *
+ * Description:
+ *   Registers the mpu60x0 accelerometer and gyroscope with the sensor
+ *   upper half as /dev/sensor/accel<devno> and /dev/sensor/gyro<devno>.
+ *
+ * Input Parameters:
+ *   devno    - The device number
+ *   config   - Configuration information
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int mpu60x0_register_sensors(int devno, FAR struct mpu_config_s *config)
+{
+  FAR struct mpu_dev_s *priv;
+  int ret;
+
+  /* Without config info, we can't do anything. */
+
+  if (config == NULL)
+    {
+      return -EINVAL;
+    }
+
+  priv = (FAR struct mpu_dev_s *)kmm_zalloc(sizeof(struct mpu_dev_s));
+  if (priv == NULL)
+    {
+      snerr("ERROR: Failed to allocate mpu60x0 device instance\n");
+      return -ENOMEM;
+    }
+
+  nxmutex_init(&priv->lock);
+  priv->config   = *config;
+  priv->interval = 1000;
+
+  /* Reset the chip, to give it an initial configuration, and keep it
+   * asleep until a sensor is activated.
+   */
+
+  ret = mpu_reset(priv);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  mpu_lock(priv);
+  __mpu_write_pwr_mgmt_1(priv, PWR_MGMT_1__SLEEP | 3);
+  mpu_unlock(priv);
+
+  priv->accel.dev                 = priv;
+  priv->accel.lower.type          = SENSOR_TYPE_ACCELEROMETER;
+  priv->accel.lower.buffer_number = MPU_FIFO_CHUNK;
+  priv->accel.lower.batch_number  = MPU_FIFO_SIZE / MPU_FRAME_SIZE;
+  priv->accel.lower.ops           = &g_mpu_sensor_ops;
+
+  priv->gyro.dev                  = priv;
+  priv->gyro.lower.type           = SENSOR_TYPE_GYROSCOPE;
+  priv->gyro.lower.buffer_number  = MPU_FIFO_CHUNK;
+  priv->gyro.lower.batch_number   = MPU_FIFO_SIZE / MPU_FRAME_SIZE;
+  priv->gyro.lower.ops            = &g_mpu_sensor_ops;
+
+  ret = sensor_register(&priv->accel.lower, devno);
+  if (ret < 0)
+    {
+      snerr("ERROR: Failed to register accel: %d\n", ret);
+      goto errout;
+    }
+
+  ret = sensor_register(&priv->gyro.lower, devno);
+  if (ret < 0)
+    {
+      snerr("ERROR: Failed to register gyro: %d\n", ret);
+      sensor_unregister(&priv->accel.lower, devno);
+      goto errout;
+    }
+
+  return OK;
+
+errout:
+  nxmutex_destroy(&priv->lock);
+  kmm_free(priv);
+  return ret;
+}
+#endif /* CONFIG_SENSORS_UPPERHALF */
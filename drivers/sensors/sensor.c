@@ -0,0 +1,811 @@
+/****************************************************************************
+ * drivers/sensors/sensor.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/sensors/sensor.h>
+
+#ifdef CONFIG_SENSORS_UPPERHALF
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define DEVNAME_FMT     "/dev/sensor/%s%d"
+#define DEVNAME_MAX     32
+
+/* Default interval: 100 Hz */
+
+#define SENSOR_DEFAULT_INTERVAL  10000
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Static information about each sensor type */
+
+struct sensor_info_s
+{
+  uint8_t esize;               /* Size of one event */
+  FAR const char *name;        /* Device node name */
+};
+
+/* The state of one registered sensor */
+
+struct sensor_upperhalf_s
+{
+  FAR struct sensor_lowerhalf_s *lower;
+  sem_t exclsem;               /* Serializes open/close/ioctl */
+  sem_t buffersem;             /* Wakes up readers waiting for events */
+  uint8_t crefs;               /* Number of opens */
+  uint8_t nwaiters;            /* Number of readers waiting for events */
+  bool enabled;                /* The sensor is activated */
+  unsigned int interval;       /* Sampling interval in microseconds */
+  unsigned int latency;        /* Batch latency in microseconds */
+
+  /* Ring buffer of events, indices are free running event counts.
+   * Updated with interrupts disabled since push_event() may be called
+   * from interrupt handlers.
+   */
+
+  FAR uint8_t *buffer;
+  size_t esize;                /* Size of one event */
+  size_t nevents;              /* Capacity of the ring in events */
+  size_t head;                 /* Next event to read */
+  size_t tail;                 /* Next event to write */
+
+  FAR struct pollfd *fds[CONFIG_SENSORS_NPOLLWAITERS];
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     sensor_open(FAR struct file *filep);
+static int     sensor_close(FAR struct file *filep);
+static ssize_t sensor_read(FAR struct file *filep, FAR char *buffer,
+                           size_t buflen);
+static int     sensor_ioctl(FAR struct file *filep, int cmd,
+                            unsigned long arg);
+static int     sensor_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                           bool setup);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct sensor_info_s g_sensor_info[SENSOR_TYPE_COUNT] =
+{
+  { sizeof(struct sensor_event_accel_s), "accel" },
+  { sizeof(struct sensor_event_mag_s),   "mag"   },
+  { sizeof(struct sensor_event_gyro_s),  "gyro"  },
+  { sizeof(struct sensor_event_baro_s),  "baro"  },
+  { sizeof(struct sensor_event_temp_s),  "temp"  },
+  { sizeof(struct sensor_event_humi_s),  "humi"  },
+  { sizeof(struct sensor_event_light_s), "light" },
+};
+
+static const struct file_operations g_sensor_fops =
+{
+  sensor_open,    /* open */
+  sensor_close,   /* close */
+  sensor_read,    /* read */
+  NULL,           /* write */
+  NULL,           /* seek */
+  sensor_ioctl,   /* ioctl */
+  sensor_poll     /* poll */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , NULL          /* unlink */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sensor_pollnotify
+ ****************************************************************************/
+
+static void sensor_pollnotify(FAR struct sensor_upperhalf_s *upper,
+                              pollevent_t eventset)
+{
+  FAR struct pollfd *fds;
+  int i;
+
+  for (i = 0; i < CONFIG_SENSORS_NPOLLWAITERS; i++)
+    {
+      fds = upper->fds[i];
+      if (fds != NULL)
+        {
+          fds->revents |= fds->events & eventset;
+          if (fds->revents != 0)
+            {
+              sninfo("Report events: %02x\n", fds->revents);
+              nxsem_post(fds->sem);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: sensor_resize
+ *
+ * Description:
+ *   Make the ring hold at least nevents events.  Buffered events are
+ *   kept, the oldest ones are dropped if they no longer fit.
+ *
+ ****************************************************************************/
+
+static int sensor_resize(FAR struct sensor_upperhalf_s *upper,
+                         size_t nevents)
+{
+  FAR uint8_t *buffer;
+  FAR uint8_t *old;
+  irqstate_t flags;
+  size_t count;
+  size_t i;
+
+  if (nevents == 0)
+    {
+      nevents = 1;
+    }
+
+  if (upper->buffer != NULL && nevents == upper->nevents)
+    {
+      return OK;
+    }
+
+  buffer = kmm_malloc(nevents * upper->esize);
+  if (buffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  flags = enter_critical_section();
+
+  count = upper->tail - upper->head;
+  if (count > nevents)
+    {
+      upper->head += count - nevents;
+      count = nevents;
+    }
+
+  for (i = 0; i < count; i++)
+    {
+      memcpy(buffer + i * upper->esize,
+             upper->buffer +
+             ((upper->head + i) % upper->nevents) * upper->esize,
+             upper->esize);
+    }
+
+  old           = upper->buffer;
+  upper->buffer = buffer;
+  upper->head   = 0;
+  upper->tail   = count;
+  upper->nevents = nevents;
+
+  leave_critical_section(flags);
+
+  kmm_free(old);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: sensor_batch_resize
+ *
+ * Description:
+ *   Make sure that the ring can hold two full batches, so that a burst
+ *   from the hardware FIFO does not overwrite events that have not been
+ *   read yet.
+ *
+ ****************************************************************************/
+
+static int sensor_batch_resize(FAR struct sensor_upperhalf_s *upper)
+{
+  size_t nevents = upper->lower->buffer_number;
+  size_t batch;
+
+  if (upper->latency > 0 && upper->interval > 0)
+    {
+      batch = upper->latency / upper->interval + 1;
+      if (nevents < 2 * batch)
+        {
+          nevents = 2 * batch;
+        }
+    }
+
+  if (nevents < upper->nevents)
+    {
+      /* Never shrink implicitly */
+
+      return OK;
+    }
+
+  return sensor_resize(upper, nevents);
+}
+
+/****************************************************************************
+ * Name: sensor_push_event
+ *
+ * Description:
+ *   Called by the lower half to add events.  If the ring is full, the
+ *   oldest events are overwritten.
+ *
+ ****************************************************************************/
+
+static void sensor_push_event(FAR void *priv, FAR const void *data,
+                              size_t bytes)
+{
+  FAR struct sensor_upperhalf_s *upper = priv;
+  FAR const uint8_t *src = data;
+  irqstate_t flags;
+  size_t nevents;
+  size_t pos;
+  size_t n;
+
+  nevents = bytes / upper->esize;
+  if (nevents == 0)
+    {
+      return;
+    }
+
+  flags = enter_critical_section();
+
+  /* Only the newest events are kept if the burst is larger than the
+   * whole ring.
+   */
+
+  if (nevents > upper->nevents)
+    {
+      src     += (nevents - upper->nevents) * upper->esize;
+      nevents  = upper->nevents;
+    }
+
+  /* Copy in at most two contiguous pieces */
+
+  while (nevents > 0)
+    {
+      pos = upper->tail % upper->nevents;
+      n   = upper->nevents - pos;
+      if (n > nevents)
+        {
+          n = nevents;
+        }
+
+      memcpy(upper->buffer + pos * upper->esize, src, n * upper->esize);
+      src         += n * upper->esize;
+      upper->tail += n;
+      nevents     -= n;
+    }
+
+  if (upper->tail - upper->head > upper->nevents)
+    {
+      upper->head = upper->tail - upper->nevents;
+    }
+
+  /* Wake up any readers */
+
+  while (upper->nwaiters > 0)
+    {
+      upper->nwaiters--;
+      nxsem_post(&upper->buffersem);
+    }
+
+  sensor_pollnotify(upper, POLLIN);
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: sensor_open
+ ****************************************************************************/
+
+static int sensor_open(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct sensor_upperhalf_s *upper = inode->i_private;
+  int ret;
+
+  ret = nxsem_wait(&upper->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (upper->crefs == UINT8_MAX)
+    {
+      ret = -EMFILE;
+    }
+  else
+    {
+      upper->crefs++;
+    }
+
+  nxsem_post(&upper->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: sensor_close
+ ****************************************************************************/
+
+static int sensor_close(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct sensor_upperhalf_s *upper = inode->i_private;
+  FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  int ret;
+
+  ret = nxsem_wait_uninterruptible(&upper->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Turn the sensor off when the last user goes away */
+
+  if (--upper->crefs == 0 && upper->enabled)
+    {
+      ret = lower->ops->activate(lower, false);
+      if (ret >= 0)
+        {
+          upper->enabled = false;
+        }
+    }
+
+  nxsem_post(&upper->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: sensor_read
+ *
+ * Description:
+ *   Return as many buffered events as fit into the user buffer, oldest
+ *   first.  Blocks until at least one event is available unless the file
+ *   was opened with O_NONBLOCK.
+ *
+ ****************************************************************************/
+
+static ssize_t sensor_read(FAR struct file *filep, FAR char *buffer,
+                           size_t buflen)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct sensor_upperhalf_s *upper = inode->i_private;
+  irqstate_t flags;
+  size_t nevents;
+  size_t count;
+  size_t pos;
+  size_t n;
+  int ret;
+
+  if (buffer == NULL || buflen < upper->esize)
+    {
+      return -EINVAL;
+    }
+
+  nevents = buflen / upper->esize;
+
+  ret = nxsem_wait(&upper->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  flags = enter_critical_section();
+
+  while (upper->head == upper->tail)
+    {
+      /* Nothing will come if the sensor is not active */
+
+      if ((filep->f_oflags & O_NONBLOCK) != 0 || !upper->enabled)
+        {
+          ret = -EAGAIN;
+          goto out;
+        }
+
+      upper->nwaiters++;
+      nxsem_post(&upper->exclsem);
+      ret = nxsem_wait(&upper->buffersem);
+      if (ret < 0)
+        {
+          /* The post will not come now, the waiter must be removed */
+
+          if (upper->nwaiters > 0)
+            {
+              upper->nwaiters--;
+            }
+
+          leave_critical_section(flags);
+          return ret;
+        }
+
+      ret = nxsem_wait(&upper->exclsem);
+      if (ret < 0)
+        {
+          leave_critical_section(flags);
+          return ret;
+        }
+    }
+
+  count = upper->tail - upper->head;
+  if (nevents > count)
+    {
+      nevents = count;
+    }
+
+  for (count = 0; count < nevents; count += n)
+    {
+      pos = upper->head % upper->nevents;
+      n   = upper->nevents - pos;
+      if (n > nevents - count)
+        {
+          n = nevents - count;
+        }
+
+      memcpy(buffer + count * upper->esize,
+             upper->buffer + pos * upper->esize, n * upper->esize);
+      upper->head += n;
+    }
+
+  ret = nevents * upper->esize;
+
+out:
+  leave_critical_section(flags);
+  nxsem_post(&upper->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: sensor_ioctl
+ ****************************************************************************/
+
+static int sensor_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct sensor_upperhalf_s *upper = inode->i_private;
+  FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  FAR unsigned int *val = (FAR unsigned int *)((uintptr_t)arg);
+  unsigned int saved;
+  int ret;
+
+  ret = nxsem_wait(&upper->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  switch (cmd)
+    {
+      /* Enable or disable the sensor.  Arg: bool value */
+
+      case SNIOC_ACTIVATE:
+        {
+          bool enable = arg != 0;
+
+          if (enable != upper->enabled)
+            {
+              ret = lower->ops->activate(lower, enable);
+              if (ret >= 0)
+                {
+                  upper->enabled = enable;
+                }
+            }
+        }
+        break;
+
+      /* Set the interval.  Arg: FAR unsigned int *, usec (in/out) */
+
+      case SNIOC_SET_INTERVAL_US:
+        {
+          if (val == NULL || *val == 0)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          ret = lower->ops->set_interval(lower, val);
+          if (ret >= 0)
+            {
+              upper->interval = *val;
+              ret = sensor_batch_resize(upper);
+            }
+        }
+        break;
+
+      /* Set the batch latency.  Arg: FAR unsigned int *, usec (in/out) */
+
+      case SNIOC_BATCH:
+        {
+          if (val == NULL)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          if (lower->ops->batch == NULL || lower->batch_number == 0)
+            {
+              /* No FIFO: every event is delivered as it comes */
+
+              if (*val != 0)
+                {
+                  ret = -ENOTSUP;
+                }
+
+              break;
+            }
+
+          /* Make room in the ring before the hardware starts batching */
+
+          saved = upper->latency;
+          upper->latency = *val;
+          ret = sensor_batch_resize(upper);
+          if (ret >= 0)
+            {
+              ret = lower->ops->batch(lower, val);
+            }
+
+          upper->latency = ret >= 0 ? *val : saved;
+        }
+        break;
+
+      /* Set the ring size.  Arg: unsigned long value, events */
+
+      case SNIOC_SET_BUFFER_NUMBER:
+        {
+          if (arg < lower->buffer_number)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          ret = sensor_resize(upper, arg);
+        }
+        break;
+
+      default:
+        if (lower->ops->control != NULL)
+          {
+            ret = lower->ops->control(lower, cmd, arg);
+          }
+        else
+          {
+            ret = -ENOTTY;
+          }
+        break;
+    }
+
+  nxsem_post(&upper->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: sensor_poll
+ ****************************************************************************/
+
+static int sensor_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                       bool setup)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct sensor_upperhalf_s *upper = inode->i_private;
+  irqstate_t flags;
+  int ret;
+  int i;
+
+  ret = nxsem_wait(&upper->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (setup)
+    {
+      /* Find an available slot for the poll structure reference */
+
+      for (i = 0; i < CONFIG_SENSORS_NPOLLWAITERS; i++)
+        {
+          if (upper->fds[i] == NULL)
+            {
+              upper->fds[i] = fds;
+              fds->priv     = &upper->fds[i];
+              break;
+            }
+        }
+
+      if (i >= CONFIG_SENSORS_NPOLLWAITERS)
+        {
+          fds->priv = NULL;
+          ret       = -EBUSY;
+          goto errout;
+        }
+
+      /* Should we immediately notify on any of the requested events? */
+
+      flags = enter_critical_section();
+      if (upper->head != upper->tail)
+        {
+          sensor_pollnotify(upper, POLLIN);
+        }
+
+      leave_critical_section(flags);
+    }
+  else if (fds->priv != NULL)
+    {
+      /* This is a request to tear down the poll */
+
+      FAR struct pollfd **slot = (FAR struct pollfd **)fds->priv;
+
+      *slot     = NULL;
+      fds->priv = NULL;
+    }
+
+errout:
+  nxsem_post(&upper->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sensor_get_timestamp
+ *
+ * Description:
+ *   Return the current time in microseconds, for use as event timestamp.
+ *
+ ****************************************************************************/
+
+uint64_t sensor_get_timestamp(void)
+{
+  struct timespec ts;
+
+  clock_systimespec(&ts);
+  return (uint64_t)ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+}
+
+/****************************************************************************
+ * Name: sensor_register
+ *
+ * Description:
+ *   Register the sensor lower half as /dev/sensor/<name><devno>.
+ *
+ * Input Parameters:
+ *   lower - The lower half instance
+ *   devno - The device number
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int sensor_register(FAR struct sensor_lowerhalf_s *lower, int devno)
+{
+  FAR struct sensor_upperhalf_s *upper;
+  char path[DEVNAME_MAX];
+  int ret;
+
+  DEBUGASSERT(lower != NULL && lower->ops != NULL &&
+              lower->ops->activate != NULL &&
+              lower->ops->set_interval != NULL);
+
+  if (lower->type < 0 || lower->type >= SENSOR_TYPE_COUNT)
+    {
+      return -EINVAL;
+    }
+
+  upper = kmm_zalloc(sizeof(struct sensor_upperhalf_s));
+  if (upper == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  upper->lower    = lower;
+  upper->esize    = g_sensor_info[lower->type].esize;
+  upper->interval = SENSOR_DEFAULT_INTERVAL;
+
+  nxsem_init(&upper->exclsem, 0, 1);
+  nxsem_init(&upper->buffersem, 0, 0);
+
+  /* The buffer semaphore is used for signaling and, hence, should not
+   * have priority inheritance enabled.
+   */
+
+  nxsem_setprotocol(&upper->buffersem, SEM_PRIO_NONE);
+
+  ret = sensor_resize(upper, lower->buffer_number);
+  if (ret < 0)
+    {
+      goto errout_with_upper;
+    }
+
+  lower->push_event = sensor_push_event;
+  lower->priv       = upper;
+
+  snprintf(path, DEVNAME_MAX, DEVNAME_FMT,
+           g_sensor_info[lower->type].name, devno);
+
+  sninfo("Registering %s\n", path);
+
+  ret = register_driver(path, &g_sensor_fops, 0666, upper);
+  if (ret < 0)
+    {
+      goto errout_with_buffer;
+    }
+
+  return OK;
+
+errout_with_buffer:
+  kmm_free(upper->buffer);
+
+errout_with_upper:
+  nxsem_destroy(&upper->exclsem);
+  nxsem_destroy(&upper->buffersem);
+  kmm_free(upper);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: sensor_unregister
+ *
+ * Description:
+ *   Unregister a sensor registered with sensor_register().
+ *
+ * Input Parameters:
+ *   lower - The lower half instance
+ *   devno - The device number
+ *
+ ****************************************************************************/
+
+void sensor_unregister(FAR struct sensor_lowerhalf_s *lower, int devno)
+{
+  FAR struct sensor_upperhalf_s *upper = lower->priv;
+  char path[DEVNAME_MAX];
+
+  snprintf(path, DEVNAME_MAX, DEVNAME_FMT,
+           g_sensor_info[lower->type].name, devno);
+  unregister_driver(path);
+
+  nxsem_destroy(&upper->exclsem);
+  nxsem_destroy(&upper->buffersem);
+  kmm_free(upper->buffer);
+  kmm_free(upper);
+}
+
+#endif /* CONFIG_SENSORS_UPPERHALF */
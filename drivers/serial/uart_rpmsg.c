@@ -45,6 +45,7 @@
 #include <string.h>
 
 #include <nuttx/fs/ioctl.h>
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/rptun/openamp.h>
 #include <nuttx/serial/serial.h>
@@ -91,7 +92,8 @@ struct uart_rpmsg_priv_s
   struct rpmsg_endpoint ept;
   FAR const char        *devname;
   FAR const char        *cpuname;
-  FAR void              *recv_data;
+  FAR void              *recv_data; /* Write message being received */
+  uint32_t              recv_pos;   /* Bytes of recv_data consumed */
   bool                  last_upper;
 #ifdef CONFIG_SERIAL_TERMIOS
   struct termios        termios;
@@ -291,7 +293,8 @@ static void uart_rpmsg_dmareceive(FAR struct uart_dev_s *dev)
   FAR struct uart_rpmsg_priv_s *priv = dev->priv;
   FAR struct uart_dmaxfer_s *xfer = &dev->dmarx;
   FAR struct uart_rpmsg_write_s *msg = priv->recv_data;
-  uint32_t len = msg->count;
+  uint32_t pos = priv->recv_pos;
+  uint32_t len = msg->count - pos;
   size_t space = xfer->length + xfer->nlength;
 
   if (len > space)
@@ -301,28 +304,65 @@ static void uart_rpmsg_dmareceive(FAR struct uart_dev_s *dev)
 
   if (len > xfer->length)
     {
-      bmem2cmem(xfer->buffer, msg->data, 0, xfer->length);
-      bmem2cmem(xfer->nbuffer, msg->data + B2C_OFF(xfer->length),
-              B2C_REM(xfer->length), len - xfer->length);
+      bmem2cmem(xfer->buffer, msg->data + B2C_OFF(pos), B2C_REM(pos),
+              xfer->length);
+      pos += xfer->length;
+      bmem2cmem(xfer->nbuffer, msg->data + B2C_OFF(pos), B2C_REM(pos),
+              len - xfer->length);
     }
   else
     {
-      bmem2cmem(xfer->buffer, msg->data, 0, len);
+      bmem2cmem(xfer->buffer, msg->data + B2C_OFF(pos), B2C_REM(pos), len);
     }
 
+  priv->recv_pos += len;
+
   xfer->nbytes = len;
   uart_recvchars_done(dev);
+}
+
+/****************************************************************************
+ * Name: uart_rpmsg_recvdone
+ *
+ * Description:
+ *   Acknowledge the write message being received once all of its data is
+ *   in the RX buffer.  Called with interrupts disabled.
+ *
+ ****************************************************************************/
 
-  msg->header.result = len;
+static bool uart_rpmsg_recvdone(FAR struct uart_dev_s *dev)
+{
+  FAR struct uart_rpmsg_priv_s *priv = dev->priv;
+  FAR struct uart_rpmsg_write_s *msg = priv->recv_data;
 
-  if (len != msg->count)
+  if (priv->recv_pos < msg->count)
     {
-      uart_rpmsg_rxflowcontrol(dev, 0, true);
+      return false;
     }
+
+  priv->recv_data = NULL;
+
+  msg->header.response = 1;
+  msg->header.result   = msg->count;
+  rpmsg_send(&priv->ept, msg, sizeof(*msg));
+  return true;
 }
 
 static void uart_rpmsg_dmarxfree(FAR struct uart_dev_s *dev)
 {
+  FAR struct uart_rpmsg_priv_s *priv = dev->priv;
+  FAR void *data = priv->recv_data;
+
+  /* The reader made room, continue with the rx buffer that is held */
+
+  if (data != NULL)
+    {
+      uart_recvchars_dma(dev);
+      if (uart_rpmsg_recvdone(dev))
+        {
+          rpmsg_release_rx_buffer(&priv->ept, data);
+        }
+    }
 }
 
 static void uart_rpmsg_dmatxavail(FAR struct uart_dev_s *dev)
@@ -403,6 +443,7 @@ static void uart_rpmsg_device_destroy(FAR struct rpmsg_device *rdev,
 
   if (strcmp(priv->cpuname, rpmsg_get_cpuname(rdev)) == 0)
     {
+      priv->recv_data = NULL;
       rpmsg_destroy_ept(&priv->ept);
     }
 }
@@ -436,15 +477,26 @@ static int uart_rpmsg_ept_cb(FAR struct rpmsg_endpoint *ept, FAR void *data,
   else if (header->command == UART_RPMSG_TTY_WRITE)
     {
       FAR struct uart_rpmsg_priv_s *priv = dev->priv;
+      irqstate_t flags;
+
+      /* Get write-cmd, there are some data, we need receive them.  If the
+       * RX buffer cannot take all of them, keep the rpmsg buffer and finish
+       * from dmarxfree when the reader makes room, instead of having the
+       * peer send the rest again.
+       */
 
-      /* Get write-cmd, there are some data, we need receive them */
+      flags = enter_critical_section();
 
       priv->recv_data = data;
+      priv->recv_pos  = 0;
       uart_recvchars_dma(dev);
-      priv->recv_data = NULL;
 
-      header->response = 1;
-      rpmsg_send(ept, msg, sizeof(*msg));
+      if (!uart_rpmsg_recvdone(dev))
+        {
+          rpmsg_hold_rx_buffer(ept, data);
+        }
+
+      leave_critical_section(flags);
     }
   else if (header->command == UART_RPMSG_TTY_WAKEUP)
     {
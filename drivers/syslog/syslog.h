@@ -43,6 +43,8 @@
 #include <nuttx/config.h>
 
 #include <stdbool.h>
+#include <stdarg.h>
+#include <time.h>
 
 /****************************************************************************
  * Public Data
@@ -248,6 +250,73 @@ int syslog_flush_intbuffer(FAR const struct syslog_channel_s *channel,
                            bool force);
 #endif
 
+/****************************************************************************
+ * Name: syslog_timestamp
+ *
+ * Description:
+ *   Get the time stamp that prefixes a message: CLOCK_REALTIME with
+ *   CONFIG_SYSLOG_TIMESTAMP_REALTIME, else CLOCK_MONOTONIC if available,
+ *   else the system timer.  Zero if the timer hardware is not ready yet.
+ *
+ * Input Parameters:
+ *   ts - Location to return the time stamp.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+void syslog_timestamp(FAR struct timespec *ts);
+#endif
+
+/****************************************************************************
+ * Name: syslog_deferred
+ *
+ * Description:
+ *   Save the format string pointer, the time stamp and a binary copy of
+ *   the arguments in the ring of the current CPU.  The message is
+ *   formatted and output later by a low priority worker.  The format string
+ *   itself is not copied and must remain valid (i.e., be a string
+ *   constant).
+ *
+ * Input Parameters:
+ *   fmt      - The printf-style format string.
+ *   ap       - The argument list.  It is not consumed.
+ *
+ * Returned Value:
+ *   A non-negative value is returned if the message was recorded (or
+ *   dropped because the ring was full).  A negated errno value is returned
+ *   if the message cannot be deferred and must be output immediately.
+ *
+ * Assumptions:
+ *   May be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+int syslog_deferred(FAR const IPTR char *fmt, FAR va_list *ap);
+#endif
+
+/****************************************************************************
+ * Name: syslog_flush_deferred
+ *
+ * Description:
+ *   Format and output all messages recorded by syslog_deferred().
+ *
+ * Input Parameters:
+ *   force - Use the emergency stream (no buffering, force() method of the
+ *           channel) as needed when called from crash-handling logic.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+void syslog_flush_deferred(bool force);
+#endif
+
 /****************************************************************************
  * Name: syslog_putc
  *
@@ -0,0 +1,736 @@
+/****************************************************************************
+ * drivers/syslog/syslog_deferred.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <limits.h>
+#include <string.h>
+#include <syslog.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/init.h>
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/streams.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/syslog/syslog.h>
+
+#include "syslog.h"
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+#  define DEFERRED_NRINGS   CONFIG_SMP_NCPUS
+#else
+#  define DEFERRED_NRINGS   1
+#endif
+
+#define DEFERRED_BUFSIZE    CONFIG_SYSLOG_DEFERRED_BUFSIZE
+#define DEFERRED_MAXRECORD  CONFIG_SYSLOG_DEFERRED_MAXRECORD
+
+/* Records are kept 8-byte aligned in the ring */
+
+#define DEFERRED_ALIGN(n)   (((n) + 7) & ~7)
+#define DEFERRED_HDRSIZE    DEFERRED_ALIGN(sizeof(struct syslog_record_s))
+
+/* Argument classes, as determined from the conversion specification */
+
+#define DARG_NONE           0  /* "%%" */
+#define DARG_INT            1  /* int and smaller, char */
+#define DARG_LONG           2
+#define DARG_LLONG          3
+#define DARG_SIZE           4  /* size_t and ptrdiff_t */
+#define DARG_PTR            5
+#define DARG_DOUBLE         6
+#define DARG_STRING         7  /* Copied into the record */
+#define DARG_INVALID        8  /* Not supported, format immediately */
+
+/* Precision given by a '*' argument, see deferred_parse() */
+
+#define DEFERRED_PRECSTAR   INT_MAX
+
+/* Longest conversion specification that is reformatted */
+
+#define DEFERRED_SPECLEN    32
+
+/* Without CONFIG_SPINLOCK there is only one CPU, but the compiler must
+ * still not move the record copy after the update of the tail.
+ */
+
+#if !defined(SP_DMB) && defined(__GNUC__)
+#  define SP_DMB()          __asm__ __volatile__ ("" : : : "memory")
+#elif !defined(SP_DMB)
+#  define SP_DMB()
+#endif
+
+#if DEFERRED_BUFSIZE & 7
+#  error CONFIG_SYSLOG_DEFERRED_BUFSIZE must be a multiple of 8
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Header of a message in the ring.  It is followed by the arguments in
+ * the order in which they are consumed by the format string.
+ */
+
+struct syslog_record_s
+{
+  uint16_t size;               /* Aligned size including the header.
+                                * Zero marks padding up to the end of the
+                                * buffer. */
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+  struct timespec time;        /* Time stamp of the call */
+#endif
+  FAR const IPTR char *fmt;    /* Format string, never copied */
+};
+
+/* Ring of one CPU.  Only that CPU produces, with its interrupts disabled,
+ * and only the worker consumes, so no lock is needed between the two.
+ */
+
+struct syslog_ring_s
+{
+  volatile uint32_t head;      /* Consumer offset, free running */
+  volatile uint32_t tail;      /* Producer offset, free running */
+  volatile uint32_t dropped;   /* Messages that did not fit */
+  uint32_t reported;           /* Dropped messages already reported */
+  uint8_t buffer[DEFERRED_BUFSIZE] aligned_data(8);
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct syslog_ring_s g_syslog_rings[DEFERRED_NRINGS];
+static struct work_s g_syslog_work;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: deferred_parse
+ *
+ * Description:
+ *   Parse one conversion specification.  fmt points just after the '%'.
+ *   Returns a pointer to the character after the conversion and provides
+ *   the argument class, the number of '*' width/precision arguments and
+ *   the precision: -1 if none is given, DEFERRED_PRECSTAR if it is the
+ *   last '*' argument.
+ *
+ ****************************************************************************/
+
+static FAR const char *deferred_parse(FAR const char *fmt,
+                                      FAR uint8_t *type,
+                                      FAR uint8_t *nstar,
+                                      FAR int *prec)
+{
+  uint8_t nlong = 0;
+  bool size = false;
+
+  *nstar = 0;
+  *prec  = -1;
+
+  if (*fmt == '%')
+    {
+      *type = DARG_NONE;
+      return fmt + 1;
+    }
+
+  /* Flags, field width and precision */
+
+  while (strchr("-+ #0", *fmt) != NULL && *fmt != '\0')
+    {
+      fmt++;
+    }
+
+  for (; (*fmt >= '0' && *fmt <= '9') || *fmt == '.' || *fmt == '*'; fmt++)
+    {
+      if (*fmt == '*')
+        {
+          (*nstar)++;
+          if (*prec >= 0)
+            {
+              *prec = DEFERRED_PRECSTAR;
+            }
+        }
+      else if (*fmt == '.')
+        {
+          *prec = 0;
+        }
+      else if (*prec >= 0 && *prec != DEFERRED_PRECSTAR &&
+               *prec < DEFERRED_MAXRECORD)
+        {
+          *prec = *prec * 10 + *fmt - '0';
+        }
+    }
+
+  /* Length modifiers */
+
+  for (; ; fmt++)
+    {
+      if (*fmt == 'l')
+        {
+          nlong++;
+        }
+      else if (*fmt == 'j')
+        {
+          nlong = sizeof(intmax_t) > sizeof(long) ? 2 : 1;
+        }
+      else if (*fmt == 'z' || *fmt == 't')
+        {
+          size = true;
+        }
+      else if (*fmt != 'h')
+        {
+          break;
+        }
+    }
+
+  switch (*fmt)
+    {
+      case 'd':
+      case 'i':
+      case 'u':
+      case 'o':
+      case 'x':
+      case 'X':
+      case 'c':
+        *type = size ? DARG_SIZE :
+                nlong == 0 ? DARG_INT :
+                nlong == 1 ? DARG_LONG : DARG_LLONG;
+        break;
+
+      case 'p':
+        *type = DARG_PTR;
+        break;
+
+      case 's':
+        *type = DARG_STRING;
+        break;
+
+      case 'e':
+      case 'E':
+      case 'f':
+      case 'F':
+      case 'g':
+      case 'G':
+        *type = DARG_DOUBLE;
+        break;
+
+      default:
+        *type = DARG_INVALID;
+        return fmt;
+    }
+
+  return fmt + 1;
+}
+
+/****************************************************************************
+ * Name: deferred_capture
+ *
+ * Description:
+ *   Copy the arguments described by fmt from ap into buffer.  Strings are
+ *   copied (and truncated if needed) since they may not outlive the call.
+ *   Returns the number of bytes used or a negated errno value if the
+ *   format cannot be deferred.
+ *
+ ****************************************************************************/
+
+static int deferred_capture(FAR const IPTR char *fmt, va_list ap,
+                            FAR uint8_t *buffer, size_t buflen)
+{
+  FAR const char *str;
+  size_t len = 0;
+  size_t max;
+  size_t n;
+  uint8_t nstar;
+  uint8_t type;
+  int prec;
+  int star = -1;
+
+  union
+  {
+    int i;
+    long l;
+    long long ll;
+    size_t z;
+    FAR void *p;
+    double d;
+  } u;
+
+  while (*fmt != '\0')
+    {
+      if (*fmt++ != '%')
+        {
+          continue;
+        }
+
+      fmt = deferred_parse(fmt, &type, &nstar, &prec);
+
+      while (nstar-- > 0)
+        {
+          if (len + sizeof(int) > buflen)
+            {
+              return -E2BIG;
+            }
+
+          star = va_arg(ap, int);
+          memcpy(buffer + len, &star, sizeof(int));
+          len += sizeof(int);
+        }
+
+      if (prec == DEFERRED_PRECSTAR)
+        {
+          /* A negative precision is taken as if it were omitted */
+
+          prec = star;
+        }
+
+      switch (type)
+        {
+          case DARG_NONE:
+            continue;
+
+          case DARG_INT:
+            u.i = va_arg(ap, int);
+            n = sizeof(int);
+            break;
+
+          case DARG_LONG:
+            u.l = va_arg(ap, long);
+            n = sizeof(long);
+            break;
+
+          case DARG_LLONG:
+            u.ll = va_arg(ap, long long);
+            n = sizeof(long long);
+            break;
+
+          case DARG_SIZE:
+            u.z = va_arg(ap, size_t);
+            n = sizeof(size_t);
+            break;
+
+          case DARG_PTR:
+            u.p = va_arg(ap, FAR void *);
+            n = sizeof(FAR void *);
+            break;
+
+          case DARG_DOUBLE:
+            u.d = va_arg(ap, double);
+            n = sizeof(double);
+            break;
+
+          case DARG_STRING:
+            str = va_arg(ap, FAR const char *);
+            if (str == NULL)
+              {
+                str = "(null)";
+              }
+
+            if (len >= buflen)
+              {
+                return -E2BIG;
+              }
+
+            /* With a precision, the string need not be terminated: read
+             * no further than the precision.
+             */
+
+            max = buflen - len - 1;
+            if (prec >= 0 && prec < max)
+              {
+                max = prec;
+              }
+
+            n = strnlen(str, max);
+            memcpy(buffer + len, str, n);
+            buffer[len + n] = '\0';
+            len += n + 1;
+            continue;
+
+          default:
+            return -ENOSYS;
+        }
+
+      if (len + n > buflen)
+        {
+          return -E2BIG;
+        }
+
+      memcpy(buffer + len, &u, n);
+      len += n;
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: deferred_format
+ *
+ * Description:
+ *   Format a record into the stream.  The format string is walked again;
+ *   literal text is copied and each conversion is formatted on its own
+ *   with the saved argument.
+ *
+ ****************************************************************************/
+
+static void deferred_format(FAR struct lib_outstream_s *stream,
+                            FAR const IPTR char *fmt,
+                            FAR const uint8_t *args)
+{
+  char spec[DEFERRED_SPECLEN];
+  FAR const char *start;
+  FAR const char *end;
+  size_t len;
+  uint8_t nstar;
+  uint8_t type;
+  int prec;
+  int star;
+  int n;
+
+  union
+  {
+    int i;
+    long l;
+    long long ll;
+    size_t z;
+    FAR void *p;
+    double d;
+  } u;
+
+  while (*fmt != '\0')
+    {
+      if (*fmt != '%')
+        {
+          stream->put(stream, *fmt++);
+          continue;
+        }
+
+      start = fmt++;
+      end   = deferred_parse(fmt, &type, &nstar, &prec);
+      fmt   = end;
+
+      if (type == DARG_NONE)
+        {
+          stream->put(stream, '%');
+          continue;
+        }
+
+      /* Copy the specification, replacing '*' by the saved values */
+
+      for (len = 0; start < end && len < DEFERRED_SPECLEN - 12; start++)
+        {
+          if (*start != '*')
+            {
+              spec[len++] = *start;
+              continue;
+            }
+
+          memcpy(&star, args, sizeof(int));
+          args += sizeof(int);
+          n = snprintf(spec + len, 12, "%d", star);
+          len += n > 0 ? n : 0;
+        }
+
+      spec[len] = '\0';
+
+      switch (type)
+        {
+          case DARG_INT:
+            memcpy(&u.i, args, sizeof(int));
+            args += sizeof(int);
+            lib_sprintf(stream, spec, u.i);
+            break;
+
+          case DARG_LONG:
+            memcpy(&u.l, args, sizeof(long));
+            args += sizeof(long);
+            lib_sprintf(stream, spec, u.l);
+            break;
+
+          case DARG_LLONG:
+            memcpy(&u.ll, args, sizeof(long long));
+            args += sizeof(long long);
+            lib_sprintf(stream, spec, u.ll);
+            break;
+
+          case DARG_SIZE:
+            memcpy(&u.z, args, sizeof(size_t));
+            args += sizeof(size_t);
+            lib_sprintf(stream, spec, u.z);
+            break;
+
+          case DARG_PTR:
+            memcpy(&u.p, args, sizeof(FAR void *));
+            args += sizeof(FAR void *);
+            lib_sprintf(stream, spec, u.p);
+            break;
+
+          case DARG_DOUBLE:
+            memcpy(&u.d, args, sizeof(double));
+            args += sizeof(double);
+            lib_sprintf(stream, spec, u.d);
+            break;
+
+          case DARG_STRING:
+            lib_sprintf(stream, spec, (FAR const char *)args);
+            args += strlen((FAR const char *)args) + 1;
+            break;
+
+          default:
+            return;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: deferred_emit
+ *
+ * Description:
+ *   Output one record as nx_vsyslog() would have done at the time of the
+ *   call.
+ *
+ ****************************************************************************/
+
+static void deferred_emit(FAR struct syslog_record_s *rec, bool force)
+{
+  struct lib_syslogstream_s stream;
+
+  if (force)
+    {
+      emergstream(&stream.public);
+    }
+  else
+    {
+      syslogstream_create(&stream);
+    }
+
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+  lib_sprintf(&stream.public, "[%5d.%06d] ", rec->time.tv_sec,
+              rec->time.tv_nsec / 1000);
+#endif
+
+#ifdef CONFIG_SYSLOG_PREFIX
+  lib_sprintf(&stream.public, "%s", CONFIG_SYSLOG_PREFIX_STRING);
+#endif
+
+  deferred_format(&stream.public, rec->fmt,
+                  (FAR const uint8_t *)rec + DEFERRED_HDRSIZE);
+
+#ifdef CONFIG_SYSLOG_BUFFER
+  if (!force)
+    {
+      syslogstream_destroy(&stream);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: deferred_worker
+ ****************************************************************************/
+
+static void deferred_worker(FAR void *arg)
+{
+  syslog_flush_deferred(false);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_deferred
+ *
+ * Description:
+ *   Record a message in the binary ring of the current CPU for formatting
+ *   by the worker.
+ *
+ ****************************************************************************/
+
+int syslog_deferred(FAR const IPTR char *fmt, FAR va_list *ap)
+{
+  union
+  {
+    struct syslog_record_s rec;
+    uint8_t buf[DEFERRED_MAXRECORD];
+  } record;
+
+  FAR struct syslog_ring_s *ring;
+  irqstate_t flags;
+  uint32_t contig;
+  uint32_t need;
+  uint32_t pos;
+  va_list copy;
+  int size;
+
+  /* The worker cannot run until the OS is up */
+
+  if (!OSINIT_OS_READY())
+    {
+      return -EAGAIN;
+    }
+
+  /* Capture the arguments from a copy of the list, so that the caller can
+   * still format the message itself if it cannot be deferred.
+   */
+
+  va_copy(copy, *ap);
+  size = deferred_capture(fmt, copy, record.buf + DEFERRED_HDRSIZE,
+                          DEFERRED_MAXRECORD - DEFERRED_HDRSIZE);
+  va_end(copy);
+
+  if (size < 0)
+    {
+      return size;
+    }
+
+  size            = DEFERRED_ALIGN(DEFERRED_HDRSIZE + size);
+  record.rec.size = size;
+  record.rec.fmt  = fmt;
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+  syslog_timestamp(&record.rec.time);
+#endif
+
+  /* Interrupts are disabled only locally: the ring belongs to this CPU */
+
+  flags  = up_irq_save();
+  ring   = &g_syslog_rings[up_cpu_index()];
+  pos    = ring->tail % DEFERRED_BUFSIZE;
+  contig = DEFERRED_BUFSIZE - pos;
+  need   = contig < size ? contig + size : size;
+
+  if (DEFERRED_BUFSIZE - (ring->tail - ring->head) < need)
+    {
+      ring->dropped++;
+      up_irq_restore(flags);
+      return 0;
+    }
+
+  if (contig < size)
+    {
+      /* Mark the end of the buffer as padding and wrap around */
+
+      if (contig >= sizeof(struct syslog_record_s))
+        {
+          ((FAR struct syslog_record_s *)&ring->buffer[pos])->size = 0;
+        }
+
+      ring->tail += contig;
+      pos = 0;
+    }
+
+  memcpy(&ring->buffer[pos], record.buf, size);
+  SP_DMB();
+  ring->tail += size;
+  up_irq_restore(flags);
+
+  if (work_available(&g_syslog_work))
+    {
+      work_queue(LPWORK, &g_syslog_work, deferred_worker, NULL,
+                 MSEC2TICK(CONFIG_SYSLOG_DEFERRED_DELAY));
+    }
+
+  return size;
+}
+
+/****************************************************************************
+ * Name: syslog_flush_deferred
+ *
+ * Description:
+ *   Format and output all recorded messages.
+ *
+ ****************************************************************************/
+
+void syslog_flush_deferred(bool force)
+{
+  FAR struct syslog_record_s *rec;
+  FAR struct syslog_ring_s *ring;
+  uint32_t dropped;
+  uint32_t pos;
+  int i;
+
+  for (i = 0; i < DEFERRED_NRINGS; i++)
+    {
+      ring = &g_syslog_rings[i];
+
+      while (ring->head != ring->tail)
+        {
+          SP_DMB();
+          pos = ring->head % DEFERRED_BUFSIZE;
+          rec = (FAR struct syslog_record_s *)&ring->buffer[pos];
+
+          if (DEFERRED_BUFSIZE - pos < sizeof(struct syslog_record_s) ||
+              rec->size == 0)
+            {
+              ring->head += DEFERRED_BUFSIZE - pos;
+              continue;
+            }
+
+          deferred_emit(rec, force);
+          ring->head += rec->size;
+        }
+
+      dropped = ring->dropped - ring->reported;
+      if (dropped > 0)
+        {
+          struct lib_syslogstream_s stream;
+
+          ring->reported += dropped;
+
+          if (force)
+            {
+              emergstream(&stream.public);
+            }
+          else
+            {
+              syslogstream_create(&stream);
+            }
+
+          lib_sprintf(&stream.public, "[%u syslog messages dropped]\n",
+                      (unsigned int)dropped);
+
+#ifdef CONFIG_SYSLOG_BUFFER
+          if (!force)
+            {
+              syslogstream_destroy(&stream);
+            }
+#endif
+        }
+    }
+}
+
+#endif /* CONFIG_SYSLOG_DEFERRED */
@@ -89,6 +89,12 @@ int syslog_flush(void)
   syslog_flush_intbuffer(g_syslog_channel, true);
 #endif
 
+#ifdef CONFIG_SYSLOG_DEFERRED
+  /* Format any messages still held in the deferred rings */
+
+  syslog_flush_deferred(true);
+#endif
+
   /* Then flush all of the buffered output to the SYSLOG device */
 
   DEBUGASSERT(g_syslog_channel->sc_flush != NULL);
@@ -49,31 +49,25 @@
 #include <nuttx/streams.h>
 #include <nuttx/syslog/syslog.h>
 
+#include "syslog.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: nx_vsyslog
+ * Name: syslog_timestamp
  *
  * Description:
- *   nx_vsyslog() handles the system logging system calls. It is functionally
- *   equivalent to vsyslog() except that (1) the per-process priority
- *   filtering has already been performed and the va_list parameter is
- *   passed by reference.  That is because the va_list is a structure in
- *   some compilers and passing of structures in the NuttX sycalls does
- *   not work.
+ *   Get the time stamp of a message.  See drivers/syslog/syslog.h.
  *
  ****************************************************************************/
 
-int nx_vsyslog(int priority, FAR const IPTR char *fmt, FAR va_list *ap)
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+void syslog_timestamp(FAR struct timespec *ts)
 {
-  struct lib_syslogstream_s stream;
   int ret;
 
-#ifdef CONFIG_SYSLOG_TIMESTAMP
-  struct timespec ts;
-
   /* Get the current time.  Since debug output may be generated very early
    * in the start-up sequence, hardware timer support may not yet be
    * available.
@@ -85,19 +79,19 @@ int nx_vsyslog(int priority, FAR const IPTR char *fmt, FAR va_list *ap)
 #if defined(CONFIG_SYSLOG_TIMESTAMP_REALTIME)
       /* Use CLOCK_REALTIME if so configured */
 
-      ret = clock_gettime(CLOCK_REALTIME, &ts);
+      ret = clock_gettime(CLOCK_REALTIME, ts);
 
 #elif defined(CONFIG_CLOCK_MONOTONIC)
       /* Prefer monotonic when enabled, as it can be synchronized to
        * RTC with clock_resynchronize.
        */
 
-      ret = clock_gettime(CLOCK_MONOTONIC, &ts);
+      ret = clock_gettime(CLOCK_MONOTONIC, ts);
 
 #else
       /* Otherwise, fall back to the system timer */
 
-      ret = clock_systimespec(&ts);
+      ret = clock_systimespec(ts);
 #endif
     }
 
@@ -105,9 +99,52 @@ int nx_vsyslog(int priority, FAR const IPTR char *fmt, FAR va_list *ap)
     {
       /* Timer hardware is not available, or clock function failed */
 
-      ts.tv_sec  = 0;
-      ts.tv_nsec = 0;
+      ts->tv_sec  = 0;
+      ts->tv_nsec = 0;
     }
+}
+#endif
+
+/****************************************************************************
+ * Name: nx_vsyslog
+ *
+ * Description:
+ *   nx_vsyslog() handles the system logging system calls. It is functionally
+ *   equivalent to vsyslog() except that (1) the per-process priority
+ *   filtering has already been performed and the va_list parameter is
+ *   passed by reference.  That is because the va_list is a structure in
+ *   some compilers and passing of structures in the NuttX sycalls does
+ *   not work.
+ *
+ ****************************************************************************/
+
+int nx_vsyslog(int priority, FAR const IPTR char *fmt, FAR va_list *ap)
+{
+  struct lib_syslogstream_s stream;
+  int ret;
+
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+  struct timespec ts;
+#endif
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+  /* Only record the raw arguments now and let the worker do the
+   * formatting, unless this is an emergency message or the format cannot
+   * be deferred.
+   */
+
+  if (priority != LOG_EMERG)
+    {
+      ret = syslog_deferred(fmt, ap);
+      if (ret >= 0)
+        {
+          return ret;
+        }
+    }
+#endif
+
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+  syslog_timestamp(&ts);
 #endif
 
   /* Wrap the low-level output in a stream object and let lib_vsprintf
@@ -41,6 +41,8 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
+#include <nuttx/hrtimer.h>
+#include <nuttx/irq.h>
 #include <nuttx/timers/arch_alarm.h>
 
 /****************************************************************************
@@ -72,6 +74,17 @@
 
 static FAR struct oneshot_lowerhalf_s *g_oneshot_lower;
 
+#ifdef CONFIG_HRTIMER
+/* The oneshot timer serves both the scheduler alarm and the high
+ * resolution timers.  Each keeps its own expiration time, in nanoseconds
+ * (UINT64_MAX if none), and the oneshot is programmed for the earlier.
+ */
+
+static uint64_t g_alarm_sched = UINT64_MAX;
+static uint64_t g_alarm_hrtimer = UINT64_MAX;
+static bool g_alarm_expiring;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -147,12 +160,84 @@ static void udelay_coarse(useconds_t microseconds)
     }
 }
 
+#ifdef CONFIG_HRTIMER
+static void oneshot_callback(FAR struct oneshot_lowerhalf_s *lower,
+                             FAR void *arg);
+
+/****************************************************************************
+ * Name: alarm_reprogram
+ *
+ * Description:
+ *   Program the oneshot for the earlier of the scheduler alarm and the
+ *   high resolution timer alarm.  Called in the critical section.
+ *
+ ****************************************************************************/
+
+static int alarm_reprogram(void)
+{
+  struct timespec now;
+  struct timespec ts;
+  uint64_t expired;
+  uint64_t nowns;
+
+  if (g_alarm_expiring)
+    {
+      /* oneshot_callback() will reprogram once it is done */
+
+      return OK;
+    }
+
+  expired = g_alarm_sched < g_alarm_hrtimer ? g_alarm_sched :
+                                              g_alarm_hrtimer;
+  if (expired == UINT64_MAX)
+    {
+      return ONESHOT_CANCEL(g_oneshot_lower, &ts);
+    }
+
+  ONESHOT_CURRENT(g_oneshot_lower, &now);
+  nowns = hrtimer_time2ns(&now);
+  hrtimer_ns2time(expired > nowns ? expired - nowns : 0, &ts);
+
+  return ONESHOT_START(g_oneshot_lower, oneshot_callback, NULL, &ts);
+}
+#endif
+
 static void oneshot_callback(FAR struct oneshot_lowerhalf_s *lower,
                              FAR void *arg)
 {
   struct timespec now;
 
-#ifdef CONFIG_SCHED_TICKLESS
+#if defined(CONFIG_HRTIMER)
+  irqstate_t flags;
+  uint64_t nowns;
+
+  /* Run whichever of the two alarms is due.  They may restart themselves;
+   * the oneshot is programmed for the next one at the end.
+   */
+
+  flags = enter_critical_section();
+  g_alarm_expiring = true;
+
+  ONESHOT_CURRENT(g_oneshot_lower, &now);
+  nowns = hrtimer_time2ns(&now);
+
+  if (g_alarm_sched <= nowns)
+    {
+      g_alarm_sched = UINT64_MAX;
+      nxsched_alarm_expiration(&now);
+    }
+
+  if (g_alarm_hrtimer <= nowns)
+    {
+      g_alarm_hrtimer = UINT64_MAX;
+      hrtimer_expiration(nowns);
+    }
+
+  g_alarm_expiring = false;
+  alarm_reprogram();
+  leave_critical_section(flags);
+
+#elif defined(CONFIG_SCHED_TICKLESS)
   ONESHOT_CURRENT(g_oneshot_lower, &now);
   nxsched_alarm_expiration(&now);
 #else
@@ -328,7 +413,18 @@ int up_alarm_cancel(FAR struct timespec *ts)
 
   if (g_oneshot_lower != NULL)
     {
+#ifdef CONFIG_HRTIMER
+      irqstate_t flags;
+
+      /* Keep the oneshot running for the high resolution timers */
+
+      flags         = enter_critical_section();
+      g_alarm_sched = UINT64_MAX;
+      ret           = alarm_reprogram();
+      leave_critical_section(flags);
+#else
       ret = ONESHOT_CANCEL(g_oneshot_lower, ts);
+#endif
       ONESHOT_CURRENT(g_oneshot_lower, ts);
     }
 
@@ -367,12 +463,47 @@ int up_alarm_start(FAR const struct timespec *ts)
 
   if (g_oneshot_lower != NULL)
     {
+#ifdef CONFIG_HRTIMER
+      irqstate_t flags;
+
+      flags         = enter_critical_section();
+      g_alarm_sched = hrtimer_time2ns(ts);
+      ret           = alarm_reprogram();
+      leave_critical_section(flags);
+#else
       struct timespec now;
       struct timespec delta;
 
       ONESHOT_CURRENT(g_oneshot_lower, &now);
       clock_timespec_subtract(ts, &now, &delta);
       ret = ONESHOT_START(g_oneshot_lower, oneshot_callback, NULL, &delta);
+#endif
+    }
+
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: up_hrtimer_start
+ *
+ * Description:
+ *   Program the high resolution timer alarm.  See include/nuttx/arch.h.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER
+int up_hrtimer_start(uint64_t expired)
+{
+  irqstate_t flags;
+  int ret = -EAGAIN;
+
+  if (g_oneshot_lower != NULL)
+    {
+      flags           = enter_critical_section();
+      g_alarm_hrtimer = expired;
+      ret             = alarm_reprogram();
+      leave_critical_section(flags);
     }
 
   return ret;
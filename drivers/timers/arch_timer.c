@@ -41,6 +41,7 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
+#include <nuttx/seqlock.h>
 #include <nuttx/timers/arch_timer.h>
 
 /****************************************************************************
@@ -78,6 +79,7 @@ struct arch_timer_s
   FAR struct timer_lowerhalf_s *lower;
   uint32_t *next_interval;
   uint32_t maxtimeout;
+  seqlock_t lock;     /* Guards timebase and the timer reload */
   uint64_t timebase;
 };
 
@@ -134,8 +136,10 @@ static uint32_t update_timeout(uint32_t timeout)
     {
       /* Otherwise, update the timeout directly. */
 
+      write_seqbegin(&g_timer.lock);
       TIMER_SETTIMEOUT(g_timer.lower, timeout);
       g_timer.timebase += status.timeout - status.timeleft;
+      write_seqend(&g_timer.lock);
     }
 
   return status.timeleft;
@@ -146,13 +150,20 @@ static uint64_t current_usec(void)
 {
   struct timer_status_s status;
   uint64_t timebase;
+  uint32_t seq;
+
+  /* The 64-bit time base cannot be read atomically on most targets, and
+   * it must match the timer status it is added to.  Sample both without
+   * a lock and try again if the timer was reloaded in between.
+   */
 
   do
     {
+      seq      = read_seqbegin(&g_timer.lock);
       timebase = g_timer.timebase;
       TIMER_GETSTATUS(g_timer.lower, &status);
     }
-  while (timebase != g_timer.timebase);
+  while (read_seqretry(&g_timer.lock, seq));
 
   return timebase + (status.timeout - status.timeleft);
 }
@@ -219,7 +230,10 @@ static bool timer_callback(FAR uint32_t *next_interval_us, FAR void *arg)
   struct timer_status_s status;
   uint32_t next_interval;
 
+  write_seqbegin(&g_timer.lock);
   g_timer.timebase     += *next_interval_us;
+  write_seqend(&g_timer.lock);
+
   next_interval         = g_timer.maxtimeout;
   g_timer.next_interval = &next_interval;
   nxsched_timer_expiration();
@@ -228,12 +242,16 @@ static bool timer_callback(FAR uint32_t *next_interval_us, FAR void *arg)
   TIMER_GETSTATUS(g_timer.lower, &status);
   if (timeout_diff(next_interval, status.timeleft))
     {
+      write_seqbegin(&g_timer.lock);
       g_timer.timebase += status.timeout - status.timeleft;
+      write_seqend(&g_timer.lock);
       *next_interval_us = next_interval;
     }
 
 #else
+  write_seqbegin(&g_timer.lock);
   g_timer.timebase += USEC_PER_TICK;
+  write_seqend(&g_timer.lock);
   nxsched_process_timer();
 #endif
 
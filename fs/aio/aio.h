@@ -49,6 +49,38 @@
 #  define CONFIG_FS_NAIOC 8
 #endif
 
+/* Number of containers that may be allocated from the heap once the
+ * pre-allocated containers are exhausted.
+ */
+
+#ifndef CONFIG_FS_AIO_NDYNAIOC
+#  define CONFIG_FS_AIO_NDYNAIOC 0
+#endif
+
+/* The AIO worker threads */
+
+#ifndef CONFIG_FS_AIO_NWORKERS
+#  define CONFIG_FS_AIO_NWORKERS 2
+#endif
+
+#ifndef CONFIG_FS_AIO_PRIORITY
+#  define CONFIG_FS_AIO_PRIORITY 100
+#endif
+
+#ifndef CONFIG_FS_AIO_STACKSIZE
+#  define CONFIG_FS_AIO_STACKSIZE 2048
+#endif
+
+/* Maximum number of adjacent requests merged into one transfer */
+
+#ifndef CONFIG_FS_AIO_MAXMERGE
+#  define CONFIG_FS_AIO_MAXMERGE 8
+#endif
+
+/* Values of aio_container_s::aioc_flags */
+
+#define AIOC_FLAG_DYNAMIC  (1 << 0)  /* Container was allocated from heap */
+
 #undef AIO_HAVE_PSOCK
 
 #ifdef CONFIG_NET_TCP
@@ -62,12 +94,15 @@
 /* This structure contains one AIO control block and appends information
  * needed by the logic running on the worker thread.  These structures are
  * pre-allocated, the number pre-allocated controlled by CONFIG_FS_NAIOC.
+ * Up to CONFIG_FS_AIO_NDYNAIOC more may be allocated from the heap.
  */
 
 struct file;
+struct aio_fileq_s;
 struct aio_container_s
 {
   dq_entry_t aioc_link;            /* Supports a doubly linked list */
+  dq_entry_t aioc_qlink;           /* Link in the per-file request queue */
   FAR struct aiocb *aioc_aiocbp;   /* The contained AIO control block */
   union
   {
@@ -77,11 +112,28 @@ struct aio_container_s
 #endif
     FAR void *ptr;                 /* Generic pointer to FAR data */
   } u;
-  struct work_s aioc_work;         /* Used to defer I/O to the work thread */
+  FAR struct aio_fileq_s *aioc_fq; /* File queue holding the request */
+  worker_t aioc_worker;            /* Performs the I/O on a worker thread */
   pid_t aioc_pid;                  /* ID of the waiting task */
 #ifdef CONFIG_PRIORITY_INHERITANCE
   uint8_t aioc_prio;               /* Priority of the waiting task */
 #endif
+  uint8_t aioc_op;                 /* LIO_READ, LIO_WRITE or LIO_NOP */
+  uint8_t aioc_flags;              /* See AIOC_FLAG_* definitions */
+};
+
+/* Running totals kept by the AIO worker threads */
+
+struct aio_stats_s
+{
+  uint32_t submitted;              /* Requests queued */
+  uint32_t completed;              /* Requests completed by a worker */
+  uint32_t canceled;               /* Requests removed by aio_cancel() */
+  uint32_t merged;                 /* Requests carried out within another */
+  uint32_t errors;                 /* Completed requests that failed */
+  uint32_t dynaioc;                /* Containers taken from the heap */
+  uint16_t maxdepth;               /* Most requests ever queued at once */
+  uint16_t depth;                  /* Requests queued now */
 };
 
 /****************************************************************************
@@ -103,6 +155,10 @@ extern "C"
 
 EXTERN dq_queue_t g_aio_pending;
 
+/* Statistics.  Modified only with the pending list locked. */
+
+EXTERN struct aio_stats_s g_aio_stats;
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -220,11 +276,12 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Add the asynchronous I/O to the queue of the file that it targets and
+ *   wake an AIO worker thread to service that queue.
  *
  * Input Parameters:
- *   arg - Worker argument.  In this case, a pointer to an instance of
- *     struct aiocb cast to void *.
+ *   aioc   - The AIO control block container
+ *   worker - The function that performs the I/O for a single request
  *
  * Returned Value:
  *   Zero (OK) on success.  Otherwise, -1 is returned and the errno is set
@@ -234,6 +291,24 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
 
 int aio_queue(FAR struct aio_container_s *aioc, worker_t worker);
 
+/****************************************************************************
+ * Name: aio_dequeue
+ *
+ * Description:
+ *   Remove a request that no worker thread has started yet from its file
+ *   queue.  The caller must hold the lock on the pending I/O list.
+ *
+ * Input Parameters:
+ *   aioc - The AIO control block container
+ *
+ * Returned Value:
+ *   Zero (OK) if the request was removed; -ENOENT if it has already been
+ *   taken by a worker thread.
+ *
+ ****************************************************************************/
+
+int aio_dequeue(FAR struct aio_container_s *aioc);
+
 /****************************************************************************
  * Name: aio_signal
  *
@@ -253,6 +328,24 @@ int aio_queue(FAR struct aio_container_s *aioc, worker_t worker);
 
 int aio_signal(pid_t pid, FAR struct aiocb *aiocbp);
 
+/****************************************************************************
+ * Name: aio_ring_register
+ *
+ * Description:
+ *   Register the I/O ring device (see include/sys/ioring.h).
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_AIO_RING
+int aio_ring_register(void);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -29,8 +29,6 @@
 #include <assert.h>
 #include <errno.h>
 
-#include <nuttx/wqueue.h>
-
 #include "aio/aio.h"
 
 #ifdef CONFIG_FS_AIO
@@ -119,12 +117,12 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
               /* Yes... attempt to cancel the I/O.  There are two
                * possibilities:* (1) the work has already been started and
                * is no longer queued, or (2) the work has not been started
-               * and is still in the work queue.  Only the second case can
-               * be canceled.  work_cancel() will return -ENOENT in the
+               * and is still in the file queue.  Only the second case can
+               * be canceled.  aio_dequeue() will return -ENOENT in the
                * first case.
                */
 
-              status = work_cancel(LPWORK, &aioc->aioc_work);
+              status = aio_dequeue(aioc);
               if (status >= 0)
                 {
                   /* Remove the container from the list of pending transfers */
@@ -174,18 +172,17 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
               /* Yes... attempt to cancel the I/O.  There are two
                * possibilities:* (1) the work has already been started and
                * is no longer queued, or (2) the work has not been started
-               * and is still in the work queue.  Only the second case can
-               * be canceled.  work_cancel() will return -ENOENT in the
+               * and is still in the file queue.  Only the second case can
+               * be canceled.  aio_dequeue() will return -ENOENT in the
                * first case.
                */
 
-              status = work_cancel(LPWORK, &aioc->aioc_work);
+              next   = (FAR struct aio_container_s *)aioc->aioc_link.flink;
+              status = aio_dequeue(aioc);
               if (status >= 0)
                 {
                   /* Remove the container from the list of pending transfers */
 
-                  next   =
-                    (FAR struct aio_container_s *)aioc->aioc_link.flink;
                   pid    = aioc->aioc_pid;
                   aiocbp = aioc_decant(aioc);
                   DEBUGASSERT(aiocbp);
@@ -76,10 +76,8 @@ static void aio_fsync_worker(FAR void *arg)
 {
   FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
   FAR struct aiocb *aiocbp;
+  FAR void *handle;
   pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  uint8_t prio;
-#endif
   int ret;
 
   /* Get the information from the container, decant the AIO control block,
@@ -89,14 +87,12 @@ static void aio_fsync_worker(FAR void *arg)
 
   DEBUGASSERT(aioc && aioc->aioc_aiocbp);
   pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  prio   = aioc->aioc_prio;
-#endif
+  handle = aioc->u.ptr;
   aiocbp = aioc_decant(aioc);
 
-  /* Perform the fsync using u.aioc_filep */
+  /* Perform the fsync using the file structure */
 
-  ret = file_fsync(aioc->u.aioc_filep);
+  ret = file_fsync((FAR struct file *)handle);
   if (ret < 0)
     {
       ferr("ERROR: file_fsync failed: %d\n", ret);
@@ -110,12 +106,6 @@ static void aio_fsync_worker(FAR void *arg)
   /* Signal the client */
 
   aio_signal(pid, aiocbp);
-
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Restore the low priority worker thread default priority */
-
-  lpwork_restorepriority(prio);
-#endif
 }
 
 /****************************************************************************
@@ -214,6 +204,7 @@ int aio_fsync(int op, FAR struct aiocb *aiocbp)
   sigwork_init(&aiocbp->aio_sigwork);
   aiocbp->aio_result = -EINPROGRESS;
   aiocbp->aio_priv   = NULL;
+  aiocbp->aio_notify = NULL;
 
   /* Create a container for the AIO control block.  This may cause us to
    * block if there are insufficient resources to satisfy the request.
@@ -29,6 +29,7 @@
 #include <queue.h>
 
 #include <nuttx/sched.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/semaphore.h>
 
 #include "aio/aio.h"
@@ -51,6 +52,12 @@ static dq_queue_t g_aioc_free;
 
 static sem_t g_aioc_freesem;
 
+#if CONFIG_FS_AIO_NDYNAIOC > 0
+/* The number of containers now allocated from the heap */
+
+static uint16_t g_aioc_ndynamic;
+#endif
+
 /* This binary semaphore supports exclusive access to the list of pending
  * asynchronous I/O.  g_aio_holder and a_aio_count support the reentrant
  * lock.
@@ -70,6 +77,54 @@ static uint16_t g_aio_count;
 
 dq_queue_t g_aio_pending;
 
+/* Statistics.  Modified only with the pending list locked. */
+
+struct aio_stats_s g_aio_stats;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aioc_dynalloc
+ *
+ * Description:
+ *   Allocate a container from the heap when all of the pre-allocated
+ *   containers are in use, up to CONFIG_FS_AIO_NDYNAIOC of them.
+ *
+ * Returned Value:
+ *   The new container, or NULL if the limit has been reached or the heap
+ *   is exhausted.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_AIO_NDYNAIOC > 0
+static FAR struct aio_container_s *aioc_dynalloc(void)
+{
+  FAR struct aio_container_s *aioc = NULL;
+
+  if (aio_lock() < 0)
+    {
+      return NULL;
+    }
+
+  if (g_aioc_ndynamic < CONFIG_FS_AIO_NDYNAIOC)
+    {
+      aioc = (FAR struct aio_container_s *)
+        kmm_zalloc(sizeof(struct aio_container_s));
+      if (aioc != NULL)
+        {
+          aioc->aioc_flags = AIOC_FLAG_DYNAMIC;
+          g_aioc_ndynamic++;
+          g_aio_stats.dynaioc++;
+        }
+    }
+
+  aio_unlock();
+  return aioc;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -185,9 +240,9 @@ void aio_unlock(void)
  *
  * Description:
  *   Allocate a new AIO container by taking the next, pre-allocated
- *   container from the free list.  This function will wait until
- *   aioc_free() is called in the event that there is no free container
- *   available in the free list.
+ *   container from the free list.  If there is none, a container is taken
+ *   from the heap if CONFIG_FS_AIO_NDYNAIOC allows it.  Otherwise this
+ *   function will wait until aioc_free() is called.
  *
  * Input Parameters:
  *   None
@@ -208,7 +263,24 @@ FAR struct aio_container_s *aioc_alloc(void)
    * container set aside for us.
    */
 
+#if CONFIG_FS_AIO_NDYNAIOC > 0
+  /* If none is free, try the heap before waiting for one */
+
+  ret = nxsem_trywait(&g_aioc_freesem);
+  if (ret < 0)
+    {
+      aioc = aioc_dynalloc();
+      if (aioc != NULL)
+        {
+          return aioc;
+        }
+
+      ret = nxsem_wait_uninterruptible(&g_aioc_freesem);
+    }
+#else
   ret = nxsem_wait_uninterruptible(&g_aioc_freesem);
+#endif
+
   if (ret < 0)
     {
       return NULL;
@@ -249,6 +321,20 @@ void aioc_free(FAR struct aio_container_s *aioc)
 
   DEBUGASSERT(aioc);
 
+#if CONFIG_FS_AIO_NDYNAIOC > 0
+  /* Containers from the heap go back to the heap */
+
+  if ((aioc->aioc_flags & AIOC_FLAG_DYNAMIC) != 0)
+    {
+      while (aio_lock() < 0);
+      g_aioc_ndynamic--;
+      aio_unlock();
+
+      kmm_free(aioc);
+      return;
+    }
+#endif
+
   /* Return the container to the free list */
 
   do
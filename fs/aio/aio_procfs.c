@@ -0,0 +1,307 @@
+/****************************************************************************
+ * fs/aio/aio_procfs.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#include "aio/aio.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_AIO)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Large enough to hold the complete formatted statistics report */
+
+#define AIO_PROCFS_BUFLEN 256
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct aio_procfs_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  unsigned int textsize;          /* Number of valid characters in text[] */
+  char text[AIO_PROCFS_BUFLEN];   /* Statistics formatted at open() time */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     aio_procfs_open(FAR struct file *filep,
+                 FAR const char *relpath, int oflags, mode_t mode);
+static int     aio_procfs_close(FAR struct file *filep);
+static ssize_t aio_procfs_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     aio_procfs_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     aio_procfs_stat(FAR const char *relpath,
+                 FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_procfs.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations aio_procfsoperations =
+{
+  aio_procfs_open,   /* open */
+  aio_procfs_close,  /* close */
+  aio_procfs_read,   /* read */
+  NULL,              /* write */
+  aio_procfs_dup,    /* dup */
+  NULL,              /* opendir */
+  NULL,              /* closedir */
+  NULL,              /* readdir */
+  NULL,              /* rewinddir */
+  aio_procfs_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_procfs_open
+ ****************************************************************************/
+
+static int aio_procfs_open(FAR struct file *filep, FAR const char *relpath,
+                           int oflags, mode_t mode)
+{
+  FAR struct aio_procfs_file_s *procfile;
+  struct aio_stats_s stats;
+  int ret;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "fs/aio" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "fs/aio") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = (FAR struct aio_procfs_file_s *)
+    kmm_zalloc(sizeof(struct aio_procfs_file_s));
+  if (!procfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Take a consistent snapshot of the statistics.  The report is formatted
+   * once here so that successive reads see the same numbers.
+   */
+
+  ret = aio_lock();
+  if (ret < 0)
+    {
+      kmm_free(procfile);
+      return ret;
+    }
+
+  stats = g_aio_stats;
+  aio_unlock();
+
+  procfile->textsize =
+    snprintf(procfile->text, AIO_PROCFS_BUFLEN,
+             "submitted: %lu\n"
+             "completed: %lu\n"
+             "canceled:  %lu\n"
+             "merged:    %lu\n"
+             "errors:    %lu\n"
+             "dynaioc:   %lu\n"
+             "depth:     %u\n"
+             "maxdepth:  %u\n"
+             "workers:   %d\n",
+             (unsigned long)stats.submitted,
+             (unsigned long)stats.completed,
+             (unsigned long)stats.canceled,
+             (unsigned long)stats.merged,
+             (unsigned long)stats.errors,
+             (unsigned long)stats.dynaioc,
+             (unsigned int)stats.depth,
+             (unsigned int)stats.maxdepth,
+             CONFIG_FS_AIO_NWORKERS);
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_procfs_close
+ ****************************************************************************/
+
+static int aio_procfs_close(FAR struct file *filep)
+{
+  FAR struct aio_procfs_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct aio_procfs_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_procfs_read
+ ****************************************************************************/
+
+static ssize_t aio_procfs_read(FAR struct file *filep, FAR char *buffer,
+                               size_t buflen)
+{
+  FAR struct aio_procfs_file_s *procfile;
+  size_t copysize;
+  off_t offset;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+  offset = filep->f_pos;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct aio_procfs_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  copysize = procfs_memcpy(procfile->text, procfile->textsize, buffer,
+                           buflen, &offset);
+
+  /* Update the file offset */
+
+  filep->f_pos += copysize;
+  return copysize;
+}
+
+/****************************************************************************
+ * Name: aio_procfs_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int aio_procfs_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct aio_procfs_file_s *oldattr;
+  FAR struct aio_procfs_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct aio_procfs_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct aio_procfs_file_s *)
+    kmm_malloc(sizeof(struct aio_procfs_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct aio_procfs_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_procfs_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int aio_procfs_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "fs/aio" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "fs/aio") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "fs/aio" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_AIO */
@@ -39,30 +39,440 @@
 
 #include <nuttx/config.h>
 
+#include <sys/types.h>
+#include <sys/uio.h>
 #include <sched.h>
+#include <fcntl.h>
 #include <aio.h>
+#include <assert.h>
 #include <errno.h>
 #include <debug.h>
 
-#include <nuttx/wqueue.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
 
 #include "aio/aio.h"
 
 #ifdef CONFIG_FS_AIO
 
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Requests are queued per file so that the requests for one file are
+ * carried out in order, by one worker at a time, and so that adjacent
+ * requests can be found and merged.  A file queue exists only while it
+ * holds requests or a worker is servicing it.
+ */
+
+struct aio_fileq_s
+{
+  dq_entry_t fq_link;              /* Link in g_aio_fileqs */
+  dq_entry_t fq_rlink;             /* Link in g_aio_ready */
+  FAR void *fq_handle;             /* The struct file or struct socket */
+  dq_queue_t fq_pending;           /* Requests not yet started */
+  bool fq_ready;                   /* Queue is in g_aio_ready */
+  bool fq_busy;                    /* A worker is servicing the queue */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* All file queues, and those that wait for a worker */
+
+static dq_queue_t g_aio_fileqs;
+static dq_queue_t g_aio_ready;
+
+/* Counts the file queues in g_aio_ready.  The workers wait on it. */
+
+static sem_t g_aio_worksem = SEM_INITIALIZER(0);
+
+/* True once the worker threads have been started */
+
+static bool g_aio_started;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: aio_fileq_ready
+ *
+ * Description:
+ *   Hand a file queue that has pending requests to the workers.  The
+ *   pending list must be locked.
+ *
+ ****************************************************************************/
+
+static void aio_fileq_ready(FAR struct aio_fileq_s *fq)
+{
+  if (!fq->fq_ready && !fq->fq_busy)
+    {
+      fq->fq_ready = true;
+      dq_addlast(&fq->fq_rlink, &g_aio_ready);
+      nxsem_post(&g_aio_worksem);
+    }
+}
+
+/****************************************************************************
+ * Name: aio_fileq_release
+ *
+ * Description:
+ *   Free a file queue that is idle and empty.  The pending list must be
+ *   locked.
+ *
+ ****************************************************************************/
+
+static void aio_fileq_release(FAR struct aio_fileq_s *fq)
+{
+  if (!fq->fq_busy && dq_empty(&fq->fq_pending))
+    {
+      if (fq->fq_ready)
+        {
+          dq_rem(&fq->fq_rlink, &g_aio_ready);
+        }
+
+      dq_rem(&fq->fq_link, &g_aio_fileqs);
+      kmm_free(fq);
+    }
+}
+
+/****************************************************************************
+ * Name: aio_fileq_merge
+ *
+ * Description:
+ *   Take the first request from a file queue together with the requests
+ *   that continue it in the file.  Only requests of the same kind are
+ *   considered and the search stops at the first request of another kind,
+ *   so reads and writes are never reordered against each other.  The
+ *   pending list must be locked.
+ *
+ * Returned Value:
+ *   The number of requests placed in batch[], in file order.
+ *
+ ****************************************************************************/
+
+static int aio_fileq_merge(FAR struct aio_fileq_s *fq,
+                           FAR struct aio_container_s **batch)
+{
+  FAR struct aio_container_s *aioc;
+  FAR struct aiocb *aiocbp;
+  FAR dq_entry_t *entry;
+  off_t next;
+  int nbatch;
+
+  entry = dq_remfirst(&fq->fq_pending);
+  batch[0] = container_of(entry, struct aio_container_s, aioc_qlink);
+  batch[0]->aioc_fq = NULL;
+  nbatch = 1;
+
+  /* Only positional reads and writes on a file can be merged */
+
+  if (batch[0]->aioc_op != LIO_READ && batch[0]->aioc_op != LIO_WRITE)
+    {
+      return nbatch;
+    }
+
+#ifdef AIO_HAVE_PSOCK
+  if (batch[0]->aioc_aiocbp->aio_fildes >= CONFIG_NFILE_DESCRIPTORS)
+    {
+      return nbatch;
+    }
+#endif
+
+  if (batch[0]->aioc_op == LIO_WRITE &&
+      (batch[0]->u.aioc_filep->f_oflags & O_APPEND) != 0)
+    {
+      return nbatch;
+    }
+
+  aiocbp = batch[0]->aioc_aiocbp;
+  next   = aiocbp->aio_offset + aiocbp->aio_nbytes;
+
+  while (nbatch < CONFIG_FS_AIO_MAXMERGE)
+    {
+      /* Look for the request that starts where the batch ends */
+
+      for (entry = dq_peek(&fq->fq_pending); entry; entry = dq_next(entry))
+        {
+          aioc = container_of(entry, struct aio_container_s, aioc_qlink);
+          if (aioc->aioc_op != batch[0]->aioc_op)
+            {
+              entry = NULL;
+              break;
+            }
+
+          if (aioc->aioc_aiocbp->aio_offset == next)
+            {
+              break;
+            }
+        }
+
+      if (entry == NULL)
+        {
+          break;
+        }
+
+      dq_rem(entry, &fq->fq_pending);
+      aioc->aioc_fq = NULL;
+      batch[nbatch++] = aioc;
+      next += aioc->aioc_aiocbp->aio_nbytes;
+    }
+
+  return nbatch;
+}
+
+/****************************************************************************
+ * Name: aio_merged_rw
+ *
+ * Description:
+ *   Carry out a batch of adjacent reads or writes as one vectored transfer
+ *   and complete each request with its share of the result.
+ *
+ * Returned Value:
+ *   The number of requests that completed with an error.
+ *
+ ****************************************************************************/
+
+static int aio_merged_rw(FAR struct aio_container_s **batch, int nbatch)
+{
+  struct iovec iov[CONFIG_FS_AIO_MAXMERGE];
+  FAR struct aiocb *aiocbp[CONFIG_FS_AIO_MAXMERGE];
+  pid_t pid[CONFIG_FS_AIO_MAXMERGE];
+  FAR struct file *filep;
+  uint8_t op;
+  off_t offset;
+  ssize_t remaining;
+  ssize_t nxfrd;
+  int nerrors = 0;
+  int i;
+
+  filep  = batch[0]->u.aioc_filep;
+  op     = batch[0]->aioc_op;
+  offset = batch[0]->aioc_aiocbp->aio_offset;
+
+  /* Free the containers before starting the I/O, as the single request
+   * workers do.
+   */
+
+  for (i = 0; i < nbatch; i++)
+    {
+      pid[i]          = batch[i]->aioc_pid;
+      aiocbp[i]       = aioc_decant(batch[i]);
+      iov[i].iov_base = (FAR void *)aiocbp[i]->aio_buf;
+      iov[i].iov_len  = aiocbp[i]->aio_nbytes;
+    }
+
+  if (op == LIO_READ)
+    {
+      nxfrd = file_preadv(filep, iov, nbatch, offset);
+    }
+  else
+    {
+      nxfrd = file_pwritev(filep, iov, nbatch, offset);
+    }
+
+  if (nxfrd < 0)
+    {
+      ferr("ERROR: merged transfer failed: %d\n", (int)nxfrd);
+    }
+
+  /* A short transfer completes the leading requests in full and the
+   * trailing requests short or empty, exactly as separate transfers at
+   * the end of the file would have.
+   */
+
+  remaining = nxfrd;
+  for (i = 0; i < nbatch; i++)
+    {
+      if (nxfrd < 0)
+        {
+          aiocbp[i]->aio_result = nxfrd;
+          nerrors++;
+        }
+      else if ((size_t)remaining > aiocbp[i]->aio_nbytes)
+        {
+          aiocbp[i]->aio_result = aiocbp[i]->aio_nbytes;
+          remaining -= aiocbp[i]->aio_nbytes;
+        }
+      else
+        {
+          aiocbp[i]->aio_result = remaining;
+          remaining = 0;
+        }
+
+      aio_signal(pid[i], aiocbp[i]);
+    }
+
+  return nerrors;
+}
+
+/****************************************************************************
+ * Name: aio_worker
+ *
+ * Description:
+ *   The body of each AIO worker thread.  A worker takes the next file queue
+ *   that has requests, carries out the first request (merged with the
+ *   requests that continue it) and hands the queue back.
+ *
+ ****************************************************************************/
+
+static int aio_worker(int argc, FAR char *argv[])
+{
+  FAR struct aio_container_s *batch[CONFIG_FS_AIO_MAXMERGE];
+  FAR struct aio_fileq_s *fq;
+  FAR struct aiocb *aiocbp;
+  FAR dq_entry_t *entry;
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  struct sched_param param;
+  uint8_t prio;
+  int i;
+#endif
+  int nerrors;
+  int nbatch;
+
+  for (; ; )
+    {
+      nxsem_wait_uninterruptible(&g_aio_worksem);
+
+      if (aio_lock() < 0)
+        {
+          continue;
+        }
+
+      /* The queue may have been emptied by aio_cancel() */
+
+      entry = dq_remfirst(&g_aio_ready);
+      if (entry == NULL)
+        {
+          aio_unlock();
+          continue;
+        }
+
+      fq = container_of(entry, struct aio_fileq_s, fq_rlink);
+      fq->fq_ready = false;
+      fq->fq_busy  = true;
+
+      nbatch = aio_fileq_merge(fq, batch);
+      g_aio_stats.depth -= nbatch;
+      aio_unlock();
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+      /* Run at the priority of the most important waiting task if that is
+       * above the priority of the worker.
+       */
+
+      prio = CONFIG_FS_AIO_PRIORITY;
+      for (i = 0; i < nbatch; i++)
+        {
+          if (batch[i]->aioc_prio > prio)
+            {
+              prio = batch[i]->aioc_prio;
+            }
+        }
+
+      if (prio != CONFIG_FS_AIO_PRIORITY)
+        {
+          param.sched_priority = prio;
+          nxsched_setparam(0, &param);
+        }
+#endif
+
+      if (nbatch > 1)
+        {
+          nerrors = aio_merged_rw(batch, nbatch);
+        }
+      else
+        {
+          /* The worker frees the container but the control block stays */
+
+          aiocbp = batch[0]->aioc_aiocbp;
+          batch[0]->aioc_worker(batch[0]);
+          nerrors = aiocbp->aio_result < 0 ? 1 : 0;
+        }
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+      if (prio != CONFIG_FS_AIO_PRIORITY)
+        {
+          param.sched_priority = CONFIG_FS_AIO_PRIORITY;
+          nxsched_setparam(0, &param);
+        }
+#endif
+
+      /* Give the file queue back */
+
+      while (aio_lock() < 0);
+      g_aio_stats.completed += nbatch;
+      g_aio_stats.merged    += nbatch - 1;
+      g_aio_stats.errors    += nerrors;
+
+      fq->fq_busy = false;
+      if (dq_empty(&fq->fq_pending))
+        {
+          aio_fileq_release(fq);
+        }
+      else
+        {
+          aio_fileq_ready(fq);
+        }
+
+      aio_unlock();
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_start
+ *
+ * Description:
+ *   Start the worker threads.  This is done on the first request rather
+ *   than from aio_initialize(), which runs before threads can be created.
+ *   The pending list must be locked.
+ *
+ ****************************************************************************/
+
+static int aio_start(void)
+{
+  int ret;
+  int i;
+
+  for (i = 0; i < CONFIG_FS_AIO_NWORKERS; i++)
+    {
+      ret = kthread_create("aio", CONFIG_FS_AIO_PRIORITY,
+                           CONFIG_FS_AIO_STACKSIZE,
+                           aio_worker, NULL);
+      if (ret < 0)
+        {
+          ferr("ERROR: Failed to start AIO worker %d: %d\n", i, ret);
+
+          /* Carry on with the workers that did start */
+
+          return i > 0 ? OK : ret;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
 /****************************************************************************
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Add the asynchronous I/O to the queue of the file that it targets and
+ *   wake an AIO worker thread to service that queue.
  *
  * Input Parameters:
- *   arg - Worker argument.  In this case, a pointer to an instance of
- *     struct aiocb cast to void *.
+ *   aioc   - The AIO control block container
+ *   worker - The function that performs the I/O for a single request
  *
  * Returned Value:
  *   Zero (OK) on success.  Otherwise, -1 is returned and the errno is set
@@ -72,42 +482,107 @@
 
 int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
 {
+  FAR struct aio_fileq_s *fq;
+  FAR dq_entry_t *entry;
   int ret;
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Prohibit context switches until we complete the queuing */
+  ret = aio_lock();
+  if (ret < 0)
+    {
+      goto errout;
+    }
 
-  sched_lock();
+  if (!g_aio_started)
+    {
+      ret = aio_start();
+      if (ret < 0)
+        {
+          goto errout_with_lock;
+        }
 
-  /* Make sure that the low-priority worker thread is running at at least
-   * the priority specified for this action.
-   */
+      g_aio_started = true;
+    }
 
-  lpwork_boostpriority(aioc->aioc_prio);
-#endif
+  /* Find the queue of the file, creating it if there is none */
 
-  /* Schedule the work on the low priority worker thread */
+  for (entry = dq_peek(&g_aio_fileqs); entry; entry = dq_next(entry))
+    {
+      fq = container_of(entry, struct aio_fileq_s, fq_link);
+      if (fq->fq_handle == aioc->u.ptr)
+        {
+          break;
+        }
+    }
 
-  ret = work_queue(LPWORK, &aioc->aioc_work, worker, aioc, 0);
-  if (ret < 0)
+  if (entry == NULL)
     {
-      FAR struct aiocb *aiocbp = aioc->aioc_aiocbp;
-      DEBUGASSERT(aiocbp);
+      fq = (FAR struct aio_fileq_s *)kmm_zalloc(sizeof(struct aio_fileq_s));
+      if (fq == NULL)
+        {
+          ret = -ENOMEM;
+          goto errout_with_lock;
+        }
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
-      lpwork_restorepriority(aioc->aioc_prio);
-#endif
-      aiocbp->aio_result = ret;
-      set_errno(-ret);
-      ret = ERROR;
+      fq->fq_handle = aioc->u.ptr;
+      dq_addlast(&fq->fq_link, &g_aio_fileqs);
     }
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Now the low-priority work queue might run at its new priority */
+  aioc->aioc_worker = worker;
+  aioc->aioc_fq  = fq;
+  dq_addlast(&aioc->aioc_qlink, &fq->fq_pending);
 
-  sched_unlock();
-#endif
-  return ret;
+  g_aio_stats.submitted++;
+  if (++g_aio_stats.depth > g_aio_stats.maxdepth)
+    {
+      g_aio_stats.maxdepth = g_aio_stats.depth;
+    }
+
+  aio_fileq_ready(fq);
+  aio_unlock();
+  return OK;
+
+errout_with_lock:
+  aio_unlock();
+
+errout:
+  aioc->aioc_aiocbp->aio_result = ret;
+  set_errno(-ret);
+  return ERROR;
+}
+
+/****************************************************************************
+ * Name: aio_dequeue
+ *
+ * Description:
+ *   Remove a request that no worker thread has started yet from its file
+ *   queue.  The caller must hold the lock on the pending I/O list.
+ *
+ * Input Parameters:
+ *   aioc - The AIO control block container
+ *
+ * Returned Value:
+ *   Zero (OK) if the request was removed; -ENOENT if it has already been
+ *   taken by a worker thread.
+ *
+ ****************************************************************************/
+
+int aio_dequeue(FAR struct aio_container_s *aioc)
+{
+  FAR struct aio_fileq_s *fq = aioc->aioc_fq;
+
+  if (fq == NULL)
+    {
+      return -ENOENT;
+    }
+
+  dq_rem(&aioc->aioc_qlink, &fq->fq_pending);
+  aioc->aioc_fq = NULL;
+
+  g_aio_stats.depth--;
+  g_aio_stats.canceled++;
+
+  aio_fileq_release(fq);
+  return OK;
 }
 
 #endif /* CONFIG_FS_AIO */
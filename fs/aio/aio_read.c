@@ -76,10 +76,8 @@ static void aio_read_worker(FAR void *arg)
 {
   FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
   FAR struct aiocb *aiocbp;
+  FAR void *handle;
   pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  uint8_t prio;
-#endif
   ssize_t nread = 0;
 
   /* Get the information from the container, decant the AIO control block,
@@ -89,9 +87,7 @@ static void aio_read_worker(FAR void *arg)
 
   DEBUGASSERT(aioc && aioc->aioc_aiocbp);
   pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  prio   = aioc->aioc_prio;
-#endif
+  handle = aioc->u.ptr;
   aiocbp = aioc_decant(aioc);
 
 #ifdef AIO_HAVE_PSOCK
@@ -100,26 +96,28 @@ static void aio_read_worker(FAR void *arg)
     {
       /* Perform the file read using:
        *
-       *   u.aioc_filep - File structure pointer
+       *   handle       - File structure pointer
        *   aio_buf      - Location of buffer
        *   aio_nbytes   - Length of transfer
        *   aio_offset   - File offset
        */
 
-     nread = file_pread(aioc->u.aioc_filep, (FAR void *)aiocbp->aio_buf,
-                        aiocbp->aio_nbytes, aiocbp->aio_offset);
+      nread = file_pread((FAR struct file *)handle,
+                         (FAR void *)aiocbp->aio_buf,
+                         aiocbp->aio_nbytes, aiocbp->aio_offset);
     }
 #ifdef AIO_HAVE_PSOCK
   else
     {
       /* Perform the socket receive using:
        *
-       *   u.aioc_psock - Socket structure pointer
+       *   handle       - Socket structure pointer
        *   aio_buf      - Location of buffer
        *   aio_nbytes   - Length of transfer
        */
 
-      nread = psock_recv(aioc->u.aioc_psock, (FAR void *)aiocbp->aio_buf,
+      nread = psock_recv((FAR struct socket *)handle,
+                         (FAR void *)aiocbp->aio_buf,
                          aiocbp->aio_nbytes, 0);
     }
 #endif
@@ -138,12 +136,6 @@ static void aio_read_worker(FAR void *arg)
   /* Signal the client */
 
   aio_signal(pid, aiocbp);
-
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Restore the low priority worker thread default priority */
-
-  lpwork_restorepriority(prio);
-#endif
 }
 
 /****************************************************************************
@@ -258,6 +250,7 @@ int aio_read(FAR struct aiocb *aiocbp)
   sigwork_init(&aiocbp->aio_sigwork);
   aiocbp->aio_result = -EINPROGRESS;
   aiocbp->aio_priv   = NULL;
+  aiocbp->aio_notify = NULL;
 
   /* Create a container for the AIO control block.  This may cause us to
    * block if there are insufficient resources to satisfy the request.
@@ -274,6 +267,7 @@ int aio_read(FAR struct aiocb *aiocbp)
 
   /* Defer the work to the worker thread */
 
+  aioc->aioc_op = LIO_READ;
   ret = aio_queue(aioc, aio_read_worker);
   if (ret < 0)
     {
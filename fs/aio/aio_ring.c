@@ -0,0 +1,1548 @@
+/****************************************************************************
+ * fs/aio/aio_ring.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/ioring.h>
+#include <sys/socket.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sched.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <aio.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "aio/aio.h"
+
+#ifdef CONFIG_FS_AIO_RING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_FS_AIO_RING_MAXENTRIES
+#  define CONFIG_FS_AIO_RING_MAXENTRIES 256
+#endif
+
+#ifndef CONFIG_FS_AIO_RING_NPOLLWAITERS
+#  define CONFIG_FS_AIO_RING_NPOLLWAITERS 2
+#endif
+
+#define AIO_RING_NFDS (CONFIG_NFILE_DESCRIPTORS + CONFIG_NSOCKET_DESCRIPTORS)
+
+/* SP_DMB() orders the queue entries against the indices that publish them.
+ * Without SMP, only the compiler must be kept from reordering them.
+ */
+
+#ifndef SP_DMB
+#  ifdef __GNUC__
+#    define SP_DMB() __asm__ __volatile__ ("" : : : "memory")
+#  else
+#    define SP_DMB()
+#  endif
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct aio_ring_s;
+
+/* One submitted operation.  The AIO control block must come first: the
+ * completion callback recovers the request from it.
+ */
+
+struct aio_ring_req_s
+{
+  struct aiocb aiocb;                  /* The request seen by the workers */
+  FAR struct aio_ring_s *ring;         /* The ring that owns the request */
+  FAR struct aio_ring_req_s *flink;    /* Free, deferred or wait list link */
+  struct pollfd fds;                   /* Readiness wait on the poller */
+  FAR void *handle;                    /* File or socket waited on */
+  struct file file;                    /* Non-blocking open of a driver */
+  clock_t deadline;                    /* End of a timed IORING_OP_POLL */
+  uintptr_t user_data;                 /* Copied to the completion */
+  FAR void *addr2;                     /* Address length for accept */
+  uint32_t op_flags;                   /* MSG_* flags or poll events */
+  uint8_t opcode;                      /* IORING_OP_* */
+  bool sock;                           /* The handle is a socket */
+  bool timed;                          /* The deadline applies */
+  bool aborted;                        /* The ring is being closed */
+};
+
+/* The state of one open ring.  The queue geometry is kept here as well as
+ * in the shared ring state so that nothing user space writes can send the
+ * kernel outside of the ring.
+ */
+
+struct aio_ring_s
+{
+  sem_t exclsem;                       /* Serializes setup, enter and close */
+  sem_t cqsem;                         /* Wakes waiters for completions */
+  FAR struct ioring_rings *rings;      /* State shared with user space */
+  FAR struct ioring_sqe *sqes;         /* Submission queue entries */
+  FAR struct ioring_cqe *cqes;         /* Completion queue entries */
+  FAR struct aio_ring_req_s *reqs;     /* One request per completion entry */
+  FAR struct aio_ring_req_s *freelist; /* Requests not in use */
+  FAR struct aio_ring_req_s *deferred; /* Accepts ready to be finished */
+  uint32_t sq_head;                    /* Next submission entry to consume */
+  uint32_t sq_entries;                 /* Size of the submission queue */
+  uint32_t cq_entries;                 /* Size of the completion queue */
+  uint32_t inflight;                   /* Requests not yet completed */
+
+  /* The poll structures of threads waiting for ring events */
+
+  FAR struct pollfd *fds[CONFIG_FS_AIO_RING_NPOLLWAITERS];
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* Character driver methods */
+
+static int     aio_ring_open(FAR struct file *filep);
+static int     aio_ring_close(FAR struct file *filep);
+static int     aio_ring_ioctl(FAR struct file *filep, int cmd,
+                 unsigned long arg);
+static int     aio_ring_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                 bool setup);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Requests waiting for their file or socket to become ready, from all
+ * rings.  A single kernel thread, the poller, waits for all of them, so
+ * that an idle socket does not park one of the few AIO workers.  The
+ * semaphore of every pollfd structure is g_aio_ring_pollsem, which wakes
+ * the poller.  The list is protected by the critical section.
+ */
+
+static FAR struct aio_ring_req_s *g_aio_ring_waits;
+static sem_t g_aio_ring_pollsem;
+static pid_t g_aio_ring_pid;
+
+static const struct file_operations g_aio_ring_fops =
+{
+  aio_ring_open,   /* open */
+  aio_ring_close,  /* close */
+  NULL,            /* read */
+  NULL,            /* write */
+  NULL,            /* seek */
+  aio_ring_ioctl,  /* ioctl */
+  aio_ring_poll    /* poll */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , NULL           /* unlink */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_ring_pollnotify
+ *
+ * Description:
+ *   Report events to the threads polling the ring.  Called from within a
+ *   critical section.
+ *
+ ****************************************************************************/
+
+static void aio_ring_pollnotify(FAR struct aio_ring_s *ring,
+                                pollevent_t eventset)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FS_AIO_RING_NPOLLWAITERS; i++)
+    {
+      FAR struct pollfd *fds = ring->fds[i];
+
+      if (fds)
+        {
+          fds->revents |= (fds->events & eventset);
+          if (fds->revents != 0)
+            {
+              nxsem_post(fds->sem);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: aio_ring_events
+ *
+ * Description:
+ *   Return the poll events of the ring.  POLLIN is reported while
+ *   completions wait to be reaped, or accepts wait to be finished by
+ *   IORINGIOC_ENTER.  POLLOUT is reported while another request can be
+ *   admitted.  Called from within a critical section.
+ *
+ ****************************************************************************/
+
+static pollevent_t aio_ring_events(FAR struct aio_ring_s *ring)
+{
+  FAR struct ioring_rings *rings = ring->rings;
+  pollevent_t eventset = 0;
+  uint32_t avail;
+
+  if (rings != NULL)
+    {
+      avail = rings->cq_tail - rings->cq_head;
+      if (avail > 0 || ring->deferred != NULL)
+        {
+          eventset |= POLLIN;
+        }
+
+      if (ring->inflight + avail < ring->cq_entries)
+        {
+          eventset |= POLLOUT;
+        }
+    }
+
+  return eventset;
+}
+
+/****************************************************************************
+ * Name: aio_ring_wakeup
+ *
+ * Description:
+ *   Wake every thread waiting for completions, and notify the threads
+ *   polling the ring of its events.  Called from within a critical
+ *   section.
+ *
+ ****************************************************************************/
+
+static void aio_ring_wakeup(FAR struct aio_ring_s *ring)
+{
+  int semcount;
+
+  while (nxsem_getvalue(&ring->cqsem, &semcount) >= 0 && semcount < 0)
+    {
+      nxsem_post(&ring->cqsem);
+    }
+
+  aio_ring_pollnotify(ring, aio_ring_events(ring));
+}
+
+/****************************************************************************
+ * Name: aio_ring_complete
+ *
+ * Description:
+ *   Post the completion of a request and release the request.  This may
+ *   run on any thread.  There is always room in the completion queue:
+ *   aio_ring_enter() admits no more requests than it can hold.
+ *
+ ****************************************************************************/
+
+static void aio_ring_complete(FAR struct aio_ring_req_s *req, int res)
+{
+  FAR struct aio_ring_s *ring = req->ring;
+  FAR struct ioring_rings *rings = ring->rings;
+  FAR struct ioring_cqe *cqe;
+  irqstate_t flags;
+  uint32_t tail;
+
+  req->aiocb.aio_result = res;
+
+  flags = enter_critical_section();
+
+  tail           = rings->cq_tail;
+  cqe            = &ring->cqes[tail & (ring->cq_entries - 1)];
+  cqe->user_data = req->user_data;
+  cqe->res       = res;
+  cqe->flags     = 0;
+
+  /* The entry must be visible before the new tail is */
+
+  SP_DMB();
+  rings->cq_tail = tail + 1;
+
+  req->flink     = ring->freelist;
+  ring->freelist = req;
+  ring->inflight--;
+
+  aio_ring_wakeup(ring);
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: aio_ring_notify
+ *
+ * Description:
+ *   The completion callback that the AIO workers call in place of
+ *   signalling the submitter.
+ *
+ ****************************************************************************/
+
+static void aio_ring_notify(FAR struct aiocb *aiocbp)
+{
+  aio_ring_complete((FAR struct aio_ring_req_s *)aiocbp,
+                    aiocbp->aio_result);
+}
+
+/****************************************************************************
+ * Name: aio_ring_defer
+ *
+ * Description:
+ *   Hand a request back to be finished by the submitting task on its next
+ *   entry to the ring.  This is needed for accept(), as the new descriptor
+ *   must be allocated in the task group of the submitter.
+ *
+ ****************************************************************************/
+
+static void aio_ring_defer(FAR struct aio_ring_req_s *req)
+{
+  FAR struct aio_ring_s *ring = req->ring;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  req->flink     = ring->deferred;
+  ring->deferred = req;
+  aio_ring_wakeup(ring);
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: aio_ring_pollsetup
+ *
+ * Description:
+ *   Set up or tear down the readiness wait of a request.
+ *
+ ****************************************************************************/
+
+static int aio_ring_pollsetup(FAR struct aio_ring_req_s *req, bool setup)
+{
+#ifdef CONFIG_NET
+  if (req->sock)
+    {
+      return psock_poll((FAR struct socket *)req->handle, &req->fds, setup);
+    }
+#endif
+
+  return file_poll((FAR struct file *)req->handle, &req->fds, setup);
+}
+
+/****************************************************************************
+ * Name: aio_ring_arm
+ *
+ * Description:
+ *   Hand a request to the poller to wait until its file or socket reports
+ *   one of the events.
+ *
+ ****************************************************************************/
+
+static int aio_ring_arm(FAR struct aio_ring_req_s *req, pollevent_t events)
+{
+  irqstate_t flags;
+  int ret;
+
+  memset(&req->fds, 0, sizeof(struct pollfd));
+  req->fds.events = events;
+  req->fds.ptr    = req->handle;
+  req->fds.sem    = &g_aio_ring_pollsem;
+
+  /* The wait is set up before the poller can see it, so that the poller
+   * never tears down a wait that is still being set up.
+   */
+
+  ret = aio_ring_pollsetup(req, true);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  flags = enter_critical_section();
+  req->flink       = g_aio_ring_waits;
+  g_aio_ring_waits = req;
+  leave_critical_section(flags);
+
+  /* Have the poller look at the new wait and its deadline */
+
+  nxsem_post(&g_aio_ring_pollsem);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_ring_tryio
+ *
+ * Description:
+ *   Transfer without blocking, on a socket or on the private non-blocking
+ *   open of a driver.
+ *
+ ****************************************************************************/
+
+static ssize_t aio_ring_tryio(FAR struct aio_ring_req_s *req)
+{
+  FAR void *buf = (FAR void *)req->aiocb.aio_buf;
+  size_t len = req->aiocb.aio_nbytes;
+  bool out;
+
+  out = req->opcode == IORING_OP_WRITE || req->opcode == IORING_OP_SEND;
+
+#ifdef CONFIG_NET
+  if (req->sock)
+    {
+      FAR struct socket *psock = (FAR struct socket *)req->handle;
+      int flags = req->op_flags | MSG_DONTWAIT;
+
+      if (out)
+        {
+          return psock_send(psock, buf, len, flags);
+        }
+      else
+        {
+          return psock_recv(psock, buf, len, flags);
+        }
+    }
+#endif
+
+  if (out)
+    {
+      return file_pwrite(&req->file, buf, len, req->aiocb.aio_offset);
+    }
+  else
+    {
+      return file_pread(&req->file, buf, len, req->aiocb.aio_offset);
+    }
+}
+
+/****************************************************************************
+ * Name: aio_ring_finish
+ *
+ * Description:
+ *   Complete a request that the poller or the submitter carried out,
+ *   closing the private open of its driver if it has one.
+ *
+ ****************************************************************************/
+
+static void aio_ring_finish(FAR struct aio_ring_req_s *req, int res)
+{
+  if (req->file.f_inode != NULL)
+    {
+      file_close(&req->file);
+    }
+
+  aio_ring_complete(req, res);
+}
+
+/****************************************************************************
+ * Name: aio_ring_ready
+ *
+ * Description:
+ *   Carry on with a request whose wait has ended, on the poller thread.
+ *   Transfers that would still block wait again.
+ *
+ ****************************************************************************/
+
+static void aio_ring_ready(FAR struct aio_ring_req_s *req)
+{
+  pollevent_t events = req->fds.events;
+  ssize_t ret;
+
+  if (req->aborted)
+    {
+      aio_ring_finish(req, -ECANCELED);
+      return;
+    }
+
+  switch (req->opcode)
+    {
+      case IORING_OP_POLL:
+        ret = req->fds.revents;
+        break;
+
+      case IORING_OP_ACCEPT:
+
+        /* The new descriptor must belong to the task group of the
+         * submitter, so leave the accept itself to it.
+         */
+
+        aio_ring_defer(req);
+        return;
+
+      case IORING_OP_READ:
+      case IORING_OP_WRITE:
+      case IORING_OP_SEND:
+      case IORING_OP_RECV:
+        ret = aio_ring_tryio(req);
+        if (ret == -EAGAIN)
+          {
+            ret = aio_ring_arm(req, events);
+            if (ret >= 0)
+              {
+                return;
+              }
+          }
+        break;
+
+      default:
+        ret = -EINVAL;
+        break;
+    }
+
+  if (ret < 0)
+    {
+      ferr("ERROR: I/O ring operation %d failed: %d\n",
+           req->opcode, (int)ret);
+    }
+
+  aio_ring_finish(req, ret);
+}
+
+/****************************************************************************
+ * Name: aio_ring_scan
+ *
+ * Description:
+ *   Take the requests whose wait has ended off the wait list and carry on
+ *   with them.
+ *
+ * Returned Value:
+ *   The number of ticks until the next deadline, or -1 if there is none.
+ *
+ ****************************************************************************/
+
+static sclock_t aio_ring_scan(void)
+{
+  FAR struct aio_ring_req_s **link;
+  FAR struct aio_ring_req_s *ready = NULL;
+  FAR struct aio_ring_req_s *req;
+  sclock_t timeout = -1;
+  sclock_t remain;
+  irqstate_t flags;
+  clock_t now;
+
+  flags = enter_critical_section();
+  now   = clock_systimer();
+  link  = &g_aio_ring_waits;
+
+  while ((req = *link) != NULL)
+    {
+      remain = (sclock_t)(req->deadline - now);
+      if (req->aborted || req->fds.revents != 0 ||
+          (req->timed && remain <= 0))
+        {
+          *link      = req->flink;
+          req->flink = ready;
+          ready      = req;
+        }
+      else
+        {
+          if (req->timed && (timeout < 0 || remain < timeout))
+            {
+              timeout = remain;
+            }
+
+          link = &req->flink;
+        }
+    }
+
+  leave_critical_section(flags);
+
+  while ((req = ready) != NULL)
+    {
+      ready = req->flink;
+      aio_ring_pollsetup(req, false);
+      aio_ring_ready(req);
+    }
+
+  return timeout;
+}
+
+/****************************************************************************
+ * Name: aio_ring_poller
+ *
+ * Description:
+ *   The poller thread.  Every pollfd structure on the wait list posts
+ *   g_aio_ring_pollsem, so one wait covers them all.
+ *
+ ****************************************************************************/
+
+static int aio_ring_poller(int argc, FAR char *argv[])
+{
+  sclock_t timeout;
+
+  for (; ; )
+    {
+      timeout = aio_ring_scan();
+      if (timeout < 0)
+        {
+          nxsem_wait_uninterruptible(&g_aio_ring_pollsem);
+        }
+      else
+        {
+          nxsem_tickwait_uninterruptible(&g_aio_ring_pollsem,
+                                         clock_systimer(), timeout);
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_ring_worker
+ *
+ * Description:
+ *   Carry out a file transfer or fsync on an AIO worker thread.  Reads and
+ *   writes that the AIO workers merge with their neighbours do not come
+ *   here.
+ *
+ ****************************************************************************/
+
+static void aio_ring_worker(FAR void *arg)
+{
+  FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
+  FAR struct aio_ring_req_s *req;
+  FAR struct aiocb *aiocbp;
+  FAR struct file *filep;
+  ssize_t ret;
+  pid_t pid;
+
+  DEBUGASSERT(aioc && aioc->aioc_aiocbp);
+  pid    = aioc->aioc_pid;
+  filep  = aioc->u.aioc_filep;
+  aiocbp = aioc_decant(aioc);
+  req    = (FAR struct aio_ring_req_s *)aiocbp;
+
+  switch (req->opcode)
+    {
+      case IORING_OP_READ:
+        ret = file_pread(filep, (FAR void *)aiocbp->aio_buf,
+                         aiocbp->aio_nbytes, aiocbp->aio_offset);
+        break;
+
+      case IORING_OP_WRITE:
+        ret = file_pwrite(filep, (FAR const void *)aiocbp->aio_buf,
+                          aiocbp->aio_nbytes, aiocbp->aio_offset);
+        break;
+
+      case IORING_OP_FSYNC:
+        ret = file_fsync(filep);
+        break;
+
+      default:
+        ret = -EINVAL;
+        break;
+    }
+
+  if (ret < 0)
+    {
+      ferr("ERROR: I/O ring operation %d failed: %d\n",
+           req->opcode, (int)ret);
+    }
+
+  aiocbp->aio_result = ret;
+  aio_signal(pid, aiocbp);
+}
+
+/****************************************************************************
+ * Name: aio_ring_queue
+ *
+ * Description:
+ *   Hand a request to the AIO workers.  Must be called by the submitter as
+ *   the descriptor is looked up in its task group.
+ *
+ ****************************************************************************/
+
+static int aio_ring_queue(FAR struct aio_ring_req_s *req)
+{
+  FAR struct aio_container_s *aioc;
+  int ret;
+
+  aioc = aio_contain(&req->aiocb);
+  if (aioc == NULL)
+    {
+      return -get_errno();
+    }
+
+  /* Only reads and writes take part in merging */
+
+  switch (req->opcode)
+    {
+      case IORING_OP_READ:
+        aioc->aioc_op = LIO_READ;
+        break;
+
+      case IORING_OP_WRITE:
+        aioc->aioc_op = LIO_WRITE;
+        break;
+
+      default:
+        aioc->aioc_op = LIO_NOP;
+        break;
+    }
+
+  ret = aio_queue(aioc, aio_ring_worker);
+  if (ret < 0)
+    {
+      aioc_decant(aioc);
+      return req->aiocb.aio_result;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_ring_lookup
+ *
+ * Description:
+ *   Look up the file or socket of a request in the task group of the
+ *   submitter.
+ *
+ ****************************************************************************/
+
+static int aio_ring_lookup(FAR struct aio_ring_req_s *req)
+{
+  FAR struct file *filep;
+  int ret;
+
+#ifdef CONFIG_NET
+  if (req->sock)
+    {
+      req->handle = sockfd_socket(req->aiocb.aio_fildes);
+      return req->handle != NULL ? OK : -EBADF;
+    }
+#endif
+
+  ret = fs_getfilep(req->aiocb.aio_fildes, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  req->handle = filep;
+  return OK;
+}
+
+#ifdef CONFIG_NET
+/****************************************************************************
+ * Name: aio_ring_accept
+ *
+ * Description:
+ *   Attempt an accept in the context of the submitter without blocking.
+ *
+ ****************************************************************************/
+
+static int aio_ring_accept(FAR struct aio_ring_req_s *req)
+{
+  FAR struct socket *psock = (FAR struct socket *)req->handle;
+  int fd = req->aiocb.aio_fildes;
+  uint8_t sflags;
+  int ret;
+
+  /* The network lock keeps other users of the listening socket from
+   * seeing the temporary non-blocking mode.
+   */
+
+  net_lock();
+  sflags = psock->s_flags;
+  psock->s_flags |= _SF_NONBLOCK;
+
+  ret = accept(fd, (FAR struct sockaddr *)req->aiocb.aio_buf,
+               (FAR socklen_t *)req->addr2);
+  if (ret < 0)
+    {
+      ret = -get_errno();
+    }
+
+  if (!_SS_ISNONBLOCK(sflags))
+    {
+      psock->s_flags &= ~_SF_NONBLOCK;
+    }
+
+  net_unlock();
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: aio_ring_flush
+ *
+ * Description:
+ *   Finish the accepts whose connections have arrived.  Called by the
+ *   submitter with the ring locked.
+ *
+ ****************************************************************************/
+
+static void aio_ring_flush(FAR struct aio_ring_s *ring)
+{
+  FAR struct aio_ring_req_s *req;
+  FAR struct aio_ring_req_s *next;
+  irqstate_t flags;
+  int ret;
+
+  flags = enter_critical_section();
+  req = ring->deferred;
+  ring->deferred = NULL;
+  leave_critical_section(flags);
+
+  for (; req != NULL; req = next)
+    {
+      next = req->flink;
+
+#ifdef CONFIG_NET
+      /* Another thread may have taken the connection first.  Then wait
+       * for the next one.
+       */
+
+      ret = aio_ring_accept(req);
+      if (ret == -EAGAIN)
+        {
+          ret = aio_ring_arm(req, POLLIN);
+          if (ret >= 0)
+            {
+              continue;
+            }
+        }
+#else
+      ret = -ENOTSOCK;
+#endif
+
+      aio_ring_complete(req, ret);
+    }
+}
+
+/****************************************************************************
+ * Name: aio_ring_startio
+ *
+ * Description:
+ *   Start a read, write, send or receive.  Transfers on files go to the AIO
+ *   workers.  Transfers on sockets, and on drivers that can be polled such
+ *   as pipes and terminals, may block for ever.  They are tried at once
+ *   without blocking instead, so that data or buffer space that is already
+ *   available is used without a trip through another thread; if they would
+ *   block, the poller waits for the socket or driver.  Closing the ring
+ *   thus never waits for a transfer that may not end.
+ *
+ * Returned Value:
+ *   -EINPROGRESS if the request was handed on, otherwise its result.
+ *
+ ****************************************************************************/
+
+static int aio_ring_startio(FAR struct aio_ring_req_s *req)
+{
+  FAR struct file *filep;
+  FAR struct inode *inode;
+  struct file nbfile;
+  ssize_t ret;
+
+  ret = aio_ring_lookup(req);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (!req->sock)
+    {
+      if (req->opcode == IORING_OP_SEND || req->opcode == IORING_OP_RECV)
+        {
+          return -ENOTSOCK;
+        }
+
+      filep = (FAR struct file *)req->handle;
+      inode = filep->f_inode;
+
+      if (!INODE_IS_DRIVER(inode) || inode->u.i_ops == NULL ||
+          inode->u.i_ops->poll == NULL)
+        {
+          ret = aio_ring_queue(req);
+          return ret < 0 ? ret : -EINPROGRESS;
+        }
+
+      /* Transfer through a private open of the driver in non-blocking
+       * mode.  Setting O_NONBLOCK on the caller's own open file would
+       * change it for every other user of the descriptor.
+       */
+
+      memcpy(&nbfile, filep, sizeof(struct file));
+      nbfile.f_oflags |= O_NONBLOCK;
+
+      ret = file_dup2(&nbfile, &req->file);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  ret = aio_ring_tryio(req);
+  if (ret == -EAGAIN && (req->op_flags & MSG_DONTWAIT) == 0)
+    {
+      if (req->opcode == IORING_OP_WRITE || req->opcode == IORING_OP_SEND)
+        {
+          ret = aio_ring_arm(req, POLLOUT | POLLERR | POLLHUP);
+        }
+      else
+        {
+          ret = aio_ring_arm(req, POLLIN | POLLERR | POLLHUP);
+        }
+
+      if (ret >= 0)
+        {
+          return -EINPROGRESS;
+        }
+    }
+
+  if (req->file.f_inode != NULL)
+    {
+      file_close(&req->file);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: aio_ring_submit
+ *
+ * Description:
+ *   Start one request.  Requests that can be carried out at once are
+ *   completed here; the others are handed to the AIO workers or to the
+ *   poller.
+ *
+ ****************************************************************************/
+
+static void aio_ring_submit(FAR struct aio_ring_s *ring,
+                            FAR const struct ioring_sqe *sqe)
+{
+  FAR struct aio_ring_req_s *req;
+  irqstate_t flags;
+  int ret;
+
+  flags = enter_critical_section();
+  req            = ring->freelist;
+  ring->freelist = req->flink;
+  ring->inflight++;
+  leave_critical_section(flags);
+
+  memset(&req->aiocb, 0, sizeof(struct aiocb));
+  req->aiocb.aio_sigevent.sigev_notify = SIGEV_NONE;
+  req->aiocb.aio_buf    = sqe->addr;
+  req->aiocb.aio_offset = sqe->off;
+  req->aiocb.aio_nbytes = sqe->len;
+  req->aiocb.aio_fildes = sqe->fd;
+  req->aiocb.aio_result = -EINPROGRESS;
+  req->aiocb.aio_notify = aio_ring_notify;
+
+  req->user_data = sqe->user_data;
+  req->addr2     = sqe->addr2;
+  req->opcode    = sqe->opcode;
+  req->handle    = NULL;
+  memset(&req->file, 0, sizeof(struct file));
+  req->sock      = false;
+  req->timed     = false;
+  req->aborted   = false;
+
+  /* MSG_* flags apply only to send and receive */
+
+  req->op_flags  = sqe->opcode == IORING_OP_READ ||
+                   sqe->opcode == IORING_OP_WRITE ? 0 : sqe->op_flags;
+
+  if (sqe->opcode != IORING_OP_NOP &&
+      (sqe->fd < 0 || sqe->fd >= AIO_RING_NFDS))
+    {
+      aio_ring_complete(req, -EBADF);
+      return;
+    }
+
+#ifdef CONFIG_NET
+  req->sock = sqe->fd >= CONFIG_NFILE_DESCRIPTORS;
+#endif
+
+  switch (sqe->opcode)
+    {
+      case IORING_OP_NOP:
+        ret = OK;
+        break;
+
+      case IORING_OP_READ:
+      case IORING_OP_WRITE:
+      case IORING_OP_SEND:
+      case IORING_OP_RECV:
+        ret = aio_ring_startio(req);
+        if (ret == -EINPROGRESS)
+          {
+            return;
+          }
+        break;
+
+      case IORING_OP_FSYNC:
+        ret = req->sock ? -EINVAL : aio_ring_queue(req);
+        if (ret >= 0)
+          {
+            return;
+          }
+        break;
+
+#ifdef CONFIG_NET
+      case IORING_OP_ACCEPT:
+        ret = req->sock ? aio_ring_lookup(req) : -ENOTSOCK;
+        if (ret >= 0)
+          {
+            ret = aio_ring_accept(req);
+            if (ret == -EAGAIN)
+              {
+                ret = aio_ring_arm(req, POLLIN);
+                if (ret >= 0)
+                  {
+                    return;
+                  }
+              }
+          }
+        break;
+#endif
+
+      case IORING_OP_POLL:
+        ret = aio_ring_lookup(req);
+        if (ret >= 0)
+          {
+            if (sqe->off >= 0)
+              {
+                req->timed    = true;
+                req->deadline = clock_systimer() + MSEC2TICK(sqe->off);
+              }
+
+            ret = aio_ring_arm(req, req->op_flags);
+            if (ret >= 0)
+              {
+                return;
+              }
+          }
+        break;
+
+      default:
+        ret = -EINVAL;
+        break;
+    }
+
+  aio_ring_complete(req, ret);
+}
+
+/****************************************************************************
+ * Name: aio_ring_start
+ *
+ * Description:
+ *   Start the poller thread when the first ring is set up.
+ *
+ ****************************************************************************/
+
+static int aio_ring_start(void)
+{
+  int ret;
+
+  ret = aio_lock();
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (g_aio_ring_pid <= 0)
+    {
+      ret = kthread_create("aio_ring", CONFIG_FS_AIO_PRIORITY,
+                           CONFIG_FS_AIO_STACKSIZE, aio_ring_poller, NULL);
+      if (ret > 0)
+        {
+          g_aio_ring_pid = ret;
+          ret = OK;
+        }
+    }
+
+  aio_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: aio_ring_setup
+ *
+ * Description:
+ *   Allocate the queues.  The shared state comes from the user heap so that
+ *   the caller can reach it directly.  A kernel build has no heap shared
+ *   with the caller, which is why FS_AIO_RING depends on !BUILD_KERNEL.
+ *
+ ****************************************************************************/
+
+static int aio_ring_setup(FAR struct aio_ring_s *ring,
+                          FAR struct ioring_params *params)
+{
+  FAR struct ioring_rings *rings;
+  FAR struct aio_ring_req_s *reqs;
+  uint32_t sq_entries;
+  uint32_t cq_entries;
+  uint32_t i;
+  int ret;
+
+  if (params == NULL || params->sq_entries == 0 ||
+      params->sq_entries > CONFIG_FS_AIO_RING_MAXENTRIES ||
+      params->cq_entries > 2 * CONFIG_FS_AIO_RING_MAXENTRIES)
+    {
+      return -EINVAL;
+    }
+
+  /* Round the queue sizes up to powers of two */
+
+  for (sq_entries = 1; sq_entries < params->sq_entries; sq_entries <<= 1);
+
+  if (params->cq_entries == 0)
+    {
+      cq_entries = 2 * sq_entries;
+    }
+  else
+    {
+      for (cq_entries = 1; cq_entries < params->cq_entries;
+           cq_entries <<= 1);
+
+      if (cq_entries < sq_entries)
+        {
+          return -EINVAL;
+        }
+    }
+
+  ret = aio_ring_start();
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = nxsem_wait(&ring->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (ring->rings != NULL)
+    {
+      ret = -EBUSY;
+      goto errout;
+    }
+
+  rings = (FAR struct ioring_rings *)
+    kumm_zalloc(sizeof(struct ioring_rings) +
+                sq_entries * sizeof(struct ioring_sqe) +
+                cq_entries * sizeof(struct ioring_cqe));
+  if (rings == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  reqs = (FAR struct aio_ring_req_s *)
+    kmm_zalloc(cq_entries * sizeof(struct aio_ring_req_s));
+  if (reqs == NULL)
+    {
+      kumm_free(rings);
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  rings->sqes    = (FAR struct ioring_sqe *)(rings + 1);
+  rings->cqes    = (FAR struct ioring_cqe *)(rings->sqes + sq_entries);
+  rings->sq_mask = sq_entries - 1;
+  rings->cq_mask = cq_entries - 1;
+
+  for (i = 0; i < cq_entries; i++)
+    {
+      reqs[i].ring  = ring;
+      reqs[i].flink = ring->freelist;
+      ring->freelist = &reqs[i];
+    }
+
+  ring->rings      = rings;
+  ring->sqes       = rings->sqes;
+  ring->cqes       = rings->cqes;
+  ring->reqs       = reqs;
+  ring->sq_entries = sq_entries;
+  ring->cq_entries = cq_entries;
+
+  params->sq_entries = sq_entries;
+  params->cq_entries = cq_entries;
+  params->rings      = rings;
+
+errout:
+  nxsem_post(&ring->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: aio_ring_enter
+ *
+ * Description:
+ *   Consume up to to_submit submission queue entries, then wait until at
+ *   least min_complete completions are available to user space.
+ *
+ * Returned Value:
+ *   The number of entries consumed, or a negated errno value.  -EBUSY
+ *   means that none could be consumed because the completion queue is
+ *   full of entries that user space has not reaped.
+ *
+ ****************************************************************************/
+
+static int aio_ring_enter(FAR struct aio_ring_s *ring,
+                          FAR const struct ioring_enter_s *enter)
+{
+  FAR struct ioring_rings *rings;
+  struct ioring_sqe sqe;
+  irqstate_t flags;
+  uint32_t tail;
+  uint32_t avail;
+  bool full = false;
+  int submitted = 0;
+  int ret;
+
+  if (enter == NULL)
+    {
+      return -EINVAL;
+    }
+
+  ret = nxsem_wait(&ring->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  rings = ring->rings;
+  if (rings == NULL)
+    {
+      nxsem_post(&ring->exclsem);
+      return -EINVAL;
+    }
+
+  aio_ring_flush(ring);
+
+  /* The entries must not be read before the tail that publishes them */
+
+  tail = rings->sq_tail;
+  SP_DMB();
+
+  if (tail - ring->sq_head > ring->sq_entries)
+    {
+      nxsem_post(&ring->exclsem);
+      return -EINVAL;
+    }
+
+  while (submitted < enter->to_submit && ring->sq_head != tail)
+    {
+      /* Accept no more requests than the completion queue can hold */
+
+      flags = enter_critical_section();
+      avail = rings->cq_tail - rings->cq_head;
+      full  = ring->inflight + avail >= ring->cq_entries;
+      leave_critical_section(flags);
+
+      if (full)
+        {
+          break;
+        }
+
+      /* Work on a copy that user space cannot change underneath us */
+
+      memcpy(&sqe, &ring->sqes[ring->sq_head & (ring->sq_entries - 1)],
+             sizeof(struct ioring_sqe));
+      rings->sq_head = ++ring->sq_head;
+
+      aio_ring_submit(ring, &sqe);
+      submitted++;
+    }
+
+  nxsem_post(&ring->exclsem);
+
+  /* The completions reaped since the last event may have made room for
+   * more requests, which a thread polling for POLLOUT waits for.
+   */
+
+  flags = enter_critical_section();
+  aio_ring_pollnotify(ring, aio_ring_events(ring));
+  leave_critical_section(flags);
+
+  if (submitted == 0 && full && enter->min_complete == 0)
+    {
+      return -EBUSY;
+    }
+
+  /* Wait for completions.  The check and the wait are made within the
+   * critical section that the completions are posted under so that no
+   * wake-up can be lost.
+   */
+
+  flags = enter_critical_section();
+  while (enter->min_complete > 0)
+    {
+      if (ring->deferred != NULL)
+        {
+          leave_critical_section(flags);
+
+          ret = nxsem_wait(&ring->exclsem);
+          if (ret < 0)
+            {
+              return submitted > 0 ? submitted : ret;
+            }
+
+          aio_ring_flush(ring);
+          nxsem_post(&ring->exclsem);
+
+          flags = enter_critical_section();
+          continue;
+        }
+
+      /* Stop when enough are available or no more can arrive */
+
+      avail = rings->cq_tail - rings->cq_head;
+      if (avail >= enter->min_complete || ring->inflight == 0)
+        {
+          break;
+        }
+
+      ret = nxsem_wait(&ring->cqsem);
+      if (ret < 0)
+        {
+          leave_critical_section(flags);
+          return submitted > 0 ? submitted : ret;
+        }
+    }
+
+  leave_critical_section(flags);
+  return submitted;
+}
+
+/****************************************************************************
+ * Name: aio_ring_open
+ ****************************************************************************/
+
+static int aio_ring_open(FAR struct file *filep)
+{
+  FAR struct aio_ring_s *ring;
+
+  ring = (FAR struct aio_ring_s *)kmm_zalloc(sizeof(struct aio_ring_s));
+  if (ring == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  nxsem_init(&ring->exclsem, 0, 1);
+  nxsem_init(&ring->cqsem, 0, 0);
+  nxsem_setprotocol(&ring->cqsem, SEM_PRIO_NONE);
+
+  filep->f_priv = ring;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_ring_close
+ *
+ * Description:
+ *   Requests that have not started are canceled and waits for readiness
+ *   are abandoned.  Transfers that are in progress are waited for, as
+ *   they still reference the queues.  These are only file transfers and
+ *   transfers on drivers that cannot be polled: everything that may block
+ *   for ever waits on the poller.
+ *
+ ****************************************************************************/
+
+static int aio_ring_close(FAR struct file *filep)
+{
+  FAR struct aio_ring_s *ring = (FAR struct aio_ring_s *)filep->f_priv;
+  FAR struct aio_ring_req_s *req;
+  FAR struct aio_ring_req_s *next;
+  irqstate_t flags;
+  uint32_t i;
+
+  DEBUGASSERT(ring != NULL);
+  nxsem_wait_uninterruptible(&ring->exclsem);
+
+  if (ring->rings != NULL)
+    {
+      for (i = 0; i < ring->cq_entries; i++)
+        {
+          req = &ring->reqs[i];
+          if (req->aiocb.aio_result != -EINPROGRESS)
+            {
+              continue;
+            }
+
+          aio_cancel(req->aiocb.aio_fildes, &req->aiocb);
+
+          flags = enter_critical_section();
+          req->aborted = true;
+          leave_critical_section(flags);
+        }
+
+      /* Have the poller abandon the waits of the ring */
+
+      nxsem_post(&g_aio_ring_pollsem);
+
+      flags = enter_critical_section();
+      while (ring->inflight > 0)
+        {
+          /* Accepts waiting to be finished will not be now */
+
+          req = ring->deferred;
+          ring->deferred = NULL;
+
+          for (; req != NULL; req = next)
+            {
+              next = req->flink;
+              aio_ring_complete(req, -ECANCELED);
+            }
+
+          if (ring->inflight > 0)
+            {
+              nxsem_wait_uninterruptible(&ring->cqsem);
+            }
+        }
+
+      leave_critical_section(flags);
+
+      kumm_free(ring->rings);
+      kmm_free(ring->reqs);
+    }
+
+  nxsem_destroy(&ring->cqsem);
+  nxsem_destroy(&ring->exclsem);
+  kmm_free(ring);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_ring_ioctl
+ ****************************************************************************/
+
+static int aio_ring_ioctl(FAR struct file *filep, int cmd,
+                          unsigned long arg)
+{
+  FAR struct aio_ring_s *ring = (FAR struct aio_ring_s *)filep->f_priv;
+
+  DEBUGASSERT(ring != NULL);
+
+  switch (cmd)
+    {
+      case IORINGIOC_SETUP:
+        return aio_ring_setup(ring,
+                              (FAR struct ioring_params *)((uintptr_t)arg));
+
+      case IORINGIOC_ENTER:
+        return aio_ring_enter(ring,
+                              (FAR const struct ioring_enter_s *)
+                              ((uintptr_t)arg));
+
+      default:
+        return -ENOTTY;
+    }
+}
+
+/****************************************************************************
+ * Name: aio_ring_poll
+ *
+ * Description:
+ *   See aio_ring_events() for the events reported.  They are evaluated
+ *   when the poll is set up and again on every completion and every
+ *   IORINGIOC_ENTER, so a waiter is notified as often as they change.
+ *   Reaping completions makes no call into the kernel, however: a thread
+ *   that waits for POLLOUT on a full ring is woken by the next completion
+ *   or IORINGIOC_ENTER, not by another thread reaping.
+ *
+ ****************************************************************************/
+
+static int aio_ring_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                         bool setup)
+{
+  FAR struct aio_ring_s *ring = (FAR struct aio_ring_s *)filep->f_priv;
+  pollevent_t eventset;
+  irqstate_t flags;
+  int ret = OK;
+  int i;
+
+  DEBUGASSERT(ring != NULL && fds != NULL);
+
+  flags = enter_critical_section();
+  if (setup)
+    {
+      for (i = 0; i < CONFIG_FS_AIO_RING_NPOLLWAITERS; i++)
+        {
+          if (ring->fds[i] == NULL)
+            {
+              ring->fds[i] = fds;
+              fds->priv    = &ring->fds[i];
+              break;
+            }
+        }
+
+      if (i >= CONFIG_FS_AIO_RING_NPOLLWAITERS)
+        {
+          fds->priv = NULL;
+          ret       = -EBUSY;
+          goto errout;
+        }
+
+      eventset = aio_ring_events(ring);
+      if (eventset != 0)
+        {
+          aio_ring_pollnotify(ring, eventset);
+        }
+    }
+  else if (fds->priv != NULL)
+    {
+      FAR struct pollfd **slot = (FAR struct pollfd **)fds->priv;
+
+      *slot     = NULL;
+      fds->priv = NULL;
+    }
+
+errout:
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_ring_register
+ *
+ * Description:
+ *   Register the I/O ring device at IORING_DEVPATH.
+ *
+ ****************************************************************************/
+
+int aio_ring_register(void)
+{
+  nxsem_init(&g_aio_ring_pollsem, 0, 0);
+  nxsem_setprotocol(&g_aio_ring_pollsem, SEM_PRIO_NONE);
+
+  return register_driver(IORING_DEVPATH, &g_aio_ring_fops, 0666, NULL);
+}
+
+#endif /* CONFIG_FS_AIO_RING */
@@ -72,6 +72,14 @@ int aio_signal(pid_t pid, FAR struct aiocb *aiocbp)
 
   ret = OK; /* Assume success */
 
+  /* Requests submitted from within the OS are completed by a callback */
+
+  if (aiocbp->aio_notify != NULL)
+    {
+      aiocbp->aio_notify(aiocbp);
+      return OK;
+    }
+
   /* Signal the client */
 
   ret = nxsig_notification(pid, &aiocbp->aio_sigevent,
@@ -76,10 +76,8 @@ static void aio_write_worker(FAR void *arg)
 {
   FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
   FAR struct aiocb *aiocbp;
+  FAR void *handle;
   pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  uint8_t prio;
-#endif
   ssize_t nwritten = 0;
   int oflags;
 
@@ -90,9 +88,7 @@ static void aio_write_worker(FAR void *arg)
 
   DEBUGASSERT(aioc && aioc->aioc_aiocbp);
   pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  prio   = aioc->aioc_prio;
-#endif
+  handle = aioc->u.ptr;
   aiocbp = aioc_decant(aioc);
 
 #ifdef AIO_HAVE_PSOCK
@@ -101,7 +97,7 @@ static void aio_write_worker(FAR void *arg)
     {
       /* Call fcntl(F_GETFL) to get the file open mode. */
 
-      oflags = file_fcntl(aioc->u.aioc_filep, F_GETFL);
+      oflags = file_fcntl((FAR struct file *)handle, F_GETFL);
       if (oflags < 0)
         {
           ferr("ERROR: file_fcntl failed: %d\n", oflags);
@@ -111,7 +107,7 @@ static void aio_write_worker(FAR void *arg)
 
       /* Perform the write using:
        *
-       *   u.aioc_filep - File structure pointer
+       *   handle       - File structure pointer
        *   aio_buf      - Location of buffer
        *   aio_nbytes   - Length of transfer
        *   aio_offset   - File offset
@@ -123,13 +119,13 @@ static void aio_write_worker(FAR void *arg)
         {
           /* Append to the current file position */
 
-          nwritten = file_write(aioc->u.aioc_filep,
+          nwritten = file_write((FAR struct file *)handle,
                                 (FAR const void *)aiocbp->aio_buf,
                                 aiocbp->aio_nbytes);
         }
       else
         {
-          nwritten = file_pwrite(aioc->u.aioc_filep,
+          nwritten = file_pwrite((FAR struct file *)handle,
                                  (FAR const void *)aiocbp->aio_buf,
                                  aiocbp->aio_nbytes,
                                  aiocbp->aio_offset);
@@ -140,12 +136,12 @@ static void aio_write_worker(FAR void *arg)
     {
       /* Perform the send using:
        *
-       *   u.aioc_psock - Socket structure pointer
+       *   handle       - Socket structure pointer
        *   aio_buf      - Location of buffer
        *   aio_nbytes   - Length of transfer
        */
 
-      nwritten = psock_send(aioc->u.aioc_psock,
+      nwritten = psock_send((FAR struct socket *)handle,
                             (FAR const void *)aiocbp->aio_buf,
                             aiocbp->aio_nbytes, 0);
     }
@@ -165,12 +161,6 @@ errout:
   /* Signal the client */
 
   aio_signal(pid, aiocbp);
-
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Restore the low priority worker thread default priority */
-
-  lpwork_restorepriority(prio);
-#endif
 }
 
 /****************************************************************************
@@ -287,6 +277,7 @@ int aio_write(FAR struct aiocb *aiocbp)
   sigwork_init(&aiocbp->aio_sigwork);
   aiocbp->aio_result = -EINPROGRESS;
   aiocbp->aio_priv   = NULL;
+  aiocbp->aio_notify = NULL;
 
   /* Create a container for the AIO control block.  This may cause us to
    * block if there are insufficient resources to satisfy the request.
@@ -303,6 +294,7 @@ int aio_write(FAR struct aiocb *aiocbp)
 
   /* Defer the work to the worker thread */
 
+  aioc->aioc_op = LIO_WRITE;
   ret = aio_queue(aioc, aio_write_worker);
   if (ret < 0)
     {
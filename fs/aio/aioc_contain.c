@@ -115,7 +115,10 @@ FAR struct aio_container_s *aio_contain(FAR struct aiocb *aiocbp)
     {
       /* Initialize the container */
 
+      uint8_t flags = aioc->aioc_flags;
+
       memset(aioc, 0, sizeof(struct aio_container_s));
+      aioc->aioc_flags  = flags;
       aioc->aioc_aiocbp = aiocbp;
       aioc->u.ptr       = u.ptr;
       aioc->aioc_pid    = getpid();
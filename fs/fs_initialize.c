@@ -66,5 +66,10 @@ void fs_initialize(void)
 
   aio_initialize();
 
+#ifdef CONFIG_FS_AIO_RING
+  /* Register the I/O ring device */
+
+  aio_ring_register();
+#endif
 #endif
 }
@@ -40,9 +40,13 @@
 
 #include <nuttx/config.h>
 
+#include <sys/stat.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <string.h>
+#include <unistd.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/hostfs.h>
 #include <nuttx/fs/hostfs_rpmsg.h>
@@ -51,14 +55,85 @@
 
 #include "hostfs_rpmsg.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_FS_HOSTFS_RPMSG_LEASE_MS
+#  define CONFIG_FS_HOSTFS_RPMSG_LEASE_MS 0
+#endif
+
+#ifndef CONFIG_FS_HOSTFS_RPMSG_WINDOW
+#  define CONFIG_FS_HOSTFS_RPMSG_WINDOW 1
+#endif
+
+#if CONFIG_FS_HOSTFS_RPMSG_LEASE_MS > 0
+#  define HOSTFS_RPMSG_CACHE 1
+#  define HOSTFS_RPMSG_LEASE MSEC2TICK(CONFIG_FS_HOSTFS_RPMSG_LEASE_MS)
+#else
+#  define hostfs_rpmsg_invalidate(p)
+#  define hostfs_rpmsg_unread(p,fd) (OK)
+#endif
+
+#ifndef MIN
+#  define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+#ifdef HOSTFS_RPMSG_CACHE
+/* Data read ahead on a regular file.  The server file position is already
+ * past the unread part, so it has to be given back before any other
+ * operation on the same descriptor.
+ */
+
+struct hostfs_rpmsg_file_s
+{
+  clock_t  stamp;                /* Time when buf was filled */
+  size_t   head;                 /* Next unread char in buf */
+  size_t   tail;                 /* Number of valid chars in buf */
+  size_t   size;                 /* Allocated size of buf */
+  bool     regular;              /* Read ahead is allowed */
+  char     buf[1];
+};
+
+/* A cached stat() result */
+
+struct hostfs_rpmsg_attr_s
+{
+  FAR char    *path;             /* Allocated copy of the path, NULL if free */
+  uint32_t    hash;              /* Hash of path */
+  clock_t     stamp;             /* Time when buf was received */
+  struct stat buf;
+};
+#endif
+
+/* Directory entries received in one GETDENTS reply */
+
+struct hostfs_rpmsg_dir_s
+{
+  int32_t  fd;                   /* Directory handle on the server */
+  uint32_t head;                 /* Offset of the next record in buf */
+  uint32_t tail;                 /* Number of valid chars in buf */
+  uint32_t size;                 /* Allocated size of buf */
+  bool     eod;                  /* The server reported the end */
+  char     buf[1];
+};
+
 struct hostfs_rpmsg_s
 {
   struct rpmsg_endpoint ept;
   FAR const char        *cpuname;
+  uint32_t              space;   /* Payload size of one tx buffer */
+#ifdef HOSTFS_RPMSG_CACHE
+  sem_t                 lock;    /* Protects attrs and generation */
+  uint32_t              generation;
+  unsigned int          attrnext;
+  struct hostfs_rpmsg_attr_s attrs[CONFIG_FS_HOSTFS_RPMSG_ATTR_NENTRIES];
+  FAR struct hostfs_rpmsg_file_s *files[CONFIG_NFILE_DESCRIPTORS];
+#endif
 };
 
 struct hostfs_rpmsg_cookie_s
@@ -81,9 +156,17 @@ static int hostfs_rpmsg_read_handler(FAR struct rpmsg_endpoint *ept,
 static int hostfs_rpmsg_readdir_handler(FAR struct rpmsg_endpoint *ept,
                                         FAR void *data, size_t len,
                                         uint32_t src, FAR void *priv);
+static int hostfs_rpmsg_getdents_handler(FAR struct rpmsg_endpoint *ept,
+                                         FAR void *data, size_t len,
+                                         uint32_t src, FAR void *priv);
 static int hostfs_rpmsg_statfs_handler(FAR struct rpmsg_endpoint *ept,
                                        FAR void *data, size_t len,
                                        uint32_t src, FAR void *priv);
+static void hostfs_rpmsg_copy_stat(FAR struct stat *buf,
+                                   FAR const struct stat *rsp);
+static int hostfs_rpmsg_fstat_handler(FAR struct rpmsg_endpoint *ept,
+                                      FAR void *data, size_t len,
+                                      uint32_t src, FAR void *priv);
 static int hostfs_rpmsg_stat_handler(FAR struct rpmsg_endpoint *ept,
                                      FAR void *data, size_t len,
                                      uint32_t src, FAR void *priv);
@@ -94,9 +177,25 @@ static void hostfs_rpmsg_device_destroy(struct rpmsg_device *rdev,
 static int  hostfs_rpmsg_ept_cb(FAR struct rpmsg_endpoint *ept,
                                 FAR void *data, size_t len, uint32_t src,
                                 FAR void *priv);
+static int  hostfs_rpmsg_send(uint32_t command, bool copy,
+                              FAR struct hostfs_rpmsg_header_s *msg,
+                              int len, FAR void *data,
+                              FAR struct hostfs_rpmsg_cookie_s *cookie);
+static int  hostfs_rpmsg_wait(FAR struct hostfs_rpmsg_cookie_s *cookie);
 static int  hostfs_rpmsg_send_recv(uint32_t command, bool copy,
                                    FAR struct hostfs_rpmsg_header_s *msg,
                                    int len, FAR void *data);
+static ssize_t hostfs_rpmsg_read(int fd, FAR char *buf, size_t count);
+#ifdef HOSTFS_RPMSG_CACHE
+static uint32_t hostfs_rpmsg_hash(FAR const char *path);
+static void hostfs_rpmsg_invalidate(FAR struct hostfs_rpmsg_s *priv);
+static FAR struct hostfs_rpmsg_file_s *
+            hostfs_rpmsg_file(FAR struct hostfs_rpmsg_s *priv, int fd,
+                              bool create);
+static int  hostfs_rpmsg_unread(FAR struct hostfs_rpmsg_s *priv, int fd);
+static ssize_t hostfs_rpmsg_readahead(FAR struct hostfs_rpmsg_s *priv,
+                                      int fd, FAR char *buf, size_t count);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -114,7 +213,7 @@ static const rpmsg_ept_cb g_hostfs_rpmsg_handler[] =
   [HOSTFS_RPMSG_IOCTL]     = hostfs_rpmsg_default_handler,
   [HOSTFS_RPMSG_SYNC]      = hostfs_rpmsg_default_handler,
   [HOSTFS_RPMSG_DUP]       = hostfs_rpmsg_default_handler,
-  [HOSTFS_RPMSG_FSTAT]     = hostfs_rpmsg_stat_handler,
+  [HOSTFS_RPMSG_FSTAT]     = hostfs_rpmsg_fstat_handler,
   [HOSTFS_RPMSG_FTRUNCATE] = hostfs_rpmsg_default_handler,
   [HOSTFS_RPMSG_OPENDIR]   = hostfs_rpmsg_default_handler,
   [HOSTFS_RPMSG_READDIR]   = hostfs_rpmsg_readdir_handler,
@@ -126,6 +225,7 @@ static const rpmsg_ept_cb g_hostfs_rpmsg_handler[] =
   [HOSTFS_RPMSG_RMDIR]     = hostfs_rpmsg_default_handler,
   [HOSTFS_RPMSG_RENAME]    = hostfs_rpmsg_default_handler,
   [HOSTFS_RPMSG_STAT]      = hostfs_rpmsg_stat_handler,
+  [HOSTFS_RPMSG_GETDENTS]  = hostfs_rpmsg_getdents_handler,
 };
 
 /****************************************************************************
@@ -194,6 +294,36 @@ static int hostfs_rpmsg_readdir_handler(FAR struct rpmsg_endpoint *ept,
   return 0;
 }
 
+static int hostfs_rpmsg_getdents_handler(FAR struct rpmsg_endpoint *ept,
+                                         FAR void *data, size_t len,
+                                         uint32_t src, FAR void *priv)
+{
+  FAR struct hostfs_rpmsg_header_s *header = data;
+  FAR struct hostfs_rpmsg_cookie_s *cookie =
+      (struct hostfs_rpmsg_cookie_s *)(uintptr_t)header->cookie;
+  FAR struct hostfs_rpmsg_getdents_s *rsp = data;
+  FAR struct hostfs_rpmsg_dir_s *dir = cookie->data;
+  size_t size;
+
+  cookie->result = header->result;
+  if (cookie->result > 0)
+    {
+      size = B2C(len - sizeof(*rsp));
+      if (size > dir->size)
+        {
+          size = dir->size;
+        }
+
+      memcpy(dir->buf, rsp->buf, size);
+      dir->head = 0;
+      dir->tail = size;
+    }
+
+  nxsem_post(&cookie->sem);
+
+  return 0;
+}
+
 static int hostfs_rpmsg_statfs_handler(FAR struct rpmsg_endpoint *ept,
                                        FAR void *data, size_t len,
                                        uint32_t src, FAR void *priv)
@@ -222,6 +352,44 @@ static int hostfs_rpmsg_statfs_handler(FAR struct rpmsg_endpoint *ept,
   return 0;
 }
 
+static void hostfs_rpmsg_copy_stat(FAR struct stat *buf,
+                                   FAR const struct stat *rsp)
+{
+  buf->st_dev     = rsp->st_dev;
+  buf->st_ino     = rsp->st_ino;
+  buf->st_mode    = rsp->st_mode;
+  buf->st_nlink   = rsp->st_nlink;
+  buf->st_uid     = rsp->st_uid;
+  buf->st_gid     = rsp->st_gid;
+  buf->st_rdev    = rsp->st_rdev;
+  buf->st_size    = B2C(rsp->st_size);
+  buf->st_atime   = rsp->st_atime;
+  buf->st_mtime   = rsp->st_mtime;
+  buf->st_ctime   = rsp->st_ctime;
+  buf->st_blksize = B2C(rsp->st_blksize);
+  buf->st_blocks  = rsp->st_blocks;
+}
+
+static int hostfs_rpmsg_fstat_handler(FAR struct rpmsg_endpoint *ept,
+                                      FAR void *data, size_t len,
+                                      uint32_t src, FAR void *priv)
+{
+  FAR struct hostfs_rpmsg_header_s *header = data;
+  FAR struct hostfs_rpmsg_cookie_s *cookie =
+      (struct hostfs_rpmsg_cookie_s *)(uintptr_t)header->cookie;
+  FAR struct hostfs_rpmsg_fstat_s *rsp = data;
+
+  cookie->result = header->result;
+  if (cookie->result >= 0)
+    {
+      hostfs_rpmsg_copy_stat(cookie->data, &rsp->buf);
+    }
+
+  nxsem_post(&cookie->sem);
+
+  return 0;
+}
+
 static int hostfs_rpmsg_stat_handler(FAR struct rpmsg_endpoint *ept,
                                      FAR void *data, size_t len,
                                      uint32_t src, FAR void *priv)
@@ -230,24 +398,11 @@ static int hostfs_rpmsg_stat_handler(FAR struct rpmsg_endpoint *ept,
   FAR struct hostfs_rpmsg_cookie_s *cookie =
       (struct hostfs_rpmsg_cookie_s *)(uintptr_t)header->cookie;
   FAR struct hostfs_rpmsg_stat_s *rsp = data;
-  FAR struct stat *buf = cookie->data;
 
   cookie->result = header->result;
   if (cookie->result >= 0)
     {
-      buf->st_dev     = rsp->buf.st_dev;
-      buf->st_ino     = rsp->buf.st_ino;
-      buf->st_mode    = rsp->buf.st_mode;
-      buf->st_nlink   = rsp->buf.st_nlink;
-      buf->st_uid     = rsp->buf.st_uid;
-      buf->st_gid     = rsp->buf.st_gid;
-      buf->st_rdev    = rsp->buf.st_rdev;
-      buf->st_size    = B2C(rsp->buf.st_size);
-      buf->st_atime   = rsp->buf.st_atime;
-      buf->st_mtime   = rsp->buf.st_mtime;
-      buf->st_ctime   = rsp->buf.st_ctime;
-      buf->st_blksize = B2C(rsp->buf.st_blksize);
-      buf->st_blocks  = rsp->buf.st_blocks;
+      hostfs_rpmsg_copy_stat(cookie->data, &rsp->buf);
     }
 
   nxsem_post(&cookie->sem);
@@ -294,30 +449,30 @@ static int hostfs_rpmsg_ept_cb(FAR struct rpmsg_endpoint *ept, FAR void *data,
   return -EINVAL;
 }
 
-static int hostfs_rpmsg_send_recv(uint32_t command, bool copy,
-                                  FAR struct hostfs_rpmsg_header_s *msg,
-                                  int len, FAR void *data)
+static int hostfs_rpmsg_send(uint32_t command, bool copy,
+                             FAR struct hostfs_rpmsg_header_s *msg,
+                             int len, FAR void *data,
+                             FAR struct hostfs_rpmsg_cookie_s *cookie)
 {
   FAR struct hostfs_rpmsg_s *priv = &g_hostfs_rpmsg;
-  FAR struct hostfs_rpmsg_cookie_s cookie;
   int ret;
 
-  memset(&cookie, 0, sizeof(cookie));
-  nxsem_init(&cookie.sem, 0, 0);
-  nxsem_setprotocol(&cookie.sem, SEM_PRIO_NONE);
+  memset(cookie, 0, sizeof(*cookie));
+  nxsem_init(&cookie->sem, 0, 0);
+  nxsem_setprotocol(&cookie->sem, SEM_PRIO_NONE);
 
   if (data)
     {
-      cookie.data = data;
+      cookie->data = data;
     }
   else if (copy)
     {
-      cookie.data = msg;
+      cookie->data = msg;
     }
 
   msg->command = command;
   msg->result  = -ENXIO;
-  msg->cookie  = (uintptr_t)&cookie;
+  msg->cookie  = (uintptr_t)cookie;
 
   if (copy)
     {
@@ -330,20 +485,314 @@ static int hostfs_rpmsg_send_recv(uint32_t command, bool copy,
 
   if (ret < 0)
     {
-      goto fail;
+      nxsem_destroy(&cookie->sem);
     }
 
-  ret = nxsem_wait_uninterruptible(&cookie.sem);
+  return ret;
+}
+
+static int hostfs_rpmsg_wait(FAR struct hostfs_rpmsg_cookie_s *cookie)
+{
+  int ret;
+
+  ret = nxsem_wait_uninterruptible(&cookie->sem);
   if (ret == 0)
     {
-      ret = cookie.result;
+      ret = cookie->result;
     }
 
-fail:
-  nxsem_destroy(&cookie.sem);
+  nxsem_destroy(&cookie->sem);
   return ret;
 }
 
+static int hostfs_rpmsg_send_recv(uint32_t command, bool copy,
+                                  FAR struct hostfs_rpmsg_header_s *msg,
+                                  int len, FAR void *data)
+{
+  struct hostfs_rpmsg_cookie_s cookie;
+  int ret;
+
+  ret = hostfs_rpmsg_send(command, copy, msg, len, data, &cookie);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return hostfs_rpmsg_wait(&cookie);
+}
+
+/****************************************************************************
+ * Name: hostfs_rpmsg_read
+ *
+ * Description:
+ *   Read count chars from the server.  Up to CONFIG_FS_HOSTFS_RPMSG_WINDOW
+ *   requests are outstanding at any time.  The server handles them in
+ *   order, so the replies are consecutive pieces of the file even if some
+ *   of them are short; the gaps left by short replies are closed as the
+ *   replies are collected.
+ *
+ ****************************************************************************/
+
+static ssize_t hostfs_rpmsg_read(int fd, FAR char *buf, size_t count)
+{
+  FAR struct hostfs_rpmsg_s *priv = &g_hostfs_rpmsg;
+  struct hostfs_rpmsg_cookie_s cookies[CONFIG_FS_HOSTFS_RPMSG_WINDOW];
+  size_t offsets[CONFIG_FS_HOSTFS_RPMSG_WINDOW];
+  size_t chunk;
+  size_t read = 0;
+  size_t sent = 0;
+  bool done = false;
+  int ret = 0;
+  int tmp;
+  int n;
+  int i;
+
+  /* Ask for as much as fits into one reply, or for everything if the size
+   * of the rpmsg buffers is not known yet.
+   */
+
+  chunk = count;
+  if (priv->space > sizeof(struct hostfs_rpmsg_read_s))
+    {
+      chunk = priv->space - sizeof(struct hostfs_rpmsg_read_s);
+    }
+
+  while (!done && sent < count)
+    {
+      for (n = 0; n < CONFIG_FS_HOSTFS_RPMSG_WINDOW && sent < count; n++)
+        {
+          struct hostfs_rpmsg_read_s msg =
+          {
+            .fd    = fd,
+            .count = C2B(MIN(chunk, count - sent)),
+          };
+
+          tmp = hostfs_rpmsg_send(HOSTFS_RPMSG_READ, true,
+                  (FAR struct hostfs_rpmsg_header_s *)&msg, sizeof(msg),
+                  buf + sent, &cookies[n]);
+          if (tmp < 0)
+            {
+              ret  = tmp;
+              done = true;
+              break;
+            }
+
+          offsets[n] = sent;
+          sent      += MIN(chunk, count - sent);
+        }
+
+      for (i = 0; i < n; i++)
+        {
+          tmp = hostfs_rpmsg_wait(&cookies[i]);
+          if (tmp > 0)
+            {
+              if (read != offsets[i])
+                {
+                  memmove(buf + read, buf + offsets[i], B2C(tmp));
+                }
+
+              read += B2C(tmp);
+            }
+          else
+            {
+              ret  = tmp;
+              done = true;
+            }
+        }
+
+      /* The file position on the server is now just past what was
+       * received.
+       */
+
+      sent = read;
+    }
+
+  return read ? read : ret;
+}
+
+#ifdef HOSTFS_RPMSG_CACHE
+static uint32_t hostfs_rpmsg_hash(FAR const char *path)
+{
+  uint32_t hash = 2166136261u;
+
+  while (*path != '\0')
+    {
+      hash ^= (uint8_t)*path++;
+      hash *= 16777619u;
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Name: hostfs_rpmsg_invalidate
+ *
+ * Description:
+ *   Forget all cached attributes.  Called after every operation that may
+ *   change something on the server.
+ *
+ ****************************************************************************/
+
+static void hostfs_rpmsg_invalidate(FAR struct hostfs_rpmsg_s *priv)
+{
+  int i;
+
+  nxsem_wait_uninterruptible(&priv->lock);
+
+  for (i = 0; i < CONFIG_FS_HOSTFS_RPMSG_ATTR_NENTRIES; i++)
+    {
+      if (priv->attrs[i].path != NULL)
+        {
+          kmm_free(priv->attrs[i].path);
+          priv->attrs[i].path = NULL;
+        }
+    }
+
+  /* Replies to stat requests sent before this point are stale */
+
+  priv->generation++;
+  nxsem_post(&priv->lock);
+}
+
+/****************************************************************************
+ * Name: hostfs_rpmsg_file
+ *
+ * Description:
+ *   Return the read ahead state of a descriptor, optionally creating it.
+ *   Only regular files are read ahead, since reading more than requested
+ *   from a pipe or a device cannot be undone.
+ *
+ ****************************************************************************/
+
+static FAR struct hostfs_rpmsg_file_s *
+hostfs_rpmsg_file(FAR struct hostfs_rpmsg_s *priv, int fd, bool create)
+{
+  FAR struct hostfs_rpmsg_file_s *file;
+  struct stat buf;
+  size_t size = 0;
+
+  if (fd < 0 || fd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+      return NULL;
+    }
+
+  file = priv->files[fd];
+  if (file != NULL || !create)
+    {
+      return file;
+    }
+
+  if (host_fstat(fd, &buf) >= 0 && S_ISREG(buf.st_mode) &&
+      priv->space > sizeof(struct hostfs_rpmsg_read_s))
+    {
+      size = priv->space - sizeof(struct hostfs_rpmsg_read_s);
+    }
+
+  file = kmm_zalloc(sizeof(*file) + size);
+  if (file != NULL)
+    {
+      file->size    = size;
+      file->regular = size > 0;
+      priv->files[fd] = file;
+    }
+
+  return file;
+}
+
+/****************************************************************************
+ * Name: hostfs_rpmsg_unread
+ *
+ * Description:
+ *   Drop the read ahead data of a descriptor and move the file position on
+ *   the server back to where the caller believes it is.
+ *
+ ****************************************************************************/
+
+static int hostfs_rpmsg_unread(FAR struct hostfs_rpmsg_s *priv, int fd)
+{
+  FAR struct hostfs_rpmsg_file_s *file;
+  struct hostfs_rpmsg_lseek_s msg;
+  int ret;
+
+  file = hostfs_rpmsg_file(priv, fd, false);
+  if (file == NULL || file->head >= file->tail)
+    {
+      return OK;
+    }
+
+  msg.fd     = fd;
+  msg.offset = -(int32_t)C2B(file->tail - file->head);
+  msg.whence = SEEK_CUR;
+
+  file->head = 0;
+  file->tail = 0;
+
+  ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_LSEEK, true,
+          (FAR struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), NULL);
+
+  return ret < 0 ? ret : OK;
+}
+
+/****************************************************************************
+ * Name: hostfs_rpmsg_readahead
+ *
+ * Description:
+ *   Serve a read from the read ahead buffer of a regular file.  Reads
+ *   smaller than one rpmsg buffer refill it.  Returns the number of chars
+ *   copied to buf, which may be less than count if the rest has to be read
+ *   directly.
+ *
+ ****************************************************************************/
+
+static ssize_t hostfs_rpmsg_readahead(FAR struct hostfs_rpmsg_s *priv,
+                                      int fd, FAR char *buf, size_t count)
+{
+  FAR struct hostfs_rpmsg_file_s *file;
+  size_t read;
+  ssize_t ret;
+
+  file = hostfs_rpmsg_file(priv, fd, true);
+  if (file == NULL || !file->regular)
+    {
+      return 0;
+    }
+
+  /* Data older than the lease may have changed on the server */
+
+  if (file->head < file->tail &&
+      clock_systimer() - file->stamp >= HOSTFS_RPMSG_LEASE)
+    {
+      ret = hostfs_rpmsg_unread(priv, fd);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  read = MIN(count, file->tail - file->head);
+  memcpy(buf, file->buf + file->head, read);
+  file->head += read;
+
+  if (read < count && count - read < file->size)
+    {
+      ret = hostfs_rpmsg_read(fd, file->buf, file->size);
+      if (ret <= 0)
+        {
+          return read ? read : ret;
+        }
+
+      file->stamp = clock_systimer();
+      file->tail  = ret;
+      file->head  = MIN(count - read, file->tail);
+
+      memcpy(buf + read, file->buf, file->head);
+      read += file->head;
+    }
+
+  return read;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -354,6 +803,7 @@ int host_open(FAR const char *pathname, int flags, int mode)
   FAR struct hostfs_rpmsg_open_s *msg;
   uint32_t space;
   size_t len;
+  int ret;
 
   len  = sizeof(*msg);
   len += B2C(strlen(pathname) + 1);
@@ -365,89 +815,165 @@ int host_open(FAR const char *pathname, int flags, int mode)
     }
 
   DEBUGASSERT(len <= space);
+  priv->space = space;
 
   msg->flags = flags;
   msg->mode  = mode;
   cstr2bstr(msg->pathname, pathname);
 
-  return hostfs_rpmsg_send_recv(HOSTFS_RPMSG_OPEN, false,
+  ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_OPEN, false,
           (struct hostfs_rpmsg_header_s *)msg, len, NULL);
+
+  if (flags & (O_CREAT | O_TRUNC))
+    {
+      hostfs_rpmsg_invalidate(priv);
+    }
+
+  return ret;
 }
 
 int host_close(int fd)
 {
+#ifdef HOSTFS_RPMSG_CACHE
+  FAR struct hostfs_rpmsg_s *priv = &g_hostfs_rpmsg;
+#endif
   struct hostfs_rpmsg_close_s msg =
   {
     .fd = fd,
   };
 
+#ifdef HOSTFS_RPMSG_CACHE
+  if (fd >= 0 && fd < CONFIG_NFILE_DESCRIPTORS && priv->files[fd] != NULL)
+    {
+      kmm_free(priv->files[fd]);
+      priv->files[fd] = NULL;
+    }
+#endif
+
   return hostfs_rpmsg_send_recv(HOSTFS_RPMSG_CLOSE, true,
           (struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), NULL);
 }
 
 ssize_t host_read(int fd, FAR void *buf, size_t count)
 {
-  size_t read = 0;
-  int ret = 0;
+  ssize_t read = 0;
+  ssize_t ret;
 
-  while (read < count)
+#ifdef HOSTFS_RPMSG_CACHE
+  read = hostfs_rpmsg_readahead(&g_hostfs_rpmsg, fd, buf, count);
+  if (read < 0 || read == count)
     {
-      struct hostfs_rpmsg_read_s msg =
-      {
-        .fd    = fd,
-        .count = C2B(count - read),
-      };
-
-      ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_READ, true,
-              (FAR struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), buf);
-      if (ret <= 0)
-        {
-          break;
-        }
+      return read;
+    }
+#endif
 
-      read += B2C(ret);
-      buf  += B2C(ret);
+  ret = hostfs_rpmsg_read(fd, (FAR char *)buf + read, count - read);
+  if (ret < 0)
+    {
+      return read ? read : ret;
     }
 
-  return read ? read : ret;
+  return read + ret;
 }
 
 ssize_t host_write(int fd, FAR const void *buf, size_t count)
 {
   FAR struct hostfs_rpmsg_s *priv = &g_hostfs_rpmsg;
+  struct hostfs_rpmsg_cookie_s cookies[CONFIG_FS_HOSTFS_RPMSG_WINDOW];
+  uint32_t sizes[CONFIG_FS_HOSTFS_RPMSG_WINDOW];
   size_t written = 0;
-  int ret = 0;
+  size_t sent = 0;
+  bool partial = false;
+  bool done = false;
+  int ret;
+  int tmp;
+  int n;
+  int i;
 
-  while (written < count)
+  ret = hostfs_rpmsg_unread(priv, fd);
+  if (ret < 0)
     {
-      FAR struct hostfs_rpmsg_write_s *msg;
-      uint32_t space;
+      return ret;
+    }
 
-      msg = rpmsg_get_tx_payload_buffer(&priv->ept, &space, true);
-      if (!msg)
+  /* Keep up to CONFIG_FS_HOSTFS_RPMSG_WINDOW chunks in flight.  The server
+   * writes them in order.  Every chunk but the first of a window continues
+   * the one before it, so once one of them comes back short the server
+   * drops whatever follows it, which is then not reported as written
+   * either.
+   */
+
+  while (!done && sent < count)
+    {
+      for (n = 0; n < CONFIG_FS_HOSTFS_RPMSG_WINDOW && sent < count; n++)
         {
-          ret = -ENOMEM;
-          break;
+          FAR struct hostfs_rpmsg_write_s *msg;
+          uint32_t space;
+
+          msg = rpmsg_get_tx_payload_buffer(&priv->ept, &space, true);
+          if (!msg)
+            {
+              ret  = -ENOMEM;
+              done = true;
+              break;
+            }
+
+          space -= sizeof(*msg);
+          if (space > count - sent)
+            {
+              space = count - sent;
+            }
+
+          msg->fd    = fd;
+          msg->count = C2B(space);
+          msg->flags = n > 0 ? HOSTFS_RPMSG_WRITE_CONT : 0;
+          memcpy(msg->buf, (FAR const char *)buf + sent, space);
+
+          tmp = hostfs_rpmsg_send(HOSTFS_RPMSG_WRITE, false,
+                  (struct hostfs_rpmsg_header_s *)msg, sizeof(*msg) + space,
+                  NULL, &cookies[n]);
+          if (tmp < 0)
+            {
+              ret  = tmp;
+              done = true;
+              break;
+            }
+
+          sizes[n] = space;
+          sent    += space;
         }
 
-      space -= sizeof(*msg);
-      if (space > count - written)
+      for (i = 0; i < n; i++)
         {
-          space = count - written;
+          tmp = hostfs_rpmsg_wait(&cookies[i]);
+          if (partial)
+            {
+              continue;
+            }
+          else if (tmp <= 0)
+            {
+              ret     = tmp;
+              partial = true;
+            }
+          else
+            {
+              written += B2C(tmp);
+              if (B2C(tmp) < sizes[i])
+                {
+                  partial = true;
+                }
+            }
         }
 
-      msg->fd    = fd;
-      msg->count = C2B(space);
-      memcpy(msg->buf, buf + written, space);
-
-      ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_WRITE, false,
-                (struct hostfs_rpmsg_header_s *)msg, sizeof(*msg) + space, NULL);
-      if (ret <= 0)
+      if (partial)
         {
-          break;
+          done = true;
         }
+    }
 
-      written += B2C(ret);
+  if (written > 0)
+    {
+      hostfs_rpmsg_invalidate(priv);
     }
 
   return written ? written : ret;
@@ -455,18 +981,51 @@ ssize_t host_write(int fd, FAR const void *buf, size_t count)
 
 off_t host_lseek(int fd, off_t offset, int whence)
 {
-  struct hostfs_rpmsg_lseek_s msg =
-  {
-    .fd     = fd,
-    .offset = C2B(offset),
-    .whence = whence,
-  };
-
+  struct hostfs_rpmsg_lseek_s msg;
+#ifdef HOSTFS_RPMSG_CACHE
+  FAR struct hostfs_rpmsg_file_s *file;
+  size_t head = 0;
+  size_t tail = 0;
+#endif
   int ret;
 
+#ifdef HOSTFS_RPMSG_CACHE
+  /* Give the read ahead data back.  A relative seek simply accounts for
+   * it, an absolute one makes it irrelevant.
+   */
+
+  file = hostfs_rpmsg_file(&g_hostfs_rpmsg, fd, false);
+  if (file != NULL)
+    {
+      head = file->head;
+      tail = file->tail;
+      file->head = 0;
+      file->tail = 0;
+
+      if (whence == SEEK_CUR)
+        {
+          offset -= tail - head;
+        }
+    }
+#endif
+
+  msg.fd     = fd;
+  msg.offset = C2B(offset);
+  msg.whence = whence;
+
   ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_LSEEK, true,
           (struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), NULL);
 
+#ifdef HOSTFS_RPMSG_CACHE
+  if (ret < 0 && file != NULL)
+    {
+      /* The server position did not move, so the data is still valid */
+
+      file->head = head;
+      file->tail = tail;
+    }
+#endif
+
   return ret < 0 ? ret : B2C(ret);
 }
 
@@ -479,6 +1038,14 @@ int host_ioctl(int fd, int request, unsigned long arg)
     .arg     = arg,
   };
 
+  int ret;
+
+  ret = hostfs_rpmsg_unread(&g_hostfs_rpmsg, fd);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
   return hostfs_rpmsg_send_recv(HOSTFS_RPMSG_IOCTL, true,
           (struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), NULL);
 }
@@ -501,6 +1068,16 @@ int host_dup(int fd)
     .fd = fd,
   };
 
+  int ret;
+
+  /* The new descriptor inherits the file position */
+
+  ret = hostfs_rpmsg_unread(&g_hostfs_rpmsg, fd);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
   return hostfs_rpmsg_send_recv(HOSTFS_RPMSG_DUP, true,
           (struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), NULL);
 }
@@ -524,14 +1101,26 @@ int host_ftruncate(int fd, off_t length)
     .length = length,
   };
 
-  return hostfs_rpmsg_send_recv(HOSTFS_RPMSG_FTRUNCATE, true,
+  int ret;
+
+  ret = hostfs_rpmsg_unread(&g_hostfs_rpmsg, fd);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_FTRUNCATE, true,
           (struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), NULL);
+
+  hostfs_rpmsg_invalidate(&g_hostfs_rpmsg);
+  return ret;
 }
 
 FAR void *host_opendir(FAR const char *name)
 {
   FAR struct hostfs_rpmsg_s *priv = &g_hostfs_rpmsg;
   FAR struct hostfs_rpmsg_opendir_s *msg;
+  FAR struct hostfs_rpmsg_dir_s *dir;
   uint32_t space;
   size_t len;
   int ret;
@@ -546,44 +1135,107 @@ FAR void *host_opendir(FAR const char *name)
     }
 
   DEBUGASSERT(len <= space);
+  priv->space = space;
 
   cstr2bstr(msg->pathname, name);
 
   ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_OPENDIR, false,
           (struct hostfs_rpmsg_header_s *)msg, len, NULL);
+  if (ret < 0)
+    {
+      return NULL;
+    }
+
+  /* The entries of one GETDENTS reply are kept here */
+
+  DEBUGASSERT(space > sizeof(struct hostfs_rpmsg_getdents_s));
+  space -= sizeof(struct hostfs_rpmsg_getdents_s);
+
+  dir = kmm_zalloc(sizeof(*dir) + space);
+  if (dir == NULL)
+    {
+      struct hostfs_rpmsg_closedir_s close =
+      {
+        .fd = ret,
+      };
 
-  return ret < 0 ? NULL : (FAR void *)((uintptr_t)ret);
+      hostfs_rpmsg_send_recv(HOSTFS_RPMSG_CLOSEDIR, true,
+              (struct hostfs_rpmsg_header_s *)&close, sizeof(close), NULL);
+      return NULL;
+    }
+
+  dir->fd   = ret;
+  dir->size = space;
+  return dir;
 }
 
 int host_readdir(FAR void *dirp, FAR struct dirent *entry)
 {
-  struct hostfs_rpmsg_readdir_s msg =
-  {
-    .fd = (uintptr_t)dirp,
-  };
+  FAR struct hostfs_rpmsg_dir_s *dir = dirp;
+  FAR struct hostfs_rpmsg_dirent_s *rec;
+  int ret;
 
-  return hostfs_rpmsg_send_recv(HOSTFS_RPMSG_READDIR, true,
-          (struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), entry);
+  if (dir->head >= dir->tail)
+    {
+      struct hostfs_rpmsg_getdents_s msg =
+      {
+        .fd    = dir->fd,
+        .count = C2B(dir->size),
+      };
+
+      if (dir->eod)
+        {
+          return -ENOENT;
+        }
+
+      ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_GETDENTS, true,
+              (struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), dir);
+      if (ret < 0)
+        {
+          return ret;
+        }
+      else if (ret == 0)
+        {
+          dir->eod = true;
+          return -ENOENT;
+        }
+    }
+
+  rec = (FAR struct hostfs_rpmsg_dirent_s *)&dir->buf[dir->head];
+  dir->head += B2C(rec->reclen);
+
+  nbstr2cstr(entry->d_name, rec->name, NAME_MAX);
+  entry->d_name[NAME_MAX] = '\0';
+  entry->d_type = rec->type;
+  return OK;
 }
 
 void host_rewinddir(FAR void *dirp)
 {
+  FAR struct hostfs_rpmsg_dir_s *dir = dirp;
   struct hostfs_rpmsg_rewinddir_s msg =
   {
-    .fd = (uintptr_t)dirp,
+    .fd = dir->fd,
   };
 
+  dir->head = 0;
+  dir->tail = 0;
+  dir->eod  = false;
+
   hostfs_rpmsg_send_recv(HOSTFS_RPMSG_REWINDDIR, true,
           (struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), NULL);
 }
 
 int host_closedir(FAR void *dirp)
 {
+  FAR struct hostfs_rpmsg_dir_s *dir = dirp;
   struct hostfs_rpmsg_closedir_s msg =
   {
-    .fd = (uintptr_t)dirp,
+    .fd = dir->fd,
   };
 
+  kmm_free(dir);
+
   return hostfs_rpmsg_send_recv(HOSTFS_RPMSG_CLOSEDIR, true,
           (struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), NULL);
 }
@@ -618,6 +1270,7 @@ int host_unlink(FAR const char *pathname)
   struct hostfs_rpmsg_unlink_s *msg;
   uint32_t space;
   size_t len;
+  int ret;
 
   len  = sizeof(*msg);
   len += B2C(strlen(pathname) + 1);
@@ -632,8 +1285,11 @@ int host_unlink(FAR const char *pathname)
 
   cstr2bstr(msg->pathname, pathname);
 
-  return hostfs_rpmsg_send_recv(HOSTFS_RPMSG_UNLINK, false,
+  ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_UNLINK, false,
           (struct hostfs_rpmsg_header_s *)msg, len, NULL);
+
+  hostfs_rpmsg_invalidate(priv);
+  return ret;
 }
 
 int host_mkdir(FAR const char *pathname, mode_t mode)
@@ -642,6 +1298,7 @@ int host_mkdir(FAR const char *pathname, mode_t mode)
   struct hostfs_rpmsg_mkdir_s *msg;
   uint32_t space;
   size_t len;
+  int ret;
 
   len  = sizeof(*msg);
   len += B2C(strlen(pathname) + 1);
@@ -655,8 +1312,11 @@ int host_mkdir(FAR const char *pathname, mode_t mode)
   msg->mode = mode;
   cstr2bstr(msg->pathname, pathname);
 
-  return hostfs_rpmsg_send_recv(HOSTFS_RPMSG_MKDIR, false,
+  ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_MKDIR, false,
           (struct hostfs_rpmsg_header_s *)msg, len, NULL);
+
+  hostfs_rpmsg_invalidate(priv);
+  return ret;
 }
 
 int host_rmdir(FAR const char *pathname)
@@ -665,6 +1325,7 @@ int host_rmdir(FAR const char *pathname)
   struct hostfs_rpmsg_rmdir_s *msg;
   uint32_t space;
   size_t len;
+  int ret;
 
   len  = sizeof(*msg);
   len += B2C(strlen(pathname) + 1);
@@ -679,8 +1340,11 @@ int host_rmdir(FAR const char *pathname)
 
   cstr2bstr(msg->pathname, pathname);
 
-  return hostfs_rpmsg_send_recv(HOSTFS_RPMSG_RMDIR, false,
+  ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_RMDIR, false,
           (struct hostfs_rpmsg_header_s *)msg, len, NULL);
+
+  hostfs_rpmsg_invalidate(priv);
+  return ret;
 }
 
 int host_rename(FAR const char *oldpath, FAR const char *newpath)
@@ -690,6 +1354,7 @@ int host_rename(FAR const char *oldpath, FAR const char *newpath)
   size_t len;
   size_t oldlen;
   uint32_t space;
+  int ret;
 
   len     = sizeof(*msg);
   oldlen  = B2C((strlen(oldpath) + 1 + 0x7) & ~0x7);
@@ -706,16 +1371,52 @@ int host_rename(FAR const char *oldpath, FAR const char *newpath)
   cstr2bstr(msg->pathname, oldpath);
   cstr2bstr(msg->pathname + oldlen, newpath);
 
-  return hostfs_rpmsg_send_recv(HOSTFS_RPMSG_RENAME, false,
+  ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_RENAME, false,
           (struct hostfs_rpmsg_header_s *)msg, len, NULL);
+
+  hostfs_rpmsg_invalidate(priv);
+  return ret;
 }
 
 int host_stat(FAR const char *path, FAR struct stat *buf)
 {
   FAR struct hostfs_rpmsg_s *priv = &g_hostfs_rpmsg;
   FAR struct hostfs_rpmsg_stat_s *msg;
+#ifdef HOSTFS_RPMSG_CACHE
+  FAR struct hostfs_rpmsg_attr_s *attr;
+  FAR char *copy;
+  uint32_t generation;
+  uint32_t hash;
+  clock_t now;
+  int i;
+#endif
   uint32_t space;
   size_t len;
+  int ret;
+
+#ifdef HOSTFS_RPMSG_CACHE
+  /* Reuse an answer received within the lease time */
+
+  hash = hostfs_rpmsg_hash(path);
+  now  = clock_systimer();
+
+  nxsem_wait_uninterruptible(&priv->lock);
+  for (i = 0; i < CONFIG_FS_HOSTFS_RPMSG_ATTR_NENTRIES; i++)
+    {
+      attr = &priv->attrs[i];
+      if (attr->path != NULL && attr->hash == hash &&
+          now - attr->stamp < HOSTFS_RPMSG_LEASE &&
+          strcmp(attr->path, path) == 0)
+        {
+          memcpy(buf, &attr->buf, sizeof(*buf));
+          nxsem_post(&priv->lock);
+          return OK;
+        }
+    }
+
+  generation = priv->generation;
+  nxsem_post(&priv->lock);
+#endif
 
   len  = sizeof(*msg);
   len += B2C(strlen(path) + 1);
@@ -730,8 +1431,52 @@ int host_stat(FAR const char *path, FAR struct stat *buf)
 
   cstr2bstr(msg->pathname, path);
 
-  return hostfs_rpmsg_send_recv(HOSTFS_RPMSG_STAT, false,
+  ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_STAT, false,
           (struct hostfs_rpmsg_header_s *)msg, len, buf);
+
+#ifdef HOSTFS_RPMSG_CACHE
+  if (ret >= 0)
+    {
+      copy = kmm_malloc(strlen(path) + 1);
+      if (copy == NULL)
+        {
+          return ret;
+        }
+
+      strcpy(copy, path);
+
+      /* Nothing may have changed on the server while the request was in
+       * flight, otherwise the answer could already be stale.
+       */
+
+      nxsem_wait_uninterruptible(&priv->lock);
+      if (generation != priv->generation)
+        {
+          nxsem_post(&priv->lock);
+          kmm_free(copy);
+          return ret;
+        }
+
+      attr = &priv->attrs[priv->attrnext];
+      if (++priv->attrnext >= CONFIG_FS_HOSTFS_RPMSG_ATTR_NENTRIES)
+        {
+          priv->attrnext = 0;
+        }
+
+      if (attr->path != NULL)
+        {
+          kmm_free(attr->path);
+        }
+
+      attr->path  = copy;
+      attr->hash  = hash;
+      attr->stamp = clock_systimer();
+      memcpy(&attr->buf, buf, sizeof(*buf));
+      nxsem_post(&priv->lock);
+    }
+#endif
+
+  return ret;
 }
 
 int hostfs_rpmsg_init(FAR const char *cpuname)
@@ -739,6 +1484,9 @@ int hostfs_rpmsg_init(FAR const char *cpuname)
   struct hostfs_rpmsg_s *priv = &g_hostfs_rpmsg;
 
   priv->cpuname = cpuname;
+#ifdef HOSTFS_RPMSG_CACHE
+  nxsem_init(&priv->lock, 0, 1);
+#endif
 
   return rpmsg_register_callback(priv,
                                  hostfs_rpmsg_device_created,
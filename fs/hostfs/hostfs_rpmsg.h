@@ -74,6 +74,7 @@
 #define HOSTFS_RPMSG_RMDIR          18
 #define HOSTFS_RPMSG_RENAME         19
 #define HOSTFS_RPMSG_STAT           20
+#define HOSTFS_RPMSG_GETDENTS       21
 
 /****************************************************************************
  * Public Types
@@ -108,7 +109,23 @@ begin_packed_struct struct hostfs_rpmsg_read_s
   char                         buf[0];
 } end_packed_struct;
 
-#define hostfs_rpmsg_write_s hostfs_rpmsg_read_s
+/* A write that continues the one sent before it, without waiting for its
+ * result, carries HOSTFS_RPMSG_WRITE_CONT.  The server drops it if that
+ * write came back short or failed, so that the file never holds data past
+ * a gap that the client does not count as written.
+ */
+
+#define HOSTFS_RPMSG_WRITE_CONT   0x01
+
+begin_packed_struct struct hostfs_rpmsg_write_s
+{
+  struct hostfs_rpmsg_header_s header;
+  int32_t                      fd;
+  uint32_t                     count;
+  uint32_t                     flags;
+  uint32_t                     reserved;
+  char                         buf[0];
+} end_packed_struct;
 
 begin_packed_struct struct hostfs_rpmsg_lseek_s
 {
@@ -158,6 +175,26 @@ begin_packed_struct struct hostfs_rpmsg_readdir_s
   char                         name[0];
 } end_packed_struct;
 
+/* GETDENTS returns as many entries as fit in one message.  The result is
+ * the number of hostfs_rpmsg_dirent_s records packed into buf, zero at the
+ * end of the directory.
+ */
+
+begin_packed_struct struct hostfs_rpmsg_dirent_s
+{
+  uint32_t                     reclen;
+  uint32_t                     type;
+  char                         name[0];
+} end_packed_struct;
+
+begin_packed_struct struct hostfs_rpmsg_getdents_s
+{
+  struct hostfs_rpmsg_header_s header;
+  int32_t                      fd;
+  uint32_t                     count;
+  char                         buf[0];
+} end_packed_struct;
+
 #define hostfs_rpmsg_rewinddir_s hostfs_rpmsg_close_s
 #define hostfs_rpmsg_closedir_s hostfs_rpmsg_close_s
 
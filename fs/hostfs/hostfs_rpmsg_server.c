@@ -41,6 +41,7 @@
 #include <nuttx/config.h>
 
 #include <dirent.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 #include <fcntl.h>
@@ -62,6 +63,8 @@ struct hostfs_rpmsg_server_s
   struct rpmsg_endpoint ept;
   struct file           files[CONFIG_NFILE_DESCRIPTORS];
   void                  *dirs[CONFIG_NFILE_DESCRIPTORS];
+  struct dirent         *pending[CONFIG_NFILE_DESCRIPTORS];
+  bool                  wgap[CONFIG_NFILE_DESCRIPTORS];
   sem_t                 sem;
 };
 
@@ -105,6 +108,9 @@ static int hostfs_rpmsg_opendir_handler(FAR struct rpmsg_endpoint *ept,
 static int hostfs_rpmsg_readdir_handler(FAR struct rpmsg_endpoint *ept,
                                         FAR void *data, size_t len,
                                         uint32_t src, FAR void *priv_);
+static int hostfs_rpmsg_getdents_handler(FAR struct rpmsg_endpoint *ept,
+                                         FAR void *data, size_t len,
+                                         uint32_t src, FAR void *priv_);
 static int hostfs_rpmsg_rewinddir_handler(FAR struct rpmsg_endpoint *ept,
                                           FAR void *data, size_t len,
                                           uint32_t src, FAR void *priv_);
@@ -164,6 +170,7 @@ static const rpmsg_ept_cb g_hostfs_rpmsg_handler[] =
   [HOSTFS_RPMSG_RMDIR]     = hostfs_rpmsg_rmdir_handler,
   [HOSTFS_RPMSG_RENAME]    = hostfs_rpmsg_rename_handler,
   [HOSTFS_RPMSG_STAT]      = hostfs_rpmsg_stat_handler,
+  [HOSTFS_RPMSG_GETDENTS]  = hostfs_rpmsg_getdents_handler,
 };
 
 /****************************************************************************
@@ -263,7 +270,21 @@ static int hostfs_rpmsg_write_handler(FAR struct rpmsg_endpoint *ept,
 
   if (msg->fd >= 0 && msg->fd < CONFIG_NFILE_DESCRIPTORS)
     {
-      ret = file_write(&priv->files[msg->fd], msg->buf, msg->count);
+      /* Drop a write that continues one that came back short or failed.
+       * The client does not count either as written and will send them
+       * again.
+       */
+
+      if ((msg->flags & HOSTFS_RPMSG_WRITE_CONT) != 0 &&
+          priv->wgap[msg->fd])
+        {
+          ret = 0;
+        }
+      else
+        {
+          ret = file_write(&priv->files[msg->fd], msg->buf, msg->count);
+          priv->wgap[msg->fd] = ret < 0 || (uint32_t)ret < msg->count;
+        }
     }
 
   msg->header.result = ret;
@@ -435,7 +456,13 @@ static int hostfs_rpmsg_readdir_handler(FAR struct rpmsg_endpoint *ept,
 
   if (msg->fd >= 1 && msg->fd < CONFIG_NFILE_DESCRIPTORS)
     {
-      entry = readdir(priv->dirs[msg->fd]);
+      entry = priv->pending[msg->fd];
+      if (entry == NULL)
+        {
+          entry = readdir(priv->dirs[msg->fd]);
+        }
+
+      priv->pending[msg->fd] = NULL;
       if (entry)
         {
           msg->type = entry->d_type;
@@ -449,6 +476,74 @@ static int hostfs_rpmsg_readdir_handler(FAR struct rpmsg_endpoint *ept,
   return rpmsg_send(ept, msg, len);
 }
 
+static int hostfs_rpmsg_getdents_handler(FAR struct rpmsg_endpoint *ept,
+                                         FAR void *data, size_t len,
+                                         uint32_t src, FAR void *priv_)
+{
+  FAR struct hostfs_rpmsg_server_s *priv = priv_;
+  FAR struct hostfs_rpmsg_getdents_s *msg = data;
+  FAR struct hostfs_rpmsg_getdents_s *rsp;
+  FAR struct hostfs_rpmsg_dirent_s *rec;
+  FAR struct dirent *entry;
+  size_t reclen;
+  size_t used = 0;
+  uint32_t space;
+  int ret = -ENOENT;
+
+  rsp = rpmsg_get_tx_payload_buffer(ept, &space, true);
+  if (!rsp)
+    {
+      return -ENOMEM;
+    }
+
+  *rsp = *msg;
+
+  space -= sizeof(*msg);
+  if (space > msg->count)
+    {
+      space = msg->count;
+    }
+
+  if (msg->fd >= 1 && msg->fd < CONFIG_NFILE_DESCRIPTORS)
+    {
+      /* Pack entries until the next one does not fit.  That one is kept
+       * for the next request; readdir() leaves it valid until it is called
+       * again.
+       */
+
+      for (ret = 0; ; ret++)
+        {
+          entry = priv->pending[msg->fd];
+          if (entry == NULL)
+            {
+              entry = readdir(priv->dirs[msg->fd]);
+              if (entry == NULL)
+                {
+                  break;
+                }
+            }
+
+          reclen = (sizeof(*rec) + strlen(entry->d_name) + 1 + 0x3) & ~0x3;
+          if (used + reclen > space)
+            {
+              priv->pending[msg->fd] = entry;
+              break;
+            }
+
+          priv->pending[msg->fd] = NULL;
+
+          rec = (FAR struct hostfs_rpmsg_dirent_s *)(rsp->buf + used);
+          rec->reclen = reclen;
+          rec->type   = entry->d_type;
+          strcpy(rec->name, entry->d_name);
+          used       += reclen;
+        }
+    }
+
+  rsp->header.result = ret;
+  return rpmsg_send_nocopy(ept, rsp, sizeof(*rsp) + used);
+}
+
 static int hostfs_rpmsg_rewinddir_handler(FAR struct rpmsg_endpoint *ept,
                                           FAR void *data, size_t len,
                                           uint32_t src, FAR void *priv_)
@@ -460,6 +555,7 @@ static int hostfs_rpmsg_rewinddir_handler(FAR struct rpmsg_endpoint *ept,
   if (msg->fd >= 1 && msg->fd < CONFIG_NFILE_DESCRIPTORS)
     {
       rewinddir(priv->dirs[msg->fd]);
+      priv->pending[msg->fd] = NULL;
       ret = 0;
     }
 
@@ -480,6 +576,7 @@ static int hostfs_rpmsg_closedir_handler(FAR struct rpmsg_endpoint *ept,
       ret = closedir(priv->dirs[msg->fd]);
       nxsem_wait(&priv->sem);
       priv->dirs[msg->fd] = NULL;
+      priv->pending[msg->fd] = NULL;
       nxsem_post(&priv->sem);
       ret = ret ? get_errno(ret) : 0;
     }
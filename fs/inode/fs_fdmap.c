@@ -0,0 +1,95 @@
+/****************************************************************************
+ * fs/inode/fs_fdmap.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <strings.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fdmap_alloc
+ *
+ * Description:
+ *   Find the lowest clear bit >= 'minbit' in a descriptor allocation bitmap
+ *   of 'nbits' bits, set it, and return its index.  The caller must hold
+ *   the semaphore of the list that owns the bitmap.
+ *
+ * Returned Value:
+ *   The index of the newly allocated bit on success; -EMFILE if every bit
+ *   from 'minbit' up is already set.
+ *
+ ****************************************************************************/
+
+int fdmap_alloc(FAR uint32_t *map, int nbits, int minbit)
+{
+  uint32_t avail;
+  int word;
+  int bit;
+
+  DEBUGASSERT(map != NULL);
+
+  if (minbit < 0)
+    {
+      minbit = 0;
+    }
+
+  for (word = minbit >> 5; (word << 5) < nbits; word++)
+    {
+      /* Free slots are the clear bits.  In the first word, ignore the
+       * slots below 'minbit'.
+       */
+
+      avail = ~map[word];
+      if (word == (minbit >> 5))
+        {
+          avail &= ~(FDMAP_BIT(minbit) - 1);
+        }
+
+      if (avail != 0)
+        {
+          /* The padding bits of the final word are never set, so make
+           * sure that the lowest free bit really is a valid slot.
+           */
+
+          bit = (word << 5) + ffs((int)avail) - 1;
+          if (bit >= nbits)
+            {
+              break;
+            }
+
+          map[word] |= FDMAP_BIT(bit);
+          return bit;
+        }
+    }
+
+  return -EMFILE;
+}
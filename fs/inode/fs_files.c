@@ -55,6 +55,38 @@ static int _files_semtake(FAR struct filelist *list)
 
 #define _files_semgive(list) nxsem_post(&list->fl_sem)
 
+/****************************************************************************
+ * Name: _files_sync
+ *
+ * Description:
+ *   Bring the allocation bitmap bit of 'filep' in line with its state.
+ *   Nothing is done if 'filep' does not belong to 'list' (as when dup'ing
+ *   into the file list of a new task).
+ *
+ * Assumptions:
+ *   Caller holds the list semaphore.
+ *
+ ****************************************************************************/
+
+static void _files_sync(FAR struct filelist *list, FAR struct file *filep)
+{
+  int fd;
+
+  if (list != NULL && filep >= list->fl_files &&
+      filep < &list->fl_files[CONFIG_NFILE_DESCRIPTORS])
+    {
+      fd = filep - list->fl_files;
+      if (filep->f_inode != NULL)
+        {
+          FDMAP_SET(list->fl_inuse, fd);
+        }
+      else
+        {
+          FDMAP_CLR(list->fl_inuse, fd);
+        }
+    }
+}
+
 /****************************************************************************
  * Name: _files_close
  *
@@ -129,6 +161,10 @@ void files_initlist(FAR struct filelist *list)
   /* Initialize the list access mutex */
 
   nxsem_init(&list->fl_sem, 0, 1);
+
+  /* No descriptors are allocated yet */
+
+  memset(list->fl_inuse, 0, sizeof(list->fl_inuse));
 }
 
 /****************************************************************************
@@ -213,6 +249,7 @@ int file_dup2(FAR struct file *filep1, FAR struct file *filep2)
    */
 
   ret = _files_close(filep2);
+  _files_sync(list, filep2);
   if (ret < 0)
     {
       /* An error occurred while closing the driver */
@@ -266,6 +303,7 @@ int file_dup2(FAR struct file *filep1, FAR struct file *filep2)
 
   if (list != NULL)
     {
+      _files_sync(list, filep2);
       _files_semgive(list);
     }
 
@@ -301,37 +339,40 @@ errout_with_sem:
 int files_allocate(FAR struct inode *inode, int oflags, off_t pos, int minfd)
 {
   FAR struct filelist *list;
-  int ret;
-  int i;
+  int fd;
 
   /* Get the file descriptor list.  It should not be NULL in this context. */
 
   list = sched_getfiles();
   DEBUGASSERT(list != NULL);
 
-  ret = _files_semtake(list);
-  if (ret < 0)
+  fd = _files_semtake(list);
+  if (fd < 0)
     {
       /* Probably canceled */
 
-      return ret;
+      return fd;
     }
 
-  for (i = minfd; i < CONFIG_NFILE_DESCRIPTORS; i++)
+  /* Claim the lowest free descriptor >= minfd from the allocation bitmap
+   * rather than probing each struct file in turn.
+   */
+
+  fd = fdmap_alloc(list->fl_inuse, CONFIG_NFILE_DESCRIPTORS, minfd);
+  if (fd < 0)
     {
-      if (!list->fl_files[i].f_inode)
-        {
-          list->fl_files[i].f_oflags = oflags;
-          list->fl_files[i].f_pos    = pos;
-          list->fl_files[i].f_inode  = inode;
-          list->fl_files[i].f_priv   = NULL;
-          _files_semgive(list);
-          return i;
-        }
+      _files_semgive(list);
+      return ERROR;
     }
 
+  DEBUGASSERT(list->fl_files[fd].f_inode == NULL);
+
+  list->fl_files[fd].f_oflags = oflags;
+  list->fl_files[fd].f_pos    = pos;
+  list->fl_files[fd].f_inode  = inode;
+  list->fl_files[fd].f_priv   = NULL;
   _files_semgive(list);
-  return ERROR;
+  return fd;
 }
 
 /****************************************************************************
@@ -372,6 +413,7 @@ int files_close(int fd)
   if (ret >= 0)
     {
       ret = _files_close(&list->fl_files[fd]);
+      _files_sync(list, &list->fl_files[fd]);
       _files_semgive(list);
     }
 
@@ -403,6 +445,7 @@ void files_release(int fd)
           list->fl_files[fd].f_oflags  = 0;
           list->fl_files[fd].f_pos     = 0;
           list->fl_files[fd].f_inode = NULL;
+          FDMAP_CLR(list->fl_inuse, fd);
           _files_semgive(list);
         }
     }
@@ -29,40 +29,24 @@
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
-#include <nuttx/semaphore.h>
+#include <nuttx/rwsem.h>
 
 #include "inode/inode.h"
 
 /****************************************************************************
- * Pre-processor Definitions
- ****************************************************************************/
-
-#define NO_HOLDER ((pid_t)-1)
-
-/****************************************************************************
- * Private Types
+ * Private Data
  ****************************************************************************/
 
-/* Implements a re-entrant mutex for inode access.  This must be re-entrant
- * because there can be cycles.  For example, it may be necessary to destroy
- * a block driver inode on umount() after a removable block device has been
- * removed.  In that case umount() holds the inode semaphore, but the block
+/* Protects the in-memory inode tree.  Lookups share it; changes to the
+ * tree take it exclusively.  The exclusive lock must be re-entrant because
+ * there can be cycles.  For example, it may be necessary to destroy a
+ * block driver inode on umount() after a removable block device has been
+ * removed.  In that case umount() holds the inode lock, but the block
  * driver may callback to unregister_blockdriver() after the un-mount,
- * requiring the semaphore again.
+ * requiring the lock again.
  */
 
-struct inode_sem_s
-{
-  sem_t   sem;     /* The semaphore */
-  pid_t   holder;  /* The current holder of the semaphore */
-  int16_t count;   /* Number of counts held */
-};
-
-/****************************************************************************
- * Private Data
- ****************************************************************************/
-
-static struct inode_sem_s g_inode_sem;
+static rw_semaphore_t g_inode_lock;
 
 /****************************************************************************
  * Public Functions
@@ -79,13 +63,7 @@ static struct inode_sem_s g_inode_sem;
 
 void inode_initialize(void)
 {
-  /* Initialize the semaphore to one (to support one-at-a-time access to the
-   * inode tree).
-   */
-
-  nxsem_init(&g_inode_sem.sem, 0, 1);
-  g_inode_sem.holder = NO_HOLDER;
-  g_inode_sem.count  = 0;
+  init_rwsem(&g_inode_lock);
 
   /* Initialize files array (if it is used) */
 
@@ -101,70 +79,51 @@ void inode_initialize(void)
  * Name: inode_semtake
  *
  * Description:
- *   Get exclusive access to the in-memory inode tree (g_inode_sem).
+ *   Get exclusive access to the in-memory inode tree (g_inode_lock).
  *
  ****************************************************************************/
 
 int inode_semtake(void)
 {
-  pid_t me;
-  int ret = OK;
-
-  /* Do we already hold the semaphore? */
-
-  me = getpid();
-  if (me == g_inode_sem.holder)
-    {
-      /* Yes... just increment the count */
-
-      g_inode_sem.count++;
-      DEBUGASSERT(g_inode_sem.count > 0);
-    }
-
-  /* Take the semaphore (perhaps waiting) */
-
-  else
-    {
-      ret = nxsem_wait_uninterruptible(&g_inode_sem.sem);
-      if (ret >= 0)
-        {
-          /* No we hold the semaphore */
-
-          g_inode_sem.holder = me;
-          g_inode_sem.count  = 1;
-        }
-    }
-
-  return ret;
+  return down_write(&g_inode_lock);
 }
 
 /****************************************************************************
  * Name: inode_semgive
  *
  * Description:
- *   Relinquish exclusive access to the in-memory inode tree (g_inode_sem).
+ *   Relinquish exclusive access to the in-memory inode tree (g_inode_lock).
  *
  ****************************************************************************/
 
 void inode_semgive(void)
 {
-  DEBUGASSERT(g_inode_sem.holder == getpid());
-
-  /* Is this our last count on the semaphore? */
+  up_write(&g_inode_lock);
+}
 
-  if (g_inode_sem.count > 1)
-    {
-      /* No.. just decrement the count */
+/****************************************************************************
+ * Name: inode_rlock
+ *
+ * Description:
+ *   Get shared access to the in-memory inode tree (g_inode_lock), to look
+ *   it up without changing it.
+ *
+ ****************************************************************************/
 
-      g_inode_sem.count--;
-    }
+int inode_rlock(void)
+{
+  return down_read(&g_inode_lock);
+}
 
-  /* Yes.. then we can really release the semaphore */
+/****************************************************************************
+ * Name: inode_runlock
+ *
+ * Description:
+ *   Relinquish shared access to the in-memory inode tree (g_inode_lock).
+ *
+ ****************************************************************************/
 
-  else
-    {
-      g_inode_sem.holder = NO_HOLDER;
-      g_inode_sem.count  = 0;
-      nxsem_post(&g_inode_sem.sem);
-    }
+void inode_runlock(void)
+{
+  up_read(&g_inode_lock);
 }
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <errno.h>
+#include <nuttx/irq.h>
 #include <nuttx/fs/fs.h>
 #include "inode/inode.h"
 
@@ -43,15 +44,18 @@
 
 int inode_addref(FAR struct inode *inode)
 {
+  irqstate_t flags;
   int ret = OK;
 
   if (inode)
     {
-      ret = inode_semtake();
+      ret = inode_rlock();
       if (ret >= 0)
         {
+          flags = spin_lock_irqsave();
           inode->i_crefs++;
-          inode_semgive();
+          spin_unlock_irqrestore(flags);
+          inode_runlock();
         }
     }
 
@@ -27,6 +27,7 @@
 #include <assert.h>
 #include <errno.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/fs/fs.h>
 
 #include "inode/inode.h"
@@ -45,17 +46,21 @@
  *   difference between inode_find() and inode_search is that inode_find()
  *   will lock the inode tree and increment the reference count on the inode.
  *
+ *   Lookups only share the inode tree, so that concurrent open() calls do
+ *   not serialize.  The reference count is then changed under the spinlock.
+ *
  ****************************************************************************/
 
 int inode_find(FAR struct inode_search_s *desc)
 {
+  irqstate_t flags;
   int ret;
 
   /* Find the node matching the path.  If found, increment the count of
    * references on the node.
    */
 
-  ret = inode_semtake();
+  ret = inode_rlock();
   if (ret < 0)
     {
       return ret;
@@ -71,9 +76,11 @@ int inode_find(FAR struct inode_search_s *desc)
 
       /* Increment the reference count on the inode */
 
+      flags = spin_lock_irqsave();
       node->i_crefs++;
+      spin_unlock_irqrestore(flags);
     }
 
-  inode_semgive();
+  inode_runlock();
   return ret;
 }
@@ -27,6 +27,7 @@
 #include <debug.h>
 #include <errno.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 
@@ -46,15 +47,20 @@
 
 void inode_release(FAR struct inode *node)
 {
+  irqstate_t flags;
+  int16_t crefs;
   int ret;
 
   if (node)
     {
-      /* Decrement the references of the inode */
+      /* Decrement the references of the inode.  Unlinking the inode needs
+       * the exclusive lock, so sharing it is enough to keep the inode from
+       * being unlinked meanwhile.
+       */
 
       do
         {
-          ret = inode_semtake();
+          ret = inode_rlock();
 
           /* This only possible error is due to cancellation of the thread.
            * We need to try again anyway in this case, otherwise the
@@ -65,30 +71,34 @@ void inode_release(FAR struct inode *node)
         }
       while (ret < 0);
 
+      flags = spin_lock_irqsave();
       if (node->i_crefs)
         {
           node->i_crefs--;
         }
 
+      crefs = node->i_crefs;
+      spin_unlock_irqrestore(flags);
+
       /* If the subtree was previously deleted and the reference
        * count has decrement to zero,  then delete the inode
-       * now.
+       * now.  Only the thread that dropped the last reference sees zero.
        */
 
-      if (node->i_crefs <= 0 && (node->i_flags & FSNODEFLAG_DELETED) != 0)
+      if (crefs <= 0 && (node->i_flags & FSNODEFLAG_DELETED) != 0)
         {
           /* If the inode has been properly unlinked, then the peer pointer
            * should be NULL.
            */
 
-          inode_semgive();
+          inode_runlock();
 
           DEBUGASSERT(node->i_peer == NULL);
           inode_free(node);
         }
       else
         {
-          inode_semgive();
+          inode_runlock();
         }
     }
 }
@@ -170,7 +170,7 @@ void inode_initialize(void);
  * Name: inode_semtake
  *
  * Description:
- *   Get exclusive access to the in-memory inode tree (tree_sem).
+ *   Get exclusive access to the in-memory inode tree.
  *
  ****************************************************************************/
 
@@ -180,12 +180,35 @@ int inode_semtake(void);
  * Name: inode_semgive
  *
  * Description:
- *   Relinquish exclusive access to the in-memory inode tree (tree_sem).
+ *   Relinquish exclusive access to the in-memory inode tree.
  *
  ****************************************************************************/
 
 void inode_semgive(void);
 
+/****************************************************************************
+ * Name: inode_rlock
+ *
+ * Description:
+ *   Get shared access to the in-memory inode tree, to look it up without
+ *   changing it.  i_crefs may still be changed under the shared lock, but
+ *   only with the spinlock held (see inode_find()).  The exclusive lock may
+ *   not be taken while the shared lock is held.
+ *
+ ****************************************************************************/
+
+int inode_rlock(void);
+
+/****************************************************************************
+ * Name: inode_runlock
+ *
+ * Description:
+ *   Relinquish shared access to the in-memory inode tree.
+ *
+ ****************************************************************************/
+
+void inode_runlock(void);
+
 /****************************************************************************
  * Name: inode_search
  *
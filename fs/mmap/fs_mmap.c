@@ -76,7 +76,7 @@
  *
  *   2. If CONFIG_FS_RAMMAP is defined in the configuration, then mmap() will
  *      support simulation of memory mapped files by copying files whole
- *      into RAM.
+ *      into RAM.  MAP_SHARED mappings of the same file share one copy.
  *
  * Input Parameters:
  *   start   A hint at where to map the memory -- ignored.  The address
@@ -207,7 +207,7 @@ FAR void *mmap(FAR void *start, size_t length, int prot, int flags,
        * do much better in the KERNEL build using the MMU.
        */
 
-      return rammap(fd, length, offset);
+      return rammap(fd, length, offset, flags);
 #else
       /* Error out.  The errno value was already set by ioctl() */
 
@@ -0,0 +1,111 @@
+/****************************************************************************
+ * fs/mmap/fs_msync.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/mman.h>
+
+#include <stdint.h>
+#include <errno.h>
+#include <debug.h>
+
+#include "fs_rammap.h"
+
+#ifdef CONFIG_FS_RAMMAP
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: msync
+ *
+ * Description:
+ *   Write the changes made to a MAP_SHARED mapping of a file opened for
+ *   writing back to the file.  All tasks mapping the same part of a file
+ *   share a single copy of it, so MS_INVALIDATE has nothing to do and
+ *   MS_ASYNC is treated like MS_SYNC.
+ *
+ *   Addresses outside of any RAM copied region (for example, files mapped
+ *   in place with FIOC_MMAP) are read-only and need no synchronization.
+ *
+ * Input Parameters:
+ *   addr  - Start of the range to synchronize
+ *   len   - Number of bytes to synchronize
+ *   flags - MS_ASYNC or MS_SYNC, optionally with MS_INVALIDATE
+ *
+ * Returned Value:
+ *   On success, msync() returns 0, on failure -1, and errno is set.
+ *
+ *     EINVAL
+ *       Both or neither of MS_ASYNC and MS_SYNC is given.
+ *     Any error reported by the file system while writing back.
+ *
+ ****************************************************************************/
+
+int msync(FAR void *addr, size_t len, int flags)
+{
+  FAR struct fs_rammap_s *map;
+  int errcode;
+  int ret;
+
+  if (((flags & MS_ASYNC) != 0) == ((flags & MS_SYNC) != 0))
+    {
+      errcode = EINVAL;
+      goto errout;
+    }
+
+  rammap_initialize();
+  ret = nxsem_wait(&g_rammaps.exclsem);
+  if (ret < 0)
+    {
+      errcode = -ret;
+      goto errout;
+    }
+
+  map = rammap_find(addr, NULL);
+  if (map != NULL)
+    {
+      ret = rammap_writeback(map, (uintptr_t)addr - (uintptr_t)map->addr,
+                             len);
+    }
+
+  nxsem_post(&g_rammaps.exclsem);
+
+  if (ret < 0)
+    {
+      ferr("ERROR: Write back failed: %d\n", ret);
+      errcode = -ret;
+      goto errout;
+    }
+
+  return OK;
+
+errout:
+  set_errno(errcode);
+  return ERROR;
+}
+
+#endif /* CONFIG_FS_RAMMAP */
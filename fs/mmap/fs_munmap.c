@@ -47,6 +47,7 @@
 #include <assert.h>
 #include <debug.h>
 
+#include <nuttx/sched.h>
 #include <nuttx/kmalloc.h>
 
 #include "inode/inode.h"
@@ -92,8 +93,9 @@
  *
  *   2. If CONFIG_FS_RAMMAP is defined in the configuration, then mmap() will
  *      support simulation of memory mapped files by copying files whole
- *      into RAM.  munmap() is required in this case to free the allocated
- *      memory holding the shared copy of the file.
+ *      into RAM.  munmap() is required in this case to drop the reference
+ *      to the shared copy of the file.  The copy is written back (for
+ *      writable MAP_SHARED mappings) and freed with the last reference.
  *
  * Input Parameters:
  *   start   The start address of the mapping to delete.  For this
@@ -110,7 +112,6 @@
 
 int munmap(FAR void *start, size_t length)
 {
-  FAR struct fs_rammap_s *prev;
   FAR struct fs_rammap_s *curr;
   FAR void *newaddr;
   unsigned int offset;
@@ -123,22 +124,13 @@ int munmap(FAR void *start, size_t length)
   ret = nxsem_wait(&g_rammaps.exclsem);
   if (ret < 0)
     {
-      errcode = ret;
+      errcode = -ret;
       goto errout;
     }
 
   /* Search the list of regions */
 
-  for (prev = NULL, curr = g_rammaps.head; curr; prev = curr, curr = curr->flink)
-    {
-      /* Does this region include any part of the specified range? */
-
-      if ((uintptr_t)start < (uintptr_t)curr->addr + curr->length &&
-          (uintptr_t)start + length >= (uintptr_t)curr->addr)
-        {
-          break;
-        }
-    }
+  curr = rammap_find(start, NULL);
 
   /* Did we find the region */
 
@@ -156,7 +148,7 @@ int munmap(FAR void *start, size_t length)
    * simulate the unmapping.
    */
 
-  offset = start - curr->addr;
+  offset = (uintptr_t)start - (uintptr_t)curr->addr;
   if (offset + length < curr->length)
     {
       ferr("ERROR: Cannot umap without unmapping to the end\n");
@@ -164,42 +156,41 @@ int munmap(FAR void *start, size_t length)
       goto errout_with_semaphore;
     }
 
-  /* Okay.. the region is beging umapped to the end.  Make sure the length
-   * indicates that.
-   */
-
-  length = curr->length - offset;
-
   /* Are we unmapping the entire region (offset == 0)? */
 
-  if (length >= curr->length)
+  if (offset == 0)
     {
-      /* Yes.. remove the mapping from the list */
+      /* Yes.. drop our reference.  The region is written back and freed
+       * when this was the last one.
+       */
 
-      if (prev)
+      ret = rammap_unref(curr, sched_self()->group);
+      if (ret < 0)
         {
-          prev->flink = curr->flink;
+          errcode = -ret;
+          goto errout_with_semaphore;
         }
-      else
-        {
-          g_rammaps.head = curr->flink;
-        }
-
-      /* Then free the region */
-
-      kumm_free(curr);
     }
 
   /* No.. We have been asked to "unmap' only a portion of the memory
-   * (offset > 0).
+   * (offset > 0).  The tail cannot be taken away from other users of a
+   * shared region, so it is only released when we are the only one.
    */
 
-  else
+  else if (curr->nrefs == 1)
     {
-      newaddr = kumm_realloc(curr->addr, sizeof(struct fs_rammap_s) + length);
+      ret = rammap_writeback(curr, offset, curr->length - offset);
+
+      newaddr = kumm_realloc(curr->addr, offset);
       DEBUGASSERT(newaddr == (FAR void *)(curr->addr));
       UNUSED(newaddr); /* May not be used */
-      curr->length = length;
+      curr->length = offset;
+
+      if (ret < 0)
+        {
+          errcode = -ret;
+          goto errout_with_semaphore;
+        }
     }
 
   nxsem_post(&g_rammaps.exclsem);
@@ -44,9 +44,12 @@
 
 #include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <errno.h>
+#include <assert.h>
 #include <debug.h>
 
+#include <nuttx/sched.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
 
@@ -63,6 +66,289 @@
 
 struct fs_allmaps_s g_rammaps;
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rammap_group
+ *
+ * Description:
+ *   Return the task group that is charged for mappings made now.
+ *
+ ****************************************************************************/
+
+static inline FAR struct task_group_s *rammap_group(void)
+{
+  return sched_self()->group;
+}
+
+/****************************************************************************
+ * Name: rammap_getref
+ *
+ * Description:
+ *   Find the references that 'group' holds to the region, and optionally
+ *   the entry preceding them in the reference list.
+ *
+ ****************************************************************************/
+
+static FAR struct fs_rammapref_s *
+rammap_getref(FAR struct fs_rammap_s *map, FAR struct task_group_s *group,
+              FAR struct fs_rammapref_s **prev)
+{
+  FAR struct fs_rammapref_s *last = NULL;
+  FAR struct fs_rammapref_s *ref;
+
+  for (ref = map->refs; ref != NULL; last = ref, ref = ref->flink)
+    {
+      if (ref->group == group)
+        {
+          break;
+        }
+    }
+
+  if (prev != NULL)
+    {
+      *prev = last;
+    }
+
+  return ref;
+}
+
+/****************************************************************************
+ * Name: rammap_addref
+ *
+ * Description:
+ *   Charge one more reference to the region to 'group'.
+ *
+ ****************************************************************************/
+
+static int rammap_addref(FAR struct fs_rammap_s *map,
+                         FAR struct task_group_s *group)
+{
+  FAR struct fs_rammapref_s *ref;
+
+  ref = rammap_getref(map, group, NULL);
+  if (ref != NULL)
+    {
+      ref->count++;
+      map->nrefs++;
+      return OK;
+    }
+
+  ref = (FAR struct fs_rammapref_s *)kmm_malloc(sizeof(*ref));
+  if (ref == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ref->group = group;
+  ref->count = 1;
+  ref->flink = map->refs;
+  map->refs  = ref;
+  map->nrefs++;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rammap_delref
+ *
+ * Description:
+ *   Drop 'count' references held by the group owning 'ref', the entry
+ *   following 'prev' in the reference list of the region.
+ *
+ ****************************************************************************/
+
+static void rammap_delref(FAR struct fs_rammap_s *map,
+                          FAR struct fs_rammapref_s *prev,
+                          FAR struct fs_rammapref_s *ref,
+                          unsigned int count)
+{
+  DEBUGASSERT(ref->count >= count && map->nrefs >= count);
+
+  map->nrefs -= count;
+  ref->count -= count;
+  if (ref->count == 0)
+    {
+      if (prev != NULL)
+        {
+          prev->flink = ref->flink;
+        }
+      else
+        {
+          map->refs = ref->flink;
+        }
+
+      kmm_free(ref);
+    }
+}
+
+/****************************************************************************
+ * Name: rammap_free
+ *
+ * Description:
+ *   Write back, unlink and free a region with no remaining references.
+ *
+ ****************************************************************************/
+
+static int rammap_free(FAR struct fs_rammap_s *map)
+{
+  FAR struct fs_rammap_s *prev;
+  int ret;
+
+  DEBUGASSERT(map->nrefs == 0 && map->refs == NULL);
+
+  ret = rammap_writeback(map, 0, map->length);
+
+  if (g_rammaps.head == map)
+    {
+      g_rammaps.head = map->flink;
+    }
+  else
+    {
+      for (prev = g_rammaps.head; prev->flink != map; prev = prev->flink)
+        {
+        }
+
+      prev->flink = map->flink;
+    }
+
+  file_close(&map->file);
+  kumm_free(map->addr);
+  kmm_free(map);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: rammap_share
+ *
+ * Description:
+ *   Find a shared region of the inode that starts at 'offset' and covers
+ *   at least 'length' bytes.
+ *
+ ****************************************************************************/
+
+static FAR struct fs_rammap_s *rammap_share(FAR struct inode *inode,
+                                            off_t offset, size_t length)
+{
+  FAR struct fs_rammap_s *map;
+
+  for (map = g_rammaps.head; map != NULL; map = map->flink)
+    {
+      if ((map->flags & RAMMAP_FLAG_SHARED) != 0 &&
+          map->file.f_inode == inode && map->offset == offset &&
+          map->length >= length)
+        {
+          return map;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: rammap_upgrade
+ *
+ * Description:
+ *   A shared region first mapped through a read-only descriptor is not
+ *   written back.  When it is shared again through a writable descriptor,
+ *   replace the private open of the file with a writable one so that the
+ *   changes made through the new mapping reach the file.
+ *
+ ****************************************************************************/
+
+static int rammap_upgrade(FAR struct fs_rammap_s *map,
+                          FAR struct file *filep)
+{
+  struct file wrfile;
+  int ret;
+
+  if ((map->flags & RAMMAP_FLAG_WRITEBACK) != 0 ||
+      (filep->f_oflags & O_WROK) == 0)
+    {
+      return OK;
+    }
+
+  memset(&wrfile, 0, sizeof(struct file));
+  ret = file_dup2(filep, &wrfile);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  file_close(&map->file);
+  memcpy(&map->file, &wrfile, sizeof(struct file));
+  map->flags |= RAMMAP_FLAG_WRITEBACK;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rammap_fill
+ *
+ * Description:
+ *   Read the mapped part of the file into the region, zeroing whatever lies
+ *   beyond the end of the file.
+ *
+ ****************************************************************************/
+
+static int rammap_fill(FAR struct fs_rammap_s *map)
+{
+  FAR uint8_t *rdbuffer = map->addr;
+  size_t length = map->length;
+  ssize_t nread;
+  off_t fpos;
+
+  /* Seek to the specified file offset */
+
+  fpos = file_seek(&map->file, map->offset, SEEK_SET);
+  if (fpos < 0)
+    {
+      ferr("ERROR: Seek to position %d failed\n", (int)map->offset);
+      return -EINVAL;
+    }
+
+  /* Read the file data into the memory region */
+
+  while (length > 0)
+    {
+      nread = file_read(&map->file, rdbuffer, length);
+      if (nread < 0)
+        {
+          /* Handle the special case where the read was interrupted by a
+           * signal.
+           */
+
+          if (nread == -EINTR)
+            {
+              continue;
+            }
+
+          /* All other read errors are bad. */
+
+          ferr("ERROR: Read failed: offset=%d errno=%d\n",
+               (int)map->offset, (int)nread);
+          return (int)nread;
+        }
+
+      /* Check for end of file. */
+
+      if (nread == 0)
+        {
+          break;
+        }
+
+      /* Increment number of bytes read */
+
+      rdbuffer += nread;
+      length   -= nread;
+    }
+
+  /* Zero any memory beyond the amount read from the file */
+
+  memset(rdbuffer, 0, length);
+  return OK;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -90,17 +376,148 @@ void rammap_initialize(void)
     }
 }
 
+/****************************************************************************
+ * Name: rammap_find
+ *
+ * Description:
+ *   Return the region containing 'addr', optionally with its predecessor in
+ *   the list.  The caller must hold g_rammaps.exclsem.
+ *
+ ****************************************************************************/
+
+FAR struct fs_rammap_s *rammap_find(FAR const void *addr,
+                                    FAR struct fs_rammap_s **prev)
+{
+  FAR struct fs_rammap_s *last = NULL;
+  FAR struct fs_rammap_s *curr;
+
+  for (curr = g_rammaps.head; curr != NULL; last = curr, curr = curr->flink)
+    {
+      if ((uintptr_t)addr >= (uintptr_t)curr->addr &&
+          (uintptr_t)addr < (uintptr_t)curr->addr + curr->length)
+        {
+          break;
+        }
+    }
+
+  if (prev != NULL)
+    {
+      *prev = last;
+    }
+
+  return curr;
+}
+
+/****************************************************************************
+ * Name: rammap_writeback
+ *
+ * Description:
+ *   Write 'length' bytes of the region starting 'offset' bytes into it back
+ *   to the mapped file.  Does nothing for regions without
+ *   RAMMAP_FLAG_WRITEBACK.  The caller must hold g_rammaps.exclsem.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int rammap_writeback(FAR struct fs_rammap_s *map, size_t offset,
+                     size_t length)
+{
+  FAR const uint8_t *src;
+  ssize_t nwritten;
+  off_t fpos;
+
+  if ((map->flags & RAMMAP_FLAG_WRITEBACK) == 0 || offset >= map->length)
+    {
+      return OK;
+    }
+
+  if (length > map->length - offset)
+    {
+      length = map->length - offset;
+    }
+
+  fpos = file_seek(&map->file, map->offset + offset, SEEK_SET);
+  if (fpos < 0)
+    {
+      return (int)fpos;
+    }
+
+  src = (FAR const uint8_t *)map->addr + offset;
+  while (length > 0)
+    {
+      nwritten = file_write(&map->file, src, length);
+      if (nwritten < 0)
+        {
+          if (nwritten == -EINTR)
+            {
+              continue;
+            }
+
+          ferr("ERROR: Write back failed: %d\n", (int)nwritten);
+          return (int)nwritten;
+        }
+
+      src    += nwritten;
+      length -= nwritten;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rammap_unref
+ *
+ * Description:
+ *   Drop one reference to the region, preferably one held by 'group'.
+ *   When the last reference is dropped, the region is written back, removed
+ *   from the list and freed.  The caller must hold g_rammaps.exclsem.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value if the final write back
+ *   failed.  The reference is dropped in either case.
+ *
+ ****************************************************************************/
+
+int rammap_unref(FAR struct fs_rammap_s *map,
+                 FAR struct task_group_s *group)
+{
+  FAR struct fs_rammapref_s *prev;
+  FAR struct fs_rammapref_s *ref;
+
+  DEBUGASSERT(map->refs != NULL);
+
+  /* The region may be unmapped by a task that did not map it, as when a
+   * loaded module is unloaded on behalf of the task that ran it.  Drop the
+   * first reference in that case.
+   */
+
+  ref = rammap_getref(map, group, &prev);
+  if (ref == NULL)
+    {
+      prev = NULL;
+      ref  = map->refs;
+    }
+
+  rammap_delref(map, prev, ref, 1);
+  return map->nrefs == 0 ? rammap_free(map) : OK;
+}
+
 /****************************************************************************
  * Name: rammmap
  *
  * Description:
  *   Support simulation of memory mapped files by copying files into RAM.
+ *   A MAP_SHARED request for a region that is already mapped returns the
+ *   existing copy.
  *
  * Input Parameters:
  *   fd      file descriptor of the backing file -- required.
  *   length  The length of the mapping.  For exception #1 above, this length
  *           ignored:  The entire underlying media is always accessible.
  *   offset  The offset into the file to map
+ *   flags   The mmap() flags.  Only MAP_SHARED is examined.
  *
  * Returned Value:
  *   On success, rammmap() returns a pointer to the mapped area. On error, the
@@ -115,124 +532,230 @@ void rammap_initialize(void)
  *
  ****************************************************************************/
 
-FAR void *rammap(int fd, size_t length, off_t offset)
+FAR void *rammap(int fd, size_t length, off_t offset, int flags)
 {
+  FAR struct task_group_s *group = rammap_group();
   FAR struct fs_rammap_s *map;
-  FAR uint8_t *alloc;
-  FAR uint8_t *rdbuffer;
-  ssize_t nread;
-  off_t fpos;
+  FAR struct file *filep;
   int errcode;
   int ret;
 
-  /* There is a major design flaw that I have not yet thought of fix for:
-   * The goal is to have a single region of memory that represents a single
-   * file and can be shared by many threads.  That is, given a filename a
-   * thread should be able to open the file, get a file descriptor, and
-   * call mmap() to get a memory region.  Different file descriptors opened
-   * with the same file path should get the same memory region when mapped.
-   *
-   * The design flaw is that I don't have sufficient knowledge to know that
-   * these different file descriptors map to the same file.  So, for the time
-   * being, a new memory region is created each time that rammap() is called.
-   * Not very useful!
+  ret = fs_getfilep(fd, &filep);
+  if (ret < 0 || filep->f_inode == NULL)
+    {
+      errcode = EBADF;
+      goto errout;
+    }
+
+  rammap_initialize();
+  ret = nxsem_wait(&g_rammaps.exclsem);
+  if (ret < 0)
+    {
+      errcode = -ret;
+      goto errout;
+    }
+
+  /* A shared mapping of a region that some task has already mapped just
+   * takes another reference to the copy in memory, made writable back to
+   * the file if it is now mapped through a writable descriptor.
    */
 
-  /* Allocate a region of memory of the specified size */
+  if ((flags & MAP_SHARED) != 0)
+    {
+      map = rammap_share(filep->f_inode, offset, length);
+      if (map != NULL)
+        {
+          ret = rammap_upgrade(map, filep);
+          if (ret >= 0)
+            {
+              ret = rammap_addref(map, group);
+            }
+
+          if (ret < 0)
+            {
+              errcode = -ret;
+              goto errout_with_sem;
+            }
+
+          nxsem_post(&g_rammaps.exclsem);
+          return map->addr;
+        }
+    }
+
+  /* Allocate the region descriptor and a region of memory of the
+   * specified size.
+   */
 
-  alloc = (FAR uint8_t *)kumm_malloc(sizeof(struct fs_rammap_s) + length);
-  if (!alloc)
+  map = (FAR struct fs_rammap_s *)kmm_zalloc(sizeof(struct fs_rammap_s));
+  if (map == NULL)
     {
-      ferr("ERROR: Region allocation failed, length: %d\n", (int)length);
       errcode = ENOMEM;
-      goto errout;
+      goto errout_with_sem;
     }
 
-  /* Initialize the region */
+  map->addr = kumm_malloc(length);
+  if (map->addr == NULL)
+    {
+      ferr("ERROR: Region allocation failed, length: %d\n", (int)length);
+      errcode = ENOMEM;
+      goto errout_with_map;
+    }
 
-  map         = (FAR struct fs_rammap_s *)alloc;
-  memset(map, 0, sizeof(struct fs_rammap_s));
-  map->addr   = alloc + sizeof(struct fs_rammap_s);
   map->length = length;
   map->offset = offset;
 
-  /* Seek to the specified file offset */
+  /* Keep a private open of the file.  It holds the inode that identifies
+   * the region, is used to write it back and does not disturb the file
+   * position of the caller's descriptor.
+   */
 
-  fpos = lseek(fd, offset,  SEEK_SET);
-  if (fpos == (off_t)-1)
+  ret = file_dup2(filep, &map->file);
+  if (ret < 0)
     {
-      /* Seek failed... errno has already been set, but EINVAL is probably
-       * the correct response.
-       */
-
-      ferr("ERROR: Seek to position %d failed\n", (int)offset);
-      errcode = EINVAL;
+      errcode = -ret;
       goto errout_with_region;
     }
 
-  /* Read the file data into the memory region */
+  ret = rammap_fill(map);
+  if (ret < 0)
+    {
+      errcode = -ret;
+      goto errout_with_file;
+    }
 
-  rdbuffer = map->addr;
-  while (length > 0)
+  if ((flags & MAP_SHARED) != 0)
     {
-      nread = nx_read(fd, rdbuffer, length);
-      if (nread < 0)
+      map->flags = RAMMAP_FLAG_SHARED;
+      if ((map->file.f_oflags & O_WROK) != 0)
         {
-          /* Handle the special case where the read was interrupted by a
-           * signal.
-           */
+          map->flags |= RAMMAP_FLAG_WRITEBACK;
+        }
+    }
 
-          if (nread != -EINTR)
-            {
-              /* All other read errors are bad. */
+  ret = rammap_addref(map, group);
+  if (ret < 0)
+    {
+      errcode = -ret;
+      goto errout_with_file;
+    }
 
-              ferr("ERROR: Read failed: offset=%d errno=%d\n",
-                   (int)offset, (int)nread);
+  /* Add the region to the list of regions */
 
-              errcode = (int)-nread;
-              goto errout_with_region;
-            }
-        }
+  map->flink     = g_rammaps.head;
+  g_rammaps.head = map;
 
-      /* Check for end of file. */
+  nxsem_post(&g_rammaps.exclsem);
+  return map->addr;
 
-      if (nread == 0)
-        {
-          break;
-        }
+errout_with_file:
+  file_close(&map->file);
 
-      /* Increment number of bytes read */
+errout_with_region:
+  kumm_free(map->addr);
 
-      rdbuffer += nread;
-      length   -= nread;
-    }
+errout_with_map:
+  kmm_free(map);
 
-  /* Zero any memory beyond the amount read from the file */
+errout_with_sem:
+  nxsem_post(&g_rammaps.exclsem);
 
-  memset(rdbuffer, 0, length);
+errout:
+  set_errno(errcode);
+  return MAP_FAILED;
+}
+
+/****************************************************************************
+ * Name: rammap_transfer
+ *
+ * Description:
+ *   Move the calling group's reference to the region at 'addr' to the task
+ *   group of 'pid'.  A module loader uses this so that the mapping it made
+ *   lives as long as the task running the module rather than the loader.
+ *   Addresses that are not RAM mapped are ignored.
+ *
+ ****************************************************************************/
+
+int rammap_transfer(FAR void *addr, pid_t pid)
+{
+  FAR struct task_group_s *group = rammap_group();
+  FAR struct fs_rammapref_s *prev;
+  FAR struct fs_rammapref_s *ref;
+  FAR struct fs_rammap_s *map;
+  FAR struct tcb_s *tcb;
+  int ret;
 
-  /* Add the buffer to the list of regions */
+  tcb = sched_gettcb(pid);
+  if (tcb == NULL)
+    {
+      return -ESRCH;
+    }
 
   rammap_initialize();
   ret = nxsem_wait(&g_rammaps.exclsem);
   if (ret < 0)
     {
-      errcode = -ret;
-      goto errout_with_region;
+      return ret;
     }
 
-  map->flink  = g_rammaps.head;
-  g_rammaps.head = map;
+  map = rammap_find(addr, NULL);
+  if (map != NULL && map->addr == addr &&
+      rammap_getref(map, group, NULL) != NULL)
+    {
+      /* Take the new reference first so that the region cannot go away,
+       * then look up ours again as adding may have changed the list.
+       */
+
+      ret = rammap_addref(map, tcb->group);
+      if (ret >= 0)
+        {
+          ref = rammap_getref(map, group, &prev);
+          rammap_delref(map, prev, ref, 1);
+        }
+    }
 
   nxsem_post(&g_rammaps.exclsem);
-  return map->addr;
+  return ret;
+}
 
-errout_with_region:
-  kumm_free(alloc);
+/****************************************************************************
+ * Name: rammap_release
+ *
+ * Description:
+ *   Drop every reference still held by a task group that is exiting,
+ *   freeing the regions that it was the last user of.
+ *
+ ****************************************************************************/
 
-errout:
-  set_errno(errcode);
-  return MAP_FAILED;
+void rammap_release(FAR struct task_group_s *group)
+{
+  FAR struct fs_rammapref_s *prev;
+  FAR struct fs_rammapref_s *ref;
+  FAR struct fs_rammap_s *next;
+  FAR struct fs_rammap_s *map;
+
+  if (!g_rammaps.initialized)
+    {
+      return;
+    }
+
+  nxsem_wait_uninterruptible(&g_rammaps.exclsem);
+
+  for (map = g_rammaps.head; map != NULL; map = next)
+    {
+      next = map->flink;
+
+      ref = rammap_getref(map, group, &prev);
+      if (ref != NULL)
+        {
+          rammap_delref(map, prev, ref, ref->count);
+          if (map->nrefs == 0)
+            {
+              rammap_free(map);
+            }
+        }
+    }
+
+  nxsem_post(&g_rammaps.exclsem);
 }
 
 #endif /* CONFIG_FS_RAMMAP */
@@ -45,10 +45,23 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+
 #include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
 
 #ifdef CONFIG_FS_RAMMAP
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Values of the flags field of struct fs_rammap_s */
+
+#define RAMMAP_FLAG_SHARED    (1 << 0) /* MAP_SHARED: Visible to other mappers */
+#define RAMMAP_FLAG_WRITEBACK (1 << 1) /* Changes are written back to the file */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -65,17 +78,32 @@
  * - All of the file must be present in memory.  This limits the size of
  *   files that may be memory mapped (especially on MCUs with no significant
  *   RAM resources).
- * - All mapped files are read-only.  You can write to the in-memory image,
- *   but the file contents will not change.
+ * - Changes reach the file only through msync() or munmap(), and only for
+ *   MAP_SHARED mappings of files opened for writing.
  * - There are not access privileges.
+ *
+ * MAP_SHARED mappings of the same inode and offset share one region.  Each
+ * mmap() takes a reference that is charged to the calling task group, so
+ * that whatever the group still holds when it exits can be dropped.
  */
 
+struct fs_rammapref_s
+{
+  FAR struct fs_rammapref_s *flink; /* Next group referencing the region */
+  FAR struct task_group_s   *group; /* The task group holding references */
+  unsigned int               count; /* Number of references it holds */
+};
+
 struct fs_rammap_s
 {
-  struct fs_rammap_s *flink;       /* Implements a singly linked list */
-  FAR void           *addr;        /* Start of allocated memory */
-  size_t              length;      /* Length of region */
-  off_t               offset;      /* File offset */
+  FAR struct fs_rammap_s    *flink;  /* Implements a singly linked list */
+  FAR void                  *addr;   /* Start of allocated memory */
+  size_t                     length; /* Length of region */
+  off_t                      offset; /* File offset */
+  unsigned int               nrefs;  /* Total number of references */
+  uint8_t                    flags;  /* See RAMMAP_FLAG_* definitions */
+  FAR struct fs_rammapref_s *refs;   /* References held per task group */
+  struct file                file;   /* Private open of the mapped file */
 };
 
 /* This structure defines all "mapped" files */
@@ -120,12 +148,15 @@ void rammap_initialize(void);
  *
  * Description:
  *   Support simulation of memory mapped files by copying files into RAM.
+ *   A MAP_SHARED request for a region that is already mapped returns the
+ *   existing copy.
  *
  * Input Parameters:
  *   fd      file descriptor of the backing file -- required.
  *   length  The length of the mapping.  For exception #1 above, this length
  *           ignored:  The entire underlying media is always accessible.
  *   offset  The offset into the file to map
+ *   flags   The mmap() flags.  Only MAP_SHARED is examined.
  *
  * Returned Value:
  *   On success, rammmap() returns a pointer to the mapped area. On error, the
@@ -140,7 +171,52 @@ void rammap_initialize(void);
  *
  ****************************************************************************/
 
-FAR void *rammap(int fd, size_t length, off_t offset);
+FAR void *rammap(int fd, size_t length, off_t offset, int flags);
+
+/****************************************************************************
+ * Name: rammap_find
+ *
+ * Description:
+ *   Return the region containing 'addr', optionally with its predecessor in
+ *   the list.  The caller must hold g_rammaps.exclsem.
+ *
+ ****************************************************************************/
+
+FAR struct fs_rammap_s *rammap_find(FAR const void *addr,
+                                    FAR struct fs_rammap_s **prev);
+
+/****************************************************************************
+ * Name: rammap_writeback
+ *
+ * Description:
+ *   Write 'length' bytes of the region starting 'offset' bytes into it back
+ *   to the mapped file.  Does nothing for regions without
+ *   RAMMAP_FLAG_WRITEBACK.  The caller must hold g_rammaps.exclsem.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int rammap_writeback(FAR struct fs_rammap_s *map, size_t offset,
+                     size_t length);
+
+/****************************************************************************
+ * Name: rammap_unref
+ *
+ * Description:
+ *   Drop one reference to the region, preferably one held by 'group'.
+ *   When the last reference is dropped, the region is written back, removed
+ *   from the list and freed.  The caller must hold g_rammaps.exclsem.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value if the final write back
+ *   failed.  The reference is dropped in either case.
+ *
+ ****************************************************************************/
+
+int rammap_unref(FAR struct fs_rammap_s *map,
+                 FAR struct task_group_s *group);
 
 #endif /* CONFIG_FS_RAMMAP */
 #endif /* __FS_MMAP_RAMMAP_H */
@@ -0,0 +1,140 @@
+/****************************************************************************
+ * fs/mmap/fs_rammap_test.c
+ * Unit test driver for the shared mappings of fs_rammap.c.  It is not part
+ * of the build: compile it as a program in a configuration with
+ * CONFIG_FS_RAMMAP and a writable file system mounted at the path given on
+ * the command line (/tmp by default) and run it.  It returns EXIT_SUCCESS
+ * if the test passes.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/mman.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TEST_LENGTH 64
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const char g_original[TEST_LENGTH] = "original file contents";
+static const char g_modified[TEST_LENGTH] = "written through the mapping";
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, FAR char *argv[])
+{
+  FAR const char *dir = argc > 1 ? argv[1] : "/tmp";
+  char path[64];
+  char buffer[TEST_LENGTH];
+  FAR char *rdaddr;
+  FAR char *wraddr;
+  int rdfd;
+  int wrfd;
+  int fd;
+
+  snprintf(path, sizeof(path), "%s/rammap_test", dir);
+
+  /* Create the file */
+
+  fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0 || write(fd, g_original, TEST_LENGTH) != TEST_LENGTH)
+    {
+      printf("FAILED to create %s\n", path);
+      return EXIT_FAILURE;
+    }
+
+  close(fd);
+
+  /* Map it shared and read-only first */
+
+  rdfd = open(path, O_RDONLY);
+  rdaddr = mmap(NULL, TEST_LENGTH, PROT_READ, MAP_SHARED, rdfd, 0);
+  if (rdfd < 0 || rdaddr == MAP_FAILED)
+    {
+      printf("FAILED to map %s read-only\n", path);
+      return EXIT_FAILURE;
+    }
+
+  /* Then map the same region shared and writable, and write to it */
+
+  wrfd = open(path, O_RDWR);
+  wraddr = mmap(NULL, TEST_LENGTH, PROT_READ | PROT_WRITE, MAP_SHARED,
+                wrfd, 0);
+  if (wrfd < 0 || wraddr == MAP_FAILED)
+    {
+      printf("FAILED to map %s writable\n", path);
+      return EXIT_FAILURE;
+    }
+
+  memcpy(wraddr, g_modified, TEST_LENGTH);
+  if (memcmp(rdaddr, g_modified, TEST_LENGTH) != 0)
+    {
+      printf("FAILED: the read-only mapping does not see the write\n");
+      return EXIT_FAILURE;
+    }
+
+  if (msync(wraddr, TEST_LENGTH, MS_SYNC) < 0)
+    {
+      printf("FAILED to sync the writable mapping\n");
+      return EXIT_FAILURE;
+    }
+
+  munmap(wraddr, TEST_LENGTH);
+  munmap(rdaddr, TEST_LENGTH);
+  close(wrfd);
+  close(rdfd);
+
+  /* The file must now hold what was written through the mapping */
+
+  fd = open(path, O_RDONLY);
+  if (fd < 0 || read(fd, buffer, TEST_LENGTH) != TEST_LENGTH)
+    {
+      printf("FAILED to read %s back\n", path);
+      return EXIT_FAILURE;
+    }
+
+  close(fd);
+  unlink(path);
+
+  if (memcmp(buffer, g_modified, TEST_LENGTH) != 0)
+    {
+      printf("FAILED: the file holds \"%s\", expected \"%s\"\n",
+             buffer, g_modified);
+      return EXIT_FAILURE;
+    }
+
+  printf("PASSED\n");
+  return EXIT_SUCCESS;
+}
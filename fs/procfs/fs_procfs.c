@@ -96,6 +96,7 @@ extern const struct procfs_operations net_procfsoperations;
 extern const struct procfs_operations net_procfs_routeoperations;
 extern const struct procfs_operations part_procfsoperations;
 extern const struct procfs_operations mount_procfsoperations;
+extern const struct procfs_operations aio_procfsoperations;
 extern const struct procfs_operations smartfs_procfsoperations;
 
 /* And even worse, this one is specific to the STM32.  The solution to
@@ -148,6 +149,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "modules",       &module_operations,          PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_FS_AIO) && !defined(CONFIG_FS_PROCFS_EXCLUDE_AIO)
+  { "fs/aio",        &aio_procfsoperations,       PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_BLOCKS
   { "fs/blocks",     &mount_procfsoperations,     PROCFS_FILE_TYPE   },
 #endif
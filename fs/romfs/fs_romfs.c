@@ -1064,6 +1064,18 @@ static int romfs_bind(FAR struct inode *blkdriver, FAR const void *data,
       goto errout_with_buffer;
     }
 
+#ifdef CONFIG_FS_ROMFS_INDEX
+  /* Build the directory index.  This is only an optimization, so a
+   * failure does not prevent the mount.
+   */
+
+  ret = romfs_buildindex(rm);
+  if (ret < 0)
+    {
+      fwarn("WARNING: romfs_buildindex failed: %d\n", ret);
+    }
+#endif
+
   /* Mounted! */
 
   *handle = (FAR void *)rm;
@@ -1154,6 +1166,8 @@ static int romfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
 
       /* Release the mountpoint private data */
 
+      romfs_freecache(rm);
+
       if (!rm->rm_xipbase && rm->rm_buffer)
         {
           kmm_free(rm->rm_buffer);
@@ -126,10 +126,69 @@
 
 #define ROMF_MAX_LINKS 64
 
+/* Every file header occupies at least 32 bytes (16 bytes of header plus at
+ * least one 16-byte name chunk).  That bounds the number of entries that a
+ * volume can hold.
+ */
+
+#define ROMFS_MINENTRY 32
+
+#ifndef CONFIG_FS_ROMFS_DCACHE_NENTRIES
+#  define CONFIG_FS_ROMFS_DCACHE_NENTRIES 0
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+/* This structure is used internally for describing the result of
+ * walking a path
+ */
+
+struct romfs_dirinfo_s
+{
+  /* These values describe the directory containing the terminal
+   * path component (of the terminal component itself if it is
+   * a directory.
+   */
+
+  struct fs_romfsdir_s rd_dir;    /* Describes directory. */
+
+  /* Values from the ROMFS file entry */
+
+  uint32_t rd_next;               /* Offset of the next file header+flags */
+  uint32_t rd_size;               /* Size (if file) */
+};
+
+#ifdef CONFIG_FS_ROMFS_INDEX
+/* One slot of the mount-time directory index.  The index is an open-
+ * addressed hash table keyed by the offset of the first entry of the
+ * containing directory and by the entry name.  A slot with rh_offset == 0
+ * is empty (offset zero holds the volume header, never a file header).
+ */
+
+struct romfs_hashent_s
+{
+  uint32_t rh_hash;               /* Hash of the parent and the entry name */
+  uint32_t rh_parent;             /* First entry offset of the parent dir */
+  uint32_t rh_offset;             /* Offset of the entry's file header */
+};
+#endif
+
+#if CONFIG_FS_ROMFS_DCACHE_NENTRIES > 0
+/* One recently resolved path */
+
+struct romfs_dentry_s
+{
+  FAR char *rc_path;              /* Relative path; NULL if slot is unused */
+  uint32_t rc_hash;               /* Hash of rc_path */
+
+  /* Result of looking up rc_path */
+
+  struct romfs_dirinfo_s rc_dirinfo;
+};
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of
  * this structure is retained as inode private data on each mountpoint that
  * is mounted with a fat32 filesystem.
@@ -150,6 +209,18 @@ struct romfs_mountpt_s
   uint32_t rm_cachesector;          /* Current sector in the rm_buffer */
   uint8_t *rm_xipbase;              /* Base address of directly accessible media */
   uint8_t *rm_buffer;               /* Device sector buffer, allocated if rm_xipbase==0 */
+#ifdef CONFIG_FS_ROMFS_INDEX
+
+  /* Directory index, NULL if it was not built at mount time */
+
+  FAR struct romfs_hashent_s *rm_index;
+  uint32_t rm_indexmask;            /* Number of index slots - 1 */
+  uint32_t rm_indexcount;           /* Number of occupied index slots */
+#endif
+#if CONFIG_FS_ROMFS_DCACHE_NENTRIES > 0
+  unsigned int rm_dcachenext;       /* Next dcache slot to replace */
+  struct romfs_dentry_s rm_dcache[CONFIG_FS_ROMFS_DCACHE_NENTRIES];
+#endif
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -167,25 +238,6 @@ struct romfs_file_s
   uint8_t rf_type;                  /* File type (for fstat()) */
 };
 
-/* This structure is used internally for describing the result of
- * walking a path
- */
-
-struct romfs_dirinfo_s
-{
-  /* These values describe the directory containing the terminal
-   * path component (of the terminal component itself if it is
-   * a directory.
-   */
-
-  struct fs_romfsdir_s rd_dir;    /* Describes directory. */
-
-  /* Values from the ROMFS file entry */
-
-  uint32_t rd_next;               /* Offset of the next file header+flags */
-  uint32_t rd_size;               /* Size (if file) */
-};
-
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -224,6 +276,10 @@ int  romfs_parsefilename(FAR struct romfs_mountpt_s *rm, uint32_t offset,
        FAR char *pname);
 int  romfs_datastart(FAR struct romfs_mountpt_s *rm, uint32_t offset,
        FAR uint32_t *start);
+#ifdef CONFIG_FS_ROMFS_INDEX
+int  romfs_buildindex(FAR struct romfs_mountpt_s *rm);
+#endif
+void romfs_freecache(FAR struct romfs_mountpt_s *rm);
 
 #undef EXTERN
 #if defined(__cplusplus)
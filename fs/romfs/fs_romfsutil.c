@@ -81,6 +81,31 @@ static uint32_t romfs_devread32(struct romfs_mountpt_s *rm, int ndx)
            ((uint32_t)rm->rm_buffer[ndx + 3] & 0xff));
 }
 
+/****************************************************************************
+ * Name: romfs_hash
+ *
+ * Description:
+ *   Return the FNV-1a hash of the first 'len' characters of 'name', seeded
+ *   with 'seed'.  The directory index seeds the hash with the offset of the
+ *   parent directory; the path cache uses a seed of zero.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_FS_ROMFS_INDEX) || CONFIG_FS_ROMFS_DCACHE_NENTRIES > 0
+static uint32_t romfs_hash(uint32_t seed, FAR const char *name, int len)
+{
+  uint32_t hash = 2166136261u ^ seed;
+
+  while (len-- > 0)
+    {
+      hash ^= (uint8_t)*name++;
+      hash *= 16777619u;
+    }
+
+  return hash;
+}
+#endif
+
 /****************************************************************************
  * Name: romfs_checkentry
  *
@@ -256,6 +281,190 @@ static int romfs_followhardlinks(struct romfs_mountpt_s *rm, uint32_t offset,
   return -ELOOP;
 }
 
+/****************************************************************************
+ * Name: romfs_indexresize
+ *
+ * Description:
+ *   (Re-)allocate the directory index with 'nslots' slots (a power of two)
+ *   and re-insert any entries already present.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_ROMFS_INDEX
+static int romfs_indexresize(FAR struct romfs_mountpt_s *rm,
+                             uint32_t nslots)
+{
+  FAR struct romfs_hashent_s *oldindex = rm->rm_index;
+  FAR struct romfs_hashent_s *newindex;
+  uint32_t oldslots = oldindex != NULL ? rm->rm_indexmask + 1 : 0;
+  uint32_t ndx;
+  uint32_t i;
+
+  newindex = (FAR struct romfs_hashent_s *)
+    kmm_zalloc(nslots * sizeof(struct romfs_hashent_s));
+  if (newindex == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0; i < oldslots; i++)
+    {
+      if (oldindex[i].rh_offset != 0)
+        {
+          ndx = oldindex[i].rh_hash & (nslots - 1);
+          while (newindex[ndx].rh_offset != 0)
+            {
+              ndx = (ndx + 1) & (nslots - 1);
+            }
+
+          newindex[ndx] = oldindex[i];
+        }
+    }
+
+  if (oldindex != NULL)
+    {
+      kmm_free(oldindex);
+    }
+
+  rm->rm_index     = newindex;
+  rm->rm_indexmask = nslots - 1;
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: romfs_indexinsert
+ *
+ * Description:
+ *   Add the entry at 'offset' in the directory whose first entry is at
+ *   'parent' to the directory index, growing the index as needed to keep
+ *   it no more than half full.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_ROMFS_INDEX
+static int romfs_indexinsert(FAR struct romfs_mountpt_s *rm, uint32_t hash,
+                             uint32_t parent, uint32_t offset)
+{
+  FAR struct romfs_hashent_s *hent;
+  uint32_t ndx;
+  int ret;
+
+  if (2 * (rm->rm_indexcount + 1) > rm->rm_indexmask + 1)
+    {
+      ret = romfs_indexresize(rm, 2 * (rm->rm_indexmask + 1));
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  ndx = hash & rm->rm_indexmask;
+  while (rm->rm_index[ndx].rh_offset != 0)
+    {
+      ndx = (ndx + 1) & rm->rm_indexmask;
+    }
+
+  hent            = &rm->rm_index[ndx];
+  hent->rh_hash   = hash;
+  hent->rh_parent = parent;
+  hent->rh_offset = offset;
+  rm->rm_indexcount++;
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: romfs_searchindex
+ *
+ * Description:
+ *   This is the romfs_searchdir() logic used when the directory index is
+ *   available:  Probe the index for entryname in the directory beginning at
+ *   dirinfo->fr_firstoffset rather than scanning the directory.  Because
+ *   the index holds every entry in the volume, a miss is authoritative.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_ROMFS_INDEX
+static int romfs_searchindex(FAR struct romfs_mountpt_s *rm,
+                             FAR const char *entryname, int entrylen,
+                             FAR struct romfs_dirinfo_s *dirinfo)
+{
+  FAR struct romfs_hashent_s *hent;
+  uint32_t parent;
+  uint32_t hash;
+  uint32_t ndx;
+  int ret;
+
+  parent = (uint32_t)dirinfo->rd_dir.fr_firstoffset;
+  hash   = romfs_hash(parent, entryname, entrylen);
+
+  for (ndx = hash & rm->rm_indexmask;
+       rm->rm_index[ndx].rh_offset != 0;
+       ndx = (ndx + 1) & rm->rm_indexmask)
+    {
+      hent = &rm->rm_index[ndx];
+      if (hent->rh_hash == hash && hent->rh_parent == parent)
+        {
+          /* A likely match.  romfs_checkentry() compares the name in the
+           * image and fills in the directory information.
+           */
+
+          ret = romfs_checkentry(rm, hent->rh_offset, entryname, entrylen,
+                                 dirinfo);
+          if (ret == OK)
+            {
+              return OK;
+            }
+        }
+    }
+
+  return -ENOENT;
+}
+#endif
+
+/****************************************************************************
+ * Name: romfs_cacheentry
+ *
+ * Description:
+ *   Remember the result of successfully looking up 'path', replacing the
+ *   oldest cached path.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_ROMFS_DCACHE_NENTRIES > 0
+static void romfs_cacheentry(FAR struct romfs_mountpt_s *rm, uint32_t hash,
+                             FAR const char *path,
+                             FAR const struct romfs_dirinfo_s *dirinfo)
+{
+  FAR struct romfs_dentry_s *dentry;
+  size_t len = strlen(path) + 1;
+
+  dentry = &rm->rm_dcache[rm->rm_dcachenext];
+  if (++rm->rm_dcachenext >= CONFIG_FS_ROMFS_DCACHE_NENTRIES)
+    {
+      rm->rm_dcachenext = 0;
+    }
+
+  if (dentry->rc_path != NULL)
+    {
+      kmm_free(dentry->rc_path);
+    }
+
+  /* If the copy of the path cannot be allocated, the slot is just left
+   * empty.
+   */
+
+  dentry->rc_path = (FAR char *)kmm_malloc(len);
+  if (dentry->rc_path != NULL)
+    {
+      memcpy(dentry->rc_path, path, len);
+      dentry->rc_hash = hash;
+      memcpy(&dentry->rc_dirinfo, dirinfo, sizeof(struct romfs_dirinfo_s));
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: romfs_searchdir
  *
@@ -274,6 +483,17 @@ static inline int romfs_searchdir(struct romfs_mountpt_s *rm,
   int16_t  ndx;
   int      ret;
 
+#ifdef CONFIG_FS_ROMFS_INDEX
+  /* Use the directory index, if one was built when the volume was
+   * mounted.
+   */
+
+  if (rm->rm_index != NULL)
+    {
+      return romfs_searchindex(rm, entryname, entrylen, dirinfo);
+    }
+#endif
+
   /* Then loop through the current directory until the directory
    * with the matching name is found.  Or until all of the entries
    * the directory have been examined.
@@ -711,6 +931,11 @@ int romfs_finddirentry(struct romfs_mountpt_s *rm,
 {
   const char *entryname;
   const char *terminator;
+#if CONFIG_FS_ROMFS_DCACHE_NENTRIES > 0
+  FAR struct romfs_dentry_s *dentry;
+  uint32_t hash;
+  int i;
+#endif
   int entrylen;
   int ret;
 
@@ -728,6 +953,23 @@ int romfs_finddirentry(struct romfs_mountpt_s *rm,
       return OK;
     }
 
+#if CONFIG_FS_ROMFS_DCACHE_NENTRIES > 0
+  /* Check if this path was looked up recently */
+
+  hash = romfs_hash(0, path, strlen(path));
+  for (i = 0; i < CONFIG_FS_ROMFS_DCACHE_NENTRIES; i++)
+    {
+      dentry = &rm->rm_dcache[i];
+      if (dentry->rc_path != NULL && dentry->rc_hash == hash &&
+          strcmp(dentry->rc_path, path) == 0)
+        {
+          memcpy(dirinfo, &dentry->rc_dirinfo,
+                 sizeof(struct romfs_dirinfo_s));
+          return OK;
+        }
+    }
+#endif
+
   /* Then loop for each directory/file component in the full path */
 
   entryname    = path;
@@ -774,6 +1016,9 @@ int romfs_finddirentry(struct romfs_mountpt_s *rm,
         {
           /* Yes.. return success */
 
+#if CONFIG_FS_ROMFS_DCACHE_NENTRIES > 0
+          romfs_cacheentry(rm, hash, path, dirinfo);
+#endif
           return OK;
         }
 
@@ -974,3 +1219,184 @@ int romfs_datastart(struct romfs_mountpt_s *rm, uint32_t offset,
 
   return -EINVAL; /* Won't get here */
 }
+
+/****************************************************************************
+ * Name: romfs_buildindex
+ *
+ * Description:
+ *   This function is called as part of the ROMFS mount operation after
+ *   romfs_fsconfigure().  It walks every directory in the volume once and
+ *   adds each directory and file entry to the directory index.  Hard links,
+ *   ".", and ".." are indexed under their own names but not descended into.
+ *
+ *   On failure, no index is retained and lookups fall back to scanning the
+ *   directories.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_ROMFS_INDEX
+int romfs_buildindex(FAR struct romfs_mountpt_s *rm)
+{
+  char name[NAME_MAX + 1];
+  FAR uint32_t *dirs = NULL;
+  FAR uint32_t *newdirs;
+  uint32_t maxentries;
+  uint32_t nentries = 0;
+  uint32_t ndirs    = 0;
+  uint32_t maxdirs  = 0;
+  uint32_t walked   = 0;
+  uint32_t linkoffset;
+  uint32_t offset;
+  uint32_t dir;
+  uint32_t next;
+  uint32_t info;
+  uint32_t size;
+  int ret;
+
+  ret = romfs_indexresize(rm, 64);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* No well-formed volume can hold more entries than this.  Exceeding it
+   * means that the headers are linked in a cycle.
+   */
+
+  maxentries = rm->rm_volsize / ROMFS_MINENTRY;
+
+  /* Walk the root directory, then each directory queued by the walk */
+
+  dir = rm->rm_rootoffset;
+  for (; ; )
+    {
+      for (offset = dir; offset != 0; offset = next & RFNEXT_OFFSETMASK)
+        {
+          if (++nentries > maxentries)
+            {
+              ret = -EINVAL;
+              goto errout;
+            }
+
+          ret = romfs_parsedirentry(rm, offset, &linkoffset, &next, &info,
+                                    &size);
+          if (ret < 0)
+            {
+              goto errout;
+            }
+
+          /* Only directories and files can be found by
+           * romfs_checkentry(), so only those are indexed.
+           */
+
+          if (!IS_DIRECTORY(next) && !IS_FILE(next))
+            {
+              continue;
+            }
+
+          ret = romfs_parsefilename(rm, offset, name);
+          if (ret < 0)
+            {
+              goto errout;
+            }
+
+          ret = romfs_indexinsert(rm, romfs_hash(dir, name, strlen(name)),
+                                  dir, offset);
+          if (ret < 0)
+            {
+              goto errout;
+            }
+
+          /* Queue real (not hard-linked) sub-directories to be walked.
+           * The "." entry of the root directory is a directory rather than
+           * a hard link, so skip "." and ".." by name as well.
+           */
+
+          if (IS_DIRECTORY(next) && linkoffset == offset &&
+              strcmp(name, ".") != 0 && strcmp(name, "..") != 0)
+            {
+              if (ndirs >= maxdirs)
+                {
+                  maxdirs = maxdirs ? 2 * maxdirs : 16;
+                  newdirs = (FAR uint32_t *)
+                    kmm_realloc(dirs, maxdirs * sizeof(uint32_t));
+                  if (newdirs == NULL)
+                    {
+                      ret = -ENOMEM;
+                      goto errout;
+                    }
+
+                  dirs = newdirs;
+                }
+
+              dirs[ndirs++] = info;
+            }
+        }
+
+      if (walked >= ndirs)
+        {
+          break;
+        }
+
+      dir = dirs[walked++];
+    }
+
+  finfo("Indexed %u entries in %u slots\n",
+        (unsigned int)rm->rm_indexcount,
+        (unsigned int)(rm->rm_indexmask + 1));
+
+  if (dirs != NULL)
+    {
+      kmm_free(dirs);
+    }
+
+  return OK;
+
+errout:
+  if (dirs != NULL)
+    {
+      kmm_free(dirs);
+    }
+
+  kmm_free(rm->rm_index);
+  rm->rm_index      = NULL;
+  rm->rm_indexmask  = 0;
+  rm->rm_indexcount = 0;
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: romfs_freecache
+ *
+ * Description:
+ *   Release the directory index and the path cache, if any.  This is
+ *   called when the volume is unmounted.
+ *
+ ****************************************************************************/
+
+void romfs_freecache(FAR struct romfs_mountpt_s *rm)
+{
+#if CONFIG_FS_ROMFS_DCACHE_NENTRIES > 0
+  int i;
+#endif
+
+#ifdef CONFIG_FS_ROMFS_INDEX
+  if (rm->rm_index != NULL)
+    {
+      kmm_free(rm->rm_index);
+      rm->rm_index = NULL;
+    }
+#endif
+
+#if CONFIG_FS_ROMFS_DCACHE_NENTRIES > 0
+  for (i = 0; i < CONFIG_FS_ROMFS_DCACHE_NENTRIES; i++)
+    {
+      if (rm->rm_dcache[i].rc_path != NULL)
+        {
+          kmm_free(rm->rm_dcache[i].rc_path);
+          rm->rm_dcache[i].rc_path = NULL;
+        }
+    }
+#endif
+}
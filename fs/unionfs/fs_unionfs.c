@@ -59,6 +59,26 @@
 #define MIN(a,b) (((a) < (b)) ? (a) : (b))
 #define MAX(a,b) (((a) > (b)) ? (a) : (b))
 
+#ifndef CONFIG_FS_UNIONFS_LOOKUP_NENTRIES
+#  define CONFIG_FS_UNIONFS_LOOKUP_NENTRIES 0
+#endif
+
+/* A cached lookup holds the index of the file system that contains the
+ * path, or UNIONFS_NOENT if neither one does.
+ */
+
+#define UNIONFS_NOENT            2
+
+/* Initial number of hash chains in the set of names enumerated on file
+ * system 1 by readdir().
+ */
+
+#define UNIONFS_NAMESET_NBUCKETS 16
+
+/* Size of the buffer used to copy file content up to file system 1 */
+
+#define UNIONFS_COPYUP_BUFSIZE   512
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -71,6 +91,17 @@ struct unionfs_mountpt_s
   FAR char *um_prefix;               /* Path prefix to filesystem */
 };
 
+#if CONFIG_FS_UNIONFS_LOOKUP_NENTRIES > 0
+/* This structure describes one cached lookup */
+
+struct unionfs_lookup_s
+{
+  FAR char *ul_path;                 /* Relative path, NULL if unused */
+  uint32_t ul_hash;                  /* Hash of ul_path */
+  uint8_t ul_ndx;                    /* File system index or UNIONFS_NOENT */
+};
+#endif
+
 /* This structure describes the union file system */
 
 struct unionfs_inode_s
@@ -79,6 +110,10 @@ struct unionfs_inode_s
   sem_t ui_exclsem;                  /* Enforces mutually exclusive access */
   int16_t ui_nopen;                  /* Number of open references */
   bool ui_unmounted;                 /* File system has been unmounted */
+#if CONFIG_FS_UNIONFS_LOOKUP_NENTRIES > 0
+  uint16_t ui_lookupnext;            /* Next lookup cache entry to replace */
+  struct unionfs_lookup_s ui_lookup[CONFIG_FS_UNIONFS_LOOKUP_NENTRIES];
+#endif
 };
 
 /* This structure descries one opened file */
@@ -89,6 +124,28 @@ struct unionfs_file_s
   FAR struct file uf_file;          /* Filesystem open file description */
 };
 
+/* This structure describes one name enumerated on file system 1 */
+
+struct unionfs_name_s
+{
+  FAR struct unionfs_name_s *un_flink;    /* Next name in the hash chain */
+  uint32_t un_hash;                       /* Hash of un_name */
+  char un_name[1];                        /* Name (variable length) */
+};
+
+/* This structure holds the names enumerated on file system 1 while reading
+ * a directory that exists on both file systems.  The entries of the same
+ * names on file system 2 are occluded and must be skipped.
+ */
+
+struct unionfs_nameset_s
+{
+  FAR struct unionfs_name_s **ns_buckets; /* Hash chains */
+  uint32_t ns_nbuckets;                   /* Number of chains (power of 2) */
+  uint32_t ns_count;                      /* Number of names in the set */
+  bool ns_incomplete;                     /* True: A name was not added */
+};
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -127,6 +184,29 @@ static int     unionfs_trystatfile(FAR struct inode *inode,
                  FAR const char *relpath, FAR const char *prefix);
 static FAR char *unionfs_relpath(FAR const char *path,
                  FAR const char *name);
+static uint32_t unionfs_hash(FAR const char *str);
+#if CONFIG_FS_UNIONFS_LOOKUP_NENTRIES > 0
+static int     unionfs_lookup(FAR struct unionfs_inode_s *ui,
+                 FAR const char *relpath);
+static void    unionfs_remember(FAR struct unionfs_inode_s *ui,
+                 FAR const char *relpath, int ndx);
+static void    unionfs_forget(FAR struct unionfs_inode_s *ui);
+#else
+#  define      unionfs_lookup(ui,relpath) (-ENOENT)
+#  define      unionfs_remember(ui,relpath,ndx)
+#  define      unionfs_forget(ui)
+#endif
+static void    unionfs_addname(FAR struct fs_unionfsdir_s *fu,
+                 FAR const char *name);
+static bool    unionfs_isduplicate(FAR struct unionfs_inode_s *ui,
+                 FAR struct fs_unionfsdir_s *fu, FAR const char *name);
+static void    unionfs_clearnames(FAR struct unionfs_nameset_s *ns);
+#ifdef CONFIG_FS_UNIONFS_COPYUP
+static int     unionfs_mkparents(FAR struct unionfs_inode_s *ui,
+                 FAR const char *relpath);
+static int     unionfs_copyup(FAR struct unionfs_inode_s *ui,
+                 FAR const char *relpath, int oflags);
+#endif
 
 static int     unionfs_unbind_child(FAR struct unionfs_mountpt_s *um);
 static void    unionfs_destroy(FAR struct unionfs_inode_s *ui);
@@ -716,6 +796,512 @@ static FAR char *unionfs_relpath(FAR const char *path, FAR const char *name)
     }
 }
 
+/****************************************************************************
+ * Name: unionfs_hash
+ *
+ * Description:
+ *   Return the FNV-1a hash of a NUL-terminated string.
+ *
+ ****************************************************************************/
+
+static uint32_t unionfs_hash(FAR const char *str)
+{
+  uint32_t hash = 2166136261u;
+
+  while (*str != '\0')
+    {
+      hash ^= (uint8_t)*str++;
+      hash *= 16777619u;
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Name: unionfs_lookup
+ *
+ * Description:
+ *   Return the cached index of the file system that holds 'relpath',
+ *   UNIONFS_NOENT if it is known to exist on neither file system, or
+ *   -ENOENT if the path is not in the cache.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_UNIONFS_LOOKUP_NENTRIES > 0
+static int unionfs_lookup(FAR struct unionfs_inode_s *ui,
+                          FAR const char *relpath)
+{
+  FAR struct unionfs_lookup_s *ul;
+  uint32_t hash;
+  int i;
+
+  if (relpath == NULL || relpath[0] == '\0')
+    {
+      return -ENOENT;
+    }
+
+  hash = unionfs_hash(relpath);
+  for (i = 0; i < CONFIG_FS_UNIONFS_LOOKUP_NENTRIES; i++)
+    {
+      ul = &ui->ui_lookup[i];
+      if (ul->ul_path != NULL && ul->ul_hash == hash &&
+          strcmp(ul->ul_path, relpath) == 0)
+        {
+          return ul->ul_ndx;
+        }
+    }
+
+  return -ENOENT;
+}
+#endif
+
+/****************************************************************************
+ * Name: unionfs_remember
+ *
+ * Description:
+ *   Record in the lookup cache that 'relpath' is held by file system 'ndx'
+ *   (or by neither if 'ndx' is UNIONFS_NOENT), replacing the oldest entry.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_UNIONFS_LOOKUP_NENTRIES > 0
+static void unionfs_remember(FAR struct unionfs_inode_s *ui,
+                             FAR const char *relpath, int ndx)
+{
+  FAR struct unionfs_lookup_s *ul;
+  size_t len;
+
+  if (relpath == NULL || relpath[0] == '\0' ||
+      unionfs_lookup(ui, relpath) >= 0)
+    {
+      return;
+    }
+
+  ul = &ui->ui_lookup[ui->ui_lookupnext];
+  if (++ui->ui_lookupnext >= CONFIG_FS_UNIONFS_LOOKUP_NENTRIES)
+    {
+      ui->ui_lookupnext = 0;
+    }
+
+  if (ul->ul_path != NULL)
+    {
+      kmm_free(ul->ul_path);
+    }
+
+  /* If the path cannot be copied, the entry is simply left unused */
+
+  len         = strlen(relpath) + 1;
+  ul->ul_path = (FAR char *)kmm_malloc(len);
+  if (ul->ul_path != NULL)
+    {
+      memcpy(ul->ul_path, relpath, len);
+      ul->ul_hash = unionfs_hash(relpath);
+      ul->ul_ndx  = (uint8_t)ndx;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: unionfs_forget
+ *
+ * Description:
+ *   Flush the lookup cache.  This must be done by every operation that
+ *   may create or remove a name on either file system.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_UNIONFS_LOOKUP_NENTRIES > 0
+static void unionfs_forget(FAR struct unionfs_inode_s *ui)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FS_UNIONFS_LOOKUP_NENTRIES; i++)
+    {
+      if (ui->ui_lookup[i].ul_path != NULL)
+        {
+          kmm_free(ui->ui_lookup[i].ul_path);
+          ui->ui_lookup[i].ul_path = NULL;
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: unionfs_addname
+ *
+ * Description:
+ *   Add a name enumerated on file system 1 to the name set of an open
+ *   directory.  If the name cannot be added, the set is marked incomplete
+ *   and unionfs_isduplicate() falls back to probing file system 1.
+ *
+ ****************************************************************************/
+
+static void unionfs_addname(FAR struct fs_unionfsdir_s *fu,
+                            FAR const char *name)
+{
+  FAR struct unionfs_nameset_s *ns = fu->fu_names;
+  FAR struct unionfs_name_s **buckets;
+  FAR struct unionfs_name_s *un;
+  FAR struct unionfs_name_s *next;
+  uint32_t nbuckets;
+  uint32_t i;
+
+  if (ns == NULL || ns->ns_incomplete)
+    {
+      return;
+    }
+
+  /* Double the number of hash chains when they average more than two
+   * names.  If that fails, the chains just get longer.
+   */
+
+  if (ns->ns_count >= 2 * ns->ns_nbuckets)
+    {
+      nbuckets = 2 * ns->ns_nbuckets;
+      buckets  = (FAR struct unionfs_name_s **)
+        kmm_zalloc(nbuckets * sizeof(FAR struct unionfs_name_s *));
+      if (buckets != NULL)
+        {
+          for (i = 0; i < ns->ns_nbuckets; i++)
+            {
+              for (un = ns->ns_buckets[i]; un != NULL; un = next)
+                {
+                  next = un->un_flink;
+                  un->un_flink = buckets[un->un_hash & (nbuckets - 1)];
+                  buckets[un->un_hash & (nbuckets - 1)] = un;
+                }
+            }
+
+          kmm_free(ns->ns_buckets);
+          ns->ns_buckets  = buckets;
+          ns->ns_nbuckets = nbuckets;
+        }
+    }
+
+  un = (FAR struct unionfs_name_s *)
+    kmm_malloc(sizeof(struct unionfs_name_s) + strlen(name));
+  if (un == NULL)
+    {
+      ns->ns_incomplete = true;
+      return;
+    }
+
+  strcpy(un->un_name, name);
+  un->un_hash  = unionfs_hash(name);
+  i            = un->un_hash & (ns->ns_nbuckets - 1);
+  un->un_flink = ns->ns_buckets[i];
+  ns->ns_buckets[i] = un;
+  ns->ns_count++;
+}
+
+/****************************************************************************
+ * Name: unionfs_isduplicate
+ *
+ * Description:
+ *   Return true if 'name', enumerated in the directory on file system 2,
+ *   also exists in the same directory on file system 1 and so must be
+ *   omitted from the merged listing.
+ *
+ ****************************************************************************/
+
+static bool unionfs_isduplicate(FAR struct unionfs_inode_s *ui,
+                                FAR struct fs_unionfsdir_s *fu,
+                                FAR const char *name)
+{
+  FAR struct unionfs_nameset_s *ns = fu->fu_names;
+  FAR struct unionfs_mountpt_s *um0;
+  FAR struct unionfs_name_s *un;
+  FAR char *relpath;
+  struct stat buf;
+  uint32_t hash;
+  int ret;
+
+  /* Check the names enumerated on file system 1, if all of them were
+   * recorded.
+   */
+
+  if (ns != NULL && !ns->ns_incomplete)
+    {
+      hash = unionfs_hash(name);
+      for (un = ns->ns_buckets[hash & (ns->ns_nbuckets - 1)];
+           un != NULL;
+           un = un->un_flink)
+        {
+          if (un->un_hash == hash && strcmp(un->un_name, name) == 0)
+            {
+              return true;
+            }
+        }
+
+      return false;
+    }
+
+  /* Otherwise, check if anything exists at this path on file system 1.
+   * NOTE: On any failures we just assume that the name is not a
+   * duplicate.
+   */
+
+  relpath = unionfs_relpath(fu->fu_relpath, name);
+  if (relpath == NULL)
+    {
+      return false;
+    }
+
+  um0 = &ui->ui_fs[0];
+  ret = unionfs_trystat(um0->um_node, relpath, um0->um_prefix, &buf);
+  kmm_free(relpath);
+
+  /* REVISIT: We could allow files and directories to have duplicate
+   * names.
+   */
+
+  return ret >= 0;
+}
+
+/****************************************************************************
+ * Name: unionfs_clearnames
+ *
+ * Description:
+ *   Remove all names from a name set.
+ *
+ ****************************************************************************/
+
+static void unionfs_clearnames(FAR struct unionfs_nameset_s *ns)
+{
+  FAR struct unionfs_name_s *un;
+  FAR struct unionfs_name_s *next;
+  uint32_t i;
+
+  for (i = 0; i < ns->ns_nbuckets; i++)
+    {
+      for (un = ns->ns_buckets[i]; un != NULL; un = next)
+        {
+          next = un->un_flink;
+          kmm_free(un);
+        }
+
+      ns->ns_buckets[i] = NULL;
+    }
+
+  ns->ns_count      = 0;
+  ns->ns_incomplete = false;
+}
+
+/****************************************************************************
+ * Name: unionfs_mkparents
+ *
+ * Description:
+ *   Create on file system 1 any missing parent directories of 'relpath',
+ *   using the modes of the same directories on file system 2.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_UNIONFS_COPYUP
+static int unionfs_mkparents(FAR struct unionfs_inode_s *ui,
+                             FAR const char *relpath)
+{
+  FAR struct unionfs_mountpt_s *um0 = &ui->ui_fs[0];
+  FAR struct unionfs_mountpt_s *um1 = &ui->ui_fs[1];
+  struct stat buf;
+  FAR char *path;
+  FAR char *sep;
+  mode_t mode;
+  int ret = OK;
+
+  path = unionfs_relpath(NULL, relpath);
+  if (path == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (sep = strchr(path, '/'); sep != NULL; sep = strchr(sep + 1, '/'))
+    {
+      if (sep == path)
+        {
+          continue;
+        }
+
+      /* Temporarily terminate the path at this separator */
+
+      *sep = '\0';
+
+      ret = unionfs_trystat(um0->um_node, path, um0->um_prefix, &buf);
+      if (ret == -ENOENT)
+        {
+          mode = 0777;
+          if (unionfs_trystat(um1->um_node, path, um1->um_prefix,
+                              &buf) >= 0)
+            {
+              mode = buf.st_mode & 0777;
+            }
+
+          ret = unionfs_trymkdir(um0->um_node, path, um0->um_prefix, mode);
+        }
+
+      *sep = '/';
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  kmm_free(path);
+  return ret < 0 ? ret : OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: unionfs_copyup
+ *
+ * Description:
+ *   If 'relpath' is a regular file that exists on file system 2 but not on
+ *   file system 1, copy it to file system 1 so that a subsequent open for
+ *   writing will find the copy.  The content is not copied if 'oflags'
+ *   includes O_TRUNC.
+ *
+ * Returned Value:
+ *   Zero (OK) if there was nothing to copy or the copy was made; a negated
+ *   errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_UNIONFS_COPYUP
+static int unionfs_copyup(FAR struct unionfs_inode_s *ui,
+                          FAR const char *relpath, int oflags)
+{
+  FAR struct unionfs_mountpt_s *um0 = &ui->ui_fs[0];
+  FAR struct unionfs_mountpt_s *um1 = &ui->ui_fs[1];
+  FAR const struct mountpt_operations *ops0 = um0->um_node->u.i_mops;
+  FAR const struct mountpt_operations *ops1 = um1->um_node->u.i_mops;
+  FAR char *iobuf = NULL;
+  struct file dest;
+  struct file src;
+  struct stat buf;
+  ssize_t nread;
+  ssize_t nwritten;
+  ssize_t ofs;
+  int ret;
+
+  /* Nothing to do if the file is already on file system 1 or if it is
+   * not a regular file on file system 2.
+   */
+
+  ret = unionfs_trystat(um0->um_node, relpath, um0->um_prefix, &buf);
+  if (ret != -ENOENT)
+    {
+      return ret < 0 ? ret : OK;
+    }
+
+  ret = unionfs_trystat(um1->um_node, relpath, um1->um_prefix, &buf);
+  if (ret < 0 || !S_ISREG(buf.st_mode))
+    {
+      return ret < 0 ? ret : OK;
+    }
+
+  if (ops0->write == NULL || ops1->read == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  /* Names are about to be created on file system 1 */
+
+  unionfs_forget(ui);
+
+  ret = unionfs_mkparents(ui, relpath);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Create the copy on file system 1 */
+
+  memset(&dest, 0, sizeof(struct file));
+  dest.f_oflags = O_WRONLY | O_CREAT | O_TRUNC;
+  dest.f_inode  = um0->um_node;
+
+  ret = unionfs_tryopen(&dest, relpath, um0->um_prefix, dest.f_oflags,
+                        buf.st_mode & 0777);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Then copy the content unless it is about to be truncated anyway */
+
+  if ((oflags & O_TRUNC) == 0 && buf.st_size > 0)
+    {
+      iobuf = (FAR char *)kmm_malloc(UNIONFS_COPYUP_BUFSIZE);
+      if (iobuf == NULL)
+        {
+          ret = -ENOMEM;
+          goto errout_with_dest;
+        }
+
+      memset(&src, 0, sizeof(struct file));
+      src.f_oflags = O_RDONLY;
+      src.f_inode  = um1->um_node;
+
+      ret = unionfs_tryopen(&src, relpath, um1->um_prefix, O_RDONLY, 0);
+      if (ret < 0)
+        {
+          goto errout_with_iobuf;
+        }
+
+      do
+        {
+          nread = ops1->read(&src, iobuf, UNIONFS_COPYUP_BUFSIZE);
+          for (ofs = 0; ofs < nread; ofs += nwritten)
+            {
+              nwritten = ops0->write(&dest, iobuf + ofs, nread - ofs);
+              if (nwritten <= 0)
+                {
+                  nread = nwritten < 0 ? nwritten : -EIO;
+                  break;
+                }
+            }
+        }
+      while (nread > 0);
+
+      if (ops1->close != NULL)
+        {
+          ops1->close(&src);
+        }
+
+      ret = nread;
+      if (ret < 0)
+        {
+          goto errout_with_iobuf;
+        }
+
+      kmm_free(iobuf);
+    }
+
+  if (ops0->close != NULL)
+    {
+      ret = ops0->close(&dest);
+      if (ret < 0)
+        {
+          unionfs_tryunlink(um0->um_node, relpath, um0->um_prefix);
+          return ret;
+        }
+    }
+
+  return OK;
+
+errout_with_iobuf:
+  kmm_free(iobuf);
+
+errout_with_dest:
+  if (ops0->close != NULL)
+    {
+      ops0->close(&dest);
+    }
+
+  unionfs_tryunlink(um0->um_node, relpath, um0->um_prefix);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: unionfs_unbind_child
  ****************************************************************************/
@@ -795,7 +1381,9 @@ static void unionfs_destroy(FAR struct unionfs_inode_s *ui)
   unionfs_unbind_child(&ui->ui_fs[0]);
   unionfs_unbind_child(&ui->ui_fs[1]);
 
-  /* Free any allocated prefix strings */
+  /* Free the lookup cache and any allocated prefix strings */
+
+  unionfs_forget(ui);
 
   if (ui->ui_fs[0].um_prefix)
     {
@@ -823,6 +1411,8 @@ static int unionfs_open(FAR struct file *filep, FAR const char *relpath,
   FAR struct unionfs_inode_s *ui;
   FAR struct unionfs_file_s *uf;
   FAR struct unionfs_mountpt_s *um;
+  int ret0 = -ENOENT;
+  int ndx;
   int ret;
 
   /* Recover the open file data from the struct file instance */
@@ -850,19 +1440,53 @@ static int unionfs_open(FAR struct file *filep, FAR const char *relpath,
       goto errout_with_semaphore;
     }
 
-  /* Try to open the file on file system 1 */
+#ifdef CONFIG_FS_UNIONFS_COPYUP
+  /* If a file that exists only on file system 2 is being opened for
+   * writing, copy it up to file system 1 first so that the writes land
+   * there.  If that fails, just carry on as before.
+   */
 
-  um = &ui->ui_fs[0];
-  DEBUGASSERT(um != NULL && um->um_node != NULL &&
-              um->um_node->u.i_mops != NULL);
+  if ((oflags & O_WROK) != 0)
+    {
+      ret = unionfs_copyup(ui, relpath, oflags);
+      if (ret < 0)
+        {
+          fwarn("WARNING: Copy-up of %s failed: %d\n", relpath, ret);
+        }
+    }
+#endif
 
-  uf->uf_file.f_oflags = filep->f_oflags;
-  uf->uf_file.f_pos    = 0;
-  uf->uf_file.f_inode  = um->um_node;
-  uf->uf_file.f_priv   = NULL;
+  /* Check if we already know which file system holds this path.  The
+   * cache is not used with O_CREAT which may create the file.
+   */
 
-  ret = unionfs_tryopen(&uf->uf_file, relpath, um->um_prefix, oflags, mode);
-  if (ret >= 0)
+  ndx = (oflags & O_CREAT) == 0 ? unionfs_lookup(ui, relpath) : -ENOENT;
+  if (ndx == UNIONFS_NOENT)
+    {
+      ret = -ENOENT;
+      goto errout_with_uf;
+    }
+
+  /* Try to open the file on file system 1 (unless it is known to be on
+   * file system 2).
+   */
+
+  if (ndx != 1)
+    {
+      um = &ui->ui_fs[0];
+      DEBUGASSERT(um != NULL && um->um_node != NULL &&
+                  um->um_node->u.i_mops != NULL);
+
+      uf->uf_file.f_oflags = filep->f_oflags;
+      uf->uf_file.f_pos    = 0;
+      uf->uf_file.f_inode  = um->um_node;
+      uf->uf_file.f_priv   = NULL;
+
+      ret0 = unionfs_tryopen(&uf->uf_file, relpath, um->um_prefix, oflags,
+                             mode);
+    }
+
+  if (ret0 >= 0)
     {
       /* Successfully opened on file system 1 */
 
@@ -870,7 +1494,7 @@ static int unionfs_open(FAR struct file *filep, FAR const char *relpath,
     }
   else
     {
-      /* Try to open the file on file system 1 */
+      /* Try to open the file on file system 2 */
 
       um  = &ui->ui_fs[1];
 
@@ -883,14 +1507,33 @@ static int unionfs_open(FAR struct file *filep, FAR const char *relpath,
                             mode);
       if (ret < 0)
         {
-          goto errout_with_semaphore;
+          if (ret0 == -ENOENT && ret == -ENOENT && (oflags & O_CREAT) == 0)
+            {
+              unionfs_remember(ui, relpath, UNIONFS_NOENT);
+            }
+
+          goto errout_with_uf;
         }
 
-      /* Successfully opened on file system 1 */
+      /* Successfully opened on file system 2 */
 
       uf->uf_ndx = 1;
     }
 
+  /* Creating a file invalidates the lookup cache.  Otherwise, remember
+   * where the file was found if file system 1 definitely does not hold
+   * it.
+   */
+
+  if ((oflags & O_CREAT) != 0)
+    {
+      unionfs_forget(ui);
+    }
+  else if (uf->uf_ndx == 0 || ret0 == -ENOENT)
+    {
+      unionfs_remember(ui, relpath, uf->uf_ndx);
+    }
+
   /* Increment the open reference count */
 
   ui->ui_nopen++;
@@ -899,7 +1542,11 @@ static int unionfs_open(FAR struct file *filep, FAR const char *relpath,
   /* Save our private data in the file structure */
 
   filep->f_priv = (FAR void *)uf;
-  ret = OK;
+  unionfs_semgive(ui);
+  return OK;
+
+errout_with_uf:
+  kmm_free(uf);
 
 errout_with_semaphore:
   unionfs_semgive(ui);
@@ -1553,6 +2200,31 @@ static int unionfs_opendir(FAR struct inode *mountpt,
         }
     }
 
+  /* If the directory exists on both file systems, then readdir() will
+   * collect the names on file system 1 so that it can omit the occluded
+   * entries of file system 2.  Without the name set, it falls back to
+   * looking up each file system 2 entry on file system 1.
+   */
+
+  if ((fu->fu_lower[0] != NULL || fu->fu_prefix[0]) &&
+      (fu->fu_lower[1] != NULL || fu->fu_prefix[1]))
+    {
+      fu->fu_names = (FAR struct unionfs_nameset_s *)
+        kmm_zalloc(sizeof(struct unionfs_nameset_s));
+      if (fu->fu_names != NULL)
+        {
+          fu->fu_names->ns_nbuckets = UNIONFS_NAMESET_NBUCKETS;
+          fu->fu_names->ns_buckets  = (FAR struct unionfs_name_s **)
+            kmm_zalloc(UNIONFS_NAMESET_NBUCKETS *
+                       sizeof(FAR struct unionfs_name_s *));
+          if (fu->fu_names->ns_buckets == NULL)
+            {
+              kmm_free(fu->fu_names);
+              fu->fu_names = NULL;
+            }
+        }
+    }
+
   /* Increment the number of open references and return success */
 
   ui->ui_nopen++;
@@ -1641,17 +2313,25 @@ static int unionfs_closedir(FAR struct inode *mountpt,
         }
     }
 
-  /* Free any allocated path */
+  /* Free any allocated path and name set */
 
   if (fu->fu_relpath != NULL)
     {
       kmm_free(fu->fu_relpath);
     }
 
+  if (fu->fu_names != NULL)
+    {
+      unionfs_clearnames(fu->fu_names);
+      kmm_free(fu->fu_names->ns_buckets);
+      kmm_free(fu->fu_names);
+    }
+
   fu->fu_ndx      = 0;
   fu->fu_relpath  = NULL;
   fu->fu_lower[0] = NULL;
   fu->fu_lower[1] = NULL;
+  fu->fu_names    = NULL;
 
   /* Decrement the count of open reference.  If that count would go to zero
    * and if the file system has been unmounted, then destroy the file system
@@ -1678,11 +2358,8 @@ static int unionfs_readdir(struct inode *mountpt, struct fs_dirent_s *dir)
 {
   FAR struct unionfs_inode_s *ui;
   FAR struct unionfs_mountpt_s *um;
-  FAR struct unionfs_mountpt_s *um0;
   FAR const struct mountpt_operations *ops;
   FAR struct fs_unionfsdir_s *fu;
-  FAR char *relpath;
-  struct stat buf;
   bool duplicate;
   int ret = -ENOSYS;
 
@@ -1729,6 +2406,13 @@ static int unionfs_readdir(struct inode *mountpt, struct fs_dirent_s *dir)
 
       dir->fd_dir.d_type = DTYPE_DIRECTORY;
 
+      /* Record the names reported for file system 1 */
+
+      if (fu->fu_ndx == 0)
+        {
+          unionfs_addname(fu, dir->fd_dir.d_name);
+        }
+
       /* Increment the index to file system 2 (maybe) */
 
       if (fu->fu_ndx == 0 && (fu->fu_prefix[1] || fu->fu_lower[1] != NULL))
@@ -1811,32 +2495,9 @@ static int unionfs_readdir(struct inode *mountpt, struct fs_dirent_s *dir)
                    * in file system 1.
                    */
 
-                  relpath = unionfs_relpath(fu->fu_relpath, um->um_prefix);
-                  if (relpath)
+                  if (unionfs_isduplicate(ui, fu, um->um_prefix))
                     {
-                      int tmp;
-
-                      /* Check if anything exists at this path on file system 1 */
-
-                      um0 = &ui->ui_fs[0];
-                      tmp = unionfs_trystat(um0->um_node, relpath,
-                                            um0->um_prefix, &buf);
-
-                      /* Free the allocated relpath */
-
-                      kmm_free(relpath);
-
-                      /* Check for a duplicate */
-
-                      if (tmp >= 0)
-                        {
-                          /* There is something there!
-                           * REVISIT: We could allow files and directories to
-                           * have duplicate names.
-                           */
-
-                          return -ENOENT;
-                        }
+                      return -ENOENT;
                     }
 
                   return OK;
@@ -1880,36 +2541,14 @@ static int unionfs_readdir(struct inode *mountpt, struct fs_dirent_s *dir)
           duplicate = false;
           if (ret >= 0 && fu->fu_ndx == 1 && fu->fu_lower[0] != NULL)
             {
-              /* Get the relative path to the same file on file system 1.
-               * NOTE: the on any failures we just assume that the filep
-               * is not a duplicate.
-               */
-
-              relpath = unionfs_relpath(fu->fu_relpath,
+              duplicate = unionfs_isduplicate(ui, fu,
                                         fu->fu_lower[1]->fd_dir.d_name);
-              if (relpath)
-                {
-                  int tmp;
-
-                  /* Check if anything exists at this path on file system 1 */
-
-                  um0 = &ui->ui_fs[0];
-                  tmp = unionfs_trystat(um0->um_node, relpath,
-                                        um0->um_prefix, &buf);
-                  if (tmp >= 0)
-                    {
-                      /* There is something there!
-                       * REVISIT: We could allow files and directories to
-                       * have duplicate names.
-                       */
-
-                      duplicate = true;
-                    }
-
-                  /* Free the allocated relpath */
+            }
+          else if (ret >= 0 && fu->fu_ndx == 0)
+            {
+              /* Record the names enumerated on file system 1 */
 
-                  kmm_free(relpath);
-                }
+              unionfs_addname(fu, fu->fu_lower[0]->fd_dir.d_name);
             }
         }
       while (duplicate);
@@ -1968,6 +2607,13 @@ static int unionfs_rewinddir(struct inode *mountpt, struct fs_dirent_s *dir)
       fu->fu_ndx = 0;
     }
 
+  /* The names on file system 1 will be collected again */
+
+  if (fu->fu_names != NULL)
+    {
+      unionfs_clearnames(fu->fu_names);
+    }
+
   if (!fu->fu_prefix[fu->fu_ndx])
     {
       DEBUGASSERT(fu->fu_lower[fu->fu_ndx] != NULL);
@@ -2262,6 +2908,10 @@ static int unionfs_unlink(FAR struct inode *mountpt,
       return ret;
     }
 
+  /* Names may be created or removed, so flush the lookup cache */
+
+  unionfs_forget(ui);
+
   /* Check if some exists at this path on file system 1.  This might be
    * a file or a directory
    */
@@ -2335,6 +2985,10 @@ static int unionfs_mkdir(FAR struct inode *mountpt, FAR const char *relpath,
       return ret;
     }
 
+  /* Names may be created or removed, so flush the lookup cache */
+
+  unionfs_forget(ui);
+
   /* Is there anything with this name on either file system? */
 
   um  = &ui->ui_fs[0];
@@ -2409,6 +3063,10 @@ static int unionfs_rmdir(FAR struct inode *mountpt, FAR const char *relpath)
       return ret;
     }
 
+  /* Names may be created or removed, so flush the lookup cache */
+
+  unionfs_forget(ui);
+
   ret = -ENOENT;
 
   /* We really don't know any better so we will try to remove the directory
@@ -2484,6 +3142,10 @@ static int unionfs_rename(FAR struct inode *mountpt,
       return ret;
     }
 
+  /* Names may be created or removed, so flush the lookup cache */
+
+  unionfs_forget(ui);
+
   DEBUGASSERT(oldrelpath != NULL && oldrelpath != NULL);
 
   /* Is there a file with this name on file system 1 */
@@ -2541,6 +3203,8 @@ static int unionfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
 {
   FAR struct unionfs_inode_s *ui;
   FAR struct unionfs_mountpt_s *um;
+  int ret0 = -ENOENT;
+  int ndx;
   int ret;
 
   finfo("relpath: %s\n", relpath);
@@ -2559,18 +3223,36 @@ static int unionfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
       return ret;
     }
 
-  /* stat this path on file system 1 */
+  /* Check if we already know which file system holds this path.  Negative
+   * entries are only cached for paths that are not "fake" prefix nodes
+   * either.
+   */
 
-  um  = &ui->ui_fs[0];
-  ret = unionfs_trystat(um->um_node, relpath, um->um_prefix, buf);
-  if (ret >= 0)
+  ndx = unionfs_lookup(ui, relpath);
+  if (ndx == UNIONFS_NOENT)
     {
-      /* Return on the first success.  The first instance of the file will
-       * shadow the second anyway.
-       */
-
       unionfs_semgive(ui);
-      return OK;
+      return -ENOENT;
+    }
+
+  /* stat this path on file system 1 (unless it is known to be on file
+   * system 2).
+   */
+
+  if (ndx != 1)
+    {
+      um   = &ui->ui_fs[0];
+      ret0 = unionfs_trystat(um->um_node, relpath, um->um_prefix, buf);
+      if (ret0 >= 0)
+        {
+          /* Return on the first success.  The first instance of the file
+           * will shadow the second anyway.
+           */
+
+          unionfs_remember(ui, relpath, 0);
+          unionfs_semgive(ui);
+          return OK;
+        }
     }
 
   /* stat failed on the file system 1.  Try again on file system 2. */
@@ -2583,6 +3265,11 @@ static int unionfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
        * shadow the second anyway.
        */
 
+      if (ret0 == -ENOENT)
+        {
+          unionfs_remember(ui, relpath, 1);
+        }
+
       unionfs_semgive(ui);
       return OK;
     }
@@ -2616,6 +3303,13 @@ static int unionfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
         }
     }
 
+  /* Remember paths that exist on neither file system */
+
+  if (ret == -ENOENT && ret0 == -ENOENT)
+    {
+      unionfs_remember(ui, relpath, UNIONFS_NOENT);
+    }
+
   unionfs_semgive(ui);
   return ret;
 }
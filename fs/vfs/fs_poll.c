@@ -46,6 +46,7 @@
 #include <errno.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/hrtimer.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/cancelpt.h>
 #include <nuttx/fs/fs.h>
@@ -460,6 +461,19 @@ int poll(FAR struct pollfd *fds, nfds_t nfds, int timeout)
         }
       else if (timeout > 0)
         {
+#ifdef CONFIG_HRTIMER
+          /* Either wait for either a poll event(s), for a signal to occur,
+           * or for the specified timeout to elapse with no event.  With
+           * high resolution timers, the timeout is not rounded to ticks.
+           *
+           * NOTE: If a poll event is pending (i.e., the semaphore has
+           * already been incremented), nxsem_hrtimedwait() will not wait,
+           * but will return immediately.
+           */
+
+          ret = nxsem_hrtimedwait(&sem, hrtimer_now() +
+                                  (uint64_t)timeout * NSEC_PER_MSEC);
+#else
           clock_t ticks;
 
           /* "Implementations may place limitations on the granularity of
@@ -490,6 +504,7 @@ int poll(FAR struct pollfd *fds, nfds_t nfds, int timeout)
            */
 
           ret = nxsem_tickwait(&sem, clock_systimer(), ticks);
+#endif
           if (ret < 0)
             {
               if (ret == -ETIMEDOUT)
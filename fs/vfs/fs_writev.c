@@ -0,0 +1,316 @@
+/****************************************************************************
+ * fs/vfs/fs_writev.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "inode/inode.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: writev_check
+ *
+ * Description:
+ *   Verify that the iovec array is usable.  The total length must fit in
+ *   the ssize_t that is returned.
+ *
+ ****************************************************************************/
+
+static int writev_check(FAR const struct iovec *iov, int iovcnt)
+{
+  size_t total = 0;
+  int i;
+
+  if (iovcnt < 0 || (iovcnt > 0 && iov == NULL))
+    {
+      return -EINVAL;
+    }
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len > SSIZE_MAX - total)
+        {
+          return -EINVAL;
+        }
+
+      total += iov[i].iov_len;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_writev
+ *
+ * Description:
+ *   Equivalent to the standard writev() function except that it accepts a
+ *   struct file instance instead of a file descriptor, does not modify the
+ *   errno variable and is not a cancellation point.
+ *
+ *   The driver's writev() method is used if it has one.  Otherwise each
+ *   segment is written in turn until one comes up short.
+ *
+ * Returned Value:
+ *   The number of bytes written, or a negated errno value if nothing was
+ *   written.
+ *
+ ****************************************************************************/
+
+ssize_t file_writev(FAR struct file *filep, FAR const struct iovec *iov,
+                   int iovcnt)
+{
+  FAR struct inode *inode;
+  ssize_t ntotal = 0;
+  ssize_t nwritten;
+  int ret;
+  int i;
+
+  DEBUGASSERT(filep);
+  inode = filep->f_inode;
+
+  ret = writev_check(iov, iovcnt);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if ((filep->f_oflags & O_WROK) == 0)
+    {
+      return -EACCES;
+    }
+
+  if (inode == NULL || inode->u.i_ops == NULL)
+    {
+      return -EBADF;
+    }
+
+  /* Only character drivers have the vectored methods */
+
+#ifndef CONFIG_DISABLE_MOUNTPOINT
+  if (!INODE_IS_MOUNTPT(inode) && inode->u.i_ops->writev != NULL)
+#else
+  if (inode->u.i_ops->writev != NULL)
+#endif
+    {
+      return inode->u.i_ops->writev(filep, iov, iovcnt);
+    }
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len == 0)
+        {
+          continue;
+        }
+
+      nwritten = file_write(filep, iov[i].iov_base, iov[i].iov_len);
+      if (nwritten < 0)
+        {
+          return ntotal > 0 ? ntotal : nwritten;
+        }
+
+      ntotal += nwritten;
+      if ((size_t)nwritten < iov[i].iov_len)
+        {
+          break;
+        }
+    }
+
+  return ntotal;
+}
+
+/****************************************************************************
+ * Name: file_pwritev
+ *
+ * Description:
+ *   file_writev() at an explicit file offset.  The file position is left
+ *   unchanged.
+ *
+ ****************************************************************************/
+
+ssize_t file_pwritev(FAR struct file *filep, FAR const struct iovec *iov,
+                    int iovcnt, off_t offset)
+{
+  off_t savepos;
+  off_t pos;
+  ssize_t ret;
+
+  /* Get the current position so that it can be restored */
+
+  savepos = file_seek(filep, 0, SEEK_CUR);
+  if (savepos < 0)
+    {
+      /* file_seek might fail if this if the media is not seekable */
+
+      return (ssize_t)savepos;
+    }
+
+  pos = file_seek(filep, offset, SEEK_SET);
+  if (pos < 0)
+    {
+      return (ssize_t)pos;
+    }
+
+  ret = file_writev(filep, iov, iovcnt);
+
+  /* Restore the file position */
+
+  pos = file_seek(filep, savepos, SEEK_SET);
+  if (pos < 0 && ret >= 0)
+    {
+      ret = (ssize_t)pos;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nx_writev
+ *
+ * Description:
+ *   writev() on a file or socket descriptor without modifying errno and
+ *   without being a cancellation point.
+ *
+ ****************************************************************************/
+
+ssize_t nx_writev(int fd, FAR const struct iovec *iov, int iovcnt)
+{
+  FAR struct file *filep;
+  ssize_t ret;
+
+  if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+#ifdef CONFIG_NET
+      /* writev() on a socket is a gathered send() with flags == 0 */
+
+      return psock_sendv(sockfd_socket(fd), iov, iovcnt, 0);
+#else
+      return -EBADF;
+#endif
+    }
+
+  ret = (ssize_t)fs_getfilep(fd, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return file_writev(filep, iov, iovcnt);
+}
+
+/****************************************************************************
+ * Name: writev
+ *
+ * Description:
+ *   The writev() function is equivalent to write(), except that it gathers
+ *   the output data from the 'iovcnt' buffers specified by the members of
+ *   the 'iov' array: iov[0], iov[1], ..., iov['iovcnt'-1].  See
+ *   include/sys/uio.h for the full description.
+ *
+ * Returned Value:
+ *   The number of bytes written on success; -1 with errno set on failure.
+ *
+ ****************************************************************************/
+
+ssize_t writev(int fildes, FAR const struct iovec *iov, int iovcnt)
+{
+  ssize_t ret;
+
+  /* writev() is a cancellation point */
+
+  enter_cancellation_point();
+
+  ret = nx_writev(fildes, iov, iovcnt);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pwritev
+ *
+ * Description:
+ *   writev() at an explicit file offset without changing the file offset.
+ *
+ * Returned Value:
+ *   The number of bytes written on success; -1 with errno set on failure.
+ *
+ ****************************************************************************/
+
+ssize_t pwritev(int fildes, FAR const struct iovec *iov, int iovcnt,
+               off_t offset)
+{
+  FAR struct file *filep;
+  ssize_t ret;
+
+  /* pwritev() is a cancellation point */
+
+  enter_cancellation_point();
+
+  if ((unsigned int)fildes >= CONFIG_NFILE_DESCRIPTORS)
+    {
+      /* Sockets cannot seek */
+
+      ret = -ESPIPE;
+    }
+  else
+    {
+      ret = (ssize_t)fs_getfilep(fildes, &filep);
+      if (ret >= 0)
+        {
+          ret = file_pwritev(filep, iov, iovcnt, offset);
+        }
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
@@ -58,22 +58,13 @@
 #  undef CONFIG_FS_AIO
 #endif
 
-/* Work queue support is required.  The low-priority work queue is required
- * so that the asynchronous I/O does not interfere with high priority driver
- * operations.  If this pre-requisite is met, then asynchronous I/O support
- * can be enabled with CONFIG_FS_AIO
+/* Asynchronous I/O is performed by a dedicated pool of kernel threads and
+ * so has no dependency on the work queues.  Asynchronous I/O support is
+ * enabled with CONFIG_FS_AIO
  */
 
 #ifdef CONFIG_FS_AIO
 
-#ifndef CONFIG_SCHED_WORKQUEUE
-#  error Asynchronous I/O requires CONFIG_SCHED_WORKQUEUE
-#endif
-
-#ifndef CONFIG_SCHED_LPWORK
-#  error Asynchronous I/O requires CONFIG_SCHED_LPWORK
-#endif
-
 /* Standard Definitions *****************************************************/
 /* aio_cancel return values
  *
@@ -140,6 +131,12 @@ struct aiocb
   struct sigwork_s aio_sigwork;  /* Signal work */
   volatile ssize_t aio_result;   /* Support for aio_error() and aio_return() */
   FAR void *aio_priv;            /* Used by signal handlers */
+
+  /* Called in place of the signal when the request was submitted from
+   * within the OS (see fs/aio/aio_ring.c).
+   */
+
+  CODE void (*aio_notify)(FAR struct aiocb *aiocbp);
 };
 
 /****************************************************************************
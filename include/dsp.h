@@ -46,6 +46,7 @@
 #include <string.h>
 #include <stdbool.h>
 #include <math.h>
+#include <fixedmath.h>
 
 #include <assert.h>
 
@@ -88,6 +89,10 @@
 #define ONE_BY_SQRT3_F     (0.57735f)
 #define TWO_BY_SQRT3_F     (1.15470f)
 
+#define SQRT3_BY_TWO_B16   (56756)     /* 0.866025 */
+#define ONE_BY_SQRT3_B16   (37837)     /* 0.577350 */
+#define TWO_BY_SQRT3_B16   (75674)     /* 1.154701 */
+
 /* Some lib constants *******************************************************/
 
 /* Motor electrical angle is in range 0.0 to 2*PI */
@@ -373,6 +378,287 @@ struct foc_data_s
   float vab_mod_scale;       /* Voltage alpha-beta modulation scale */
 };
 
+/* This structure represents a rotation quaternion */
+
+struct quat_s
+{
+  float w;                     /* Scalar component */
+  float x;                     /* X vector component */
+  float y;                     /* Y vector component */
+  float z;                     /* Z vector component */
+};
+
+typedef struct quat_s quat_t;
+
+/* Rotation quaternion in b16_t format */
+
+struct quat_b16_s
+{
+  b16_t w;                     /* Scalar component */
+  b16_t x;                     /* X vector component */
+  b16_t y;                     /* Y vector component */
+  b16_t z;                     /* Z vector component */
+};
+
+typedef struct quat_b16_s quat_b16_t;
+
+/* Quaternion complementary filter (Mahony) for a 6-DOF IMU.
+ * Gyroscope data is in rad/s, accelerometer data in any unit.
+ */
+
+struct ahrs_cf_s
+{
+  quat_t q;                    /* Attitude estimate */
+  float  kp2;                  /* Proportional gain multiplied by 2 */
+  float  kidt2;                /* Integral gain multiplied by 2*per */
+  float  halfdt;               /* Half of the filter execution period */
+  float  bias[3];              /* Integral feedback (gyroscope bias) */
+};
+
+/* Madgwick gradient descent filter for a 6-DOF IMU */
+
+struct ahrs_madgwick_s
+{
+  quat_t q;                    /* Attitude estimate */
+  float  beta;                 /* Filter gain */
+  float  dt;                   /* Filter execution period */
+};
+
+/* Fixed-point complementary filter. The quaternion is kept in Q1.30
+ * internally, b16_t does not have enough resolution to integrate slow
+ * rotations at kHz rates.
+ */
+
+struct ahrs_cf_b16_s
+{
+  int32_t q[4];                /* Attitude estimate (w, x, y, z) in Q1.30 */
+  b16_t   kp2;                 /* Proportional gain multiplied by 2 */
+  int32_t kidt2;               /* 2*ki/fs in Q1.30 */
+  int32_t halfdt;              /* 1/(2*fs) in Q1.30 */
+  int32_t bias[3];             /* Integral feedback in Q8.24 */
+};
+
+/* Fixed-point Madgwick filter */
+
+struct ahrs_madgwick_b16_s
+{
+  int32_t q[4];                /* Attitude estimate (w, x, y, z) in Q1.30 */
+  b16_t   beta;                /* Filter gain */
+  int32_t dt;                  /* 1/fs in Q1.30 */
+  int32_t halfdt;              /* 1/(2*fs) in Q1.30 */
+};
+
+/* FIR filter. The delay line holds 2*ntaps samples so that the newest
+ * ntaps samples are always contiguous in memory.
+ */
+
+struct fir_filter_s
+{
+  FAR const float *coeff;      /* Coefficients, coeff[0] for newest sample */
+  FAR float       *state;      /* Delay line, 2*ntaps samples */
+  uint16_t         ntaps;      /* Number of filter taps */
+  uint16_t         pos;        /* Current delay line position */
+};
+
+/* FIR filter in b16_t format */
+
+struct fir_filter_b16_s
+{
+  FAR const b16_t *coeff;      /* Coefficients, coeff[0] for newest sample */
+  FAR b16_t       *state;      /* Delay line, 2*ntaps samples */
+  uint16_t         ntaps;      /* Number of filter taps */
+  uint16_t         pos;        /* Current delay line position */
+};
+
+/* Cascade of second order IIR sections (transposed direct form II).
+ * Each section takes 5 coefficients {b0, b1, b2, a1, a2} for:
+ *
+ *   H(z) = (b0 + b1*z^-1 + b2*z^-2) / (1 + a1*z^-1 + a2*z^-2)
+ */
+
+struct biquad_s
+{
+  FAR const float *coeff;      /* Coefficients, 5 per section */
+  FAR float       *state;      /* Section state, 2 per section */
+  uint8_t          nstages;    /* Number of sections */
+};
+
+/* Biquad cascade in b16_t format (direct form I, 64-bit accumulator) */
+
+struct biquad_b16_s
+{
+  FAR const b16_t *coeff;      /* Coefficients, 5 per section */
+  FAR b16_t       *state;      /* Section state, 4 per section */
+  uint8_t          nstages;    /* Number of sections */
+};
+
+/* Fixed-point FOC data types.
+ * Currents, voltages and angles use b16_t. Normalized quantities
+ * (sine, cosine, duty cycle, modulation voltage) are in range <-1.0, 1.0>.
+ */
+
+struct phase_angle_b16_s
+{
+  b16_t   angle;               /* Phase angle in radians <0, 2PI) */
+  b16_t   sin;                 /* Phase angle sine */
+  b16_t   cos;                 /* Phase angle cosine */
+};
+
+typedef struct phase_angle_b16_s phase_angle_b16_t;
+
+struct abc_frame_b16_s
+{
+  b16_t a;                     /* A component */
+  b16_t b;                     /* B component */
+  b16_t c;                     /* C component */
+};
+
+typedef struct abc_frame_b16_s abc_frame_b16_t;
+
+struct ab_frame_b16_s
+{
+  b16_t a;                     /* Alpha component */
+  b16_t b;                     /* Beta component */
+};
+
+typedef struct ab_frame_b16_s ab_frame_b16_t;
+
+struct dq_frame_b16_s
+{
+  b16_t d;                     /* Direct component */
+  b16_t q;                     /* Quadrature component */
+};
+
+typedef struct dq_frame_b16_s dq_frame_b16_t;
+
+/* b16_t PI/PID controller. The integral part is kept in Q32 so that
+ * small KI*err products are not lost to rounding.
+ */
+
+struct pid_controller_b16_s
+{
+  b16_t       out;              /* Controller output */
+  b16_t       sat_min;          /* Output lower limit */
+  b16_t       sat_max;          /* Output upper limit */
+  b16_t       err;              /* Current error value */
+  b16_t       err_prev;         /* Previous error value */
+  b16_t       KP;               /* Proportional coefficient */
+  b16_t       KI;               /* Integral coefficient */
+  b16_t       KD;               /* Derivative coefficient */
+  int64_t     integral;         /* Integral part in Q32 */
+};
+
+typedef struct pid_controller_b16_s pid_controller_b16_t;
+
+/* Space Vector Modulation data for 3-phase system in b16_t format */
+
+struct svm3_state_b16_s
+{
+  uint8_t     sector;          /* Current space vector sector */
+  b16_t       d_u;             /* Duty cycle for phase U */
+  b16_t       d_v;             /* Duty cycle for phase V */
+  b16_t       d_w;             /* Duty cycle for phase W */
+  b16_t       d_max;           /* Duty cycle max */
+  b16_t       d_min;           /* Duty cycle min */
+};
+
+/* Common motor observer structure in b16_t format */
+
+struct motor_observer_b16_s
+{
+  b16_t    angle;             /* Estimated observer angle */
+  b16_t    speed;             /* Estimated observer speed */
+  uint32_t freq;              /* Observer execution frequency in Hz.
+                               * b16_t period would be too coarse at
+                               * current loop rates.
+                               */
+
+  FAR void *so;               /* Speed estimation observer data */
+  FAR void *ao;               /* Angle estimation observer data */
+};
+
+/* Speed observer division method data in b16_t format */
+
+struct motor_sobserver_div_b16_s
+{
+  b16_t   angle_acc;            /* Accumulated mechanical angle */
+  b16_t   angle_prev;           /* Previous mechanical angle */
+  b16_t   filter;               /* Low-pass filter for final omega */
+  uint8_t cntr;                 /* Sample counter */
+  uint8_t samples;              /* Number of samples for observer */
+};
+
+/* Motor Sliding Mode Observer private data in b16_t format */
+
+struct motor_observer_smo_b16_s
+{
+  b16_t k_slide;             /* Bang-bang controller gain */
+  b16_t err_max;             /* Linear mode threshold */
+  b16_t k_lin;               /* Linear mode gain (k_slide / err_max) */
+  ab_frame_b16_t emf;        /* Estimated back-EMF */
+  ab_frame_b16_t emf_f;      /* Fitlered estimated back-EMF */
+  ab_frame_b16_t z;          /* Correction factor */
+  ab_frame_b16_t i_est;      /* Estimated idq current */
+};
+
+/* Motor physical parameters in b16_t format */
+
+struct motor_phy_params_b16_s
+{
+  uint8_t p;                   /* Number of the motor pole pairs */
+  b16_t   res;                 /* Phase-to-neutral resistance */
+  b16_t   one_by_ind;          /* Inverse phase-to-neutral inductance */
+};
+
+/* Field oriented control (FOC) data in b16_t format */
+
+struct foc_data_b16_s
+{
+  abc_frame_b16_t      v_abc;    /* Voltage in ABC frame */
+  ab_frame_b16_t       v_ab;     /* Voltage in alpha-beta frame */
+  dq_frame_b16_t       v_dq;     /* Voltage in dq frame */
+  ab_frame_b16_t       v_ab_mod; /* Modulation voltage normalized to
+                                  * magnitude (0.0, 1.0)
+                                  */
+
+  abc_frame_b16_t      i_abc;    /* Current in ABC frame */
+  ab_frame_b16_t       i_ab;     /* Current in apha-beta frame */
+  dq_frame_b16_t       i_dq;     /* Current in dq frame */
+  dq_frame_b16_t       i_dq_err; /* DQ current error */
+
+  dq_frame_b16_t       i_dq_ref; /* Current dq reference frame */
+  pid_controller_b16_t id_pid;   /* Current d-axis component PI controller */
+  pid_controller_b16_t iq_pid;   /* Current q-axis component PI controller */
+
+  b16_t vdq_mag_max;             /* Maximum dq voltage magnitude */
+  b16_t vab_mod_scale;           /* Voltage alpha-beta modulation scale */
+};
+
+/* Moving window statistics */
+
+struct mwstats_s
+{
+  FAR float *buf;              /* Window buffer */
+  float      ref;              /* Reference the sums are relative to */
+  float      sum;              /* Sum of the samples in window minus ref */
+  float      sumsq;            /* Sum of squares of the samples minus ref */
+  uint16_t   size;             /* Window size */
+  uint16_t   pos;              /* Next write position */
+  uint16_t   count;            /* Number of valid samples */
+};
+
+/* Moving window statistics in b16_t format (exact 64-bit sums) */
+
+struct mwstats_b16_s
+{
+  FAR b16_t *buf;              /* Window buffer */
+  int64_t    sum;              /* Sum of the samples in window */
+  uint64_t   sumsq;            /* Sum of squares in Q32 */
+  uint16_t   size;             /* Window size */
+  uint16_t   pos;              /* Next write position */
+  uint16_t   count;            /* Number of valid samples */
+};
+
 /****************************************************************************
  * Public Functions Prototypes
  ****************************************************************************/
@@ -393,6 +679,8 @@ float fast_sin2(float angle);
 float fast_cos(float angle);
 float fast_cos2(float angle);
 float fast_atan2(float y, float x);
+float fast_rsqrt(float x);
+uint32_t fixed_rsqrt(uint64_t x, FAR int *shift);
 
 void f_saturate(FAR float *val, float min, float max);
 
@@ -490,6 +778,162 @@ void motor_phy_params_init(FAR struct motor_phy_params_s *phy, uint8_t poles,
 void motor_phy_params_temp_set(FAR struct motor_phy_params_s *phy,
                                float res_alpha, float res_temp_ref);
 
+/* Fixed-point math functions */
+
+b16_t fast_sin_b16(b16_t angle);
+b16_t fast_cos_b16(b16_t angle);
+void f_saturate_b16(FAR b16_t *val, b16_t min, b16_t max);
+void vector2d_saturate_b16(FAR b16_t *x, FAR b16_t *y, b16_t max);
+void dq_saturate_b16(FAR dq_frame_b16_t *dq, b16_t max);
+void angle_norm_2pi_b16(FAR b16_t *angle);
+void phase_angle_update_b16(FAR phase_angle_b16_t *angle, b16_t val);
+
+/* Fixed-point PI/PID controller */
+
+void pid_controller_init_b16(FAR pid_controller_b16_t *pid,
+                             b16_t KP, b16_t KI, b16_t KD);
+void pi_controller_init_b16(FAR pid_controller_b16_t *pid,
+                            b16_t KP, b16_t KI);
+void pi_saturation_set_b16(FAR pid_controller_b16_t *pid, b16_t min,
+                           b16_t max);
+void pi_integral_reset_b16(FAR pid_controller_b16_t *pid);
+b16_t pi_controller_b16(FAR pid_controller_b16_t *pid, b16_t err);
+b16_t pid_controller_b16(FAR pid_controller_b16_t *pid, b16_t err);
+
+/* Fixed-point transformation functions */
+
+void clarke_transform_b16(FAR abc_frame_b16_t *abc,
+                          FAR ab_frame_b16_t *ab);
+void inv_clarke_transform_b16(FAR ab_frame_b16_t *ab,
+                              FAR abc_frame_b16_t *abc);
+void park_transform_b16(FAR phase_angle_b16_t *angle,
+                        FAR ab_frame_b16_t *ab, FAR dq_frame_b16_t *dq);
+void inv_park_transform_b16(FAR phase_angle_b16_t *angle,
+                            FAR dq_frame_b16_t *dq, FAR ab_frame_b16_t *ab);
+
+/* Fixed-point 3-phase space vector modulation */
+
+void svm3_init_b16(FAR struct svm3_state_b16_s *s, b16_t min, b16_t max);
+void svm3_b16(FAR struct svm3_state_b16_s *s, FAR ab_frame_b16_t *ab);
+void svm3_current_correct_b16(FAR struct svm3_state_b16_s *s,
+                              FAR int32_t *c0, FAR int32_t *c1,
+                              FAR int32_t *c2);
+
+/* Fixed-point field oriented control */
+
+void foc_init_b16(FAR struct foc_data_b16_s *foc, b16_t id_kp, b16_t id_ki,
+                  b16_t iq_kp, b16_t iq_ki);
+void foc_vbase_update_b16(FAR struct foc_data_b16_s *foc, b16_t vbase);
+void foc_idq_ref_set_b16(FAR struct foc_data_b16_s *foc, b16_t d,
+                         b16_t q);
+void foc_process_b16(FAR struct foc_data_b16_s *foc,
+                     FAR abc_frame_b16_t *i_abc,
+                     FAR phase_angle_b16_t *angle);
+
+/* Fixed-point BLDC/PMSM motor observers */
+
+void motor_observer_init_b16(FAR struct motor_observer_b16_s *observer,
+                             FAR void *ao, FAR void *so, uint32_t freq);
+b16_t motor_observer_speed_get_b16(FAR struct motor_observer_b16_s *o);
+b16_t motor_observer_angle_get_b16(FAR struct motor_observer_b16_s *o);
+
+void motor_observer_smo_init_b16(FAR struct motor_observer_smo_b16_s *smo,
+                                 b16_t kslide, b16_t err_max);
+void motor_observer_smo_b16(FAR struct motor_observer_b16_s *o,
+                            FAR ab_frame_b16_t *i_ab,
+                            FAR ab_frame_b16_t *v_ab,
+                            FAR struct motor_phy_params_b16_s *phy,
+                            int8_t dir);
+
+void motor_sobserver_div_init_b16(FAR struct motor_sobserver_div_b16_s *so,
+                                  uint8_t samples, b16_t filter);
+void motor_sobserver_div_b16(FAR struct motor_observer_b16_s *o,
+                             b16_t angle, int8_t dir);
+
+/* Attitude estimation (block versions take n interleaved xyz samples) */
+
+void ahrs_cf_init(FAR struct ahrs_cf_s *cf, float kp, float ki, float per);
+void ahrs_cf_update(FAR struct ahrs_cf_s *cf, FAR const float *gyr,
+                    FAR const float *acc);
+void ahrs_cf_process(FAR struct ahrs_cf_s *cf, FAR const float *gyr,
+                     FAR const float *acc, size_t n);
+
+void ahrs_madgwick_init(FAR struct ahrs_madgwick_s *mw, float beta,
+                        float per);
+void ahrs_madgwick_update(FAR struct ahrs_madgwick_s *mw,
+                          FAR const float *gyr, FAR const float *acc);
+void ahrs_madgwick_process(FAR struct ahrs_madgwick_s *mw,
+                           FAR const float *gyr, FAR const float *acc,
+                           size_t n);
+
+void ahrs_cf_b16_init(FAR struct ahrs_cf_b16_s *cf, b16_t kp, b16_t ki,
+                      uint32_t fs);
+void ahrs_cf_b16_update(FAR struct ahrs_cf_b16_s *cf,
+                        FAR const b16_t *gyr, FAR const b16_t *acc);
+void ahrs_cf_b16_process(FAR struct ahrs_cf_b16_s *cf,
+                         FAR const b16_t *gyr, FAR const b16_t *acc,
+                         size_t n);
+void ahrs_cf_b16_quat_get(FAR struct ahrs_cf_b16_s *cf,
+                          FAR quat_b16_t *q);
+
+void ahrs_madgwick_b16_init(FAR struct ahrs_madgwick_b16_s *mw, b16_t beta,
+                            uint32_t fs);
+void ahrs_madgwick_b16_update(FAR struct ahrs_madgwick_b16_s *mw,
+                              FAR const b16_t *gyr, FAR const b16_t *acc);
+void ahrs_madgwick_b16_process(FAR struct ahrs_madgwick_b16_s *mw,
+                               FAR const b16_t *gyr, FAR const b16_t *acc,
+                               size_t n);
+void ahrs_madgwick_b16_quat_get(FAR struct ahrs_madgwick_b16_s *mw,
+                                FAR quat_b16_t *q);
+
+/* FIR filters (in-place block processing) */
+
+void fir_filter_init(FAR struct fir_filter_s *fir, FAR const float *coeff,
+                     FAR float *state, uint16_t ntaps);
+void fir_filter_reset(FAR struct fir_filter_s *fir);
+void fir_filter_process(FAR struct fir_filter_s *fir, FAR float *data,
+                        size_t n);
+
+void fir_filter_b16_init(FAR struct fir_filter_b16_s *fir,
+                         FAR const b16_t *coeff, FAR b16_t *state,
+                         uint16_t ntaps);
+void fir_filter_b16_reset(FAR struct fir_filter_b16_s *fir);
+void fir_filter_b16_process(FAR struct fir_filter_b16_s *fir,
+                            FAR b16_t *data, size_t n);
+
+/* Biquad IIR filter banks (in-place block processing) */
+
+void biquad_init(FAR struct biquad_s *bq, FAR const float *coeff,
+                 FAR float *state, uint8_t nstages);
+void biquad_reset(FAR struct biquad_s *bq);
+void biquad_process(FAR struct biquad_s *bq, FAR float *data, size_t n);
+void biquad_lowpass_coeff(FAR float *coeff, float fc, float fs, float q);
+void biquad_notch_coeff(FAR float *coeff, float fc, float fs, float q);
+
+void biquad_b16_init(FAR struct biquad_b16_s *bq, FAR const b16_t *coeff,
+                     FAR b16_t *state, uint8_t nstages);
+void biquad_b16_reset(FAR struct biquad_b16_s *bq);
+void biquad_b16_process(FAR struct biquad_b16_s *bq, FAR b16_t *data,
+                        size_t n);
+
+/* Moving window statistics */
+
+void mwstats_init(FAR struct mwstats_s *mw, FAR float *buf, uint16_t size);
+void mwstats_reset(FAR struct mwstats_s *mw);
+void mwstats_process(FAR struct mwstats_s *mw, FAR const float *data,
+                     size_t n);
+float mwstats_mean(FAR struct mwstats_s *mw);
+float mwstats_var(FAR struct mwstats_s *mw);
+float mwstats_rms(FAR struct mwstats_s *mw);
+
+void mwstats_b16_init(FAR struct mwstats_b16_s *mw, FAR b16_t *buf,
+                      uint16_t size);
+void mwstats_b16_reset(FAR struct mwstats_b16_s *mw);
+void mwstats_b16_process(FAR struct mwstats_b16_s *mw,
+                         FAR const b16_t *data, size_t n);
+b16_t mwstats_b16_mean(FAR struct mwstats_b16_s *mw);
+b16_t mwstats_b16_var(FAR struct mwstats_b16_s *mw);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
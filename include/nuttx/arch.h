@@ -1665,6 +1665,34 @@ int up_timer_cancel(FAR struct timespec *ts);
 int up_timer_start(FAR const struct timespec *ts);
 #endif
 
+/****************************************************************************
+ * Name: up_hrtimer_start
+ *
+ * Description:
+ *   Program the high resolution timer alarm.  hrtimer_expiration() will be
+ *   called with the current time once CLOCK_MONOTONIC reaches 'expired'
+ *   nanoseconds.  The alarm shares the hardware with up_alarm_start(); the
+ *   platform must keep both and fire on the earlier.
+ *
+ *   Provided by platform-specific code and called from the RTOS base code.
+ *
+ * Input Parameters:
+ *   expired - The absolute expiration time in nanoseconds, or UINT64_MAX
+ *             if no high resolution timer is running.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ * Assumptions:
+ *   Called in the critical section, possibly from hrtimer_expiration().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER
+int up_hrtimer_start(uint64_t expired);
+#endif
+
 /****************************************************************************
  * TLS support
  ****************************************************************************/
@@ -42,23 +42,72 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+
+#include <sys/types.h>
 #include <stdint.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
+#define AES_BLOCK_SIZE     16
+
 #define AES128_KEY_SIZE    16
+#define AES192_KEY_SIZE    24
+#define AES256_KEY_SIZE    32
+
+/* Maximum number of rounds (AES-256) */
+
+#define AES_MAXNR          14
+
+/* Number of key stream bytes generated at once in CTR mode */
+
+#define AES_CTR_STREAM_SIZE (4 * AES_BLOCK_SIZE)
 
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+/* Expanded key schedule.  Round keys are stored as little-endian 32-bit
+ * words so that their in-memory byte order matches FIPS-197 on
+ * little-endian hosts (as required by the AES-NI instructions).
+ */
+
 struct aes_state_s
 {
-  uint8_t expanded_key[176];
+  uint32_t ek[4 * (AES_MAXNR + 1)];  /* Encryption round keys */
+  uint32_t dk[4 * (AES_MAXNR + 1)];  /* Equivalent inverse cipher round keys */
+  int nr;                            /* Number of rounds (10, 12 or 14) */
+};
+
+/* Streaming CTR mode context */
+
+struct aes_ctr_s
+{
+  struct aes_state_s aes;                 /* Expanded key */
+  uint8_t counter[AES_BLOCK_SIZE];        /* Next counter block */
+  uint8_t stream[AES_CTR_STREAM_SIZE];    /* Unused key stream */
+  unsigned int offset;                    /* Offset of unused key stream */
 };
 
+#ifdef CONFIG_CRYPTO_SW_AES_GCM
+/* Streaming GCM mode context */
+
+struct aes_gcm_s
+{
+  struct aes_state_s aes;                 /* Expanded key */
+  uint64_t hl[16];                        /* GHASH multiplication table */
+  uint64_t hh[16];
+  uint8_t ek0[AES_BLOCK_SIZE];            /* E(K, J0) that masks the tag */
+  uint8_t counter[AES_BLOCK_SIZE];        /* Current counter block */
+  uint8_t stream[AES_BLOCK_SIZE];         /* Key stream for counter */
+  uint8_t ghash[AES_BLOCK_SIZE];          /* GHASH accumulator */
+  uint64_t aadlen;                        /* Bytes of AAD processed */
+  uint64_t textlen;                       /* Bytes of text processed */
+  uint8_t encrypt;                        /* CYPHER_ENCRYPT or CYPHER_DECRYPT */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -118,14 +167,12 @@ void aes_decrypt(FAR uint8_t *state, FAR const uint8_t *key);
  *
  * Input Parameters:
  *  state  an AES context that can be used for AES operations
- *  key    a pointer to a 16-byte buffer holding the AES-128 key
- *  len    length of the key, must be 16
- *
- * TODO: Support other key lengths of 24 (AES-192) and 32 (AES-256)
+ *  key    a pointer to a buffer holding the AES key
+ *  len    length of the key: 16 (AES-128), 24 (AES-192) or 32 (AES-256)
  *
  * Returned Value:
  *   0 if OK
- *   -EINVAL if len is not 16
+ *   -EINVAL if len is not a supported key length
  *
  ****************************************************************************/
 
@@ -164,6 +211,134 @@ void aes_encipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
 void aes_decipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
                   int nblk);
 
+/****************************************************************************
+ * Name: aes_ctr_setupkey
+ *
+ * Description:
+ *   Initialize a streaming CTR mode context with the given key and initial
+ *   counter block.  The whole 16-byte counter block is incremented as a
+ *   big-endian number (NIST SP 800-38A).
+ *
+ * Input Parameters:
+ *  ctr    the CTR context to initialize
+ *  key    a pointer to a buffer holding the AES key
+ *  len    length of the key: 16, 24 or 32
+ *  iv     the 16-byte initial counter block
+ *
+ * Returned Value:
+ *   0 if OK
+ *   -EINVAL if len is not a supported key length
+ *
+ ****************************************************************************/
+
+int aes_ctr_setupkey(FAR struct aes_ctr_s *ctr, FAR const uint8_t *key,
+                     int len, FAR const uint8_t *iv);
+
+/****************************************************************************
+ * Name: aes_ctr_crypt
+ *
+ * Description:
+ *   Encrypt or decrypt (the operations are identical) len bytes in CTR
+ *   mode.  The data need not be a multiple of the block size; unused key
+ *   stream is kept for the next call so that a message may be processed in
+ *   arbitrary pieces.  out and in may be the same buffer.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aes_ctr_crypt(FAR struct aes_ctr_s *ctr, FAR uint8_t *out,
+                   FAR const uint8_t *in, size_t len);
+
+#ifdef CONFIG_CRYPTO_SW_AES_GCM
+/****************************************************************************
+ * Name: aes_gcm_setupkey
+ *
+ * Description:
+ *   Expand the key and precompute the GHASH table of a GCM context.  The
+ *   context may then be used for any number of messages, each started with
+ *   aes_gcm_start().
+ *
+ * Returned Value:
+ *   0 if OK
+ *   -EINVAL if len is not a supported key length
+ *
+ ****************************************************************************/
+
+int aes_gcm_setupkey(FAR struct aes_gcm_s *gcm, FAR const uint8_t *key,
+                     int len);
+
+/****************************************************************************
+ * Name: aes_gcm_start
+ *
+ * Description:
+ *   Start a new GCM message with the given IV.  A 12-byte IV is
+ *   recommended; other non-zero lengths are hashed as per NIST SP 800-38D.
+ *
+ * Input Parameters:
+ *  gcm     the GCM context
+ *  iv      the initialization vector
+ *  ivlen   length of the IV in bytes
+ *  encrypt CYPHER_ENCRYPT or CYPHER_DECRYPT
+ *
+ * Returned Value:
+ *   0 if OK
+ *   -EINVAL if ivlen is zero
+ *
+ ****************************************************************************/
+
+int aes_gcm_start(FAR struct aes_gcm_s *gcm, FAR const uint8_t *iv,
+                  size_t ivlen, int encrypt);
+
+/****************************************************************************
+ * Name: aes_gcm_aad
+ *
+ * Description:
+ *   Add additional authenticated data to the current message.  May be
+ *   called several times, but only before the first aes_gcm_update().
+ *
+ * Returned Value:
+ *   0 if OK
+ *   -EINVAL if text has already been processed
+ *
+ ****************************************************************************/
+
+int aes_gcm_aad(FAR struct aes_gcm_s *gcm, FAR const uint8_t *aad,
+                size_t len);
+
+/****************************************************************************
+ * Name: aes_gcm_update
+ *
+ * Description:
+ *   Encrypt or decrypt the next len bytes of the message.  The data may be
+ *   supplied in pieces of any size.  out and in may be the same buffer.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aes_gcm_update(FAR struct aes_gcm_s *gcm, FAR uint8_t *out,
+                    FAR const uint8_t *in, size_t len);
+
+/****************************************************************************
+ * Name: aes_gcm_finish
+ *
+ * Description:
+ *   Finish the message and return the first taglen bytes (at most 16) of
+ *   the authentication tag.  When decrypting, the caller must compare the
+ *   tag with the received one before using the plain text.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aes_gcm_finish(FAR struct aes_gcm_s *gcm, FAR uint8_t *tag,
+                    size_t taglen);
+#endif
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -53,7 +53,8 @@
 #define CRYPTO_AES_ECB          1
 #define CRYPTO_AES_CBC          2
 #define CRYPTO_AES_CTR          3
-#define CRYPTO_ALGORITHM_MAX    1
+#define CRYPTO_AES_GCM          4  /* 12-byte IV, 16-byte tag in mac */
+#define CRYPTO_ALGORITHM_MAX    4
 
 #define CRYPTO_FLAG_HARDWARE    0x01000000 /* hardware accelerated */
 #define CRYPTO_FLAG_SOFTWARE    0x02000000 /* software implementation */
@@ -62,9 +63,15 @@
 #define COP_DECRYPT             2
 #define COP_F_BATCH             0x0008 /* Batch op if possible */
 
-#define CIOCGSESSION            101
-#define CIOCFSESSION            102
-#define CIOCCRYPT               103
+#define CIOCGSESSION            101  /* arg: struct session_op * */
+#define CIOCFSESSION            102  /* arg: uint32_t * session number */
+#define CIOCCRYPT               103  /* arg: struct crypt_op * */
+#define CIOCSUBMIT              104  /* arg: struct crypt_batch * */
+#define CIOCREAP                105  /* arg: struct crypt_batch * */
+
+/* struct crypt_batch flags */
+
+#define CRYPT_BATCH_WAIT        0x0001 /* CIOCREAP: wait for a completion */
 
 typedef char* caddr_t;
 
@@ -92,4 +99,27 @@ struct crypt_op
   caddr_t iv;
 };
 
+/* A job of the batched interface (CONFIG_CRYPTO_CRYPTODEV_BATCH).
+ * CIOCSUBMIT queues an array of jobs which are processed in order by a
+ * kernel worker; CIOCREAP returns the completed jobs, in the same order,
+ * with the result field set.  Both return the number of jobs transferred.
+ * The input (src, iv and, to decrypt, mac) is copied when the job is
+ * submitted; the output (dst and, to encrypt, mac) is written when the job
+ * is reaped.  So dst and mac must stay valid until the job is reaped.
+ */
+
+struct crypt_job
+{
+  struct crypt_op op;
+  FAR void *priv;     /* Opaque to the driver, returned with the job */
+  int result;         /* returns: OK or a negated errno value */
+};
+
+struct crypt_batch
+{
+  FAR struct crypt_job *jobs;
+  unsigned int njobs; /* Number of entries in jobs */
+  unsigned int flags; /* CRYPT_BATCH_* */
+};
+
 #endif /* __INCLUDE_NUTTX_CRYPTO_CRYPTODEV_H */
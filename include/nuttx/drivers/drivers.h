@@ -142,6 +142,24 @@ void devcrypto_register(void);
 
 void devzero_register(void);
 
+/****************************************************************************
+ * Name: shmring_register
+ *
+ * Description:
+ *   Register /dev/shmring
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEV_SHMRING
+void shmring_register(void);
+#endif
+
 /****************************************************************************
  * Name: bchdev_register
  *
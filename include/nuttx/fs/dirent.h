@@ -188,6 +188,7 @@ struct fs_spiffsdir_s
  */
 
 struct fs_dirent_s;                           /* Forward reference */
+struct unionfs_nameset_s;                     /* Forward reference */
 struct fs_unionfsdir_s
 {
   uint8_t fu_ndx;                             /* Index of file system being enumerated */
@@ -195,6 +196,7 @@ struct fs_unionfsdir_s
   bool fu_prefix[2];                          /* True: Fake directory in prefix */
   FAR char *fu_relpath;                       /* Path being enumerated */
   FAR struct fs_dirent_s *fu_lower[2];        /* dirent struct used by contained file system */
+  FAR struct unionfs_nameset_s *fu_names;     /* Names enumerated on file system 1 */
 };
 #endif
 
@@ -102,6 +102,17 @@
 #define __FS_FLAG_LBF   (1 << 2) /* Line buffered */
 #define __FS_FLAG_UBF   (1 << 3) /* Buffer allocated by caller of setvbuf */
 
+/* Descriptor allocation bitmaps.  Each file list (and socket list) keeps
+ * one bit per descriptor slot, set while the slot is in use, so that the
+ * lowest free descriptor can be located a 32-bit word at a time.
+ */
+
+#define FDMAP_NWORDS(n)    (((n) + 31) >> 5)
+#define FDMAP_BIT(i)       ((uint32_t)1 << ((i) & 31))
+#define FDMAP_SET(m,i)     ((m)[(i) >> 5] |= FDMAP_BIT(i))
+#define FDMAP_CLR(m,i)     ((m)[(i) >> 5] &= ~FDMAP_BIT(i))
+#define FDMAP_ISSET(m,i)   (((m)[(i) >> 5] & FDMAP_BIT(i)) != 0)
+
 /* Inode i_flags values:
  *
  *   Bit 0-3: Inode type (Bit 3 indicates internal OS types)
@@ -199,6 +210,7 @@ struct inode;
 struct stat;
 struct statfs;
 struct pollfd;
+struct iovec;
 struct fs_dirent_s;
 struct mtd_dev_s;
 
@@ -230,6 +242,15 @@ struct file_operations
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   int     (*unlink)(FAR struct inode *inode);
 #endif
+
+  /* Optional vectored transfers.  Drivers that leave these NULL are
+   * served by calling read() or write() once per segment.
+   */
+
+  ssize_t (*readv)(FAR struct file *filep, FAR const struct iovec *iov,
+                   int iovcnt);
+  ssize_t (*writev)(FAR struct file *filep, FAR const struct iovec *iov,
+                    int iovcnt);
 };
 
 /* This structure provides information about the state of a block driver */
@@ -414,6 +435,10 @@ struct filelist
 {
   sem_t   fl_sem;               /* Manage access to the file list */
   struct file fl_files[CONFIG_NFILE_DESCRIPTORS];
+
+  /* One bit per entry in fl_files[], set while the descriptor is in use */
+
+  uint32_t fl_inuse[FDMAP_NWORDS(CONFIG_NFILE_DESCRIPTORS)];
 };
 
 /* The following structure defines the list of files used for standard C I/O.
@@ -688,6 +713,22 @@ int unregister_mtddriver(FAR const char *path);
 
 int inode_checkflags(FAR struct inode *inode, int oflags);
 
+/****************************************************************************
+ * Name: fdmap_alloc
+ *
+ * Description:
+ *   Find the lowest clear bit >= 'minbit' in a descriptor allocation bitmap
+ *   of 'nbits' bits, set it, and return its index.  The caller must hold
+ *   the semaphore of the list that owns the bitmap.
+ *
+ * Returned Value:
+ *   The index of the newly allocated bit on success; -EMFILE if every bit
+ *   from 'minbit' up is already set.
+ *
+ ****************************************************************************/
+
+int fdmap_alloc(FAR uint32_t *map, int nbits, int minbit);
+
 /****************************************************************************
  * Name: files_initlist
  *
@@ -1148,6 +1189,53 @@ ssize_t file_pread(FAR struct file *filep, FAR void *buf, size_t nbytes,
 ssize_t file_pwrite(FAR struct file *filep, FAR const void *buf,
                     size_t nbytes, off_t offset);
 
+/****************************************************************************
+ * Name: file_readv and file_writev
+ *
+ * Description:
+ *   Equivalent to the standard readv() and writev() functions except that
+ *   they accept a struct file instance instead of a file descriptor, do not
+ *   modify errno and are not cancellation points.  The driver's vectored
+ *   method is used when it has one; otherwise each segment is transferred
+ *   in turn, stopping at the first short transfer.
+ *
+ * Returned Value:
+ *   The number of bytes transferred, or a negated errno value if nothing
+ *   was transferred.
+ *
+ ****************************************************************************/
+
+ssize_t file_readv(FAR struct file *filep, FAR const struct iovec *iov,
+                   int iovcnt);
+ssize_t file_writev(FAR struct file *filep, FAR const struct iovec *iov,
+                    int iovcnt);
+
+/****************************************************************************
+ * Name: nx_readv and nx_writev
+ *
+ * Description:
+ *   readv() and writev() on a file or socket descriptor without modifying
+ *   errno and without being cancellation points.
+ *
+ ****************************************************************************/
+
+ssize_t nx_readv(int fd, FAR const struct iovec *iov, int iovcnt);
+ssize_t nx_writev(int fd, FAR const struct iovec *iov, int iovcnt);
+
+/****************************************************************************
+ * Name: file_preadv and file_pwritev
+ *
+ * Description:
+ *   file_readv() and file_writev() at an explicit file offset.  The file
+ *   position is left unchanged.
+ *
+ ****************************************************************************/
+
+ssize_t file_preadv(FAR struct file *filep, FAR const struct iovec *iov,
+                    int iovcnt, off_t offset);
+ssize_t file_pwritev(FAR struct file *filep, FAR const struct iovec *iov,
+                     int iovcnt, off_t offset);
+
 /****************************************************************************
  * Name: file_seek
  *
@@ -1316,6 +1404,38 @@ int file_fstat(FAR struct file *filep, FAR struct stat *buf);
 
 int fdesc_poll(int fd, FAR struct pollfd *fds, bool setup);
 
+/****************************************************************************
+ * Name: rammap_transfer
+ *
+ * Description:
+ *   Move the calling task group's reference to the RAM copied mapping at
+ *   'addr' to the task group of 'pid'.  Used by the module loader so that
+ *   the mapping lives as long as the task running the module.  Addresses
+ *   that are not RAM mapped are ignored.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_RAMMAP
+int rammap_transfer(FAR void *addr, pid_t pid);
+#endif
+
+/****************************************************************************
+ * Name: rammap_release
+ *
+ * Description:
+ *   Called by the OS when a task group exits to drop the RAM copied file
+ *   mappings that it still holds.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_RAMMAP
+struct task_group_s; /* Forward reference */
+void rammap_release(FAR struct task_group_s *group);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
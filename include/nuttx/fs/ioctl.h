@@ -97,6 +97,8 @@
 #define _NXTERMBASE     (0x2900) /* NxTerm character driver ioctl commands */
 #define _RFIOCBASE      (0x2a00) /* RF devices ioctl commands */
 #define _RPTUNBASE      (0x2b00) /* Remote processor tunnel ioctl commands */
+#define _IORINGBASE     (0x2c00) /* I/O ring ioctl commands */
+#define _SHMRINGBASE    (0x2d00) /* Shared memory ring ioctl commands */
 #define _WLIOCBASE      (0x8b00) /* Wireless modules ioctl network commands */
 
 /* boardctl() commands share the same number space */
@@ -510,6 +512,16 @@
 #define _RPTUNIOCVALID(c)   (_IOC_TYPE(c)==_RPTUNBASE)
 #define _RPTUNIOC(nr)       _IOC(_RPTUNBASE,nr)
 
+/* I/O ring driver (see include/sys/ioring.h) *******************************/
+
+#define _IORINGIOCVALID(c)  (_IOC_TYPE(c)==_IORINGBASE)
+#define _IORINGIOC(nr)      _IOC(_IORINGBASE,nr)
+
+/* Shared memory ring driver (see include/sys/shmring.h) ********************/
+
+#define _SHMRINGIOCVALID(c) (_IOC_TYPE(c)==_SHMRINGBASE)
+#define _SHMRINGIOC(nr)     _IOC(_SHMRINGBASE,nr)
+
 /* Wireless driver network ioctl definitions ********************************/
 
 /* (see nuttx/include/wireless/wireless.h */
@@ -0,0 +1,187 @@
+/****************************************************************************
+ * include/nuttx/hrtimer.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_HRTIMER_H
+#define __INCLUDE_NUTTX_HRTIMER_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <time.h>
+
+#include <nuttx/clock.h>
+
+#ifdef CONFIG_HRTIMER
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+/* High resolution timers expire at an absolute time in nanoseconds on the
+ * clock of the alarm hardware (see up_timer_gettime()), independent of the
+ * system tick.  They are kept in a
+ * pairing heap ordered by expiration; the earliest one programs the
+ * alarm.  The callback runs from the alarm interrupt, inside the critical
+ * section, and may start the timer again.
+ */
+
+struct hrtimer_s;
+typedef CODE void (*hrtimer_cb_t)(FAR struct hrtimer_s *hrtimer);
+
+struct hrtimer_s
+{
+  FAR struct hrtimer_s *child;   /* First child in the heap */
+  FAR struct hrtimer_s *sibling; /* Next sibling in the heap */
+  FAR struct hrtimer_s *prev;    /* Parent if first child, else previous
+                                  * sibling.  NULL for the root. */
+  uint64_t expired;              /* Expiration time in nanoseconds */
+  hrtimer_cb_t func;             /* Function to call on expiration */
+  FAR void *arg;                 /* Argument for the callback */
+};
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+static inline uint64_t hrtimer_time2ns(FAR const struct timespec *ts)
+{
+  return (uint64_t)ts->tv_sec * NSEC_PER_SEC + ts->tv_nsec;
+}
+
+static inline void hrtimer_ns2time(uint64_t ns, FAR struct timespec *ts)
+{
+  ts->tv_sec  = ns / NSEC_PER_SEC;
+  ts->tv_nsec = ns - (uint64_t)ts->tv_sec * NSEC_PER_SEC;
+}
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: hrtimer_init
+ *
+ * Description:
+ *   Initialize a timer to the stopped state before its first
+ *   hrtimer_start().  A timer in zeroed memory is already stopped.
+ *
+ ****************************************************************************/
+
+void hrtimer_init(FAR struct hrtimer_s *hrtimer);
+
+/****************************************************************************
+ * Name: hrtimer_start
+ *
+ * Description:
+ *   (Re-)start the timer so that 'func' is called with the timer when
+ *   hrtimer_now() reaches 'expired' nanoseconds.  A time in the past
+ *   expires at once.
+ *
+ * Input Parameters:
+ *   hrtimer - The timer to start.  Restarted if already running.
+ *   expired - Absolute expiration time, see hrtimer_now().
+ *   func    - Function to call on expiration.
+ *   arg     - Stored in hrtimer->arg for the callback.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int hrtimer_start(FAR struct hrtimer_s *hrtimer, uint64_t expired,
+                  hrtimer_cb_t func, FAR void *arg);
+
+/****************************************************************************
+ * Name: hrtimer_cancel
+ *
+ * Description:
+ *   Stop the timer if it is running.  After return, the callback will not
+ *   be called until the timer is started again.
+ *
+ ****************************************************************************/
+
+int hrtimer_cancel(FAR struct hrtimer_s *hrtimer);
+
+/****************************************************************************
+ * Name: hrtimer_gettime
+ *
+ * Description:
+ *   Return the nanoseconds left before the timer expires; zero if it is
+ *   not running.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_gettime(FAR struct hrtimer_s *hrtimer);
+
+/****************************************************************************
+ * Name: hrtimer_now
+ *
+ * Description:
+ *   Return the current time of the alarm hardware in nanoseconds, the time
+ *   base of all high resolution timers.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_now(void);
+
+/****************************************************************************
+ * Name: hrtimer_abstime
+ *
+ * Description:
+ *   Convert an absolute time on 'clockid' (CLOCK_REALTIME or
+ *   CLOCK_MONOTONIC) to an expiration time for hrtimer_start().  A time
+ *   that has already passed converts to the current time.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_abstime(clockid_t clockid,
+                         FAR const struct timespec *abstime);
+
+/****************************************************************************
+ * Name: hrtimer_expiration
+ *
+ * Description:
+ *   Run the callbacks of the timers that have expired by 'now' and
+ *   reprogram the alarm for the next one.  Called by the architecture
+ *   from the alarm interrupt.
+ *
+ ****************************************************************************/
+
+void hrtimer_expiration(uint64_t now);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_HRTIMER */
+#endif /* __INCLUDE_NUTTX_HRTIMER_H */
@@ -41,6 +41,9 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stddef.h>
 
 /* If CONFIG_ARCH_MATH_H is defined, then the top-level Makefile will copy
  * this header file to include/math.h where it will become the system math.h
@@ -426,6 +429,16 @@ long double truncl (long double x);
 #define nanl(x) ((long double)(NAN))
 #endif
 
+/* Non-standard batch versions, y[i] = f(x[i]) for 0 <= i < n.  Most of the
+ * work is done by branch free loops that the compiler can vectorize.  x and
+ * y may be the same array.
+ */
+
+void        vsinf (FAR float *y, FAR const float *x, size_t n);
+void        vcosf (FAR float *y, FAR const float *x, size_t n);
+void        vexpf (FAR float *y, FAR const float *x, size_t n);
+void        vlogf (FAR float *y, FAR const float *x, size_t n);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -51,6 +51,8 @@
 #include <semaphore.h>
 #include <queue.h>
 
+#include <nuttx/fs/fs.h>
+
 #ifdef CONFIG_MM_IOB
 #  include <nuttx/mm/iob.h>
 #endif
@@ -178,6 +180,7 @@ typedef uint8_t sockcaps_t;
 struct file;    /* Forward reference */
 struct socket;  /* Forward reference */
 struct pollfd;  /* Forward reference */
+struct iovec;   /* Forward reference */
 
 struct sock_intf_s
 {
@@ -203,6 +206,8 @@ struct sock_intf_s
   CODE ssize_t    (*si_sendto)(FAR struct socket *psock, FAR const void *buf,
                     size_t len, int flags, FAR const struct sockaddr *to,
                     socklen_t tolen);
+  CODE ssize_t    (*si_sendv)(FAR struct socket *psock,
+                    FAR const struct iovec *iov, int iovcnt, int flags);
 #ifdef CONFIG_NET_SENDFILE
   CODE ssize_t    (*si_sendfile)(FAR struct socket *psock,
                     FAR struct file *infile, FAR off_t *offset,
@@ -290,6 +295,10 @@ struct socketlist
 {
   sem_t         sl_sem;      /* Manage access to the socket list */
   struct socket sl_sockets[CONFIG_NSOCKET_DESCRIPTORS];
+
+  /* One bit per entry in sl_sockets[], set while the socket is allocated */
+
+  uint32_t      sl_inuse[FDMAP_NWORDS(CONFIG_NSOCKET_DESCRIPTORS)];
 };
 #endif
 
@@ -875,6 +884,55 @@ int psock_connect(FAR struct socket *psock, FAR const struct sockaddr *addr,
 ssize_t psock_send(FAR struct socket *psock, const void *buf, size_t len,
                    int flags);
 
+/****************************************************************************
+ * Name: psock_sendv
+ *
+ * Description:
+ *   Send the data gathered from 'iovcnt' buffers as psock_send() would
+ *   send them from one.  This is the socket half of writev().  Address
+ *   families with an si_sendv() method gather the data themselves.
+ *   Otherwise stream sockets send each segment in turn and other sockets
+ *   send one message assembled from the segments.
+ *
+ * Input Parameters:
+ *   psock  - An instance of the internal socket structure.
+ *   iov    - Array of buffers to send
+ *   iovcnt - Number of elements in iov[]
+ *   flags  - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On any failure, a
+ *   negated errno value is returned.
+ *
+ ****************************************************************************/
+
+ssize_t psock_sendv(FAR struct socket *psock, FAR const struct iovec *iov,
+                    int iovcnt, int flags);
+
+/****************************************************************************
+ * Name: psock_recvv
+ *
+ * Description:
+ *   Receive into 'iovcnt' buffers as psock_recvfrom() would receive into
+ *   one.  This is the socket half of readv().  Only the first segment may
+ *   block; a stream socket stops at the first segment that it cannot fill
+ *   and a datagram is never split across calls.
+ *
+ * Input Parameters:
+ *   psock  - An instance of the internal socket structure.
+ *   iov    - Array of buffers to receive into
+ *   iovcnt - Number of elements in iov[]
+ *   flags  - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On any
+ *   failure, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+ssize_t psock_recvv(FAR struct socket *psock, FAR const struct iovec *iov,
+                    int iovcnt, int flags);
+
 /****************************************************************************
  * Name: nx_send
  *
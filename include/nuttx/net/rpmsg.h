@@ -55,6 +55,7 @@
 #define NET_RPMSG_DEVIOCTL              4 /* IP-->LINK */
 #define NET_RPMSG_SOCKIOCTL             5 /* IP<--LINK */
 #define NET_RPMSG_TRANSFER              6 /* IP<->LINK */
+#define NET_RPMSG_TRANSFER_FRAG         7 /* IP<->LINK */
 
 /****************************************************************************
  * Public Types
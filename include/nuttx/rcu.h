@@ -0,0 +1,98 @@
+/****************************************************************************
+ * include/nuttx/rcu.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_RCU_H
+#define __INCLUDE_NUTTX_RCU_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <nuttx/irq.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Read-copy-update for read-mostly kernel lists.
+ *
+ * Readers walk a list between rcu_read_lock() and rcu_read_unlock()
+ * without taking any lock shared with other CPUs.  A read section must
+ * be short and must not block or enter the critical section.
+ *
+ * Writers serialize among themselves with a lock of their own, publish a
+ * new entry with rcu_assign_pointer() once it is fully initialized, and
+ * call synchronize_rcu() after unlinking an entry and before reusing or
+ * freeing it: when it returns, no reader can still see the entry.
+ *
+ * A read section runs with the local interrupts disabled, so its CPU can
+ * neither be preempted nor switch context in it.  A context switch on a
+ * CPU is therefore a quiescent state, and grace periods are tracked by
+ * counting context switches.  On a single CPU, a writer never runs while
+ * a read section is in progress, so there is nothing to wait for.
+ */
+
+#define rcu_read_lock()            up_irq_save()
+#define rcu_read_unlock(flags)     up_irq_restore(flags)
+
+/* The release store keeps the initialization of the new entry ahead of
+ * its publication, for the compiler and for the other CPUs alike.
+ */
+
+#define rcu_assign_pointer(p, v)   __atomic_store_n(&(p), (v), __ATOMIC_RELEASE)
+
+#ifndef CONFIG_SMP
+#  define synchronize_rcu()
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: synchronize_rcu
+ *
+ * Description:
+ *   Wait until every read section in progress on the other CPUs has
+ *   ended.  Must not be called from a read section, with the scheduler
+ *   locked or from an interrupt handler.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+void synchronize_rcu(void);
+#endif
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_RCU_H */
@@ -41,6 +41,11 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
 #include <openamp/open_amp.h>
 #include <openamp/remoteproc_loader.h>
 
@@ -56,6 +61,26 @@ typedef void (*rpmsg_bind_cb_t)(FAR struct rpmsg_device *rdev,
                                 FAR void *priv, FAR const char *name,
                                 uint32_t dest);
 
+/* Every fragment sent by rpmsg_send_frag() starts with a copy of the
+ * caller's message header, so the receiver can still dispatch on it,
+ * followed by this structure and then the fragment data.
+ */
+
+begin_packed_struct struct rpmsg_frag_s
+{
+  uint32_t total;                   /* Length of the whole payload */
+  uint32_t offset;                  /* Offset of this fragment */
+} end_packed_struct;
+
+/* Receive side reassembly state, see rpmsg_recv_frag() */
+
+struct rpmsg_reasm_s
+{
+  FAR uint8_t *buf;                 /* Reassembly buffer */
+  size_t      size;                 /* Size of buf */
+  size_t      received;             /* Bytes received so far */
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -77,6 +102,11 @@ void rpmsg_unregister_callback(FAR void *priv,
                                rpmsg_dev_cb_t device_created,
                                rpmsg_dev_cb_t device_destroy,
                                rpmsg_bind_cb_t ns_bind);
+int rpmsg_send_frag(FAR struct rpmsg_endpoint *ept,
+                    FAR const void *header, size_t hdrlen,
+                    FAR const void *data, size_t len);
+ssize_t rpmsg_recv_frag(FAR struct rpmsg_reasm_s *reasm,
+                        FAR const void *msg, size_t len, size_t hdrlen);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,117 @@
+/****************************************************************************
+ * include/nuttx/rwsem.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_RWSEM_H
+#define __INCLUDE_NUTTX_RWSEM_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+
+#include <nuttx/semaphore.h>
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* A kernel reader-writer lock.  Any number of readers, or one writer, may
+ * hold it.  The writer may take it again, for reading or writing, while it
+ * holds it.  Readers are preferred: a reader gets the lock whenever no
+ * writer holds it, so a thread may take the read lock recursively even
+ * with writers waiting.  A reader must not try to take the write lock.
+ */
+
+typedef struct
+{
+  sem_t   protect;  /* Protects the fields below */
+  sem_t   waiting;  /* Readers and writers sleep here */
+  int16_t waiter;   /* Number of threads sleeping on 'waiting' */
+  int16_t reader;   /* Number of read locks held */
+  int16_t writer;   /* Number of write locks held by 'holder' */
+  pid_t   holder;   /* The thread holding the write lock */
+} rw_semaphore_t;
+
+#define RWSEM_NO_HOLDER ((pid_t)-1)
+
+#define RWSEM_INITIALIZER \
+  {SEM_INITIALIZER(1), SEM_INITIALIZER(0), 0, 0, 0, RWSEM_NO_HOLDER}
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: init_rwsem / destroy_rwsem
+ *
+ * Description:
+ *   Initialize or destroy a reader-writer lock.
+ *
+ ****************************************************************************/
+
+int init_rwsem(FAR rw_semaphore_t *rwsem);
+void destroy_rwsem(FAR rw_semaphore_t *rwsem);
+
+/****************************************************************************
+ * Name: down_read / down_read_trylock / up_read
+ *
+ * Description:
+ *   Take or release the lock for reading.  down_read() waits while another
+ *   thread holds the write lock; down_read_trylock() returns false
+ *   instead.  down_read() fails only if the thread is canceled.
+ *
+ ****************************************************************************/
+
+int down_read(FAR rw_semaphore_t *rwsem);
+bool down_read_trylock(FAR rw_semaphore_t *rwsem);
+void up_read(FAR rw_semaphore_t *rwsem);
+
+/****************************************************************************
+ * Name: down_write / down_write_trylock / up_write
+ *
+ * Description:
+ *   Take or release the lock for writing.  down_write() waits while any
+ *   other thread holds the lock; down_write_trylock() returns false
+ *   instead.  down_write() fails only if the thread is canceled.
+ *
+ ****************************************************************************/
+
+int down_write(FAR rw_semaphore_t *rwsem);
+bool down_write_trylock(FAR rw_semaphore_t *rwsem);
+void up_write(FAR rw_semaphore_t *rwsem);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_RWSEM_H */
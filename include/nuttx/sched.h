@@ -37,6 +37,7 @@
 #include <time.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/hrtimer.h>
 #include <nuttx/irq.h>
 #include <nuttx/wdog.h>
 #include <nuttx/mm/shm.h>
@@ -644,6 +645,9 @@ struct tcb_s
 #endif
 
   WDOG_ID waitdog;                       /* All timed waits use this timer      */
+#ifdef CONFIG_HRTIMER
+  struct hrtimer_s waittimer;            /* Or this one, if high resolution     */
+#endif
 
   /* Stack-Related Fields *******************************************************/
 
@@ -665,6 +669,12 @@ struct tcb_s
 
   sem_t *waitsem;                        /* Semaphore ID waiting on             */
 
+  /* Futex Control Fields *******************************************************/
+
+#ifdef CONFIG_FUTEX
+  FAR struct futex_waiter_s *futexwait;  /* Waiter queued by FUTEX_WAIT         */
+#endif
+
   /* POSIX Signal Control Fields ************************************************/
 
   sigset_t   sigprocmask;                /* Signals that are blocked            */
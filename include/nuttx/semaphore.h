@@ -310,6 +310,33 @@ int nxsem_timedwait(FAR sem_t *sem, FAR const struct timespec *abstime);
 
 int nxsem_tickwait(FAR sem_t *sem, clock_t start, uint32_t delay);
 
+/****************************************************************************
+ * Name: nxsem_hrtimedwait
+ *
+ * Description:
+ *   This function is a variant of nxsem_timedwait() with a high resolution
+ *   timeout.  It is non-standard and intended only for use within the RTOS.
+ *
+ * Input Parameters:
+ *   sem     - Semaphore object
+ *   expired - The time, in nanoseconds of hrtimer_now(), at which the wait
+ *             times out.  See hrtimer_now() and hrtimer_abstime().
+ *
+ * Returned Value:
+ *   This is an internal OS interface, not available to applications, and
+ *   hence follows the NuttX internal error return policy:  Zero (OK) is
+ *   returned on success.  A negated errno value is returned on failure:
+ *
+ *     -ETIMEDOUT is returned on the timeout condition.
+ *     -EINTR is returned if a signal interrupted the wait.
+ *     -ECANCELED may be returned if the thread is canceled while waiting.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER
+int nxsem_hrtimedwait(FAR sem_t *sem, uint64_t expired);
+#endif
+
 /****************************************************************************
  * Name: nxsem_post
  *
@@ -149,6 +149,33 @@ int bmi160_register(FAR const char *devpath, FAR struct i2c_master_s *dev);
 int bmi160_register(FAR const char *devpath, FAR struct spi_dev_s *dev);
 #  endif
 
+/****************************************************************************
+ * Name: bmi160_register_sensors
+ *
+ * Description:
+ *   Register the BMI160 accelerometer and gyroscope with the common sensor
+ *   upper half as /dev/sensor/accel<devno> and /dev/sensor/gyro<devno>.
+ *   This is an alternative to bmi160_register(): the samples are buffered
+ *   with timestamps and collected in bursts from the FIFO of the chip.
+ *
+ * Input Parameters:
+ *   devno - The device number
+ *   dev   - An instance of the SPI or I2C interface to use to communicate
+ *           with BMI160
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#  ifdef CONFIG_SENSORS_UPPERHALF
+#    ifdef CONFIG_SENSORS_BMI160_I2C
+int bmi160_register_sensors(int devno, FAR struct i2c_master_s *dev);
+#    else /* CONFIG_BMI160_SPI */
+int bmi160_register_sensors(int devno, FAR struct spi_dev_s *dev);
+#    endif
+#  endif
+
 #else /* CONFIG_SENSORS_BMI160_SCU */
 
 #  ifdef CONFIG_SENSORS_BMI160_I2C
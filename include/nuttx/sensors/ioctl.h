@@ -227,4 +227,11 @@
 #define SNIOC_SET_RESOLUTION       _SNIOC(0x0065) /* Arg: uint8_t value */
 #define SNIOC_SET_RANGE            _SNIOC(0x0066) /* Arg: uint8_t value */
 
+/* IOCTL commands of the common sensor upper half (sensor.h) */
+
+#define SNIOC_ACTIVATE             _SNIOC(0x0067) /* Arg: bool value */
+#define SNIOC_BATCH                _SNIOC(0x0068) /* Arg: FAR unsigned int* (usec, in/out) */
+#define SNIOC_SET_BUFFER_NUMBER    _SNIOC(0x0069) /* Arg: unsigned long value (events) */
+#define SNIOC_SET_INTERVAL_US      _SNIOC(0x006a) /* Arg: FAR unsigned int* (usec, in/out) */
+
 #endif /* __INCLUDE_NUTTX_SENSORS_IOCTL_H */
@@ -887,6 +887,29 @@ int lsm6dsl_sensor_register(FAR const char *devpath,
                             FAR struct i2c_master_s *i2c,
                             uint8_t addr);
 
+/****************************************************************************************************
+ * Name: lsm6dsl_register_sensors
+ *
+ * Description:
+ *   Register the LSM6DSL accelerometer and gyroscope with the common sensor upper half as
+ *   /dev/sensor/accel<devno> and /dev/sensor/gyro<devno>.  The samples are buffered with
+ *   timestamps and collected in bursts from the FIFO of the chip.
+ *
+ * Input Parameters:
+ *   devno   - The device number.
+ *   i2c     - An I2C driver instance.
+ *   addr    - The I2C address of the LSM6DSL.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************************************/
+
+#ifdef CONFIG_SENSORS_UPPERHALF
+int lsm6dsl_register_sensors(int devno, FAR struct i2c_master_s *i2c,
+                             uint8_t addr);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
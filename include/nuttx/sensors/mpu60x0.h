@@ -124,4 +124,16 @@ struct mpu_config_s
 
 int mpu60x0_register(FAR const char *path, FAR struct mpu_config_s *config);
 
+/* Declares the existence of an mpu60x0 chip, wired according to
+ * config; registers its accelerometer and gyroscope with the common
+ * sensor upper half as /dev/sensor/accel<devno> and /dev/sensor/gyro<devno>.
+ * Samples are collected in bursts from the FIFO of the chip.
+ *
+ * Returns 0 on success, or negative errno.
+ */
+
+#ifdef CONFIG_SENSORS_UPPERHALF
+int mpu60x0_register_sensors(int devno, FAR struct mpu_config_s *config);
+#endif
+
 #endif /* __INCLUDE_NUTTX_SENSORS_MPU60X0_H */
@@ -0,0 +1,268 @@
+/****************************************************************************
+ * include/nuttx/sensors/sensor.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_SENSORS_SENSOR_H
+#define __INCLUDE_NUTTX_SENSORS_SENSOR_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <nuttx/sensors/ioctl.h>
+
+#ifdef CONFIG_SENSORS_UPPERHALF
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Sensor types.  The type selects the event structure and the name of the
+ * device node: /dev/sensor/<name><devno>.
+ */
+
+#define SENSOR_TYPE_ACCELEROMETER   0  /* accel, struct sensor_event_accel_s */
+#define SENSOR_TYPE_MAGNETIC_FIELD  1  /* mag, struct sensor_event_mag_s */
+#define SENSOR_TYPE_GYROSCOPE       2  /* gyro, struct sensor_event_gyro_s */
+#define SENSOR_TYPE_BAROMETER       3  /* baro, struct sensor_event_baro_s */
+#define SENSOR_TYPE_TEMPERATURE     4  /* temp, struct sensor_event_temp_s */
+#define SENSOR_TYPE_HUMIDITY        5  /* humi, struct sensor_event_humi_s */
+#define SENSOR_TYPE_LIGHT           6  /* light, struct sensor_event_light_s */
+#define SENSOR_TYPE_COUNT           7
+
+/* Standard gravity, used to convert g to m/s^2 */
+
+#define SENSOR_GRAVITY              9.80665f
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Events returned by read().  All timestamps are in microseconds since
+ * boot and refer to the time the sample was taken, which is usually
+ * earlier than the time it was read from a hardware FIFO.
+ */
+
+struct sensor_event_accel_s     /* Type: Accelerometer */
+{
+  uint64_t timestamp;           /* Units is microseconds */
+  float x;                      /* Axis X in m/s^2 */
+  float y;                      /* Axis Y in m/s^2 */
+  float z;                      /* Axis Z in m/s^2 */
+  float temperature;            /* Temperature in degrees Celsius */
+};
+
+struct sensor_event_gyro_s      /* Type: Gyroscope */
+{
+  uint64_t timestamp;           /* Units is microseconds */
+  float x;                      /* Axis X in rad/s */
+  float y;                      /* Axis Y in rad/s */
+  float z;                      /* Axis Z in rad/s */
+  float temperature;            /* Temperature in degrees Celsius */
+};
+
+struct sensor_event_mag_s       /* Type: Magnetic Field */
+{
+  uint64_t timestamp;           /* Units is microseconds */
+  float x;                      /* Axis X in Gauss or micro Tesla (uT) */
+  float y;                      /* Axis Y in Gauss or micro Tesla (uT) */
+  float z;                      /* Axis Z in Gauss or micro Tesla (uT) */
+  float temperature;            /* Temperature in degrees Celsius */
+};
+
+struct sensor_event_baro_s      /* Type: Barometer */
+{
+  uint64_t timestamp;           /* Units is microseconds */
+  float pressure;               /* Pressure in millibar or hPa */
+  float temperature;            /* Temperature in degrees Celsius */
+};
+
+struct sensor_event_temp_s      /* Type: Temperature */
+{
+  uint64_t timestamp;           /* Units is microseconds */
+  float temperature;            /* Temperature in degrees Celsius */
+};
+
+struct sensor_event_humi_s      /* Type: Relative Humidity */
+{
+  uint64_t timestamp;           /* Units is microseconds */
+  float humidity;               /* Humidity in percent */
+};
+
+struct sensor_event_light_s     /* Type: Light */
+{
+  uint64_t timestamp;           /* Units is microseconds */
+  float light;                  /* Light in SI lux units */
+  float ir;                     /* Infrared in SI lux units */
+};
+
+/* Called by the lower half to hand events to the upper half.  data may
+ * hold several events of the sensor type, e.g. all the samples drained
+ * from a hardware FIFO in one burst.  May be called from interrupt level.
+ */
+
+struct sensor_lowerhalf_s;
+typedef CODE void (*sensor_push_event_t)(FAR void *priv,
+                                         FAR const void *data,
+                                         size_t bytes);
+
+/* The operations provided by the lower half */
+
+struct sensor_ops_s
+{
+  /**************************************************************************
+   * Name: activate
+   *
+   * Description:
+   *   Enable or disable the sensor.  An enabled sensor pushes events at the
+   *   configured interval (or in bursts if batching is enabled).
+   *
+   **************************************************************************/
+
+  CODE int (*activate)(FAR struct sensor_lowerhalf_s *lower, bool enable);
+
+  /**************************************************************************
+   * Name: set_interval
+   *
+   * Description:
+   *   Set the sampling interval in microseconds.  The lower half rounds the
+   *   request to what the hardware supports, preferring faster rates, and
+   *   returns the actual interval in *period_us.
+   *
+   **************************************************************************/
+
+  CODE int (*set_interval)(FAR struct sensor_lowerhalf_s *lower,
+                           FAR unsigned int *period_us);
+
+  /**************************************************************************
+   * Name: batch
+   *
+   * Description:
+   *   Set the maximum delay in microseconds between the sampling of an
+   *   event and its delivery to the upper half.  Zero disables batching.
+   *   Sensors with a hardware FIFO let it fill up to this latency and
+   *   drain it in one burst.  The lower half returns the actual latency,
+   *   which is limited by the FIFO depth (batch_number).  Optional: may be
+   *   NULL if the sensor has no FIFO.
+   *
+   **************************************************************************/
+
+  CODE int (*batch)(FAR struct sensor_lowerhalf_s *lower,
+                    FAR unsigned int *latency_us);
+
+  /**************************************************************************
+   * Name: control
+   *
+   * Description:
+   *   Handle the IOCTL commands that are not known to the upper half.
+   *   Optional: may be NULL.
+   *
+   **************************************************************************/
+
+  CODE int (*control)(FAR struct sensor_lowerhalf_s *lower,
+                      int cmd, unsigned long arg);
+};
+
+/* This structure is the interface between the upper half and the lower
+ * half.  The lower half allocates it and sets up the first fields; the
+ * upper half sets up push_event and priv in sensor_register().
+ */
+
+struct sensor_lowerhalf_s
+{
+  int type;                          /* SENSOR_TYPE_* */
+  unsigned long buffer_number;       /* Minimum number of buffered events */
+  unsigned long batch_number;        /* Depth of the hardware FIFO in
+                                      * events, zero if none */
+  FAR const struct sensor_ops_s *ops;
+
+  /* Set by the upper half */
+
+  sensor_push_event_t push_event;
+  FAR void *priv;
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: sensor_get_timestamp
+ *
+ * Description:
+ *   Return the current time in microseconds, for use as event timestamp.
+ *
+ ****************************************************************************/
+
+uint64_t sensor_get_timestamp(void);
+
+/****************************************************************************
+ * Name: sensor_register
+ *
+ * Description:
+ *   Register the sensor lower half as /dev/sensor/<name><devno>, where the
+ *   name depends on the sensor type (accel, mag, gyro, baro, temp, humi or
+ *   light).
+ *
+ * Input Parameters:
+ *   lower - The lower half instance
+ *   devno - The device number
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int sensor_register(FAR struct sensor_lowerhalf_s *lower, int devno);
+
+/****************************************************************************
+ * Name: sensor_unregister
+ *
+ * Description:
+ *   Unregister a sensor registered with sensor_register().
+ *
+ * Input Parameters:
+ *   lower - The lower half instance
+ *   devno - The device number
+ *
+ ****************************************************************************/
+
+void sensor_unregister(FAR struct sensor_lowerhalf_s *lower, int devno);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_SENSORS_UPPERHALF */
+#endif /* __INCLUDE_NUTTX_SENSORS_SENSOR_H */
@@ -0,0 +1,125 @@
+/****************************************************************************
+ * include/nuttx/seqlock.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_SEQLOCK_H
+#define __INCLUDE_NUTTX_SEQLOCK_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Sequence locks for small records that are read far more often than they
+ * are written, such as the time base.
+ *
+ * A reader takes no lock: it samples the sequence with read_seqbegin(),
+ * copies the record and starts over if read_seqretry() reports that a
+ * writer got in the way.  A writer brackets its update with
+ * write_seqbegin() and write_seqend(); the sequence is odd while the
+ * update is in progress.
+ *
+ * The writers must exclude each other and must not be interrupted by a
+ * reader on their own CPU, or that reader would spin forever.  Holding
+ * the critical section does both.  A reader that itself holds the
+ * critical section can read the record directly.
+ */
+
+#define SEQLOCK_INITIALIZER  { 0 }
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+typedef struct
+{
+  volatile uint32_t sequence;
+} seqlock_t;
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: read_seqbegin
+ *
+ * Description:
+ *   Begin a read of the record protected by 'sl', waiting for any update
+ *   in progress on another CPU to complete.
+ *
+ * Returned Value:
+ *   The sequence to be passed to read_seqretry().
+ *
+ ****************************************************************************/
+
+static inline uint32_t read_seqbegin(FAR const seqlock_t *sl)
+{
+  uint32_t seq;
+
+  while (((seq = __atomic_load_n(&sl->sequence, __ATOMIC_ACQUIRE)) & 1)
+         != 0)
+    {
+    }
+
+  return seq;
+}
+
+/****************************************************************************
+ * Name: read_seqretry
+ *
+ * Description:
+ *   Return true if the record was updated since read_seqbegin() returned
+ *   'seq', in which case the copy must be discarded and read again.
+ *
+ ****************************************************************************/
+
+static inline bool read_seqretry(FAR const seqlock_t *sl, uint32_t seq)
+{
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  return __atomic_load_n(&sl->sequence, __ATOMIC_RELAXED) != seq;
+}
+
+/****************************************************************************
+ * Name: write_seqbegin
+ ****************************************************************************/
+
+static inline void write_seqbegin(FAR seqlock_t *sl)
+{
+  __atomic_store_n(&sl->sequence, sl->sequence + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/****************************************************************************
+ * Name: write_seqend
+ ****************************************************************************/
+
+static inline void write_seqend(FAR seqlock_t *sl)
+{
+  __atomic_store_n(&sl->sequence, sl->sequence + 1, __ATOMIC_RELEASE);
+}
+
+#endif /* __INCLUDE_NUTTX_SEQLOCK_H */
@@ -277,7 +277,12 @@ typedef int pthread_condattr_t;
 
 struct pthread_cond_s
 {
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+  volatile uint32_t seq;       /* Futex bumped by each signal and broadcast */
+  volatile uint32_t nwaiters;  /* Number of threads waiting on seq */
+#else
   sem_t sem;
+#endif
 };
 
 #ifndef __PTHREAD_COND_T_DEFINED
@@ -285,7 +290,11 @@ typedef struct pthread_cond_s pthread_cond_t;
 #define __PTHREAD_COND_T_DEFINED 1
 #endif
 
-#define PTHREAD_COND_INITIALIZER {SEM_INITIALIZER(0)}
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+#  define PTHREAD_COND_INITIALIZER {0, 0}
+#else
+#  define PTHREAD_COND_INITIALIZER {SEM_INITIALIZER(0)}
+#endif
 
 struct pthread_mutexattr_s
 {
@@ -316,7 +325,11 @@ struct pthread_mutex_s
 
   /* Payload */
 
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+  volatile uint32_t futex; /* 0: unlocked, 1: locked, 2: locked, contended */
+#else
   sem_t sem;        /* Semaphore underlying the implementation of the mutex */
+#endif
   pid_t pid;        /* ID of the holder of the mutex */
 #ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
   uint8_t flags;    /* See _PTHREAD_MFLAGS_* */
@@ -340,18 +353,24 @@ typedef struct pthread_mutex_s pthread_mutex_t;
 #  endif
 #endif
 
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+#  define __PTHREAD_MUTEX_LOCK_INITIALIZER 0
+#else
+#  define __PTHREAD_MUTEX_LOCK_INITIALIZER SEM_INITIALIZER(1)
+#endif
+
 #if defined(CONFIG_PTHREAD_MUTEX_TYPES) && !defined(CONFIG_PTHREAD_MUTEX_UNSAFE)
-#  define PTHREAD_MUTEX_INITIALIZER {NULL, SEM_INITIALIZER(1), -1, \
-                                     __PTHREAD_MUTEX_DEFAULT_FLAGS, \
+#  define PTHREAD_MUTEX_INITIALIZER {NULL, __PTHREAD_MUTEX_LOCK_INITIALIZER, \
+                                     -1, __PTHREAD_MUTEX_DEFAULT_FLAGS, \
                                      PTHREAD_MUTEX_DEFAULT, 0}
 #elif defined(CONFIG_PTHREAD_MUTEX_TYPES)
-#  define PTHREAD_MUTEX_INITIALIZER {SEM_INITIALIZER(1), -1, \
+#  define PTHREAD_MUTEX_INITIALIZER {__PTHREAD_MUTEX_LOCK_INITIALIZER, -1, \
                                      PTHREAD_MUTEX_DEFAULT, 0}
 #elif !defined(CONFIG_PTHREAD_MUTEX_UNSAFE)
-#  define PTHREAD_MUTEX_INITIALIZER {NULL, SEM_INITIALIZER(1), -1,\
-                                     __PTHREAD_MUTEX_DEFAULT_FLAGS}
+#  define PTHREAD_MUTEX_INITIALIZER {NULL, __PTHREAD_MUTEX_LOCK_INITIALIZER, \
+                                     -1, __PTHREAD_MUTEX_DEFAULT_FLAGS}
 #else
-#  define PTHREAD_MUTEX_INITIALIZER {SEM_INITIALIZER(1), -1}
+#  define PTHREAD_MUTEX_INITIALIZER {__PTHREAD_MUTEX_LOCK_INITIALIZER, -1}
 #endif
 
 struct pthread_barrierattr_s
@@ -90,6 +90,10 @@
 #define putchar(c) fputc(c, stdout)
 #define getc(s)    fgetc(s)
 #define getchar()  fgetc(stdin)
+#define getc_unlocked(s)    fgetc_unlocked(s)
+#define putc_unlocked(c,s)  fputc_unlocked((c),(s))
+#define getchar_unlocked()  fgetc_unlocked(stdin)
+#define putchar_unlocked(c) fputc_unlocked((c), stdout)
 #define rewind(s)  ((void)fseek((s),0,SEEK_SET))
 
 /* Path to the directory where temporary files can be created */
@@ -172,6 +176,18 @@ void   setbuf(FAR FILE *stream, FAR char *buf);
 int    setvbuf(FAR FILE *stream, FAR char *buffer, int mode, size_t size);
 int    ungetc(int c, FAR FILE *stream);
 
+/* Explicit stream locking and the lock-free operations used under it */
+
+void   flockfile(FAR FILE *stream);
+int    ftrylockfile(FAR FILE *stream);
+void   funlockfile(FAR FILE *stream);
+int    fgetc_unlocked(FAR FILE *stream);
+int    fputc_unlocked(int c, FAR FILE *stream);
+size_t fread_unlocked(FAR void *ptr, size_t size, size_t n_items,
+         FAR FILE *stream);
+size_t fwrite_unlocked(FAR const void *ptr, size_t size, size_t n_items,
+         FAR FILE *stream);
+
 /* Operations on the stdout stream, buffers, paths, and the whole printf-family */
 
 void   perror(FAR const char *s);
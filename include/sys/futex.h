@@ -0,0 +1,77 @@
+/****************************************************************************
+ * include/sys/futex.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_SYS_FUTEX_H
+#define __INCLUDE_SYS_FUTEX_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <time.h>
+
+#ifdef CONFIG_FUTEX
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* futex() operations
+ *
+ * FUTEX_WAIT - Sleep on uaddr if it still holds val.  Fails with EAGAIN
+ *              if it does not, with ETIMEDOUT once the absolute
+ *              CLOCK_REALTIME time in abstime has passed (NULL waits
+ *              forever) and with EINTR if a signal is received.
+ * FUTEX_WAKE - Wake at most val threads sleeping on uaddr.  Returns the
+ *              number of threads woken.
+ *
+ * A futex is private to the address space it lives in: in a kernel build
+ * two processes never share one, even when they share the memory.
+ */
+
+#define FUTEX_WAIT          0
+#define FUTEX_WAKE          1
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+int futex(FAR volatile uint32_t *uaddr, int op, uint32_t val,
+          FAR const struct timespec *abstime);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_FUTEX */
+#endif /* __INCLUDE_SYS_FUTEX_H */
@@ -0,0 +1,187 @@
+/****************************************************************************
+ * include/sys/ioring.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_SYS_IORING_H
+#define __INCLUDE_SYS_IORING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#include <nuttx/fs/ioctl.h>
+
+#ifdef CONFIG_FS_AIO_RING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The I/O ring device.  Each open() of the device creates a new ring. */
+
+#define IORING_DEVPATH      "/dev/ioring"
+
+/* Operations.  Fields of struct ioring_sqe that an operation does not list
+ * are ignored.
+ *
+ * IORING_OP_NOP    - Complete at once with res == 0
+ * IORING_OP_READ   - pread(fd, addr, len, off), or recv() on a socket
+ * IORING_OP_WRITE  - pwrite(fd, addr, len, off), or send() on a socket
+ * IORING_OP_FSYNC  - fsync(fd)
+ * IORING_OP_SEND   - send(fd, addr, len, op_flags)
+ * IORING_OP_RECV   - recv(fd, addr, len, op_flags)
+ * IORING_OP_ACCEPT - accept(fd, addr, addr2).  res is the new descriptor.
+ * IORING_OP_POLL   - Wait for the events in op_flags on fd.  off is the
+ *                    timeout in milliseconds, negative to wait forever.
+ *                    res is the returned events, or zero on timeout.
+ */
+
+#define IORING_OP_NOP       0
+#define IORING_OP_READ      1
+#define IORING_OP_WRITE     2
+#define IORING_OP_FSYNC     3
+#define IORING_OP_SEND      4
+#define IORING_OP_RECV      5
+#define IORING_OP_ACCEPT    6
+#define IORING_OP_POLL      7
+#define IORING_OP_NOPS      8
+
+/* ioctl commands
+ *
+ * IORINGIOC_SETUP - Size the ring and map it into the caller.  Argument:
+ *                   FAR struct ioring_params *.  May be issued only once.
+ * IORINGIOC_ENTER - Consume submission queue entries and, optionally, wait
+ *                   for completions.  Argument: FAR struct ioring_enter_s *.
+ *                   Returns the number of entries consumed.
+ */
+
+#define IORINGIOC_SETUP     _IORINGIOC(0x0001)
+#define IORINGIOC_ENTER     _IORINGIOC(0x0002)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Submission queue entry */
+
+struct ioring_sqe
+{
+  uint8_t   opcode;           /* IORING_OP_* */
+  uint8_t   flags;            /* Reserved, must be zero */
+  uint16_t  reserved;
+  int32_t   fd;               /* File or socket descriptor */
+  off_t     off;              /* File offset or poll timeout */
+  FAR void *addr;             /* Buffer or socket address */
+  FAR void *addr2;            /* Socket address length (accept) */
+  uint32_t  len;              /* Buffer length */
+  uint32_t  op_flags;         /* MSG_* flags or poll events */
+  uintptr_t user_data;        /* Copied unchanged to the completion */
+};
+
+/* Completion queue entry */
+
+struct ioring_cqe
+{
+  uintptr_t user_data;        /* From the submission queue entry */
+  int32_t   res;              /* Result, or a negated errno value */
+  uint32_t  flags;            /* Reserved */
+};
+
+/* The shared ring state.  User space produces submission queue entries at
+ * sq_tail and consumes completion queue entries at cq_head; the kernel does
+ * the reverse.  The indices run freely and are masked on use.  The entries
+ * follow this structure in the same allocation.
+ */
+
+struct ioring_rings
+{
+  volatile uint32_t sq_head;  /* Written by the kernel */
+  volatile uint32_t sq_tail;  /* Written by user space */
+  volatile uint32_t cq_head;  /* Written by user space */
+  volatile uint32_t cq_tail;  /* Written by the kernel */
+  uint32_t sq_mask;           /* Number of submission entries - 1 */
+  uint32_t cq_mask;           /* Number of completion entries - 1 */
+  FAR struct ioring_sqe *sqes;
+  FAR struct ioring_cqe *cqes;
+};
+
+/* Argument of IORINGIOC_SETUP */
+
+struct ioring_params
+{
+  uint32_t sq_entries;        /* In/out: rounded up to a power of two */
+  uint32_t cq_entries;        /* In/out: zero selects twice sq_entries */
+
+  /* Out: the shared ring state */
+
+  FAR struct ioring_rings *rings;
+};
+
+/* Argument of IORINGIOC_ENTER */
+
+struct ioring_enter_s
+{
+  uint32_t to_submit;         /* Most entries to consume */
+  uint32_t min_complete;      /* Completions to wait for */
+};
+
+/* User-space handle kept by the helper functions below */
+
+struct ioring
+{
+  int fd;                     /* Open descriptor of IORING_DEVPATH */
+  uint32_t sq_tail;           /* Entries handed out but not yet published */
+  FAR struct ioring_rings *rings;
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/* Helpers in the C library that hide the ring protocol */
+
+int ioring_queue_init(unsigned int entries, FAR struct ioring *ring);
+void ioring_queue_exit(FAR struct ioring *ring);
+FAR struct ioring_sqe *ioring_get_sqe(FAR struct ioring *ring);
+int ioring_submit(FAR struct ioring *ring, unsigned int wait_nr);
+FAR struct ioring_cqe *ioring_peek_cqe(FAR struct ioring *ring);
+int ioring_wait_cqe(FAR struct ioring *ring, FAR struct ioring_cqe **cqep);
+void ioring_cqe_seen(FAR struct ioring *ring);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_FS_AIO_RING */
+#endif /* __INCLUDE_SYS_IORING_H */
@@ -0,0 +1,170 @@
+/****************************************************************************
+ * include/sys/shmring.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_SYS_SHMRING_H
+#define __INCLUDE_SYS_SHMRING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#include <nuttx/fs/ioctl.h>
+
+#ifdef CONFIG_DEV_SHMRING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The shared ring device.  Each open() of the device is attached to one
+ * named ring with SHMRINGIOC_ATTACH.
+ */
+
+#define SHMRING_DEVPATH     "/dev/shmring"
+
+/* Longest ring name, not counting the terminating NUL */
+
+#define SHMRING_NAME_MAX    31
+
+/* Ring flags given at creation */
+
+#define SHMRING_SPSC        (1 << 0) /* One producer and one consumer only */
+
+/* ioctl commands
+ *
+ * SHMRINGIOC_ATTACH - Attach the descriptor to a ring, creating it if
+ *                     O_CREAT is given.  Argument:
+ *                     FAR struct shmring_attach_s *.  May be issued only
+ *                     once.
+ * SHMRINGIOC_WAIT   - Wait until the ring is readable (POLLIN) or writable
+ *                     (POLLOUT).  Argument: the event.
+ * SHMRINGIOC_WAKE   - Wake the consumers (POLLIN) and/or the producers
+ *                     (POLLOUT) waiting on the ring.  Argument: the events.
+ */
+
+#define SHMRINGIOC_ATTACH   _SHMRINGIOC(0x0001)
+#define SHMRINGIOC_WAIT     _SHMRINGIOC(0x0002)
+#define SHMRINGIOC_WAKE     _SHMRINGIOC(0x0003)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Each slot starts with this header, followed by the payload.  seq tells
+ * whose turn it is: a slot at position pos may be produced when
+ * seq == pos, and consumed when seq == pos + 1.
+ */
+
+struct shmring_slot_s
+{
+  volatile uint32_t seq;      /* Turn of the slot, see above */
+  uint32_t len;               /* Length of the payload */
+};
+
+/* The shared ring state.  Producers claim positions at head and consumers
+ * at tail; the indices run freely and are masked on use.  A side that
+ * finds the ring full or empty counts itself in wwait or rwait before it
+ * sleeps, so the other side knows to issue SHMRINGIOC_WAKE.  The slots
+ * follow this structure in the same allocation.
+ */
+
+struct shmring_ctrl_s
+{
+  volatile uint32_t head;     /* Next position to produce */
+  volatile uint32_t tail;     /* Next position to consume */
+  volatile uint32_t rwait;    /* Consumers waiting for data */
+  volatile uint32_t wwait;    /* Producers waiting for room */
+  uint32_t mask;              /* Number of slots - 1 */
+  uint32_t slotsize;          /* Payload bytes per slot */
+  uint32_t stride;            /* Bytes from one slot to the next */
+  uint32_t flags;             /* SHMRING_* flags */
+  FAR uint8_t *slots;
+};
+
+/* Geometry of a new ring */
+
+struct shmring_attr_s
+{
+  uint32_t nslots;            /* Rounded up to a power of two */
+  uint32_t slotsize;          /* Largest payload of one slot */
+  uint32_t flags;             /* SHMRING_* flags */
+};
+
+/* Argument of SHMRINGIOC_ATTACH */
+
+struct shmring_attach_s
+{
+  FAR const char *name;       /* Name of the ring */
+  int oflag;                  /* O_CREAT and O_EXCL as for mq_open() */
+  struct shmring_attr_s attr; /* Geometry if the ring is created */
+
+  /* Out: the shared ring state */
+
+  FAR struct shmring_ctrl_s *ctrl;
+};
+
+/* User-space handle kept by the helper functions below */
+
+struct shmring_s
+{
+  int fd;                     /* Open descriptor of SHMRING_DEVPATH */
+  int oflag;                  /* O_NONBLOCK makes the helpers not wait */
+  FAR struct shmring_ctrl_s *ctrl;
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/* Helpers in the C library that hide the ring protocol.  A producer
+ * fills the buffer returned by shmring_reserve() in place and publishes
+ * it with shmring_commit(); a consumer reads the buffer returned by
+ * shmring_peek() in place and hands it back with shmring_release().
+ */
+
+int shmring_open(FAR struct shmring_s *ring, FAR const char *name,
+                 int oflag, FAR const struct shmring_attr_s *attr);
+void shmring_close(FAR struct shmring_s *ring);
+FAR void *shmring_reserve(FAR struct shmring_s *ring);
+void shmring_commit(FAR struct shmring_s *ring, FAR void *buf, size_t len);
+FAR void *shmring_peek(FAR struct shmring_s *ring, FAR size_t *len);
+void shmring_release(FAR struct shmring_s *ring, FAR void *buf);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_DEV_SHMRING */
+#endif /* __INCLUDE_SYS_SHMRING_H */
@@ -294,15 +294,19 @@
 #define SYS_write                    (__SYS_descriptors + 3)
 #define SYS_pread                    (__SYS_descriptors + 4)
 #define SYS_pwrite                   (__SYS_descriptors + 5)
+#define SYS_readv                    (__SYS_descriptors + 6)
+#define SYS_writev                   (__SYS_descriptors + 7)
+#define SYS_preadv                   (__SYS_descriptors + 8)
+#define SYS_pwritev                  (__SYS_descriptors + 9)
 
 #ifdef CONFIG_FS_AIO
-#  define SYS_aio_read               (__SYS_descriptors + 6)
-#  define SYS_aio_write              (__SYS_descriptors + 7)
-#  define SYS_aio_fsync              (__SYS_descriptors + 8)
-#  define SYS_aio_cancel             (__SYS_descriptors + 9)
-#  define __SYS_poll                 (__SYS_descriptors + 10)
+#  define SYS_aio_read               (__SYS_descriptors + 10)
+#  define SYS_aio_write              (__SYS_descriptors + 11)
+#  define SYS_aio_fsync              (__SYS_descriptors + 12)
+#  define SYS_aio_cancel             (__SYS_descriptors + 13)
+#  define __SYS_poll                 (__SYS_descriptors + 14)
 #else
-#  define __SYS_poll                 (__SYS_descriptors + 6)
+#  define __SYS_poll                 (__SYS_descriptors + 10)
 #endif
 
 #define SYS_poll                     (__SYS_poll + 0)
@@ -356,7 +360,8 @@
 
 #ifdef CONFIG_FS_RAMMAP
 #  define SYS_munmap                   (__SYS_filedesc + 16)
-#  define __SYS_link                   (__SYS_filedesc + 17)
+#  define SYS_msync                    (__SYS_filedesc + 17)
+#  define __SYS_link                   (__SYS_filedesc + 18)
 #else
 #  define __SYS_link                   (__SYS_filedesc + 16)
 #endif
@@ -428,31 +433,41 @@
 
 #ifndef CONFIG_DISABLE_PTHREAD
 #  define SYS_pthread_cancel           (__SYS_pthread + 0)
-#  define SYS_pthread_cond_broadcast   (__SYS_pthread + 1)
-#  define SYS_pthread_cond_signal      (__SYS_pthread + 2)
-#  define SYS_pthread_cond_wait        (__SYS_pthread + 3)
-#  define SYS_pthread_create           (__SYS_pthread + 4)
-#  define SYS_pthread_detach           (__SYS_pthread + 5)
-#  define SYS_pthread_exit             (__SYS_pthread + 6)
-#  define SYS_pthread_get_stackaddr_np (__SYS_pthread + 7)
-#  define SYS_pthread_get_stacksize_np (__SYS_pthread + 8)
-#  define SYS_pthread_getschedparam    (__SYS_pthread + 9)
-#  define SYS_pthread_getspecific      (__SYS_pthread + 10)
-#  define SYS_pthread_join             (__SYS_pthread + 11)
-#  define SYS_pthread_key_create       (__SYS_pthread + 12)
-#  define SYS_pthread_key_delete       (__SYS_pthread + 13)
-#  define SYS_pthread_mutex_destroy    (__SYS_pthread + 14)
-#  define SYS_pthread_mutex_init       (__SYS_pthread + 15)
-#  define SYS_pthread_mutex_timedlock  (__SYS_pthread + 16)
-#  define SYS_pthread_mutex_trylock    (__SYS_pthread + 17)
-#  define SYS_pthread_mutex_unlock     (__SYS_pthread + 18)
-
-#ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
-#  define SYS_pthread_mutex_consistent (__SYS_pthread + 19)
-#  define __SYS_pthread_setschedparam  (__SYS_pthread + 20)
-#else
-#  define __SYS_pthread_setschedparam  (__SYS_pthread + 19)
-#endif
+#  define SYS_pthread_create           (__SYS_pthread + 1)
+#  define SYS_pthread_detach           (__SYS_pthread + 2)
+#  define SYS_pthread_exit             (__SYS_pthread + 3)
+#  define SYS_pthread_get_stackaddr_np (__SYS_pthread + 4)
+#  define SYS_pthread_get_stacksize_np (__SYS_pthread + 5)
+#  define SYS_pthread_getschedparam    (__SYS_pthread + 6)
+#  define SYS_pthread_getspecific      (__SYS_pthread + 7)
+#  define SYS_pthread_join             (__SYS_pthread + 8)
+#  define SYS_pthread_key_create       (__SYS_pthread + 9)
+#  define SYS_pthread_key_delete       (__SYS_pthread + 10)
+#  define __SYS_pthread_mutex          (__SYS_pthread + 11)
+
+/* Futex-based mutexes and condition variables live in the C library */
+
+#  ifndef CONFIG_PTHREAD_MUTEX_FUTEX
+#    define SYS_pthread_cond_broadcast   (__SYS_pthread_mutex + 0)
+#    define SYS_pthread_cond_signal      (__SYS_pthread_mutex + 1)
+#    define SYS_pthread_cond_timedwait   (__SYS_pthread_mutex + 2)
+#    define SYS_pthread_cond_wait        (__SYS_pthread_mutex + 3)
+#    define SYS_pthread_mutex_destroy    (__SYS_pthread_mutex + 4)
+#    define SYS_pthread_mutex_init       (__SYS_pthread_mutex + 5)
+#    define SYS_pthread_mutex_timedlock  (__SYS_pthread_mutex + 6)
+#    define SYS_pthread_mutex_trylock    (__SYS_pthread_mutex + 7)
+#    define SYS_pthread_mutex_unlock     (__SYS_pthread_mutex + 8)
+#    define __SYS_pthread_consistent     (__SYS_pthread_mutex + 9)
+#  else
+#    define __SYS_pthread_consistent     (__SYS_pthread_mutex + 0)
+#  endif
+
+#  ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
+#    define SYS_pthread_mutex_consistent (__SYS_pthread_consistent + 0)
+#    define __SYS_pthread_setschedparam  (__SYS_pthread_consistent + 1)
+#  else
+#    define __SYS_pthread_setschedparam  (__SYS_pthread_consistent + 0)
+#  endif
 
 #  define SYS_pthread_setschedparam    (__SYS_pthread_setschedparam + 0)
 #  define SYS_pthread_setschedprio     (__SYS_pthread_setschedparam + 1)
@@ -467,10 +482,9 @@
 #    define __SYS_pthread_signals      (__SYS_pthread_smp + 0)
 #  endif
 
-#  define SYS_pthread_cond_timedwait   (__SYS_pthread_signals + 0)
-#  define SYS_pthread_kill             (__SYS_pthread_signals + 1)
-#  define SYS_pthread_sigmask          (__SYS_pthread_signals + 2)
-#  define __SYS_pthread_cleanup        (__SYS_pthread_signals + 3)
+#  define SYS_pthread_kill             (__SYS_pthread_signals + 0)
+#  define SYS_pthread_sigmask          (__SYS_pthread_signals + 1)
+#  define __SYS_pthread_cleanup        (__SYS_pthread_signals + 2)
 
 #  ifdef CONFIG_PTHREAD_CLEANUP
 #    define SYS_pthread_cleanup_push   (__SYS_pthread_cleanup + 0)
@@ -560,9 +574,18 @@
 
 #ifdef CONFIG_CRYPTO_RANDOM_POOL
 #  define SYS_getrandom                (__SYS_prctl + 0)
-#  define SYS_maxsyscall               (__SYS_prctl + 1)
+#  define __SYS_futex                  (__SYS_prctl + 1)
+#else
+#  define __SYS_futex                  (__SYS_prctl + 0)
+#endif
+
+/* The following is defined only if futexes are enabled */
+
+#ifdef CONFIG_FUTEX
+#  define SYS_futex                    (__SYS_futex + 0)
+#  define SYS_maxsyscall               (__SYS_futex + 1)
 #else
-#  define SYS_maxsyscall               (__SYS_prctl + 0)
+#  define SYS_maxsyscall               (__SYS_futex + 0)
 #endif
 
 /* Note that the reported number of system calls does *NOT* include the
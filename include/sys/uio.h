@@ -89,8 +89,7 @@ struct iovec
  *
  *    EINVAL.
  *      The sum of the iov_len values in the iov array overflowed an ssize_t
- *      or The 'iovcnt' argument was less than or equal to 0, or greater than
- *      IOV_MAX (Not implemented).
+ *      or The 'iovcnt' argument was less than 0.
  *
  ****************************************************************************/
 
@@ -114,7 +113,7 @@ ssize_t readv(int fildes, FAR const struct iovec *iov, int iovcnt);
  *   the array pointed to by iov are 0, writev() will return 0 and have no
  *   other effect. For other file types, the behavior is unspecified.
  *
- *   TODO: If the sum of the iov_len values is greater than SSIZE_MAX, the
+ *   If the sum of the iov_len values is greater than SSIZE_MAX, the
  *   operation will fail and no data will be transferred.
  *
  * Input Parameters:
@@ -131,11 +130,35 @@ ssize_t readv(int fildes, FAR const struct iovec *iov, int iovcnt);
  *
  *    EINVAL.
  *      The sum of the iov_len values in the iov array overflowed an ssize_t
- *      or The 'iovcnt' argument was less than or equal to 0, or greater than
- *      IOV_MAX (Not implemented).
+ *      or The 'iovcnt' argument was less than 0.
  *
  ****************************************************************************/
 
 ssize_t writev(int fildes, FAR const struct iovec *iov, int iovcnt);
 
+/****************************************************************************
+ * Name: preadv() and pwritev()
+ *
+ * Description:
+ *   Equivalent to readv() and writev() except that the transfer starts at
+ *   'offset' in the file, and the file offset is not changed.  The file
+ *   must be capable of seeking.
+ *
+ * Input Parameters:
+ *   filedes - The open file descriptor for the file
+ *   iov     - Array of buffer descriptors
+ *   iovcnt  - Number of elements in iov[]
+ *   offset  - File offset of the transfer
+ *
+ * Returned Value:
+ *   As for readv() and writev().  ESPIPE is returned if 'filedes' is
+ *   associated with a pipe, FIFO or socket.
+ *
+ ****************************************************************************/
+
+ssize_t preadv(int fildes, FAR const struct iovec *iov, int iovcnt,
+               off_t offset);
+ssize_t pwritev(int fildes, FAR const struct iovec *iov, int iovcnt,
+                off_t offset);
+
 #endif /* __INCLUDE_SYS_UIO_H */
@@ -0,0 +1,258 @@
+/****************************************************************************
+ * libs/libc/aio/lib_ioring.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/ioctl.h>
+#include <sys/ioring.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#include <nuttx/spinlock.h>
+
+#ifdef CONFIG_FS_AIO_RING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* SP_DMB() orders the queue entries against the indices that publish them.
+ * Without SMP, only the compiler must be kept from reordering them.
+ */
+
+#ifndef SP_DMB
+#  ifdef __GNUC__
+#    define SP_DMB() __asm__ __volatile__ ("" : : : "memory")
+#  else
+#    define SP_DMB()
+#  endif
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ioring_queue_init
+ *
+ * Description:
+ *   Open a new I/O ring with at least 'entries' submission queue entries
+ *   and twice as many completion queue entries.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -1 (ERROR) on failure with errno set.
+ *
+ ****************************************************************************/
+
+int ioring_queue_init(unsigned int entries, FAR struct ioring *ring)
+{
+  struct ioring_params params;
+  int errcode;
+  int ret;
+
+  ring->fd = open(IORING_DEVPATH, O_RDWR);
+  if (ring->fd < 0)
+    {
+      return ERROR;
+    }
+
+  memset(&params, 0, sizeof(struct ioring_params));
+  params.sq_entries = entries;
+
+  ret = ioctl(ring->fd, IORINGIOC_SETUP,
+              (unsigned long)((uintptr_t)&params));
+  if (ret < 0)
+    {
+      errcode = get_errno();
+      close(ring->fd);
+      ring->fd = -1;
+      set_errno(errcode);
+      return ERROR;
+    }
+
+  ring->rings   = params.rings;
+  ring->sq_tail = params.rings->sq_tail;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ioring_queue_exit
+ *
+ * Description:
+ *   Close an I/O ring.  Requests that have not started are canceled; the
+ *   call waits for those that have.
+ *
+ ****************************************************************************/
+
+void ioring_queue_exit(FAR struct ioring *ring)
+{
+  close(ring->fd);
+  ring->fd    = -1;
+  ring->rings = NULL;
+}
+
+/****************************************************************************
+ * Name: ioring_get_sqe
+ *
+ * Description:
+ *   Return the next free submission queue entry, cleared, or NULL if the
+ *   queue is full.  The entry is not seen by the kernel until the next
+ *   ioring_submit().
+ *
+ ****************************************************************************/
+
+FAR struct ioring_sqe *ioring_get_sqe(FAR struct ioring *ring)
+{
+  FAR struct ioring_rings *rings = ring->rings;
+  FAR struct ioring_sqe *sqe;
+
+  if (ring->sq_tail - rings->sq_head > rings->sq_mask)
+    {
+      return NULL;
+    }
+
+  sqe = &rings->sqes[ring->sq_tail++ & rings->sq_mask];
+  memset(sqe, 0, sizeof(struct ioring_sqe));
+  return sqe;
+}
+
+/****************************************************************************
+ * Name: ioring_submit
+ *
+ * Description:
+ *   Publish the entries obtained from ioring_get_sqe() and hand them all
+ *   to the kernel with one call, then wait for at least 'wait_nr'
+ *   completions.
+ *
+ * Returned Value:
+ *   The number of entries submitted; -1 (ERROR) on failure with errno set.
+ *
+ ****************************************************************************/
+
+int ioring_submit(FAR struct ioring *ring, unsigned int wait_nr)
+{
+  FAR struct ioring_rings *rings = ring->rings;
+  struct ioring_enter_s enter;
+
+  /* The entries must be visible before the tail that publishes them */
+
+  SP_DMB();
+  rings->sq_tail = ring->sq_tail;
+
+  enter.to_submit    = ring->sq_tail - rings->sq_head;
+  enter.min_complete = wait_nr;
+
+  if (enter.to_submit == 0 && wait_nr == 0)
+    {
+      return 0;
+    }
+
+  return ioctl(ring->fd, IORINGIOC_ENTER,
+               (unsigned long)((uintptr_t)&enter));
+}
+
+/****************************************************************************
+ * Name: ioring_peek_cqe
+ *
+ * Description:
+ *   Return the oldest unreaped completion, or NULL if there is none.  No
+ *   system call is made.
+ *
+ ****************************************************************************/
+
+FAR struct ioring_cqe *ioring_peek_cqe(FAR struct ioring *ring)
+{
+  FAR struct ioring_rings *rings = ring->rings;
+  uint32_t head = rings->cq_head;
+
+  if (head == rings->cq_tail)
+    {
+      return NULL;
+    }
+
+  /* The entry must not be read before the tail that publishes it */
+
+  SP_DMB();
+  return &rings->cqes[head & rings->cq_mask];
+}
+
+/****************************************************************************
+ * Name: ioring_wait_cqe
+ *
+ * Description:
+ *   Return the oldest unreaped completion, submitting any pending entries
+ *   and waiting if there is none.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -1 (ERROR) on failure with errno set.  EAGAIN
+ *   means that nothing was in flight to wait for.
+ *
+ ****************************************************************************/
+
+int ioring_wait_cqe(FAR struct ioring *ring, FAR struct ioring_cqe **cqep)
+{
+  FAR struct ioring_cqe *cqe;
+  int ret;
+
+  while ((cqe = ioring_peek_cqe(ring)) == NULL)
+    {
+      ret = ioring_submit(ring, 1);
+      if (ret < 0)
+        {
+          return ERROR;
+        }
+
+      cqe = ioring_peek_cqe(ring);
+      if (cqe == NULL && ret == 0)
+        {
+          set_errno(EAGAIN);
+          return ERROR;
+        }
+    }
+
+  *cqep = cqe;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ioring_cqe_seen
+ *
+ * Description:
+ *   Release the completion returned by ioring_peek_cqe() or
+ *   ioring_wait_cqe() back to the kernel.
+ *
+ ****************************************************************************/
+
+void ioring_cqe_seen(FAR struct ioring *ring)
+{
+  /* The entry must be consumed before it is handed back */
+
+  SP_DMB();
+  ring->rings->cq_head++;
+}
+
+#endif /* CONFIG_FS_AIO_RING */
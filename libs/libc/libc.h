@@ -44,6 +44,7 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <limits.h>
 #include <semaphore.h>
@@ -71,6 +72,7 @@
 #ifdef CONFIG_STDIO_DISABLE_BUFFERING
 #  define lib_sem_initialize(s)
 #  define lib_take_semaphore(s)
+#  define lib_trytake_semaphore(s) (0)
 #  define lib_give_semaphore(s)
 #endif
 
@@ -163,10 +165,13 @@ int lib_mode2oflags(FAR const char *mode);
 /* Defined in lib_libfwrite.c */
 
 ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream);
+ssize_t lib_fwrite_unlocked(FAR const void *ptr, size_t count,
+                            FAR FILE *stream);
 
 /* Defined in lib_libfread.c */
 
 ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream);
+ssize_t lib_fread_unlocked(FAR void *ptr, size_t count, FAR FILE *stream);
 
 /* Defined in lib_libfgets.c */
 
@@ -190,6 +195,7 @@ int lib_wrflush(FAR FILE *stream);
 #ifndef CONFIG_STDIO_DISABLE_BUFFERING
 void lib_sem_initialize(FAR struct file_struct *stream);
 void lib_take_semaphore(FAR struct file_struct *stream);
+int lib_trytake_semaphore(FAR struct file_struct *stream);
 void lib_give_semaphore(FAR struct file_struct *stream);
 #endif
 
@@ -209,10 +215,14 @@ bool lib_isbasedigit(int ch, int base, int *value);
 
 int lib_checkbase(int base, const char **pptr);
 
+/* Defined in lib_libstrtod.c */
+
+uint64_t lib_strtobits(FAR const char *str, FAR char **endptr,
+                       int mant_bits, int exp_bits);
+
 /* Defined in lib_expi.c */
 
 #ifdef CONFIG_LIBM
-float  lib_expif(size_t n);
 double lib_expi(size_t n);
 #endif
 
@@ -32,15 +32,56 @@
 #include <nuttx/config.h>
 #include <nuttx/compiler.h>
 
+#include <stdint.h>
 #include <math.h>
 
+#include "lib_math.h"
+
+#ifdef CONFIG_HAVE_DOUBLE
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
-#ifdef CONFIG_HAVE_DOUBLE
+/****************************************************************************
+ * Name: cos
+ *
+ * Description:
+ *   As sin(), with the quadrant advanced by one.  Maximum error is
+ *   about 0.78 ULP.
+ *
+ ****************************************************************************/
+
 double cos(double x)
 {
-  return sin(x + M_PI_2);
+  uint32_t hx = (lib_asuint64(x) >> 32) & 0x7fffffff;
+  double y[2];
+
+  /* |x| < pi/4 */
+
+  if (hx < 0x3fe921fb)
+    {
+      return hx < 0x3e46a09e ? 1.0 : __cos(x, 0.0);
+    }
+  else if (hx >= 0x7ff00000)
+    {
+      return x - x;
+    }
+
+  switch (lib_rempio2(x, y) & 3)
+    {
+      case 0:
+        return __cos(y[0], y[1]);
+
+      case 1:
+        return -__sin(y[0], y[1], 1);
+
+      case 2:
+        return -__cos(y[0], y[1]);
+
+      default:
+        return __sin(y[0], y[1], 1);
+    }
 }
+
 #endif
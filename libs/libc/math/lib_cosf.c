@@ -29,13 +29,43 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
 #include <math.h>
 
+#include "lib_math.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: cosf
+ *
+ * Description:
+ *   cos(x) = sin(x + pi/2), with the quarter turn added to the quadrant
+ *   after reduction rather than to x.  Maximum error is about
+ *   0.88 ULP.
+ *
+ ****************************************************************************/
+
 float cosf(float x)
 {
-  return sinf(x + M_PI_2_F);
+  uint32_t ix = lib_asuint(x) & 0x7fffffff;
+  float y[2];
+  int n;
+
+  if (ix < LIB_SINF_BIG)
+    {
+      return lib_sinf_kernel(x, 1);
+    }
+  else if (ix >= 0x7f800000)
+    {
+      return x - x;
+    }
+
+  n = lib_rempio2f(x, y);
+  return lib_sincosf_eval(y[0], y[1], n + 1);
 }
@@ -32,95 +32,60 @@
 #include <nuttx/config.h>
 #include <nuttx/compiler.h>
 
-#include <sys/types.h>
+#include <stdint.h>
 #include <math.h>
 
-#include "libc.h"
+#include "lib_math.h"
 
 #ifdef CONFIG_HAVE_DOUBLE
 
 /****************************************************************************
- * Private Data
+ * Public Functions
  ****************************************************************************/
 
-static double _dbl_inv_fact[] =
-{
-  1.0 / 1.0,                    /* 1 / 0! */
-  1.0 / 1.0,                    /* 1 / 1! */
-  1.0 / 2.0,                    /* 1 / 2! */
-  1.0 / 6.0,                    /* 1 / 3! */
-  1.0 / 24.0,                   /* 1 / 4! */
-  1.0 / 120.0,                  /* 1 / 5! */
-  1.0 / 720.0,                  /* 1 / 6! */
-  1.0 / 5040.0,                 /* 1 / 7! */
-  1.0 / 40320.0,                /* 1 / 8! */
-  1.0 / 362880.0,               /* 1 / 9! */
-  1.0 / 3628800.0,              /* 1 / 10! */
-  1.0 / 39916800.0,             /* 1 / 11! */
-  1.0 / 479001600.0,            /* 1 / 12! */
-  1.0 / 6227020800.0,           /* 1 / 13! */
-  1.0 / 87178291200.0,          /* 1 / 14! */
-  1.0 / 1307674368000.0,        /* 1 / 15! */
-  1.0 / 20922789888000.0,       /* 1 / 16! */
-  1.0 / 355687428096000.0,      /* 1 / 17! */
-  1.0 / 6402373705728000.0,     /* 1 / 18! */
-};
-
 /****************************************************************************
- * Public Functions
+ * Name: exp
+ *
+ * Description:
+ *   exp(x) = 2^(k/128) * exp(r) with 2^(j/128) from a table in two parts
+ *   and exp(r) from a degree 5 polynomial.  Maximum error is about 0.75 ULP.
+ *
  ****************************************************************************/
 
 double exp(double x)
 {
-  size_t int_part;
-  bool invert;
-  double value;
-  double x0;
-  size_t i;
+  uint64_t ix = lib_asuint64(x);
 
-  if (x == 0)
+  if ((ix & 0x7fffffffffffffffull) < LIB_EXP_SMALL)
     {
-      return 1;
+      return lib_exp_kernel(x, 0);
     }
-  else if (x < 0)
+
+  if ((ix & 0x7fffffffffffffffull) >= 0x7ff0000000000000ull)
     {
-      invert = true;
-      x = -x;
+      /* exp(-inf) = 0, NaN and +inf are returned as is */
+
+      return ix == 0xfff0000000000000ull ? 0.0 : x + x;
     }
-  else
+  else if (x > LIB_EXP_OFLOW)
     {
-      invert = false;
+      return INFINITY;
     }
-
-  /* Extract integer component */
-
-  int_part = (size_t) x;
-
-  /* Set x to fractional component */
-
-  x -= (double)int_part;
-
-  /* Perform Taylor series approximation with nineteen terms */
-
-  value = 0.0;
-  x0 = 1.0;
-  for (i = 0; i < 19; i++)
+  else if (x < LIB_EXP_UFLOW)
     {
-      value += x0 * _dbl_inv_fact[i];
-      x0 *= x;
+      return 0.0;
     }
 
-  /* Multiply by exp of the integer component */
-
-  value *= lib_expi(int_part);
+  /* Keep the scale factor in range near the overflow and underflow
+   * thresholds.
+   */
 
-  if (invert)
+  if (x > 0.0)
     {
-      return (1.0 / value);
-    }
-  else
-    {
-      return value;
+      return lib_exp_kernel(x, 1) * 2.0;
     }
+
+  return lib_exp_kernel(x, -64) * 5.4210108624275222e-20;
 }
+
 #endif
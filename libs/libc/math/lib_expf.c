@@ -29,84 +29,59 @@
  * Included Files
  ****************************************************************************/
 
-#include <sys/types.h>
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
 #include <math.h>
 
-#include "libc.h"
+#include "lib_math.h"
 
 /****************************************************************************
- * Private Data
+ * Public Functions
  ****************************************************************************/
 
-static float _flt_inv_fact[] =
-{
-  1.0 / 1.0,                    /* 1/0! */
-  1.0 / 1.0,                    /* 1/1! */
-  1.0 / 2.0,                    /* 1/2! */
-  1.0 / 6.0,                    /* 1/3! */
-  1.0 / 24.0,                   /* 1/4! */
-  1.0 / 120.0,                  /* 1/5! */
-  1.0 / 720.0,                  /* 1/6! */
-  1.0 / 5040.0,                 /* 1/7! */
-  1.0 / 40320.0,                /* 1/8! */
-  1.0 / 362880.0,               /* 1/9! */
-  1.0 / 3628800.0,              /* 1/10! */
-};
-
 /****************************************************************************
- * Public Functions
+ * Name: expf
+ *
+ * Description:
+ *   exp(x) = 2^(k/32) * exp(r) with 2^(j/32) from a table and exp(r) from
+ *   a degree 4 polynomial.  Maximum error is about 1.02 ULP.
+ *
  ****************************************************************************/
 
 float expf(float x)
 {
-  size_t int_part;
-  bool invert;
-  float value;
-  float x0;
-  size_t i;
+  uint32_t ix = lib_asuint(x);
 
-  if (x == 0)
+  if ((ix & 0x7fffffff) < LIB_EXPF_SMALL)
     {
-      return 1;
+      return lib_expf_kernel(x, 0);
     }
-  else if (x < 0)
+
+  if ((ix & 0x7fffffff) >= 0x7f800000)
     {
-      invert = true;
-      x = -x;
+      /* exp(-inf) = 0, NaN and +inf are returned as is */
+
+      return ix == 0xff800000 ? 0.0f : x + x;
     }
-  else
+  else if (x > LIB_EXPF_OFLOW)
     {
-      invert = false;
+      return INFINITY_F;
     }
-
-  /* Extract integer component */
-
-  int_part = (size_t) x;
-
-  /* set x to fractional component */
-
-  x -= (float)int_part;
-
-  /* Perform Taylor series approximation with eleven terms */
-
-  value = 0.0F;
-  x0 = 1.0F;
-  for (i = 0; i < 10; i++)
+  else if (x < LIB_EXPF_UFLOW)
     {
-      value += x0 * _flt_inv_fact[i];
-      x0 *= x;
+      return 0.0f;
     }
 
-  /* Multiply by exp of the integer component */
+  /* Keep the scale factor in range near the overflow and underflow
+   * thresholds.
+   */
 
-  value *= lib_expif(int_part);
-
-  if (invert)
-    {
-      return (1.0F / value);
-    }
-  else
+  if (x > 0.0f)
     {
-      return value;
+      return lib_expf_kernel(x, 1) * 2.0f;
     }
+
+  return lib_expf_kernel(x, -64) * 5.42101086e-20f;
 }
@@ -0,0 +1,743 @@
+/****************************************************************************
+ * libs/libc/math/lib_libmdata.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include "lib_math.h"
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* 2^(j/32), j = 0..31 */
+
+const float g_lib_exp2f_tab[LIB_EXPF_N] =
+{
+  1.0f, 1.0218972f, 1.0442737f, 1.0671405f,
+  1.0905077f, 1.1143868f, 1.1387886f, 1.1637249f,
+  1.1892071f, 1.2152474f, 1.2418578f, 1.269051f,
+  1.2968396f, 1.3252367f, 1.3542556f, 1.38391f,
+  1.4142135f, 1.4451808f, 1.4768262f, 1.5091645f,
+  1.5422108f, 1.5759809f, 1.6104903f, 1.6457555f,
+  1.6817929f, 1.7186193f, 1.7562522f, 1.7947091f,
+  1.8340081f, 1.8741677f, 1.9152066f, 1.9571441f,
+};
+
+/* {1/c, c, log(c) high, log(c) low} for the 32 sub-intervals of
+ * [0x3f320000, 0x3fb20000).  c is picked close to the middle of each
+ * interval such that c * (1/c) is 1 to within a few units of 2^-35, and is
+ * exactly 1 for the interval that contains 1.
+ */
+
+const struct lib_logf_entry_s g_lib_logf_tab[LIB_LOGF_N] =
+{
+  { 1.4220537f, 7.032083e-01f, -3.5209656e-01f, -5.5330656e-06f },
+  { 1.3910075f, 7.1890336e-01f, -3.3003235e-01f, 4.0132636e-06f },
+  { 1.3620863f, 7.341679e-01f, -3.09021e-01f, 3.4305558e-06f },
+  { 1.333333f, 7.500002e-01f, -2.876892e-01f, 7.374951e-06f },
+  { 1.3062022f, 7.6557827e-01f, -2.6712036e-01f, -3.46094e-06f },
+  { 1.2801466f, 7.8116053e-01f, -2.4697876e-01f, 4.1580647e-06f },
+  { 1.2552307f, 7.966663e-01f, -2.2732544e-01f, 6.086777e-06f },
+  { 1.2309955f, 8.1235063e-01f, -2.078247e-01f, 1.4862882e-06f },
+  { 1.2078252f, 8.279344e-01f, -1.8882751e-01f, 6.1409523e-06f },
+  { 1.1852721f, 8.4368813e-01f, -1.6996765e-01f, -4.715075e-06f },
+  { 1.1634926f, 8.594812e-01f, -1.5142822e-01f, 1.913083e-06f },
+  { 1.1428566f, 8.750004e-01f, -1.3352966e-01f, -1.2527015e-06f },
+  { 1.1228552f, 8.905868e-01f, -1.15875244e-01f, 5.2908223e-07f },
+  { 1.1034199f, 9.062733e-01f, -9.841919e-02f, 4.8326306e-06f },
+  { 1.0849056f, 9.2173916e-01f, -8.149719e-02f, 4.1913077e-06f },
+  { 1.0666656f, 9.375009e-01f, -6.454468e-02f, 7.110271e-06f },
+  { 1.0490062f, 9.532832e-01f, -4.7836304e-02f, -6.958648e-06f },
+  { 1.0322421f, 9.68765e-01f, -3.173828e-02f, 5.087714e-06f },
+  { 1.0157475f, 9.844966e-01f, -1.5625e-02f, 1.5893396e-07f },
+  { 1.0f, 1.0f, 0.0f, 0.0f },
+  { 9.6971154e-01f, 1.0312345f, 3.0761719e-02f, -5.0877916e-06f },
+  { 9.41423e-01f, 1.0622218f, 6.036377e-02f, -1.0497557e-06f },
+  { 9.141737e-01f, 1.093884f, 8.973694e-02f, -2.2810123e-06f },
+  { 8.8853365e-01f, 1.1254498f, 1.1817932e-01f, 3.435934e-06f },
+  { 8.645722e-01f, 1.1566414f, 1.4552307e-01f, -2.6416576e-06f },
+  { 8.4226346e-01f, 1.187277f, 1.7166138e-01f, 1.0386855e-06f },
+  { 8.20413e-01f, 1.2188983f, 1.9795227e-01f, -4.855519e-06f },
+  { 7.9999924e-01f, 1.2500012f, 2.2314453e-01f, -2.6261928e-08f },
+  { 7.807739e-01f, 1.2807806f, 2.4746704e-01f, 2.6587288e-06f },
+  { 7.6195127e-01f, 1.3124199f, 2.7186584e-01f, 6.833738e-06f },
+  { 7.4400157e-01f, 1.3440832f, 2.9571533e-01f, -3.194551e-06f },
+  { 7.2729164e-01f, 1.3749642f, 3.184204e-01f, 7.3113247e-06f },
+};
+
+#ifdef CONFIG_HAVE_DOUBLE
+
+/* 2^(j/128) as a high and low part, j = 0..127 */
+
+const struct lib_exp_entry_s g_lib_exp2_tab[LIB_EXP_N] =
+{
+  { 1.0, 0.0 },
+  { 1.0054299011128027, 9.499186535455032e-17 },
+  { 1.0108892860517005, -1.5234778603368577e-17 },
+  { 1.016378314910953, -5.77217007319966e-17 },
+  { 1.0218971486541166, 5.109225028973444e-17 },
+  { 1.0274459491187637, -4.9560741746453704e-17 },
+  { 1.0330248790212284, 7.600838874027088e-18 },
+  { 1.0386341019613787, 5.996273788852511e-17 },
+  { 1.0442737824274138, 8.551889705537965e-17 },
+  { 1.0499440858006872, 5.592937848127003e-17 },
+  { 1.0556451783605572, 1.759325738772092e-18 },
+  { 1.061377227289262, -1.1973537085365658e-17 },
+  { 1.0671404006768237, -7.899853966841582e-17 },
+  { 1.0729348675259756, -3.839668843358824e-18 },
+  { 1.0787607977571199, -6.656660436056593e-17 },
+  { 1.0846183622133092, 3.166152845816346e-17 },
+  { 1.0905077326652577, -3.046782079812471e-17 },
+  { 1.0964290818163769, -5.919933484449316e-17 },
+  { 1.102382583307841, 5.2660368715706944e-17 },
+  { 1.1083684117236787, -8.786813845180527e-17 },
+  { 1.1143867425958924, 1.0410278456845571e-16 },
+  { 1.1204377524096067, -6.201085906554179e-17 },
+  { 1.1265216186082418, 5.165856758795457e-17 },
+  { 1.1326385195987192, 3.237356166738e-17 },
+  { 1.1387886347566916, 8.912812676025408e-17 },
+  { 1.1449721444318042, 4.6412898921700107e-17 },
+  { 1.1511892299529827, 3.250710218863827e-17 },
+  { 1.1574400736337511, -9.1238712311344e-17 },
+  { 1.1637248587775775, 3.8292048369240935e-17 },
+  { 1.1700437696832502, -1.8477442017900047e-18 },
+  { 1.1763969916502812, 5.554203254218079e-17 },
+  { 1.182784710984341, 1.542975430079076e-17 },
+  { 1.189207115002721, 3.982015231465646e-17 },
+  { 1.1956643920398273, 4.6166036704814814e-17 },
+  { 1.202156731452703, 6.644981499252301e-17 },
+  { 1.2086843236265816, -4.746725945228984e-17 },
+  { 1.215247359980469, -7.712630692681488e-17 },
+  { 1.2218460329727576, -1.0611021211402691e-16 },
+  { 1.22848053610687, -1.89878163130253e-17 },
+  { 1.2351510639369334, -1.0755244344307841e-16 },
+  { 1.241857812073484, 4.658027591836937e-17 },
+  { 1.2486009771892048, -8.261810999021964e-17 },
+  { 1.255380757024691, -6.7113898212968784e-18 },
+  { 1.2621973503942507, -3.0844648874738465e-17 },
+  { 1.2690509571917332, 2.667932131342186e-18 },
+  { 1.275941778396392, 9.91543024421429e-17 },
+  { 1.2828700160787783, 1.713594918243561e-17 },
+  { 1.2898358734066657, 8.949257530897592e-17 },
+  { 1.2968395546510096, 2.5382502794888315e-17 },
+  { 1.3038812651919358, 8.647675598267871e-17 },
+  { 1.3109612115247644, -7.181536135519454e-17 },
+  { 1.318079601266064, -5.4579558271491535e-17 },
+  { 1.3252366431597413, -2.8587312100388614e-17 },
+  { 1.3324325470831615, -5.101586630916744e-17 },
+  { 1.339667524053303, 8.927282594831732e-17 },
+  { 1.3469417862329458, 3.224065101254679e-17 },
+  { 1.3542555469368927, 7.70094837980299e-17 },
+  { 1.3616090206382248, 1.533787661270668e-18 },
+  { 1.3690024229745905, 9.593797919118849e-17 },
+  { 1.3764359707545302, -6.898588935871801e-17 },
+  { 1.383909881963832, -6.770511658794786e-17 },
+  { 1.3914243757719262, -4.9061748652889893e-17 },
+  { 1.3989796725383112, -9.614213209051323e-17 },
+  { 1.4065759938190154, 7.034914812136422e-18 },
+  { 1.4142135623730951, -9.667293313452913e-17 },
+  { 1.4218926021691656, -1.6077828915890244e-17 },
+  { 1.42961333839197, -1.2031642489053655e-17 },
+  { 1.4373759974489824, -4.2040340164675566e-17 },
+  { 1.4451808069770467, -3.0237581349939873e-17 },
+  { 1.4530279958490526, -5.779948609396106e-17 },
+  { 1.460917794180647, -5.600377186075216e-17 },
+  { 1.4688504333369818, 8.465882756533628e-17 },
+  { 1.4768261459394993, -3.483994556892796e-17 },
+  { 1.4848451658727524, 1.0780086764407481e-16 },
+  { 1.4929077282912648, 1.4192920154284036e-17 },
+  { 1.5010140696264256, -6.413767275790235e-17 },
+  { 1.5091644275934228, -1.016455327754295e-16 },
+  { 1.5173590411982147, -4.308699472043341e-17 },
+  { 1.5255981507445384, -1.1024941712342561e-16 },
+  { 1.533881997840956, 8.875226844438446e-17 },
+  { 1.5422108254079407, 7.949834809697621e-17 },
+  { 1.550584877685, -1.4600706590689385e-17 },
+  { 1.559004400237837, 3.7812070533575275e-17 },
+  { 1.567469639965553, -1.0352061768849722e-16 },
+  { 1.5759808451078865, -1.0136916471278304e-17 },
+  { 1.5845382652524937, -1.9337717034585703e-17 },
+  { 1.593142151342267, -1.0094406542311964e-16 },
+  { 1.6017927556826934, -6.054917453527784e-17 },
+  { 1.6104903319492543, 2.4707192569797888e-17 },
+  { 1.6192351351948637, 2.0941334154229092e-17 },
+  { 1.6280274218573478, -6.712955084707084e-17 },
+  { 1.6368674497669644, 7.698325071319876e-17 },
+  { 1.645755478153965, -1.0125679913674773e-16 },
+  { 1.6546917676561943, 9.643294303196029e-17 },
+  { 1.6636765803267364, 5.8909926967131e-17 },
+  { 1.6727101796415966, -5.476715964599563e-17 },
+  { 1.681792830507429, 8.199010020581497e-17 },
+  { 1.6909247992693053, -9.66967147439488e-17 },
+  { 1.7001063537185235, -8.0237193703977e-18 },
+  { 1.709337763100463, -9.868779456632931e-17 },
+  { 1.718619298122478, -1.851380418263111e-17 },
+  { 1.7279512309618377, -1.0750981861204642e-16 },
+  { 1.7373338352737062, 3.164389299292957e-17 },
+  { 1.746767386199169, -1.0752290483507515e-16 },
+  { 1.7562521603732995, 2.960140695448873e-17 },
+  { 1.7657884359332727, 9.461315018083268e-17 },
+  { 1.7753764925265212, 6.429731796556572e-17 },
+  { 1.785016611318935, 1.5330400121031314e-17 },
+  { 1.7947090750031072, 1.8227458427912087e-17 },
+  { 1.804454167806624, -5.177222408793318e-17 },
+  { 1.8142521755003989, -9.969531538920349e-17 },
+  { 1.8241033854070534, -1.0159627862277083e-16 },
+  { 1.8340080864093424, 3.283107224245627e-17 },
+  { 1.843966568958626, -5.939742026949965e-17 },
+  { 1.8539791250833855, 9.761887490727594e-17 },
+  { 1.864046048397789, 6.540912680620572e-17 },
+  { 1.8741676341103, -6.122763413004143e-17 },
+  { 1.8843441790323345, -8.226593125533711e-17 },
+  { 1.8945759815869656, 3.4034035352165297e-17 },
+  { 1.9048633418176741, 6.533857514718279e-17 },
+  { 1.9152065613971474, -1.0619946056195963e-16 },
+  { 1.925605943636125, -9.914963769693741e-17 },
+  { 1.9360617934922943, 1.0332385960676326e-16 },
+  { 1.9465744175792332, 6.811022349533877e-17 },
+  { 1.9571441241754002, 8.960767791036668e-17 },
+  { 1.9677712232331759, -1.0314928011531132e-16 },
+  { 1.978456026387951, 4.0388753109278167e-17 },
+  { 1.9891988469672663, 8.2051326383692e-18 },
+};
+
+/* As g_lib_logf_tab, for the 128 sub-intervals of
+ * [0x3fe5f00000000000, 0x3ff5f00000000000)
+ */
+
+const struct lib_log_entry_s g_lib_log_tab[LIB_LOG_N] =
+{
+  {
+    1.4545454545454675, 6.874999999999939e-01,
+    -3.746934494413381e-01, -8.148644569625766e-14
+  },
+  {
+    1.4463276836153438, 6.914062500002273e-01,
+    -3.690277119053462e-01, -5.841413952866061e-14
+  },
+  {
+    1.4382022471909295, 6.953125000000395e-01,
+    -3.6339389418731116e-01, -1.0932252522187054e-13
+  },
+  {
+    1.430167597765075, 6.992187500001409e-01,
+    -3.5779163863867325e-01, 6.726164550563758e-14
+  },
+  {
+    1.4222222222224445, 7.031249999998901e-01,
+    -3.5222059358943625e-01, -7.217021993234231e-14
+  },
+  {
+    1.4143646408837023, 7.070312500001378e-01,
+    -3.4668041321356213e-01, 2.0273814265454484e-14
+  },
+  {
+    1.4065934065929468, 7.109375000002324e-01,
+    -3.411707574025513e-01, 1.1104166925252485e-13
+  },
+  {
+    1.3989071038256715, 7.148437499997267e-01,
+    -3.3569129163856815e-01, 4.4237437719291183e-14
+  },
+  {
+    1.3913043478261216, 7.187499999999821e-01,
+    -3.3024168687052224e-01, -7.948114024152403e-14
+  },
+  {
+    1.3837837837834674, 7.226562500001652e-01,
+    -3.248216194010638e-01, 5.474551293685702e-14
+  },
+  {
+    1.3763440860220726, 7.265624999997006e-01,
+    -3.1943077076675763e-01, -1.571101005538815e-14
+  },
+  {
+    1.3689839572193319, 7.30468749999957e-01,
+    -3.140688276250785e-01, 4.3813547929259444e-14
+  },
+  {
+    1.3617021276595551, 7.343750000000104e-01,
+    -3.0873548164959175e-01, -7.311272776440987e-15
+  },
+  {
+    1.3544973544973529, 7.382812500000009e-01,
+    -3.034304294199046e-01, -1.428042461517537e-14
+  },
+  {
+    1.3473684210530337, 7.421874999997785e-01,
+    -2.981533723193479e-01, -2.685019023729886e-14
+  },
+  {
+    1.3403141361251873, 7.4609375000026e-01,
+    -2.9290401643265795e-01, 7.385254638719762e-14
+  },
+  {
+    1.333333333333334, 7.499999999999997e-01,
+    -2.8768207245184385e-01, 6.247948468023189e-14
+  },
+  {
+    1.3264248704660708, 7.539062500001423e-01,
+    -2.8248725557455145e-01, 6.332198262640171e-14
+  },
+  {
+    1.3195876288664294, 7.578124999997415e-01,
+    -2.773192854165245e-01, -5.0896280395065754e-14
+  },
+  {
+    1.312820512820928, 7.617187499997591e-01,
+    -2.721778859161077e-01, -2.4257906552543327e-14
+  },
+  {
+    1.3061224489797496, 7.656249999999075e-01,
+    -2.670627852492089e-01, 4.2861937665851065e-14
+  },
+  {
+    1.2994923857870242, 7.695312499998684e-01,
+    -2.619737157417603e-01, 1.5384090233701266e-14
+  },
+  {
+    1.2929292929293297, 7.73437499999978e-01,
+    -2.5691041378513546e-01, 7.980000703758683e-14
+  },
+  {
+    1.2864321608037101, 7.773437500001873e-01,
+    -2.518726197547494e-01, -7.97441940363305e-14
+  },
+  {
+    1.2799999999999727, 7.812500000000167e-01,
+    -2.468600779316148e-01, 1.1031479563840722e-13
+  },
+  {
+    1.2736318407956797, 7.851562500002097e-01,
+    -2.4187253642026008e-01, 4.045906448207207e-14
+  },
+  {
+    1.2673267326736095, 7.89062499999787e-01,
+    -2.3690974707869827e-01, 7.055270497459441e-14
+  },
+  {
+    1.2610837438424645, 7.929687499999372e-01,
+    -2.3197146543793679e-01, 8.239793186979258e-14
+  },
+  {
+    1.2549019607845366, 7.968749999998584e-01,
+    -2.2705745063558425e-01, 6.052535900190814e-14
+  },
+  {
+    1.2487804878046407, 8.007812500001522e-01,
+    -2.221674653410446e-01, 8.037185376545856e-14
+  },
+  {
+    1.2427184466014296, 8.046875000003316e-01,
+    -2.173012756895787e-01, 9.407523288367906e-15
+  },
+  {
+    1.2367149758455949, 8.085937499998795e-01,
+    -2.1245865121431962e-01, -2.2759460880115336e-14
+  },
+  {
+    1.2307692307692264, 8.125000000000029e-01,
+    -2.0763936477828793e-01, 4.697813627404306e-14
+  },
+  {
+    1.2248803827751544, 8.164062499999768e-01,
+    -2.0284319251481975e-01, 3.9854908441450565e-14
+  },
+  {
+    1.2190476190480695, 8.203124999996969e-01,
+    -1.980699137625379e-01, 7.463099998687543e-14
+  },
+  {
+    1.213270142179681, 8.242187500002811e-01,
+    -1.9331931100305155e-01, -1.0336639403297534e-13
+  },
+  {
+    1.2075471698112779, 8.281250000000294e-01,
+    -1.8859116980752333e-01, 8.83370520998856e-15
+  },
+  {
+    1.2018779342720844, 8.320312500001495e-01,
+    -1.838852787700489e-01, 9.127355363358359e-14
+  },
+  {
+    1.1962616822431227, 8.359374999999077e-01,
+    -1.792014294578621e-01, 4.074559410507402e-14
+  },
+  {
+    1.1906976744184155, 8.398437500001334e-01,
+    -1.7453941635176307e-01, 2.2285824939314284e-14
+  },
+  {
+    1.1851851851852189, 8.43749999999976e-01,
+    -1.6989903679541385e-01, -1.2045433016306908e-14
+  },
+  {
+    1.179723502304114, 8.476562500000241e-01,
+    -1.6528009093917717e-01, 1.0266850043356614e-13
+  },
+  {
+    1.174311926605102, 8.515625000002919e-01,
+    -1.606823816900942e-01, -3.652090485851454e-14
+  },
+  {
+    1.1689497716897363, 8.554687499998254e-01,
+    -1.5610571466322654e-01, -3.926221969032221e-14
+  },
+  {
+    1.1636363636362148, 8.593750000001099e-01,
+    -1.5154989812708664e-01, 1.3595065092281526e-14
+  },
+  {
+    1.1583710407241152, 8.632812499999006e-01,
+    -1.4701474296202832e-01, 1.0356139870496909e-13
+  },
+  {
+    1.1531531531527435, 8.671875000003081e-01,
+    -1.425000626070414e-01, 1.1364125295855589e-13
+  },
+  {
+    1.1479820627804849, 8.710937499998362e-01,
+    -1.3800567301973388e-01, 1.0216874284035779e-13
+  },
+  {
+    1.142857142857146, 8.749999999999977e-01,
+    -1.3353139262449076e-01, -3.452427160817871e-14
+  },
+  {
+    1.1377777777773728, 8.789062500003129e-01,
+    -1.2907704227473005e-01, -5.633001401966973e-14
+  },
+  {
+    1.132743362832116, 8.828124999997993e-01,
+    -1.2464244520742795e-01, -7.601671269855451e-14
+  },
+  {
+    1.127753303965152, 8.8671874999969e-01,
+    -1.2022742699855371e-01, 4.433546126954958e-14
+  },
+  {
+    1.1228070175438916, 8.906249999999747e-01,
+    -1.1583181552509814e-01, -5.199053161244317e-14
+  },
+  {
+    1.117903930130658, 8.945312500002772e-01,
+    -1.1145544092505588e-01, 4.2963399391555093e-14
+  },
+  {
+    1.1130434782608063, 8.984375000000511e-01,
+    -1.0709813555627079e-01, -3.946669147438577e-14
+  },
+  {
+    1.1082251082253018, 9.023437499998423e-01,
+    -1.0275973395800975e-01, 6.609854318211835e-14
+  },
+  {
+    1.1034482758620925, 9.062499999999807e-01,
+    -9.844007281321865e-02, -5.518752310204465e-14
+  },
+  {
+    1.0987124463516091, 9.101562500002669e-01,
+    -9.413899091350686e-02, -6.18070890218421e-14
+  },
+  {
+    1.0940170940172729, 9.140624999998506e-01,
+    -8.98563291220853e-02, 6.076624118929821e-14
+  },
+  {
+    1.0893617021280386, 9.179687499996806e-01,
+    -8.559193033579504e-02, 4.3572968054712874e-14
+  },
+  {
+    1.0847457627119184, 9.218749999999541e-01,
+    -8.134563945395712e-02, -4.5024620724907265e-14
+  },
+  {
+    1.080168776371107, 9.257812500001723e-01,
+    -7.711730334426647e-02, 2.1305050339050613e-14
+  },
+  {
+    1.0756302521011951, 9.296874999996934e-01,
+    -7.290677080845853e-02, 4.0916276016655977e-14
+  },
+  {
+    1.0711297071133141, 9.335937499997007e-01,
+    -6.871389254843052e-02, 5.810708545082267e-14
+  },
+  {
+    1.0666666666666629, 9.375000000000033e-01,
+    -6.45385211375924e-02, 2.4778321723610492e-14
+  },
+  {
+    1.0622406639000792, 9.414062500002975e-01,
+    -6.038051098857977e-02, -1.1649080871608581e-14
+  },
+  {
+    1.057851239669617, 9.453124999998254e-01,
+    -5.623971832301322e-02, -4.759752866584009e-14
+  },
+  {
+    1.0534979423867301, 9.492187500000911e-01,
+    -5.211600113898385e-02, 6.585458981202487e-14
+  },
+  {
+    1.0491803278687257, 9.531250000001151e-01,
+    -4.800921918626955e-02, 2.973172128790045e-14
+  },
+  {
+    1.044897959183812, 9.570312499998732e-01,
+    -4.391923393495745e-02, -1.0523731139068096e-14
+  },
+  {
+    1.040650406504094, 9.609374999999732e-01,
+    -3.9845908547249564e-02, 2.2049744307312062e-14
+  },
+  {
+    1.0364372469633427, 9.648437500002048e-01,
+    -3.578910785131484e-02, -5.814083556347123e-14
+  },
+  {
+    1.0322580645160997, 9.687500000000275e-01,
+    -3.1748698314459034e-02, -9.284543866058758e-14
+  },
+  {
+    1.0281124497990077, 9.726562500001789e-01,
+    -2.7724548014703032e-02, 3.2056663558091214e-14
+  },
+  {
+    1.0239999999997105, 9.765625000002761e-01,
+    -2.371652661713597e-02, 1.0266603769071952e-13
+  },
+  {
+    1.0199203187249442, 9.804687500001494e-01,
+    -1.972450534753989e-02, -8.6287242899068e-14
+  },
+  {
+    1.0158730158732396, 9.843749999997832e-01,
+    -1.5748356968288135e-02, -7.130160646748604e-14
+  },
+  {
+    1.0118577075101787, 9.882812499997097e-01,
+    -1.178795575242475e-02, 8.874388512185188e-14
+  },
+  {
+    1.0078740157478023, 9.921875000002256e-01,
+    -7.843177460699735e-03, -9.878410481034054e-14
+  },
+  {
+    1.0039215686272214, 9.960937500002278e-01,
+    -3.913899320878045e-03, -2.95731061380916e-14
+  },
+  {
+    1.0, 1.0,
+    0.0, 0.0
+  },
+  {
+    9.922480620152783e-01, 1.0078125000002292,
+    7.782140442259333e-03, 2.2989410046177662e-14
+  },
+  {
+    9.846153846156085e-01, 1.015624999999769,
+    1.5504186535736153e-02, 1.7274567499447613e-15
+  },
+  {
+    9.770992366410162e-01, 1.023437500000215,
+    2.3167059281831826e-02, -8.743036616092638e-14
+  },
+  {
+    9.696969696969973e-01, 1.0312499999999707,
+    3.077165866670839e-02, 1.6876433147504877e-14
+  },
+  {
+    9.62406015038141e-01, 1.0390624999994094,
+    3.831886430157283e-02, -4.665294699744567e-15
+  },
+  {
+    9.552238805972593e-01, 1.0468749999997322,
+    4.580953603112903e-02, -9.062005142519465e-14
+  },
+  {
+    9.481481481480964e-01, 1.0546875000000575,
+    5.3244514518837605e-02, 2.9205886439006564e-14
+  },
+  {
+    9.41176470588232e-01, 1.0625000000000038,
+    6.062462181648698e-02, -4.8583492712564546e-14
+  },
+  {
+    9.343065693428798e-01, 1.070312500000213,
+    6.795066190875332e-02, -4.661676946059261e-14
+  },
+  {
+    9.275362318840052e-01, 1.0781250000000613,
+    7.522342123775161e-02, -1.0723959699518022e-13
+  },
+  {
+    9.208633093525914e-01, 1.0859374999999134,
+    8.244366921098845e-02, 6.400764771971637e-15
+  },
+  {
+    9.142857142858247e-01, 1.0937499999998679,
+    8.961215868953332e-02, 3.3023708169657446e-14
+  },
+  {
+    9.078014184400784e-01, 1.1015624999995606,
+    9.672962645822736e-02, -7.515744203351999e-14
+  },
+  {
+    9.014084507043663e-01, 1.1093749999998266,
+    1.0379679368156758e-01, -8.033303589529284e-14
+  },
+  {
+    8.951048951050853e-01, 1.1171874999997626,
+    1.1081436634003694e-01, 4.0706482243049433e-14
+  },
+  {
+    8.888888888888857e-01, 1.125000000000004,
+    1.1778303565643e-01, -4.299458379718395e-14
+  },
+  {
+    8.827586206898559e-01, 1.1328124999997424,
+    1.2470347850080543e-01, -7.556920687453922e-14
+  },
+  {
+    8.767123287670984e-01, 1.1406250000000324,
+    1.315763577888447e-01, -9.699461377574372e-14
+  },
+  {
+    8.707482993195299e-01, 1.1484375000002611,
+    1.3840232285929233e-01, 5.4183331378983145e-14
+  },
+  {
+    8.64864864864785e-01, 1.1562500000001068,
+    1.4518200984457508e-01, 1.5190542280527773e-14
+  },
+  {
+    8.590604026844763e-01, 1.1640625000001186,
+    1.5191604202595954e-01, -1.5705779841760434e-14
+  },
+  {
+    8.533333333334667e-01, 1.1718749999998168,
+    1.5860503017643168e-01, 5.0581915775535845e-14
+  },
+  {
+    8.476821192052739e-01, 1.1796875000000335,
+    1.6524957289539088e-01, -5.5299201561955523e-14
+  },
+  {
+    8.421052631579187e-01, 1.1874999999999662,
+    1.7185025692651834e-01, 1.1245956994070694e-13
+  },
+  {
+    8.366013071899943e-01, 1.1953124999993545,
+    1.7840765747223486e-01, 4.342504328452474e-14
+  },
+  {
+    8.311688311687249e-01, 1.2031250000001539,
+    1.8492233849406148e-01, 7.841252477555886e-14
+  },
+  {
+    8.258064516131987e-01, 1.2109374999995668,
+    1.9139485299933767e-01, -6.596457013836766e-14
+  },
+  {
+    8.205128205129313e-01, 1.2187499999998355,
+    1.9782574332975855e-01, 2.6325106877980078e-14
+  },
+  {
+    8.152866242037954e-01, 1.2265625000000395,
+    2.042155414287663e-01, -4.31858257653464e-14
+  },
+  {
+    8.101265822788264e-01, 1.2343749999994738,
+    2.1056476910689526e-01, 2.8056637541995224e-14
+  },
+  {
+    8.050314465412286e-01, 1.2421874999994629,
+    2.168739383000684e-01, 1.1355348368648089e-13
+  },
+  {
+    8.000000000000007e-01, 1.249999999999999,
+    2.2314355131425145e-01, -4.258614426497208e-14
+  },
+  {
+    7.950310559002319e-01, 1.2578125000006157,
+    2.2937410106533207e-01, 3.284223619950372e-15
+  },
+  {
+    7.901234567898427e-01, 1.2656250000004496,
+    2.3556607131308738e-01, 3.480309748478603e-14
+  },
+  {
+    7.852760736196408e-01, 1.2734374999999856,
+    2.417199368871934e-01, -5.956409993899776e-14
+  },
+  {
+    7.80487804878021e-01, 1.2812500000000455,
+    2.478361639045943e-01, 2.2497339614695716e-14
+  },
+  {
+    7.757575757572266e-01, 1.2890625000005802,
+    2.539152099814146e-01, -1.0506484469846146e-15
+  },
+  {
+    7.710843373497482e-01, 1.2968749999994102,
+    2.599575244364587e-01, 1.2621729398781918e-14
+  },
+  {
+    7.664670658679312e-01, 1.3046875000005655,
+    2.659635484976661e-01, -9.470964830236774e-14
+  },
+  {
+    7.619047619047592e-01, 1.3125000000000047,
+    2.719337154835557e-01, 8.959578140688783e-14
+  },
+  {
+    7.573964497037605e-01, 1.320312500000665,
+    2.778684510039966e-01, -3.66044435909524e-14
+  },
+  {
+    7.529411764708129e-01, 1.3281249999996037,
+    2.837681731302837e-01, 6.248522963054051e-14
+  },
+  {
+    7.485380116959277e-01, 1.335937499999962,
+    2.8963329258294834e-01, 6.591227246472249e-14
+  },
+  {
+    7.441860465116861e-01, 1.343749999999895,
+    2.9546421289364844e-01, 1.0927981066573955e-13
+  },
+  {
+    7.398843930635065e-01, 1.3515625000001412,
+    3.012613305781997e-01, 6.656358200562942e-14
+  },
+  {
+    7.356321839079101e-01, 1.3593750000002511,
+    3.070250352950552e-01, 4.139899890230117e-14
+  },
+  {
+    7.314285714286478e-01, 1.3671874999998572,
+    3.1275571000378477e-01, 7.688526467891358e-15
+  },
+};
+
+#endif /* CONFIG_HAVE_DOUBLE */
@@ -0,0 +1,391 @@
+/****************************************************************************
+ * libs/libc/math/lib_librempio2.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
+#include <math.h>
+
+#include "lib_math.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Words of 2/pi multiplied with the mantissa.  One word more than the
+ * precision requires, so that the window can start on a word boundary.
+ */
+
+#define INVPIO2F_WORDS    4
+#define INVPIO2_WORDS     7
+
+/* pi/2 split in 33 bit parts plus tails for the medium range reduction,
+ * so that n * PIO2_x is exact for n < 2^20.
+ */
+
+#define INVPIO2           6.366197723675814e-01
+#define PIO2_1            1.5707963267341256e+00
+#define PIO2_1T           6.077100506506192e-11
+#define PIO2_2            6.077100506303966e-11
+#define PIO2_2T           2.0222662487959506e-21
+#define PIO2_3            2.0222662487111665e-21
+#define PIO2_3T           8.47842766036890e-32
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The first 1280 bits of 2/pi, enough for any finite double */
+
+static const uint32_t g_invpio2[] =
+{
+  0xa2f9836e, 0x4e441529, 0xfc2757d1, 0xf534ddc0, 0xdb629599, 0x3c439041,
+  0xfe5163ab, 0xdebbc561, 0xb7246e3a, 0x424dd2e0, 0x06492eea, 0x09d1921c,
+  0xfe1deb1c, 0xb129a73e, 0xe88235f5, 0x2ebb4484, 0xe99c7026, 0xb45f7e41,
+  0x3991d639, 0x835339f4, 0x9c845f8b, 0xbdf9283b, 0x1ff897ff, 0xde05980f,
+  0xef2f118b, 0x5a0a6d1f, 0x6d367ecf, 0x27cb09b7, 0x4f463f66, 0x9e5fea2d,
+  0x7527bac7, 0xebe5f17b, 0x3d0739f7, 0x8a5292ea, 0x6bfb5fb1, 0x1f8d5d08,
+  0x56033046, 0xfc7b6bab, 0xf0cfbc20, 0x9af4361d
+};
+
+/* pi/2 * 2^126, least significant word first */
+
+static const uint32_t g_pio2[4] =
+{
+  0xc06e0e69, 0x62633145, 0x10b4611a, 0x6487ed51
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_mul_words
+ *
+ * Description:
+ *   p = a * b for numbers stored as little endian arrays of 32-bit words.
+ *   p must have room for na + nb words.
+ *
+ ****************************************************************************/
+
+static void lib_mul_words(FAR uint32_t *p, FAR const uint32_t *a, int na,
+                          FAR const uint32_t *b, int nb)
+{
+  uint64_t carry;
+  uint64_t t;
+  int i;
+  int j;
+
+  for (i = 0; i < na + nb; i++)
+    {
+      p[i] = 0;
+    }
+
+  for (i = 0; i < na; i++)
+    {
+      carry = 0;
+      for (j = 0; j < nb; j++)
+        {
+          t        = (uint64_t)a[i] * b[j] + p[i + j] + carry;
+          p[i + j] = (uint32_t)t;
+          carry    = t >> 32;
+        }
+
+      p[i + nb] = (uint32_t)carry;
+    }
+}
+
+/****************************************************************************
+ * Name: lib_get_bits
+ *
+ * Description:
+ *   Return bits [pos, pos + 64) of the np word number p.  Bits outside of
+ *   p read as zero.
+ *
+ ****************************************************************************/
+
+static uint64_t lib_get_bits(FAR const uint32_t *p, int np, int pos)
+{
+  uint64_t word[3];
+  int s = pos & 31;
+  int q = (pos - s) / 32;
+  int i;
+
+  for (i = 0; i < 3; i++)
+    {
+      word[i] = q + i >= 0 && q + i < np ? p[q + i] : 0;
+    }
+
+  word[0] |= word[1] << 32;
+  return s != 0 ? (word[0] >> s) | (word[2] << (64 - s)) : word[0];
+}
+
+/****************************************************************************
+ * Name: lib_mul_invpio2
+ *
+ * Description:
+ *   Multiply the mantissa m (nm words) of x = m * 2^e by nw words of 2/pi.
+ *   Leading bits of 2/pi that only contribute multiples of 4 to x * 2/pi
+ *   are skipped, so p holds x * 2/pi modulo 4 plus those multiples.
+ *
+ * Returned Value:
+ *   The bit position of the binary point in p.
+ *
+ ****************************************************************************/
+
+static int lib_mul_invpio2(FAR uint32_t *p, FAR const uint32_t *m, int nm,
+                           int e, int nw)
+{
+  uint32_t w[INVPIO2_WORDS];
+  int l = e >= 2 ? (e - 2) / 32 : 0;
+  int i;
+
+  for (i = 0; i < nw; i++)
+    {
+      w[i] = g_invpio2[l + nw - 1 - i];
+    }
+
+  lib_mul_words(p, m, nm, w, nw);
+  return 32 * (nw + l) - e;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_rempio2f
+ *
+ * Description:
+ *   Reduce a finite x with |x| >= 2^8 to y[0] + y[1] = x - n * pi/2,
+ *   |y[0]| <= pi/4.
+ *   x * 2/pi is computed exactly in 2.62 fixed point; a float input can
+ *   land at most 2^-29 from a multiple of pi/2, so the fraction keeps at
+ *   least 33 good bits.  It is multiplied by pi/2 in integer arithmetic as
+ *   well, leaving a single rounding to float.
+ *
+ * Returned Value:
+ *   n; only the two low bits are meaningful.
+ *
+ ****************************************************************************/
+
+int lib_rempio2f(float x, FAR float *y)
+{
+  uint32_t p[1 + INVPIO2F_WORDS];
+  uint32_t ix = lib_asuint(x);
+  uint32_t m = (ix & 0x7fffff) | 0x800000;
+  uint32_t a[2];
+  uint32_t q[4];
+  uint64_t f;
+  int point;
+  int neg;
+  int sh;
+  int n;
+
+  point = lib_mul_invpio2(p, &m, 1, (int)((ix >> 23) & 0xff) - 150,
+                          INVPIO2F_WORDS);
+
+  f   = lib_get_bits(p, 1 + INVPIO2F_WORDS, point - 62);
+  n   = (int)((f + (1ull << 61)) >> 62);
+  f  -= (uint64_t)n << 62;
+  neg = (int64_t)f < 0;
+  if (neg)
+    {
+      f = 0 - f;
+    }
+
+  /* Normalize the fraction and multiply by the top 64 bits of pi/2, which
+   * gives y * 2^(124 + sh) in q.  Split the top 64 bits of that into 24
+   * and 40.
+   */
+
+  for (sh = 0; (f >> 63) == 0 && sh < 64; sh++)
+    {
+      f <<= 1;
+    }
+
+  a[0] = (uint32_t)f;
+  a[1] = (uint32_t)(f >> 32);
+  lib_mul_words(q, a, 2, &g_pio2[2], 2);
+
+  f    = lib_get_bits(q, 4, 64);
+  y[0] = (float)(f & ~0xffffffffffull) *
+         lib_asfloat((uint32_t)(127 - 60 - sh) << 23);
+  y[1] = (float)(f & 0xffffffffffull) *
+         lib_asfloat((uint32_t)(127 - 60 - sh) << 23);
+
+  if (neg ^ (int)(ix >> 31))
+    {
+      y[0] = -y[0];
+      y[1] = -y[1];
+    }
+
+  return ix >> 31 ? -n : n;
+}
+
+#ifdef CONFIG_HAVE_DOUBLE
+
+/****************************************************************************
+ * Name: lib_rempio2
+ *
+ * Description:
+ *   Reduce a finite x with |x| > pi/4 to y[0] + y[1] = x - n * pi/2 for
+ *   the __sin() and __cos() kernels.  Up to 2^20 * pi/2 a three stage
+ *   Cody-Waite reduction is used, above that x * 2/pi is formed with
+ *   integer arithmetic from as many bits of 2/pi as the exponent needs.
+ *
+ * Returned Value:
+ *   n; only the two low bits are meaningful.
+ *
+ ****************************************************************************/
+
+int lib_rempio2(double x, FAR double *y)
+{
+  uint32_t p[2 + INVPIO2_WORDS];
+  uint32_t m[2];
+  uint32_t a[4];
+  uint32_t q[8];
+  uint64_t ix = lib_asuint64(x);
+  uint64_t hi;
+  uint64_t lo;
+  uint32_t hx = (ix >> 32) & 0x7fffffff;
+  double fn;
+  double r;
+  double w;
+  double t;
+  int point;
+  int lead;
+  int neg;
+  int top;
+  int e;
+  int i;
+  int n;
+
+  if (hx <= 0x413921fb)
+    {
+      fn = x * INVPIO2 + LIB_SHIFT;
+      n  = (int32_t)lib_asuint64(fn);
+      fn -= LIB_SHIFT;
+
+      /* The first stage is good to 85 bits, add more only if the result
+       * has cancelled that far.
+       */
+
+      r    = x - fn * PIO2_1;
+      w    = fn * PIO2_1T;
+      y[0] = r - w;
+      e    = hx >> 20;
+
+      if (e - (int)((lib_asuint64(y[0]) >> 52) & 0x7ff) > 16)
+        {
+          t    = r;
+          w    = fn * PIO2_2;
+          r    = t - w;
+          w    = fn * PIO2_2T - ((t - r) - w);
+          y[0] = r - w;
+
+          if (e - (int)((lib_asuint64(y[0]) >> 52) & 0x7ff) > 49)
+            {
+              t    = r;
+              w    = fn * PIO2_3;
+              r    = t - w;
+              w    = fn * PIO2_3T - ((t - r) - w);
+              y[0] = r - w;
+            }
+        }
+
+      y[1] = (r - y[0]) - w;
+      return n;
+    }
+
+  /* x = m * 2^e with a 53-bit integer m */
+
+  lo    = (ix & 0x000fffffffffffffull) | 0x0010000000000000ull;
+  m[0]  = (uint32_t)lo;
+  m[1]  = (uint32_t)(lo >> 32);
+  e     = (int)((ix >> 52) & 0x7ff) - 1075;
+  point = lib_mul_invpio2(p, m, 2, e, INVPIO2_WORDS);
+
+  /* Round to the nearest quadrant; the fraction becomes 1 - f when
+   * rounding up, which is what negating the whole product leaves below
+   * the binary point.
+   */
+
+  n   = (int)(lib_get_bits(p, 2 + INVPIO2_WORDS, point) & 3);
+  neg = (lib_get_bits(p, 2 + INVPIO2_WORDS, point - 1) & 1) != 0;
+  if (neg)
+    {
+      n++;
+      for (i = 0, hi = 1; i < 2 + INVPIO2_WORDS; i++)
+        {
+          hi   += (uint32_t)~p[i];
+          p[i]  = (uint32_t)hi;
+          hi  >>= 32;
+        }
+    }
+
+  for (lead = point - 1; lead > 0; lead--)
+    {
+      if ((p[lead / 32] >> (lead % 32)) & 1)
+        {
+          break;
+        }
+    }
+
+  /* Normalized 128-bit fraction times pi/2 */
+
+  hi   = lib_get_bits(p, 2 + INVPIO2_WORDS, lead - 63);
+  lo   = lib_get_bits(p, 2 + INVPIO2_WORDS, lead - 127);
+  a[0] = (uint32_t)lo;
+  a[1] = (uint32_t)(lo >> 32);
+  a[2] = (uint32_t)hi;
+  a[3] = (uint32_t)(hi >> 32);
+  lib_mul_words(q, a, 4, g_pio2, 4);
+
+  /* The product is q * 2^(lead - point - 253) with its top bit at 253 or
+   * 254.  Split it into 53 bits and the following 64.
+   */
+
+  top  = (q[7] >> 30) & 1 ? 254 : 253;
+  e    = top - 52 + lead - point - 253;
+  y[0] = (double)(lib_get_bits(q, 8, top - 63) >> 11) *
+         lib_asdouble((uint64_t)(1023 + e) << 52);
+  y[1] = (double)lib_get_bits(q, 8, top - 116) *
+         lib_asdouble((uint64_t)(1023 + e - 64) << 52);
+
+  t    = y[0] + y[1];
+  y[1] = y[1] - (t - y[0]);
+  y[0] = t;
+
+  if (neg ^ (int)(ix >> 63))
+    {
+      y[0] = -y[0];
+      y[1] = -y[1];
+    }
+
+  return ix >> 63 ? -n : n;
+}
+
+#endif /* CONFIG_HAVE_DOUBLE */
@@ -32,20 +32,12 @@
 #include <nuttx/config.h>
 #include <nuttx/compiler.h>
 
+#include <stdint.h>
 #include <math.h>
-#include <float.h>
 
-/****************************************************************************
- * Pre-processor Definitions
- ****************************************************************************/
-
-/* To avoid looping forever in particular corner cases, every LOGF_MAX_ITER
- * the error criteria is relaxed by a factor LOGF_RELAX_MULTIPLIER.
- * todo: might need to adjust the double floating point version too.
- */
+#include "lib_math.h"
 
-#define LOGF_MAX_ITER         10
-#define LOGF_RELAX_MULTIPLIER 2
+#ifdef CONFIG_HAVE_DOUBLE
 
 /****************************************************************************
  * Public Functions
@@ -53,66 +45,42 @@
 
 /****************************************************************************
  * Name: log
+ *
+ * Description:
+ *   log(x) = k * ln2 + log(c) + log1p(r) with c and log(c) from a 128 entry
+ *   table and log1p(r), |r| < 1/256, from a degree 7 polynomial.  Maximum
+ *   error is about 0.97 ULP.
+ *
  ****************************************************************************/
 
-#ifdef CONFIG_HAVE_DOUBLE
 double log(double x)
 {
-  double y;
-  double y_old;
-  double ney;
-  double epsilon;
-  int    relax_factor;
-  int    iter;
-
-  y = 0.0;
-  y_old = 1.0;
-  epsilon = DBL_EPSILON;
-
-  iter         = 0;
-  relax_factor = 1;
+  uint64_t ix = lib_asuint64(x);
 
+  /* Zero, subnormal, negative, infinite or NaN */
 
-  while (y > y_old + epsilon || y < y_old - epsilon)
+  if (ix - 0x0010000000000000ull >=
+      0x7ff0000000000000ull - 0x0010000000000000ull)
     {
-      y_old = y;
-      ney   = exp(-y);
-      y    -= 1.0 - x * ney;
-
-      if (y > 700.0)
+      if ((ix << 1) == 0)
         {
-          y = 700.0;
+          return -INFINITY;
         }
-
-      if (y < -700.0)
+      else if (ix == 0x7ff0000000000000ull)
         {
-          y = -700.0;
+          return x;
         }
-
-      epsilon = (fabs(y) > 1.0) ? fabs(y) * DBL_EPSILON : DBL_EPSILON;
-
-      if (++iter >= LOGF_MAX_ITER)
-        {
-          relax_factor *= LOGF_RELAX_MULTIPLIER;
-          iter = 0;
-        }
-
-      if (relax_factor > 1)
+      else if ((ix >> 63) != 0 || ix > 0x7ff0000000000000ull)
         {
-          epsilon *= relax_factor;
+          return NAN;
         }
-    }
 
-  if (y == 700.0)
-    {
-      return INFINITY;
-    }
+      /* Normalize subnormals */
 
-  if (y == -700.0)
-    {
-      return INFINITY;
+      return lib_log_kernel(lib_asuint64(x * 4503599627370496.0), -52);
     }
 
-  return y;
+  return lib_log_kernel(ix, 0);
 }
+
 #endif
@@ -29,22 +29,13 @@
  * Included Files
  ****************************************************************************/
 
-#include <math.h>
-#include <float.h>
-
-/****************************************************************************
- * Pre-processor Definitions
- ****************************************************************************/
-
-#define FLT_MAX_EXP_X   88.0F
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
 
-/* To avoid looping forever in particular corner cases, every LOGF_MAX_ITER
- * the error criteria is relaxed by a factor LOGF_RELAX_MULTIPLIER.
- * todo: might need to adjust the double floating point version too.
- */
+#include <stdint.h>
+#include <math.h>
 
-#define LOGF_MAX_ITER         10
-#define LOGF_RELAX_MULTIPLIER 2
+#include "lib_math.h"
 
 /****************************************************************************
  * Public Functions
@@ -52,63 +43,39 @@
 
 /****************************************************************************
  * Name: logf
+ *
+ * Description:
+ *   log(x) = k * ln2 + log(c) + log1p(r) with c and log(c) from a 32 entry
+ *   table and log1p(r), |r| < 1/64, from a degree 4 polynomial.  Maximum
+ *   error is about 0.85 ULP.
+ *
  ****************************************************************************/
 
 float logf(float x)
 {
-  float y;
-  float y_old;
-  float ney;
-  float epsilon;
-  int   relax_factor;
-  int   iter;
+  uint32_t ix = lib_asuint(x);
 
-  y       = 0.0F;
-  y_old   = 1.0F;
-  epsilon = FLT_EPSILON;
+  /* Zero, subnormal, negative, infinite or NaN */
 
-  iter         = 0;
-  relax_factor = 1;
-
-  while (y > y_old + epsilon || y < y_old - epsilon)
+  if (ix - 0x00800000 >= 0x7f800000 - 0x00800000)
     {
-      y_old = y;
-      ney   = expf(-y);
-      y    -= 1.0F - x * ney;
-
-      if (y > FLT_MAX_EXP_X)
+      if ((ix << 1) == 0)
         {
-          y = FLT_MAX_EXP_X;
+          return -INFINITY_F;
         }
-
-      if (y < -FLT_MAX_EXP_X)
-        {
-          y = -FLT_MAX_EXP_X;
-        }
-
-      epsilon = (fabsf(y) > 1.0F) ? fabsf(y) * FLT_EPSILON : FLT_EPSILON;
-
-      if (++iter >= LOGF_MAX_ITER)
+      else if (ix == 0x7f800000)
         {
-          relax_factor *= LOGF_RELAX_MULTIPLIER;
-          iter = 0;
+          return x;
         }
-
-      if (relax_factor > 1)
+      else if ((ix >> 31) != 0 || ix > 0x7f800000)
         {
-          epsilon *= relax_factor;
+          return NAN_F;
         }
-    }
 
-  if (y == FLT_MAX_EXP_X)
-    {
-      return INFINITY;
-    }
+      /* Normalize subnormals */
 
-  if (y == -FLT_MAX_EXP_X)
-    {
-      return INFINITY;
+      return lib_logf_kernel(lib_asuint(x * 8388608.0f), -23);
     }
 
-  return y;
+  return lib_logf_kernel(ix, 0);
 }
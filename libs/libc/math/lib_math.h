@@ -0,0 +1,463 @@
+/****************************************************************************
+ * libs/libc/math/lib_math.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBC_MATH_LIB_MATH_H
+#define __LIBS_LIBC_MATH_LIB_MATH_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
+#include <math.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Table sizes.  The exp tables hold 2^(j/N), the log tables hold 1/c and
+ * log(c) for N sub-intervals of [OFF, 2 * OFF).
+ */
+
+#define LIB_EXPF_TABLE_BITS   5
+#define LIB_EXPF_N            (1 << LIB_EXPF_TABLE_BITS)
+#define LIB_LOGF_TABLE_BITS   5
+#define LIB_LOGF_N            (1 << LIB_LOGF_TABLE_BITS)
+#define LIB_LOGF_OFF          0x3f320000
+
+#define LIB_EXP_TABLE_BITS    7
+#define LIB_EXP_N             (1 << LIB_EXP_TABLE_BITS)
+#define LIB_LOG_TABLE_BITS    7
+#define LIB_LOG_N             (1 << LIB_LOG_TABLE_BITS)
+#define LIB_LOG_OFF           0x3fe5f00000000000ull
+
+/* Adding these round a value to the nearest integer, which is then found
+ * in the low bits of the sum.
+ */
+
+#define LIB_SHIFT_F           12582912.0f          /* 0x1.8p23 */
+#define LIB_SHIFT_F_BITS      0x4b400000
+#define LIB_SHIFT             6755399441055744.0   /* 0x1.8p52 */
+#define LIB_SHIFT_BITS        0x4338000000000000ull
+
+/* sinf/cosf: arguments with |x| < 2^8 are reduced inline with a three part
+ * Cody-Waite split of pi/2 (the first two parts have 16 significant bits so
+ * n * part is exact), larger ones with lib_rempio2f().
+ */
+
+#define LIB_SINF_BIG          0x43800000
+
+/* sinf: below 2^-12 in magnitude, sin(x) rounds to x itself.  The reduction
+ * would turn x = -0 into +0, so these arguments are returned as they are.
+ */
+
+#define LIB_SINF_TINY         0x39800000
+#define LIB_INVPIO2_F         6.3661975e-01f
+#define LIB_PIO2_1_F          1.5708008e+00f
+#define LIB_PIO2_2_F          -4.4543995e-06f
+#define LIB_PIO2_3_F          -5.5644316e-11f
+
+/* Minimax coefficients for sin(r) and cos(r) on [-pi/4, pi/4] */
+
+#define LIB_SINF_S1           -1.6666664e-01f
+#define LIB_SINF_S2           8.332748e-03f
+#define LIB_SINF_S3           -1.958789e-04f
+#define LIB_COSF_C1           4.1666664e-02f
+#define LIB_COSF_C2           -1.3888302e-03f
+#define LIB_COSF_C3           2.4547942e-05f
+
+/* expf: x = k * ln2 / N + r, |r| <= ln2 / 2N.  The high part of ln2 / N
+ * has 11 significant bits so kd * LIB_LN2N_HI_F is exact.
+ */
+
+#define LIB_INVLN2N_F         4.616624e+01f
+#define LIB_LN2N_HI_F         2.166748e-02f
+#define LIB_LN2N_LO_F         -6.6310763e-06f
+#define LIB_EXPF_E1           1.6666715e-01f
+#define LIB_EXPF_E2           4.166675e-02f
+
+/* Inputs with |x| below this never overflow or underflow in the kernel */
+
+#define LIB_EXPF_SMALL        0x42ae0000           /* 87.0f */
+#define LIB_EXPF_OFLOW        8.8722839e+01f
+#define LIB_EXPF_UFLOW        -1.0397208e+02f
+
+/* logf: log(x) = k * ln2 + log(c) + log1p((z - c) / c).  The high parts of
+ * ln2 and of the log(c) table entries are multiples of 2^-16 so their sum
+ * is exact.
+ */
+
+#define LIB_LN2_HI_F          6.9314575e-01f
+#define LIB_LN2_LO_F          1.4286068e-06f
+#define LIB_LOGF_L1           -5.000000e-01f
+#define LIB_LOGF_L2           3.3336997e-01f
+#define LIB_LOGF_L3           -2.5003052e-01f
+
+/* Double precision counterparts */
+
+#define LIB_INVLN2N           1.846649652337873e+02
+#define LIB_LN2N_HI           5.4152123482253955e-03
+#define LIB_LN2N_LO           -1.0082281460997769e-13
+#define LIB_EXP_E1            1.6666666666666666e-01
+#define LIB_EXP_E2            4.166667430326241e-02
+#define LIB_EXP_E3            8.333334424275559e-03
+
+#define LIB_EXP_SMALL         0x4086200000000000ull  /* 708.0 */
+#define LIB_EXP_OFLOW         7.09782712893383973e+02
+#define LIB_EXP_UFLOW         -7.45133219101941108e+02
+
+#define LIB_LN2_HI            6.931471805598903e-01
+#define LIB_LN2_LO            5.497923018708371e-14
+#define LIB_LOG_L1            -5.00000000000000e-01
+#define LIB_LOG_L2            3.3333333333333337e-01
+#define LIB_LOG_L3            -2.4999999998362796e-01
+#define LIB_LOG_L4            1.9999999998544707e-01
+#define LIB_LOG_L5            -1.6666952780215125e-01
+#define LIB_LOG_L6            1.428596860894785e-01
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct lib_logf_entry_s
+{
+  float invc;
+  float c;
+  float logc_hi;
+  float logc_lo;
+};
+
+#ifdef CONFIG_HAVE_DOUBLE
+struct lib_exp_entry_s
+{
+  double hi;
+  double lo;
+};
+
+struct lib_log_entry_s
+{
+  double invc;
+  double c;
+  double logc_hi;
+  double logc_lo;
+};
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+EXTERN const float g_lib_exp2f_tab[LIB_EXPF_N];
+EXTERN const struct lib_logf_entry_s g_lib_logf_tab[LIB_LOGF_N];
+
+#ifdef CONFIG_HAVE_DOUBLE
+EXTERN const struct lib_exp_entry_s g_lib_exp2_tab[LIB_EXP_N];
+EXTERN const struct lib_log_entry_s g_lib_log_tab[LIB_LOG_N];
+#endif
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+static inline uint32_t lib_asuint(float x)
+{
+  union
+  {
+    float f;
+    uint32_t i;
+  } u;
+
+  u.f = x;
+  return u.i;
+}
+
+static inline float lib_asfloat(uint32_t i)
+{
+  union
+  {
+    uint32_t i;
+    float f;
+  } u;
+
+  u.i = i;
+  return u.f;
+}
+
+#ifdef CONFIG_HAVE_DOUBLE
+static inline uint64_t lib_asuint64(double x)
+{
+  union
+  {
+    double f;
+    uint64_t i;
+  } u;
+
+  u.f = x;
+  return u.i;
+}
+
+static inline double lib_asdouble(uint64_t i)
+{
+  union
+  {
+    uint64_t i;
+    double f;
+  } u;
+
+  u.i = i;
+  return u.f;
+}
+#endif
+
+/****************************************************************************
+ * Name: lib_sincosf_eval
+ *
+ * Description:
+ *   Evaluate sin(r + t + n * pi/2) for a reduced argument |r| <= pi/4 with
+ *   a small tail t, using sin(r + t) ~ sin(r) + t * cos(r) and
+ *   cos(r + t) ~ cos(r) - t * r.  Both polynomials are cheap enough that a
+ *   vectorized caller computes them unconditionally and selects the result.
+ *
+ ****************************************************************************/
+
+static inline float lib_sincosf_eval(float r, float t, uint32_t n)
+{
+  float r2 = r * r;
+  float hz = 0.5f * r2;
+  float w = 1.0f - hz;
+  uint32_t mask;
+  float s;
+  float c;
+
+  s = r + (r * r2 * (LIB_SINF_S1 + r2 * (LIB_SINF_S2 + r2 * LIB_SINF_S3)) +
+           t * w);
+  c = w + (((1.0f - w) - hz) +
+           (r2 * r2 * (LIB_COSF_C1 + r2 * (LIB_COSF_C2 + r2 * LIB_COSF_C3)) -
+            r * t));
+
+  /* Select with masks rather than a conditional to keep loops that use
+   * this free of control flow.
+   */
+
+  mask = 0 - (n & 1);
+  return lib_asfloat(((lib_asuint(s) & ~mask) | (lib_asuint(c) & mask)) ^
+                     ((n & 2) << 30));
+}
+
+/****************************************************************************
+ * Name: lib_sinf_kernel
+ *
+ * Description:
+ *   sin(x + q * pi/2) for |x| < 2^8.  x - n * LIB_PIO2_1_F and
+ *   n * LIB_PIO2_2_F are exact, the rounding errors of the two subtractions
+ *   are carried along as a tail.  No branches, no table lookups.  For sin
+ *   (q = 0) the callers return x below LIB_SINF_TINY, or -0 would come
+ *   out as +0.
+ *
+ ****************************************************************************/
+
+static inline float lib_sinf_kernel(float x, uint32_t q)
+{
+  float kd = x * LIB_INVPIO2_F + LIB_SHIFT_F;
+  uint32_t n = lib_asuint(kd) + q;
+  float r;
+  float w;
+  float y;
+  float t;
+
+  kd -= LIB_SHIFT_F;
+  r   = x - kd * LIB_PIO2_1_F;
+  w   = kd * LIB_PIO2_2_F;
+  y   = r - w;
+  t   = (r - y) - w;
+  w   = kd * LIB_PIO2_3_F;
+  r   = y - w;
+  t  += (y - r) - w;
+
+  return lib_sincosf_eval(r, t, n);
+}
+
+/****************************************************************************
+ * Name: lib_expf_kernel
+ *
+ * Description:
+ *   Return exp(x) * 2^-bias.  Valid when the scaled result is a normal
+ *   number, which holds for |x| < 87 with bias 0.
+ *
+ ****************************************************************************/
+
+static inline float lib_expf_kernel(float x, int bias)
+{
+  float kd = x * LIB_INVLN2N_F + LIB_SHIFT_F;
+  uint32_t ki = lib_asuint(kd);
+  int32_t k = (int32_t)(ki >> LIB_EXPF_TABLE_BITS) -
+              (LIB_SHIFT_F_BITS >> LIB_EXPF_TABLE_BITS);
+  float scale;
+  float r;
+  float p;
+  float t;
+
+  kd -= LIB_SHIFT_F;
+  r   = x - kd * LIB_LN2N_HI_F;
+  r  -= kd * LIB_LN2N_LO_F;
+
+  p = r + r * r * (0.5f + r * (LIB_EXPF_E1 + r * LIB_EXPF_E2));
+  t = g_lib_exp2f_tab[ki & (LIB_EXPF_N - 1)];
+
+  scale = lib_asfloat((uint32_t)(k + 127 - bias) << 23);
+  return (t + t * p) * scale;
+}
+
+/****************************************************************************
+ * Name: lib_logf_kernel
+ *
+ * Description:
+ *   Return log(x) + kadj * ln2 for the bit pattern ix of a positive normal
+ *   number x.
+ *
+ ****************************************************************************/
+
+static inline float lib_logf_kernel(uint32_t ix, int32_t kadj)
+{
+  FAR const struct lib_logf_entry_s *e;
+  uint32_t tmp = ix - LIB_LOGF_OFF;
+  float kf = (float)(((int32_t)tmp >> 23) + kadj);
+  float hi;
+  float lo;
+  float r;
+  float s;
+
+  /* z = x / 2^k lies in [OFF, 2 * OFF) and z - c is exact */
+
+  e  = &g_lib_logf_tab[(tmp >> (23 - LIB_LOGF_TABLE_BITS)) &
+                       (LIB_LOGF_N - 1)];
+  r  = (lib_asfloat(ix - (tmp & 0xff800000)) - e->c) * e->invc;
+  hi = kf * LIB_LN2_HI_F + e->logc_hi;
+  lo = kf * LIB_LN2_LO_F + e->logc_lo;
+
+  /* |hi| >= |r| unless hi is 0, so hi + r is split exactly into s and a
+   * rounding error that joins the low order terms.
+   */
+
+  s  = hi + r;
+  lo = ((hi - s) + r) + lo;
+
+  return s + (lo + r * r * (LIB_LOGF_L1 + r *
+                            (LIB_LOGF_L2 + r * LIB_LOGF_L3)));
+}
+
+#ifdef CONFIG_HAVE_DOUBLE
+
+/****************************************************************************
+ * Name: lib_exp_kernel
+ *
+ * Description:
+ *   Return exp(x) * 2^-bias.  Valid for |x| < 708 with bias 0.
+ *
+ ****************************************************************************/
+
+static inline double lib_exp_kernel(double x, int bias)
+{
+  FAR const struct lib_exp_entry_s *e;
+  double kd = x * LIB_INVLN2N + LIB_SHIFT;
+  uint64_t ki = lib_asuint64(kd);
+  int64_t k = (int64_t)(ki >> LIB_EXP_TABLE_BITS) -
+              (int64_t)(LIB_SHIFT_BITS >> LIB_EXP_TABLE_BITS);
+  double scale;
+  double r;
+  double p;
+
+  kd -= LIB_SHIFT;
+  r   = x - kd * LIB_LN2N_HI;
+  r  -= kd * LIB_LN2N_LO;
+
+  p = r + r * r * (0.5 + r * (LIB_EXP_E1 + r * (LIB_EXP_E2 +
+                                                r * LIB_EXP_E3)));
+  e = &g_lib_exp2_tab[ki & (LIB_EXP_N - 1)];
+
+  scale = lib_asdouble((uint64_t)(k + 1023 - bias) << 52);
+  return (e->hi + (e->lo + e->hi * p)) * scale;
+}
+
+/****************************************************************************
+ * Name: lib_log_kernel
+ *
+ * Description:
+ *   Return log(x) + kadj * ln2 for the bit pattern ix of a positive normal
+ *   number x.
+ *
+ ****************************************************************************/
+
+static inline double lib_log_kernel(uint64_t ix, int kadj)
+{
+  FAR const struct lib_log_entry_s *e;
+  uint64_t tmp = ix - LIB_LOG_OFF;
+  double kd = (double)(((int64_t)tmp >> 52) + kadj);
+  double hi;
+  double lo;
+  double r;
+  double s;
+  double p;
+
+  e  = &g_lib_log_tab[(tmp >> (52 - LIB_LOG_TABLE_BITS)) & (LIB_LOG_N - 1)];
+  r  = (lib_asdouble(ix - (tmp & 0xfff0000000000000ull)) - e->c) * e->invc;
+  hi = kd * LIB_LN2_HI + e->logc_hi;
+  lo = kd * LIB_LN2_LO + e->logc_lo;
+
+  /* Exact split of hi + r, as in lib_logf_kernel() */
+
+  s  = hi + r;
+  lo = ((hi - s) + r) + lo;
+
+  p = LIB_LOG_L3 + r * (LIB_LOG_L4 + r * (LIB_LOG_L5 + r * LIB_LOG_L6));
+  return s + (lo + r * r * (LIB_LOG_L1 + r * (LIB_LOG_L2 + r * p)));
+}
+
+#endif /* CONFIG_HAVE_DOUBLE */
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* Defined in lib_librempio2.c */
+
+int lib_rempio2f(float x, FAR float *y);
+#ifdef CONFIG_HAVE_DOUBLE
+int lib_rempio2(double x, FAR double *y);
+#endif
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* __LIBS_LIBC_MATH_LIB_MATH_H */
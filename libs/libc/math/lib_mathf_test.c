@@ -0,0 +1,234 @@
+/****************************************************************************
+ * libs/libc/math/lib_mathf_test.c
+ * Accuracy and benchmark driver for sinf(), cosf(), expf(), logf() and
+ * their vector forms.  It is not part of the build: compile it as a
+ * program together with the math sources (for example in the simulator,
+ * which provides the double precision reference) and run it.  It returns
+ * EXIT_SUCCESS if every result is within the error bound, the vector
+ * functions match the scalar ones bit for bit and the signed zeros come
+ * out right.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <float.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TEST_COUNT      4096
+#define TEST_ROUNDS     256
+#define TEST_MAX_ULP    1.1
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct mathf_test_s
+{
+  FAR const char *name;
+  CODE float (*scalar)(float x);
+  CODE void (*vector)(FAR float *y, FAR const float *x, size_t n);
+  CODE double (*reference)(double x);
+  float min;
+  float max;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct mathf_test_s g_mathf_test[] =
+{
+  { "sinf", sinf, vsinf, sin, -200.0f, 200.0f },
+  { "sinf", sinf, vsinf, sin, 200.0f, 1e6f },
+  { "cosf", cosf, vcosf, cos, -200.0f, 200.0f },
+  { "cosf", cosf, vcosf, cos, 200.0f, 1e6f },
+  { "expf", expf, vexpf, exp, -100.0f, 88.0f },
+  { "logf", logf, vlogf, log, 1e-30f, 1e30f },
+};
+
+static float g_x[TEST_COUNT];
+static float g_y[TEST_COUNT];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mathf_ulp
+ *
+ * Description:
+ *   Error of y in units in the last place of the exact result ref.
+ *
+ ****************************************************************************/
+
+static double mathf_ulp(float y, double ref)
+{
+  int exp;
+
+  frexp(ref, &exp);
+  if (exp < FLT_MIN_EXP)
+    {
+      exp = FLT_MIN_EXP;
+    }
+
+  return fabs((double)y - ref) / ldexp(1.0, exp - FLT_MANT_DIG);
+}
+
+/****************************************************************************
+ * Name: mathf_now
+ ****************************************************************************/
+
+static double mathf_now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/****************************************************************************
+ * Name: mathf_run
+ *
+ * Description:
+ *   Check and time one function over TEST_ROUNDS sets of TEST_COUNT
+ *   arguments spread evenly over its range, logarithmically for logf().
+ *   Returns the number of failures.
+ *
+ ****************************************************************************/
+
+static int mathf_run(FAR const struct mathf_test_s *test)
+{
+  double maxulp = 0.0;
+  double tscalar = 0.0;
+  double tvector = 0.0;
+  double start;
+  double ulp;
+  float lo = test->min;
+  float hi = test->max;
+  int failed = 0;
+  int round;
+  int i;
+
+  for (round = 0; round < TEST_ROUNDS; round++)
+    {
+      for (i = 0; i < TEST_COUNT; i++)
+        {
+          double t = (round * TEST_COUNT + i + 0.5) /
+                     (TEST_ROUNDS * TEST_COUNT);
+
+          g_x[i] = test->scalar == logf ?
+                   (float)(lo * pow((double)hi / lo, t)) :
+                   (float)(lo + (hi - lo) * t);
+        }
+
+      start = mathf_now();
+      for (i = 0; i < TEST_COUNT; i++)
+        {
+          g_y[i] = test->scalar(g_x[i]);
+        }
+
+      tscalar += mathf_now() - start;
+
+      for (i = 0; i < TEST_COUNT; i++)
+        {
+          ulp = mathf_ulp(g_y[i], test->reference(g_x[i]));
+          if (ulp > maxulp)
+            {
+              maxulp = ulp;
+            }
+        }
+
+      start = mathf_now();
+      test->vector(g_y, g_x, TEST_COUNT);
+      tvector += mathf_now() - start;
+
+      for (i = 0; i < TEST_COUNT; i++)
+        {
+          float y = test->scalar(g_x[i]);
+
+          if (memcmp(&g_y[i], &y, sizeof(y)) != 0)
+            {
+              printf("FAILED %s(%a): vector %a, scalar %a\n",
+                     test->name, g_x[i], g_y[i], y);
+              failed++;
+            }
+        }
+    }
+
+  if (maxulp > TEST_MAX_ULP)
+    {
+      printf("FAILED %s: maximum error %.3f ULP\n", test->name, maxulp);
+      failed++;
+    }
+
+  printf("%s [%g, %g]: %.3f ULP, %.1f ns scalar, %.1f ns vector\n",
+         test->name, lo, hi, maxulp, tscalar / (TEST_ROUNDS * TEST_COUNT),
+         tvector / (TEST_ROUNDS * TEST_COUNT));
+  return failed;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, FAR char *argv[])
+{
+  static const float zeros[2] =
+  {
+    0.0f, -0.0f
+  };
+
+  float y[2];
+  int failed = 0;
+  int i;
+
+  for (i = 0; i < sizeof(g_mathf_test) / sizeof(g_mathf_test[0]); i++)
+    {
+      failed += mathf_run(&g_mathf_test[i]);
+    }
+
+  /* sin(+-0) is +-0, both from the scalar and the vector function */
+
+  vsinf(y, zeros, 2);
+  for (i = 0; i < 2; i++)
+    {
+      if (signbit(sinf(zeros[i])) != signbit(zeros[i]) ||
+          signbit(y[i]) != signbit(zeros[i]))
+        {
+          printf("FAILED sinf(%g) has the wrong sign\n", zeros[i]);
+          failed++;
+        }
+    }
+
+  printf("%d failures\n", failed);
+  return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -32,83 +32,56 @@
 #include <nuttx/config.h>
 #include <nuttx/compiler.h>
 
-#include <sys/types.h>
+#include <stdint.h>
 #include <math.h>
 
+#include "lib_math.h"
+
 #ifdef CONFIG_HAVE_DOUBLE
 
 /****************************************************************************
- * Private Data
+ * Public Functions
  ****************************************************************************/
 
-static double _dbl_inv_fact[] =
-{
-  1.0 / 1.0,                    /* 1 / 1! */
-  1.0 / 6.0,                    /* 1 / 3! */
-  1.0 / 120.0,                  /* 1 / 5! */
-  1.0 / 5040.0,                 /* 1 / 7! */
-  1.0 / 362880.0,               /* 1 / 9! */
-  1.0 / 39916800.0,             /* 1 / 11! */
-  1.0 / 6227020800.0,           /* 1 / 13! */
-  1.0 / 1307674368000.0,        /* 1 / 15! */
-  1.0 / 355687428096000.0,      /* 1 / 17! */
-  1.0 / 121645100408832000.0,   /* 1 / 19! */
-};
-
 /****************************************************************************
- * Public Functions
+ * Name: sin
+ *
+ * Description:
+ *   The argument is reduced by lib_rempio2() and evaluated with the __sin()
+ *   and __cos() kernels.  Maximum error is about 0.78 ULP.
+ *
  ****************************************************************************/
 
 double sin(double x)
 {
-  double x_squared;
-  double sin_x;
-  size_t i;
+  uint32_t hx = (lib_asuint64(x) >> 32) & 0x7fffffff;
+  double y[2];
 
-  /* Move x to [-pi, pi) */
+  /* |x| < pi/4 */
 
-  x = fmod(x, 2 * M_PI);
-  if (x >= M_PI)
+  if (hx < 0x3fe921fb)
     {
-      x -= 2 * M_PI;
+      return hx < 0x3e500000 ? x : __sin(x, 0.0, 0);
     }
-
-  if (x < -M_PI)
+  else if (hx >= 0x7ff00000)
     {
-      x += 2 * M_PI;
+      return x - x;
     }
 
-  /* Move x to [-pi/2, pi/2) */
-
-  if (x >= M_PI_2)
+  switch (lib_rempio2(x, y) & 3)
     {
-      x = M_PI - x;
-    }
-
-  if (x < -M_PI_2)
-    {
-      x = -M_PI - x;
-    }
+      case 0:
+        return __sin(y[0], y[1], 1);
 
-  x_squared = x * x;
-  sin_x = 0.0;
+      case 1:
+        return __cos(y[0], y[1]);
 
-  /* Perform Taylor series approximation for sin(x) with ten terms */
+      case 2:
+        return -__sin(y[0], y[1], 1);
 
-  for (i = 0; i < 10; i++)
-    {
-      if (i % 2 == 0)
-        {
-          sin_x += x * _dbl_inv_fact[i];
-        }
-      else
-        {
-          sin_x -= x * _dbl_inv_fact[i];
-        }
-
-      x *= x_squared;
+      default:
+        return -__cos(y[0], y[1]);
     }
-
-  return sin_x;
 }
+
 #endif
@@ -0,0 +1,120 @@
+/****************************************************************************
+ * libs/libc/math/lib_vmathf.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "lib_math.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Inputs are processed in blocks through a local buffer so that x and y
+ * may be the same array: the inline kernel runs over the whole block, then
+ * the few elements outside of its domain are redone with the scalar
+ * function.
+ */
+
+#define VMATH_BLOCK         64
+
+#define VMATH_LOOP(y, x, n, kernel, outside, scalar) \
+  do \
+    { \
+      float t_[VMATH_BLOCK]; \
+      uint32_t ix_; \
+      size_t len_; \
+      size_t i_; \
+      size_t j_; \
+      int any_; \
+      for (i_ = 0; i_ < (n); i_ += len_) \
+        { \
+          len_ = (n) - i_ < VMATH_BLOCK ? (n) - i_ : VMATH_BLOCK; \
+          any_ = 0; \
+          for (j_ = 0; j_ < len_; j_++) \
+            { \
+              ix_    = lib_asuint((x)[i_ + j_]); \
+              t_[j_] = kernel; \
+              any_  |= outside; \
+            } \
+          if (any_) \
+            { \
+              for (j_ = 0; j_ < len_; j_++) \
+                { \
+                  ix_ = lib_asuint((x)[i_ + j_]); \
+                  if (outside) \
+                    { \
+                      t_[j_] = scalar((x)[i_ + j_]); \
+                    } \
+                } \
+            } \
+          for (j_ = 0; j_ < len_; j_++) \
+            { \
+              (y)[i_ + j_] = t_[j_]; \
+            } \
+        } \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vsinf, vcosf, vexpf, vlogf
+ *
+ * Description:
+ *   y[i] = f(x[i]) for 0 <= i < n, with the same results as the scalar
+ *   functions.  x and y may be the same array.
+ *
+ ****************************************************************************/
+
+void vsinf(FAR float *y, FAR const float *x, size_t n)
+{
+  VMATH_LOOP(y, x, n, lib_sinf_kernel(x[i_ + j_], 0),
+             (ix_ & 0x7fffffff) - LIB_SINF_TINY >=
+             LIB_SINF_BIG - LIB_SINF_TINY, sinf);
+}
+
+void vcosf(FAR float *y, FAR const float *x, size_t n)
+{
+  VMATH_LOOP(y, x, n, lib_sinf_kernel(x[i_ + j_], 1),
+             (ix_ & 0x7fffffff) >= LIB_SINF_BIG, cosf);
+}
+
+void vexpf(FAR float *y, FAR const float *x, size_t n)
+{
+  VMATH_LOOP(y, x, n, lib_expf_kernel(x[i_ + j_], 0),
+             (ix_ & 0x7fffffff) >= LIB_EXPF_SMALL, expf);
+}
+
+void vlogf(FAR float *y, FAR const float *x, size_t n)
+{
+  VMATH_LOOP(y, x, n, lib_logf_kernel(ix_, 0),
+             ix_ - 0x00800000 >= 0x7f800000 - 0x00800000, logf);
+}
@@ -121,6 +121,45 @@ void lib_take_semaphore(FAR struct file_struct *stream)
 #endif
 }
 
+/****************************************************************************
+ * lib_trytake_semaphore
+ ****************************************************************************/
+
+int lib_trytake_semaphore(FAR struct file_struct *stream)
+{
+#ifdef CONFIG_SMP
+  irqstate_t flags = enter_critical_section();
+#endif
+
+  pid_t my_pid = getpid();
+  int ret = OK;
+
+  /* Do I already have the semaphore? */
+
+  if (stream->fs_holder == my_pid)
+    {
+      stream->fs_counts++;
+    }
+
+  /* No, take it only if nobody else holds it */
+
+  else if ((ret = _SEM_TRYWAIT(&stream->fs_sem)) >= 0)
+    {
+      stream->fs_holder = my_pid;
+      stream->fs_counts = 1;
+    }
+  else
+    {
+      ret = ERROR;
+    }
+
+#ifdef CONFIG_SMP
+  leave_critical_section(flags);
+#endif
+
+  return ret;
+}
+
 /****************************************************************************
  * lib_give_semaphore
  ****************************************************************************/
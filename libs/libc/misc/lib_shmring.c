@@ -0,0 +1,312 @@
+/****************************************************************************
+ * libs/libc/misc/lib_shmring.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/ioctl.h>
+#include <sys/shmring.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <errno.h>
+
+#ifdef CONFIG_DEV_SHMRING
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shmring_slot
+ ****************************************************************************/
+
+static inline FAR struct shmring_slot_s *
+shmring_slot(FAR struct shmring_ctrl_s *ctrl, uint32_t pos)
+{
+  return (FAR struct shmring_slot_s *)
+         (ctrl->slots + (pos & ctrl->mask) * ctrl->stride);
+}
+
+/****************************************************************************
+ * Name: shmring_wait
+ *
+ * Description:
+ *   Wait for the ring to become readable (POLLIN) or writable (POLLOUT),
+ *   unless the ring was opened with O_NONBLOCK.
+ *
+ * Returned Value:
+ *   Zero (OK) if the caller should try again; -1 (ERROR) with errno set
+ *   otherwise.
+ *
+ ****************************************************************************/
+
+static int shmring_wait(FAR struct shmring_s *ring, int events)
+{
+  if (ring->oflag & O_NONBLOCK)
+    {
+      set_errno(EAGAIN);
+      return ERROR;
+    }
+
+  return ioctl(ring->fd, SHMRINGIOC_WAIT, (unsigned long)events);
+}
+
+/****************************************************************************
+ * Name: shmring_wake
+ *
+ * Description:
+ *   Wake the other side if some of it is waiting.  The count is read only
+ *   after the slot has been handed over; the kernel counts a waiter before
+ *   it checks the slot.  So either the waiter sees the slot or we see the
+ *   waiter.
+ *
+ ****************************************************************************/
+
+static void shmring_wake(FAR struct shmring_s *ring,
+                         FAR volatile uint32_t *count, int events)
+{
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  if (__atomic_load_n(count, __ATOMIC_RELAXED) != 0)
+    {
+      ioctl(ring->fd, SHMRINGIOC_WAKE, (unsigned long)events);
+    }
+}
+
+/****************************************************************************
+ * Name: shmring_claim
+ *
+ * Description:
+ *   Claim the position at *index if its slot has the expected turn.
+ *   Several producers or consumers race with compare-and-swap; a single
+ *   one takes the position with a plain store.
+ *
+ * Returned Value:
+ *   The claimed slot; NULL if the ring is full (producer) or empty
+ *   (consumer).
+ *
+ ****************************************************************************/
+
+static FAR struct shmring_slot_s *
+shmring_claim(FAR struct shmring_ctrl_s *ctrl,
+              FAR volatile uint32_t *index, uint32_t turn)
+{
+  FAR struct shmring_slot_s *slot;
+  uint32_t pos;
+  int32_t diff;
+
+  pos = __atomic_load_n(index, __ATOMIC_RELAXED);
+  for (; ; )
+    {
+      slot = shmring_slot(ctrl, pos);
+      diff = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) -
+                       (pos + turn));
+      if (diff == 0)
+        {
+          if (ctrl->flags & SHMRING_SPSC)
+            {
+              *index = pos + 1;
+              return slot;
+            }
+
+          if (__atomic_compare_exchange_n(index, &pos, pos + 1, true,
+                                          __ATOMIC_RELAXED,
+                                          __ATOMIC_RELAXED))
+            {
+              return slot;
+            }
+        }
+      else if (diff < 0)
+        {
+          return NULL;
+        }
+      else
+        {
+          pos = __atomic_load_n(index, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shmring_open
+ *
+ * Description:
+ *   Open the ring called 'name'.  O_CREAT creates it with the geometry in
+ *   'attr' if it does not exist yet, and O_EXCL makes that a requirement,
+ *   as for mq_open().  O_NONBLOCK makes shmring_reserve() and
+ *   shmring_peek() fail with EAGAIN instead of waiting.  The ring lives
+ *   until the last descriptor attached to it is closed.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -1 (ERROR) on failure with errno set.
+ *
+ ****************************************************************************/
+
+int shmring_open(FAR struct shmring_s *ring, FAR const char *name,
+                 int oflag, FAR const struct shmring_attr_s *attr)
+{
+  struct shmring_attach_s attach;
+  int errcode;
+  int ret;
+
+  ring->fd = open(SHMRING_DEVPATH, O_RDWR);
+  if (ring->fd < 0)
+    {
+      return ERROR;
+    }
+
+  memset(&attach, 0, sizeof(struct shmring_attach_s));
+  attach.name  = name;
+  attach.oflag = oflag;
+  if (attr != NULL)
+    {
+      attach.attr = *attr;
+    }
+
+  ret = ioctl(ring->fd, SHMRINGIOC_ATTACH,
+              (unsigned long)((uintptr_t)&attach));
+  if (ret < 0)
+    {
+      errcode = get_errno();
+      close(ring->fd);
+      ring->fd = -1;
+      set_errno(errcode);
+      return ERROR;
+    }
+
+  ring->oflag = oflag;
+  ring->ctrl  = attach.ctrl;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: shmring_close
+ ****************************************************************************/
+
+void shmring_close(FAR struct shmring_s *ring)
+{
+  close(ring->fd);
+  ring->fd   = -1;
+  ring->ctrl = NULL;
+}
+
+/****************************************************************************
+ * Name: shmring_reserve
+ *
+ * Description:
+ *   Claim the next free slot for the caller to fill in place, waiting for
+ *   one if the ring is full.  At most ring->ctrl->slotsize bytes may be
+ *   written.
+ *
+ * Returned Value:
+ *   The payload buffer of the slot; NULL on failure with errno set.
+ *
+ ****************************************************************************/
+
+FAR void *shmring_reserve(FAR struct shmring_s *ring)
+{
+  FAR struct shmring_ctrl_s *ctrl = ring->ctrl;
+  FAR struct shmring_slot_s *slot;
+
+  while ((slot = shmring_claim(ctrl, &ctrl->head, 0)) == NULL)
+    {
+      if (shmring_wait(ring, POLLOUT) < 0)
+        {
+          return NULL;
+        }
+    }
+
+  return slot + 1;
+}
+
+/****************************************************************************
+ * Name: shmring_commit
+ *
+ * Description:
+ *   Publish 'len' bytes written into a buffer from shmring_reserve().
+ *
+ ****************************************************************************/
+
+void shmring_commit(FAR struct shmring_s *ring, FAR void *buf, size_t len)
+{
+  FAR struct shmring_slot_s *slot = (FAR struct shmring_slot_s *)buf - 1;
+
+  slot->len = len;
+  __atomic_store_n(&slot->seq, slot->seq + 1, __ATOMIC_RELEASE);
+  shmring_wake(ring, &ring->ctrl->rwait, POLLIN);
+}
+
+/****************************************************************************
+ * Name: shmring_peek
+ *
+ * Description:
+ *   Claim the oldest published slot for the caller to read in place,
+ *   waiting for one if the ring is empty.
+ *
+ * Returned Value:
+ *   The payload buffer of the slot, with its length in *len; NULL on
+ *   failure with errno set.
+ *
+ ****************************************************************************/
+
+FAR void *shmring_peek(FAR struct shmring_s *ring, FAR size_t *len)
+{
+  FAR struct shmring_ctrl_s *ctrl = ring->ctrl;
+  FAR struct shmring_slot_s *slot;
+
+  while ((slot = shmring_claim(ctrl, &ctrl->tail, 1)) == NULL)
+    {
+      if (shmring_wait(ring, POLLIN) < 0)
+        {
+          return NULL;
+        }
+    }
+
+  *len = slot->len;
+  return slot + 1;
+}
+
+/****************************************************************************
+ * Name: shmring_release
+ *
+ * Description:
+ *   Hand a buffer from shmring_peek() back to the producers.
+ *
+ ****************************************************************************/
+
+void shmring_release(FAR struct shmring_s *ring, FAR void *buf)
+{
+  FAR struct shmring_slot_s *slot = (FAR struct shmring_slot_s *)buf - 1;
+
+  __atomic_store_n(&slot->seq, slot->seq + ring->ctrl->mask,
+                   __ATOMIC_RELEASE);
+  shmring_wake(ring, &ring->ctrl->wwait, POLLOUT);
+}
+
+#endif /* CONFIG_DEV_SHMRING */
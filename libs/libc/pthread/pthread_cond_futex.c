@@ -0,0 +1,242 @@
+/****************************************************************************
+ * libs/libc/pthread/pthread_cond_futex.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/futex.h>
+#include <stdint.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <errno.h>
+
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef CONFIG_PTHREAD_CLEANUP
+struct cond_wait_s
+{
+  FAR pthread_cond_t *cond;
+  FAR pthread_mutex_t *mutex;
+};
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cond_cleanup
+ *
+ * Description:
+ *   Run if the thread is canceled while it waits: stop counting it as a
+ *   waiter and give the cleanup handlers the mutex back, as POSIX
+ *   requires.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PTHREAD_CLEANUP
+static void cond_cleanup(FAR void *arg)
+{
+  FAR struct cond_wait_s *wait = (FAR struct cond_wait_s *)arg;
+
+  __atomic_fetch_sub(&wait->cond->nwaiters, 1, __ATOMIC_SEQ_CST);
+  pthread_mutex_lock(wait->mutex);
+}
+#endif
+
+/****************************************************************************
+ * Name: cond_wake
+ *
+ * Description:
+ *   Bump the sequence number and wake up to nwake waiters.  The waiter
+ *   count is read only after the bump; a waiter counts itself before it
+ *   reads the sequence number.  So either we see the waiter, or it sees
+ *   the new sequence number and does not sleep on the old one.
+ *
+ ****************************************************************************/
+
+static void cond_wake(FAR pthread_cond_t *cond, uint32_t nwake)
+{
+  __atomic_fetch_add(&cond->seq, 1, __ATOMIC_SEQ_CST);
+  if (__atomic_load_n(&cond->nwaiters, __ATOMIC_SEQ_CST) != 0)
+    {
+      futex(&cond->seq, FUTEX_WAKE, nwake, NULL);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_cond_timedwait
+ *
+ * Description:
+ *   Release the mutex and wait for the condition variable to be signaled,
+ *   or until the absolute time abstime (forever if abstime is NULL).  The
+ *   mutex is taken again before returning.
+ *
+ * Input Parameters:
+ *   cond    - The condition variable to wait on
+ *   mutex   - The mutex held by the caller
+ *   abstime - Absolute CLOCK_REALTIME time to give up, or NULL
+ *
+ * Returned Value:
+ *   0 (OK) on success; otherwise EINVAL, EPERM (the mutex is not held by
+ *   the caller), ETIMEDOUT or the error of a failed futex() call.
+ *
+ ****************************************************************************/
+
+int pthread_cond_timedwait(FAR pthread_cond_t *cond,
+                           FAR pthread_mutex_t *mutex,
+                           FAR const struct timespec *abstime)
+{
+#ifdef CONFIG_PTHREAD_CLEANUP
+  struct cond_wait_s wait;
+#endif
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+  int16_t nlocks;
+#endif
+  uint32_t seq;
+  int ret = OK;
+  int status;
+
+  if (cond == NULL || mutex == NULL)
+    {
+      return EINVAL;
+    }
+
+  /* Only mutexes that record their holder can be checked */
+
+  if (mutex->futex == 0 || (mutex->pid != -1 && mutex->pid != getpid()))
+    {
+      return EPERM;
+    }
+
+  __atomic_fetch_add(&cond->nwaiters, 1, __ATOMIC_SEQ_CST);
+  seq = __atomic_load_n(&cond->seq, __ATOMIC_SEQ_CST);
+
+  /* Give up the mutex, all the recursive locks of it at once */
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+  nlocks        = mutex->nlocks;
+  mutex->nlocks = 1;
+#endif
+  pthread_mutex_unlock(mutex);
+
+  /* Sleep unless the condition was signaled since seq was read.  Wake-ups
+   * may be spurious, which the caller has to handle anyway.  The sleep is
+   * a cancellation point.
+   */
+
+#ifdef CONFIG_PTHREAD_CLEANUP
+  wait.cond  = cond;
+  wait.mutex = mutex;
+  pthread_cleanup_push(cond_cleanup, &wait);
+#endif
+
+  status = futex(&cond->seq, FUTEX_WAIT, seq, abstime);
+  if (status < 0 && get_errno() != EAGAIN && get_errno() != EINTR)
+    {
+      ret = get_errno();
+    }
+
+#ifdef CONFIG_PTHREAD_CLEANUP
+  pthread_cleanup_pop(0);
+#endif
+
+  __atomic_fetch_sub(&cond->nwaiters, 1, __ATOMIC_SEQ_CST);
+
+  /* Take the mutex again, even if the wait timed out */
+
+  status = pthread_mutex_lock(mutex);
+  if (status != OK)
+    {
+      return status;
+    }
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+  mutex->nlocks = nlocks;
+#endif
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pthread_cond_wait
+ *
+ * Description:
+ *   Release the mutex and wait for the condition variable to be signaled.
+ *
+ ****************************************************************************/
+
+int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
+{
+  return pthread_cond_timedwait(cond, mutex, NULL);
+}
+
+/****************************************************************************
+ * Name: pthread_cond_signal
+ *
+ * Description:
+ *   Wake one thread waiting on the condition variable.  Nothing is done in
+ *   the kernel if there is none.
+ *
+ ****************************************************************************/
+
+int pthread_cond_signal(FAR pthread_cond_t *cond)
+{
+  if (cond == NULL)
+    {
+      return EINVAL;
+    }
+
+  cond_wake(cond, 1);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pthread_cond_broadcast
+ *
+ * Description:
+ *   Wake all threads waiting on the condition variable.  Nothing is done
+ *   in the kernel if there is none.
+ *
+ ****************************************************************************/
+
+int pthread_cond_broadcast(FAR pthread_cond_t *cond)
+{
+  if (cond == NULL)
+    {
+      return EINVAL;
+    }
+
+  cond_wake(cond, INT_MAX);
+  return OK;
+}
+
+#endif /* CONFIG_PTHREAD_MUTEX_FUTEX */
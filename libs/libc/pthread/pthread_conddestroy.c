@@ -74,12 +74,23 @@ int pthread_cond_destroy(FAR pthread_cond_t *cond)
       ret = EINVAL;
     }
 
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+  /* There is nothing to release, but a condition variable that is being
+   * waited on may not be destroyed.
+   */
+
+  else if (cond->nwaiters != 0)
+    {
+      ret = EBUSY;
+    }
+#else
   /* Destroy the semaphore contained in the structure */
 
   else if (sem_destroy((FAR sem_t *)&cond->sem) != OK)
     {
       ret = EINVAL;
     }
+#endif
 
   sinfo("Returning %d\n", ret);
   return ret;
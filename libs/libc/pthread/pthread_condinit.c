@@ -75,6 +75,15 @@ int pthread_cond_init(FAR pthread_cond_t *cond, FAR const pthread_condattr_t *at
       ret = EINVAL;
     }
 
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+  /* Nobody waits and nothing has been signaled yet */
+
+  else
+    {
+      cond->seq      = 0;
+      cond->nwaiters = 0;
+    }
+#else
   /* Initialize the semaphore contained in the condition structure with
    * initial count = 0
    */
@@ -91,6 +100,7 @@ int pthread_cond_init(FAR pthread_cond_t *cond, FAR const pthread_condattr_t *at
 
       sem_setprotocol(&cond->sem, SEM_PRIO_NONE);
     }
+#endif
 
   sinfo("Returning %d\n", ret);
   return ret;
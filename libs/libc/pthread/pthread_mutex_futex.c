@@ -0,0 +1,387 @@
+/****************************************************************************
+ * libs/libc/pthread/pthread_mutex_futex.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/futex.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <errno.h>
+
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Values of the futex word */
+
+#define MUTEX_UNLOCKED   0  /* Free */
+#define MUTEX_LOCKED     1  /* Held, nobody sleeps on it */
+#define MUTEX_CONTENDED  2  /* Held, somebody may sleep on it */
+
+/* Only mutexes that detect recursion or foreign unlocks need to know their
+ * holder, and only those pay for getpid().
+ */
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+#  define MUTEX_OWNED(m) ((m)->type != PTHREAD_MUTEX_NORMAL)
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mutex_trylock
+ ****************************************************************************/
+
+static inline bool mutex_trylock(FAR pthread_mutex_t *mutex)
+{
+  uint32_t state = MUTEX_UNLOCKED;
+
+  return __atomic_compare_exchange_n(&mutex->futex, &state, MUTEX_LOCKED,
+                                     false, __ATOMIC_ACQUIRE,
+                                     __ATOMIC_RELAXED);
+}
+
+/****************************************************************************
+ * Name: mutex_lock
+ *
+ * Description:
+ *   Take the mutex, sleeping in the kernel while it is held.  A thread
+ *   about to sleep marks the futex contended, so that the holder knows to
+ *   wake somebody on unlock.  Having slept once, the mutex is taken as
+ *   contended: there may be others still asleep.
+ *
+ ****************************************************************************/
+
+static int mutex_lock(FAR pthread_mutex_t *mutex,
+                      FAR const struct timespec *abstime)
+{
+  uint32_t state;
+  int errcode;
+
+  if (mutex_trylock(mutex))
+    {
+      return OK;
+    }
+
+  state = __atomic_exchange_n(&mutex->futex, MUTEX_CONTENDED,
+                              __ATOMIC_ACQUIRE);
+  while (state != MUTEX_UNLOCKED)
+    {
+      /* EAGAIN means that the mutex changed hands before we slept, EINTR
+       * that a signal woke us.  Anything else, including a timeout, ends
+       * the attempt.
+       */
+
+      if (futex(&mutex->futex, FUTEX_WAIT, MUTEX_CONTENDED, abstime) < 0)
+        {
+          errcode = get_errno();
+          if (errcode != EAGAIN && errcode != EINTR)
+            {
+              return errcode;
+            }
+        }
+
+      state = __atomic_exchange_n(&mutex->futex, MUTEX_CONTENDED,
+                                  __ATOMIC_ACQUIRE);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mutex_owner
+ *
+ * Description:
+ *   Handle a lock request of a thread that may already hold the mutex.
+ *
+ * Returned Value:
+ *   OK if the mutex was taken recursively, an errno value if the request
+ *   fails, or -EAGAIN if the mutex has to be taken.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+static int mutex_owner(FAR pthread_mutex_t *mutex, pid_t pid)
+{
+  if (mutex->pid != pid)
+    {
+      return -EAGAIN;
+    }
+
+  if (mutex->type != PTHREAD_MUTEX_RECURSIVE)
+    {
+      return EDEADLK;
+    }
+
+  if (mutex->nlocks >= INT16_MAX)
+    {
+      return EOVERFLOW;
+    }
+
+  mutex->nlocks++;
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_init
+ *
+ * Description:
+ *   Create a mutex
+ *
+ * Input Parameters:
+ *   mutex - The mutex to initialize
+ *   attr  - Mutex attributes, or NULL for the defaults
+ *
+ * Returned Value:
+ *   0 (OK) on success or EINVAL if mutex is NULL.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_init(FAR pthread_mutex_t *mutex,
+                       FAR const pthread_mutexattr_t *attr)
+{
+  if (mutex == NULL)
+    {
+      return EINVAL;
+    }
+
+  mutex->futex  = MUTEX_UNLOCKED;
+  mutex->pid    = -1;
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+  mutex->type   = attr != NULL ? attr->type : PTHREAD_MUTEX_DEFAULT;
+  mutex->nlocks = 0;
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_destroy
+ *
+ * Description:
+ *   Destroy a mutex.
+ *
+ * Input Parameters:
+ *   mutex - The mutex to destroy
+ *
+ * Returned Value:
+ *   0 (OK) on success; EINVAL if mutex is NULL or EBUSY if it is held.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_destroy(FAR pthread_mutex_t *mutex)
+{
+  if (mutex == NULL)
+    {
+      return EINVAL;
+    }
+
+  if (mutex->futex != MUTEX_UNLOCKED)
+    {
+      return EBUSY;
+    }
+
+  mutex->pid = -1;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_timedlock
+ *
+ * Description:
+ *   Lock the mutex, waiting until the absolute time abs_timeout at most
+ *   (forever if abs_timeout is NULL).  A free mutex is taken with a single
+ *   compare-and-swap; the kernel is entered only to sleep on a held one.
+ *
+ * Input Parameters:
+ *   mutex       - The mutex to lock
+ *   abs_timeout - Absolute CLOCK_REALTIME time to give up, or NULL
+ *
+ * Returned Value:
+ *   0 (OK) on success; otherwise EINVAL, ETIMEDOUT, EDEADLK (ERRORCHECK
+ *   mutex already held by the caller), EOVERFLOW (too many recursive
+ *   locks) or the error of a failed futex() call.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_timedlock(FAR pthread_mutex_t *mutex,
+                            FAR const struct timespec *abs_timeout)
+{
+  pid_t pid = -1;
+  int ret;
+
+  if (mutex == NULL)
+    {
+      return EINVAL;
+    }
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+  if (MUTEX_OWNED(mutex))
+    {
+      pid = getpid();
+      ret = mutex_owner(mutex, pid);
+      if (ret != -EAGAIN)
+        {
+          return ret;
+        }
+    }
+#endif
+
+  ret = mutex_lock(mutex, abs_timeout);
+  if (ret == OK)
+    {
+      mutex->pid    = pid;
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+      mutex->nlocks = 1;
+#endif
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_trylock
+ *
+ * Description:
+ *   Lock the mutex if it is free.
+ *
+ * Input Parameters:
+ *   mutex - The mutex to lock
+ *
+ * Returned Value:
+ *   0 (OK) on success; otherwise EINVAL, EBUSY (held by another thread or,
+ *   unless RECURSIVE, by the caller) or EOVERFLOW.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_trylock(FAR pthread_mutex_t *mutex)
+{
+  pid_t pid = -1;
+
+  if (mutex == NULL)
+    {
+      return EINVAL;
+    }
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+  if (MUTEX_OWNED(mutex))
+    {
+      int ret;
+
+      pid = getpid();
+      ret = mutex_owner(mutex, pid);
+      if (ret != -EAGAIN)
+        {
+          return ret == EDEADLK ? EBUSY : ret;
+        }
+    }
+#endif
+
+  if (!mutex_trylock(mutex))
+    {
+      return EBUSY;
+    }
+
+  mutex->pid    = pid;
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+  mutex->nlocks = 1;
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_unlock
+ *
+ * Description:
+ *   Unlock the mutex.  The kernel is entered only if some thread may sleep
+ *   on it.
+ *
+ * Input Parameters:
+ *   mutex - The mutex to unlock
+ *
+ * Returned Value:
+ *   0 (OK) on success; otherwise EINVAL or EPERM (the mutex is not held,
+ *   or, unless NORMAL, is held by another thread).
+ *
+ ****************************************************************************/
+
+int pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
+{
+  if (mutex == NULL)
+    {
+      return EINVAL;
+    }
+
+  if (mutex->futex == MUTEX_UNLOCKED)
+    {
+      return EPERM;
+    }
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+  if (MUTEX_OWNED(mutex))
+    {
+      if (mutex->pid != getpid())
+        {
+          return EPERM;
+        }
+
+      if (mutex->nlocks > 1)
+        {
+          mutex->nlocks--;
+          return OK;
+        }
+
+      mutex->nlocks = 0;
+    }
+#endif
+
+  mutex->pid = -1;
+
+  /* Release the mutex, and wake one sleeper if there may be any.  The
+   * woken thread takes the mutex as contended, so that the next unlock
+   * wakes the others in turn.
+   */
+
+  if (__atomic_exchange_n(&mutex->futex, MUTEX_UNLOCKED,
+                          __ATOMIC_RELEASE) == MUTEX_CONTENDED)
+    {
+      futex(&mutex->futex, FUTEX_WAKE, 1, NULL);
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_PTHREAD_MUTEX_FUTEX */
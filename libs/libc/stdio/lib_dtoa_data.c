@@ -37,241 +37,86 @@
  * Included Files
  ****************************************************************************/
 
-#include <sys/types.h>
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
 #include "lib_dtoa_engine.h"
 
 /****************************************************************************
- * Pre-processor Definitions
+ * Public Data
  ****************************************************************************/
 
-#ifndef DBL_MAX_10_EXP
-#  error DBL_MAX_10_EXP
-#endif
+/* 5^0 .. 5^25 */
 
-#ifndef DBL_MIN_10_EXP
-#  error DBL_MIN_10_EXP
-#endif
-
-#ifndef DBL_DIG
-#  error DBL_DIG
-#endif
+const uint64_t g_dtoa_pow5[DTOA_POW5_TABLE_SIZE] =
+{
+  1ull, 5ull, 25ull,
+  125ull, 625ull, 3125ull,
+  15625ull, 78125ull, 390625ull,
+  1953125ull, 9765625ull, 48828125ull,
+  244140625ull, 1220703125ull, 6103515625ull,
+  30517578125ull, 152587890625ull, 762939453125ull,
+  3814697265625ull, 19073486328125ull, 95367431640625ull,
+  476837158203125ull, 2384185791015625ull, 11920928955078125ull,
+  59604644775390625ull, 298023223876953125ull
+};
 
-/* Make sure the computed sizes of the arrays match the actual sizes
- * by declaring an array which is legal if the sizes match and illegal
- * if they do not
- */
+/* The leading 125 bits of 5^(26 * i), as { low, high } */
 
-#define count_of(n)             (sizeof (n) / sizeof (n[0]))
-#define match(array,size)       (count_of(array) == size)
-#define check_match(array,size) (match(array, size) ? 1 : -1)
+const uint64_t g_dtoa_pow5_split[DTOA_POW5_SPLIT_SIZE][2] =
+{
+  { 0x0000000000000000ull, 0x1000000000000000ull },
+  { 0x0000000000000000ull, 0x14adf4b7320334b9ull },
+  { 0x0e549208b31adb10ull, 0x1aba4714957d300dull },
+  { 0x6dc6ad264d8f0866ull, 0x1145b7e285bf98f5ull },
+  { 0xeb1dbd923d8596caull, 0x1652efdc6018a1fcull },
+  { 0xb4c1b80b22ae923cull, 0x1cda62055b2d9d83ull },
+  { 0x5bb28b4e8f7e4c30ull, 0x12a5568b9f52f416ull },
+  { 0xf08aed437682d4fbull, 0x1819651531f9e78full },
+  { 0xb4ee134ad99bf150ull, 0x1f25c186a6f04c28ull },
+  { 0x16499ecb70c25f03ull, 0x1420eb449c8842e6ull },
+  { 0x85a56ead360865b0ull, 0x1a03fde214caf085ull },
+  { 0x093db1d57999890bull, 0x10cfeb353a97dad8ull },
+  { 0xcf38bb735e3f36acull, 0x15baaf44fa52673eull }
+};
 
-/****************************************************************************
- * Public Data
- ****************************************************************************/
+/* floor(2^(bitlength(5^(26 * i)) + 124) / 5^(26 * i)), as { low, high } */
 
-const double_t g_dtoa_scale_up[] =
+const uint64_t g_dtoa_pow5_inv_split[DTOA_POW5_SPLIT_SIZE][2] =
 {
-#if DBL_MAX_10_EXP >= 1
-  1e1,
-#endif
-#if DBL_MAX_10_EXP >= 2
-  1e2,
-#endif
-#if DBL_MAX_10_EXP >= 4
-  1e4,
-#endif
-#if DBL_MAX_10_EXP >= 8
-  1e8,
-#endif
-#if DBL_MAX_10_EXP >= 16
-  1e16,
-#endif
-#if DBL_MAX_10_EXP >= 32
-  1e32,
-#endif
-#if DBL_MAX_10_EXP >= 64
-  1e64,
-#endif
-#if DBL_MAX_10_EXP >= 128
-  1e128,
-#endif
-#if DBL_MAX_10_EXP >= 256
-  1e256,
-#endif
-#if DBL_MAX_10_EXP >= 512
-  1e512,
-#endif
-#if DBL_MAX_10_EXP >= 1024
-  1e1024,
-#endif
-#if DBL_MAX_10_EXP >= 2048
-  1e2048,
-#endif
-#if DBL_MAX_10_EXP >= 4096
-  1e4096,
-#endif
-#if DBL_MAX_10_EXP >= 8192
-  1e8192,
-#endif
-#if DBL_MAX_10_EXP >= 16384
-  1e16384,
-#endif
-#if DBL_MAX_10_EXP >= 32768
-  1e32768,
-#endif
-#if DBL_MAX_10_EXP >= 65536
-  1e65536,
-#endif
+  { 0x0000000000000000ull, 0x2000000000000000ull },
+  { 0x52a6c95fc0655033ull, 0x18c240c4aecb13bbull },
+  { 0x7ca8d50071dfc805ull, 0x1327fc58da0f6ff5ull },
+  { 0x6520247d3556476dull, 0x1da48ce468e7c702ull },
+  { 0x6139cdd76802e6e8ull, 0x16ef5b40c2fc7779ull },
+  { 0xf951a7ff43de8c78ull, 0x11bebdf578b2f391ull },
+  { 0x7be8bee8d6e957e7ull, 0x1b758d848fac54b0ull },
+  { 0x8bd3f9e999a423e9ull, 0x153eda614071a3b7ull },
+  { 0x0848f973cb3ee3cdull, 0x10701bd527b4978cull },
+  { 0x153285ebb9efbfa1ull, 0x196fbb9bb44db44dull },
+  { 0xadeee7f86c07b695ull, 0x13ae3591f5b4d936ull },
+  { 0x4d686a4eaf182221ull, 0x1e74404f3daada91ull },
+  { 0x98c0a106e09ebd9eull, 0x17900ea4fda7c257ull }
 };
 
-const double_t g_dtoa_scale_down[] =
+/* 2-bit corrections to add to the rebuilt 5^i and 5^-i, 16 to a word */
+
+const uint32_t g_dtoa_pow5_offsets[] =
 {
-#if DBL_MIN_10_EXP <= -1
-  1e-1,
-#endif
-#if DBL_MIN_10_EXP <= -2
-  1e-2,
-#endif
-#if DBL_MIN_10_EXP <= -4
-  1e-4,
-#endif
-#if DBL_MIN_10_EXP <= -8
-  1e-8,
-#endif
-#if DBL_MIN_10_EXP <= -16
-  1e-16,
-#endif
-#if DBL_MIN_10_EXP <= -32
-  1e-32,
-#endif
-#if DBL_MIN_10_EXP <= -64
-  1e-64,
-#endif
-#if DBL_MIN_10_EXP <= -128
-  1e-128,
-#endif
-#if DBL_MIN_10_EXP <= -256
-  1e-256,
-#endif
-#if DBL_MIN_10_EXP <= -512
-  1e-512,
-#endif
-#if DBL_MIN_10_EXP <= -1024
-  1e-1024,
-#endif
-#if DBL_MIN_10_EXP <= -2048
-  1e-2048,
-#endif
-#if DBL_MIN_10_EXP <= -4096
-  1e-4096,
-#endif
-#if DBL_MIN_10_EXP <= -8192
-  1e-8192,
-#endif
-#if DBL_MIN_10_EXP <= -16384
-  1e-16384,
-#endif
-#if DBL_MIN_10_EXP <= -32768
-  1e-32768,
-#endif
-#if DBL_MIN_10_EXP <= -65536
-  1e-65536,
-#endif
+  0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x40000000, 0x59695995, 0x55545555, 0x56555515,
+  0x41150504, 0x40555410, 0x44555145, 0x44504540,
+  0x45555550, 0x40004000, 0x96440440, 0x55565565,
+  0x54454045, 0x40154151, 0x55559155, 0x51405555,
+  0x00000105
 };
 
-const double_t g_dtoa_round[] =
+const uint32_t g_dtoa_pow5_inv_offsets[] =
 {
-#if DBL_DIG >= 30
-  5e30,
-#endif
-#if DBL_DIG >= 29
-  5e29,
-#endif
-#if DBL_DIG >= 28
-  5e28,
-#endif
-#if DBL_DIG >= 27
-  5e27,
-#endif
-#if DBL_DIG >= 26
-  5e26,
-#endif
-#if DBL_DIG >= 25
-  5e25,
-#endif
-#if DBL_DIG >= 24
-  5e24,
-#endif
-#if DBL_DIG >= 23
-  5e23,
-#endif
-#if DBL_DIG >= 22
-  5e22,
-#endif
-#if DBL_DIG >= 21
-  5e21,
-#endif
-#if DBL_DIG >= 20
-  5e20,
-#endif
-#if DBL_DIG >= 19
-  5e19,
-#endif
-#if DBL_DIG >= 18
-  5e18,
-#endif
-#if DBL_DIG >= 17
-  5e17,
-#endif
-#if DBL_DIG >= 16
-  5e16,
-#endif
-#if DBL_DIG >= 15
-  5e15,
-#endif
-#if DBL_DIG >= 14
-  5e14,
-#endif
-#if DBL_DIG >= 13
-  5e13,
-#endif
-#if DBL_DIG >= 12
-  5e12,
-#endif
-#if DBL_DIG >= 11
-  5e11,
-#endif
-#if DBL_DIG >= 10
-  5e10,
-#endif
-#if DBL_DIG >= 9
-  5e9,
-#endif
-#if DBL_DIG >= 8
-  5e8,
-#endif
-#if DBL_DIG >= 7
-  5e7,
-#endif
-#if DBL_DIG >= 6
-  5e6,
-#endif
-#if DBL_DIG >= 5
-  5e5,
-#endif
-#if DBL_DIG >= 4
-  5e4,
-#endif
-#if DBL_DIG >= 3
-  5e3,
-#endif
-#if DBL_DIG >= 2
-  5e2,
-#endif
-#if DBL_DIG >= 1
-  5e1,
-#endif
-#if DBL_DIG >= 0
-  5e0,
-#endif
+  0xa9a99aa9, 0x595aaa9a, 0x65596555, 0x55955969,
+  0x95565555, 0x966aaaaa, 0x555559a9, 0x55565599,
+  0x95555555, 0x99555596, 0xa59a99a5, 0xaaaa55a9,
+  0xa6baaaa9, 0x95559555, 0x56555556, 0x55565a55,
+  0xa6a6a966, 0x5aaaaaa9, 0x00000015
 };
@@ -37,8 +37,14 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+
 #include <sys/types.h>
-#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/streams.h>
 
 #include "lib_dtoa_engine.h"
 
@@ -46,125 +52,1053 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
-/* A bit of CPP trickery -- construct the floating-point value 10 ** DBL_DIG
- * by pasting the value of DBL_DIG onto '1e' to
+/* Layout of double_t.  The shortest conversion works on the IEEE fields
+ * directly; the exact fallback needs enough 32-bit words to hold the
+ * largest scaled value, which is about 10^-DBL_MIN_10_EXP times the
+ * smallest subnormal mantissa.
  */
 
-#define PASTE(a)      1e##a
-#define SUBSTITUTE(a) PASTE(a)
-#define MIN_MANT      (SUBSTITUTE(DBL_DIG))
-#define MAX_MANT      (10.0 * MIN_MANT)
-#define MIN_MANT_INT  ((uint64_t)MIN_MANT)
-#define MIN_MANT_EXP  DBL_DIG
+#ifdef CONFIG_HAVE_DOUBLE
+#  define DTOA_MANT_BITS      52
+#  define DTOA_EXP_BITS       11
+#  define DTOA_EXP_BIAS       1023
+#  define DTOA_BIGINT_WORDS   36
+#else
+#  define DTOA_MANT_BITS      23
+#  define DTOA_EXP_BITS       8
+#  define DTOA_EXP_BIAS       127
+#  define DTOA_BIGINT_WORDS   7
+#endif
+
+#define DTOA_EXP_MASK         ((1 << DTOA_EXP_BITS) - 1)
+
+/* Integer approximations of logarithms, valid over the exponent ranges
+ * used here.
+ */
+
+#define DTOA_POW5BITS(e)      ((int)(((uint32_t)(e) * 1217359) >> 19) + 1)
+#define DTOA_LOG10POW2(e)     ((int)(((uint32_t)(e) * 78913) >> 18))
+#define DTOA_LOG10POW5(e)     ((int)(((uint32_t)(e) * 732923) >> 20))
+
+#define MIN(a, b)             ((a) < (b) ? (a) : (b))
 
-#define MAX(a, b)     ((a) > (b) ? (a) : (b))
-#define MIN(a, b)     ((a) < (b) ? (a) : (b))
+/* __dtoa_tail() writes its digits in chunks of this size */
+
+#define DTOA_TAIL_CHUNK       16
 
 /****************************************************************************
- * Public Functions
+ * Private Types
  ****************************************************************************/
 
-int __dtoa_engine(double_t x, FAR struct dtoa_s *dtoa, int max_digits,
-                  int max_decimals)
+#ifdef CONFIG_HAVE_DOUBLE
+typedef uint64_t dtoa_bits_t;
+#else
+typedef uint32_t dtoa_bits_t;
+#endif
+
+/* Unsigned big integer used for the rare conversions that need more than
+ * the shortest digits: least significant word first.
+ */
+
+struct dtoa_bigint_s
+{
+  int      len;
+  uint32_t word[DTOA_BIGINT_WORDS];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const uint64_t g_dtoa_pow10[] =
+{
+  1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull,
+  10000000ull, 100000000ull, 1000000000ull, 10000000000ull,
+  100000000000ull, 1000000000000ull, 10000000000000ull,
+  100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+  100000000000000000ull, 1000000000000000000ull
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: dtoa_umul128
+ *
+ * Description:
+ *   Return the low 64 bits of a * b and store the high 64 bits in *hi.
+ *
+ ****************************************************************************/
+
+static uint64_t dtoa_umul128(uint64_t a, uint64_t b, FAR uint64_t *hi)
+{
+  uint64_t ll = (uint64_t)(uint32_t)a * (uint32_t)b;
+  uint64_t lh = (uint64_t)(uint32_t)a * (uint32_t)(b >> 32);
+  uint64_t hl = (uint64_t)(uint32_t)(a >> 32) * (uint32_t)b;
+  uint64_t hh = (uint64_t)(uint32_t)(a >> 32) * (uint32_t)(b >> 32);
+  uint64_t mid1 = hl + (ll >> 32);
+  uint64_t mid2 = lh + (uint32_t)mid1;
+
+  *hi = hh + (mid1 >> 32) + (mid2 >> 32);
+  return (mid2 << 32) | (uint32_t)ll;
+}
+
+static uint64_t dtoa_shiftright128(uint64_t lo, uint64_t hi, int dist)
+{
+  /* 0 < dist < 64 */
+
+  return (hi << (64 - dist)) | (lo >> dist);
+}
+
+/****************************************************************************
+ * Name: dtoa_pow5 and dtoa_pow5_inv
+ *
+ * Description:
+ *   Rebuild the 125-bit approximations of 5^i and 2^k / 5^i from every
+ *   26th entry.
+ *
+ ****************************************************************************/
+
+static void dtoa_pow5_mul(FAR const uint64_t *base, uint64_t m, int delta,
+                          uint32_t corr, FAR uint64_t *result)
+{
+  uint64_t hi0;
+  uint64_t hi1;
+  uint64_t lo0;
+  uint64_t lo1;
+  uint64_t sum;
+
+  /* The product of a 128-bit and a 64-bit value, shifted right by delta */
+
+  lo0 = dtoa_umul128(m, base[0], &hi0);
+  lo1 = dtoa_umul128(m, base[1], &hi1);
+
+  sum = hi0 + lo1;
+  if (sum < hi0)
+    {
+      hi1++;
+    }
+
+  result[0] = dtoa_shiftright128(lo0, sum, delta) + corr;
+  result[1] = dtoa_shiftright128(sum, hi1, delta);
+  if (result[0] < corr)
+    {
+      result[1]++;
+    }
+}
+
+static void dtoa_pow5(int i, FAR uint64_t *result)
+{
+  int base = i / DTOA_POW5_TABLE_SIZE;
+  int base2 = base * DTOA_POW5_TABLE_SIZE;
+  int offset = i - base2;
+
+  if (offset == 0)
+    {
+      result[0] = g_dtoa_pow5_split[base][0];
+      result[1] = g_dtoa_pow5_split[base][1];
+      return;
+    }
+
+  dtoa_pow5_mul(g_dtoa_pow5_split[base], g_dtoa_pow5[offset],
+                DTOA_POW5BITS(i) - DTOA_POW5BITS(base2),
+                (g_dtoa_pow5_offsets[i / 16] >> ((i % 16) << 1)) & 3,
+                result);
+}
+
+static void dtoa_pow5_inv(int i, FAR uint64_t *result)
+{
+  int base = (i + DTOA_POW5_TABLE_SIZE - 1) / DTOA_POW5_TABLE_SIZE;
+  int base2 = base * DTOA_POW5_TABLE_SIZE;
+  int offset = base2 - i;
+  uint32_t corr = (g_dtoa_pow5_inv_offsets[i / 16] >> ((i % 16) << 1)) & 3;
+
+  if (offset == 0)
+    {
+      result[0] = g_dtoa_pow5_inv_split[base][0] + corr;
+      result[1] = g_dtoa_pow5_inv_split[base][1];
+      if (result[0] < corr)
+        {
+          result[1]++;
+        }
+
+      return;
+    }
+
+  dtoa_pow5_mul(g_dtoa_pow5_inv_split[base], g_dtoa_pow5[offset],
+                DTOA_POW5BITS(base2) - DTOA_POW5BITS(i), corr, result);
+}
+
+/****************************************************************************
+ * Name: dtoa_mulshift
+ *
+ * Description:
+ *   Return (m * mul) >> j for a 128-bit mul and 64 <= j < 128.
+ *
+ ****************************************************************************/
+
+static uint64_t dtoa_mulshift(uint64_t m, FAR const uint64_t *mul, int j)
+{
+  uint64_t high0;
+  uint64_t high1;
+  uint64_t low1;
+  uint64_t sum;
+
+  dtoa_umul128(m, mul[0], &high0);
+  low1 = dtoa_umul128(m, mul[1], &high1);
+
+  sum = high0 + low1;
+  if (sum < high0)
+    {
+      high1++;
+    }
+
+  return dtoa_shiftright128(sum, high1, j - 64);
+}
+
+static bool dtoa_multiple_of_pow5(uint64_t value, int p)
+{
+  int count = 0;
+
+  while (value % 5 == 0)
+    {
+      value /= 5;
+      count++;
+    }
+
+  return count >= p;
+}
+
+static bool dtoa_multiple_of_pow2(uint64_t value, int p)
+{
+  return (value & ((1ull << p) - 1)) == 0;
+}
+
+static int dtoa_length(uint64_t v)
+{
+  int len = 1;
+
+  while (len < 19 && v >= g_dtoa_pow10[len])
+    {
+      len++;
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: dtoa_digits
+ *
+ * Description:
+ *   Write the len decimal digits of v to buf.  Blocks of eight digits are
+ *   split off first so that the rest only needs 32-bit divisions.
+ *
+ ****************************************************************************/
+
+static void dtoa_digits(uint64_t v, FAR char *buf, int len)
 {
-  int32_t exp = 0;
-  uint8_t flags = 0;
+  uint32_t lo;
   int i;
 
-  if (__builtin_signbit(x))
+  while (v > UINT32_MAX)
     {
-      flags |= DTOA_MINUS;
-      x = -x;
+      lo = (uint32_t)(v % 100000000);
+      v /= 100000000;
+
+      for (i = 0; i < 8; i++)
+        {
+          buf[--len] = '0' + lo % 10;
+          lo /= 10;
+        }
     }
 
-  if (x == 0)
+  lo = (uint32_t)v;
+  while (len > 0)
+    {
+      buf[--len] = '0' + lo % 10;
+      lo /= 10;
+    }
+}
+
+/****************************************************************************
+ * Name: dtoa_ryu
+ *
+ * Description:
+ *   The core of the Ryu algorithm (Ulf Adams, PLDI 2018): find the
+ *   shortest decimal that lies inside the rounding interval of the value
+ *   m2 * 2^e2 and, among those, the one closest to it.  Returns the
+ *   digits as an integer and the decimal exponent of the last one.
+ *
+ ****************************************************************************/
+
+static uint64_t dtoa_ryu(dtoa_bits_t ieee_mant, int ieee_exp,
+                         FAR int *exp10)
+{
+  uint64_t pow5[2];
+  uint64_t m2;
+  uint64_t mv;
+  uint64_t vr;
+  uint64_t vp;
+  uint64_t vm;
+  uint64_t output;
+  uint32_t mm_shift;
+  int32_t e2;
+  int32_t e10;
+  uint8_t last_removed = 0;
+  bool vm_trailing_zeros = false;
+  bool vr_trailing_zeros = false;
+  bool accept_bounds;
+  int removed = 0;
+
+  if (ieee_exp == 0)
     {
-      flags |= DTOA_ZERO;
-      for (i = 0; i < max_digits; i++)
-        dtoa->digits[i] = '0';
+      e2 = 1 - DTOA_EXP_BIAS - DTOA_MANT_BITS - 2;
+      m2 = ieee_mant;
     }
-  else if (isnan(x))
+  else
     {
-      flags |= DTOA_NAN;
+      e2 = ieee_exp - DTOA_EXP_BIAS - DTOA_MANT_BITS - 2;
+      m2 = ((dtoa_bits_t)1 << DTOA_MANT_BITS) | ieee_mant;
     }
-  else if (isinf(x))
+
+  accept_bounds = (m2 & 1) == 0;
+
+  /* The interval is [mv - 1 - mm_shift, mv + 2] in units of 2^e2; it is
+   * narrower below the value when the mantissa is a power of two.
+   */
+
+  mv = 4 * m2;
+  mm_shift = ieee_mant != 0 || ieee_exp <= 1;
+
+  /* Scale the interval by a power of ten so that it spans about 17
+   * decimal digits.
+   */
+
+  if (e2 >= 0)
     {
-      flags |= DTOA_INF;
+      int q = DTOA_LOG10POW2(e2) - (e2 > 3);
+      int k = DTOA_POW5BITS(q) + DTOA_POW5_BITCOUNT - 1;
+      int i = -e2 + q + k;
+
+      e10 = q;
+      dtoa_pow5_inv(q, pow5);
+      vr = dtoa_mulshift(4 * m2, pow5, i);
+      vp = dtoa_mulshift(4 * m2 + 2, pow5, i);
+      vm = dtoa_mulshift(4 * m2 - 1 - mm_shift, pow5, i);
+
+      if (q <= 21)
+        {
+          /* Only one of mp, mv and mm can be a multiple of 5, if any */
+
+          if (mv % 5 == 0)
+            {
+              vr_trailing_zeros = dtoa_multiple_of_pow5(mv, q);
+            }
+          else if (accept_bounds)
+            {
+              vm_trailing_zeros =
+                dtoa_multiple_of_pow5(mv - 1 - mm_shift, q);
+            }
+          else
+            {
+              vp -= dtoa_multiple_of_pow5(mv + 2, q);
+            }
+        }
     }
   else
     {
-      double_t y;
+      int q = DTOA_LOG10POW5(-e2) - (-e2 > 1);
+      int i = -e2 - q;
+      int k = DTOA_POW5BITS(i) - DTOA_POW5_BITCOUNT;
+      int j = q - k;
 
-      exp = MIN_MANT_EXP;
+      e10 = q + e2;
+      dtoa_pow5(i, pow5);
+      vr = dtoa_mulshift(4 * m2, pow5, j);
+      vp = dtoa_mulshift(4 * m2 + 2, pow5, j);
+      vm = dtoa_mulshift(4 * m2 - 1 - mm_shift, pow5, j);
 
-      /* Bring x within range MIN_MANT <= x < MAX_MANT while computing
-       * exponent value
-       */
+      if (q <= 1)
+        {
+          /* mv has at least q trailing zero bits, so is vr */
+
+          vr_trailing_zeros = true;
+          if (accept_bounds)
+            {
+              vm_trailing_zeros = mm_shift == 1;
+            }
+          else
+            {
+              vp--;
+            }
+        }
+      else if (q < 63)
+        {
+          vr_trailing_zeros = dtoa_multiple_of_pow2(mv, q);
+        }
+    }
 
-      if (x < MIN_MANT)
+  /* Drop digits while the interval still contains a shorter decimal */
+
+  if (vm_trailing_zeros || vr_trailing_zeros)
+    {
+      /* The rare case where exact ties and inclusive bounds matter */
+
+      while (vp / 10 > vm / 10)
         {
-          for (i = DTOA_SCALE_UP_NUM - 1; i >= 0; i--)
+          vm_trailing_zeros &= vm % 10 == 0;
+          vr_trailing_zeros &= last_removed == 0;
+          last_removed = vr % 10;
+          vr /= 10;
+          vp /= 10;
+          vm /= 10;
+          removed++;
+        }
+
+      if (vm_trailing_zeros)
+        {
+          while (vm % 10 == 0)
             {
-              y = x * g_dtoa_scale_up[i];
-              if (y < MAX_MANT)
-                {
-                  x = y;
-                  exp -= (1 << i);
-                }
+              vr_trailing_zeros &= last_removed == 0;
+              last_removed = vr % 10;
+              vr /= 10;
+              vp /= 10;
+              vm /= 10;
+              removed++;
             }
         }
-      else
+
+      if (vr_trailing_zeros && last_removed == 5 && vr % 2 == 0)
+        {
+          /* Round even if the exact number is .....50..0 */
+
+          last_removed = 4;
+        }
+
+      output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) ||
+                     last_removed >= 5);
+    }
+  else
+    {
+      bool round_up = false;
+      uint64_t vp_div;
+      uint64_t vm_div;
+      uint64_t vr_div;
+
+      /* Most values drop several digits, take two at a time first */
+
+      vp_div = vp / 100;
+      vm_div = vm / 100;
+      if (vp_div > vm_div)
+        {
+          vr_div   = vr / 100;
+          round_up = vr - 100 * vr_div >= 50;
+          vr       = vr_div;
+          vp       = vp_div;
+          vm       = vm_div;
+          removed += 2;
+        }
+
+      for (; ; )
         {
-          for (i = DTOA_SCALE_DOWN_NUM - 1; i >= 0; i--)
+          vp_div = vp / 10;
+          vm_div = vm / 10;
+          if (vp_div <= vm_div)
             {
-              y = x * g_dtoa_scale_down[i];
-              if (y >= MIN_MANT)
-                {
-                  x = y;
-                  exp += (1 << i);
-                }
+              break;
             }
+
+          vr_div   = vr / 10;
+          round_up = vr - 10 * vr_div >= 5;
+          vr       = vr_div;
+          vp       = vp_div;
+          vm       = vm_div;
+          removed++;
+        }
+
+      output = vr + (vr == vm || round_up);
+    }
+
+  *exp10 = e10 + removed;
+  return output;
+}
+
+/****************************************************************************
+ * Name: dtoa_bigint_*
+ *
+ * Description:
+ *   The few big integer operations needed by dtoa_exact().
+ *
+ ****************************************************************************/
+
+static void dtoa_bigint_set(FAR struct dtoa_bigint_s *b, uint64_t v)
+{
+  b->word[0] = (uint32_t)v;
+  b->word[1] = (uint32_t)(v >> 32);
+  b->len     = b->word[1] != 0 ? 2 : 1;
+}
+
+static void dtoa_bigint_mul(FAR struct dtoa_bigint_s *b, uint32_t m)
+{
+  uint64_t carry = 0;
+  int i;
+
+  for (i = 0; i < b->len; i++)
+    {
+      carry     += (uint64_t)b->word[i] * m;
+      b->word[i] = (uint32_t)carry;
+      carry    >>= 32;
+    }
+
+  if (carry != 0)
+    {
+      b->word[b->len++] = (uint32_t)carry;
+    }
+}
+
+static void dtoa_bigint_mul_pow10(FAR struct dtoa_bigint_s *b, int n)
+{
+  for (; n >= 9; n -= 9)
+    {
+      dtoa_bigint_mul(b, 1000000000);
+    }
+
+  if (n > 0)
+    {
+      dtoa_bigint_mul(b, (uint32_t)g_dtoa_pow10[n]);
+    }
+}
+
+static void dtoa_bigint_shl(FAR struct dtoa_bigint_s *b, int n)
+{
+  int words = n / 32;
+  int bits = n % 32;
+  int i;
+
+  if (bits != 0)
+    {
+      uint32_t top = b->word[b->len - 1] >> (32 - bits);
+
+      for (i = b->len - 1; i > 0; i--)
+        {
+          b->word[i] = (b->word[i] << bits) |
+                       (b->word[i - 1] >> (32 - bits));
+        }
+
+      b->word[0] <<= bits;
+      if (top != 0)
+        {
+          b->word[b->len++] = top;
+        }
+    }
+
+  if (words != 0)
+    {
+      for (i = b->len - 1; i >= 0; i--)
+        {
+          b->word[i + words] = b->word[i];
+        }
+
+      memset(b->word, 0, words * sizeof(uint32_t));
+      b->len += words;
+    }
+}
+
+static int dtoa_bigint_cmp(FAR const struct dtoa_bigint_s *a,
+                           FAR const struct dtoa_bigint_s *b)
+{
+  int i;
+
+  if (a->len != b->len)
+    {
+      return a->len > b->len ? 1 : -1;
+    }
+
+  for (i = a->len - 1; i >= 0; i--)
+    {
+      if (a->word[i] != b->word[i])
+        {
+          return a->word[i] > b->word[i] ? 1 : -1;
+        }
+    }
+
+  return 0;
+}
+
+static void dtoa_bigint_sub(FAR struct dtoa_bigint_s *a,
+                            FAR const struct dtoa_bigint_s *b)
+{
+  int64_t borrow = 0;
+  int i;
+
+  for (i = 0; i < a->len; i++)
+    {
+      borrow    += (int64_t)a->word[i] - (i < b->len ? b->word[i] : 0);
+      a->word[i] = (uint32_t)borrow;
+      borrow   >>= 32;
+    }
+
+  while (a->len > 1 && a->word[a->len - 1] == 0)
+    {
+      a->len--;
+    }
+}
+
+/****************************************************************************
+ * Name: dtoa_bigint_digit
+ *
+ * Description:
+ *   Take the next decimal digit out of r / s, which must be below 10, and
+ *   move on to the following one.
+ *
+ ****************************************************************************/
+
+static char dtoa_bigint_digit(FAR struct dtoa_bigint_s *r,
+                              FAR const struct dtoa_bigint_s *s)
+{
+  char digit = '0';
+
+  while (dtoa_bigint_cmp(r, s) >= 0)
+    {
+      dtoa_bigint_sub(r, s);
+      digit++;
+    }
+
+  dtoa_bigint_mul(r, 10);
+  return digit;
+}
+
+/****************************************************************************
+ * Name: dtoa_scale
+ *
+ * Description:
+ *   Set r / s to x / 10^exp10, where x is given by its IEEE fields and
+ *   exp10 is the decimal exponent of its leading digit, possibly one too
+ *   large.  Returns the exact exponent, with r / s between 1 and 10.
+ *
+ ****************************************************************************/
+
+static int dtoa_scale(FAR struct dtoa_bigint_s *r,
+                      FAR struct dtoa_bigint_s *s,
+                      dtoa_bits_t mant, int ieee_exp, int exp10)
+{
+  int e2;
+
+  if (ieee_exp == 0)
+    {
+      e2 = 1 - DTOA_EXP_BIAS - DTOA_MANT_BITS;
+    }
+  else
+    {
+      e2    = ieee_exp - DTOA_EXP_BIAS - DTOA_MANT_BITS;
+      mant |= (dtoa_bits_t)1 << DTOA_MANT_BITS;
+    }
+
+  /* r / s = mant * 2^e2 / 10^exp10 */
+
+  dtoa_bigint_set(r, mant);
+  dtoa_bigint_set(s, 1);
+
+  if (e2 >= 0)
+    {
+      dtoa_bigint_shl(r, e2);
+    }
+  else
+    {
+      dtoa_bigint_shl(s, -e2);
+    }
+
+  if (exp10 >= 0)
+    {
+      dtoa_bigint_mul_pow10(s, exp10);
+    }
+  else
+    {
+      dtoa_bigint_mul_pow10(r, -exp10);
+    }
+
+  if (dtoa_bigint_cmp(r, s) < 0)
+    {
+      dtoa_bigint_mul(r, 10);
+      exp10--;
+    }
+
+  return exp10;
+}
+
+/****************************************************************************
+ * Name: dtoa_exact
+ *
+ * Description:
+ *   Generate correctly rounded digits of x with big integer arithmetic.
+ *   This is only needed when the shortest digits cannot be rounded or
+ *   padded to the request: ties, subnormals and requests for more than
+ *   DBL_DIG digits, up to the whole expansion of x.  Digits past
+ *   DTOA_MAX_DIG are only counted here, __dtoa_tail() produces them.
+ *
+ ****************************************************************************/
+
+static int dtoa_exact(dtoa_bits_t mant, int ieee_exp, int exp10,
+                      FAR struct dtoa_s *dtoa, int max_digits,
+                      int max_decimals)
+{
+  struct dtoa_bigint_s r;
+  struct dtoa_bigint_s s;
+  char digit = '0';
+  int nonzero = 0;
+  int last = -1;
+  int ndigits;
+  int cmp;
+  int i;
+
+  exp10 = dtoa_scale(&r, &s, mant, ieee_exp, exp10);
+
+  ndigits = max_digits;
+  if (max_decimals >= 0)
+    {
+      ndigits = MIN(ndigits, max_decimals + exp10 + 1);
+    }
+
+  if (ndigits <= 0)
+    {
+      /* Everything is below the last decimal place: the result is either
+       * zero or one unit in that place.  Exactly half rounds to even zero.
+       */
+
+      dtoa_bigint_mul(&s, 5);
+      if (ndigits < 0 || dtoa_bigint_cmp(&r, &s) <= 0)
+        {
+          dtoa->digits[0] = '0';
+          dtoa->exp       = 0;
+          dtoa->flags    |= DTOA_ZERO;
+        }
+      else
+        {
+          dtoa->digits[0] = '1';
+          dtoa->exp       = -max_decimals;
+        }
+
+      dtoa->digits[1] = '\0';
+      return 1;
+    }
+
+  /* Keep track of the last digit other than 0, where the digits end if
+   * they are truncated, and of the last one other than 9, where they end
+   * if they are rounded up.
+   */
+
+  for (i = 0; i < ndigits; i++)
+    {
+      digit = dtoa_bigint_digit(&r, &s);
+      if (i < DTOA_MAX_DIG)
+        {
+          dtoa->digits[i] = digit;
+        }
+
+      if (digit != '0')
+        {
+          nonzero = i;
+        }
+
+      if (digit != '9')
+        {
+          last = i;
+        }
+
+      if (r.len == 1 && r.word[0] == 0)
+        {
+          /* The expansion ended: the remaining digits are all zeros */
+
+          break;
+        }
+    }
+
+  /* Round half to even on the remainder, now ten times r / s */
+
+  dtoa_bigint_mul(&s, 5);
+  cmp = dtoa_bigint_cmp(&r, &s);
+  if (i < ndigits || cmp < 0 || (cmp == 0 && (digit & 1) == 0))
+    {
+      ndigits = nonzero + 1;
+    }
+  else if (last < 0)
+    {
+      dtoa->digits[0] = '1';
+      exp10++;
+      ndigits = 1;
+    }
+  else
+    {
+      ndigits = last + 1;
+      if (last < DTOA_MAX_DIG)
+        {
+          dtoa->digits[last]++;
+        }
+      else
+        {
+          dtoa->flags |= DTOA_CARRY;
         }
+    }
+
+  dtoa->digits[MIN(ndigits, DTOA_MAX_DIG)] = '\0';
+  dtoa->exp = exp10;
+  return ndigits;
+}
+
+/****************************************************************************
+ * Name: dtoa_decompose
+ *
+ * Description:
+ *   Split x into its IEEE fields, filling in the flags for sign, zero,
+ *   infinity and NaN.  Returns true if x is finite and not zero.
+ *
+ ****************************************************************************/
+
+static bool dtoa_decompose(double_t x, FAR struct dtoa_s *dtoa,
+                           FAR dtoa_bits_t *mant, FAR int *exp)
+{
+  dtoa_bits_t bits;
+
+  memcpy(&bits, &x, sizeof(bits));
+
+  *mant = bits & (((dtoa_bits_t)1 << DTOA_MANT_BITS) - 1);
+  *exp  = (bits >> DTOA_MANT_BITS) & DTOA_EXP_MASK;
+
+  dtoa->flags = 0;
+  dtoa->exp   = 0;
+
+  if ((bits >> (DTOA_MANT_BITS + DTOA_EXP_BITS)) != 0)
+    {
+      dtoa->flags |= DTOA_MINUS;
+    }
+
+  if (*exp == DTOA_EXP_MASK)
+    {
+      dtoa->flags |= *mant != 0 ? DTOA_NAN : DTOA_INF;
+      return false;
+    }
+
+  if (*exp == 0 && *mant == 0)
+    {
+      dtoa->flags |= DTOA_ZERO;
+      return false;
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: __dtoa_shortest
+ ****************************************************************************/
+
+int __dtoa_shortest(double_t x, FAR struct dtoa_s *dtoa)
+{
+  dtoa_bits_t mant;
+  uint64_t output;
+  int ieee_exp;
+  int exp10;
+  int olen;
+
+  if (!dtoa_decompose(x, dtoa, &mant, &ieee_exp))
+    {
+      dtoa->digits[0] = '0';
+      dtoa->digits[1] = '\0';
+      return 1;
+    }
+
+  output = dtoa_ryu(mant, ieee_exp, &exp10);
+  olen   = dtoa_length(output);
+
+  dtoa_digits(output, dtoa->digits, olen);
+
+  dtoa->digits[olen] = '\0';
+  dtoa->exp = exp10 + olen - 1;
+  return olen;
+}
+
+/****************************************************************************
+ * Name: __dtoa_engine
+ ****************************************************************************/
+
+int __dtoa_engine(double_t x, FAR struct dtoa_s *dtoa, int max_digits,
+                  int max_decimals)
+{
+  dtoa_bits_t mant;
+  uint64_t output;
+  int ieee_exp;
+  int exp10;
+  int olen;
+  int ndigits;
+
+  if (!dtoa_decompose(x, dtoa, &mant, &ieee_exp))
+    {
+      ndigits = (dtoa->flags & DTOA_ZERO) != 0 ? 1 : 0;
+      dtoa->digits[0] = '0';
+      dtoa->digits[ndigits] = '\0';
+      return ndigits;
+    }
+
+  /* Start from the shortest digits that identify x */
+
+  output = dtoa_ryu(mant, ieee_exp, &exp10);
+  olen   = dtoa_length(output);
+  exp10 += olen - 1;
 
-      /* If limiting decimals, then limit the max digits to no more than the
-       * number of digits left of the decimal plus the number of digits right
-       * of the decimal
+  ndigits = max_digits;
+  if (max_decimals >= 0)
+    {
+      ndigits = MIN(ndigits, max_decimals + exp10 + 1);
+    }
+
+  if (ndigits >= olen)
+    {
+      /* Padding the shortest digits with zeros is exact unless the zeros
+       * would stand for digits finer than the precision of x.  When x is a
+       * power of two, the interval below it is narrower and the closest
+       * decimal of the same length may have been rejected for lying just
+       * outside it.
        */
 
-      if (max_decimals != 0)
+      if (ndigits > olen && (ndigits > DBL_DIG || ieee_exp == 0))
         {
-          max_digits = MIN(max_digits, max_decimals + MAX(exp + 1, 1));
+          goto exact;
         }
 
-      /* Round nearest by adding 1/2 of the last digit before converting to
-       * int. Check for overflow and adjust mantissa and exponent values
+      if (ndigits == olen && mant == 0 && ieee_exp > 1)
+        {
+          goto exact;
+        }
+    }
+  else if (ndigits > 0)
+    {
+      /* Rounding the shortest digits gives the same result as rounding x
+       * itself, except when they end exactly on a half: then x may lie on
+       * either side of it.
        */
 
-      x = x + g_dtoa_round[max_digits];
+      uint64_t scale = g_dtoa_pow10[olen - ndigits];
+      uint64_t rem = output % scale;
 
-      if (x >= MAX_MANT)
+      if (rem == scale / 2)
         {
-          x /= 10.0;
-          exp++;
+          goto exact;
         }
 
-      /* Now convert mantissa to decimal. */
+      output /= scale;
+      if (rem > scale / 2)
+        {
+          output++;
+          if (output == g_dtoa_pow10[ndigits])
+            {
+              output /= 10;
+              exp10++;
+            }
+        }
 
-      uint64_t mant = (uint64_t) x;
-      uint64_t decimal = MIN_MANT_INT;
+      olen = ndigits;
+    }
+  else
+    {
+      /* All digits are below the last decimal place.  Only a leading digit
+       * just one place below it can round up to a unit in that place.
+       */
 
-      /* Compute digits */
+      if (ndigits == 0 && output == 5 * g_dtoa_pow10[olen - 1])
+        {
+          goto exact;
+        }
 
-      for (i = 0; i < max_digits; i++)
+      if (ndigits == 0 && output > 5 * g_dtoa_pow10[olen - 1])
+        {
+          output = 1;
+          exp10  = -max_decimals;
+        }
+      else
         {
-          dtoa->digits[i] = mant / decimal + '0';
-          mant %= decimal;
-          decimal /= 10;
+          output = 0;
+          exp10  = 0;
+          dtoa->flags |= DTOA_ZERO;
         }
+
+      olen = 1;
+    }
+
+  while (olen > 1 && output % 10 == 0)
+    {
+      output /= 10;
+      olen--;
     }
 
-  dtoa->digits[max_digits] = '\0';
-  dtoa->flags = flags;
-  dtoa->exp = exp;
-  return max_digits;
+  dtoa_digits(output, dtoa->digits, olen);
+
+  dtoa->digits[olen] = '\0';
+  dtoa->exp = exp10;
+  return olen;
+
+exact:
+  return dtoa_exact(mant, ieee_exp, exp10, dtoa, max_digits, max_decimals);
+}
+
+/****************************************************************************
+ * Name: __dtoa_tail
+ ****************************************************************************/
+
+void __dtoa_tail(double_t x, FAR const struct dtoa_s *dtoa, int ndigits,
+                 int first, int count, FAR struct lib_outstream_s *stream)
+{
+  struct dtoa_bigint_s r;
+  struct dtoa_bigint_s s;
+  dtoa_bits_t bits;
+  char chunk[DTOA_TAIL_CHUNK];
+  int end = first + count;
+  int n = 0;
+  int i;
+
+  /* Run the generation of dtoa_exact() again, this time writing out the
+   * digits that did not fit in dtoa->digits.
+   */
+
+  memcpy(&bits, &x, sizeof(bits));
+  dtoa_scale(&r, &s, bits & (((dtoa_bits_t)1 << DTOA_MANT_BITS) - 1),
+             (bits >> DTOA_MANT_BITS) & DTOA_EXP_MASK, dtoa->exp);
+
+  for (i = 0; i < end; i++)
+    {
+      char digit = dtoa_bigint_digit(&r, &s);
+
+      if (i < first)
+        {
+          continue;
+        }
+
+      if (i == ndigits - 1 && (dtoa->flags & DTOA_CARRY) != 0)
+        {
+          digit++;
+        }
+
+      chunk[n++] = digit;
+      if (n == DTOA_TAIL_CHUNK || i == end - 1)
+        {
+          if (stream->puts != NULL)
+            {
+              stream->puts(stream, chunk, n);
+            }
+          else
+            {
+              int j;
+
+              for (j = 0; j < n; j++)
+                {
+                  stream->put(stream, chunk[j]);
+                }
+            }
+
+          n = 0;
+        }
+    }
 }
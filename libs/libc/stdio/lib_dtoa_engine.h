@@ -40,6 +40,8 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+
 #include <sys/types.h>
 #include <stdint.h>
 #include <float.h>
@@ -50,118 +52,37 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define DTOA_MAX_DIG        DBL_DIG
-
-#define DTOA_MINUS          1
-#define DTOA_ZERO           2
-#define DTOA_INF            4
-#define DTOA_NAN            8
-#define DTOA_CARRY          16    /* Carry was to master position. */
-
-#if DBL_MAX_10_EXP >= 1 && DBL_MAX_10_EXP < 2
-#  define DTOA_SCALE_UP_NUM 1
-#endif
-#if DBL_MAX_10_EXP >= 2 && DBL_MAX_10_EXP < 4
-#  define DTOA_SCALE_UP_NUM 2
-#endif
-#if DBL_MAX_10_EXP >= 4 && DBL_MAX_10_EXP < 8
-#  define DTOA_SCALE_UP_NUM 3
-#endif
-#if DBL_MAX_10_EXP >= 8 && DBL_MAX_10_EXP < 16
-#  define DTOA_SCALE_UP_NUM 4
-#endif
-#if DBL_MAX_10_EXP >= 16 && DBL_MAX_10_EXP < 32
-#  define DTOA_SCALE_UP_NUM 5
-#endif
-#if DBL_MAX_10_EXP >= 32 && DBL_MAX_10_EXP < 64
-#  define DTOA_SCALE_UP_NUM 6
-#endif
-#if DBL_MAX_10_EXP >= 64 && DBL_MAX_10_EXP < 128
-#  define DTOA_SCALE_UP_NUM 7
-#endif
-#if DBL_MAX_10_EXP >= 128 && DBL_MAX_10_EXP < 256
-#  define DTOA_SCALE_UP_NUM 8
-#endif
-#if DBL_MAX_10_EXP >= 256 && DBL_MAX_10_EXP < 512
-#  define DTOA_SCALE_UP_NUM 9
-#endif
-#if DBL_MAX_10_EXP >= 512 && DBL_MAX_10_EXP < 1024
-#  define DTOA_SCALE_UP_NUM 10
-#endif
-#if DBL_MAX_10_EXP >= 1024 && DBL_MAX_10_EXP < 2048
-#  define DTOA_SCALE_UP_NUM 11
-#endif
-#if DBL_MAX_10_EXP >= 2048 && DBL_MAX_10_EXP < 4096
-#  define DTOA_SCALE_UP_NUM 12
-#endif
-#if DBL_MAX_10_EXP >= 4096 && DBL_MAX_10_EXP < 8192
-#  define DTOA_SCALE_UP_NUM 13
-#endif
-#if DBL_MAX_10_EXP >= 8192 && DBL_MAX_10_EXP < 16384
-#  define DTOA_SCALE_UP_NUM 14
-#endif
-#if DBL_MAX_10_EXP >= 16384 && DBL_MAX_10_EXP < 32768
-#  define DTOA_SCALE_UP_NUM 15
-#endif
-#if DBL_MAX_10_EXP >= 32768 && DBL_MAX_10_EXP < 65536
-#  define DTOA_SCALE_UP_NUM 16
-#endif
-#if DBL_MAX_10_EXP >= 65536 && DBL_MAX_10_EXP < 131072
-#  define DTOA_SCALE_UP_NUM 17
-#endif
-#if DBL_MIN_10_EXP <= -1 && DBL_MIN_10_EXP > -2
-#  define DTOA_SCALE_DOWN_NUM 1
-#endif
-#if DBL_MIN_10_EXP <= -2 && DBL_MIN_10_EXP > -4
-#  define DTOA_SCALE_DOWN_NUM 2
-#endif
-#if DBL_MIN_10_EXP <= -4 && DBL_MIN_10_EXP > -8
-#  define DTOA_SCALE_DOWN_NUM 3
-#endif
-#if DBL_MIN_10_EXP <= -8 && DBL_MIN_10_EXP > -16
-#  define DTOA_SCALE_DOWN_NUM 4
-#endif
-#if DBL_MIN_10_EXP <= -16 && DBL_MIN_10_EXP > -32
-#  define DTOA_SCALE_DOWN_NUM 5
-#endif
-#if DBL_MIN_10_EXP <= -32 && DBL_MIN_10_EXP > -64
-#  define DTOA_SCALE_DOWN_NUM 6
-#endif
-#if DBL_MIN_10_EXP <= -64 && DBL_MIN_10_EXP > -128
-#  define DTOA_SCALE_DOWN_NUM 7
-#endif
-#if DBL_MIN_10_EXP <= -128 && DBL_MIN_10_EXP > -256
-#  define DTOA_SCALE_DOWN_NUM 8
-#endif
-#if DBL_MIN_10_EXP <= -256 && DBL_MIN_10_EXP > -512
-#  define DTOA_SCALE_DOWN_NUM 9
-#endif
-#if DBL_MIN_10_EXP <= -512 && DBL_MIN_10_EXP > -1024
-#  define DTOA_SCALE_DOWN_NUM 10
-#endif
-#if DBL_MIN_10_EXP <= -1024 && DBL_MIN_10_EXP > -2048
-#  define DTOA_SCALE_DOWN_NUM 11
-#endif
-#if DBL_MIN_10_EXP <= -2048 && DBL_MIN_10_EXP > -4096
-#  define DTOA_SCALE_DOWN_NUM 12
-#endif
-#if DBL_MIN_10_EXP <= -4096 && DBL_MIN_10_EXP > -8192
-#  define DTOA_SCALE_DOWN_NUM 13
-#endif
-#if DBL_MIN_10_EXP <= -8192 && DBL_MIN_10_EXP > -16384
-#  define DTOA_SCALE_DOWN_NUM 14
-#endif
-#if DBL_MIN_10_EXP <= -16384 && DBL_MIN_10_EXP > -32768
-#  define DTOA_SCALE_DOWN_NUM 15
-#endif
-#if DBL_MIN_10_EXP <= -32768 && DBL_MIN_10_EXP > -65536
-#  define DTOA_SCALE_DOWN_NUM 16
-#endif
-#if DBL_MIN_10_EXP <= -65536 && DBL_MIN_10_EXP > -131072
-#  define DTOA_SCALE_DOWN_NUM 17
-#endif
-
-#define DTOA_ROUND_NUM        (DBL_DIG + 1)
+/* The decimal expansion of a binary floating point number is finite, but
+ * long: up to 767 significant digits for a double and 112 for a float.
+ * Only the leading DTOA_MAX_DIG digits, which cover the shortest digits
+ * of any value with room to spare, are kept in struct dtoa_s.  The rare
+ * requests for more are served by __dtoa_tail(), which regenerates the
+ * rest straight into the output stream.
+ */
+
+#ifdef CONFIG_HAVE_DOUBLE
+#  define DTOA_MAX_DIG        32
+#else
+#  define DTOA_MAX_DIG        16
+#endif
+
+#define DTOA_MINUS            1
+#define DTOA_ZERO             2
+#define DTOA_INF              4
+#define DTOA_NAN              8
+#define DTOA_CARRY            16  /* Last digit, past digits[], rounds up */
+
+/* The shortest conversion needs 125-bit approximations of 5^i and 5^-i.
+ * Rather than storing all of them, every 26th power is kept and the rest
+ * are rebuilt by multiplying with a 64-bit 5^j, adding a 2-bit correction
+ * so that the result is exactly what a full table would have held.
+ */
+
+#define DTOA_POW5_TABLE_SIZE  26
+#define DTOA_POW5_SPLIT_SIZE  13
+#define DTOA_POW5_BITCOUNT    125
+#define DTOA_POW5_NUM         326  /* 5^0 .. 5^325 */
+#define DTOA_POW5_INV_NUM     291  /* 5^-0 .. 5^-290 */
 
 /****************************************************************************
  * Public Types
@@ -174,19 +95,59 @@ struct dtoa_s
   char digits[DTOA_MAX_DIG + 1];
 };
 
+struct lib_outstream_s;  /* Forward reference */
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
-extern const double_t g_dtoa_scale_up[];
-extern const double_t g_dtoa_scale_down[];
-extern const double_t g_dtoa_round[];
+extern const uint64_t g_dtoa_pow5[DTOA_POW5_TABLE_SIZE];
+extern const uint64_t g_dtoa_pow5_split[DTOA_POW5_SPLIT_SIZE][2];
+extern const uint64_t g_dtoa_pow5_inv_split[DTOA_POW5_SPLIT_SIZE][2];
+extern const uint32_t g_dtoa_pow5_offsets[];
+extern const uint32_t g_dtoa_pow5_inv_offsets[];
 
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: __dtoa_shortest
+ *
+ * Description:
+ *   Convert x to the shortest string of decimal digits that reads back as
+ *   exactly x, using the Ryu algorithm.  Returns the number of digits.
+ *
+ ****************************************************************************/
+
+int __dtoa_shortest(double_t x, FAR struct dtoa_s *dtoa);
+
+/****************************************************************************
+ * Name: __dtoa_engine
+ *
+ * Description:
+ *   Convert x to at most max_digits correctly rounded significant digits.
+ *   If max_decimals is not negative, the digits are also limited so that
+ *   none falls below the max_decimals'th place after the decimal point.
+ *   Returns the number of digits up to the last nonzero one; the caller
+ *   pads with zeros.  Only the first DTOA_MAX_DIG of them are stored in
+ *   dtoa->digits, the others are written by __dtoa_tail().
+ *
+ ****************************************************************************/
+
 int __dtoa_engine(double_t x, FAR struct dtoa_s *dtoa, int max_digits,
                   int max_decimals);
 
+/****************************************************************************
+ * Name: __dtoa_tail
+ *
+ * Description:
+ *   Write count digits of the ndigits returned by __dtoa_engine() for x,
+ *   starting at first (not below DTOA_MAX_DIG), to stream.
+ *
+ ****************************************************************************/
+
+void __dtoa_tail(double_t x, FAR const struct dtoa_s *dtoa, int ndigits,
+                 int first, int count, FAR struct lib_outstream_s *stream);
+
 #endif /* __LIBS_LIBC_STDIO_LIB_DTOA_ENGINE_H */
@@ -0,0 +1,99 @@
+/****************************************************************************
+ * libs/libc/stdio/lib_dtoa_test.c
+ * Unit test driver for the floating point conversions of lib_vsprintf().
+ * It is not part of the build: compile it as a program together with the
+ * stdio sources (for example in the simulator) and run it.  It returns
+ * EXIT_SUCCESS if every vector matches.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct dtoa_testvec_s
+{
+  FAR const char *format;
+  double value;
+  FAR const char *result;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Correctly rounded results.  Most of them need more significant digits
+ * than the shortest representation of the value has.
+ */
+
+static const struct dtoa_testvec_s g_dtoa_testvec[] =
+{
+  { "%f", 40331360842381.38, "40331360842381.382812" },
+  { "%05.23f", 51.639186295503215, "51.63918629550321526266998" },
+  { "%-10.19g", 2014612314.851607, "2014612314.851607084" },
+  { "%028.17E", 9.49285634690637e-39, "000009.49285634690637041E-39" },
+  { "%.20f", 0.1, "0.10000000000000000555" },
+  { "%.30e", 0.3333333333333333, "3.333333333333333148296162562474e-01" },
+  { "%.25g", 0.6666666666666666, "0.6666666666666666296592325" },
+  { "%.0f", 1.2676506002282294e30, "1267650600228229401496703205376" },
+  { "%.60f", 8.673617379884035e-19,
+    "0.000000000000000000867361737988403547205962240695953369140625" },
+  { "%.30e", 5e-324, "4.940656458412465441765687928682e-324" },
+  { "%.38e", 0.6666666666666666,
+    "6.66666666666666629659232512494781985879e-01" },
+  { "%.0f", 1.329227995784916e36, "1329227995784915872903807060280344576" },
+  { "%.3f", 0.0005, "0.001" },
+  { "%.17g", 0.1, "0.10000000000000001" },
+};
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, FAR char *argv[])
+{
+  FAR const struct dtoa_testvec_s *vec;
+  char buffer[128];
+  int failed = 0;
+  int i;
+
+  for (i = 0; i < sizeof(g_dtoa_testvec) / sizeof(g_dtoa_testvec[0]); i++)
+    {
+      vec = &g_dtoa_testvec[i];
+      snprintf(buffer, sizeof(buffer), vec->format, vec->value);
+      if (strcmp(buffer, vec->result) != 0)
+        {
+          printf("FAILED %s of %a: \"%s\", expected \"%s\"\n",
+                 vec->format, vec->value, buffer, vec->result);
+          failed++;
+        }
+    }
+
+  printf("%d of %d vectors failed\n", failed, i);
+  return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
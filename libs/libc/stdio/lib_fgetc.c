@@ -37,7 +37,13 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+
 #include <stdio.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+
 #include "libc.h"
 
 /****************************************************************************
@@ -45,15 +51,33 @@
  ****************************************************************************/
 
 /****************************************************************************
- * fgetc
+ * Name: fgetc_unlocked
+ *
+ * Description:
+ *   fgetc() without taking the stream lock; the caller holds it through
+ *   flockfile() or does not share the stream.  Read-ahead data is returned
+ *   straight from the buffer.
+ *
  ****************************************************************************/
 
-int fgetc(FAR FILE *stream)
+int fgetc_unlocked(FAR FILE *stream)
 {
   unsigned char ch;
   ssize_t ret;
 
-  ret = lib_fread(&ch, 1, stream);
+#ifndef CONFIG_STDIO_DISABLE_BUFFERING
+#  if CONFIG_NUNGET_CHARS > 0
+  if (stream != NULL && stream->fs_nungotten == 0 &&
+      stream->fs_bufpos < stream->fs_bufread)
+#  else
+  if (stream != NULL && stream->fs_bufpos < stream->fs_bufread)
+#  endif
+    {
+      return *stream->fs_bufpos++;
+    }
+#endif
+
+  ret = lib_fread_unlocked(&ch, 1, stream);
   if (ret > 0)
     {
       return ch;
@@ -63,3 +87,24 @@ int fgetc(FAR FILE *stream)
       return EOF;
     }
 }
+
+/****************************************************************************
+ * Name: fgetc
+ ****************************************************************************/
+
+int fgetc(FAR FILE *stream)
+{
+  int ret;
+
+  if (stream == NULL)
+    {
+      set_errno(EBADF);
+      return EOF;
+    }
+
+  lib_take_semaphore(stream);
+  ret = fgetc_unlocked(stream);
+  lib_give_semaphore(stream);
+
+  return ret;
+}
@@ -0,0 +1,78 @@
+/****************************************************************************
+ * libs/libc/stdio/lib_flockfile.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: flockfile
+ *
+ * Description:
+ *   Acquire ownership of the stream so that a sequence of *_unlocked()
+ *   calls is atomic with respect to other threads.  The lock is
+ *   recursive; each flockfile() must be balanced by funlockfile().
+ *
+ ****************************************************************************/
+
+void flockfile(FAR FILE *stream)
+{
+  lib_take_semaphore(stream);
+}
+
+/****************************************************************************
+ * Name: ftrylockfile
+ *
+ * Description:
+ *   Non-blocking flockfile().  Returns zero if the lock was acquired and
+ *   non-zero if another thread holds it.
+ *
+ ****************************************************************************/
+
+int ftrylockfile(FAR FILE *stream)
+{
+  return lib_trytake_semaphore(stream);
+}
+
+/****************************************************************************
+ * Name: funlockfile
+ *
+ * Description:
+ *   Release one reference to the stream lock taken by flockfile() or
+ *   ftrylockfile().
+ *
+ ****************************************************************************/
+
+void funlockfile(FAR FILE *stream)
+{
+  lib_give_semaphore(stream);
+}
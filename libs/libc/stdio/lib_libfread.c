@@ -55,10 +55,14 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: lib_fread
+ * Name: lib_fread_unlocked
+ *
+ * Description:
+ *   lib_fread() for a caller that already holds the stream lock.
+ *
  ****************************************************************************/
 
-ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
+ssize_t lib_fread_unlocked(FAR void *ptr, size_t count, FAR FILE *stream)
 {
   FAR unsigned char *dest  = (FAR unsigned char*)ptr;
   ssize_t bytes_read;
@@ -76,10 +80,6 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
     }
   else
     {
-      /* The stream must be stable until we complete the read */
-
-      lib_take_semaphore(stream);
-
 #if CONFIG_NUNGET_CHARS > 0
       /* First, re-read any previously ungotten characters */
 
@@ -112,7 +112,6 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
           ret = lib_wrflush(stream);
           if (ret < 0)
             {
-              lib_give_semaphore(stream);
               return ret;
             }
 
@@ -122,12 +121,21 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
             {
               /* Is there readable data in the buffer? */
 
-              while (remaining > 0 && stream->fs_bufpos < stream->fs_bufread)
+              size_t avail = stream->fs_bufread - stream->fs_bufpos;
+
+              if (avail > 0)
                 {
-                  /* Yes, copy a byte into the user buffer */
+                  /* Yes, copy it into the user buffer */
 
-                  *dest++ = *stream->fs_bufpos++;
-                  remaining--;
+                  if (avail > remaining)
+                    {
+                      avail = remaining;
+                    }
+
+                  memcpy(dest, stream->fs_bufpos, avail);
+                  stream->fs_bufpos += avail;
+                  dest              += avail;
+                  remaining         -= avail;
                 }
 
               /* The buffer is empty OR we have already supplied the number of
@@ -155,7 +163,7 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
                    * directly into the user's buffer.
                    */
 
-                  if (remaining > buffer_available)
+                  if (remaining >= buffer_available)
                     {
                       bytes_read = _NX_READ(stream->fs_fd, dest, remaining);
                       if (bytes_read < 0)
@@ -280,8 +288,6 @@ shortread:
         {
           stream->fs_flags |= __FS_FLAG_EOF;
         }
-
-      lib_give_semaphore(stream);
     }
 
   return count - remaining;
@@ -290,6 +296,28 @@ shortread:
 
 errout_with_errno:
   stream->fs_flags |= __FS_FLAG_ERROR;
-  lib_give_semaphore(stream);
   return -get_errno();
 }
+
+/****************************************************************************
+ * Name: lib_fread
+ ****************************************************************************/
+
+ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
+{
+  ssize_t ret;
+
+  if (stream == NULL)
+    {
+      set_errno(EBADF);
+      return ERROR;
+    }
+
+  /* The stream must be stable until we complete the read */
+
+  lib_take_semaphore(stream);
+  ret = lib_fread_unlocked(ptr, count, stream);
+  lib_give_semaphore(stream);
+
+  return ret;
+}
@@ -42,6 +42,7 @@
 #include <sys/types.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
@@ -50,21 +51,61 @@
 
 #include "libc.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_fwrite_direct
+ *
+ * Description:
+ *   Write the user data straight to the file, retrying short writes.
+ *   Returns the number of bytes written or ERROR if nothing was written.
+ *
+ ****************************************************************************/
+
+static ssize_t lib_fwrite_direct(FAR const unsigned char *src, size_t count,
+                                 FAR FILE *stream)
+{
+  size_t nwritten = 0;
+  ssize_t ret;
+
+  while (nwritten < count)
+    {
+      ret = _NX_WRITE(stream->fs_fd, src + nwritten, count - nwritten);
+      if (ret < 0)
+        {
+          _NX_SETERRNO(ret);
+          return nwritten > 0 ? (ssize_t)nwritten : ERROR;
+        }
+
+      nwritten += ret;
+    }
+
+  return nwritten;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: lib_fwrite
+ * Name: lib_fwrite_unlocked
+ *
+ * Description:
+ *   lib_fwrite() for a caller that already holds the stream lock.  Writes
+ *   at least as large as the buffer bypass it once the data already
+ *   buffered has been flushed.
+ *
  ****************************************************************************/
 
-ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
+ssize_t lib_fwrite_unlocked(FAR const void *ptr, size_t count,
+                            FAR FILE *stream)
 #ifndef CONFIG_STDIO_DISABLE_BUFFERING
 {
   FAR const unsigned char *start = ptr;
   FAR const unsigned char *src   = ptr;
   ssize_t ret = ERROR;
-  unsigned char *dest;
 
   /* Make sure that writing to this stream is allowed */
 
@@ -85,22 +126,10 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
   /* If there is no I/O buffer, then output data immediately */
 
   if (stream->fs_bufstart == NULL)
-   {
-     ret = _NX_WRITE(stream->fs_fd, ptr, count);
-#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
-     if (ret < 0)
-       {
-         _NX_SETERRNO((int)-ret);
-         ret = ERROR;
-       }
-#endif
-
-     goto errout;
-   }
-
-  /* Get exclusive access to the stream */
-
-  lib_take_semaphore(stream);
+    {
+      ret = lib_fwrite_direct(src, count, stream);
+      goto errout;
+    }
 
   /* If the buffer is currently being used for read access, then
    * discard all of the read-ahead data.  We do not support concurrent
@@ -109,7 +138,22 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
 
   if (lib_rdflush(stream) < 0)
     {
-      goto errout_with_semaphore;
+      goto errout;
+    }
+
+  /* Copying a request that would fill the buffer anyway only costs time:
+   * flush what is already buffered and hand the data to the file.
+   */
+
+  if (count >= (size_t)(stream->fs_bufend - stream->fs_bufstart))
+    {
+      if (lib_fflush(stream, true) < 0)
+        {
+          goto errout;
+        }
+
+      ret = lib_fwrite_direct(src, count, stream);
+      goto errout;
     }
 
   /* Loop until all of the bytes have been buffered */
@@ -131,31 +175,23 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
           gulp_size = count;
         }
 
-      /* Adjust the number of bytes remaining to be transferred
-       * on the next pass through the loop (might be zero).
-       */
-
-      count -= gulp_size;
-
       /* Transfer the data into the buffer */
 
-      for (dest = stream->fs_bufpos; gulp_size > 0; gulp_size--)
-        {
-          *dest++ = *src++;
-        }
-
-      stream->fs_bufpos = dest;
+      memcpy(stream->fs_bufpos, src, gulp_size);
+      stream->fs_bufpos += gulp_size;
+      src               += gulp_size;
+      count             -= gulp_size;
 
       /* Is the buffer full? */
 
-      if (dest >= stream->fs_bufend)
+      if (stream->fs_bufpos >= stream->fs_bufend)
         {
           /* Flush the buffered data to the IO stream */
 
           int bytes_buffered = lib_fflush(stream, false);
           if (bytes_buffered < 0)
             {
-              goto errout_with_semaphore;
+              goto errout;
             }
         }
     }
@@ -164,9 +200,6 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
 
   ret = (uintptr_t)src - (uintptr_t)start;
 
-errout_with_semaphore:
-  lib_give_semaphore(stream);
-
 errout:
   if (ret < 0)
     {
@@ -187,3 +220,24 @@ errout:
   return ret;
 }
 #endif /* CONFIG_STDIO_DISABLE_BUFFERING */
+
+/****************************************************************************
+ * Name: lib_fwrite
+ ****************************************************************************/
+
+ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
+{
+  ssize_t ret;
+
+  if (stream == NULL)
+    {
+      set_errno(EBADF);
+      return ERROR;
+    }
+
+  lib_take_semaphore(stream);
+  ret = lib_fwrite_unlocked(ptr, count, stream);
+  lib_give_semaphore(stream);
+
+  return ret;
+}
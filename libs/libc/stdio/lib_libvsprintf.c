@@ -53,7 +53,7 @@
 #include <nuttx/streams.h>
 
 #include "lib_dtoa_engine.h"
-#include "lib_ultoa_invert.h"
+#include "lib_ultoa.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -75,6 +75,20 @@
 
 #define putc(c,stream)  (total_len++, (stream)->put(stream, c))
 
+/* Put a span of characters, or n copies of a padding character */
+
+#define putstr(s,n,stream)  (total_len += (n), vsprintf_puts(stream, s, n))
+#define putpad(c,n,stream)  (total_len += (n), vsprintf_pad(stream, c, n))
+
+/* Put n of the digits converted by __dtoa_engine(), starting at first */
+
+#define putdigits(first,n,stream) \
+  (total_len += (n), vsprintf_digits(stream, value, &_dtoa, ndigs, first, n))
+
+/* Size of the blocks used to write padding */
+
+#define PAD_BLOCK_SIZE      16
+
 /* Order is relevant here and matches order in format string */
 
 #define FL_ZFILL           0x0001
@@ -137,16 +151,107 @@ struct arg
   } value;
 };
 
- /****************************************************************************
-  * Private Constant Data
-  ****************************************************************************/
+/****************************************************************************
+ * Private Constant Data
+ ****************************************************************************/
+
+static const char g_nullstring[] = "(null)";
+
+static const char g_spaces[PAD_BLOCK_SIZE] =
+{
+  ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ',
+  ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '
+};
+
+static const char g_zeros[PAD_BLOCK_SIZE] =
+{
+  '0', '0', '0', '0', '0', '0', '0', '0',
+  '0', '0', '0', '0', '0', '0', '0', '0'
+};
 
- static const char g_nullstring[] = "(null)";
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
 
 /****************************************************************************
- * Public Functions
+ * Name: vsprintf_puts
+ *
+ * Description:
+ *   Write a span of characters with the stream's bulk method, falling back
+ *   to one put() per character for streams that do not provide one.
+ *
+ ****************************************************************************/
+
+static void vsprintf_puts(FAR struct lib_outstream_s *stream,
+                          FAR const char *buf, int len)
+{
+  if (stream->puts != NULL)
+    {
+      if (len > 0)
+        {
+          stream->puts(stream, buf, len);
+        }
+    }
+  else
+    {
+      while (len-- > 0)
+        {
+          stream->put(stream, *buf++);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: vsprintf_pad
+ *
+ * Description:
+ *   Write n spaces or zeros.
+ *
+ ****************************************************************************/
+
+static void vsprintf_pad(FAR struct lib_outstream_s *stream, int ch, int n)
+{
+  FAR const char *block = ch == '0' ? g_zeros : g_spaces;
+
+  while (n > 0)
+    {
+      int chunk = n < PAD_BLOCK_SIZE ? n : PAD_BLOCK_SIZE;
+
+      vsprintf_puts(stream, block, chunk);
+      n -= chunk;
+    }
+}
+
+/****************************************************************************
+ * Name: vsprintf_digits
+ *
+ * Description:
+ *   Write n of the ndigs digits of value converted into dtoa, starting at
+ *   first.  The ones past those kept in dtoa are regenerated.
+ *
  ****************************************************************************/
 
+#ifdef CONFIG_LIBC_FLOATINGPOINT
+static void vsprintf_digits(FAR struct lib_outstream_s *stream,
+                            double_t value, FAR const struct dtoa_s *dtoa,
+                            int ndigs, int first, int n)
+{
+  if (first < DTOA_MAX_DIG)
+    {
+      int nbuf = n < DTOA_MAX_DIG - first ? n : DTOA_MAX_DIG - first;
+
+      vsprintf_puts(stream, &dtoa->digits[first], nbuf);
+      first += nbuf;
+      n     -= nbuf;
+    }
+
+  if (n > 0)
+    {
+      __dtoa_tail(value, dtoa, ndigs, first, n, stream);
+    }
+}
+#endif
+
 static int vsprintf_internal(FAR struct lib_outstream_s *stream,
                              FAR struct arg *arglist, int numargs,
                              FAR const IPTR char *fmt, va_list ap)
@@ -185,6 +290,29 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
     {
       for (; ; )
         {
+#ifndef CONFIG_ARCH_ROMGETC
+          /* Copy the literal text up to the next conversion in one go */
+
+          pnt = fmt;
+          while (*fmt != '\0' && *fmt != '%')
+            {
+              fmt++;
+            }
+
+          size = fmt - pnt;
+#ifdef CONFIG_LIBC_NUMBERED_ARGS
+          if (stream == NULL)
+            {
+              size = 0;
+            }
+#endif
+
+          if (size != 0)
+            {
+              putstr(pnt, size, stream);
+            }
+
+#endif
           c = fmt_char(fmt);
           if (c == '\0')
             {
@@ -531,14 +659,14 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
           int exp;              /* Exponent of master decimal digit */
           int n;
           uint8_t sign;         /* Sign character (or 0) */
-          uint8_t ndigs;        /* Number of digits to convert */
-          uint8_t ndecimal;     /* Digits after decimal (for 'f' format), 0 if
-                                 * no limit */
+          int ndigs;            /* Number of digits to convert */
+          int ndecimal;         /* Digits after decimal (for 'f' format), -1
+                                 * if no limit */
+          char ebuf[6];         /* Exponent, e.g. "e+308" */
 
           flags &= ~FL_FLTUPP;
 
           flt_oper:
-          ndigs = 0;
           if ((flags & FL_PREC) == 0)
             {
               prec = 6;
@@ -548,25 +676,27 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
 
           if (c == 'e')
             {
-              ndigs = prec + 1;
-              ndecimal = 0;
+              n = prec + 1;
+              ndecimal = -1;
               flags |= FL_FLTEXP;
             }
           else if (c == 'f')
             {
-              ndigs = DTOA_MAX_DIG;
+              n = INT_MAX;
               ndecimal = prec;
               flags |= FL_FLTFIX;
             }
           else
             {
-              ndigs = prec;
-              ndecimal = 0;
-            }
+              /* A precision of zero is taken as one for 'g' */
 
-          if (ndigs > DTOA_MAX_DIG)
-            {
-              ndigs = DTOA_MAX_DIG;
+              if (prec == 0)
+                {
+                  prec = 1;
+                }
+
+              n = prec;
+              ndecimal = -1;
             }
 
 #ifdef CONFIG_LIBC_NUMBERED_ARGS
@@ -582,8 +712,7 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
           value = va_arg(ap, double_t);
 #endif
 
-          ndigs = __dtoa_engine(value, &_dtoa, ndigs,
-                                ndecimal);
+          ndigs = __dtoa_engine(value, &_dtoa, n, ndecimal);
           exp = _dtoa.exp;
 
           sign = 0;
@@ -605,20 +734,10 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
               FAR const char *p;
 
               ndigs = sign ? 4 : 3;
-              if (width > ndigs)
-                {
-                  width -= ndigs;
-                  if ((flags & FL_LPAD) == 0)
-                    {
-                      do
-                        {
-                          putc(' ', stream);
-                        }
-                      while (--width);
-                    }
-                }
-              else
+              width = width > ndigs ? width - ndigs : 0;
+              if ((flags & FL_LPAD) == 0)
                 {
+                  putpad(' ', width, stream);
                   width = 0;
                 }
 
@@ -627,60 +746,36 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
                   putc(sign, stream);
                 }
 
-              p = "inf";
               if (_dtoa.flags & DTOA_NAN)
                 {
-                  p = "nan";
+                  p = (flags & FL_FLTUPP) != 0 ? "NAN" : "nan";
                 }
-
-#  if ('I'-'i' != 'N'-'n') || ('I'-'i' != 'F'-'f') || ('I'-'i' != 'A'-'a')
-#    error
-#  endif
-              while ((ndigs = *p) != 0)
+              else
                 {
-                  if ((flags & FL_FLTUPP) != 0)
-                    {
-                      ndigs += 'I' - 'i';
-                    }
-
-                  putc(ndigs, stream);
-                  p++;
+                  p = (flags & FL_FLTUPP) != 0 ? "INF" : "inf";
                 }
 
+              putstr(p, 3, stream);
               goto tail;
             }
 
           if ((flags & (FL_FLTEXP | FL_FLTFIX)) == 0)
             {
-              /* 'g(G)' format */
-
-              prec = ndigs;
+              /* 'g(G)' format.  Unless '#' was given, the precision
+               * shrinks to the digits left without the trailing zeros.
+               */
 
-              /* Remove trailing zeros */
-
-              while (ndigs > 0 && _dtoa.digits[ndigs - 1] == '0')
-                {
-                  ndigs--;
-                }
+              n = (flags & FL_ALT) != 0 ? prec : ndigs;
 
               if (-4 <= exp && exp < prec)
                 {
                   flags |= FL_FLTFIX;
-
-                  if (exp < 0 || ndigs > exp)
-                    {
-                      prec = ndigs - (exp + 1);
-                    }
-                  else
-                    {
-                      prec = 0;
-                    }
+                  prec  = n - 1 - exp > 0 ? n - 1 - exp : 0;
                 }
               else
                 {
-                  /* Limit displayed precision to available precision */
-
-                  prec = ndigs - 1;
+                  flags |= FL_FLTEXP;
+                  prec  = n - 1;
                 }
             }
 
@@ -690,6 +785,10 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
             {
               n = (exp > 0 ? exp + 1 : 1);
             }
+          else if (exp <= -100 || exp >= 100)
+            {
+              n = 6;              /* 1e+100 */
+            }
           else
             {
               n = 5;              /* 1e+00 */
@@ -715,11 +814,8 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
 
           if ((flags & (FL_LPAD | FL_ZFILL)) == 0)
             {
-              while (width)
-                {
-                  putc(' ', stream);
-                  width--;
-                }
+              putpad(' ', width, stream);
+              width = 0;
             }
 
           if (sign != 0)
@@ -729,68 +825,53 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
 
           if ((flags & FL_LPAD) == 0)
             {
-              while (width)
-                {
-                  putc('0', stream);
-                  width--;
-                }
+              putpad('0', width, stream);
+              width = 0;
             }
 
           if ((flags & FL_FLTFIX) != 0)
             {
-              /* 'f' format */
-
-              char out;
-
-              /* At this point, we should have exp exponent of leftmost digit
-               * in _dtoa.digits ndigs number of buffer digits to print prec
-               * number of digits after decimal In the loop, 'n' walks over
-               * the exponent value
+              /* 'f' format.  The integer part first: the converted digits
+               * followed by zeros if it is longer than them.
                */
 
-              n = exp > 0 ? exp : 0;    /* Exponent of left digit */
-              do
+              if (exp < 0)
                 {
+                  putc('0', stream);
+                }
+              else
+                {
+                  n = exp + 1 < ndigs ? exp + 1 : ndigs;
+                  putdigits(0, n, stream);
+                  putpad('0', exp + 1 - n, stream);
+                }
 
-                  /* Insert decimal point at correct place */
-
-                  if (n == -1)
-                    {
-                      putc('.', stream);
-                    }
-
-                  /* Pull digits from buffer when in-range, otherwise use 0 */
-
-                  if (0 <= exp - n && exp - n < ndigs)
-                    {
-                      out = _dtoa.digits[exp - n];
-                    }
-                  else
-                    {
-                      out = '0';
-                    }
-
-                  if (--n < -prec)
-                    {
-                      if ((flags & FL_ALT) != 0 && n == -1)
-                        {
-                          putc('.', stream);
-                        }
+              if (prec > 0 || (flags & FL_ALT) != 0)
+                {
+                  putc('.', stream);
+                }
 
-                      break;
-                    }
+              /* Then the fraction: zeros down to the first digit, the
+               * rest of the digits and zeros up to the precision.
+               */
 
-                  putc(out, stream);
+              if (exp < -1)
+                {
+                  n = -exp - 1 < prec ? -exp - 1 : prec;
+                  putpad('0', n, stream);
+                  prec -= n;
                 }
-              while (1);
 
-              if (n == exp && (_dtoa.digits[0] > '5' ||
-                  (_dtoa.digits[0] == '5' && !(_dtoa.flags & DTOA_CARRY))))
+              n = exp + 1 > 0 ? exp + 1 : 0;
+              if (n < ndigs && prec > 0)
                 {
-                  out = '1';
+                  int nfrac = ndigs - n < prec ? ndigs - n : prec;
+
+                  putdigits(n, nfrac, stream);
+                  prec -= nfrac;
                 }
 
-              putc(out, stream);
+              putpad('0', prec, stream);
             }
           else
             {
@@ -799,45 +880,36 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
                * Mantissa
                */
 
-              if (_dtoa.digits[0] != '1')
-                {
-                  _dtoa.flags &= ~DTOA_CARRY;
-                }
-
               putc(_dtoa.digits[0], stream);
-              if (prec > 0)
-                {
-                  uint8_t pos;
-
-                  putc('.', stream);
-                  for (pos = 1; pos < 1 + prec; pos++)
-                    {
-                      putc(pos < ndigs ? _dtoa.digits[pos] : '0', stream);
-                    }
-                }
-              else if ((flags & FL_ALT) != 0)
+              if (prec > 0 || (flags & FL_ALT) != 0)
                 {
                   putc('.', stream);
                 }
 
+              n = ndigs - 1 < prec ? ndigs - 1 : prec;
+              putdigits(1, n, stream);
+              putpad('0', prec - n, stream);
+
               /* Exponent */
 
-              putc(flags & FL_FLTUPP ? 'E' : 'e', stream);
-              ndigs = '+';
-              if (exp < 0 || (exp == 0 && (_dtoa.flags & DTOA_CARRY) != 0))
+              n = 0;
+              ebuf[n++] = flags & FL_FLTUPP ? 'E' : 'e';
+              ebuf[n++] = '+';
+              if (exp < 0)
                 {
+                  ebuf[n - 1] = '-';
                   exp = -exp;
-                  ndigs = '-';
                 }
 
-              putc(ndigs, stream);
-              for (ndigs = '0'; exp >= 10; exp -= 10)
+              if (exp >= 100)
                 {
-                  ndigs += 1;
+                  ebuf[n++] = '0' + exp / 100;
+                  exp %= 100;
                 }
 
-              putc(ndigs, stream);
-              putc('0' + exp, stream);
+              ebuf[n++] = '0' + exp / 10;
+              ebuf[n++] = '0' + exp % 10;
+              putstr(ebuf, n, stream);
             }
 
           goto tail;
@@ -895,26 +967,14 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
           size = strnlen(pnt, (flags & FL_PREC) ? prec : ~0);
 
         str_lpad:
-          if ((flags & FL_LPAD) == 0)
-            {
-              while (size < width)
-                {
-                  putc(' ', stream);
-                  width--;
-                }
-            }
-
-          while (size)
+          if ((flags & FL_LPAD) == 0 && size < (size_t)width)
             {
-              putc(*pnt++, stream);
-              if (width != 0)
-                {
-                  width -= 1;
-                }
-
-              size -= 1;
+              putpad(' ', width - size, stream);
+              width = size;
             }
 
+          putstr(pnt, size, stream);
+          width = (size_t)width > size ? width - size : 0;
           goto tail;
         }
 
@@ -997,7 +1057,8 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
             }
           else
             {
-              c = __ultoa_invert(x, (FAR char *)buf, 10) - (FAR char *)buf;
+              pnt = __ultoa(x, (FAR char *)buf + sizeof(buf), 10);
+              c = (FAR const char *)buf + sizeof(buf) - pnt;
             }
         }
       else
@@ -1115,7 +1176,8 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
             }
           else
             {
-              c = __ultoa_invert(x, (FAR char *)buf, base) - (FAR char *)buf;
+              pnt = __ultoa(x, (FAR char *)buf + sizeof(buf), base);
+              c = (FAR const char *)buf + sizeof(buf) - pnt;
             }
 
           flags &= ~FL_NEGATIVE;
@@ -1138,7 +1200,7 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
 
       if ((flags & FL_ALT) != 0)
         {
-          if (buf[c - 1] == '0')
+          if (c == 0 ? (flags & FL_ALTHEX) != 0 : pnt[0] == '0')
             {
               flags &= ~(FL_ALT | FL_ALTHEX | FL_ALTUPP);
             }
@@ -1168,10 +1230,10 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
                 }
             }
 
-          while (len < width)
+          if (len < width)
             {
-              putc(' ', stream);
-              len++;
+              putpad(' ', width - len, stream);
+              len = width;
             }
         }
 
@@ -1201,26 +1263,18 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
           putc(z, stream);
         }
 
-      while (prec > c)
+      if (prec > c)
         {
-          putc('0', stream);
-          prec--;
+          putpad('0', prec - c, stream);
         }
 
-      while (c)
-        {
-          putc(buf[--c], stream);
-        }
+      putstr(pnt, c, stream);
 
 tail:
 
       /* Tail is possible.  */
 
-      while (width)
-        {
-          putc(' ', stream);
-          width--;
-        }
+      putpad(' ', width, stream);
     }
 
 ret:
@@ -38,6 +38,7 @@
  ****************************************************************************/
 
 #include <assert.h>
+#include <string.h>
 
 #include "libc.h"
 
@@ -68,6 +69,33 @@ static void memoutstream_putc(FAR struct lib_outstream_s *this, int ch)
     }
 }
 
+/****************************************************************************
+ * Name: memoutstream_puts
+ ****************************************************************************/
+
+static void memoutstream_puts(FAR struct lib_outstream_s *this,
+                              FAR const char *buf, int len)
+{
+  FAR struct lib_memoutstream_s *mthis = (FAR struct lib_memoutstream_s *)this;
+  size_t ncopy;
+
+  DEBUGASSERT(this && buf);
+
+  /* Copy as much of the span as will fit, silently truncating the rest
+   * just as memoutstream_putc() does for single characters.
+   */
+
+  ncopy = mthis->buflen - this->nput;
+  if ((size_t)len < ncopy)
+    {
+      ncopy = len;
+    }
+
+  memcpy(mthis->buffer + this->nput, buf, ncopy);
+  this->nput += ncopy;
+  mthis->buffer[this->nput] = '\0';
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -93,6 +121,7 @@ void lib_memoutstream(FAR struct lib_memoutstream_s *outstream,
                       FAR char *bufstart, int buflen)
 {
   outstream->public.put   = memoutstream_putc;
+  outstream->public.puts  = memoutstream_puts;
   outstream->public.flush = lib_noflush;
   outstream->public.nput  = 0;          /* Will be buffer index */
   outstream->buffer       = bufstart;   /* Start of buffer */
@@ -88,6 +88,45 @@ static void rawoutstream_putc(FAR struct lib_outstream_s *this, int ch)
   while (errcode == EINTR);
 }
 
+/****************************************************************************
+ * Name: rawoutstream_puts
+ ****************************************************************************/
+
+static void rawoutstream_puts(FAR struct lib_outstream_s *this,
+                              FAR const char *buf, int len)
+{
+  FAR struct lib_rawoutstream_s *rthis = (FAR struct lib_rawoutstream_s *)this;
+  int nwritten;
+  int errcode;
+
+  DEBUGASSERT(this && buf && rthis->fd >= 0);
+
+  /* Write the whole span with as few system calls as possible, looping on
+   * partial writes and EINTR until it is transferred or an irrecoverable
+   * error occurs.
+   */
+
+  while (len > 0)
+    {
+      nwritten = _NX_WRITE(rthis->fd, buf, len);
+      if (nwritten > 0)
+        {
+          this->nput += nwritten;
+          buf        += nwritten;
+          len        -= nwritten;
+          continue;
+        }
+
+      errcode = _NX_GETERRNO(nwritten);
+      DEBUGASSERT(nwritten < 0);
+
+      if (errcode != EINTR)
+        {
+          break;
+        }
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -112,6 +151,7 @@ static void rawoutstream_putc(FAR struct lib_outstream_s *this, int ch)
 void lib_rawoutstream(FAR struct lib_rawoutstream_s *outstream, int fd)
 {
   outstream->public.put   = rawoutstream_putc;
+  outstream->public.puts  = rawoutstream_puts;
   outstream->public.flush = lib_noflush;
   outstream->public.nput  = 0;
   outstream->fd           = fd;
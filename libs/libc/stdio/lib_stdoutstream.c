@@ -40,6 +40,7 @@
 #include <fcntl.h>
 #include <assert.h>
 #include <errno.h>
+#include <string.h>
 
 #include "libc.h"
 
@@ -78,6 +79,65 @@ static void stdoutstream_putc(FAR struct lib_outstream_s *this, int ch)
   while (get_errno() == EINTR);
 }
 
+/****************************************************************************
+ * Name: stdoutstream_puts
+ ****************************************************************************/
+
+static void stdoutstream_puts(FAR struct lib_outstream_s *this,
+                              FAR const char *buf, int len)
+{
+  FAR struct lib_stdoutstream_s *sthis = (FAR struct lib_stdoutstream_s *)this;
+  FAR const char *newline;
+  ssize_t result;
+  int ntowrite;
+
+  DEBUGASSERT(this && buf && sthis->stream);
+
+  while (len > 0)
+    {
+      /* A line buffered stream must be flushed after each newline, just as
+       * fputc() does, so only write up to the next newline in that case.
+       */
+
+      ntowrite = len;
+      newline  = NULL;
+
+      if ((sthis->stream->fs_flags & __FS_FLAG_LBF) != 0)
+        {
+          newline = memchr(buf, '\n', len);
+          if (newline != NULL)
+            {
+              ntowrite = newline - buf + 1;
+            }
+        }
+
+      result = lib_fwrite(buf, ntowrite, sthis->stream);
+      if (result > 0)
+        {
+          this->nput += result;
+          buf        += result;
+          len        -= result;
+
+          if (newline != NULL && buf > newline &&
+              lib_fflush(sthis->stream, true) < 0)
+            {
+              break;
+            }
+
+          continue;
+        }
+
+      /* EINTR (meaning that lib_fwrite was interrupted by a signal) is the
+       * only recoverable error.
+       */
+
+      if (get_errno() != EINTR)
+        {
+          break;
+        }
+    }
+}
+
 /****************************************************************************
  * Name: stdoutstream_flush
  ****************************************************************************/
@@ -116,9 +176,10 @@ static int stdoutstream_flush(FAR struct lib_outstream_s *this)
 void lib_stdoutstream(FAR struct lib_stdoutstream_s *outstream,
                       FAR FILE *stream)
 {
-  /* Select the put operation */
+  /* Select the put operations */
 
-  outstream->public.put = stdoutstream_putc;
+  outstream->public.put  = stdoutstream_putc;
+  outstream->public.puts = stdoutstream_puts;
 
   /* Select the correct flush operation.  This flush is only called when
    * a newline is encountered in the output stream.  However, we do not
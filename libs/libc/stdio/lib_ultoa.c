@@ -0,0 +1,179 @@
+/****************************************************************************
+ * libs/libc/stdio/lib_ultoa.c
+ *
+ *   Copyright © 2017, Keith Packard
+ *   All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+
+#include "lib_ultoa.h"
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Two ASCII digits for every value 0..99 so that decimal conversion needs
+ * one division for each pair of digits rather than one for each digit.
+ */
+
+static const char g_ultoa_pairs[201] =
+  "0001020304050607080910111213141516171819"
+  "2021222324252627282930313233343536373839"
+  "4041424344454647484950515253545556575859"
+  "6061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+
+static const char g_ultoa_lower[] = "0123456789abcdef";
+static const char g_ultoa_upper[] = "0123456789ABCDEF";
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ultoa_decimal
+ *
+ * Description:
+ *   Convert a 32-bit value to decimal, writing backwards from 'end' and
+ *   padding with zeros down to 'limit'.
+ *
+ ****************************************************************************/
+
+static FAR char *ultoa_decimal(uint32_t val, FAR char *end,
+                               FAR char *limit)
+{
+  FAR const char *pair;
+
+  while (val >= 100)
+    {
+      pair  = &g_ultoa_pairs[(val % 100) << 1];
+      val  /= 100;
+      end  -= 2;
+      end[0] = pair[0];
+      end[1] = pair[1];
+    }
+
+  if (val >= 10)
+    {
+      pair   = &g_ultoa_pairs[val << 1];
+      end   -= 2;
+      end[0] = pair[0];
+      end[1] = pair[1];
+    }
+  else
+    {
+      *--end = '0' + val;
+    }
+
+  while (end > limit)
+    {
+      *--end = '0';
+    }
+
+  return end;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_LONG_LONG
+FAR char *__ultoa(unsigned long long val, FAR char *end, int base)
+#else
+FAR char *__ultoa(unsigned long val, FAR char *end, int base)
+#endif
+{
+  FAR const char *digits = g_ultoa_lower;
+  unsigned int shift;
+
+  if (base & XTOA_UPPER)
+    {
+      digits = g_ultoa_upper;
+      base &= ~XTOA_UPPER;
+    }
+
+  switch (base)
+    {
+      case 10:
+
+        /* Split off eight digits at a time with one wide division so that
+         * the pair loop only ever does native 32-bit arithmetic.
+         */
+
+        while (val > UINT32_MAX)
+          {
+            uint32_t low = val % 100000000;
+
+            val /= 100000000;
+            end  = ultoa_decimal(low, end, end - 8);
+          }
+
+        return ultoa_decimal((uint32_t)val, end, end);
+
+      case 16:
+        shift = 4;
+        break;
+
+      case 8:
+        shift = 3;
+        break;
+
+      case 2:
+        shift = 1;
+        break;
+
+      default:
+        do
+          {
+            *--end = digits[val % base];
+            val /= base;
+          }
+        while (val);
+
+        return end;
+    }
+
+  /* Power of two bases only need shifts and masks */
+
+  do
+    {
+      *--end = digits[val & ((1 << shift) - 1)];
+      val >>= shift;
+    }
+  while (val);
+
+  return end;
+}
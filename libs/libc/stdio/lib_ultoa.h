@@ -1,5 +1,5 @@
 /****************************************************************************
- * libs/libc/stdio/lib_ultoa_invert.h
+ * libs/libc/stdio/lib_ultoa.h
  *
  *   Copyright (c) 2005, Dmitry Xmelkov
  *   All rights reserved.
@@ -33,8 +33,8 @@
  *
  ****************************************************************************/
 
-#ifndef __LIBS_LIBC_STDIO_LIB_ULTOA_INVERT_H
-#define __LIBS_LIBC_STDIO_LIB_ULTOA_INVERT_H
+#ifndef __LIBS_LIBC_STDIO_LIB_ULTOA_H
+#define __LIBS_LIBC_STDIO_LIB_ULTOA_H
 
 /****************************************************************************
  * Included Files
@@ -65,12 +65,15 @@
  * Public Function Prototypes
  ****************************************************************************/
 
-/* Internal function for use from `printf'. */
+/* Internal function for use from `printf'.  The digits are written
+ * backwards so that the last one lands just before `end'; the returned
+ * pointer addresses the most significant digit.
+ */
 
 #ifdef CONFIG_LIBC_LONG_LONG
-FAR char *__ultoa_invert(unsigned long long val, FAR char *str, int base);
+FAR char *__ultoa(unsigned long long val, FAR char *end, int base);
 #else
-FAR char *__ultoa_invert(unsigned long val, FAR char *str, int base);
+FAR char *__ultoa(unsigned long val, FAR char *end, int base);
 #endif
 
-#endif /* __LIBS_LIBC_STDIO_LIB_ULTOA_INVERT_H */
+#endif /* __LIBS_LIBC_STDIO_LIB_ULTOA_H */
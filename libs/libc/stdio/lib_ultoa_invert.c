@@ -1,83 +0,0 @@
-/****************************************************************************
- * libs/libc/stdio/lib_ultoa_invert.c
- *
- *   Copyright © 2017, Keith Packard
- *   All rights reserved.
- *
- * Redistribution and use in source and binary forms, with or without
- * modification, are permitted provided that the following conditions
- * are met:
- *
- * 1. Redistributions of source code must retain the above copyright
- *    notice, this list of conditions and the following disclaimer.
- * 2. Redistributions in binary form must reproduce the above copyright
- *    notice, this list of conditions and the following disclaimer in
- *    the documentation and/or other materials provided with the
- *    distribution.
- * 3. Neither the name NuttX nor the names of its contributors may be
- *    used to endorse or promote products derived from this software
- *    without specific prior written permission.
- *
- * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
- * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
- * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
- * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
- * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
- * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
- * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
- * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
- * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
- * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
- * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
- * POSSIBILITY OF SUCH DAMAGE.
- *
- ****************************************************************************/
-
-/****************************************************************************
- * Included Files
- ****************************************************************************/
-
-#include "lib_ultoa_invert.h"
-
-/****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-#ifdef CONFIG_LIBC_LONG_LONG
-FAR char *__ultoa_invert(unsigned long long val, FAR char *str, int base)
-#else
-FAR char *__ultoa_invert(unsigned long val, FAR char *str, int base)
-#endif
-{
-  int upper = 0;
-
-  if (base & XTOA_UPPER)
-    {
-      upper = 1;
-      base &= ~XTOA_UPPER;
-    }
-  do
-    {
-      int v;
-
-      v   = val % base;
-      val = val / base;
-
-      if (v <= 9)
-        {
-          v += '0';
-        }
-      else
-        {
-          if (upper)
-            v += 'A' - 10;
-          else
-            v += 'a' - 10;
-        }
-
-      *str++ = v;
-    }
-  while (val);
-
-  return str;
-}
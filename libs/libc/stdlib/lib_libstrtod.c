@@ -0,0 +1,993 @@
+/****************************************************************************
+ * libs/libc/stdlib/lib_libstrtod.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <errno.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* w * 10^q rounds to zero below this q and to infinity above it for any
+ * 19 digit w, in every supported format.
+ */
+
+#define STRTOD_MIN_EXP10     (-342)
+#define STRTOD_MAX_EXP10     308
+
+/* The 128-bit powers of five are rebuilt from every 27th one */
+
+#define STRTOD_POW5_STEP     27
+
+/* The most significant digits w can hold without overflow */
+
+#define STRTOD_MAX_FAST      19
+
+/* Decimal digits beyond this count can only break a tie, so the exact
+ * comparison folds them into a sticky flag.  No halfway point between two
+ * doubles has more than 767 significant digits (112 for float), and the
+ * big integers are sized to match.
+ */
+
+#ifdef CONFIG_HAVE_DOUBLE
+#  define STRTOD_MAX_DIGITS  768
+#  define STRTOD_BIGINT_WORDS 90
+#else
+#  define STRTOD_MAX_DIGITS  128
+#  define STRTOD_BIGINT_WORDS 18
+#endif
+
+/* floor(log2(5^q)), exact for |q| < 3529 */
+
+#define STRTOD_LOG2POW5(q)   (((q) * 1217359) >> 19)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct strtod_bigint_s
+{
+  int      len;
+  uint32_t word[STRTOD_BIGINT_WORDS];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* 5^q normalized to 128 bits and truncated, {low, high}, for q = -342 +
+ * 27 * i.
+ */
+
+static const uint64_t g_strtod_pow5_base[][2] =
+{
+  {0x113faa2906a13b3full, 0xeef453d6923bd65aull}, /* 5^-342 */
+  {0x999ec0bb696e840aull, 0xc1069cd4eabe89f8ull}, /* 5^-315 */
+  {0x4ee367f9430aec32ull, 0x9becce62836ac577ull}, /* 5^-288 */
+  {0x4bf1ff9f0062baa8ull, 0xfbe9141915d7a922ull}, /* 5^-261 */
+  {0xa9942f5dcf7dfd09ull, 0xcb7ddcdda26da268ull}, /* 5^-234 */
+  {0x52d9be85f074e608ull, 0xa46116538d0deb78ull}, /* 5^-207 */
+  {0x29ecd9f40041e073ull, 0x84c8d4dfd2c63f3bull}, /* 5^-180 */
+  {0xc80a537b0efefebdull, 0xd686619ba27255a2ull}, /* 5^-153 */
+  {0x86c16c98d2c953c6ull, 0xad4ab7112eb3929dull}, /* 5^-126 */
+  {0x57eb4edb3c55b65aull, 0x8bfbea76c619ef36ull}, /* 5^-99 */
+  {0x25c6da63c38de1b0ull, 0xe2280b6c20dd5232ull}, /* 5^-72 */
+  {0x3d607b97c5fd0d22ull, 0xb6b00d69bb55c8d1ull}, /* 5^-45 */
+  {0x3aff322e62439fcfull, 0x9392ee8e921d5d07ull}, /* 5^-18 */
+  {0x0000000000000000ull, 0xee6b280000000000ull}, /* 5^9 */
+  {0x4b9f100000000000ull, 0xc097ce7bc90715b3ull}, /* 5^36 */
+  {0x63cc55f49f88eb2full, 0x9b934c3b330c8577ull}, /* 5^63 */
+  {0x04ab48a04065c723ull, 0xfb5878494ace3a5full}, /* 5^90 */
+  {0x5cadf5bfd3072cc5ull, 0xcb090c8001ab551cull}, /* 5^117 */
+  {0x5f16206c9c6209a6ull, 0xa402b9c5a8d3a6e7ull}, /* 5^144 */
+  {0x69956135febada11ull, 0x847c9b5d7c2e09b7ull}, /* 5^171 */
+  {0x8a71e223d8d3b074ull, 0xd60b3bd56a5586f1ull}, /* 5^198 */
+  {0x636cc64d1001550bull, 0xace73cbfdc0bfb7bull}, /* 5^225 */
+  {0x1ad089b6c2f7548eull, 0x8bab8eefb6409c1aull}, /* 5^252 */
+  {0x5e7873f8a0396973ull, 0xe1a63853bbd26451ull}, /* 5^279 */
+  {0xe0133fe4adf8e952ull, 0xb6472e511c81471dull}, /* 5^306 */
+};
+
+/* 5^i for i = 0..27 */
+
+static const uint64_t g_strtod_pow5[STRTOD_POW5_STEP + 1] =
+{
+  0x1ull, 0x5ull, 0x19ull, 0x7dull, 0x271ull, 0xc35ull, 0x3d09ull,
+  0x1312dull, 0x5f5e1ull, 0x1dcd65ull, 0x9502f9ull, 0x2e90eddull,
+  0xe8d4a51ull, 0x48c27395ull, 0x16bcc41e9ull, 0x71afd498dull,
+  0x2386f26fc1ull, 0xb1a2bc2ec5ull, 0x3782dace9d9ull, 0x1158e460913dull,
+  0x56bc75e2d631ull, 0x1b1ae4d6e2ef5ull, 0x878678326eac9ull,
+  0x2a5a058fc295edull, 0xd3c21bcecceda1ull, 0x422ca8b0a00a425ull,
+  0x14adf4b7320334b9ull, 0x6765c793fa10079dull
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: strtod_umul128
+ *
+ * Description:
+ *   Return the low 64 bits of a * b and store the high 64 bits in *hi.
+ *
+ ****************************************************************************/
+
+static uint64_t strtod_umul128(uint64_t a, uint64_t b, FAR uint64_t *hi)
+{
+  uint64_t ll = (uint64_t)(uint32_t)a * (uint32_t)b;
+  uint64_t lh = (uint64_t)(uint32_t)a * (uint32_t)(b >> 32);
+  uint64_t hl = (uint64_t)(uint32_t)(a >> 32) * (uint32_t)b;
+  uint64_t hh = (uint64_t)(uint32_t)(a >> 32) * (uint32_t)(b >> 32);
+  uint64_t mid1 = hl + (ll >> 32);
+  uint64_t mid2 = lh + (uint32_t)mid1;
+
+  *hi = hh + (mid1 >> 32) + (mid2 >> 32);
+  return (mid2 << 32) | (uint32_t)ll;
+}
+
+static int strtod_clz64(uint64_t v)
+{
+  int n = 0;
+
+  if ((v >> 32) == 0)
+    {
+      n += 32;
+      v <<= 32;
+    }
+
+  if ((v >> 48) == 0)
+    {
+      n += 16;
+      v <<= 16;
+    }
+
+  if ((v >> 56) == 0)
+    {
+      n += 8;
+      v <<= 8;
+    }
+
+  if ((v >> 60) == 0)
+    {
+      n += 4;
+      v <<= 4;
+    }
+
+  if ((v >> 62) == 0)
+    {
+      n += 2;
+      v <<= 2;
+    }
+
+  return n + ((v >> 63) == 0);
+}
+
+/****************************************************************************
+ * Name: strtod_pow5
+ *
+ * Description:
+ *   Return 5^q * 2^(127 - floor(log2(5^q))) in t[] as {low, high}.  The
+ *   result is exact for 0 <= q <= 55 and otherwise less than three units
+ *   below the true value.
+ *
+ ****************************************************************************/
+
+static void strtod_pow5(int q, FAR uint64_t *t)
+{
+  FAR const uint64_t *base;
+  uint64_t mul;
+  uint64_t p0;
+  uint64_t p1;
+  uint64_t p2;
+  uint64_t hi;
+  int index;
+  int shift;
+
+  if (q >= 0 && q <= STRTOD_POW5_STEP)
+    {
+      /* Small powers come straight from the 64-bit table */
+
+      mul   = g_strtod_pow5[q];
+      shift = strtod_clz64(mul);
+      t[0]  = 0;
+      t[1]  = mul << shift;
+      return;
+    }
+
+  index = (q - STRTOD_MIN_EXP10) / STRTOD_POW5_STEP;
+  base  = g_strtod_pow5_base[index];
+  mul   = g_strtod_pow5[q - STRTOD_MIN_EXP10 - index * STRTOD_POW5_STEP];
+
+  if (mul == 1)
+    {
+      t[0] = base[0];
+      t[1] = base[1];
+      return;
+    }
+
+  /* The 192-bit product, renormalized to its top 128 bits */
+
+  p0  = strtod_umul128(base[0], mul, &hi);
+  p1  = strtod_umul128(base[1], mul, &p2);
+  p1 += hi;
+  p2 += p1 < hi;
+
+  shift = strtod_clz64(p2);
+  if (shift > 0)
+    {
+      p2 = (p2 << shift) | (p1 >> (64 - shift));
+      p1 = (p1 << shift) | (p0 >> (64 - shift));
+    }
+
+  t[0] = p1;
+  t[1] = p2;
+}
+
+/****************************************************************************
+ * Name: strtod_lemire
+ *
+ * Description:
+ *   Convert w * 10^q to the IEEE bits of the given format with the
+ *   Eisel-Lemire algorithm (Lemire, "Number Parsing at a Gigabyte per
+ *   Second", 2021).  Returns 0 with the correctly rounded bits, or -1 when
+ *   the error in the power of five leaves the rounding undecided; *bits
+ *   then holds the candidate just below the value.
+ *
+ ****************************************************************************/
+
+static int strtod_lemire(uint64_t w, int q, int mant_bits, int exp_bits,
+                         FAR uint64_t *bits)
+{
+  uint64_t t[2];
+  uint64_t z0;
+  uint64_t z1;
+  uint64_t z2;
+  uint64_t hi;
+  uint64_t lo;
+  uint64_t mant;
+  uint64_t restmask;
+  uint64_t rest;
+  bool exact = q >= 0 && q <= 55;
+  bool near;
+  int bias = (1 << (exp_bits - 1)) - 1;
+  int exp_max = (1 << exp_bits) - 1;
+  int round;
+  int shift;
+  int keep;
+  int lz;
+  int e;
+
+  lz = strtod_clz64(w);
+  w <<= lz;
+
+  strtod_pow5(q, t);
+
+  z0  = strtod_umul128(w, t[0], &hi);
+  lo  = strtod_umul128(w, t[1], &z2);
+  z1  = hi + lo;
+  z2 += z1 < lo;
+
+  shift = (z2 >> 63) == 0;
+  if (shift)
+    {
+      z2 = (z2 << 1) | (z1 >> 63);
+      z1 = (z1 << 1) | (z0 >> 63);
+      z0 <<= 1;
+    }
+
+  /* The value lies in [2^e, 2^(e + 1)) relative to the bias */
+
+  e = 64 + STRTOD_LOG2POW5(q) + q - lz - shift + bias;
+  if (e >= exp_max)
+    {
+      *bits = (uint64_t)exp_max << mant_bits;
+      return 0;
+    }
+
+  /* Subnormals keep fewer bits.  keep == -1 still rounds up to the
+   * smallest subnormal when the value is above half of it.
+   */
+
+  keep = e >= 1 ? mant_bits + 1 : mant_bits + e;
+  if (keep < -1)
+    {
+      *bits = 0;
+      return 0;
+    }
+
+  if (keep >= 0)
+    {
+      mant     = keep > 0 ? z2 >> (64 - keep) : 0;
+      round    = (z2 >> (63 - keep)) & 1;
+      restmask = ((uint64_t)1 << (63 - keep)) - 1;
+    }
+  else
+    {
+      mant     = 0;
+      round    = 0;
+      restmask = UINT64_MAX;
+    }
+
+  rest  = (z2 & restmask) | z1 | z0;
+  *bits = (e >= 1 ? (uint64_t)(e - 1) << mant_bits : 0) + mant;
+
+  if (exact)
+    {
+      *bits += round && (rest != 0 || (mant & 1) != 0);
+      return 0;
+    }
+
+  /* Otherwise the true product lies in [z, z + (4 * w << shift)).  It
+   * only matters when that range reaches the next rounding bit, or when
+   * z sits exactly on a halfway point.
+   */
+
+  near = false;
+  if ((z2 & restmask) == restmask)
+    {
+      lo   = z0 + (w << (2 + shift));
+      hi   = (w >> (62 - shift)) + (lo < z0);
+      near = z1 > UINT64_MAX - hi;
+    }
+
+  if (near)
+    {
+      if (round)
+        {
+          /* Close to the next representable value, far from a tie */
+
+          *bits += 1;
+          return 0;
+        }
+
+      return -1;
+    }
+
+  if (round && rest == 0)
+    {
+      return -1;
+    }
+
+  *bits += round;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: strtod_bigint_*
+ *
+ * Description:
+ *   The few big integer operations needed by strtod_exact().
+ *
+ ****************************************************************************/
+
+static void strtod_bigint_set(FAR struct strtod_bigint_s *b, uint64_t v)
+{
+  b->word[0] = (uint32_t)v;
+  b->word[1] = (uint32_t)(v >> 32);
+  b->len     = b->word[1] != 0 ? 2 : b->word[0] != 0;
+}
+
+static void strtod_bigint_muladd(FAR struct strtod_bigint_s *b, uint32_t m,
+                                 uint32_t a)
+{
+  uint64_t carry = a;
+  int i;
+
+  for (i = 0; i < b->len; i++)
+    {
+      carry     += (uint64_t)b->word[i] * m;
+      b->word[i] = (uint32_t)carry;
+      carry    >>= 32;
+    }
+
+  if (carry != 0)
+    {
+      b->word[b->len++] = (uint32_t)carry;
+    }
+}
+
+static void strtod_bigint_mul_pow5(FAR struct strtod_bigint_s *b, int n)
+{
+  /* 5^13 is the largest power of five below 2^32 */
+
+  while (n >= 13)
+    {
+      strtod_bigint_muladd(b, (uint32_t)g_strtod_pow5[13], 0);
+      n -= 13;
+    }
+
+  if (n > 0)
+    {
+      strtod_bigint_muladd(b, (uint32_t)g_strtod_pow5[n], 0);
+    }
+}
+
+static void strtod_bigint_shl(FAR struct strtod_bigint_s *b, int n)
+{
+  int words = n / 32;
+  int bits = n % 32;
+  int i;
+
+  if (b->len == 0)
+    {
+      return;
+    }
+
+  if (bits != 0)
+    {
+      b->word[b->len] = 0;
+      for (i = b->len; i > 0; i--)
+        {
+          b->word[i] = (b->word[i] << bits) |
+                       (b->word[i - 1] >> (32 - bits));
+        }
+
+      b->word[0] <<= bits;
+      if (b->word[b->len] != 0)
+        {
+          b->len++;
+        }
+    }
+
+  if (words != 0)
+    {
+      for (i = b->len - 1; i >= 0; i--)
+        {
+          b->word[i + words] = b->word[i];
+        }
+
+      for (i = 0; i < words; i++)
+        {
+          b->word[i] = 0;
+        }
+
+      b->len += words;
+    }
+}
+
+static int strtod_bigint_cmp(FAR const struct strtod_bigint_s *a,
+                             FAR const struct strtod_bigint_s *b)
+{
+  int i;
+
+  if (a->len != b->len)
+    {
+      return a->len > b->len ? 1 : -1;
+    }
+
+  for (i = a->len - 1; i >= 0; i--)
+    {
+      if (a->word[i] != b->word[i])
+        {
+          return a->word[i] > b->word[i] ? 1 : -1;
+        }
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: strtod_exact
+ *
+ * Description:
+ *   Settle the cases Eisel-Lemire leaves open: compare the full decimal
+ *   digits against the halfway point above the candidate bits and round
+ *   accordingly.  The nsig significant digits start at first, q is the
+ *   decimal exponent of the STRTOD_MAX_FAST leading ones.
+ *
+ ****************************************************************************/
+
+static uint64_t strtod_exact(FAR const char *first, int nsig, int q,
+                             uint64_t bits, int mant_bits, int exp_bits)
+{
+  struct strtod_bigint_s digits;
+  struct strtod_bigint_s half;
+  uint64_t mant;
+  uint32_t chunk = 0;
+  uint32_t scale = 1;
+  bool sticky = false;
+  int bias = (1 << (exp_bits - 1)) - 1;
+  int biased;
+  int used = 0;
+  int seen;
+  int e2;
+  int cmp;
+
+  /* The halfway point is (2 * mant + 1) * 2^(e2 - 1) */
+
+  biased = (int)(bits >> mant_bits);
+  mant   = bits & (((uint64_t)1 << mant_bits) - 1);
+  if (biased == 0)
+    {
+      e2 = 1 - bias - mant_bits;
+    }
+  else
+    {
+      mant |= (uint64_t)1 << mant_bits;
+      e2    = biased - bias - mant_bits;
+    }
+
+  strtod_bigint_set(&half, 2 * mant + 1);
+
+  /* Collect the digits, nine at a time */
+
+  digits.len = 0;
+  for (seen = 0; seen < nsig; first++)
+    {
+      if (*first == '.')
+        {
+          continue;
+        }
+
+      seen++;
+      if (used >= STRTOD_MAX_DIGITS)
+        {
+          sticky |= *first != '0';
+          continue;
+        }
+
+      chunk  = chunk * 10 + (*first - '0');
+      scale *= 10;
+      used++;
+
+      if (scale == 1000000000)
+        {
+          strtod_bigint_muladd(&digits, scale, chunk);
+          chunk = 0;
+          scale = 1;
+        }
+    }
+
+  if (scale != 1)
+    {
+      strtod_bigint_muladd(&digits, scale, chunk);
+    }
+
+  /* digits * 10^q against half * 2^(e2 - 1) */
+
+  q -= used - (nsig < STRTOD_MAX_FAST ? nsig : STRTOD_MAX_FAST);
+  if (q >= 0)
+    {
+      strtod_bigint_mul_pow5(&digits, q);
+    }
+  else
+    {
+      strtod_bigint_mul_pow5(&half, -q);
+    }
+
+  if (q - (e2 - 1) >= 0)
+    {
+      strtod_bigint_shl(&digits, q - (e2 - 1));
+    }
+  else
+    {
+      strtod_bigint_shl(&half, (e2 - 1) - q);
+    }
+
+  cmp = strtod_bigint_cmp(&digits, &half);
+  if (cmp > 0 || (cmp == 0 && (sticky || (bits & 1) != 0)))
+    {
+      bits++;
+    }
+
+  return bits;
+}
+
+/****************************************************************************
+ * Name: strtod_hex
+ *
+ * Description:
+ *   Parse the part of a hexadecimal floating point string that follows
+ *   "0x" and round it to the given format, setting errno as for the
+ *   decimal case.  Returns -1 without touching *pp when no hexadecimal
+ *   digit follows.
+ *
+ ****************************************************************************/
+
+static int strtod_hex(FAR const char **pp, int mant_bits, int exp_bits,
+                      FAR uint64_t *bits)
+{
+  FAR const char *p = *pp;
+  uint64_t mant = 0;
+  uint64_t rest;
+  bool sticky = false;
+  bool digits = false;
+  bool dot = false;
+  int bias = (1 << (exp_bits - 1)) - 1;
+  int exp_max = (1 << exp_bits) - 1;
+  int e2 = 0;
+  int keep;
+  int drop;
+  int round;
+  int e;
+
+  for (; ; p++)
+    {
+      int d;
+
+      if (*p == '.' && !dot)
+        {
+          dot = true;
+          continue;
+        }
+
+      if (!isxdigit(*p))
+        {
+          break;
+        }
+
+      digits = true;
+      d = isdigit(*p) ? *p - '0' : tolower(*p) - 'a' + 10;
+
+      if ((mant >> 60) == 0)
+        {
+          mant = (mant << 4) | d;
+          e2  -= dot ? 4 : 0;
+        }
+      else
+        {
+          sticky |= d != 0;
+          e2     += dot ? 0 : 4;
+        }
+    }
+
+  if (!digits)
+    {
+      return -1;
+    }
+
+  if (*p == 'p' || *p == 'P')
+    {
+      FAR const char *e = p + 1;
+      bool eneg = false;
+      int exp2 = 0;
+
+      if (*e == '-' || *e == '+')
+        {
+          eneg = *e++ == '-';
+        }
+
+      if (isdigit(*e))
+        {
+          for (; isdigit(*e); e++)
+            {
+              if (exp2 < 100000)
+                {
+                  exp2 = exp2 * 10 + (*e - '0');
+                }
+            }
+
+          e2 += eneg ? -exp2 : exp2;
+          p   = e;
+        }
+    }
+
+  *pp   = p;
+  *bits = 0;
+  if (mant == 0)
+    {
+      return 0;
+    }
+
+  /* mant * 2^e2 lies in [2^e, 2^(e + 1)) relative to the bias */
+
+  e = e2 + 63 - strtod_clz64(mant) + bias;
+  if (e >= exp_max)
+    {
+      *bits = (uint64_t)exp_max << mant_bits;
+      set_errno(ERANGE);
+      return 0;
+    }
+
+  keep = e >= 1 ? mant_bits + 1 : mant_bits + e;
+  if (keep < 0)
+    {
+      set_errno(ERANGE);
+      return 0;
+    }
+
+  drop = 64 - strtod_clz64(mant) - keep;
+  if (drop <= 0)
+    {
+      mant <<= -drop;
+      round  = 0;
+      rest   = 0;
+    }
+  else
+    {
+      round  = (mant >> (drop - 1)) & 1;
+      rest   = (mant & (((uint64_t)1 << (drop - 1)) - 1)) | sticky;
+      mant   = drop < 64 ? mant >> drop : 0;
+    }
+
+  *bits = (e >= 1 ? (uint64_t)(e - 1) << mant_bits : 0) + mant;
+  *bits += round && (rest != 0 || (mant & 1) != 0);
+
+  if (*bits >= (uint64_t)exp_max << mant_bits || *bits == 0)
+    {
+      set_errno(ERANGE);
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: strtod_match
+ *
+ * Description:
+ *   Return the length of word if str starts with it, ignoring case.
+ *
+ ****************************************************************************/
+
+static int strtod_match(FAR const char *str, FAR const char *word)
+{
+  int n;
+
+  for (n = 0; word[n] != '\0'; n++)
+    {
+      if (tolower(str[n]) != word[n])
+        {
+          return 0;
+        }
+    }
+
+  return n;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_strtobits
+ *
+ * Description:
+ *   The common part of strtod(), strtof() and strtold().  Parse a decimal
+ *   floating point string, infinity or NaN and return the IEEE 754 bits of
+ *   the correctly rounded value in a format with mant_bits stored mantissa
+ *   and exp_bits exponent bits.  errno is set to ERANGE when a non-zero
+ *   value rounds to zero or overflows to infinity.
+ *
+ ****************************************************************************/
+
+uint64_t lib_strtobits(FAR const char *str, FAR char **endptr,
+                       int mant_bits, int exp_bits)
+{
+  FAR const char *p = str;
+  FAR const char *first = NULL;
+  uint64_t infinity = (uint64_t)((1 << exp_bits) - 1) << mant_bits;
+  uint64_t bits = 0;
+  uint64_t w = 0;
+  bool negative = false;
+  bool truncated = false;
+  bool digits = false;
+  bool dot = false;
+  int nsig = 0;
+  int q = 0;
+  int n;
+
+  /* Skip leading whitespace and handle an optional sign */
+
+  while (isspace(*p))
+    {
+      p++;
+    }
+
+  if (*p == '-' || *p == '+')
+    {
+      negative = *p++ == '-';
+    }
+
+  if ((n = strtod_match(p, "inf")) != 0)
+    {
+      p += n;
+      p += strtod_match(p, "inity");
+      bits = infinity;
+      goto out;
+    }
+
+  if ((n = strtod_match(p, "nan")) != 0)
+    {
+      FAR const char *tag = p + n;
+
+      p = tag;
+      if (*tag == '(')
+        {
+          tag++;
+          while (isalnum(*tag) || *tag == '_')
+            {
+              tag++;
+            }
+
+          if (*tag == ')')
+            {
+              p = tag + 1;
+            }
+        }
+
+      bits = infinity | ((uint64_t)1 << (mant_bits - 1));
+      goto out;
+    }
+
+  if (p[0] == '0' && tolower(p[1]) == 'x')
+    {
+      FAR const char *hex = p + 2;
+
+      if (strtod_hex(&hex, mant_bits, exp_bits, &bits) == 0)
+        {
+          p = hex;
+          goto out;
+        }
+    }
+
+  /* Keep the first STRTOD_MAX_FAST significant digits in w; q becomes the
+   * decimal exponent of its last digit.
+   */
+
+  for (; ; p++)
+    {
+      int d;
+
+      if (*p == '.' && !dot)
+        {
+          dot = true;
+          continue;
+        }
+
+      if (!isdigit(*p))
+        {
+          break;
+        }
+
+      digits = true;
+      d = *p - '0';
+
+      if (nsig == 0 && d == 0)
+        {
+          q -= dot;
+          continue;
+        }
+
+      if (nsig == 0)
+        {
+          first = p;
+        }
+
+      if (nsig < STRTOD_MAX_FAST)
+        {
+          w  = w * 10 + d;
+          q -= dot;
+        }
+      else
+        {
+          q += !dot;
+          truncated |= d != 0;
+        }
+
+      nsig++;
+    }
+
+  if (!digits)
+    {
+      p = str;
+      negative = false;
+      goto out;
+    }
+
+  /* An exponent only counts when it has at least one digit */
+
+  if (*p == 'e' || *p == 'E')
+    {
+      FAR const char *e = p + 1;
+      bool eneg = false;
+      int exp10 = 0;
+
+      if (*e == '-' || *e == '+')
+        {
+          eneg = *e++ == '-';
+        }
+
+      if (isdigit(*e))
+        {
+          for (; isdigit(*e); e++)
+            {
+              if (exp10 < 100000)
+                {
+                  exp10 = exp10 * 10 + (*e - '0');
+                }
+            }
+
+          q += eneg ? -exp10 : exp10;
+          p  = e;
+        }
+    }
+
+  if (nsig == 0)
+    {
+      goto out;
+    }
+
+  if (q < STRTOD_MIN_EXP10)
+    {
+      bits = 0;
+    }
+  else if (q > STRTOD_MAX_EXP10)
+    {
+      bits = infinity;
+    }
+  else if (!truncated)
+    {
+      if (strtod_lemire(w, q, mant_bits, exp_bits, &bits) < 0)
+        {
+          bits = strtod_exact(first, nsig, q, bits, mant_bits, exp_bits);
+        }
+    }
+  else
+    {
+      uint64_t upper;
+
+      /* The value lies between w and w + 1 at this scale; when both round
+       * the same way, so does the value.
+       */
+
+      if (strtod_lemire(w, q, mant_bits, exp_bits, &bits) < 0 ||
+          strtod_lemire(w + 1, q, mant_bits, exp_bits, &upper) < 0 ||
+          upper != bits)
+        {
+          bits = strtod_exact(first, nsig, q, bits, mant_bits, exp_bits);
+        }
+    }
+
+  if (bits >= infinity)
+    {
+      bits = infinity;
+      set_errno(ERANGE);
+    }
+  else if (bits == 0)
+    {
+      set_errno(ERANGE);
+    }
+
+out:
+  if (endptr != NULL)
+    {
+      *endptr = (FAR char *)p;
+    }
+
+  if (negative)
+    {
+      bits |= (uint64_t)1 << (mant_bits + exp_bits);
+    }
+
+  return bits;
+}
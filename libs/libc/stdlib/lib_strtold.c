@@ -89,6 +89,14 @@ static inline int is_real(long double x)
 
 long double strtold(FAR const char *str, FAR char **endptr)
 {
+#if defined(CONFIG_HAVE_DOUBLE) && defined(__LDBL_MANT_DIG__) && \
+    __LDBL_MANT_DIG__ == __DBL_MANT_DIG__
+  /* long double has the same format as double, so strtod() gives the
+   * correctly rounded result.
+   */
+
+  return strtod(str, endptr);
+#else
   long double number;
   int exponent;
   int negative;
@@ -251,6 +259,7 @@ errout:
     }
 
   return number;
+#endif
 }
 
 #endif /* CONFIG_HAVE_LONG_DOUBLE */
@@ -0,0 +1,127 @@
+/****************************************************************************
+ * libs/libdsp/dsp_b16.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBDSP_DSP_B16_H
+#define __LIBS_LIBDSP_DSP_B16_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Branch-free (on targets with conditional select) min/max */
+
+#define B16_MIN(a, b)       ((a) < (b) ? (a) : (b))
+#define B16_MAX(a, b)       ((a) > (b) ? (a) : (b))
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/* Kernels shared by the public b16_t functions and foc_process_b16().
+ * Keeping them inline lets the whole current loop compile to a single
+ * function without calls between the stages. Sums of products are
+ * accumulated in 64 bits and rounded once.
+ */
+
+/****************************************************************************
+ * Name: clarke_b16
+ ****************************************************************************/
+
+static inline void clarke_b16(FAR const abc_frame_b16_t *abc,
+                              FAR ab_frame_b16_t *ab)
+{
+  ab->a = abc->a;
+  ab->b = (b16_t)(((int64_t)ONE_BY_SQRT3_B16 * abc->a +
+                   (int64_t)TWO_BY_SQRT3_B16 * abc->b + b16HALF) >> 16);
+}
+
+/****************************************************************************
+ * Name: park_b16
+ ****************************************************************************/
+
+static inline void park_b16(FAR const phase_angle_b16_t *angle,
+                            FAR const ab_frame_b16_t *ab,
+                            FAR dq_frame_b16_t *dq)
+{
+  dq->d = (b16_t)(((int64_t)angle->cos * ab->a +
+                   (int64_t)angle->sin * ab->b + b16HALF) >> 16);
+  dq->q = (b16_t)(((int64_t)angle->cos * ab->b -
+                   (int64_t)angle->sin * ab->a + b16HALF) >> 16);
+}
+
+/****************************************************************************
+ * Name: inv_park_b16
+ ****************************************************************************/
+
+static inline void inv_park_b16(FAR const phase_angle_b16_t *angle,
+                                FAR const dq_frame_b16_t *dq,
+                                FAR ab_frame_b16_t *ab)
+{
+  ab->a = (b16_t)(((int64_t)angle->cos * dq->d -
+                   (int64_t)angle->sin * dq->q + b16HALF) >> 16);
+  ab->b = (b16_t)(((int64_t)angle->cos * dq->q +
+                   (int64_t)angle->sin * dq->d + b16HALF) >> 16);
+}
+
+/****************************************************************************
+ * Name: pid_b16
+ *
+ * Description:
+ *   PID step with output saturation. Anti-windup limits the integral part
+ *   to the output range instead of resetting it, which needs no
+ *   branches on the sign of the error.
+ *
+ ****************************************************************************/
+
+static inline b16_t pid_b16(FAR pid_controller_b16_t *pid, b16_t err)
+{
+  int64_t min = (int64_t)pid->sat_min << 16;
+  int64_t max = (int64_t)pid->sat_max << 16;
+  int64_t acc;
+
+  pid->err = err;
+
+  /* Integral part in Q32 */
+
+  acc           = pid->integral + (int64_t)pid->KI * err;
+  acc           = B16_MAX(acc, min);
+  pid->integral = B16_MIN(acc, max);
+
+  /* Proportional and derivative parts */
+
+  acc = pid->integral + (int64_t)pid->KP * err +
+        (int64_t)pid->KD * (err - pid->err_prev);
+
+  pid->err_prev = err;
+
+  acc      = B16_MAX(acc, min);
+  acc      = B16_MIN(acc, max);
+  pid->out = (b16_t)(acc >> 16);
+
+  return pid->out;
+}
+
+#endif /* __LIBS_LIBDSP_DSP_B16_H */
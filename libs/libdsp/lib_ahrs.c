@@ -0,0 +1,853 @@
+/****************************************************************************
+ * libs/libdsp/lib_ahrs.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Q1.30 constants and helpers used by the fixed-point filters */
+
+#define Q30_ONE             ((int32_t)1 << 30)
+#define Q30_HALF            ((int32_t)1 << 29)
+#define Q30_ONE_AND_HALF    (Q30_ONE + Q30_HALF)
+
+#define q30mul(a, b)        ((int32_t)(((int64_t)(a) * (b)) >> 30))
+#define q30tob16(a)         ((b16_t)((a) >> 14))
+
+/* b16_t value multiplied by a Q1.30 value gives Q1.30 */
+
+#define b16mulq30(a, b)     ((int32_t)(((int64_t)(a) * (b)) >> 16))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: quat_normalize
+ ****************************************************************************/
+
+static inline void quat_normalize(FAR quat_t *q)
+{
+  float inv = fast_rsqrt(q->w * q->w + q->x * q->x +
+                         q->y * q->y + q->z * q->z);
+
+  q->w *= inv;
+  q->x *= inv;
+  q->y *= inv;
+  q->z *= inv;
+}
+
+/****************************************************************************
+ * Name: quat_integrate
+ *
+ * Description:
+ *   q += q (x) (0, h), where h is angular rate multiplied by per/2
+ *
+ ****************************************************************************/
+
+static inline void quat_integrate(FAR quat_t *q, float hx, float hy,
+                                  float hz)
+{
+  float w = q->w;
+  float x = q->x;
+  float y = q->y;
+  float z = q->z;
+
+  q->w += -x * hx - y * hy - z * hz;
+  q->x +=  w * hx + y * hz - z * hy;
+  q->y +=  w * hy - x * hz + z * hx;
+  q->z +=  w * hz + x * hy - y * hx;
+}
+
+/****************************************************************************
+ * Name: ahrs_cf_step
+ ****************************************************************************/
+
+static inline void ahrs_cf_step(FAR struct ahrs_cf_s *cf,
+                                FAR const float *gyr,
+                                FAR const float *acc)
+{
+  FAR quat_t *q = &cf->q;
+  float gx      = gyr[0];
+  float gy      = gyr[1];
+  float gz      = gyr[2];
+  float ax      = acc[0];
+  float ay      = acc[1];
+  float az      = acc[2];
+  float norm    = ax * ax + ay * ay + az * az;
+  float vx      = 0.0f;
+  float vy      = 0.0f;
+  float vz      = 0.0f;
+  float ex      = 0.0f;
+  float ey      = 0.0f;
+  float ez      = 0.0f;
+
+  /* Accelerometer feedback only if the measurement is valid */
+
+  if (norm > 0.0f)
+    {
+      norm = fast_rsqrt(norm);
+      ax *= norm;
+      ay *= norm;
+      az *= norm;
+
+      /* Estimated direction of gravity (half of it) */
+
+      vx = q->x * q->z - q->w * q->y;
+      vy = q->w * q->x + q->y * q->z;
+      vz = q->w * q->w - 0.5f + q->z * q->z;
+
+      /* Error is the cross product between estimated and measured
+       * direction of gravity.
+       */
+
+      ex = ay * vz - az * vy;
+      ey = az * vx - ax * vz;
+      ez = ax * vy - ay * vx;
+
+      /* Integral feedback */
+
+      cf->bias[0] += cf->kidt2 * ex;
+      cf->bias[1] += cf->kidt2 * ey;
+      cf->bias[2] += cf->kidt2 * ez;
+
+      /* Proportional and integral feedback */
+
+      gx += cf->kp2 * ex + cf->bias[0];
+      gy += cf->kp2 * ey + cf->bias[1];
+      gz += cf->kp2 * ez + cf->bias[2];
+    }
+
+  quat_integrate(q, gx * cf->halfdt, gy * cf->halfdt, gz * cf->halfdt);
+  quat_normalize(q);
+}
+
+/****************************************************************************
+ * Name: ahrs_madgwick_step
+ ****************************************************************************/
+
+static inline void ahrs_madgwick_step(FAR struct ahrs_madgwick_s *mw,
+                                      FAR const float *gyr,
+                                      FAR const float *acc)
+{
+  FAR quat_t *q = &mw->q;
+  float ax      = acc[0];
+  float ay      = acc[1];
+  float az      = acc[2];
+  float norm    = ax * ax + ay * ay + az * az;
+  float q0      = q->w;
+  float q1      = q->x;
+  float q2      = q->y;
+  float q3      = q->z;
+  float s0      = 0.0f;
+  float s1      = 0.0f;
+  float s2      = 0.0f;
+  float s3      = 0.0f;
+  float q1q1;
+  float q2q2;
+  float q0q0;
+  float q3q3;
+
+  /* Integrate the rate of change from gyroscope */
+
+  quat_integrate(q, 0.5f * mw->dt * gyr[0], 0.5f * mw->dt * gyr[1],
+                 0.5f * mw->dt * gyr[2]);
+
+  /* Gradient descent step only if the accelerometer data is valid */
+
+  if (norm > 0.0f)
+    {
+      norm = fast_rsqrt(norm);
+      ax *= norm;
+      ay *= norm;
+      az *= norm;
+
+      q0q0 = q0 * q0;
+      q1q1 = q1 * q1;
+      q2q2 = q2 * q2;
+      q3q3 = q3 * q3;
+
+      /* Gradient of the objective function */
+
+      s0 = 4.0f * q0 * (q2q2 + q1q1) + 2.0f * (q2 * ax - q1 * ay);
+      s1 = 4.0f * q1 * (q3q3 + q0q0 - 1.0f + 2.0f * (q1q1 + q2q2) + az) -
+           2.0f * (q3 * ax + q0 * ay);
+      s2 = 4.0f * q2 * (q0q0 + q3q3 - 1.0f + 2.0f * (q1q1 + q2q2) + az) +
+           2.0f * (q0 * ax - q3 * ay);
+      s3 = 4.0f * q3 * (q1q1 + q2q2) - 2.0f * (q1 * ax + q2 * ay);
+
+      norm = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+      if (norm > 0.0f)
+        {
+          norm = mw->beta * mw->dt * fast_rsqrt(norm);
+
+          q->w -= norm * s0;
+          q->x -= norm * s1;
+          q->y -= norm * s2;
+          q->z -= norm * s3;
+        }
+    }
+
+  quat_normalize(q);
+}
+
+/****************************************************************************
+ * Name: q30_normalize
+ *
+ * Description:
+ *   Normalize Q1.30 quaternion. The quaternion is renormalized after each
+ *   update so its norm stays close to one and a single Newton-Raphson
+ *   iteration started from 1.0 is enough.
+ *
+ ****************************************************************************/
+
+static inline void q30_normalize(FAR int32_t *q)
+{
+  int64_t n = (int64_t)q[0] * q[0] + (int64_t)q[1] * q[1] +
+              (int64_t)q[2] * q[2] + (int64_t)q[3] * q[3];
+  int32_t k = Q30_ONE_AND_HALF - (int32_t)(n >> 31);
+
+  q[0] = q30mul(q[0], k);
+  q[1] = q30mul(q[1], k);
+  q[2] = q30mul(q[2], k);
+  q[3] = q30mul(q[3], k);
+}
+
+/****************************************************************************
+ * Name: q30_integrate
+ ****************************************************************************/
+
+static inline void q30_integrate(FAR int32_t *q, int32_t hx, int32_t hy,
+                                 int32_t hz)
+{
+  int32_t w = q[0];
+  int32_t x = q[1];
+  int32_t y = q[2];
+  int32_t z = q[3];
+
+  q[0] += -q30mul(x, hx) - q30mul(y, hy) - q30mul(z, hz);
+  q[1] +=  q30mul(w, hx) + q30mul(y, hz) - q30mul(z, hy);
+  q[2] +=  q30mul(w, hy) - q30mul(x, hz) + q30mul(z, hx);
+  q[3] +=  q30mul(w, hz) + q30mul(x, hy) - q30mul(y, hx);
+}
+
+/****************************************************************************
+ * Name: b16_unit3
+ *
+ * Description:
+ *   Normalize b16_t 3D vector, the result is in Q1.30.
+ *
+ * Returned Value:
+ *   false if the vector has zero length
+ *
+ ****************************************************************************/
+
+static inline bool b16_unit3(FAR const b16_t *v, FAR int32_t *u)
+{
+  uint64_t n = (uint64_t)((int64_t)v[0] * v[0]) +
+               (uint64_t)((int64_t)v[1] * v[1]) +
+               (uint64_t)((int64_t)v[2] * v[2]);
+  uint32_t y = 0;
+  int shift  = 0;
+
+  if (n == 0)
+    {
+      return false;
+    }
+
+  /* v is b16_t, so |v| = sqrt(n) in the same raw units */
+
+  y     = fixed_rsqrt(n, &shift);
+  shift = shift - 30;
+
+  u[0] = (int32_t)(((int64_t)v[0] * y) >> shift);
+  u[1] = (int32_t)(((int64_t)v[1] * y) >> shift);
+  u[2] = (int32_t)(((int64_t)v[2] * y) >> shift);
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: ahrs_cf_b16_step
+ ****************************************************************************/
+
+static inline void ahrs_cf_b16_step(FAR struct ahrs_cf_b16_s *cf,
+                                    FAR const b16_t *gyr,
+                                    FAR const b16_t *acc)
+{
+  FAR int32_t *q = cf->q;
+  b16_t gx       = gyr[0];
+  b16_t gy       = gyr[1];
+  b16_t gz       = gyr[2];
+  int32_t a[3];
+  int32_t vx;
+  int32_t vy;
+  int32_t vz;
+  int32_t ex;
+  int32_t ey;
+  int32_t ez;
+
+  if (b16_unit3(acc, a))
+    {
+      /* Estimated direction of gravity (half of it) */
+
+      vx = q30mul(q[1], q[3]) - q30mul(q[0], q[2]);
+      vy = q30mul(q[0], q[1]) + q30mul(q[2], q[3]);
+      vz = q30mul(q[0], q[0]) - Q30_HALF + q30mul(q[3], q[3]);
+
+      /* Error is the cross product between estimated and measured
+       * direction of gravity.
+       */
+
+      ex = q30mul(a[1], vz) - q30mul(a[2], vy);
+      ey = q30mul(a[2], vx) - q30mul(a[0], vz);
+      ez = q30mul(a[0], vy) - q30mul(a[1], vx);
+
+      /* Integral feedback in Q8.24 */
+
+      cf->bias[0] += (int32_t)(((int64_t)ex * cf->kidt2) >> 36);
+      cf->bias[1] += (int32_t)(((int64_t)ey * cf->kidt2) >> 36);
+      cf->bias[2] += (int32_t)(((int64_t)ez * cf->kidt2) >> 36);
+
+      /* Proportional and integral feedback in b16_t */
+
+      gx += (b16_t)(((int64_t)ex * cf->kp2) >> 30) + (cf->bias[0] >> 8);
+      gy += (b16_t)(((int64_t)ey * cf->kp2) >> 30) + (cf->bias[1] >> 8);
+      gz += (b16_t)(((int64_t)ez * cf->kp2) >> 30) + (cf->bias[2] >> 8);
+    }
+
+  q30_integrate(q, b16mulq30(gx, cf->halfdt), b16mulq30(gy, cf->halfdt),
+                b16mulq30(gz, cf->halfdt));
+  q30_normalize(q);
+}
+
+/****************************************************************************
+ * Name: ahrs_madgwick_b16_step
+ ****************************************************************************/
+
+static inline void ahrs_madgwick_b16_step(FAR struct ahrs_madgwick_b16_s *mw,
+                                          FAR const b16_t *gyr,
+                                          FAR const b16_t *acc)
+{
+  FAR int32_t *q = mw->q;
+  int32_t a[3];
+  b16_t q0;
+  b16_t q1;
+  b16_t q2;
+  b16_t q3;
+  b16_t ax;
+  b16_t ay;
+  b16_t az;
+  b16_t q0q0;
+  b16_t q1q1;
+  b16_t q2q2;
+  b16_t q3q3;
+  b16_t s[4];
+  uint64_t n;
+  uint32_t y;
+  int shift;
+  int i;
+
+  if (b16_unit3(acc, a))
+    {
+      /* The gradient only gives a direction, b16_t is good enough here */
+
+      q0 = q30tob16(q[0]);
+      q1 = q30tob16(q[1]);
+      q2 = q30tob16(q[2]);
+      q3 = q30tob16(q[3]);
+      ax = q30tob16(a[0]);
+      ay = q30tob16(a[1]);
+      az = q30tob16(a[2]);
+
+      q0q0 = b16mulb16(q0, q0);
+      q1q1 = b16mulb16(q1, q1);
+      q2q2 = b16mulb16(q2, q2);
+      q3q3 = b16mulb16(q3, q3);
+
+      s[0] = 4 * b16mulb16(q0, q2q2 + q1q1) +
+             2 * (b16mulb16(q2, ax) - b16mulb16(q1, ay));
+      s[1] = 4 * b16mulb16(q1, q3q3 + q0q0 - b16ONE +
+                           2 * (q1q1 + q2q2) + az) -
+             2 * (b16mulb16(q3, ax) + b16mulb16(q0, ay));
+      s[2] = 4 * b16mulb16(q2, q0q0 + q3q3 - b16ONE +
+                           2 * (q1q1 + q2q2) + az) +
+             2 * (b16mulb16(q0, ax) - b16mulb16(q3, ay));
+      s[3] = 4 * b16mulb16(q3, q1q1 + q2q2) -
+             2 * (b16mulb16(q1, ax) + b16mulb16(q2, ay));
+
+      n = (uint64_t)((int64_t)s[0] * s[0]) +
+          (uint64_t)((int64_t)s[1] * s[1]) +
+          (uint64_t)((int64_t)s[2] * s[2]) +
+          (uint64_t)((int64_t)s[3] * s[3]);
+
+      if (n != 0)
+        {
+          /* Normalized gradient multiplied by beta, in b16_t */
+
+          y     = fixed_rsqrt(n, &shift);
+          shift = shift - 16;
+
+          for (i = 0; i < 4; i++)
+            {
+              s[i] = (b16_t)(((int64_t)s[i] * y) >> shift);
+              s[i] = b16mulb16(s[i], mw->beta);
+            }
+        }
+    }
+  else
+    {
+      s[0] = s[1] = s[2] = s[3] = 0;
+    }
+
+  /* Integrate the rate of change from gyroscope and the gradient step */
+
+  q30_integrate(q, b16mulq30(gyr[0], mw->halfdt),
+                b16mulq30(gyr[1], mw->halfdt),
+                b16mulq30(gyr[2], mw->halfdt));
+
+  q[0] -= b16mulq30(s[0], mw->dt);
+  q[1] -= b16mulq30(s[1], mw->dt);
+  q[2] -= b16mulq30(s[2], mw->dt);
+  q[3] -= b16mulq30(s[3], mw->dt);
+
+  q30_normalize(q);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ahrs_cf_init
+ *
+ * Description:
+ *   Initialize quaternion complementary filter (Mahony). Attitude is reset
+ *   to the identity quaternion.
+ *
+ *   REFERENCE: R. Mahony, T. Hamel, J.-M. Pflimlin, "Nonlinear
+ *   Complementary Filters on the Special Orthogonal Group", 2008.
+ *
+ * Input Parameters:
+ *   cf  - (out) pointer to the filter data
+ *   kp  - (in) proportional gain
+ *   ki  - (in) integral gain (0.0 disables the gyroscope bias estimation)
+ *   per - (in) filter execution period in seconds
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ahrs_cf_init(FAR struct ahrs_cf_s *cf, float kp, float ki, float per)
+{
+  DEBUGASSERT(cf != NULL);
+  DEBUGASSERT(per > 0.0f);
+
+  memset(cf, 0, sizeof(struct ahrs_cf_s));
+
+  cf->q.w    = 1.0f;
+  cf->kp2    = 2.0f * kp;
+  cf->kidt2  = 2.0f * ki * per;
+  cf->halfdt = 0.5f * per;
+}
+
+/****************************************************************************
+ * Name: ahrs_cf_update
+ *
+ * Description:
+ *   Update attitude estimate with one gyroscope and accelerometer sample.
+ *
+ * Input Parameters:
+ *   cf  - (in/out) pointer to the filter data
+ *   gyr - (in) angular rate {x, y, z} in rad/s
+ *   acc - (in) acceleration {x, y, z}, the unit is not important
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ahrs_cf_update(FAR struct ahrs_cf_s *cf, FAR const float *gyr,
+                    FAR const float *acc)
+{
+  DEBUGASSERT(cf != NULL);
+  DEBUGASSERT(gyr != NULL);
+  DEBUGASSERT(acc != NULL);
+
+  ahrs_cf_step(cf, gyr, acc);
+}
+
+/****************************************************************************
+ * Name: ahrs_cf_process
+ *
+ * Description:
+ *   Update attitude estimate with a block of samples, for example a whole
+ *   sensor FIFO. Samples are interleaved {x, y, z} triplets.
+ *
+ * Input Parameters:
+ *   cf  - (in/out) pointer to the filter data
+ *   gyr - (in) n angular rate samples in rad/s
+ *   acc - (in) n acceleration samples
+ *   n   - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ahrs_cf_process(FAR struct ahrs_cf_s *cf, FAR const float *gyr,
+                     FAR const float *acc, size_t n)
+{
+  DEBUGASSERT(cf != NULL);
+  DEBUGASSERT(gyr != NULL);
+  DEBUGASSERT(acc != NULL);
+
+  for (; n > 0; n--, gyr += 3, acc += 3)
+    {
+      ahrs_cf_step(cf, gyr, acc);
+    }
+}
+
+/****************************************************************************
+ * Name: ahrs_madgwick_init
+ *
+ * Description:
+ *   Initialize Madgwick gradient descent orientation filter. Attitude is
+ *   reset to the identity quaternion.
+ *
+ *   REFERENCE: S. Madgwick, "An efficient orientation filter for inertial
+ *   and inertial/magnetic sensor arrays", 2010.
+ *
+ * Input Parameters:
+ *   mw   - (out) pointer to the filter data
+ *   beta - (in) filter gain
+ *   per  - (in) filter execution period in seconds
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ahrs_madgwick_init(FAR struct ahrs_madgwick_s *mw, float beta,
+                        float per)
+{
+  DEBUGASSERT(mw != NULL);
+  DEBUGASSERT(per > 0.0f);
+
+  memset(mw, 0, sizeof(struct ahrs_madgwick_s));
+
+  mw->q.w  = 1.0f;
+  mw->beta = beta;
+  mw->dt   = per;
+}
+
+/****************************************************************************
+ * Name: ahrs_madgwick_update
+ *
+ * Description:
+ *   Update attitude estimate with one gyroscope and accelerometer sample.
+ *
+ * Input Parameters:
+ *   mw  - (in/out) pointer to the filter data
+ *   gyr - (in) angular rate {x, y, z} in rad/s
+ *   acc - (in) acceleration {x, y, z}, the unit is not important
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ahrs_madgwick_update(FAR struct ahrs_madgwick_s *mw,
+                          FAR const float *gyr, FAR const float *acc)
+{
+  DEBUGASSERT(mw != NULL);
+  DEBUGASSERT(gyr != NULL);
+  DEBUGASSERT(acc != NULL);
+
+  ahrs_madgwick_step(mw, gyr, acc);
+}
+
+/****************************************************************************
+ * Name: ahrs_madgwick_process
+ *
+ * Description:
+ *   Update attitude estimate with a block of interleaved {x, y, z} samples.
+ *
+ * Input Parameters:
+ *   mw  - (in/out) pointer to the filter data
+ *   gyr - (in) n angular rate samples in rad/s
+ *   acc - (in) n acceleration samples
+ *   n   - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ahrs_madgwick_process(FAR struct ahrs_madgwick_s *mw,
+                           FAR const float *gyr, FAR const float *acc,
+                           size_t n)
+{
+  DEBUGASSERT(mw != NULL);
+  DEBUGASSERT(gyr != NULL);
+  DEBUGASSERT(acc != NULL);
+
+  for (; n > 0; n--, gyr += 3, acc += 3)
+    {
+      ahrs_madgwick_step(mw, gyr, acc);
+    }
+}
+
+/****************************************************************************
+ * Name: ahrs_cf_b16_init
+ *
+ * Description:
+ *   Initialize fixed-point quaternion complementary filter. The execution
+ *   rate is given in Hz, as b16_t period would lose up to 1% of the
+ *   integrated angle at kHz rates.
+ *
+ * Input Parameters:
+ *   cf  - (out) pointer to the filter data
+ *   kp  - (in) proportional gain
+ *   ki  - (in) integral gain
+ *   fs  - (in) filter execution frequency in Hz
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ahrs_cf_b16_init(FAR struct ahrs_cf_b16_s *cf, b16_t kp, b16_t ki,
+                      uint32_t fs)
+{
+  DEBUGASSERT(cf != NULL);
+  DEBUGASSERT(fs > 1);
+
+  memset(cf, 0, sizeof(struct ahrs_cf_b16_s));
+
+  cf->q[0]   = Q30_ONE;
+  cf->kp2    = 2 * kp;
+  cf->kidt2  = (int32_t)(((int64_t)ki << 15) / fs);
+  cf->halfdt = Q30_HALF / fs;
+}
+
+/****************************************************************************
+ * Name: ahrs_cf_b16_update
+ *
+ * Description:
+ *   Update attitude estimate with one gyroscope and accelerometer sample.
+ *
+ * Input Parameters:
+ *   cf  - (in/out) pointer to the filter data
+ *   gyr - (in) angular rate {x, y, z} in rad/s
+ *   acc - (in) acceleration {x, y, z}, the unit is not important
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ahrs_cf_b16_update(FAR struct ahrs_cf_b16_s *cf,
+                        FAR const b16_t *gyr, FAR const b16_t *acc)
+{
+  DEBUGASSERT(cf != NULL);
+  DEBUGASSERT(gyr != NULL);
+  DEBUGASSERT(acc != NULL);
+
+  ahrs_cf_b16_step(cf, gyr, acc);
+}
+
+/****************************************************************************
+ * Name: ahrs_cf_b16_process
+ *
+ * Description:
+ *   Update attitude estimate with a block of interleaved {x, y, z} samples.
+ *
+ * Input Parameters:
+ *   cf  - (in/out) pointer to the filter data
+ *   gyr - (in) n angular rate samples in rad/s
+ *   acc - (in) n acceleration samples
+ *   n   - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ahrs_cf_b16_process(FAR struct ahrs_cf_b16_s *cf,
+                         FAR const b16_t *gyr, FAR const b16_t *acc,
+                         size_t n)
+{
+  DEBUGASSERT(cf != NULL);
+  DEBUGASSERT(gyr != NULL);
+  DEBUGASSERT(acc != NULL);
+
+  for (; n > 0; n--, gyr += 3, acc += 3)
+    {
+      ahrs_cf_b16_step(cf, gyr, acc);
+    }
+}
+
+/****************************************************************************
+ * Name: ahrs_cf_b16_quat_get
+ *
+ * Description:
+ *   Get attitude estimate of the fixed-point complementary filter.
+ *
+ * Input Parameters:
+ *   cf - (in) pointer to the filter data
+ *   q  - (out) attitude quaternion
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ahrs_cf_b16_quat_get(FAR struct ahrs_cf_b16_s *cf, FAR quat_b16_t *q)
+{
+  DEBUGASSERT(cf != NULL);
+  DEBUGASSERT(q != NULL);
+
+  q->w = q30tob16(cf->q[0]);
+  q->x = q30tob16(cf->q[1]);
+  q->y = q30tob16(cf->q[2]);
+  q->z = q30tob16(cf->q[3]);
+}
+
+/****************************************************************************
+ * Name: ahrs_madgwick_b16_init
+ *
+ * Description:
+ *   Initialize fixed-point Madgwick filter.
+ *
+ * Input Parameters:
+ *   mw   - (out) pointer to the filter data
+ *   beta - (in) filter gain
+ *   fs   - (in) filter execution frequency in Hz
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ahrs_madgwick_b16_init(FAR struct ahrs_madgwick_b16_s *mw, b16_t beta,
+                            uint32_t fs)
+{
+  DEBUGASSERT(mw != NULL);
+  DEBUGASSERT(fs > 1);
+
+  memset(mw, 0, sizeof(struct ahrs_madgwick_b16_s));
+
+  mw->q[0]   = Q30_ONE;
+  mw->beta   = beta;
+  mw->dt     = Q30_ONE / fs;
+  mw->halfdt = Q30_HALF / fs;
+}
+
+/****************************************************************************
+ * Name: ahrs_madgwick_b16_update
+ *
+ * Description:
+ *   Update attitude estimate with one gyroscope and accelerometer sample.
+ *
+ * Input Parameters:
+ *   mw  - (in/out) pointer to the filter data
+ *   gyr - (in) angular rate {x, y, z} in rad/s
+ *   acc - (in) acceleration {x, y, z}, the unit is not important
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ahrs_madgwick_b16_update(FAR struct ahrs_madgwick_b16_s *mw,
+                              FAR const b16_t *gyr, FAR const b16_t *acc)
+{
+  DEBUGASSERT(mw != NULL);
+  DEBUGASSERT(gyr != NULL);
+  DEBUGASSERT(acc != NULL);
+
+  ahrs_madgwick_b16_step(mw, gyr, acc);
+}
+
+/****************************************************************************
+ * Name: ahrs_madgwick_b16_process
+ *
+ * Description:
+ *   Update attitude estimate with a block of interleaved {x, y, z} samples.
+ *
+ * Input Parameters:
+ *   mw  - (in/out) pointer to the filter data
+ *   gyr - (in) n angular rate samples in rad/s
+ *   acc - (in) n acceleration samples
+ *   n   - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ahrs_madgwick_b16_process(FAR struct ahrs_madgwick_b16_s *mw,
+                               FAR const b16_t *gyr, FAR const b16_t *acc,
+                               size_t n)
+{
+  DEBUGASSERT(mw != NULL);
+  DEBUGASSERT(gyr != NULL);
+  DEBUGASSERT(acc != NULL);
+
+  for (; n > 0; n--, gyr += 3, acc += 3)
+    {
+      ahrs_madgwick_b16_step(mw, gyr, acc);
+    }
+}
+
+/****************************************************************************
+ * Name: ahrs_madgwick_b16_quat_get
+ *
+ * Description:
+ *   Get attitude estimate of the fixed-point Madgwick filter.
+ *
+ * Input Parameters:
+ *   mw - (in) pointer to the filter data
+ *   q  - (out) attitude quaternion
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ahrs_madgwick_b16_quat_get(FAR struct ahrs_madgwick_b16_s *mw,
+                                FAR quat_b16_t *q)
+{
+  DEBUGASSERT(mw != NULL);
+  DEBUGASSERT(q != NULL);
+
+  q->w = q30tob16(mw->q[0]);
+  q->x = q30tob16(mw->q[1]);
+  q->y = q30tob16(mw->q[2]);
+  q->z = q30tob16(mw->q[3]);
+}
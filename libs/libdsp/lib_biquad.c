@@ -0,0 +1,362 @@
+/****************************************************************************
+ * libs/libdsp/lib_biquad.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: biquad_init
+ *
+ * Description:
+ *   Initialize cascade of second order IIR sections and clear its state.
+ *
+ * Input Parameters:
+ *   bq      - (out) pointer to the biquad cascade data
+ *   coeff   - (in) 5 coefficients {b0, b1, b2, a1, a2} per section
+ *   state   - (in) state buffer, must hold 2*nstages values
+ *   nstages - (in) number of sections
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void biquad_init(FAR struct biquad_s *bq, FAR const float *coeff,
+                 FAR float *state, uint8_t nstages)
+{
+  DEBUGASSERT(bq != NULL);
+  DEBUGASSERT(coeff != NULL);
+  DEBUGASSERT(state != NULL);
+  DEBUGASSERT(nstages > 0);
+
+  bq->coeff   = coeff;
+  bq->state   = state;
+  bq->nstages = nstages;
+
+  biquad_reset(bq);
+}
+
+/****************************************************************************
+ * Name: biquad_reset
+ *
+ * Description:
+ *   Clear state of the biquad cascade.
+ *
+ * Input Parameters:
+ *   bq - (in/out) pointer to the biquad cascade data
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void biquad_reset(FAR struct biquad_s *bq)
+{
+  DEBUGASSERT(bq != NULL);
+
+  memset(bq->state, 0, 2 * bq->nstages * sizeof(float));
+}
+
+/****************************************************************************
+ * Name: biquad_process
+ *
+ * Description:
+ *   Filter a block of samples in place. The whole block is passed through
+ *   one section before the next one, so coefficients and state of the
+ *   current section stay in registers for the inner loop.
+ *
+ * Input Parameters:
+ *   bq   - (in/out) pointer to the biquad cascade data
+ *   data - (in/out) samples to be filtered
+ *   n    - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void biquad_process(FAR struct biquad_s *bq, FAR float *data, size_t n)
+{
+  FAR const float *coeff = NULL;
+  FAR float *state       = NULL;
+  uint8_t stage          = 0;
+  size_t i               = 0;
+  float b0;
+  float b1;
+  float b2;
+  float a1;
+  float a2;
+  float s1;
+  float s2;
+  float x;
+  float y;
+
+  DEBUGASSERT(bq != NULL);
+  DEBUGASSERT(data != NULL);
+
+  coeff = bq->coeff;
+  state = bq->state;
+
+  for (stage = 0; stage < bq->nstages; stage++, coeff += 5, state += 2)
+    {
+      b0 = coeff[0];
+      b1 = coeff[1];
+      b2 = coeff[2];
+      a1 = coeff[3];
+      a2 = coeff[4];
+      s1 = state[0];
+      s2 = state[1];
+
+      /* Transposed direct form II */
+
+      for (i = 0; i < n; i++)
+        {
+          x       = data[i];
+          y       = b0 * x + s1;
+          s1      = b1 * x - a1 * y + s2;
+          s2      = b2 * x - a2 * y;
+          data[i] = y;
+        }
+
+      state[0] = s1;
+      state[1] = s2;
+    }
+}
+
+/****************************************************************************
+ * Name: biquad_lowpass_coeff
+ *
+ * Description:
+ *   Calculate second order low pass section coefficients.
+ *
+ *   REFERENCE: R. Bristow-Johnson, "Cookbook formulae for audio EQ biquad
+ *   filter coefficients"
+ *
+ * Input Parameters:
+ *   coeff - (out) 5 section coefficients
+ *   fc    - (in) cutoff frequency
+ *   fs    - (in) sampling frequency
+ *   q     - (in) quality factor (0.7071 for Butterworth response)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void biquad_lowpass_coeff(FAR float *coeff, float fc, float fs, float q)
+{
+  float w0    = 0.0f;
+  float cs    = 0.0f;
+  float alpha = 0.0f;
+  float a0    = 0.0f;
+
+  DEBUGASSERT(coeff != NULL);
+  DEBUGASSERT(fc > 0.0f && fc < fs / 2.0f);
+  DEBUGASSERT(q > 0.0f);
+
+  w0    = 2.0f * M_PI_F * fc / fs;
+  cs    = cosf(w0);
+  alpha = sinf(w0) / (2.0f * q);
+  a0    = 1.0f / (1.0f + alpha);
+
+  coeff[0] = 0.5f * (1.0f - cs) * a0;
+  coeff[1] = (1.0f - cs) * a0;
+  coeff[2] = coeff[0];
+  coeff[3] = -2.0f * cs * a0;
+  coeff[4] = (1.0f - alpha) * a0;
+}
+
+/****************************************************************************
+ * Name: biquad_notch_coeff
+ *
+ * Description:
+ *   Calculate second order notch section coefficients.
+ *
+ * Input Parameters:
+ *   coeff - (out) 5 section coefficients
+ *   fc    - (in) notch center frequency
+ *   fs    - (in) sampling frequency
+ *   q     - (in) quality factor (center frequency / bandwidth)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void biquad_notch_coeff(FAR float *coeff, float fc, float fs, float q)
+{
+  float w0    = 0.0f;
+  float cs    = 0.0f;
+  float alpha = 0.0f;
+  float a0    = 0.0f;
+
+  DEBUGASSERT(coeff != NULL);
+  DEBUGASSERT(fc > 0.0f && fc < fs / 2.0f);
+  DEBUGASSERT(q > 0.0f);
+
+  w0    = 2.0f * M_PI_F * fc / fs;
+  cs    = cosf(w0);
+  alpha = sinf(w0) / (2.0f * q);
+  a0    = 1.0f / (1.0f + alpha);
+
+  coeff[0] = a0;
+  coeff[1] = -2.0f * cs * a0;
+  coeff[2] = a0;
+  coeff[3] = coeff[1];
+  coeff[4] = (1.0f - alpha) * a0;
+}
+
+/****************************************************************************
+ * Name: biquad_b16_init
+ *
+ * Description:
+ *   Initialize fixed-point biquad cascade and clear its state.
+ *
+ *   b16_t coefficients have a resolution of 1.5e-5, cutoff frequencies
+ *   below about fs/500 should use the floating point version.
+ *
+ * Input Parameters:
+ *   bq      - (out) pointer to the biquad cascade data
+ *   coeff   - (in) 5 coefficients {b0, b1, b2, a1, a2} per section
+ *   state   - (in) state buffer, must hold 4*nstages values
+ *   nstages - (in) number of sections
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void biquad_b16_init(FAR struct biquad_b16_s *bq, FAR const b16_t *coeff,
+                     FAR b16_t *state, uint8_t nstages)
+{
+  DEBUGASSERT(bq != NULL);
+  DEBUGASSERT(coeff != NULL);
+  DEBUGASSERT(state != NULL);
+  DEBUGASSERT(nstages > 0);
+
+  bq->coeff   = coeff;
+  bq->state   = state;
+  bq->nstages = nstages;
+
+  biquad_b16_reset(bq);
+}
+
+/****************************************************************************
+ * Name: biquad_b16_reset
+ *
+ * Description:
+ *   Clear state of the fixed-point biquad cascade.
+ *
+ * Input Parameters:
+ *   bq - (in/out) pointer to the biquad cascade data
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void biquad_b16_reset(FAR struct biquad_b16_s *bq)
+{
+  DEBUGASSERT(bq != NULL);
+
+  memset(bq->state, 0, 4 * bq->nstages * sizeof(b16_t));
+}
+
+/****************************************************************************
+ * Name: biquad_b16_process
+ *
+ * Description:
+ *   Filter a block of b16_t samples in place. Direct form I is used so
+ *   that the only rounding happens once per section output, the sum of
+ *   products is kept in a 64-bit accumulator.
+ *
+ * Input Parameters:
+ *   bq   - (in/out) pointer to the biquad cascade data
+ *   data - (in/out) samples to be filtered
+ *   n    - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void biquad_b16_process(FAR struct biquad_b16_s *bq, FAR b16_t *data,
+                        size_t n)
+{
+  FAR const b16_t *coeff = NULL;
+  FAR b16_t *state       = NULL;
+  uint8_t stage          = 0;
+  size_t i               = 0;
+  int64_t acc;
+  b16_t b0;
+  b16_t b1;
+  b16_t b2;
+  b16_t a1;
+  b16_t a2;
+  b16_t x1;
+  b16_t x2;
+  b16_t y1;
+  b16_t y2;
+  b16_t x;
+
+  DEBUGASSERT(bq != NULL);
+  DEBUGASSERT(data != NULL);
+
+  coeff = bq->coeff;
+  state = bq->state;
+
+  for (stage = 0; stage < bq->nstages; stage++, coeff += 5, state += 4)
+    {
+      b0 = coeff[0];
+      b1 = coeff[1];
+      b2 = coeff[2];
+      a1 = coeff[3];
+      a2 = coeff[4];
+      x1 = state[0];
+      x2 = state[1];
+      y1 = state[2];
+      y2 = state[3];
+
+      for (i = 0; i < n; i++)
+        {
+          x   = data[i];
+          acc = (int64_t)b0 * x + (int64_t)b1 * x1 + (int64_t)b2 * x2 -
+                (int64_t)a1 * y1 - (int64_t)a2 * y2 + b16HALF;
+
+          x2      = x1;
+          x1      = x;
+          y2      = y1;
+          y1      = (b16_t)(acc >> 16);
+          data[i] = y1;
+        }
+
+      state[0] = x1;
+      state[1] = x2;
+      state[2] = y1;
+      state[3] = y2;
+    }
+}
@@ -0,0 +1,265 @@
+/****************************************************************************
+ * libs/libdsp/lib_fir.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fir_filter_init
+ *
+ * Description:
+ *   Initialize FIR filter and clear its delay line.
+ *
+ * Input Parameters:
+ *   fir   - (out) pointer to the FIR filter data
+ *   coeff - (in) filter coefficients, coeff[0] is applied to the newest
+ *           sample
+ *   state - (in) delay line buffer, must hold 2*ntaps samples
+ *   ntaps - (in) number of filter taps
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fir_filter_init(FAR struct fir_filter_s *fir, FAR const float *coeff,
+                     FAR float *state, uint16_t ntaps)
+{
+  DEBUGASSERT(fir != NULL);
+  DEBUGASSERT(coeff != NULL);
+  DEBUGASSERT(state != NULL);
+  DEBUGASSERT(ntaps > 0);
+
+  fir->coeff = coeff;
+  fir->state = state;
+  fir->ntaps = ntaps;
+
+  fir_filter_reset(fir);
+}
+
+/****************************************************************************
+ * Name: fir_filter_reset
+ *
+ * Description:
+ *   Clear FIR filter delay line.
+ *
+ * Input Parameters:
+ *   fir - (in/out) pointer to the FIR filter data
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fir_filter_reset(FAR struct fir_filter_s *fir)
+{
+  DEBUGASSERT(fir != NULL);
+
+  memset(fir->state, 0, 2 * fir->ntaps * sizeof(float));
+  fir->pos = 0;
+}
+
+/****************************************************************************
+ * Name: fir_filter_process
+ *
+ * Description:
+ *   Filter a block of samples in place.
+ *
+ *   Every sample is written twice to the delay line (at pos and
+ *   pos + ntaps), so the newest ntaps samples can be read from one
+ *   contiguous window and the inner loop needs no wrap-around checks.
+ *
+ * Input Parameters:
+ *   fir  - (in/out) pointer to the FIR filter data
+ *   data - (in/out) samples to be filtered
+ *   n    - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fir_filter_process(FAR struct fir_filter_s *fir, FAR float *data,
+                        size_t n)
+{
+  FAR const float *coeff = NULL;
+  FAR const float *x     = NULL;
+  FAR float *state       = NULL;
+  uint16_t ntaps         = 0;
+  uint16_t pos           = 0;
+  uint16_t k             = 0;
+  float acc0             = 0.0f;
+  float acc1             = 0.0f;
+
+  DEBUGASSERT(fir != NULL);
+  DEBUGASSERT(data != NULL);
+
+  coeff = fir->coeff;
+  state = fir->state;
+  ntaps = fir->ntaps;
+  pos   = fir->pos;
+
+  for (; n > 0; n--, data++)
+    {
+      /* Move the window one sample back and insert the new sample */
+
+      pos = (pos == 0 ? ntaps : pos) - 1;
+      state[pos] = state[pos + ntaps] = *data;
+
+      /* Two accumulators to break the dependency chain */
+
+      x    = &state[pos];
+      acc0 = 0.0f;
+      acc1 = 0.0f;
+
+      for (k = 0; k + 1 < ntaps; k += 2)
+        {
+          acc0 += coeff[k] * x[k];
+          acc1 += coeff[k + 1] * x[k + 1];
+        }
+
+      if (k < ntaps)
+        {
+          acc0 += coeff[k] * x[k];
+        }
+
+      *data = acc0 + acc1;
+    }
+
+  fir->pos = pos;
+}
+
+/****************************************************************************
+ * Name: fir_filter_b16_init
+ *
+ * Description:
+ *   Initialize fixed-point FIR filter and clear its delay line.
+ *
+ * Input Parameters:
+ *   fir   - (out) pointer to the FIR filter data
+ *   coeff - (in) filter coefficients, coeff[0] is applied to the newest
+ *           sample
+ *   state - (in) delay line buffer, must hold 2*ntaps samples
+ *   ntaps - (in) number of filter taps
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fir_filter_b16_init(FAR struct fir_filter_b16_s *fir,
+                         FAR const b16_t *coeff, FAR b16_t *state,
+                         uint16_t ntaps)
+{
+  DEBUGASSERT(fir != NULL);
+  DEBUGASSERT(coeff != NULL);
+  DEBUGASSERT(state != NULL);
+  DEBUGASSERT(ntaps > 0);
+
+  fir->coeff = coeff;
+  fir->state = state;
+  fir->ntaps = ntaps;
+
+  fir_filter_b16_reset(fir);
+}
+
+/****************************************************************************
+ * Name: fir_filter_b16_reset
+ *
+ * Description:
+ *   Clear fixed-point FIR filter delay line.
+ *
+ * Input Parameters:
+ *   fir - (in/out) pointer to the FIR filter data
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fir_filter_b16_reset(FAR struct fir_filter_b16_s *fir)
+{
+  DEBUGASSERT(fir != NULL);
+
+  memset(fir->state, 0, 2 * fir->ntaps * sizeof(b16_t));
+  fir->pos = 0;
+}
+
+/****************************************************************************
+ * Name: fir_filter_b16_process
+ *
+ * Description:
+ *   Filter a block of b16_t samples in place. Products are accumulated
+ *   in 64 bits and rounded once per output sample.
+ *
+ * Input Parameters:
+ *   fir  - (in/out) pointer to the FIR filter data
+ *   data - (in/out) samples to be filtered
+ *   n    - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fir_filter_b16_process(FAR struct fir_filter_b16_s *fir,
+                            FAR b16_t *data, size_t n)
+{
+  FAR const b16_t *coeff = NULL;
+  FAR const b16_t *x     = NULL;
+  FAR b16_t *state       = NULL;
+  uint16_t ntaps         = 0;
+  uint16_t pos           = 0;
+  uint16_t k             = 0;
+  int64_t acc            = 0;
+
+  DEBUGASSERT(fir != NULL);
+  DEBUGASSERT(data != NULL);
+
+  coeff = fir->coeff;
+  state = fir->state;
+  ntaps = fir->ntaps;
+  pos   = fir->pos;
+
+  for (; n > 0; n--, data++)
+    {
+      pos = (pos == 0 ? ntaps : pos) - 1;
+      state[pos] = state[pos + ntaps] = *data;
+
+      x   = &state[pos];
+      acc = b16HALF;
+
+      for (k = 0; k < ntaps; k++)
+        {
+          acc += (int64_t)coeff[k] * x[k];
+        }
+
+      *data = (b16_t)(acc >> 16);
+    }
+
+  fir->pos = pos;
+}
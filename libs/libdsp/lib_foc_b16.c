@@ -0,0 +1,173 @@
+/****************************************************************************
+ * libs/libdsp/lib_foc_b16.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+#include "dsp_b16.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: foc_init_b16
+ *
+ * Description:
+ *   Initialize b16_t FOC controller
+ *
+ * Input Parameters:
+ *   foc   - (in/out) pointer to the FOC data
+ *   id_kp - (in) KP for d current
+ *   id_ki - (in) KI for d current
+ *   iq_kp - (in) KP for q current
+ *   iq_ki - (in) KI for q current
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void foc_init_b16(FAR struct foc_data_b16_s *foc, b16_t id_kp, b16_t id_ki,
+                  b16_t iq_kp, b16_t iq_ki)
+{
+  DEBUGASSERT(foc != NULL);
+
+  memset(foc, 0, sizeof(struct foc_data_b16_s));
+
+  pi_controller_init_b16(&foc->id_pid, id_kp, id_ki);
+  pi_controller_init_b16(&foc->iq_pid, iq_kp, iq_ki);
+}
+
+/****************************************************************************
+ * Name: foc_idq_ref_set_b16
+ *
+ * Description:
+ *   Set dq reference current vector
+ *
+ * Input Parameters:
+ *   foc - (in/out) pointer to the FOC data
+ *   d   - (in) reference d current
+ *   q   - (in) reference q current
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void foc_idq_ref_set_b16(FAR struct foc_data_b16_s *foc, b16_t d, b16_t q)
+{
+  foc->i_dq_ref.d = d;
+  foc->i_dq_ref.q = q;
+}
+
+/****************************************************************************
+ * Name: foc_vbase_update_b16
+ *
+ * Description:
+ *   Update base voltage for FOC controller. This is the only place where
+ *   a division is needed, the modulation scale is kept for
+ *   foc_process_b16().
+ *
+ * Input Parameters:
+ *   foc   - (in/out) pointer to the FOC data
+ *   vbase - (in) base voltage for FOC
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void foc_vbase_update_b16(FAR struct foc_data_b16_s *foc, b16_t vbase)
+{
+  b16_t scale   = 0;
+  b16_t mag_max = 0;
+
+  /* Only if voltage is valid */
+
+  if (vbase > 0)
+    {
+      scale   = (b16_t)(((int64_t)b16ONE << 16) / vbase);
+      mag_max = vbase;
+    }
+
+  foc->vab_mod_scale = scale;
+  foc->vdq_mag_max   = mag_max;
+
+  /* Update regulators saturation */
+
+  pi_saturation_set_b16(&foc->id_pid, -mag_max, mag_max);
+  pi_saturation_set_b16(&foc->iq_pid, -mag_max, mag_max);
+}
+
+/****************************************************************************
+ * Name: foc_process_b16
+ *
+ * Description:
+ *   Process FOC (Field Oriented Control) in fixed-point. All stages are
+ *   inlined, see foc_process() for the description of the algorithm.
+ *
+ * Input Parameters:
+ *   foc   - (in/out) pointer to the FOC data
+ *   i_abc - (in) pointer to the ABC current frame
+ *   angle - (in) pointer to the phase angle data
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void foc_process_b16(FAR struct foc_data_b16_s *foc,
+                     FAR abc_frame_b16_t *i_abc,
+                     FAR phase_angle_b16_t *angle)
+{
+  DEBUGASSERT(foc != NULL);
+  DEBUGASSERT(i_abc != NULL);
+  DEBUGASSERT(angle != NULL);
+
+  foc->i_abc = *i_abc;
+
+  /* abc current -> alpha-beta current -> dq current */
+
+  clarke_b16(&foc->i_abc, &foc->i_ab);
+  park_b16(angle, &foc->i_ab, &foc->i_dq);
+
+  /* Current control (current dq -> voltage dq) */
+
+  foc->i_dq_err.d = foc->i_dq_ref.d - foc->i_dq.d;
+  foc->i_dq_err.q = foc->i_dq_ref.q - foc->i_dq.q;
+
+  foc->v_dq.d = pid_b16(&foc->id_pid, foc->i_dq_err.d);
+  foc->v_dq.q = pid_b16(&foc->iq_pid, foc->i_dq_err.q);
+
+  dq_saturate_b16(&foc->v_dq, foc->vdq_mag_max);
+
+  /* Voltage dq -> voltage alpha-beta */
+
+  inv_park_b16(angle, &foc->v_dq, &foc->v_ab);
+
+  /* Normalize the alpha-beta voltage to get the modulation voltage */
+
+  foc->v_ab_mod.a = b16mulb16(foc->v_ab.a, foc->vab_mod_scale);
+  foc->v_ab_mod.b = b16mulb16(foc->v_ab.b, foc->vab_mod_scale);
+}
@@ -46,6 +46,26 @@
 #define VECTOR2D_SATURATE_MAG_MIN (1e-10f)
 #define FAST_ATAN2_SMALLNUM       (1e-10f)
 
+/* Number of Newton-Raphson iterations for fixed_rsqrt() */
+
+#define FIXED_RSQRT_ITER          (3)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Initial guess for 1/sqrt(u) in Q30, u = (i + 8.5) / 32, u in <0.25, 1) */
+
+static const uint32_t g_rsqrt_tab[24] =
+{
+  0x7c2da123, 0x7575faa4, 0x6fba415c, 0x6ac266ba,
+  0x66666666, 0x6288d173, 0x5f137599, 0x5bf539e5,
+  0x5920b4df, 0x568b3632, 0x542c1aa4, 0x51fc5140,
+  0x4ff601e0, 0x4e144ae9, 0x4c530f65, 0x4aaed0f0,
+  0x49249249, 0x47b1c049, 0x46541fb4, 0x4509beb0,
+  0x43d0e917, 0x42a81ef6, 0x418e0cc8, 0x40818512
+};
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -471,3 +491,133 @@ void phase_angle_update(FAR struct phase_angle_s *angle, float val)
   angle->cos = fast_cos(val);
 #endif
 }
+
+/****************************************************************************
+ * Name: fast_rsqrt
+ *
+ * Description:
+ *   Fast inverse square root calculation
+ *
+ * Input Parameters:
+ *   x - (in) positive number
+ *
+ * Returned Value:
+ *   Return 1/sqrt(x)
+ *
+ ****************************************************************************/
+
+float fast_rsqrt(float x)
+{
+#if CONFIG_LIBDSP_PRECISION == 0
+  union
+  {
+    float    f;
+    uint32_t i;
+  } u;
+
+  /* Initial guess from the floating point exponent and two Newton-Raphson
+   * iterations. Relative error is below 5e-6.
+   */
+
+  u.f = x;
+  u.i = 0x5f375a86 - (u.i >> 1);
+  u.f = u.f * (1.5f - 0.5f * x * u.f * u.f);
+  u.f = u.f * (1.5f - 0.5f * x * u.f * u.f);
+
+  return u.f;
+#else
+  return 1.0f / sqrtf(x);
+#endif
+}
+
+/****************************************************************************
+ * Name: fixed_rsqrt
+ *
+ * Description:
+ *   Integer inverse square root without division, for use by the
+ *   fixed-point routines on targets without FPU. The result is returned as
+ *   a mantissa and a shift:
+ *
+ *     1/sqrt(x) = y * 2^(-shift)
+ *
+ *   where y is in range <2^30, 2^31>. To normalize a vector v whose squared
+ *   magnitude is x, compute (v * y) >> (shift - frac) where frac is the
+ *   number of fractional bits of the result.
+ *
+ * Input Parameters:
+ *   x     - (in) raw integer value, must be non-zero
+ *   shift - (out) result exponent, always >= 31
+ *
+ * Returned Value:
+ *   Return inverse square root mantissa
+ *
+ ****************************************************************************/
+
+uint32_t fixed_rsqrt(uint64_t x, FAR int *shift)
+{
+  uint64_t y = 0;
+  uint64_t u = 0;
+  uint64_t t = 0;
+  int      s = 0;
+  int      i = 0;
+
+  DEBUGASSERT(x != 0);
+  DEBUGASSERT(shift != NULL);
+
+  /* Normalize x to <2^60, 2^62) with an even shift */
+
+  if (x < ((uint64_t)1 << 30))
+    {
+      x <<= 32;
+      s += 32;
+    }
+
+  if (x < ((uint64_t)1 << 46))
+    {
+      x <<= 16;
+      s += 16;
+    }
+
+  if (x < ((uint64_t)1 << 54))
+    {
+      x <<= 8;
+      s += 8;
+    }
+
+  if (x < ((uint64_t)1 << 58))
+    {
+      x <<= 4;
+      s += 4;
+    }
+
+  if (x < ((uint64_t)1 << 60))
+    {
+      x <<= 2;
+      s += 2;
+    }
+
+  if (x >= ((uint64_t)1 << 62))
+    {
+      x >>= 2;
+      s -= 2;
+    }
+
+  /* u = x / 2^62 in Q32, range <0.25, 1) */
+
+  u = x >> 30;
+
+  /* Table lookup and Newton-Raphson iterations y = y * (3 - u*y^2) / 2 */
+
+  y = g_rsqrt_tab[(u >> 27) - 8];
+
+  for (i = 0; i < FIXED_RSQRT_ITER; i += 1)
+    {
+      t = (y * y) >> 30;
+      t = (t * u) >> 32;
+      y = (y * (((uint64_t)3 << 30) - t)) >> 31;
+    }
+
+  *shift = 61 - s / 2;
+
+  return (uint32_t)y;
+}
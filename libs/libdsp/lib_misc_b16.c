@@ -0,0 +1,321 @@
+/****************************************************************************
+ * libs/libdsp/lib_misc_b16.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* b16_t angle in radians to 32-bit phase: 2^32 / (2*PI) / 2^16 in Q16 */
+
+#define PHASE_SCALE         (683565276)
+#define PHASE_QUARTER       (0x40000000u)
+
+/* 2*PI in b16_t, rounded (b16TWOPI is truncated) */
+
+#define B16_TWOPI           (411775)
+
+/* Sine table resolution */
+
+#define SIN_TAB_BITS        (9)
+#define SIN_FRAC_SHIFT      (32 - SIN_TAB_BITS - 16)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* One period of sine in Q15 with one guard entry for interpolation.
+ * Linear interpolation gives a maximum error of about 2e-5.
+ */
+
+static const int16_t g_sin_tab[(1 << SIN_TAB_BITS) + 1] =
+{
+  0, 402, 804, 1206, 1608, 2009, 2411, 2811, 3212, 3612, 4011, 4410, 4808,
+  5205, 5602, 5998, 6393, 6787, 7180, 7571, 7962, 8351, 8740, 9127, 9512,
+  9896, 10279, 10660, 11039, 11417, 11793, 12167, 12540, 12910, 13279,
+  13646, 14010, 14373, 14733, 15091, 15447, 15800, 16151, 16500, 16846,
+  17190, 17531, 17869, 18205, 18538, 18868, 19195, 19520, 19841, 20160,
+  20475, 20788, 21097, 21403, 21706, 22006, 22302, 22595, 22884, 23170,
+  23453, 23732, 24008, 24279, 24548, 24812, 25073, 25330, 25583, 25833,
+  26078, 26320, 26557, 26791, 27020, 27246, 27467, 27684, 27897, 28106,
+  28311, 28511, 28707, 28899, 29086, 29269, 29448, 29622, 29792, 29957,
+  30118, 30274, 30425, 30572, 30715, 30853, 30986, 31114, 31238, 31357,
+  31471, 31581, 31686, 31786, 31881, 31972, 32058, 32138, 32214, 32286,
+  32352, 32413, 32470, 32522, 32568, 32610, 32647, 32679, 32706, 32729,
+  32746, 32758, 32766, 32767, 32766, 32758, 32746, 32729, 32706, 32679,
+  32647, 32610, 32568, 32522, 32470, 32413, 32352, 32286, 32214, 32138,
+  32058, 31972, 31881, 31786, 31686, 31581, 31471, 31357, 31238, 31114,
+  30986, 30853, 30715, 30572, 30425, 30274, 30118, 29957, 29792, 29622,
+  29448, 29269, 29086, 28899, 28707, 28511, 28311, 28106, 27897, 27684,
+  27467, 27246, 27020, 26791, 26557, 26320, 26078, 25833, 25583, 25330,
+  25073, 24812, 24548, 24279, 24008, 23732, 23453, 23170, 22884, 22595,
+  22302, 22006, 21706, 21403, 21097, 20788, 20475, 20160, 19841, 19520,
+  19195, 18868, 18538, 18205, 17869, 17531, 17190, 16846, 16500, 16151,
+  15800, 15447, 15091, 14733, 14373, 14010, 13646, 13279, 12910, 12540,
+  12167, 11793, 11417, 11039, 10660, 10279, 9896, 9512, 9127, 8740, 8351,
+  7962, 7571, 7180, 6787, 6393, 5998, 5602, 5205, 4808, 4410, 4011, 3612,
+  3212, 2811, 2411, 2009, 1608, 1206, 804, 402, 0, -402, -804, -1206, -1608,
+  -2009, -2411, -2811, -3212, -3612, -4011, -4410, -4808, -5205, -5602,
+  -5998, -6393, -6787, -7180, -7571, -7962, -8351, -8740, -9127, -9512,
+  -9896, -10279, -10660, -11039, -11417, -11793, -12167, -12540, -12910,
+  -13279, -13646, -14010, -14373, -14733, -15091, -15447, -15800, -16151,
+  -16500, -16846, -17190, -17531, -17869, -18205, -18538, -18868, -19195,
+  -19520, -19841, -20160, -20475, -20788, -21097, -21403, -21706, -22006,
+  -22302, -22595, -22884, -23170, -23453, -23732, -24008, -24279, -24548,
+  -24812, -25073, -25330, -25583, -25833, -26078, -26320, -26557, -26791,
+  -27020, -27246, -27467, -27684, -27897, -28106, -28311, -28511, -28707,
+  -28899, -29086, -29269, -29448, -29622, -29792, -29957, -30118, -30274,
+  -30425, -30572, -30715, -30853, -30986, -31114, -31238, -31357, -31471,
+  -31581, -31686, -31786, -31881, -31972, -32058, -32138, -32214, -32286,
+  -32352, -32413, -32470, -32522, -32568, -32610, -32647, -32679, -32706,
+  -32729, -32746, -32758, -32766, -32767, -32766, -32758, -32746, -32729,
+  -32706, -32679, -32647, -32610, -32568, -32522, -32470, -32413, -32352,
+  -32286, -32214, -32138, -32058, -31972, -31881, -31786, -31686, -31581,
+  -31471, -31357, -31238, -31114, -30986, -30853, -30715, -30572, -30425,
+  -30274, -30118, -29957, -29792, -29622, -29448, -29269, -29086, -28899,
+  -28707, -28511, -28311, -28106, -27897, -27684, -27467, -27246, -27020,
+  -26791, -26557, -26320, -26078, -25833, -25583, -25330, -25073, -24812,
+  -24548, -24279, -24008, -23732, -23453, -23170, -22884, -22595, -22302,
+  -22006, -21706, -21403, -21097, -20788, -20475, -20160, -19841, -19520,
+  -19195, -18868, -18538, -18205, -17869, -17531, -17190, -16846, -16500,
+  -16151, -15800, -15447, -15091, -14733, -14373, -14010, -13646, -13279,
+  -12910, -12540, -12167, -11793, -11417, -11039, -10660, -10279, -9896,
+  -9512, -9127, -8740, -8351, -7962, -7571, -7180, -6787, -6393, -5998,
+  -5602, -5205, -4808, -4410, -4011, -3612, -3212, -2811, -2411, -2009,
+  -1608, -1206, -804, -402, 0
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: angle_to_phase
+ *
+ * Description:
+ *   Convert b16_t angle to 32-bit phase. Integer wrap-around normalizes any
+ *   angle (also negative) to one period without branches.
+ *
+ ****************************************************************************/
+
+static inline uint32_t angle_to_phase(b16_t angle)
+{
+  return (uint32_t)(((int64_t)angle * PHASE_SCALE) >> 16);
+}
+
+/****************************************************************************
+ * Name: phase_sin
+ *
+ * Description:
+ *   Sine table lookup with linear interpolation.
+ *
+ ****************************************************************************/
+
+static inline b16_t phase_sin(uint32_t phase)
+{
+  uint32_t idx  = phase >> (32 - SIN_TAB_BITS);
+  int32_t  frac = (phase >> SIN_FRAC_SHIFT) & 0xffff;
+  int32_t  s0   = g_sin_tab[idx];
+  int32_t  s1   = g_sin_tab[idx + 1];
+
+  /* Q15 table to b16_t */
+
+  return (b16_t)((s0 << 1) + (((s1 - s0) * frac) >> 15));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fast_sin_b16
+ *
+ * Description:
+ *   Lookup table sine for b16_t angle
+ *
+ * Input Parameters:
+ *   angle - (in) angle in radians, any range
+ *
+ * Returned Value:
+ *   Return sine value
+ *
+ ****************************************************************************/
+
+b16_t fast_sin_b16(b16_t angle)
+{
+  return phase_sin(angle_to_phase(angle));
+}
+
+/****************************************************************************
+ * Name: fast_cos_b16
+ *
+ * Description:
+ *   Lookup table cosine for b16_t angle
+ *
+ * Input Parameters:
+ *   angle - (in) angle in radians, any range
+ *
+ * Returned Value:
+ *   Return cosine value
+ *
+ ****************************************************************************/
+
+b16_t fast_cos_b16(b16_t angle)
+{
+  return phase_sin(angle_to_phase(angle) + PHASE_QUARTER);
+}
+
+/****************************************************************************
+ * Name: f_saturate_b16
+ *
+ * Description:
+ *   Saturate b16_t number
+ *
+ * Input Parameters:
+ *   val - (in/out) pointer to b16_t number
+ *   min - (in) lower limit
+ *   max - (in) upper limit
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void f_saturate_b16(FAR b16_t *val, b16_t min, b16_t max)
+{
+  b16_t tmp = *val;
+
+  tmp  = tmp < min ? min : tmp;
+  *val = tmp > max ? max : tmp;
+}
+
+/****************************************************************************
+ * Name: vector2d_saturate_b16
+ *
+ * Description:
+ *   Saturate 2D b16_t vector magnitude. Uses the division-free inverse
+ *   square root, so no sqrt or division is needed.
+ *
+ * Input Parameters:
+ *   x   - (in/out) pointer to the vector x component
+ *   y   - (in/out) pointer to the vector y component
+ *   max - (in) maximum vector magnitude
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void vector2d_saturate_b16(FAR b16_t *x, FAR b16_t *y, b16_t max)
+{
+  uint64_t mag2 = 0;
+  uint32_t rs   = 0;
+  int64_t  k    = 0;
+  int      shift;
+
+  DEBUGASSERT(max >= 0);
+
+  mag2 = (uint64_t)((int64_t)*x * *x) + (uint64_t)((int64_t)*y * *y);
+
+  if (mag2 > (uint64_t)((int64_t)max * max))
+    {
+      /* k = max / |v| in Q30 */
+
+      rs    = fixed_rsqrt(mag2, &shift);
+      k     = ((int64_t)max * rs) >> (shift - 30);
+
+      *x = (b16_t)(((int64_t)*x * k) >> 30);
+      *y = (b16_t)(((int64_t)*y * k) >> 30);
+    }
+}
+
+/****************************************************************************
+ * Name: dq_saturate_b16
+ *
+ * Description:
+ *   Saturate b16_t dq frame vector magnitude.
+ *
+ * Input Parameters:
+ *   dq  - (in/out) dq frame vector
+ *   max - (in) maximum vector magnitude
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void dq_saturate_b16(FAR dq_frame_b16_t *dq, b16_t max)
+{
+  vector2d_saturate_b16(&dq->d, &dq->q, max);
+}
+
+/****************************************************************************
+ * Name: angle_norm_2pi_b16
+ *
+ * Description:
+ *   Normalize b16_t angle to range <0, 2PI) without loops.
+ *
+ * Input Parameters:
+ *   angle - (in/out) pointer to the angle data
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void angle_norm_2pi_b16(FAR b16_t *angle)
+{
+  uint32_t phase = angle_to_phase(*angle);
+
+  *angle = (b16_t)(((uint64_t)phase * B16_TWOPI) >> 32);
+}
+
+/****************************************************************************
+ * Name: phase_angle_update_b16
+ *
+ * Description:
+ *   Update phase_angle_b16_s structure: normalize angle to <0, 2PI) and
+ *   update sine and cosine from the lookup table. The angle is converted
+ *   to phase only once for all three values.
+ *
+ * Input Parameters:
+ *   angle - (in/out) pointer to the angle data
+ *   val   - (in) angle radian value
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void phase_angle_update_b16(FAR phase_angle_b16_t *angle, b16_t val)
+{
+  uint32_t phase = angle_to_phase(val);
+
+  DEBUGASSERT(angle != NULL);
+
+  angle->angle = (b16_t)(((uint64_t)phase * B16_TWOPI) >> 32);
+  angle->sin   = phase_sin(phase);
+  angle->cos   = phase_sin(phase + PHASE_QUARTER);
+}
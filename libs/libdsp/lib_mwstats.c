@@ -0,0 +1,525 @@
+/****************************************************************************
+ * libs/libdsp/lib_mwstats.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mwstats_resum
+ *
+ * Description:
+ *   Recalculate the running sums from the full window buffer, relative to
+ *   its first sample, the oldest one when the write position wraps. Float
+ *   running sums accumulate rounding errors, this is done once per window
+ *   so the cost is O(1) per sample.
+ *
+ ****************************************************************************/
+
+static void mwstats_resum(FAR struct mwstats_s *mw)
+{
+  float sum   = 0.0f;
+  float sumsq = 0.0f;
+  float d     = 0.0f;
+  uint16_t i  = 0;
+
+  mw->ref = mw->buf[0];
+
+  for (i = 0; i < mw->count; i++)
+    {
+      d      = mw->buf[i] - mw->ref;
+      sum   += d;
+      sumsq += d * d;
+    }
+
+  mw->sum   = sum;
+  mw->sumsq = sumsq;
+}
+
+/****************************************************************************
+ * Name: mwstats_b16_mul
+ *
+ * Description:
+ *   Multiply two unsigned 64-bit values into a 128-bit product split in
+ *   high and low halves.
+ *
+ ****************************************************************************/
+
+static void mwstats_b16_mul(uint64_t a, uint64_t b, FAR uint64_t *hi,
+                            FAR uint64_t *lo)
+{
+  uint64_t p00 = (a & 0xffffffff) * (b & 0xffffffff);
+  uint64_t p01 = (a & 0xffffffff) * (b >> 32);
+  uint64_t p10 = (a >> 32) * (b & 0xffffffff);
+  uint64_t p11 = (a >> 32) * (b >> 32);
+  uint64_t mid = (p00 >> 32) + (p01 & 0xffffffff) + (p10 & 0xffffffff);
+
+  *lo = (mid << 32) | (p00 & 0xffffffff);
+  *hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mwstats_init
+ *
+ * Description:
+ *   Initialize moving window statistics.
+ *
+ * Input Parameters:
+ *   mw   - (out) pointer to the statistics data
+ *   buf  - (in) window buffer, must hold size samples
+ *   size - (in) window size
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mwstats_init(FAR struct mwstats_s *mw, FAR float *buf, uint16_t size)
+{
+  DEBUGASSERT(mw != NULL);
+  DEBUGASSERT(buf != NULL);
+  DEBUGASSERT(size > 0);
+
+  mw->buf  = buf;
+  mw->size = size;
+
+  mwstats_reset(mw);
+}
+
+/****************************************************************************
+ * Name: mwstats_reset
+ *
+ * Description:
+ *   Discard all samples from the window.
+ *
+ * Input Parameters:
+ *   mw - (in/out) pointer to the statistics data
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mwstats_reset(FAR struct mwstats_s *mw)
+{
+  DEBUGASSERT(mw != NULL);
+
+  mw->ref   = 0.0f;
+  mw->sum   = 0.0f;
+  mw->sumsq = 0.0f;
+  mw->pos   = 0;
+  mw->count = 0;
+}
+
+/****************************************************************************
+ * Name: mwstats_process
+ *
+ * Description:
+ *   Push a block of samples into the window. The sums are taken relative
+ *   to a reference sample, so that the variance does not cancel out when
+ *   the samples are large compared to their spread.
+ *
+ * Input Parameters:
+ *   mw   - (in/out) pointer to the statistics data
+ *   data - (in) samples
+ *   n    - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mwstats_process(FAR struct mwstats_s *mw, FAR const float *data,
+                     size_t n)
+{
+  FAR float *buf = NULL;
+  float sum      = 0.0f;
+  float sumsq    = 0.0f;
+  float old      = 0.0f;
+  float x        = 0.0f;
+  uint16_t pos   = 0;
+
+  DEBUGASSERT(mw != NULL);
+  DEBUGASSERT(data != NULL);
+
+  if (n > 0 && mw->count == 0)
+    {
+      mw->ref = data[0];
+    }
+
+  buf   = mw->buf;
+  sum   = mw->sum;
+  sumsq = mw->sumsq;
+  pos   = mw->pos;
+
+  for (; n > 0; n--)
+    {
+      x = *data++;
+
+      /* Remove the oldest sample once the window is full */
+
+      if (mw->count == mw->size)
+        {
+          old    = buf[pos] - mw->ref;
+          sum   -= old;
+          sumsq -= old * old;
+        }
+      else
+        {
+          mw->count++;
+        }
+
+      buf[pos] = x;
+      x       -= mw->ref;
+      sum     += x;
+      sumsq   += x * x;
+
+      if (++pos == mw->size)
+        {
+          pos       = 0;
+          mw->sum   = sum;
+          mw->sumsq = sumsq;
+
+          mwstats_resum(mw);
+
+          sum   = mw->sum;
+          sumsq = mw->sumsq;
+        }
+    }
+
+  mw->sum   = sum;
+  mw->sumsq = sumsq;
+  mw->pos   = pos;
+}
+
+/****************************************************************************
+ * Name: mwstats_mean
+ *
+ * Description:
+ *   Get mean value of the samples in the window.
+ *
+ * Input Parameters:
+ *   mw - (in) pointer to the statistics data
+ *
+ * Returned Value:
+ *   Return mean value or 0.0 if the window is empty
+ *
+ ****************************************************************************/
+
+float mwstats_mean(FAR struct mwstats_s *mw)
+{
+  DEBUGASSERT(mw != NULL);
+
+  return mw->count > 0 ? mw->ref + mw->sum / mw->count : 0.0f;
+}
+
+/****************************************************************************
+ * Name: mwstats_var
+ *
+ * Description:
+ *   Get (population) variance of the samples in the window.
+ *
+ * Input Parameters:
+ *   mw - (in) pointer to the statistics data
+ *
+ * Returned Value:
+ *   Return variance or 0.0 if the window is empty
+ *
+ ****************************************************************************/
+
+float mwstats_var(FAR struct mwstats_s *mw)
+{
+  float mean = 0.0f;
+  float var  = 0.0f;
+
+  DEBUGASSERT(mw != NULL);
+
+  if (mw->count == 0)
+    {
+      return 0.0f;
+    }
+
+  /* Both sums are relative to mw->ref, which is within the spread of the
+   * samples, so the subtraction does not cancel out the variance.
+   */
+
+  mean = mw->sum / mw->count;
+  var  = mw->sumsq / mw->count - mean * mean;
+
+  return var > 0.0f ? var : 0.0f;
+}
+
+/****************************************************************************
+ * Name: mwstats_rms
+ *
+ * Description:
+ *   Get root mean square of the samples in the window.
+ *
+ * Input Parameters:
+ *   mw - (in) pointer to the statistics data
+ *
+ * Returned Value:
+ *   Return RMS value or 0.0 if the window is empty
+ *
+ ****************************************************************************/
+
+float mwstats_rms(FAR struct mwstats_s *mw)
+{
+  float mean = 0.0f;
+
+  DEBUGASSERT(mw != NULL);
+
+  if (mw->count == 0)
+    {
+      return 0.0f;
+    }
+
+  /* The mean square is the variance plus the squared mean */
+
+  mean = mwstats_mean(mw);
+
+  return sqrtf(mwstats_var(mw) + mean * mean);
+}
+
+/****************************************************************************
+ * Name: mwstats_b16_init
+ *
+ * Description:
+ *   Initialize fixed-point moving window statistics.
+ *
+ * Input Parameters:
+ *   mw   - (out) pointer to the statistics data
+ *   buf  - (in) window buffer, must hold size samples
+ *   size - (in) window size
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mwstats_b16_init(FAR struct mwstats_b16_s *mw, FAR b16_t *buf,
+                      uint16_t size)
+{
+  DEBUGASSERT(mw != NULL);
+  DEBUGASSERT(buf != NULL);
+  DEBUGASSERT(size > 0);
+
+  mw->buf  = buf;
+  mw->size = size;
+
+  mwstats_b16_reset(mw);
+}
+
+/****************************************************************************
+ * Name: mwstats_b16_reset
+ *
+ * Description:
+ *   Discard all samples from the window.
+ *
+ * Input Parameters:
+ *   mw - (in/out) pointer to the statistics data
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mwstats_b16_reset(FAR struct mwstats_b16_s *mw)
+{
+  DEBUGASSERT(mw != NULL);
+
+  mw->sum   = 0;
+  mw->sumsq = 0;
+  mw->pos   = 0;
+  mw->count = 0;
+}
+
+/****************************************************************************
+ * Name: mwstats_b16_process
+ *
+ * Description:
+ *   Push a block of samples into the window. The sums are exact, so
+ *   unlike the float version they never need to be recalculated.
+ *
+ * Input Parameters:
+ *   mw   - (in/out) pointer to the statistics data
+ *   data - (in) samples
+ *   n    - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mwstats_b16_process(FAR struct mwstats_b16_s *mw,
+                         FAR const b16_t *data, size_t n)
+{
+  FAR b16_t *buf = NULL;
+  int64_t sum    = 0;
+  uint64_t sumsq = 0;
+  b16_t old      = 0;
+  b16_t x        = 0;
+  uint16_t pos   = 0;
+
+  DEBUGASSERT(mw != NULL);
+  DEBUGASSERT(data != NULL);
+
+  buf   = mw->buf;
+  sum   = mw->sum;
+  sumsq = mw->sumsq;
+  pos   = mw->pos;
+
+  for (; n > 0; n--)
+    {
+      x = *data++;
+
+      if (mw->count == mw->size)
+        {
+          old    = buf[pos];
+          sum   -= old;
+          sumsq -= (uint64_t)((int64_t)old * old);
+        }
+      else
+        {
+          mw->count++;
+        }
+
+      buf[pos] = x;
+      sum     += x;
+      sumsq   += (uint64_t)((int64_t)x * x);
+
+      if (++pos == mw->size)
+        {
+          pos = 0;
+        }
+    }
+
+  mw->sum   = sum;
+  mw->sumsq = sumsq;
+  mw->pos   = pos;
+}
+
+/****************************************************************************
+ * Name: mwstats_b16_mean
+ *
+ * Description:
+ *   Get mean value of the samples in the window.
+ *
+ * Input Parameters:
+ *   mw - (in) pointer to the statistics data
+ *
+ * Returned Value:
+ *   Return mean value or 0 if the window is empty
+ *
+ ****************************************************************************/
+
+b16_t mwstats_b16_mean(FAR struct mwstats_b16_s *mw)
+{
+  DEBUGASSERT(mw != NULL);
+
+  return mw->count > 0 ? (b16_t)(mw->sum / mw->count) : 0;
+}
+
+/****************************************************************************
+ * Name: mwstats_b16_var
+ *
+ * Description:
+ *   Get (population) variance of the samples in the window.
+ *
+ * Input Parameters:
+ *   mw - (in) pointer to the statistics data
+ *
+ * Returned Value:
+ *   Return variance (saturated to b16MAX) or 0 if the window is empty
+ *
+ ****************************************************************************/
+
+b16_t mwstats_b16_var(FAR struct mwstats_b16_s *mw)
+{
+  uint64_t abssum = 0;
+  uint64_t div    = 0;
+  uint64_t rem    = 0;
+  uint64_t cur    = 0;
+  uint64_t nhi    = 0;
+  uint64_t nlo    = 0;
+  uint64_t shi    = 0;
+  uint64_t slo    = 0;
+  uint32_t q[4];
+  int i           = 0;
+
+  DEBUGASSERT(mw != NULL);
+
+  if (mw->count == 0)
+    {
+      return 0;
+    }
+
+  /* var = (count * sumsq - sum^2) / count^2, computed exactly in 128 bits
+   * so that neither the mean nor the mean square is truncated first.  The
+   * numerator is a sum of squared differences and cannot be negative.
+   */
+
+  abssum = mw->sum < 0 ? -(uint64_t)mw->sum : (uint64_t)mw->sum;
+
+  mwstats_b16_mul(mw->sumsq, mw->count, &nhi, &nlo);
+  mwstats_b16_mul(abssum, abssum, &shi, &slo);
+
+  if (nhi < shi || (nhi == shi && nlo <= slo))
+    {
+      return 0;
+    }
+
+  nhi -= shi + (nlo < slo);
+  nlo -= slo;
+
+  /* Long division by count^2, which fits in 32 bits, one word at a time */
+
+  div  = (uint64_t)mw->count * mw->count;
+  q[0] = (uint32_t)(nhi >> 32);
+  q[1] = (uint32_t)nhi;
+  q[2] = (uint32_t)(nlo >> 32);
+  q[3] = (uint32_t)nlo;
+
+  for (i = 0; i < 4; i++)
+    {
+      cur  = (rem << 32) | q[i];
+      q[i] = (uint32_t)(cur / div);
+      rem  = cur % div;
+    }
+
+  /* The quotient is in Q32, return it in Q16 */
+
+  if (q[0] != 0 || q[1] != 0 || q[2] > (b16MAX >> 16))
+    {
+      return b16MAX;
+    }
+
+  return (b16_t)(((uint64_t)q[2] << 16) | (q[3] >> 16));
+}
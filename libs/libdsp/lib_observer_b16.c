@@ -0,0 +1,304 @@
+/****************************************************************************
+ * libs/libdsp/lib_observer_b16.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+#include "dsp_b16.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define SMO_G_MAX            (0x0000ffbe)   /* 0.999 */
+#define SMO_FILTER_MAX       (0x0000fd71)   /* 0.99 */
+#define SMO_FILTER_MIN       (0x00000148)   /* 0.005 */
+
+/* PI in b16_t, rounded (b16PI is truncated) */
+
+#define B16_PI               (205887)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: motor_observer_init_b16
+ *
+ * Description:
+ *   Initialize b16_t motor observer
+ *
+ * Input Parameters:
+ *   observer - pointer to the common observer data
+ *   ao       - pointer to the angle specific observer data
+ *   so       - pointer to the speed specific observer data
+ *   freq     - observer execution frequency in Hz
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void motor_observer_init_b16(FAR struct motor_observer_b16_s *observer,
+                             FAR void *ao, FAR void *so, uint32_t freq)
+{
+  DEBUGASSERT(observer != NULL);
+  DEBUGASSERT(ao != NULL);
+  DEBUGASSERT(so != NULL);
+  DEBUGASSERT(freq > 0);
+
+  memset(observer, 0, sizeof(struct motor_observer_b16_s));
+
+  observer->freq = freq;
+  observer->ao   = ao;
+  observer->so   = so;
+}
+
+/****************************************************************************
+ * Name: motor_observer_smo_init_b16
+ *
+ * Description:
+ *   Initialize b16_t motor sliding mode observer.
+ *
+ * Input Parameters:
+ *   smo     - pointer to the sliding mode observer private data
+ *   kslide  - SMO gain
+ *   err_max - linear region upper limit
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void motor_observer_smo_init_b16(FAR struct motor_observer_smo_b16_s *smo,
+                                 b16_t kslide, b16_t err_max)
+{
+  DEBUGASSERT(smo != NULL);
+  DEBUGASSERT(kslide > 0);
+  DEBUGASSERT(err_max > 0);
+
+  memset(smo, 0, sizeof(struct motor_observer_smo_b16_s));
+
+  smo->k_slide = kslide;
+  smo->err_max = err_max;
+  smo->k_lin   = (b16_t)(((int64_t)kslide << 16) / err_max);
+}
+
+/****************************************************************************
+ * Name: motor_observer_smo_b16
+ *
+ * Description:
+ *   One step of the b16_t SMO observer, see motor_observer_smo() for the
+ *   theoretical background.
+ *
+ *   The linear and bang-bang regions of the correction factor are
+ *   expressed as one saturation:
+ *
+ *     z = sat(i_err * k_slide / err_max, -k_slide, k_slide)
+ *
+ * Input Parameters:
+ *   o      - (in/out) pointer to the common observer data
+ *   i_ab   - (in) inverter alpha-beta current
+ *   v_ab   - (in) inverter alpha-beta voltage
+ *   phy    - (in) pointer to the motor physical parameters
+ *   dir    - (in) rotation direction (1 for CW, -1 for CCW)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void motor_observer_smo_b16(FAR struct motor_observer_b16_s *o,
+                            FAR ab_frame_b16_t *i_ab,
+                            FAR ab_frame_b16_t *v_ab,
+                            FAR struct motor_phy_params_b16_s *phy,
+                            int8_t dir)
+{
+  FAR struct motor_observer_smo_b16_s *smo = NULL;
+  FAR ab_frame_b16_t *emf   = NULL;
+  FAR ab_frame_b16_t *emf_f = NULL;
+  FAR ab_frame_b16_t *z     = NULL;
+  FAR ab_frame_b16_t *i_est = NULL;
+  b16_t F;
+  b16_t G;
+  b16_t filter;
+  b16_t err;
+  b16_t angle;
+
+  DEBUGASSERT(o != NULL);
+  DEBUGASSERT(i_ab != NULL);
+  DEBUGASSERT(v_ab != NULL);
+  DEBUGASSERT(phy != NULL);
+
+  smo   = (FAR struct motor_observer_smo_b16_s *)o->ao;
+  emf   = &smo->emf;
+  emf_f = &smo->emf_f;
+  z     = &smo->z;
+  i_est = &smo->i_est;
+
+  /* Observer gains: F = 1 - per*R/L, G = per/L */
+
+  F = b16ONE - b16mulb16(phy->res, phy->one_by_ind) / (b16_t)o->freq;
+  G = phy->one_by_ind / (b16_t)o->freq;
+  F = B16_MAX(F, 0);
+  G = B16_MIN(G, SMO_G_MAX);
+
+  /* Adaptive low pass filters: filter = per * omega_m * pole_pairs */
+
+  filter = o->speed * phy->p / (b16_t)o->freq;
+  filter = B16_MAX(filter, SMO_FILTER_MIN);
+  filter = B16_MIN(filter, SMO_FILTER_MAX);
+
+  /* Estimate stator current */
+
+  i_est->a = b16mulb16(F, i_est->a) +
+             b16mulb16(G, v_ab->a - emf->a - z->a);
+  i_est->b = b16mulb16(F, i_est->b) +
+             b16mulb16(G, v_ab->b - emf->b - z->b);
+
+  /* Slide-mode controller */
+
+  err  = b16mulb16(i_ab->a - i_est->a, smo->k_lin);
+  z->a = B16_MIN(B16_MAX(err, -smo->k_slide), smo->k_slide);
+  err  = b16mulb16(i_ab->b - i_est->b, smo->k_lin);
+  z->b = B16_MIN(B16_MAX(err, -smo->k_slide), smo->k_slide);
+
+  /* Filter z to obtain estimated emf and filter emf once again */
+
+  emf->a   -= b16mulb16(filter, emf->a - z->a);
+  emf->b   -= b16mulb16(filter, emf->b - z->b);
+  emf_f->a -= b16mulb16(filter, emf_f->a - emf->a);
+  emf_f->b -= b16mulb16(filter, emf_f->b - emf->b);
+
+  /* Estimate phase angle and compensate -PI/2 phase shift from the
+   * filters.
+   */
+
+  angle = b16atan2(-emf->a, emf->b) + dir * b16HALFPI;
+
+  angle_norm_2pi_b16(&angle);
+
+  o->angle = angle;
+}
+
+/****************************************************************************
+ * Name: motor_sobserver_div_init_b16
+ *
+ * Description:
+ *   Initialize b16_t DIV speed observer
+ *
+ * Input Parameters:
+ *   so      - (in/out) pointer to the DIV speed observer data
+ *   samples - (in) number of mechanical angle samples
+ *   filter  - (in) low-pass filter for final omega
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void motor_sobserver_div_init_b16(FAR struct motor_sobserver_div_b16_s *so,
+                                  uint8_t samples, b16_t filter)
+{
+  DEBUGASSERT(so != NULL);
+  DEBUGASSERT(samples > 0);
+  DEBUGASSERT(filter > 0);
+
+  memset(so, 0, sizeof(struct motor_sobserver_div_b16_s));
+
+  so->samples = samples;
+  so->filter  = filter;
+}
+
+/****************************************************************************
+ * Name: motor_sobserver_div_b16
+ *
+ * Description:
+ *   Estimate motor mechanical speed based on motor mechanical angle
+ *   difference (b16_t version).
+ *
+ * Input Parameters:
+ *   o     - (in/out) pointer to the common observer data
+ *   angle - (in) mechanical angle normalized to <0.0, 2PI>
+ *   dir   - (in) mechanical rotation direction (1 for CW, -1 for CCW)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void motor_sobserver_div_b16(FAR struct motor_observer_b16_s *o,
+                             b16_t angle, int8_t dir)
+{
+  FAR struct motor_sobserver_div_b16_s *so = NULL;
+  b16_t diff;
+  b16_t omega;
+
+  DEBUGASSERT(o != NULL);
+  DEBUGASSERT(dir == 1 || dir == -1);
+
+  so = (FAR struct motor_sobserver_div_b16_s *)o->so;
+
+  /* Get angle difference, correct it if we crossed angle boundary */
+
+  diff = (angle - so->angle_prev) * dir;
+  diff = diff < -B16_PI ? diff + 2 * B16_PI : diff;
+  diff = diff < 0 ? -diff : diff;
+
+  so->angle_acc += diff;
+  so->angle_prev = angle;
+
+  if (++so->cntr >= so->samples)
+    {
+      /* omega = delta_theta / delta_time */
+
+      omega = (b16_t)((int64_t)so->angle_acc * o->freq / so->samples);
+
+      o->speed -= b16mulb16(so->filter, o->speed - omega);
+
+      so->cntr      = 0;
+      so->angle_acc = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: motor_observer_speed_get_b16
+ ****************************************************************************/
+
+b16_t motor_observer_speed_get_b16(FAR struct motor_observer_b16_s *o)
+{
+  DEBUGASSERT(o != NULL);
+
+  return o->speed;
+}
+
+/****************************************************************************
+ * Name: motor_observer_angle_get_b16
+ ****************************************************************************/
+
+b16_t motor_observer_angle_get_b16(FAR struct motor_observer_b16_s *o)
+{
+  DEBUGASSERT(o != NULL);
+
+  return o->angle;
+}
@@ -0,0 +1,170 @@
+/****************************************************************************
+ * libs/libdsp/lib_pid_b16.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+#include "dsp_b16.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pid_controller_init_b16
+ *
+ * Description:
+ *   Initialize b16_t PID controller. Output is not limited until
+ *   pi_saturation_set_b16() is called.
+ *
+ * Input Parameters:
+ *   pid - (out) pointer to the PID controller data
+ *   KP  - (in) proportional gain
+ *   KI  - (in) integral gain
+ *   KD  - (in) derivative gain
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void pid_controller_init_b16(FAR pid_controller_b16_t *pid,
+                             b16_t KP, b16_t KI, b16_t KD)
+{
+  DEBUGASSERT(pid != NULL);
+
+  /* Reset controller data */
+
+  memset(pid, 0, sizeof(pid_controller_b16_t));
+
+  /* Copy controller parameters */
+
+  pid->KP      = KP;
+  pid->KI      = KI;
+  pid->KD      = KD;
+  pid->sat_min = INT32_MIN;
+  pid->sat_max = INT32_MAX;
+}
+
+/****************************************************************************
+ * Name: pi_controller_init_b16
+ *
+ * Description:
+ *   Initialize b16_t PI controller.
+ *
+ * Input Parameters:
+ *   pid - (out) pointer to the PI controller data
+ *   KP  - (in) proportional gain
+ *   KI  - (in) integral gain
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void pi_controller_init_b16(FAR pid_controller_b16_t *pid,
+                            b16_t KP, b16_t KI)
+{
+  pid_controller_init_b16(pid, KP, KI, 0);
+}
+
+/****************************************************************************
+ * Name: pi_saturation_set_b16
+ *
+ * Description:
+ *   Set controller output limits. The integral part is limited to the
+ *   same range.
+ *
+ * Input Parameters:
+ *   pid - (out) pointer to the PID controller data
+ *   min - (in) lower limit
+ *   max - (in) upper limit
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void pi_saturation_set_b16(FAR pid_controller_b16_t *pid, b16_t min,
+                           b16_t max)
+{
+  DEBUGASSERT(pid != NULL);
+  DEBUGASSERT(min <= max);
+
+  pid->sat_min = min;
+  pid->sat_max = max;
+}
+
+/****************************************************************************
+ * Name: pi_integral_reset_b16
+ ****************************************************************************/
+
+void pi_integral_reset_b16(FAR pid_controller_b16_t *pid)
+{
+  pid->integral = 0;
+}
+
+/****************************************************************************
+ * Name: pi_controller_b16
+ *
+ * Description:
+ *   b16_t PI controller with output saturation and anti-windup
+ *
+ * Input Parameters:
+ *   pid - (in/out) pointer to the PI controller data
+ *   err - (in) current controller error
+ *
+ * Returned Value:
+ *   Return controller output.
+ *
+ ****************************************************************************/
+
+b16_t pi_controller_b16(FAR pid_controller_b16_t *pid, b16_t err)
+{
+  DEBUGASSERT(pid != NULL);
+  DEBUGASSERT(pid->KD == 0);
+
+  return pid_b16(pid, err);
+}
+
+/****************************************************************************
+ * Name: pid_controller_b16
+ *
+ * Description:
+ *   b16_t PID controller with output saturation and anti-windup
+ *
+ * Input Parameters:
+ *   pid - (in/out) pointer to the PID controller data
+ *   err - (in) current controller error
+ *
+ * Returned Value:
+ *   Return controller output.
+ *
+ ****************************************************************************/
+
+b16_t pid_controller_b16(FAR pid_controller_b16_t *pid, b16_t err)
+{
+  DEBUGASSERT(pid != NULL);
+
+  return pid_b16(pid, err);
+}
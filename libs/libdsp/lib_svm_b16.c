@@ -0,0 +1,204 @@
+/****************************************************************************
+ * libs/libdsp/lib_svm_b16.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+#include "dsp_b16.h"
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* SVM sector indexed by (i > 0) | (j > 0) << 1 | (k > 0) << 2.
+ * Same mapping as svm3_sector_get(), the degenerated cases 0 and 7 are
+ * resolved the same way as the float version does.
+ */
+
+static const uint8_t g_svm3_sector[8] =
+{
+  2, 6, 2, 1, 4, 5, 3, 5
+};
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: svm3_b16
+ *
+ * Description:
+ *   One step of the space vector modulation (b16_t version).
+ *
+ *   SVM with centered null vectors is equivalent to adding the mid-point
+ *   of the maximum and minimum phase voltages as zero sequence. This gives
+ *   the same duty cycles as svm3() without per-sector branches:
+ *
+ *     d_x = 0.5 + (v_x - (v_max + v_min) / 2) / sqrt(3)
+ *
+ * Input Parameters:
+ *   s    - (out) pointer to the SVM data
+ *   v_ab - (in) pointer to the modulation voltage vector in alpha-beta
+ *          frame, normalized to magnitude <0.0, 1.0>
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void svm3_b16(FAR struct svm3_state_b16_s *s, FAR ab_frame_b16_t *v_ab)
+{
+  b16_t i;
+  b16_t j;
+  b16_t k;
+  b16_t va;
+  b16_t vb;
+  b16_t vc;
+  b16_t vmax;
+  b16_t vmin;
+  b16_t mid;
+
+  DEBUGASSERT(s != NULL);
+  DEBUGASSERT(v_ab != NULL);
+
+  /* Auxiliary i,j,k frame, used only to get the sector for
+   * svm3_current_correct_b16().
+   */
+
+  i = (b16_t)((-((int64_t)v_ab->b << 15) +
+               (int64_t)SQRT3_BY_TWO_B16 * v_ab->a + b16HALF) >> 16);
+  j = v_ab->b;
+  k = -j - i;
+
+  s->sector = g_svm3_sector[(i > 0) | ((j > 0) << 1) | ((k > 0) << 2)];
+
+  /* Phase voltages (inverse Clarke transform) */
+
+  va = v_ab->a;
+  vb = (b16_t)((-((int64_t)v_ab->a << 15) +
+                (int64_t)SQRT3_BY_TWO_B16 * v_ab->b + b16HALF) >> 16);
+  vc = -va - vb;
+
+  /* Zero sequence */
+
+  vmax = B16_MAX(B16_MAX(va, vb), vc);
+  vmin = B16_MIN(B16_MIN(va, vb), vc);
+  mid  = (vmax + vmin) / 2;
+
+  /* Duty cycles */
+
+  va = b16HALF + b16mulb16(va - mid, ONE_BY_SQRT3_B16);
+  vb = b16HALF + b16mulb16(vb - mid, ONE_BY_SQRT3_B16);
+  vc = b16HALF + b16mulb16(vc - mid, ONE_BY_SQRT3_B16);
+
+  /* Saturate output from SVM */
+
+  s->d_u = B16_MIN(B16_MAX(va, s->d_min), s->d_max);
+  s->d_v = B16_MIN(B16_MAX(vb, s->d_min), s->d_max);
+  s->d_w = B16_MIN(B16_MAX(vc, s->d_min), s->d_max);
+}
+
+/****************************************************************************
+ * Name: svm3_current_correct_b16
+ *
+ * Description:
+ *   Correct ADC samples (int32) according to SVM3 state.
+ *   See svm3_current_correct() for details.
+ *
+ ****************************************************************************/
+
+void svm3_current_correct_b16(FAR struct svm3_state_b16_s *s,
+                              FAR int32_t *c0, FAR int32_t *c1,
+                              FAR int32_t *c2)
+{
+  switch (s->sector)
+    {
+      case 1:
+      case 6:
+        {
+          /* Sector 1-6: ignore phase 1 */
+
+          *c0 = -(*c1 + *c2);
+
+          break;
+        }
+
+      case 2:
+      case 3:
+        {
+          /* Sector 2-3: ignore phase 2 */
+
+          *c1 = -(*c0 + *c2);
+
+          break;
+        }
+
+      case 4:
+      case 5:
+        {
+          /* Sector 4-5: ignore phase 3 */
+
+          *c2 = -(*c0 + *c1);
+
+          break;
+        }
+
+      default:
+        {
+          /* We should not get here. */
+
+          *c0 = 0;
+          *c1 = 0;
+          *c2 = 0;
+
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: svm3_init_b16
+ *
+ * Description:
+ *   Initialize 3-phase SVM data (b16_t version).
+ *
+ * Input Parameters:
+ *   s   - (in/out) pointer to the SVM state data
+ *   min - (in) duty cycle lower limit
+ *   max - (in) duty cycle upper limit
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void svm3_init_b16(FAR struct svm3_state_b16_s *s, b16_t min, b16_t max)
+{
+  DEBUGASSERT(s != NULL);
+  DEBUGASSERT(max > min);
+
+  memset(s, 0, sizeof(struct svm3_state_b16_s));
+
+  s->d_max = max;
+  s->d_min = min;
+}
@@ -105,6 +105,7 @@ const struct sock_intf_s g_bluetooth_sockif =
   bluetooth_poll_local,  /* si_poll */
   bluetooth_send,        /* si_send */
   bluetooth_sendto,      /* si_sendto */
+  NULL,                  /* si_sendv */
 #ifdef CONFIG_NET_SENDFILE
   NULL,                   /* si_sendfile */
 #endif
@@ -98,6 +98,7 @@ const struct sock_intf_s g_icmp_sockif =
   icmp_netpoll,     /* si_poll */
   icmp_send,        /* si_send */
   icmp_sendto,      /* si_sendto */
+  NULL,             /* si_sendv */
 #ifdef CONFIG_NET_SENDFILE
   NULL,             /* si_sendfile */
 #endif
@@ -98,6 +98,7 @@ const struct sock_intf_s g_icmpv6_sockif =
   icmpv6_netpoll,     /* si_poll */
   icmpv6_send,        /* si_send */
   icmpv6_sendto,      /* si_sendto */
+  NULL,               /* si_sendv */
 #ifdef CONFIG_NET_SENDFILE
   NULL,               /* si_sendfile */
 #endif
@@ -103,6 +103,7 @@ const struct sock_intf_s g_ieee802154_sockif =
   ieee802154_poll_local,  /* si_poll */
   ieee802154_send,        /* si_send */
   ieee802154_sendto,      /* si_sendto */
+  NULL,                   /* si_sendv */
 #ifdef CONFIG_NET_SENDFILE
   NULL,                   /* si_sendfile */
 #endif
@@ -86,6 +86,8 @@ static ssize_t    inet_send(FAR struct socket *psock, FAR const void *buf,
 static ssize_t    inet_sendto(FAR struct socket *psock, FAR const void *buf,
                     size_t len, int flags, FAR const struct sockaddr *to,
                     socklen_t tolen);
+static ssize_t    inet_sendv(FAR struct socket *psock,
+                    FAR const struct iovec *iov, int iovcnt, int flags);
 #ifdef CONFIG_NET_SENDFILE
 static ssize_t    inet_sendfile(FAR struct socket *psock,
                     FAR struct file *infile, FAR off_t *offset,
@@ -113,6 +115,7 @@ static const struct sock_intf_s g_inet_sockif =
   inet_poll,        /* si_poll */
   inet_send,        /* si_send */
   inet_sendto,      /* si_sendto */
+  inet_sendv,       /* si_sendv */
 #ifdef CONFIG_NET_SENDFILE
   inet_sendfile,    /* si_sendfile */
 #endif
@@ -1232,6 +1235,42 @@ static ssize_t inet_sendto(FAR struct socket *psock, FAR const void *buf,
   return nsent;
 }
 
+/****************************************************************************
+ * Name: inet_sendv
+ *
+ * Description:
+ *   Gather the data from 'iovcnt' buffers and send it on a connected
+ *   socket.  Buffered TCP copies all of the segments into one write buffer
+ *   so that they go out together.  Everything else is left to the generic
+ *   logic in psock_sendv().
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   iov      Array of buffers to send
+ *   iovcnt   Number of elements in iov[]
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  -ENOSYS is
+ *   returned if there is no native path for this socket.  Any other
+ *   negated errno value reports a failure.
+ *
+ ****************************************************************************/
+
+static ssize_t inet_sendv(FAR struct socket *psock,
+                          FAR const struct iovec *iov, int iovcnt, int flags)
+{
+#if defined(NET_TCP_HAVE_STACK) && defined(CONFIG_NET_TCP_WRITE_BUFFERS) && \
+   !defined(CONFIG_NET_6LOWPAN)
+  if (psock->s_type == SOCK_STREAM)
+    {
+      return psock_tcp_sendv(psock, iov, iovcnt, flags);
+    }
+#endif
+
+  return -ENOSYS;
+}
+
 /****************************************************************************
  * Name: inet_sendfile
  *
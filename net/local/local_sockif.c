@@ -106,6 +106,7 @@ const struct sock_intf_s g_local_sockif =
   local_poll,        /* si_poll */
   local_send,        /* si_send */
   local_sendto,      /* si_sendto */
+  NULL,              /* si_sendv */
 #ifdef CONFIG_NET_SENDFILE
   NULL,              /* si_sendfile */
 #endif
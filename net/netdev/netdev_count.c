@@ -42,6 +42,7 @@
 #include <string.h>
 #include <errno.h>
 
+#include <nuttx/rcu.h>
 #include <nuttx/net/netdev.h>
 
 #include "utils/utils.h"
@@ -67,11 +68,12 @@
 
 int netdev_count(void)
 {
+  irqstate_t flags;
   struct net_driver_s *dev;
   int ndev;
 
-  net_lock();
+  flags = rcu_read_lock();
   for (dev = g_netdevices, ndev = 0; dev; dev = dev->flink, ndev++);
-  net_unlock();
+  rcu_read_unlock(flags);
   return ndev;
 }
@@ -39,6 +39,7 @@
 
 #include <nuttx/config.h>
 
+#include <nuttx/rcu.h>
 #include <nuttx/net/netdev.h>
 
 #include "utils/utils.h"
@@ -71,12 +72,13 @@
 
 FAR struct net_driver_s *netdev_default(void)
 {
+  irqstate_t flags;
   FAR struct net_driver_s *ret = NULL;
   FAR struct net_driver_s *dev;
 
   /* Examine each registered network device */
 
-  net_lock();
+  flags = rcu_read_lock();
   for (dev = g_netdevices; dev; dev = dev->flink)
     {
       /* Is the interface in the "up" state? */
@@ -96,6 +98,6 @@ FAR struct net_driver_s *netdev_default(void)
         }
     }
 
-  net_unlock();
+  rcu_read_unlock(flags);
   return ret;
 }
@@ -47,6 +47,7 @@
 
 #include <netinet/in.h>
 
+#include <nuttx/rcu.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ip.h>
 
@@ -80,11 +81,12 @@
 #ifdef CONFIG_NET_IPv4
 FAR struct net_driver_s *netdev_findby_lipv4addr(in_addr_t lipaddr)
 {
+  irqstate_t flags;
   FAR struct net_driver_s *dev;
 
   /* Examine each registered network device */
 
-  net_lock();
+  flags = rcu_read_lock();
   for (dev = g_netdevices; dev; dev = dev->flink)
     {
       /* Is the interface in the "up" state? */
@@ -98,7 +100,7 @@ FAR struct net_driver_s *netdev_findby_lipv4addr(in_addr_t lipaddr)
             {
               /* Its a match */
 
-              net_unlock();
+              rcu_read_unlock(flags);
               return dev;
             }
         }
@@ -106,7 +108,7 @@ FAR struct net_driver_s *netdev_findby_lipv4addr(in_addr_t lipaddr)
 
   /* No device with the matching address found */
 
-  net_unlock();
+  rcu_read_unlock(flags);
   return NULL;
 }
 #endif /* CONFIG_NET_IPv4 */
@@ -131,11 +133,12 @@ FAR struct net_driver_s *netdev_findby_lipv4addr(in_addr_t lipaddr)
 #ifdef CONFIG_NET_IPv6
 FAR struct net_driver_s *netdev_findby_lipv6addr(const net_ipv6addr_t lipaddr)
 {
+  irqstate_t flags;
   FAR struct net_driver_s *dev;
 
   /* Examine each registered network device */
 
-  net_lock();
+  flags = rcu_read_lock();
   for (dev = g_netdevices; dev; dev = dev->flink)
     {
       /* Is the interface in the "up" state? */
@@ -149,7 +152,7 @@ FAR struct net_driver_s *netdev_findby_lipv6addr(const net_ipv6addr_t lipaddr)
             {
               /* Its a match */
 
-              net_unlock();
+              rcu_read_unlock(flags);
               return dev;
             }
         }
@@ -157,7 +160,7 @@ FAR struct net_driver_s *netdev_findby_lipv6addr(const net_ipv6addr_t lipaddr)
 
   /* No device with the matching address found */
 
-  net_unlock();
+  rcu_read_unlock(flags);
   return NULL;
 }
 #endif /* CONFIG_NET_IPv6 */
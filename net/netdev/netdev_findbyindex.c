@@ -43,6 +43,7 @@
 #include <assert.h>
 #include <errno.h>
 
+#include <nuttx/rcu.h>
 #include <nuttx/net/netdev.h>
 
 #include "utils/utils.h"
@@ -70,6 +71,7 @@
 
 FAR struct net_driver_s *netdev_findbyindex(int ifindex)
 {
+  irqstate_t flags;
   FAR struct net_driver_s *dev;
   int i;
 
@@ -85,7 +87,7 @@ FAR struct net_driver_s *netdev_findbyindex(int ifindex)
     }
 #endif
 
-  net_lock();
+  flags = rcu_read_lock();
 
 #ifdef CONFIG_NETDEV_IFINDEX
   /* Check if this index has been assigned */
@@ -94,7 +96,7 @@ FAR struct net_driver_s *netdev_findbyindex(int ifindex)
     {
       /* This index has not been assigned */
 
-      net_unlock();
+      rcu_read_unlock(flags);
       return NULL;
     }
 #endif
@@ -117,12 +119,12 @@ FAR struct net_driver_s *netdev_findbyindex(int ifindex)
       if (i == (ifindex - 1))
 #endif
         {
-          net_unlock();
+          rcu_read_unlock(flags);
           return dev;
         }
     }
 
-  net_unlock();
+  rcu_read_unlock(flags);
   return NULL;
 }
 
@@ -42,6 +42,7 @@
 #include <string.h>
 #include <errno.h>
 
+#include <nuttx/rcu.h>
 #include <nuttx/net/netdev.h>
 
 #include "utils/utils.h"
@@ -68,21 +69,22 @@
 
 FAR struct net_driver_s *netdev_findbyname(FAR const char *ifname)
 {
+  irqstate_t flags;
   FAR struct net_driver_s *dev;
 
   if (ifname)
     {
-      net_lock();
+      flags = rcu_read_lock();
       for (dev = g_netdevices; dev; dev = dev->flink)
         {
           if (strcmp(ifname, dev->d_ifname) == 0)
             {
-              net_unlock();
+              rcu_read_unlock(flags);
               return dev;
             }
         }
 
-      net_unlock();
+      rcu_read_unlock(flags);
     }
 
   return NULL;
@@ -49,6 +49,7 @@
 
 #include <net/if.h>
 #include <net/ethernet.h>
+#include <nuttx/rcu.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ethernet.h>
@@ -403,10 +404,13 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
 
       snprintf(dev->d_ifname, IFNAMSIZ, devfmt, devnum);
 
-      /* Add the device to the list of known network devices */
+      /* Add the device to the list of known network devices.  Readers walk
+       * the list without the network lock, so the name and index must be
+       * set before the device is published.
+       */
 
       dev->flink  = g_netdevices;
-      g_netdevices = dev;
+      rcu_assign_pointer(g_netdevices, dev);
 
 #ifdef CONFIG_NET_IGMP
       /* Configure the device for IGMP support */
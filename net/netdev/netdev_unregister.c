@@ -48,6 +48,7 @@
 
 #include <net/if.h>
 #include <net/ethernet.h>
+#include <nuttx/rcu.h>
 #include <nuttx/net/netdev.h>
 
 #include "utils/utils.h"
@@ -148,16 +149,14 @@ int netdev_unregister(FAR struct net_driver_s *dev)
             {
               /* The entry was in the middle or at the end of the list */
 
-              prev->flink = curr->flink;
+              rcu_assign_pointer(prev->flink, curr->flink);
             }
           else
             {
               /* The entry was at the beginning of the list */
 
-              g_netdevices = curr->flink;
+              rcu_assign_pointer(g_netdevices, curr->flink);
             }
-
-          curr->flink = NULL;
         }
 
 #ifdef CONFIG_NETDEV_IFINDEX
@@ -165,6 +164,17 @@ int netdev_unregister(FAR struct net_driver_s *dev)
 #endif
       net_unlock();
 
+      /* Readers walking the list without the network lock may still be
+       * looking at the device.  Wait for them before the link is cleared
+       * and the caller frees the device.
+       */
+
+      if (curr)
+        {
+          synchronize_rcu();
+          curr->flink = NULL;
+        }
+
 #ifdef CONFIG_NET_ETHERNET
       ninfo("Unregistered MAC: %02x:%02x:%02x:%02x:%02x:%02x as dev: %s\n",
             dev->d_mac.ether.ether_addr_octet[0],
@@ -41,6 +41,7 @@
 
 #include <stdbool.h>
 
+#include <nuttx/rcu.h>
 #include <nuttx/net/netdev.h>
 
 #include "utils/utils.h"
@@ -63,12 +64,13 @@
 
 bool netdev_verify(FAR struct net_driver_s *dev)
 {
+  irqstate_t flags;
   FAR struct net_driver_s *chkdev;
   bool valid = false;
 
   /* Search the list of registered devices */
 
-  net_lock();
+  flags = rcu_read_lock();
   for (chkdev = g_netdevices; chkdev != NULL; chkdev = chkdev->flink)
     {
       /* Is the network device that we are looking for? */
@@ -82,6 +84,6 @@ bool netdev_verify(FAR struct net_driver_s *dev)
         }
     }
 
-  net_unlock();
+  rcu_read_unlock(flags);
   return valid;
 }
@@ -107,6 +107,7 @@ const struct sock_intf_s g_netlink_sockif =
   netlink_poll,         /* si_poll */
   netlink_send,         /* si_send */
   netlink_sendto,       /* si_sendto */
+  NULL,                 /* si_sendv */
 #ifdef CONFIG_NET_SENDFILE
   NULL,                 /* si_sendfile */
 #endif
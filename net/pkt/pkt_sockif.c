@@ -104,6 +104,7 @@ const struct sock_intf_s g_pkt_sockif =
   pkt_poll_local,  /* si_poll */
   pkt_send,        /* si_send */
   pkt_sendto,      /* si_sendto */
+  NULL,            /* si_sendv */
 #ifdef CONFIG_NET_SENDFILE
   NULL,            /* si_sendfile */
 #endif
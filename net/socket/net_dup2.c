@@ -201,9 +201,13 @@ int net_dup2(int sockfd1, int sockfd2)
       net_close(sockfd2);
     }
 
-  /* Duplicate the socket state */
+  /* Duplicate the socket state and claim the slot of sockfd2 */
 
   ret = psock_dup2(psock1, psock2);
+  if (ret >= 0)
+    {
+      psock_mark(psock2);
+    }
 
 errout:
   sched_unlock();
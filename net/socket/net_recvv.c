@@ -0,0 +1,163 @@
+/****************************************************************************
+ * net/socket/net_recvv.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <limits.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvv
+ *
+ * Description:
+ *   Receive into 'iovcnt' buffers as psock_recvfrom() would receive into
+ *   one.  This is the socket half of readv().
+ *
+ *   A stream socket fills the segments in turn.  Only the first receive may
+ *   block; the rest are made with MSG_DONTWAIT so that the call returns as
+ *   soon as the data that has already arrived is used up.  A message
+ *   socket receives one message into a temporary buffer and scatters it so
+ *   that the message is never split across two calls.
+ *
+ * Input Parameters:
+ *   psock  - An instance of the internal socket structure.
+ *   iov    - Array of buffers to receive into
+ *   iovcnt - Number of elements in iov[]
+ *   flags  - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On any
+ *   failure, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+ssize_t psock_recvv(FAR struct socket *psock, FAR const struct iovec *iov,
+                    int iovcnt, int flags)
+{
+  FAR uint8_t *buffer;
+  size_t len = 0;
+  size_t ncopy;
+  ssize_t ntotal;
+  ssize_t ret;
+  int i;
+
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  if (iovcnt < 0 || (iovcnt > 0 && iov == NULL))
+    {
+      return -EINVAL;
+    }
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len > SSIZE_MAX - len)
+        {
+          return -EINVAL;
+        }
+
+      len += iov[i].iov_len;
+    }
+
+  /* A single segment needs no scattering at all */
+
+  if (iovcnt == 1)
+    {
+      return psock_recvfrom(psock, iov[0].iov_base, iov[0].iov_len, flags,
+                            NULL, NULL);
+    }
+
+  if (psock->s_type == SOCK_STREAM)
+    {
+      ntotal = 0;
+      for (i = 0; i < iovcnt; i++)
+        {
+          if (iov[i].iov_len == 0)
+            {
+              continue;
+            }
+
+          ret = psock_recvfrom(psock, iov[i].iov_base, iov[i].iov_len,
+                               ntotal > 0 ? flags | MSG_DONTWAIT : flags,
+                               NULL, NULL);
+          if (ret < 0)
+            {
+              return ntotal > 0 ? ntotal : ret;
+            }
+
+          ntotal += ret;
+          if ((size_t)ret < iov[i].iov_len)
+            {
+              break;
+            }
+        }
+
+      return ntotal;
+    }
+
+  /* Receive the whole message, then scatter it */
+
+  buffer = kmm_malloc(len > 0 ? len : 1);
+  if (buffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ret = psock_recvfrom(psock, buffer, len, flags, NULL, NULL);
+  if (ret > 0)
+    {
+      for (ntotal = 0, i = 0; i < iovcnt && ntotal < ret; i++)
+        {
+          ncopy = iov[i].iov_len;
+          if (ncopy > (size_t)(ret - ntotal))
+            {
+              ncopy = ret - ntotal;
+            }
+
+          memcpy(iov[i].iov_base, buffer + ntotal, ncopy);
+          ntotal += ncopy;
+        }
+    }
+
+  kmm_free(buffer);
+  return ret;
+}
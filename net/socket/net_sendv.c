@@ -0,0 +1,176 @@
+/****************************************************************************
+ * net/socket/net_sendv.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <limits.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_sendv
+ *
+ * Description:
+ *   Send the data gathered from 'iovcnt' buffers as psock_send() would
+ *   send them from one.  This is the socket half of writev().
+ *
+ *   Address families that provide si_sendv() gather the segments straight
+ *   into their own buffers; si_sendv() returns -ENOSYS for sockets that it
+ *   does not handle.  Otherwise a stream socket sends the segments
+ *   one at a time, which preserves the byte stream, and a message socket
+ *   sends a single message assembled in a temporary buffer, which preserves
+ *   the message boundary.
+ *
+ * Input Parameters:
+ *   psock  - An instance of the internal socket structure.
+ *   iov    - Array of buffers to send
+ *   iovcnt - Number of elements in iov[]
+ *   flags  - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On any failure, a
+ *   negated errno value is returned.
+ *
+ ****************************************************************************/
+
+ssize_t psock_sendv(FAR struct socket *psock, FAR const struct iovec *iov,
+                    int iovcnt, int flags)
+{
+  FAR uint8_t *buffer;
+  size_t len = 0;
+  ssize_t ntotal;
+  ssize_t ret;
+  int i;
+
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  if (iovcnt < 0 || (iovcnt > 0 && iov == NULL))
+    {
+      return -EINVAL;
+    }
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len > SSIZE_MAX - len)
+        {
+          return -EINVAL;
+        }
+
+      len += iov[i].iov_len;
+    }
+
+  DEBUGASSERT(psock->s_sockif != NULL && psock->s_sockif->si_send != NULL);
+
+  /* Let the address family gather the data if it knows how.  -ENOSYS
+   * means that it has no native path for this particular socket.
+   */
+
+  if (psock->s_sockif->si_sendv != NULL)
+    {
+      ret = psock->s_sockif->si_sendv(psock, iov, iovcnt, flags);
+      if (ret != -ENOSYS)
+        {
+          if (ret < 0)
+            {
+              nerr("ERROR: socket si_sendv() failed: %d\n", ret);
+            }
+
+          return ret;
+        }
+    }
+
+  /* A single segment needs no gathering at all */
+
+  if (iovcnt == 1)
+    {
+      return psock_send(psock, iov[0].iov_base, iov[0].iov_len, flags);
+    }
+
+  if (psock->s_type == SOCK_STREAM)
+    {
+      /* Send the segments one at a time, stopping at the first that is not
+       * taken in full.
+       */
+
+      ntotal = 0;
+      for (i = 0; i < iovcnt; i++)
+        {
+          if (iov[i].iov_len == 0)
+            {
+              continue;
+            }
+
+          ret = psock_send(psock, iov[i].iov_base, iov[i].iov_len, flags);
+          if (ret < 0)
+            {
+              return ntotal > 0 ? ntotal : ret;
+            }
+
+          ntotal += ret;
+          if ((size_t)ret < iov[i].iov_len)
+            {
+              break;
+            }
+        }
+
+      return ntotal;
+    }
+
+  /* A message must go out in one piece.  Assemble it first. */
+
+  buffer = kmm_malloc(len > 0 ? len : 1);
+  if (buffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (ntotal = 0, i = 0; i < iovcnt; i++)
+    {
+      memcpy(buffer + ntotal, iov[i].iov_base, iov[i].iov_len);
+      ntotal += iov[i].iov_len;
+    }
+
+  ret = psock_send(psock, buffer, len, flags);
+  kmm_free(buffer);
+  return ret;
+}
@@ -45,6 +45,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/net/net.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/semaphore.h>
@@ -85,6 +86,10 @@ void net_initlist(FAR struct socketlist *list)
   /* Initialize the list access mutex */
 
   nxsem_init(&list->sl_sem, 0, 1);
+
+  /* No sockets are allocated yet */
+
+  memset(list->sl_inuse, 0, sizeof(list->sl_inuse));
 }
 
 /****************************************************************************
@@ -141,6 +146,7 @@ void net_releaselist(FAR struct socketlist *list)
 int sockfd_allocate(int minsd)
 {
   FAR struct socketlist *list;
+  irqstate_t flags;
   int i;
 
   /* Get the socket list for this task/thread */
@@ -148,24 +154,30 @@ int sockfd_allocate(int minsd)
   list = sched_getsockets();
   if (list)
     {
-      /* Search for a socket structure with no references */
+      /* Claim the lowest socket structure with no references from the
+       * allocation bitmap.  The semaphore serializes allocations; the
+       * critical section protects the bitmap from psock_release(), which
+       * may run without the semaphore.
+       */
 
       _net_semtake(list);
-      for (i = minsd; i < CONFIG_NSOCKET_DESCRIPTORS; i++)
+
+      flags = enter_critical_section();
+      i = fdmap_alloc(list->sl_inuse, CONFIG_NSOCKET_DESCRIPTORS, minsd);
+      leave_critical_section(flags);
+
+      if (i >= 0)
         {
-          /* Are there references on this socket? */
-
-          if (!list->sl_sockets[i].s_crefs)
-            {
-              /* No take the reference and return the index + an offset
-               * as the socket descriptor.
-               */
-
-              memset(&list->sl_sockets[i], 0, sizeof(struct socket));
-              list->sl_sockets[i].s_crefs = 1;
-              _net_semgive(list);
-              return i + __SOCKFD_OFFSET;
-            }
+          /* Take the reference and return the index + an offset as the
+           * socket descriptor.
+           */
+
+          DEBUGASSERT(list->sl_sockets[i].s_crefs == 0);
+
+          memset(&list->sl_sockets[i], 0, sizeof(struct socket));
+          list->sl_sockets[i].s_crefs = 1;
+          _net_semgive(list);
+          return i + __SOCKFD_OFFSET;
         }
 
       _net_semgive(list);
@@ -202,10 +214,56 @@ void psock_release(FAR struct socket *psock)
         }
       else
         {
-          /* The socket will not persist... reset it */
+          /* The socket will not persist... reset it and return its slot
+           * to the allocation bitmap.
+           */
 
           memset(psock, 0, sizeof(struct socket));
+          psock_mark(psock);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: psock_mark
+ *
+ * Description:
+ *   Update the socket allocation bitmap of the current task so that it
+ *   reflects whether 'psock' is allocated (has a non-zero reference count).
+ *   Nothing is done if 'psock' does not belong to the current task's socket
+ *   list.
+ *
+ * Input Parameters:
+ *   psock - A reference to the socket instance whose slot was (re)used.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void psock_mark(FAR struct socket *psock)
+{
+  FAR struct socketlist *list;
+  irqstate_t flags;
+  int ndx;
+
+  list = sched_getsockets();
+  if (list != NULL && psock >= list->sl_sockets &&
+      psock < &list->sl_sockets[CONFIG_NSOCKET_DESCRIPTORS])
+    {
+      ndx   = psock - list->sl_sockets;
+      flags = enter_critical_section();
+
+      if (psock->s_crefs > 0)
+        {
+          FDMAP_SET(list->sl_inuse, ndx);
         }
+      else
+        {
+          FDMAP_CLR(list->sl_inuse, ndx);
+        }
+
+      leave_critical_section(flags);
     }
 }
 
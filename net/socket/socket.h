@@ -172,6 +172,25 @@ int sockfd_allocate(int minsd);
 
 void psock_release(FAR struct socket *psock);
 
+/****************************************************************************
+ * Name: psock_mark
+ *
+ * Description:
+ *   Update the socket allocation bitmap of the current task so that it
+ *   reflects whether 'psock' is allocated (has a non-zero reference count).
+ *   Nothing is done if 'psock' does not belong to the current task's socket
+ *   list.
+ *
+ * Input Parameters:
+ *   psock - A reference to the socket instance whose slot was (re)used.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void psock_mark(FAR struct socket *psock);
+
 /****************************************************************************
  * Name: sockfd_release
  *
@@ -81,11 +81,11 @@
 #  define TCP_WBNRTX(wrb)            ((wrb)->wb_nrtx)
 #  define TCP_WBIOB(wrb)             ((wrb)->wb_iob)
 #  define TCP_WBCOPYOUT(wrb,dest,n)  (iob_copyout(dest,(wrb)->wb_iob,(n),0))
-#  define TCP_WBCOPYIN(wrb,src,n) \
-     (iob_copyin((wrb)->wb_iob,src,(n),0,false,\
+#  define TCP_WBCOPYIN(wrb,src,n,off) \
+     (iob_copyin((wrb)->wb_iob,src,(n),(off),false,\
                  IOBUSER_NET_TCP_WRITEBUFFER))
-#  define TCP_WBTRYCOPYIN(wrb,src,n) \
-     (iob_trycopyin((wrb)->wb_iob,src,(n),0,false,\
+#  define TCP_WBTRYCOPYIN(wrb,src,n,off) \
+     (iob_trycopyin((wrb)->wb_iob,src,(n),(off),false,\
                     IOBUSER_NET_TCP_WRITEBUFFER))
 
 #  define TCP_WBTRIM(wrb,n) \
@@ -1355,6 +1355,22 @@ struct socket;
 ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
                        size_t len, int flags);
 
+/****************************************************************************
+ * Name: psock_tcp_sendv
+ *
+ * Description:
+ *   Gather the data from 'iovcnt' buffers into one write buffer and queue
+ *   it as psock_tcp_send() would queue a single buffer.  Only available
+ *   with CONFIG_NET_TCP_WRITE_BUFFERS.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+struct iovec;
+ssize_t psock_tcp_sendv(FAR struct socket *psock,
+                        FAR const struct iovec *iov, int iovcnt, int flags);
+#endif
+
 /****************************************************************************
  * Name: tcp_setsockopt
  *
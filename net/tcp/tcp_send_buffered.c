@@ -52,6 +52,7 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 
 #include <stdint.h>
 #include <stdbool.h>
@@ -876,16 +877,18 @@ static inline void send_txnotify(FAR struct socket *psock,
  ****************************************************************************/
 
 /****************************************************************************
- * Name: psock_tcp_send
+ * Name: psock_tcp_sendv
  *
  * Description:
- *   psock_tcp_send() call may be used only when the TCP socket is in a
- *   connected state (so that the intended recipient is known).
+ *   psock_tcp_sendv() gathers the data from 'iovcnt' buffers into a single
+ *   write buffer.  The segments are therefore queued and sent together
+ *   rather than as one small TCP segment each.  Like psock_tcp_send(), it
+ *   may be used only when the TCP socket is in a connected state.
  *
  * Input Parameters:
  *   psock    An instance of the internal socket structure.
- *   buf      Data to send
- *   len      Length of data to send
+ *   iov      Array of buffers to send
+ *   iovcnt   Number of elements in iov[]
  *   flags    Send flags
  *
  * Returned Value:
@@ -931,14 +934,16 @@ static inline void send_txnotify(FAR struct socket *psock,
  *
  ****************************************************************************/
 
-ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
-                       size_t len, int flags)
+ssize_t psock_tcp_sendv(FAR struct socket *psock,
+                        FAR const struct iovec *iov, int iovcnt, int flags)
 {
   FAR struct tcp_conn_s *conn;
   FAR struct tcp_wrbuffer_s *wrb;
   ssize_t    result = 0;
+  size_t     len = 0;
   bool       nonblock;
   int        ret = OK;
+  int        i;
 
   if (psock == NULL || psock->s_crefs <= 0)
     {
@@ -994,9 +999,13 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
 
   nonblock = _SS_ISNONBLOCK(psock->s_flags) || (flags & MSG_DONTWAIT) != 0;
 
-  /* Dump the incoming buffer */
+  /* Dump the incoming buffers */
 
-  BUF_DUMP("psock_tcp_send", buf, len);
+  for (i = 0; i < iovcnt; i++)
+    {
+      BUF_DUMP("psock_tcp_send", iov[i].iov_base, iov[i].iov_len);
+      len += iov[i].iov_len;
+    }
 
   if (len > 0)
     {
@@ -1053,56 +1062,81 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
       TCP_WBSEQNO(wrb) = (unsigned)-1;
       TCP_WBNRTX(wrb)  = 0;
 
-      /* Copy the user data into the write buffer.  We cannot wait for
-       * buffer space if the socket was opened non-blocking.
+      /* Copy the user data into the write buffer, each segment following
+       * the last.  We cannot wait for buffer space if the socket was opened
+       * non-blocking.
        */
 
-      if (nonblock)
+      for (i = 0; i < iovcnt; i++)
         {
-          /* The return value from TCP_WBTRYCOPYIN is either OK or
-           * -ENOMEM if less than the entire data chunk could be allocated.
-           * If -ENOMEM is returned, check if at least a part of the data
-           * chunk was allocated. If more than zero bytes were sent
-           * we return that number and let the caller deal with sending the
-           * remaining data.
-           */
+          int copied;
 
-          result = TCP_WBTRYCOPYIN(wrb, (FAR uint8_t *)buf, len);
-          if (result == -ENOMEM)
+          if (iov[i].iov_len == 0)
             {
-              if (TCP_WBPKTLEN(wrb) > 0)
-                {
-                  ninfo("INFO: Allocated part of the requested data\n");
-                  result = TCP_WBPKTLEN(wrb);
-                }
-              else
+              continue;
+            }
+
+          if (nonblock)
+            {
+              /* The return value from TCP_WBTRYCOPYIN is either the number
+               * of bytes copied or -ENOMEM if less than the entire data
+               * chunk could be allocated.  If -ENOMEM is returned, check
+               * if at least a part of the data was allocated.  If more than
+               * zero bytes were sent we return that number and let the
+               * caller deal with sending the remaining data.
+               */
+
+              copied = TCP_WBTRYCOPYIN(wrb, (FAR uint8_t *)iov[i].iov_base,
+                                       iov[i].iov_len, result);
+              if (copied == -ENOMEM)
                 {
-                  nerr("ERROR: Failed to add data to the I/O buffer chain\n");
-                  ret = -EWOULDBLOCK;
-                  goto errout_with_wrb;
+                  if (TCP_WBPKTLEN(wrb) > 0)
+                    {
+                      ninfo("INFO: Allocated part of the requested data\n");
+                      result = TCP_WBPKTLEN(wrb);
+                      break;
+                    }
+                  else
+                    {
+                      nerr("ERROR: Failed to add data to the I/O buffer "
+                           "chain\n");
+                      ret = -EWOULDBLOCK;
+                      goto errout_with_wrb;
+                    }
                 }
             }
           else
             {
-              result = len;
-            }
-        }
-      else
-        {
-          unsigned int count;
-          int blresult;
+              unsigned int count;
+              int blresult;
 
-          /* iob_copyin might wait for buffers to be freed, but if network is
-           * locked this might never happen, since network driver is also locked,
-           * therefore we need to break the lock
-           */
+              /* iob_copyin might wait for buffers to be freed, but if
+               * network is locked this might never happen, since network
+               * driver is also locked, therefore we need to break the lock
+               */
 
-          blresult = net_breaklock(&count);
-          result = TCP_WBCOPYIN(wrb, (FAR uint8_t *)buf, len);
-          if (blresult >= 0)
-            {
-              net_restorelock(count);
+              blresult = net_breaklock(&count);
+              copied = TCP_WBCOPYIN(wrb, (FAR uint8_t *)iov[i].iov_base,
+                                    iov[i].iov_len, result);
+              if (blresult >= 0)
+                {
+                  net_restorelock(count);
+                }
+
+              if (copied < 0)
+                {
+                  /* Report what was queued before the failure, if any */
+
+                  if (result == 0)
+                    {
+                      result = copied;
+                    }
+
+                  break;
+                }
             }
+
+          result += iov[i].iov_len;
         }
 
       /* Dump I/O buffer chain */
@@ -1153,6 +1187,35 @@ errout:
   return ret;
 }
 
+/****************************************************************************
+ * Name: psock_tcp_send
+ *
+ * Description:
+ *   psock_tcp_send() call may be used only when the TCP socket is in a
+ *   connected state (so that the intended recipient is known).
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   buf      Data to send
+ *   len      Length of data to send
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On any failure, a
+ *   negated errno value is returned.  See psock_tcp_sendv().
+ *
+ ****************************************************************************/
+
+ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
+                       size_t len, int flags)
+{
+  struct iovec iov;
+
+  iov.iov_base = (FAR void *)buf;
+  iov.iov_len  = len;
+  return psock_tcp_sendv(psock, &iov, 1, flags);
+}
+
 /****************************************************************************
  * Name: psock_tcp_cansend
  *
@@ -83,6 +83,7 @@ const struct sock_intf_s g_usrsock_sockif =
   usrsock_poll,               /* si_poll */
   usrsock_sockif_send,        /* si_send */
   usrsock_sendto,             /* si_sendto */
+  NULL,                       /* si_sendv */
 #ifdef CONFIG_NET_SENDFILE
   NULL,                       /* si_sendfile */
 #endif
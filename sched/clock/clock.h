@@ -46,6 +46,7 @@
 
 #include <nuttx/clock.h>
 #include <nuttx/compiler.h>
+#include <nuttx/seqlock.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -80,7 +81,12 @@ extern volatile uint32_t g_system_timer;
 #endif
 
 #ifndef CONFIG_CLOCK_TIMEKEEPING
+/* The time-of-day at power up.  It is read under g_basetime_lock and
+ * written in the critical section, see include/nuttx/seqlock.h.
+ */
+
 extern struct timespec   g_basetime;
+extern seqlock_t         g_basetime_lock;
 #endif
 
 /****************************************************************************
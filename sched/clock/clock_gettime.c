@@ -118,19 +118,25 @@ int clock_gettime(clockid_t clock_id, struct timespec *tp)
       ret = clock_systimespec(&ts);
       if (ret == OK)
         {
-          irqstate_t flags;
+          struct timespec basetime;
+          uint32_t seq;
 
           /* Add the base time to this.  The base time is the time-of-day
            * setting.  When added to the elapsed time since the time-of-day
-           * was last set, this gives us the current time.
+           * was last set, this gives us the current time.  It is copied
+           * without a lock; the copy is retried if clock_settime() got in
+           * the way.
            */
 
-          flags = spin_lock_irqsave();
-
-          ts.tv_sec  += (uint32_t)g_basetime.tv_sec;
-          ts.tv_nsec += (uint32_t)g_basetime.tv_nsec;
+          do
+            {
+              seq      = read_seqbegin(&g_basetime_lock);
+              basetime = g_basetime;
+            }
+          while (read_seqretry(&g_basetime_lock, seq));
 
-          spin_unlock_irqrestore(flags);
+          ts.tv_sec  += (uint32_t)basetime.tv_sec;
+          ts.tv_nsec += (uint32_t)basetime.tv_nsec;
 
           /* Handle carry to seconds. */
 
@@ -73,6 +73,7 @@ volatile uint32_t g_system_timer = INITIAL_SYSTEM_TIMER_TICKS;
 
 #ifndef CONFIG_CLOCK_TIMEKEEPING
 struct timespec   g_basetime;
+seqlock_t         g_basetime_lock = SEQLOCK_INITIALIZER;
 #endif
 
 /****************************************************************************
@@ -176,13 +177,20 @@ static void clock_inittime(void)
   /* (Re-)initialize the time value to match the RTC */
 
 #ifndef CONFIG_CLOCK_TIMEKEEPING
+  struct timespec basetime;
   struct timespec ts;
 
-  clock_basetime(&g_basetime);
+  clock_basetime(&basetime);
+
+  write_seqbegin(&g_basetime_lock);
+  g_basetime = basetime;
+  write_seqend(&g_basetime_lock);
+
   clock_systimespec(&ts);
 
   /* Adjust base time to hide initial timer ticks. */
 
+  write_seqbegin(&g_basetime_lock);
   g_basetime.tv_sec  -= ts.tv_sec;
   g_basetime.tv_nsec -= ts.tv_nsec;
   while (g_basetime.tv_nsec < 0)
@@ -190,6 +198,8 @@ static void clock_inittime(void)
       g_basetime.tv_nsec += NSEC_PER_SEC;
       g_basetime.tv_sec--;
     }
+
+  write_seqend(&g_basetime_lock);
 #else
   clock_inittimekeeping();
 #endif
@@ -93,8 +93,11 @@ int clock_settime(clockid_t clock_id, FAR const struct timespec *tp)
 
       clock_systimespec(&bias);
 
-      /* Save the new base time. */
+      /* Save the new base time.  clock_gettime() reads it without the
+       * critical section, so bracket the update with the sequence.
+       */
 
+      write_seqbegin(&g_basetime_lock);
       g_basetime.tv_sec  = tp->tv_sec;
       g_basetime.tv_nsec = tp->tv_nsec;
 
@@ -113,6 +116,7 @@ int clock_settime(clockid_t clock_id, FAR const struct timespec *tp)
 
       g_basetime.tv_nsec -= bias.tv_nsec;
       g_basetime.tv_sec  -= bias.tv_sec;
+      write_seqend(&g_basetime_lock);
 
       /* Setup the RTC (lo- or high-res) */
 
@@ -77,6 +77,8 @@ int clock_systimespec(FAR struct timespec *ts)
 
   if (g_rtc_enabled)
     {
+      struct timespec basetime;
+      uint32_t seq;
       int ret;
 
       /* Get the hi-resolution time from the RTC.  This will return the
@@ -93,16 +95,23 @@ int clock_systimespec(FAR struct timespec *ts)
        * time since power up.
        */
 
-      DEBUGASSERT(ts->tv_sec >= g_basetime.tv_sec);
-      if (ts->tv_sec < g_basetime.tv_sec)
+      do
+        {
+          seq      = read_seqbegin(&g_basetime_lock);
+          basetime = g_basetime;
+        }
+      while (read_seqretry(&g_basetime_lock, seq));
+
+      DEBUGASSERT(ts->tv_sec >= basetime.tv_sec);
+      if (ts->tv_sec < basetime.tv_sec)
         {
           /* Negative times are not supported */
 
           return -ENOSYS;
         }
 
-      ts->tv_sec -= g_basetime.tv_sec;
-      if (ts->tv_nsec < g_basetime.tv_nsec)
+      ts->tv_sec -= basetime.tv_sec;
+      if (ts->tv_nsec < basetime.tv_nsec)
         {
           /* Borrow */
 
@@ -117,7 +126,7 @@ int clock_systimespec(FAR struct timespec *ts)
           ts->tv_nsec += NSEC_PER_SEC;
         }
 
-      ts->tv_nsec -= g_basetime.tv_nsec;
+      ts->tv_nsec -= basetime.tv_nsec;
       return OK;
     }
   else
@@ -49,6 +49,7 @@
 
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
+#include <nuttx/seqlock.h>
 
 #include "clock/clock.h"
 
@@ -62,6 +63,12 @@
  * Private Data
  ****************************************************************************/
 
+/* The wall time and the counter value it was taken at.  Readers copy them
+ * under g_clock_lock without entering the critical section; the writers
+ * hold the critical section and bump the sequence around their updates.
+ */
+
+static seqlock_t       g_clock_lock = SEQLOCK_INITIALIZER;
 static struct timespec g_clock_wall_time;
 static uint64_t        g_clock_last_counter;
 static uint64_t        g_clock_mask;
@@ -78,27 +85,34 @@ static long            g_clock_adjust;
 static int clock_get_current_time(FAR struct timespec *ts,
                                   FAR struct timespec *base)
 {
-  irqstate_t flags;
+  struct timespec copy;
   uint64_t counter;
   uint64_t offset;
   uint64_t nsec;
+  uint32_t seq;
   time_t sec;
   int ret;
 
-  flags = enter_critical_section();
-
-  ret = up_timer_getcounter(&counter);
-  if (ret < 0)
+  do
     {
-      goto errout_in_critical_section;
+      seq = read_seqbegin(&g_clock_lock);
+
+      ret = up_timer_getcounter(&counter);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      copy   = *base;
+      offset = (counter - g_clock_last_counter) & g_clock_mask;
     }
+  while (read_seqretry(&g_clock_lock, seq));
 
-  offset = (counter - g_clock_last_counter) & g_clock_mask;
   nsec   = offset * NSEC_PER_TICK;
   sec    = nsec   / NSEC_PER_SEC;
   nsec  -= sec    * NSEC_PER_SEC;
 
-  nsec  += base->tv_nsec;
+  nsec  += copy.tv_nsec;
   if (nsec >= NSEC_PER_SEC)
     {
       nsec -= NSEC_PER_SEC;
@@ -106,11 +120,8 @@ static int clock_get_current_time(FAR struct timespec *ts,
     }
 
   ts->tv_nsec = nsec;
-  ts->tv_sec = base->tv_sec + sec;
-
-errout_in_critical_section:
-  leave_critical_section(flags);
-  return ret;
+  ts->tv_sec = copy.tv_sec + sec;
+  return OK;
 }
 
 /****************************************************************************
@@ -144,9 +155,11 @@ int clock_timekeeping_set_wall_time(FAR struct timespec *ts)
       goto errout_in_critical_section;
     }
 
+  write_seqbegin(&g_clock_lock);
   g_clock_wall_time    = *ts;
   g_clock_adjust       = 0;
   g_clock_last_counter = counter;
+  write_seqend(&g_clock_lock);
 
 errout_in_critical_section:
   leave_critical_section(flags);
@@ -277,10 +290,12 @@ void clock_update_wall_time(void)
         }
     }
 
+  write_seqbegin(&g_clock_lock);
   g_clock_wall_time.tv_sec += sec;
   g_clock_wall_time.tv_nsec = (long)nsec;
 
   g_clock_last_counter = counter;
+  write_seqend(&g_clock_lock);
 
 errout_in_critical_section:
   leave_critical_section(flags);
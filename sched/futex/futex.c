@@ -0,0 +1,328 @@
+/****************************************************************************
+ * sched/futex/futex.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/futex.h>
+#include <stdint.h>
+#include <queue.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/cancelpt.h>
+#include <nuttx/semaphore.h>
+
+#include "sched/sched.h"
+#include "futex/futex.h"
+
+#ifdef CONFIG_FUTEX
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A thread sleeping in FUTEX_WAIT.  The structure lives on the stack of
+ * the sleeping thread and is queued in the hash bucket of its address.
+ * The TCB of the thread points to it while it is queued, so that it can be
+ * removed if the thread is deleted in its sleep.
+ */
+
+struct futex_waiter_s
+{
+  sq_entry_t node;                  /* Supports a singly linked list */
+  FAR volatile uint32_t *uaddr;     /* Address waited on */
+#ifdef CONFIG_ARCH_ADDRENV
+  FAR struct task_group_s *group;   /* Address space of uaddr */
+#endif
+  sem_t sem;                        /* Posted by FUTEX_WAKE */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Waiters hashed by address.  All buckets are protected by the critical
+ * section.
+ */
+
+static sq_queue_t g_futex_hash[CONFIG_FUTEX_NHASH];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: futex_bucket
+ ****************************************************************************/
+
+static inline FAR sq_queue_t *futex_bucket(FAR volatile uint32_t *uaddr)
+{
+  return &g_futex_hash[((uintptr_t)uaddr >> 2) % CONFIG_FUTEX_NHASH];
+}
+
+/****************************************************************************
+ * Name: futex_match
+ ****************************************************************************/
+
+static inline bool futex_match(FAR struct futex_waiter_s *waiter,
+                               FAR volatile uint32_t *uaddr)
+{
+#ifdef CONFIG_ARCH_ADDRENV
+  return waiter->uaddr == uaddr && waiter->group == this_task()->group;
+#else
+  return waiter->uaddr == uaddr;
+#endif
+}
+
+/****************************************************************************
+ * Name: futex_dequeue
+ *
+ * Description:
+ *   Remove the waiter from its bucket if it is still there.  A waiter that
+ *   is no longer queued has been taken by FUTEX_WAKE.
+ *
+ ****************************************************************************/
+
+static bool futex_dequeue(FAR sq_queue_t *bucket,
+                          FAR struct futex_waiter_s *waiter)
+{
+  FAR sq_entry_t *node;
+
+  for (node = sq_peek(bucket); node != NULL; node = sq_next(node))
+    {
+      if (node == &waiter->node)
+        {
+          sq_rem(node, bucket);
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: futex_wait
+ ****************************************************************************/
+
+static int futex_wait(FAR volatile uint32_t *uaddr, uint32_t val,
+                      FAR const struct timespec *abstime)
+{
+  FAR sq_queue_t *bucket = futex_bucket(uaddr);
+  FAR struct tcb_s *rtcb = this_task();
+  struct futex_waiter_s waiter;
+  irqstate_t flags;
+  int ret;
+
+  waiter.uaddr = uaddr;
+#ifdef CONFIG_ARCH_ADDRENV
+  waiter.group = rtcb->group;
+#endif
+
+  /* The semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&waiter.sem, 0, 0);
+  nxsem_setprotocol(&waiter.sem, SEM_PRIO_NONE);
+
+  /* The value is checked and the waiter queued in the same critical
+   * section FUTEX_WAKE takes.  A thread that changes the value and then
+   * wakes us either runs before the check, or finds us queued.
+   */
+
+  flags = enter_critical_section();
+
+  if (*uaddr != val)
+    {
+      ret = -EAGAIN;
+    }
+  else
+    {
+      sq_addlast(&waiter.node, bucket);
+      rtcb->futexwait = &waiter;
+
+      if (abstime != NULL)
+        {
+          ret = nxsem_timedwait(&waiter.sem, abstime);
+        }
+      else
+        {
+          ret = nxsem_wait(&waiter.sem);
+        }
+
+      /* A wake-up that raced with the timeout or a signal has already
+       * removed us and must not be lost.
+       */
+
+      if (ret < 0 && !futex_dequeue(bucket, &waiter))
+        {
+          ret = OK;
+        }
+
+      rtcb->futexwait = NULL;
+    }
+
+  leave_critical_section(flags);
+  nxsem_destroy(&waiter.sem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: futex_wake
+ ****************************************************************************/
+
+static int futex_wake(FAR volatile uint32_t *uaddr, uint32_t nwake)
+{
+  FAR sq_queue_t *bucket = futex_bucket(uaddr);
+  FAR struct futex_waiter_s *waiter;
+  FAR sq_entry_t *node;
+  FAR sq_entry_t *next;
+  irqstate_t flags;
+  uint32_t nwoken = 0;
+
+  /* Keep the woken threads from running until the bucket has been walked;
+   * they are removed from it here, but others may time out meanwhile.
+   */
+
+  sched_lock();
+  flags = enter_critical_section();
+
+  for (node = sq_peek(bucket); node != NULL && nwoken < nwake; node = next)
+    {
+      next   = sq_next(node);
+      waiter = (FAR struct futex_waiter_s *)node;
+
+      if (futex_match(waiter, uaddr))
+        {
+          sq_rem(node, bucket);
+          nxsem_post(&waiter->sem);
+          nwoken++;
+        }
+    }
+
+  leave_critical_section(flags);
+  sched_unlock();
+  return (int)nwoken;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: futex_recover
+ *
+ * Description:
+ *   This function is called from nxtask_recover() when a task is deleted
+ *   or restarted.  If the task was sleeping in FUTEX_WAIT, its waiter,
+ *   which lives on the stack of the task, is removed from the hash bucket.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the terminated task or thread
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void futex_recover(FAR struct tcb_s *tcb)
+{
+  FAR struct futex_waiter_s *waiter;
+  irqstate_t flags;
+
+  flags  = enter_critical_section();
+  waiter = tcb->futexwait;
+  if (waiter != NULL)
+    {
+      futex_dequeue(futex_bucket(waiter->uaddr), waiter);
+      tcb->futexwait = NULL;
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: futex
+ *
+ * Description:
+ *   Sleep on, or wake the threads sleeping on, a 32-bit word in user
+ *   memory.  The word itself is only ever read here; it is up to the
+ *   caller to update it atomically.  This lets synchronization objects
+ *   in user memory take their uncontended paths without a system call
+ *   and enter the kernel only to sleep or to wake a sleeper.
+ *
+ *   FUTEX_WAIT is a cancellation point.
+ *
+ * Input Parameters:
+ *   uaddr   - The address of the futex word
+ *   op      - FUTEX_WAIT or FUTEX_WAKE
+ *   val     - The expected value (FUTEX_WAIT) or the number of threads
+ *             to wake (FUTEX_WAKE)
+ *   abstime - Absolute CLOCK_REALTIME timeout of FUTEX_WAIT, or NULL
+ *
+ * Returned Value:
+ *   The number of threads woken (FUTEX_WAKE) or zero (FUTEX_WAIT) on
+ *   success; -1 (ERROR) with errno set on failure:
+ *
+ *   EAGAIN    - The futex word did not hold val
+ *   ETIMEDOUT - abstime passed before the thread was woken
+ *   EINTR     - A signal was received
+ *   EINVAL    - Bad address or operation
+ *
+ ****************************************************************************/
+
+int futex(FAR volatile uint32_t *uaddr, int op, uint32_t val,
+          FAR const struct timespec *abstime)
+{
+  int ret;
+
+  if (uaddr == NULL || ((uintptr_t)uaddr & 3) != 0)
+    {
+      ret = -EINVAL;
+    }
+  else if (op == FUTEX_WAIT)
+    {
+      enter_cancellation_point();
+      ret = futex_wait(uaddr, val, abstime);
+      leave_cancellation_point();
+    }
+  else if (op == FUTEX_WAKE)
+    {
+      ret = futex_wake(uaddr, val);
+    }
+  else
+    {
+      ret = -EINVAL;
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      return ERROR;
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_FUTEX */
@@ -0,0 +1,57 @@
+/****************************************************************************
+ * sched/futex/futex.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __SCHED_FUTEX_FUTEX_H
+#define __SCHED_FUTEX_FUTEX_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#ifdef CONFIG_FUTEX
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+struct tcb_s; /* Forward reference */
+
+/****************************************************************************
+ * Name: futex_recover
+ *
+ * Description:
+ *   This function is called from nxtask_recover() when a task is deleted
+ *   or restarted.  If the task was sleeping in FUTEX_WAIT, its waiter,
+ *   which lives on the stack of the task, is removed from the hash bucket.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the terminated task or thread
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void futex_recover(FAR struct tcb_s *tcb);
+
+#endif /* CONFIG_FUTEX */
+#endif /* __SCHED_FUTEX_FUTEX_H */
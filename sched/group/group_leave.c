@@ -270,6 +270,12 @@ static inline void group_release(FAR struct task_group_s *group)
     }
 #endif
 
+#ifdef CONFIG_FS_RAMMAP
+  /* Drop the file mappings that the group did not unmap itself */
+
+  rammap_release(group);
+#endif
+
 #if defined(CONFIG_SCHED_WAITPID) && !defined(CONFIG_SCHED_HAVE_PARENT)
   /* If there are threads waiting for this group to be freed, then we cannot
    * yet free the memory resources.  Instead just mark the group deleted
@@ -118,9 +118,15 @@ static inline void sched_dupfiles(FAR struct task_tcb_s *tcb)
       if (parent[i].f_inode &&
           (parent[i].f_oflags & O_CLOEXEC) == 0)
         {
-          /* Yes... duplicate it for the child */
-
-          file_dup2(&parent[i], &child[i]);
+          /* Yes... duplicate it for the child.  file_dup2() only
+           * maintains the allocation bitmap of the caller's own list, so
+           * mark the descriptor in the child's list here.
+           */
+
+          if (file_dup2(&parent[i], &child[i]) >= 0)
+            {
+              FDMAP_SET(tcb->cmn.group->tg_filelist.fl_inuse, i);
+            }
         }
     }
 }
@@ -175,9 +181,14 @@ static inline void sched_dupsockets(FAR struct task_tcb_s *tcb)
       if (parent[i].s_crefs > 0 &&
           !_SS_ISCLOEXEC(parent[i].s_flags))
         {
-          /* Yes... duplicate it for the child */
-
-          psock_dup2(&parent[i], &child[i]);
+          /* Yes... duplicate it for the child and mark it allocated in
+           * the child's socket list.
+           */
+
+          if (psock_dup2(&parent[i], &child[i]) >= 0)
+            {
+              FDMAP_SET(tcb->cmn.group->tg_socketlist.sl_inuse, i);
+            }
         }
     }
 }
@@ -0,0 +1,395 @@
+/****************************************************************************
+ * sched/hrtimer/hrtimer.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/hrtimer.h>
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The running timers form a pairing heap: each node is no later than its
+ * children, so the root is the next to expire.  Insertion is O(1); removal
+ * is O(log n) amortized.  All accesses are made in the critical section.
+ */
+
+static FAR struct hrtimer_s *g_hrtimer_root;
+
+/* True while hrtimer_expiration() runs the callbacks.  The alarm is then
+ * reprogrammed once at the end rather than on every restart.
+ */
+
+static bool g_hrtimer_expiring;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: hrtimer_active
+ ****************************************************************************/
+
+static inline bool hrtimer_active(FAR struct hrtimer_s *hrtimer)
+{
+  return hrtimer == g_hrtimer_root || hrtimer->prev != NULL;
+}
+
+/****************************************************************************
+ * Name: hrtimer_meld
+ *
+ * Description:
+ *   Join two heaps by making the later root the first child of the
+ *   earlier one.  Both roots must have no siblings.
+ *
+ ****************************************************************************/
+
+static FAR struct hrtimer_s *hrtimer_meld(FAR struct hrtimer_s *a,
+                                          FAR struct hrtimer_s *b)
+{
+  FAR struct hrtimer_s *tmp;
+
+  if (a == NULL)
+    {
+      return b;
+    }
+  else if (b == NULL)
+    {
+      return a;
+    }
+
+  if (b->expired < a->expired)
+    {
+      tmp = a;
+      a   = b;
+      b   = tmp;
+    }
+
+  b->prev    = a;
+  b->sibling = a->child;
+  if (a->child != NULL)
+    {
+      a->child->prev = b;
+    }
+
+  a->child = b;
+  return a;
+}
+
+/****************************************************************************
+ * Name: hrtimer_merge
+ *
+ * Description:
+ *   Merge the list of siblings starting at 'first' into a single heap:
+ *   meld them in pairs from left to right, then meld the pairs from right
+ *   to left.
+ *
+ ****************************************************************************/
+
+static FAR struct hrtimer_s *hrtimer_merge(FAR struct hrtimer_s *first)
+{
+  FAR struct hrtimer_s *pairs = NULL;
+  FAR struct hrtimer_s *root = NULL;
+  FAR struct hrtimer_s *a;
+  FAR struct hrtimer_s *b;
+
+  while (first != NULL)
+    {
+      a     = first;
+      b     = a->sibling;
+      first = b != NULL ? b->sibling : NULL;
+
+      a->prev    = NULL;
+      a->sibling = NULL;
+      if (b != NULL)
+        {
+          b->prev    = NULL;
+          b->sibling = NULL;
+          a          = hrtimer_meld(a, b);
+        }
+
+      /* Stack the pairs so that the second pass sees them in reverse */
+
+      a->sibling = pairs;
+      pairs      = a;
+    }
+
+  while (pairs != NULL)
+    {
+      a          = pairs;
+      pairs      = a->sibling;
+      a->sibling = NULL;
+      root       = hrtimer_meld(root, a);
+    }
+
+  return root;
+}
+
+/****************************************************************************
+ * Name: hrtimer_remove
+ ****************************************************************************/
+
+static void hrtimer_remove(FAR struct hrtimer_s *hrtimer)
+{
+  FAR struct hrtimer_s *sub;
+
+  if (hrtimer == g_hrtimer_root)
+    {
+      g_hrtimer_root = hrtimer_merge(hrtimer->child);
+    }
+  else
+    {
+      /* Unlink the subtree from its parent or previous sibling, then
+       * put its children back.
+       */
+
+      if (hrtimer->prev->child == hrtimer)
+        {
+          hrtimer->prev->child = hrtimer->sibling;
+        }
+      else
+        {
+          hrtimer->prev->sibling = hrtimer->sibling;
+        }
+
+      if (hrtimer->sibling != NULL)
+        {
+          hrtimer->sibling->prev = hrtimer->prev;
+        }
+
+      sub            = hrtimer_merge(hrtimer->child);
+      g_hrtimer_root = hrtimer_meld(g_hrtimer_root, sub);
+    }
+
+  hrtimer->child   = NULL;
+  hrtimer->sibling = NULL;
+  hrtimer->prev    = NULL;
+}
+
+/****************************************************************************
+ * Name: hrtimer_reprogram
+ ****************************************************************************/
+
+static void hrtimer_reprogram(void)
+{
+  up_hrtimer_start(g_hrtimer_root != NULL ?
+                   g_hrtimer_root->expired : UINT64_MAX);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: hrtimer_init
+ ****************************************************************************/
+
+void hrtimer_init(FAR struct hrtimer_s *hrtimer)
+{
+  hrtimer->child   = NULL;
+  hrtimer->sibling = NULL;
+  hrtimer->prev    = NULL;
+  hrtimer->expired = 0;
+  hrtimer->func    = NULL;
+  hrtimer->arg     = NULL;
+}
+
+/****************************************************************************
+ * Name: hrtimer_start
+ ****************************************************************************/
+
+int hrtimer_start(FAR struct hrtimer_s *hrtimer, uint64_t expired,
+                  hrtimer_cb_t func, FAR void *arg)
+{
+  FAR struct hrtimer_s *root;
+  irqstate_t flags;
+
+  if (hrtimer == NULL || func == NULL)
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+
+  root = g_hrtimer_root;
+  if (hrtimer_active(hrtimer))
+    {
+      hrtimer_remove(hrtimer);
+    }
+
+  hrtimer->expired = expired;
+  hrtimer->func    = func;
+  hrtimer->arg     = arg;
+  g_hrtimer_root   = hrtimer_meld(g_hrtimer_root, hrtimer);
+
+  if (g_hrtimer_root != root && !g_hrtimer_expiring)
+    {
+      hrtimer_reprogram();
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: hrtimer_cancel
+ ****************************************************************************/
+
+int hrtimer_cancel(FAR struct hrtimer_s *hrtimer)
+{
+  FAR struct hrtimer_s *root;
+  irqstate_t flags;
+
+  if (hrtimer == NULL)
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+
+  if (hrtimer_active(hrtimer))
+    {
+      root = g_hrtimer_root;
+      hrtimer_remove(hrtimer);
+
+      if (g_hrtimer_root != root && !g_hrtimer_expiring)
+        {
+          hrtimer_reprogram();
+        }
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: hrtimer_gettime
+ ****************************************************************************/
+
+uint64_t hrtimer_gettime(FAR struct hrtimer_s *hrtimer)
+{
+  irqstate_t flags;
+  uint64_t remaining = 0;
+  uint64_t now;
+
+  flags = enter_critical_section();
+
+  if (hrtimer_active(hrtimer))
+    {
+      now = hrtimer_now();
+      if (hrtimer->expired > now)
+        {
+          remaining = hrtimer->expired - now;
+        }
+    }
+
+  leave_critical_section(flags);
+  return remaining;
+}
+
+/****************************************************************************
+ * Name: hrtimer_now
+ ****************************************************************************/
+
+uint64_t hrtimer_now(void)
+{
+  struct timespec ts;
+
+  /* Read the clock that the alarm is programmed in, not
+   * clock_systimespec() which may be based on the RTC.
+   */
+
+  if (up_timer_gettime(&ts) < 0)
+    {
+      return 0;
+    }
+
+  return hrtimer_time2ns(&ts);
+}
+
+/****************************************************************************
+ * Name: hrtimer_abstime
+ ****************************************************************************/
+
+uint64_t hrtimer_abstime(clockid_t clockid,
+                         FAR const struct timespec *abstime)
+{
+  struct timespec clktime;
+  uint64_t expired;
+  uint64_t clknow;
+  uint64_t now;
+
+  /* Move the time from 'clockid' to the time base of the alarm.  A time
+   * that has passed expires at once.
+   */
+
+  now = hrtimer_now();
+  if (clock_gettime(clockid, &clktime) < 0)
+    {
+      return now;
+    }
+
+  expired = hrtimer_time2ns(abstime);
+  clknow  = hrtimer_time2ns(&clktime);
+
+  return expired > clknow ? now + (expired - clknow) : now;
+}
+
+/****************************************************************************
+ * Name: hrtimer_expiration
+ ****************************************************************************/
+
+void hrtimer_expiration(uint64_t now)
+{
+  FAR struct hrtimer_s *hrtimer;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  g_hrtimer_expiring = true;
+
+  while (g_hrtimer_root != NULL && g_hrtimer_root->expired <= now)
+    {
+      /* Take the timer out of the heap before its callback, which may
+       * start it again.
+       */
+
+      hrtimer        = g_hrtimer_root;
+      g_hrtimer_root = hrtimer_merge(hrtimer->child);
+      hrtimer->child = NULL;
+
+      hrtimer->func(hrtimer);
+    }
+
+  g_hrtimer_expiring = false;
+  hrtimer_reprogram();
+  leave_critical_section(flags);
+}
@@ -361,6 +361,10 @@ extern volatile spinlock_t g_cpu_tasklistlock SP_SECTION;
 extern volatile int16_t g_global_lockcount;
 #endif
 
+/* Context switches on each CPU, counted for RCU grace periods */
+
+extern volatile uint32_t g_rcu_qs[CONFIG_SMP_NCPUS];
+
 #endif /* CONFIG_SMP */
 
 /****************************************************************************
@@ -0,0 +1,124 @@
+/****************************************************************************
+ * sched/sched/sched_rcu.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/rcu.h>
+#include <nuttx/signal.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SMP
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* Context switches on each CPU, counted by sched_resume_scheduler() */
+
+volatile uint32_t g_rcu_qs[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rcu_pending
+ *
+ * Description:
+ *   Return true if another CPU has not switched context since the counts
+ *   in 'snap' were taken.  The calling CPU is skipped: no read section can
+ *   be in progress on the CPU we run on, and if we moved here since, this
+ *   CPU has switched context.
+ *
+ ****************************************************************************/
+
+static bool rcu_pending(FAR const uint32_t *snap, int cpu)
+{
+  return cpu != this_cpu() && g_rcu_qs[cpu] == snap[cpu];
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: synchronize_rcu
+ *
+ * Description:
+ *   Wait until every read section in progress on the other CPUs has
+ *   ended.  CPUs that switch context within a tick cost nothing more.  A
+ *   CPU that does not is paused: it can take the pause request only with
+ *   its interrupts enabled, which is outside of any read section.
+ *
+ ****************************************************************************/
+
+void synchronize_rcu(void)
+{
+  uint32_t snap[CONFIG_SMP_NCPUS];
+  irqstate_t flags;
+  bool pending = false;
+  int cpu;
+
+  SP_DMB();
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      snap[cpu] = g_rcu_qs[cpu];
+    }
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      pending |= rcu_pending(snap, cpu);
+    }
+
+  if (!pending)
+    {
+      return;
+    }
+
+  nxsig_usleep(USEC_PER_TICK);
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      flags = enter_critical_section();
+
+      if (rcu_pending(snap, cpu))
+        {
+          DEBUGVERIFY(up_cpu_pause(cpu));
+          DEBUGVERIFY(up_cpu_resume(cpu));
+        }
+
+      leave_critical_section(flags);
+    }
+}
+
+#endif /* CONFIG_SMP */
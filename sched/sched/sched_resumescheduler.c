@@ -113,6 +113,10 @@ void sched_resume_scheduler(FAR struct tcb_s *tcb)
 
   int me = this_cpu();
 
+  /* A context switch is a quiescent state for RCU */
+
+  g_rcu_qs[me]++;
+
   /* Adjust global IRQ controls.  If irqcount is greater than zero,
    * then this task/this CPU holds the IRQ lock
    */
@@ -0,0 +1,109 @@
+/****************************************************************************
+ * sched/semaphore/sem_hrtimedwait.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/hrtimer.h>
+
+#include "sched/sched.h"
+#include "semaphore/semaphore.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsem_hrtimedwait
+ *
+ * Description:
+ *   This function is a variant of nxsem_timedwait() with a high resolution
+ *   timeout.  It is non-standard and intended only for use within the RTOS.
+ *
+ * Input Parameters:
+ *   sem     - Semaphore object
+ *   expired - The time, in nanoseconds of hrtimer_now(), at which the wait
+ *             times out.
+ *
+ * Returned Value:
+ *   This is an internal OS interface, not available to applications, and
+ *   hence follows the NuttX internal error return policy:  Zero (OK) is
+ *   returned on success.  A negated errno value is returned on failure.
+ *   -ETIMEDOUT is returned on the timeout condition.
+ *
+ ****************************************************************************/
+
+int nxsem_hrtimedwait(FAR sem_t *sem, uint64_t expired)
+{
+  FAR struct tcb_s *rtcb = this_task();
+  irqstate_t flags;
+  int ret;
+
+  DEBUGASSERT(sem != NULL && up_interrupt_context() == false);
+
+  /* We will disable interrupts until we have completed the semaphore
+   * wait, so that neither a post from an interrupt handler nor the timer
+   * can slip in between the checks below and the wait.
+   */
+
+  flags = enter_critical_section();
+
+  /* Try to take the semaphore without waiting. */
+
+  ret = nxsem_trywait(sem);
+  if (ret == OK)
+    {
+      goto out_with_irqdisabled;
+    }
+
+  if (expired <= hrtimer_now())
+    {
+      ret = -ETIMEDOUT;
+      goto out_with_irqdisabled;
+    }
+
+  /* Start the timer of the TCB with interrupts still disabled.  It is
+   * cancelled before we return, or by nxtask_recover() if the task is
+   * deleted while waiting.
+   */
+
+  hrtimer_start(&rtcb->waittimer, expired, nxsem_hrtimeout, rtcb);
+
+  /* Now perform the blocking wait */
+
+  ret = nxsem_wait(sem);
+
+  /* Stop the timer */
+
+  hrtimer_cancel(&rtcb->waittimer);
+
+out_with_irqdisabled:
+  leave_critical_section(flags);
+  return ret;
+}
@@ -87,12 +87,24 @@ int nxsem_post(FAR sem_t *sem)
 {
   FAR struct tcb_s *stcb = NULL;
   irqstate_t flags;
+  int16_t semcount;
   int ret = -EINVAL;
 
   /* Make sure we were supplied with a valid semaphore. */
 
   if (sem != NULL)
     {
+#ifdef CONFIG_SEM_FASTPATH
+      /* Give the count back without the critical section if no thread
+       * waits for it and no holder has to be released.
+       */
+
+      if (nxsem_fastpath(sem) && nxsem_tryinc(sem))
+        {
+          return OK;
+        }
+#endif
+
       /* The following operations must be performed with interrupts
        * disabled because sem_post() may be called from an interrupt
        * handler.
@@ -119,7 +131,7 @@ int nxsem_post(FAR sem_t *sem)
 
       DEBUGASSERT(sem->semcount < SEM_VALUE_MAX);
       nxsem_releaseholder(sem);
-      sem->semcount++;
+      semcount = nxsem_fetch_add(sem, 1) + 1;
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
       /* Don't let any unblocked tasks run until we complete any priority
@@ -136,7 +148,7 @@ int nxsem_post(FAR sem_t *sem)
        * there must be some task waiting for the semaphore.
        */
 
-      if (sem->semcount <= 0)
+      if (semcount <= 0)
         {
           /* Check if there are any tasks in the waiting for semaphore
            * task list that are waiting for this semaphore. This is a
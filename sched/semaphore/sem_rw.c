@@ -0,0 +1,414 @@
+/****************************************************************************
+ * sched/semaphore/sem_rw.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <unistd.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/rwsem.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rwsem_lock
+ *
+ * Description:
+ *   Take the semaphore protecting the lock state on a release path, which
+ *   may not fail.
+ *
+ ****************************************************************************/
+
+static void rwsem_lock(FAR rw_semaphore_t *rwsem)
+{
+  int ret;
+
+  do
+    {
+      ret = nxsem_wait_uninterruptible(&rwsem->protect);
+
+      /* The only possible error is due to cancellation of the thread.
+       * We need to try again anyway in this case, otherwise the lock would
+       * never be released.
+       */
+
+      DEBUGASSERT(ret == OK || ret == -ECANCELED);
+    }
+  while (ret < 0);
+}
+
+/****************************************************************************
+ * Name: rwsem_sleep
+ *
+ * Description:
+ *   Sleep until the lock changes hands.  Called with 'protect' held;
+ *   returns with it held again on success, and released on failure.
+ *
+ ****************************************************************************/
+
+static int rwsem_sleep(FAR rw_semaphore_t *rwsem)
+{
+  int ret;
+
+  rwsem->waiter++;
+  nxsem_post(&rwsem->protect);
+
+  ret = nxsem_wait_uninterruptible(&rwsem->waiting);
+  if (ret < 0)
+    {
+      /* Give up the place among the sleepers.  A wakeup already posted
+       * for this thread only wakes a later sleeper early, which then
+       * checks the lock again.
+       */
+
+      rwsem_lock(rwsem);
+      rwsem->waiter--;
+      nxsem_post(&rwsem->protect);
+      return ret;
+    }
+
+  return nxsem_wait_uninterruptible(&rwsem->protect);
+}
+
+/****************************************************************************
+ * Name: rwsem_wakeall
+ *
+ * Description:
+ *   Wake all sleepers to check the lock again.  Called with 'protect'
+ *   held.
+ *
+ ****************************************************************************/
+
+static void rwsem_wakeall(FAR rw_semaphore_t *rwsem)
+{
+  while (rwsem->waiter > 0)
+    {
+      rwsem->waiter--;
+      nxsem_post(&rwsem->waiting);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: init_rwsem
+ *
+ * Description:
+ *   Initialize a reader-writer lock.
+ *
+ * Input Parameters:
+ *   rwsem - The lock to initialize
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int init_rwsem(FAR rw_semaphore_t *rwsem)
+{
+  int ret;
+
+  ret = nxsem_init(&rwsem->protect, 0, 1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = nxsem_init(&rwsem->waiting, 0, 0);
+  if (ret < 0)
+    {
+      nxsem_destroy(&rwsem->protect);
+      return ret;
+    }
+
+  /* The waiting semaphore is used for signaling and, hence, should not
+   * have priority inheritance enabled.
+   */
+
+  nxsem_setprotocol(&rwsem->waiting, SEM_PRIO_NONE);
+
+  rwsem->waiter = 0;
+  rwsem->reader = 0;
+  rwsem->writer = 0;
+  rwsem->holder = RWSEM_NO_HOLDER;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: destroy_rwsem
+ *
+ * Description:
+ *   Destroy a reader-writer lock that nobody holds.
+ *
+ * Input Parameters:
+ *   rwsem - The lock to destroy
+ *
+ ****************************************************************************/
+
+void destroy_rwsem(FAR rw_semaphore_t *rwsem)
+{
+  DEBUGASSERT(rwsem->waiter == 0 && rwsem->reader == 0 &&
+              rwsem->writer == 0 && rwsem->holder == RWSEM_NO_HOLDER);
+
+  nxsem_destroy(&rwsem->waiting);
+  nxsem_destroy(&rwsem->protect);
+}
+
+/****************************************************************************
+ * Name: down_read_trylock
+ *
+ * Description:
+ *   Take the lock for reading if no other thread holds it for writing.
+ *
+ * Input Parameters:
+ *   rwsem - The lock to take
+ *
+ * Returned Value:
+ *   true if the lock was taken.
+ *
+ ****************************************************************************/
+
+bool down_read_trylock(FAR rw_semaphore_t *rwsem)
+{
+  bool locked = true;
+
+  rwsem_lock(rwsem);
+
+  /* A read lock taken by the writer nests in its write lock */
+
+  if (rwsem->holder == getpid())
+    {
+      rwsem->writer++;
+    }
+  else if (rwsem->writer > 0)
+    {
+      locked = false;
+    }
+  else
+    {
+      rwsem->reader++;
+    }
+
+  nxsem_post(&rwsem->protect);
+  return locked;
+}
+
+/****************************************************************************
+ * Name: down_read
+ *
+ * Description:
+ *   Take the lock for reading, waiting while another thread holds it for
+ *   writing.
+ *
+ * Input Parameters:
+ *   rwsem - The lock to take
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ECANCELED if the thread was canceled.
+ *
+ ****************************************************************************/
+
+int down_read(FAR rw_semaphore_t *rwsem)
+{
+  int ret;
+
+  ret = nxsem_wait_uninterruptible(&rwsem->protect);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (rwsem->holder == getpid())
+    {
+      rwsem->writer++;
+    }
+  else
+    {
+      while (rwsem->writer > 0)
+        {
+          ret = rwsem_sleep(rwsem);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+
+      rwsem->reader++;
+    }
+
+  nxsem_post(&rwsem->protect);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: down_write_trylock
+ *
+ * Description:
+ *   Take the lock for writing if no other thread holds it.
+ *
+ * Input Parameters:
+ *   rwsem - The lock to take
+ *
+ * Returned Value:
+ *   true if the lock was taken.
+ *
+ ****************************************************************************/
+
+bool down_write_trylock(FAR rw_semaphore_t *rwsem)
+{
+  pid_t me = getpid();
+  bool locked = true;
+
+  rwsem_lock(rwsem);
+
+  if (rwsem->holder == me)
+    {
+      rwsem->writer++;
+    }
+  else if (rwsem->writer > 0 || rwsem->reader > 0)
+    {
+      locked = false;
+    }
+  else
+    {
+      rwsem->writer = 1;
+      rwsem->holder = me;
+    }
+
+  nxsem_post(&rwsem->protect);
+  return locked;
+}
+
+/****************************************************************************
+ * Name: down_write
+ *
+ * Description:
+ *   Take the lock for writing, waiting while any other thread holds it.
+ *
+ * Input Parameters:
+ *   rwsem - The lock to take
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ECANCELED if the thread was canceled.
+ *
+ ****************************************************************************/
+
+int down_write(FAR rw_semaphore_t *rwsem)
+{
+  pid_t me = getpid();
+  int ret;
+
+  ret = nxsem_wait_uninterruptible(&rwsem->protect);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (rwsem->holder == me)
+    {
+      rwsem->writer++;
+    }
+  else
+    {
+      while (rwsem->writer > 0 || rwsem->reader > 0)
+        {
+          ret = rwsem_sleep(rwsem);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+
+      rwsem->writer = 1;
+      rwsem->holder = me;
+    }
+
+  nxsem_post(&rwsem->protect);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: up_write
+ *
+ * Description:
+ *   Release a write lock, or a read lock nested in it.
+ *
+ * Input Parameters:
+ *   rwsem - The lock to release
+ *
+ ****************************************************************************/
+
+void up_write(FAR rw_semaphore_t *rwsem)
+{
+  rwsem_lock(rwsem);
+
+  DEBUGASSERT(rwsem->holder == getpid() && rwsem->writer > 0);
+
+  if (--rwsem->writer == 0)
+    {
+      rwsem->holder = RWSEM_NO_HOLDER;
+      rwsem_wakeall(rwsem);
+    }
+
+  nxsem_post(&rwsem->protect);
+}
+
+/****************************************************************************
+ * Name: up_read
+ *
+ * Description:
+ *   Release a read lock.
+ *
+ * Input Parameters:
+ *   rwsem - The lock to release
+ *
+ ****************************************************************************/
+
+void up_read(FAR rw_semaphore_t *rwsem)
+{
+  rwsem_lock(rwsem);
+
+  if (rwsem->holder == getpid())
+    {
+      /* The read lock was nested in our write lock */
+
+      DEBUGASSERT(rwsem->writer > 1);
+      rwsem->writer--;
+    }
+  else
+    {
+      DEBUGASSERT(rwsem->reader > 0);
+      if (--rwsem->reader == 0)
+        {
+          rwsem_wakeall(rwsem);
+        }
+    }
+
+  nxsem_post(&rwsem->protect);
+}
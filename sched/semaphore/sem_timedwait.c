@@ -88,6 +88,28 @@
 
 int nxsem_timedwait(FAR sem_t *sem, FAR const struct timespec *abstime)
 {
+#ifdef CONFIG_HRTIMER
+  int ret;
+
+#ifdef CONFIG_DEBUG_FEATURES
+  if (!abstime || !sem)
+    {
+      return -EINVAL;
+    }
+#endif
+
+  /* Wait with a high resolution timer rather than a watchdog.  As below,
+   * a bad timeout is only reported if we would have to wait.
+   */
+
+  if (abstime->tv_nsec < 0 || abstime->tv_nsec >= 1000000000)
+    {
+      ret = nxsem_trywait(sem);
+      return ret == OK ? OK : -EINVAL;
+    }
+
+  return nxsem_hrtimedwait(sem, hrtimer_abstime(CLOCK_REALTIME, abstime));
+#else
   FAR struct tcb_s *rtcb = this_task();
   irqstate_t flags;
   sclock_t ticks;
@@ -195,6 +217,7 @@ errout_with_irqdisabled:
   wd_delete(rtcb->waitdog);
   rtcb->waitdog = NULL;
   return ret;
+#endif /* CONFIG_HRTIMER */
 }
 
 /****************************************************************************
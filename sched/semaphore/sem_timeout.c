@@ -101,3 +101,38 @@ void nxsem_timeout(int argc, wdparm_t pid, ...)
 
   leave_critical_section(flags);
 }
+
+/****************************************************************************
+ * Name: nxsem_hrtimeout
+ *
+ * Description:
+ *   The same as nxsem_timeout() for the high resolution timer of
+ *   nxsem_hrtimedwait().  The timer is embedded in the TCB of the waiting
+ *   task and is cancelled before the task is released, so the TCB is still
+ *   valid here.
+ *
+ * Input Parameters:
+ *   hrtimer - The expired timer, tcb->waittimer
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   - Called from the context of the alarm interrupt handler, in the
+ *     critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER
+void nxsem_hrtimeout(FAR struct hrtimer_s *hrtimer)
+{
+  FAR struct tcb_s *wtcb = (FAR struct tcb_s *)hrtimer->arg;
+
+  if (wtcb->task_state == TSTATE_WAIT_SEM)
+    {
+      /* Cancel the semaphore wait */
+
+      nxsem_wait_irq(wtcb, ETIMEDOUT);
+    }
+}
+#endif
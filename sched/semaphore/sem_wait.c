@@ -77,6 +77,17 @@ int nxsem_wait(FAR sem_t *sem)
 
   DEBUGASSERT(sem != NULL && up_interrupt_context() == false);
 
+#ifdef CONFIG_SEM_FASTPATH
+  /* Take an available count without the critical section if no holder
+   * has to be recorded.
+   */
+
+  if (sem != NULL && nxsem_fastpath(sem) && nxsem_trydec(sem))
+    {
+      return OK;
+    }
+#endif
+
   /* The following operations must be performed with interrupts
    * disabled because nxsem_post() may be called from an interrupt
    * handler.
@@ -88,13 +99,14 @@ int nxsem_wait(FAR sem_t *sem)
 
   if (sem != NULL)
     {
-      /* Check if the lock is available */
+      /* Check if the lock is available.  The count is decremented in
+       * either case: a negative count is the number of waiting threads.
+       */
 
-      if (sem->semcount > 0)
+      if (nxsem_fetch_add(sem, -1) > 0)
         {
           /* It is, let the task take the semaphore. */
 
-          sem->semcount--;
           nxsem_addholder(sem);
           rtcb->waitsem = NULL;
           ret = OK;
@@ -114,10 +126,6 @@ int nxsem_wait(FAR sem_t *sem)
 
           DEBUGASSERT(rtcb->waitsem == NULL);
 
-          /* Handle the POSIX semaphore (but don't set the owner yet) */
-
-          sem->semcount--;
-
           /* Save the waited on semaphore in the TCB */
 
           rtcb->waitsem = sem;
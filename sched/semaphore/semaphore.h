@@ -43,11 +43,158 @@
 #include <nuttx/config.h>
 #include <nuttx/compiler.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/hrtimer.h>
 
 #include <stdint.h>
 #include <stdbool.h>
 #include <sched.h>
 #include <queue.h>
+#include <assert.h>
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsem_fetch_add
+ *
+ * Description:
+ *   Add n to the semaphore count and return the previous count.  With
+ *   CONFIG_SEM_FASTPATH, counts may be taken or given back outside of the
+ *   critical section, so the count must be updated atomically within it
+ *   too.
+ *
+ ****************************************************************************/
+
+static inline int16_t nxsem_fetch_add(FAR sem_t *sem, int16_t n)
+{
+#ifdef CONFIG_SEM_FASTPATH
+  return __atomic_fetch_add(&sem->semcount, n, __ATOMIC_ACQ_REL);
+#else
+  int16_t count = sem->semcount;
+
+  sem->semcount = count + n;
+  return count;
+#endif
+}
+
+/****************************************************************************
+ * Name: nxsem_trydec
+ *
+ * Description:
+ *   Take one count if the semaphore has one available.  Never blocks.
+ *
+ ****************************************************************************/
+
+static inline bool nxsem_trydec(FAR sem_t *sem)
+{
+#ifdef CONFIG_SEM_FASTPATH
+  int16_t count = __atomic_load_n(&sem->semcount, __ATOMIC_RELAXED);
+
+  while (count > 0)
+    {
+      if (__atomic_compare_exchange_n(&sem->semcount, &count, count - 1,
+                                      true, __ATOMIC_ACQUIRE,
+                                      __ATOMIC_RELAXED))
+        {
+          return true;
+        }
+    }
+
+  return false;
+#else
+  if (sem->semcount > 0)
+    {
+      sem->semcount--;
+      return true;
+    }
+
+  return false;
+#endif
+}
+
+/****************************************************************************
+ * Name: nxsem_trysetcount
+ *
+ * Description:
+ *   Set the semaphore count to n if no thread is waiting for the semaphore.
+ *   Return false, leaving the count unchanged, if one is.
+ *
+ ****************************************************************************/
+
+static inline bool nxsem_trysetcount(FAR sem_t *sem, int16_t n)
+{
+#ifdef CONFIG_SEM_FASTPATH
+  int16_t count = __atomic_load_n(&sem->semcount, __ATOMIC_RELAXED);
+
+  while (count >= 0)
+    {
+      if (__atomic_compare_exchange_n(&sem->semcount, &count, n,
+                                      true, __ATOMIC_ACQ_REL,
+                                      __ATOMIC_RELAXED))
+        {
+          return true;
+        }
+    }
+
+  return false;
+#else
+  if (sem->semcount >= 0)
+    {
+      sem->semcount = n;
+      return true;
+    }
+
+  return false;
+#endif
+}
+
+#ifdef CONFIG_SEM_FASTPATH
+/****************************************************************************
+ * Name: nxsem_tryinc
+ *
+ * Description:
+ *   Give back one count if no thread is waiting for the semaphore.
+ *
+ ****************************************************************************/
+
+static inline bool nxsem_tryinc(FAR sem_t *sem)
+{
+  int16_t count = __atomic_load_n(&sem->semcount, __ATOMIC_RELAXED);
+
+  while (count >= 0)
+    {
+      DEBUGASSERT(count < SEM_VALUE_MAX);
+      if (__atomic_compare_exchange_n(&sem->semcount, &count, count + 1,
+                                      true, __ATOMIC_RELEASE,
+                                      __ATOMIC_RELAXED))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: nxsem_fastpath
+ *
+ * Description:
+ *   Return true if counts of the semaphore may be taken and given back
+ *   outside of the critical section, that is, if no holders are tracked
+ *   for priority inheritance.
+ *
+ ****************************************************************************/
+
+static inline bool nxsem_fastpath(FAR sem_t *sem)
+{
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  return (sem->flags & PRIOINHERIT_FLAGS_DISABLE) != 0;
+#else
+  return true;
+#endif
+}
+#endif
 
 /****************************************************************************
  * Public Function Prototypes
@@ -76,6 +223,9 @@ void nxsem_wait_irq(FAR struct tcb_s *wtcb, int errcode);
 /* Handle semaphore timer expiration */
 
 void nxsem_timeout(int argc, wdparm_t pid, ...);
+#ifdef CONFIG_HRTIMER
+void nxsem_hrtimeout(FAR struct hrtimer_s *hrtimer);
+#endif
 
 /* Recover semaphore resources with a task or thread is destroyed  */
 
@@ -45,6 +45,7 @@
 #include <errno.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/hrtimer.h>
 #include <nuttx/irq.h>
 #include <nuttx/signal.h>
 #include <nuttx/cancelpt.h>
@@ -107,7 +108,11 @@ int nxsig_nanosleep(FAR const struct timespec *rqtp,
                     FAR struct timespec *rmtp)
 {
   irqstate_t flags;
+#ifdef CONFIG_HRTIMER
+  uint64_t start;
+#else
   clock_t starttick;
+#endif
   sigset_t set;
   int ret;
 
@@ -124,7 +129,11 @@ int nxsig_nanosleep(FAR const struct timespec *rqtp,
    */
 
   flags     = enter_critical_section();
+#ifdef CONFIG_HRTIMER
+  start     = hrtimer_now();
+#else
   starttick = clock_systimer();
+#endif
 
   /* Set up for the sleep.  Using the empty set means that we are not
    * waiting for any particular signal.  However, any unmasked signal can
@@ -156,6 +165,12 @@ int nxsig_nanosleep(FAR const struct timespec *rqtp,
 
   if (rmtp)
     {
+#ifdef CONFIG_HRTIMER
+      uint64_t requested = hrtimer_time2ns(rqtp);
+      uint64_t elapsed   = hrtimer_now() - start;
+
+      hrtimer_ns2time(elapsed < requested ? requested - elapsed : 0, rmtp);
+#else
       clock_t elapsed;
       clock_t remaining;
       sclock_t ticks;
@@ -190,6 +205,7 @@ int nxsig_nanosleep(FAR const struct timespec *rqtp,
         }
 
       clock_ticks2time((sclock_t)remaining, rmtp);
+#endif
     }
 
   leave_critical_section(flags);
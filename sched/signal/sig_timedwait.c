@@ -52,6 +52,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/wdog.h>
+#include <nuttx/hrtimer.h>
 #include <nuttx/signal.h>
 #include <nuttx/cancelpt.h>
 
@@ -75,6 +76,37 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: nxsig_timedout
+ *
+ * Description:
+ *   Wake up a task whose wait for signals timed out.
+ *
+ * Assumptions:
+ *   Called in the critical section.
+ *
+ ****************************************************************************/
+
+static void nxsig_timedout(FAR struct tcb_s *wtcb)
+{
+  /* There may be a race condition -- make sure the task is
+   * still waiting for a signal
+   */
+
+  if (wtcb->task_state == TSTATE_WAIT_SIG)
+    {
+      wtcb->sigunbinfo.si_signo           = SIG_WAIT_TIMEOUT;
+      wtcb->sigunbinfo.si_code            = SI_TIMER;
+      wtcb->sigunbinfo.si_errno           = ETIMEDOUT;
+      wtcb->sigunbinfo.si_value.sival_int = 0;
+#ifdef CONFIG_SCHED_HAVE_PARENT
+      wtcb->sigunbinfo.si_pid             = 0;  /* Not applicable */
+      wtcb->sigunbinfo.si_status          = OK;
+#endif
+      up_unblock_task(wtcb);
+    }
+}
+
 /****************************************************************************
  * Name: nxsig_timeout
  *
@@ -87,6 +119,7 @@
  *
  ****************************************************************************/
 
+#ifndef CONFIG_HRTIMER
 static void nxsig_timeout(int argc, wdparm_t itcb, ...)
 {
 #ifdef CONFIG_SMP
@@ -121,27 +154,32 @@ static void nxsig_timeout(int argc, wdparm_t itcb, ...)
   flags = enter_critical_section();
 #endif
 
-  /* There may be a race condition -- make sure the task is
-   * still waiting for a signal
-   */
-
-  if (u.wtcb->task_state == TSTATE_WAIT_SIG)
-    {
-      u.wtcb->sigunbinfo.si_signo           = SIG_WAIT_TIMEOUT;
-      u.wtcb->sigunbinfo.si_code            = SI_TIMER;
-      u.wtcb->sigunbinfo.si_errno           = ETIMEDOUT;
-      u.wtcb->sigunbinfo.si_value.sival_int = 0;
-#ifdef CONFIG_SCHED_HAVE_PARENT
-      u.wtcb->sigunbinfo.si_pid             = 0;  /* Not applicable */
-      u.wtcb->sigunbinfo.si_status          = OK;
-#endif
-      up_unblock_task(u.wtcb);
-    }
+  nxsig_timedout(u.wtcb);
 
 #ifdef CONFIG_SMP
   leave_critical_section(flags);
 #endif
 }
+#endif
+
+/****************************************************************************
+ * Name: nxsig_hrtimeout
+ *
+ * Description:
+ *   The same as nxsig_timeout() for the high resolution timer of the TCB.
+ *
+ * Assumptions:
+ *   This function executes in the context of the alarm interrupt handler,
+ *   in the critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER
+static void nxsig_hrtimeout(FAR struct hrtimer_s *hrtimer)
+{
+  nxsig_timedout((FAR struct tcb_s *)hrtimer->arg);
+}
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -244,7 +282,9 @@ int nxsig_timedwait(FAR const sigset_t *set, FAR struct siginfo *info,
   sigset_t intersection;
   FAR sigpendq_t *sigpend;
   irqstate_t flags;
+#ifndef CONFIG_HRTIMER
   int32_t waitticks;
+#endif
   int ret;
 
   DEBUGASSERT(set != NULL && rtcb->waitdog == NULL);
@@ -319,6 +359,27 @@ int nxsig_timedwait(FAR const sigset_t *set, FAR struct siginfo *info,
 
       if (timeout != NULL)
         {
+#ifdef CONFIG_HRTIMER
+          /* Start the high resolution timer of the TCB.  There is no
+           * rounding to ticks and nothing to allocate.
+           */
+
+          hrtimer_start(&rtcb->waittimer,
+                        hrtimer_now() + hrtimer_time2ns(timeout),
+                        nxsig_hrtimeout, rtcb);
+
+          /* Now wait for either the signal or the timer, but first, make
+           * sure this is not the idle task, descheduling that isn't going
+           * to end well.
+           */
+
+          DEBUGASSERT(NULL != rtcb->flink);
+          up_block_task(rtcb, TSTATE_WAIT_SIG);
+
+          /* We no longer need the timer */
+
+          hrtimer_cancel(&rtcb->waittimer);
+#else
           /* Convert the timespec to system clock ticks, making sure that
            * the resulting delay is greater than or equal to the requested
            * time in nanoseconds.
@@ -377,6 +438,7 @@ int nxsig_timedwait(FAR const sigset_t *set, FAR struct siginfo *info,
           /* REVISIT: And do what if there are no watchdog timers?  The wait
            * will fail and we will return something bogus.
            */
+#endif
         }
 
       /* No timeout, just wait */
@@ -43,11 +43,13 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/wdog.h>
+#include <nuttx/hrtimer.h>
 #include <nuttx/sched.h>
 
 #include "semaphore/semaphore.h"
 #include "wdog/wdog.h"
 #include "mqueue/mqueue.h"
+#include "futex/futex.h"
 #include "sched/sched.h"
 #include "task/task.h"
 
@@ -80,12 +82,22 @@ void nxtask_recover(FAR struct tcb_s *tcb)
 
   wd_recover(tcb);
 
+#ifdef CONFIG_HRTIMER
+  hrtimer_cancel(&tcb->waittimer);
+#endif
+
   /* If the thread holds semaphore counts or is waiting for a semaphore
    *  count, then release the counts.
    */
 
   nxsem_recover(tcb);
 
+#ifdef CONFIG_FUTEX
+  /* Unlink the waiter of a thread deleted while sleeping in FUTEX_WAIT */
+
+  futex_recover(tcb);
+#endif
+
 #ifndef CONFIG_DISABLE_MQUEUE
   /* Handle cases where the thread was waiting for a message queue event */
 
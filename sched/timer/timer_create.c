@@ -156,7 +156,9 @@ int timer_create(clockid_t clockid, FAR struct sigevent *evp,
                  FAR timer_t *timerid)
 {
   FAR struct posix_timer_s *ret;
+#ifndef CONFIG_HRTIMER
   WDOG_ID wdog;
+#endif
 
   /* Sanity checks.  Also, we support only CLOCK_REALTIME */
 
@@ -166,6 +168,7 @@ int timer_create(clockid_t clockid, FAR struct sigevent *evp,
       return ERROR;
     }
 
+#ifndef CONFIG_HRTIMER
   /* Allocate a watchdog to provide the underling CLOCK_REALTIME timer */
 
   wdog = wd_create();
@@ -174,23 +177,31 @@ int timer_create(clockid_t clockid, FAR struct sigevent *evp,
       set_errno(EAGAIN);
       return ERROR;
     }
+#endif
 
   /* Allocate a timer instance to contain the watchdog */
 
   ret = timer_allocate();
   if (!ret)
     {
+#ifndef CONFIG_HRTIMER
       wd_delete(wdog);
+#endif
       set_errno(EAGAIN);
       return ERROR;
     }
 
   /* Initialize the timer instance */
 
-  ret->pt_crefs = 1;
-  ret->pt_owner = getpid();
-  ret->pt_delay = 0;
-  ret->pt_wdog  = wdog;
+  ret->pt_crefs    = 1;
+  ret->pt_owner    = getpid();
+#ifdef CONFIG_HRTIMER
+  ret->pt_interval = 0;
+  hrtimer_init(&ret->pt_hrtimer);
+#else
+  ret->pt_delay    = 0;
+  ret->pt_wdog     = wdog;
+#endif
 
   /* Was a struct sigevent provided? */
 
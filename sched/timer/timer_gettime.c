@@ -71,7 +71,9 @@
 int timer_gettime(timer_t timerid, FAR struct itimerspec *value)
 {
   FAR struct posix_timer_s *timer = (FAR struct posix_timer_s *)timerid;
+#ifndef CONFIG_HRTIMER
   sclock_t ticks;
+#endif
 
   if (!timer || !value)
     {
@@ -79,6 +81,12 @@ int timer_gettime(timer_t timerid, FAR struct itimerspec *value)
       return ERROR;
     }
 
+#ifdef CONFIG_HRTIMER
+  /* Get the time before the underlying high resolution timer expires */
+
+  hrtimer_ns2time(hrtimer_gettime(&timer->pt_hrtimer), &value->it_value);
+  hrtimer_ns2time(timer->pt_interval, &value->it_interval);
+#else
   /* Get the number of ticks before the underlying watchdog expires */
 
   ticks = wd_gettime(timer->pt_wdog);
@@ -87,6 +95,8 @@ int timer_gettime(timer_t timerid, FAR struct itimerspec *value)
 
   clock_ticks2time(ticks, &value->it_value);
   clock_ticks2time(timer->pt_last, &value->it_interval);
+#endif
+
   return OK;
 }
 
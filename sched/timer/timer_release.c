@@ -119,11 +119,17 @@ int timer_release(FAR struct posix_timer_s *timer)
       return 1;
     }
 
+#ifdef CONFIG_HRTIMER
+  /* Stop the underlying high resolution timer */
+
+  hrtimer_cancel(&timer->pt_hrtimer);
+#else
   /* Free the underlying watchdog instance (the timer will be canceled by the
    * watchdog logic before it is actually deleted)
    */
 
   wd_delete(timer->pt_wdog);
+#endif
 
   /* Cancel any pending notification */
 
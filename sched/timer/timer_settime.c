@@ -41,9 +41,13 @@
  ****************************************************************************/
 
 static inline void timer_signotify(FAR struct posix_timer_s *timer);
+#ifdef CONFIG_HRTIMER
+static void timer_hrtimeout(FAR struct hrtimer_s *hrtimer);
+#else
 static inline void timer_restart(FAR struct posix_timer_s *timer,
                                  wdparm_t itimer);
 static void timer_timeout(int argc, wdparm_t itimer, ...);
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -73,6 +77,59 @@ static inline void timer_signotify(FAR struct posix_timer_s *timer)
                                  SI_TIMER, &timer->pt_work));
 }
 
+#ifdef CONFIG_HRTIMER
+/****************************************************************************
+ * Name: timer_hrtimeout
+ *
+ * Description:
+ *   This function is called when the high resolution timer of a POSIX timer
+ *   expires.  A repetitive timer is restarted one interval after its last
+ *   expiration, not after now, so that the period does not drift.  Periods
+ *   that were missed altogether are skipped.
+ *
+ * Input Parameters:
+ *   hrtimer - The high resolution timer of the POSIX timer
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   This function executes in the context of the timer interrupt.
+ *
+ ****************************************************************************/
+
+static void timer_hrtimeout(FAR struct hrtimer_s *hrtimer)
+{
+  FAR struct posix_timer_s *timer = hrtimer->arg;
+  uint64_t expired;
+  uint64_t now;
+
+  /* Send the specified signal to the specified task.   Increment the
+   * reference count on the timer first so that will not be deleted until
+   * after the signal handler returns.
+   */
+
+  timer->pt_crefs++;
+  timer_signotify(timer);
+
+  /* Release the reference.  timer_release will return nonzero if the timer
+   * was not deleted.
+   */
+
+  if (timer_release(timer) && timer->pt_interval > 0)
+    {
+      expired = hrtimer->expired + timer->pt_interval;
+      now     = hrtimer_now();
+      if (expired <= now)
+        {
+          expired += ((now - expired) / timer->pt_interval + 1) *
+                     timer->pt_interval;
+        }
+
+      hrtimer_start(hrtimer, expired, timer_hrtimeout, timer);
+    }
+}
+#else
 /****************************************************************************
  * Name: timer_restart
  *
@@ -146,6 +203,7 @@ static void timer_timeout(int argc, wdparm_t itimer, ...)
       timer_restart(timer, itimer);
     }
 }
+#endif /* CONFIG_HRTIMER */
 
 /****************************************************************************
  * Public Functions
@@ -221,7 +279,11 @@ int timer_settime(timer_t timerid, int flags,
 {
   FAR struct posix_timer_s *timer = (FAR struct posix_timer_s *)timerid;
   irqstate_t intflags;
+#ifdef CONFIG_HRTIMER
+  uint64_t expired;
+#else
   sclock_t delay;
+#endif
   int ret = OK;
 
   /* Some sanity checks */
@@ -232,6 +294,72 @@ int timer_settime(timer_t timerid, int flags,
       return ERROR;
     }
 
+#ifdef CONFIG_HRTIMER
+  if (ovalue)
+    {
+      /* Get the time before the underlying high resolution timer expires */
+
+      hrtimer_ns2time(hrtimer_gettime(&timer->pt_hrtimer),
+                      &ovalue->it_value);
+      hrtimer_ns2time(timer->pt_interval, &ovalue->it_interval);
+    }
+
+  /* Disarm the timer (in case the timer was already armed when
+   * timer_settime() is called).
+   */
+
+  hrtimer_cancel(&timer->pt_hrtimer);
+
+  /* Cancel any pending notification */
+
+  nxsig_cancel_notification(&timer->pt_work);
+
+  /* If the it_value member of value is zero, the timer will not be
+   * re-armed
+   */
+
+  if (value->it_value.tv_sec <= 0 && value->it_value.tv_nsec <= 0)
+    {
+      return OK;
+    }
+
+  /* Setup up any repetitive timer */
+
+  if (value->it_interval.tv_sec > 0 || value->it_interval.tv_nsec > 0)
+    {
+      timer->pt_interval = hrtimer_time2ns(&value->it_interval);
+    }
+  else
+    {
+      timer->pt_interval = 0;
+    }
+
+  /* The expiration is an absolute CLOCK_MONOTONIC time.  If it has
+   * already passed, the timer expires on the next timer interrupt and the
+   * notification is made, as for an absolute time that has passed.
+   */
+
+  intflags = enter_critical_section();
+
+  if ((flags & TIMER_ABSTIME) != 0)
+    {
+      expired = hrtimer_abstime(CLOCK_REALTIME, &value->it_value);
+    }
+  else
+    {
+      expired = hrtimer_now() + hrtimer_time2ns(&value->it_value);
+    }
+
+  ret = hrtimer_start(&timer->pt_hrtimer, expired, timer_hrtimeout, timer);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_critical_section(intflags);
+  return ret;
+#else
   if (ovalue)
     {
       /* Get the number of ticks before the underlying watchdog expires */
@@ -338,6 +466,7 @@ int timer_settime(timer_t timerid, int flags,
 
   leave_critical_section(intflags);
   return ret;
+#endif /* CONFIG_HRTIMER */
 }
 
 #endif /* CONFIG_DISABLE_POSIX_TIMERS */
@@ -205,6 +205,10 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(write,                    3, STUB_write)
   SYSCALL_LOOKUP(pread,                    4, STUB_pread)
   SYSCALL_LOOKUP(pwrite,                   4, STUB_pwrite)
+  SYSCALL_LOOKUP(readv,                    3, STUB_readv)
+  SYSCALL_LOOKUP(writev,                   3, STUB_writev)
+  SYSCALL_LOOKUP(preadv,                   4, STUB_preadv)
+  SYSCALL_LOOKUP(pwritev,                  4, STUB_pwritev)
 #ifdef CONFIG_FS_AIO
   SYSCALL_LOOKUP(aio_read,                 1, STUB_aio_read)
   SYSCALL_LOOKUP(aio_write,                1, STUB_aio_write)
@@ -250,6 +254,7 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
 
 #if defined(CONFIG_FS_RAMMAP)
   SYSCALL_LOOKUP(munmap,                   2, STUB_munmap)
+  SYSCALL_LOOKUP(msync,                    3, STUB_msync)
 #endif
 
 #if defined(CONFIG_PSEUDOFS_SOFTLINKS)
@@ -298,9 +303,6 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
 
 #ifndef CONFIG_DISABLE_PTHREAD
   SYSCALL_LOOKUP(pthread_cancel,           1, STUB_pthread_cancel)
-  SYSCALL_LOOKUP(pthread_cond_broadcast,   1, STUB_pthread_cond_broadcast)
-  SYSCALL_LOOKUP(pthread_cond_signal,      1, STUB_pthread_cond_signal)
-  SYSCALL_LOOKUP(pthread_cond_wait,        2, STUB_pthread_cond_wait)
   SYSCALL_LOOKUP(pthread_create,           4, STUB_pthread_create)
   SYSCALL_LOOKUP(pthread_detach,           1, STUB_pthread_detach)
   SYSCALL_LOOKUP(pthread_exit,             1, STUB_pthread_exit)
@@ -311,11 +313,17 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(pthread_join,             2, STUB_pthread_join)
   SYSCALL_LOOKUP(pthread_key_create,       2, STUB_pthread_key_create)
   SYSCALL_LOOKUP(pthread_key_delete,       1, STUB_pthread_key_delete)
+#ifndef CONFIG_PTHREAD_MUTEX_FUTEX
+  SYSCALL_LOOKUP(pthread_cond_broadcast,   1, STUB_pthread_cond_broadcast)
+  SYSCALL_LOOKUP(pthread_cond_signal,      1, STUB_pthread_cond_signal)
+  SYSCALL_LOOKUP(pthread_cond_timedwait,   3, STUB_pthread_cond_timedwait)
+  SYSCALL_LOOKUP(pthread_cond_wait,        2, STUB_pthread_cond_wait)
   SYSCALL_LOOKUP(pthread_mutex_destroy,    1, STUB_pthread_mutex_destroy)
   SYSCALL_LOOKUP(pthread_mutex_init,       2, STUB_pthread_mutex_init)
   SYSCALL_LOOKUP(pthread_mutex_timedlock,  2, STUB_pthread_mutex_timedlock)
   SYSCALL_LOOKUP(pthread_mutex_trylock,    1, STUB_pthread_mutex_trylock)
   SYSCALL_LOOKUP(pthread_mutex_unlock,     1, STUB_pthread_mutex_unlock)
+#endif
 #ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
   SYSCALL_LOOKUP(pthread_mutex_consistent, 1, STUB_pthread_mutex_consistent)
 #endif
@@ -326,7 +334,6 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(pthread_setaffinity,      3, STUB_pthread_setaffinity)
   SYSCALL_LOOKUP(pthread_getaffinity,      3, STUB_pthread_getaffinity)
 #endif
-  SYSCALL_LOOKUP(pthread_cond_timedwait,   3, STUB_pthread_cond_timedwait)
   SYSCALL_LOOKUP(pthread_kill,             2, STUB_pthread_kill)
   SYSCALL_LOOKUP(pthread_sigmask,          3, STUB_pthread_sigmask)
 #ifdef CONFIG_PTHREAD_CLEANUP
@@ -398,6 +405,12 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(getrandom,               2, STUB_getrandom)
 #endif
 
+/* The following is defined only if futexes are enabled */
+
+#ifdef CONFIG_FUTEX
+  SYSCALL_LOOKUP(futex,                    4, STUB_futex)
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/